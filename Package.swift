@@ -111,6 +111,10 @@ let package = Package(
         "include/grpc/support/thd_id.h",
         "include/grpc/support/time.h",
         "include/grpc/support/workaround_list.h",
+        "src/core/ext/filters/adaptive_concurrency/adaptive_concurrency_filter.cc",
+        "src/core/ext/filters/adaptive_concurrency/adaptive_concurrency_filter.h",
+        "src/core/ext/filters/adaptive_concurrency/concurrency_limiter.cc",
+        "src/core/ext/filters/adaptive_concurrency/concurrency_limiter.h",
         "src/core/ext/filters/backend_metrics/backend_metric_filter.cc",
         "src/core/ext/filters/backend_metrics/backend_metric_filter.h",
         "src/core/ext/filters/backend_metrics/backend_metric_provider.h",
@@ -161,6 +165,8 @@ let package = Package(
         "src/core/ext/filters/client_channel/lb_policy/health_check_client.cc",
         "src/core/ext/filters/client_channel/lb_policy/health_check_client.h",
         "src/core/ext/filters/client_channel/lb_policy/health_check_client_internal.h",
+        "src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc",
+        "src/core/ext/filters/client_channel/lb_policy/maglev/maglev.cc",
         "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc",
         "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.h",
         "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric_internal.h",
@@ -169,12 +175,16 @@ let package = Package(
         "src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc",
         "src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.h",
         "src/core/ext/filters/client_channel/lb_policy/priority/priority.cc",
+        "src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash_lb_policy.cc",
         "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc",
+        "src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash_lb_policy.h",
         "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h",
         "src/core/ext/filters/client_channel/lb_policy/rls/rls.cc",
         "src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc",
         "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h",
+        "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/alias_table_scheduler.cc",
         "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.cc",
+        "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/alias_table_scheduler.h",
         "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h",
         "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc",
         "src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc",
@@ -247,10 +257,18 @@ let package = Package(
         "src/core/ext/filters/http/server/http_server_filter.h",
         "src/core/ext/filters/message_size/message_size_filter.cc",
         "src/core/ext/filters/message_size/message_size_filter.h",
+        "src/core/ext/filters/method_stats/method_stats_filter.cc",
+        "src/core/ext/filters/method_stats/method_stats_filter.h",
         "src/core/ext/filters/rbac/rbac_filter.cc",
         "src/core/ext/filters/rbac/rbac_filter.h",
         "src/core/ext/filters/rbac/rbac_service_config_parser.cc",
         "src/core/ext/filters/rbac/rbac_service_config_parser.h",
+        "src/core/ext/filters/response_cache/response_cache.cc",
+        "src/core/ext/filters/response_cache/response_cache.h",
+        "src/core/ext/filters/response_cache/response_cache_filter.cc",
+        "src/core/ext/filters/response_cache/response_cache_filter.h",
+        "src/core/ext/filters/response_cache/response_cache_service_config_parser.cc",
+        "src/core/ext/filters/response_cache/response_cache_service_config_parser.h",
         "src/core/ext/filters/server_config_selector/server_config_selector.h",
         "src/core/ext/filters/server_config_selector/server_config_selector_filter.cc",
         "src/core/ext/filters/server_config_selector/server_config_selector_filter.h",
@@ -988,6 +1006,7 @@ let package = Package(
         "src/core/ext/xds/xds_lb_policy_registry.h",
         "src/core/ext/xds/xds_listener.cc",
         "src/core/ext/xds/xds_listener.h",
+        "src/core/ext/xds/xds_parallel_for.h",
         "src/core/ext/xds/xds_resource_type.h",
         "src/core/ext/xds/xds_resource_type_impl.h",
         "src/core/ext/xds/xds_route_config.cc",
@@ -1051,6 +1070,10 @@ let package = Package(
         "src/core/lib/debug/event_log.h",
         "src/core/lib/debug/histogram_view.cc",
         "src/core/lib/debug/histogram_view.h",
+        "src/core/lib/debug/call_timeline.cc",
+        "src/core/lib/debug/method_stats.cc",
+        "src/core/lib/debug/call_timeline.h",
+        "src/core/lib/debug/method_stats.h",
         "src/core/lib/debug/stats.cc",
         "src/core/lib/debug/stats.h",
         "src/core/lib/debug/stats_data.cc",
@@ -1210,6 +1233,7 @@ let package = Package(
         "src/core/lib/gprpp/host_port.cc",
         "src/core/lib/gprpp/host_port.h",
         "src/core/lib/gprpp/if_list.h",
+        "src/core/lib/gprpp/intern_cache.h",
         "src/core/lib/gprpp/linux/env.cc",
         "src/core/lib/gprpp/load_file.cc",
         "src/core/lib/gprpp/load_file.h",
@@ -1242,6 +1266,7 @@ let package = Package(
         "src/core/lib/gprpp/tchar.cc",
         "src/core/lib/gprpp/tchar.h",
         "src/core/lib/gprpp/thd.h",
+        "src/core/lib/gprpp/thread_local_random.h",
         "src/core/lib/gprpp/time.cc",
         "src/core/lib/gprpp/time.h",
         "src/core/lib/gprpp/time_averaged_stats.cc",
@@ -1415,6 +1440,8 @@ let package = Package(
         "src/core/lib/json/json.h",
         "src/core/lib/json/json_args.h",
         "src/core/lib/json/json_channel_args.h",
+        "src/core/lib/json/json_document.cc",
+        "src/core/lib/json/json_document.h",
         "src/core/lib/json/json_object_loader.cc",
         "src/core/lib/json/json_object_loader.h",
         "src/core/lib/json/json_reader.cc",
@@ -266,6 +266,8 @@
         'upb',
       ],
       'sources': [
+        'src/core/ext/filters/adaptive_concurrency/adaptive_concurrency_filter.cc',
+        'src/core/ext/filters/adaptive_concurrency/concurrency_limiter.cc',
         'src/core/ext/filters/backend_metrics/backend_metric_filter.cc',
         'src/core/ext/filters/census/grpc_context.cc',
         'src/core/ext/filters/channel_idle/channel_idle_filter.cc',
@@ -290,13 +292,17 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
         'src/core/ext/filters/client_channel/lb_policy/health_check_client.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
+        'src/core/ext/filters/client_channel/lb_policy/maglev/maglev.cc',
         'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
         'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
+        'src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash_lb_policy.cc',
         'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/alias_table_scheduler.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
@@ -340,8 +346,12 @@
         'src/core/ext/filters/http/message_compress/compression_filter.cc',
         'src/core/ext/filters/http/server/http_server_filter.cc',
         'src/core/ext/filters/message_size/message_size_filter.cc',
+        'src/core/ext/filters/method_stats/method_stats_filter.cc',
         'src/core/ext/filters/rbac/rbac_filter.cc',
         'src/core/ext/filters/rbac/rbac_service_config_parser.cc',
+        'src/core/ext/filters/response_cache/response_cache.cc',
+        'src/core/ext/filters/response_cache/response_cache_filter.cc',
+        'src/core/ext/filters/response_cache/response_cache_service_config_parser.cc',
         'src/core/ext/filters/server_config_selector/server_config_selector_filter.cc',
         'src/core/ext/filters/stateful_session/stateful_session_filter.cc',
         'src/core/ext/filters/stateful_session/stateful_session_service_config_parser.cc',
@@ -734,8 +744,10 @@
         'src/core/lib/compression/compression_internal.cc',
         'src/core/lib/compression/message_compress.cc',
         'src/core/lib/config/core_configuration.cc',
+        'src/core/lib/debug/call_timeline.cc',
         'src/core/lib/debug/event_log.cc',
         'src/core/lib/debug/histogram_view.cc',
+        'src/core/lib/debug/method_stats.cc',
         'src/core/lib/debug/stats.cc',
         'src/core/lib/debug/stats_data.cc',
         'src/core/lib/debug/trace.cc',
@@ -875,6 +887,7 @@
         'src/core/lib/iomgr/wakeup_fd_nospecial.cc',
         'src/core/lib/iomgr/wakeup_fd_pipe.cc',
         'src/core/lib/iomgr/wakeup_fd_posix.cc',
+        'src/core/lib/json/json_document.cc',
         'src/core/lib/json/json_object_loader.cc',
         'src/core/lib/json/json_reader.cc',
         'src/core/lib/json/json_util.cc',
@@ -1101,6 +1114,8 @@
         'upb',
       ],
       'sources': [
+        'src/core/ext/filters/adaptive_concurrency/adaptive_concurrency_filter.cc',
+        'src/core/ext/filters/adaptive_concurrency/concurrency_limiter.cc',
         'src/core/ext/filters/backend_metrics/backend_metric_filter.cc',
         'src/core/ext/filters/census/grpc_context.cc',
         'src/core/ext/filters/channel_idle/channel_idle_filter.cc',
@@ -1125,12 +1140,14 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
         'src/core/ext/filters/client_channel/lb_policy/health_check_client.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
         'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
         'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
         'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/alias_table_scheduler.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
@@ -1166,6 +1183,10 @@
         'src/core/ext/filters/http/message_compress/compression_filter.cc',
         'src/core/ext/filters/http/server/http_server_filter.cc',
         'src/core/ext/filters/message_size/message_size_filter.cc',
+        'src/core/ext/filters/method_stats/method_stats_filter.cc',
+        'src/core/ext/filters/response_cache/response_cache.cc',
+        'src/core/ext/filters/response_cache/response_cache_filter.cc',
+        'src/core/ext/filters/response_cache/response_cache_service_config_parser.cc',
         'src/core/ext/transport/chttp2/client/chttp2_connector.cc',
         'src/core/ext/transport/chttp2/server/chttp2_server.cc',
         'src/core/ext/transport/chttp2/transport/bin_decoder.cc',
@@ -1233,8 +1254,10 @@
         'src/core/lib/compression/compression_internal.cc',
         'src/core/lib/compression/message_compress.cc',
         'src/core/lib/config/core_configuration.cc',
+        'src/core/lib/debug/call_timeline.cc',
         'src/core/lib/debug/event_log.cc',
         'src/core/lib/debug/histogram_view.cc',
+        'src/core/lib/debug/method_stats.cc',
         'src/core/lib/debug/stats.cc',
         'src/core/lib/debug/stats_data.cc',
         'src/core/lib/debug/trace.cc',
@@ -1373,6 +1396,7 @@
         'src/core/lib/iomgr/wakeup_fd_nospecial.cc',
         'src/core/lib/iomgr/wakeup_fd_pipe.cc',
         'src/core/lib/iomgr/wakeup_fd_posix.cc',
+        'src/core/lib/json/json_document.cc',
         'src/core/lib/json/json_object_loader.cc',
         'src/core/lib/json/json_reader.cc',
         'src/core/lib/json/json_writer.cc',
@@ -1754,8 +1778,10 @@
         'src/core/lib/compression/compression_internal.cc',
         'src/core/lib/compression/message_compress.cc',
         'src/core/lib/config/core_configuration.cc',
+        'src/core/lib/debug/call_timeline.cc',
         'src/core/lib/debug/event_log.cc',
         'src/core/lib/debug/histogram_view.cc',
+        'src/core/lib/debug/method_stats.cc',
         'src/core/lib/debug/stats.cc',
         'src/core/lib/debug/stats_data.cc',
         'src/core/lib/debug/trace.cc',
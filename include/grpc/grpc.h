@@ -580,6 +580,14 @@ GRPCAPI char* grpc_channelz_get_subchannel(intptr_t subchannel_id);
    is allocated and must be freed by the application. */
 GRPCAPI char* grpc_channelz_get_socket(intptr_t socket_id);
 
+/* Returns the slow sampled calls of a Channel or Server (see
+   GRPC_ARG_SLOW_CALL_THRESHOLD_MS), or NULL if there is no such entity.
+   The JSON object is not part of the channelz proto; it has a "slowCall"
+   array whose elements hold the "method", "status", "latency" and
+   "timeline" of a call.  The returned string is allocated and must be freed
+   by the application. */
+GRPCAPI char* grpc_channelz_get_slow_calls(intptr_t channelz_id);
+
 /**
  * EXPERIMENTAL - Subject to change.
  * Fetch a vtable for grpc_channel_arg that points to
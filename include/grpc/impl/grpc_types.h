@@ -325,6 +325,28 @@ typedef struct {
     values set in the LB policy config will be capped to this value.
     Default is 4096. */
 #define GRPC_ARG_RING_HASH_LB_RING_SIZE_CAP "grpc.lb.ring_hash.ring_size_cap"
+/** If set to a value of at least 100, the ring_hash LB policy will use
+    consistent hashing with bounded loads: no READY endpoint will be sent a
+    call while it has more than this percentage of the average number of
+    calls in flight per READY endpoint, and calls that hash to such an
+    endpoint spill over to the next endpoint on the ring instead.  Values
+    between 1 and 99 are treated as 100.  Default is 0 (disabled). */
+#define GRPC_ARG_RING_HASH_LB_BALANCE_FACTOR "grpc.lb.ring_hash.balance_factor"
+/** If non-zero, the round_robin LB policy will keep a separate pick cursor
+    per CPU instead of a single cursor shared by all picking threads.  This
+    avoids contention on a single cache line at very high QPS, at the cost
+    of picks from any one thread no longer being in strict round-robin
+    order.  Picks are still evenly distributed in the long run.
+    Default is 0. */
+#define GRPC_ARG_ROUND_ROBIN_LB_PER_CPU_PICKER \
+  "grpc.lb.round_robin.per_cpu_picker"
+/** If non-zero, the weighted_round_robin LB policy will pick with a randomized
+    alias-table scheduler instead of the default stride scheduler.  Picks
+    cost O(1) no matter how skewed the endpoint weights are, but are only
+    weighted in expectation rather than deterministically interleaved.
+    Default is 0. */
+#define GRPC_ARG_WEIGHTED_ROUND_ROBIN_LB_ALIAS_TABLE_SCHEDULER \
+  "grpc.lb.weighted_round_robin.alias_table_scheduler"
 /** The grpc_socket_mutator instance that set the socket options. A pointer. */
 #define GRPC_ARG_SOCKET_MUTATOR "grpc.socket_mutator"
 /** The grpc_socket_factory instance to create and bind sockets. A pointer. */
@@ -415,15 +437,13 @@ typedef struct {
     retries are enabled when they are configured via the service config.
     For details, see:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    NOTE: Hedging functionality is not yet implemented, so those
-          fields in the service config will currently be ignored.  See
-          also the GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below.
+    NOTE: Hedging policies in the service config are ignored unless the
+          GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below is also set.
  */
 #define GRPC_ARG_ENABLE_RETRIES "grpc.enable_retries"
 /** Enables hedging functionality, as described in:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    Default is currently false, since this functionality is not yet
-    fully implemented.
+    Requires retries to be enabled.  Default is currently false.
     NOTE: This channel arg is experimental and will eventually be removed.
           Once hedging functionality has been implemented and proves stable,
           this arg will be removed, and the hedging functionality will
@@ -431,6 +451,39 @@ typedef struct {
 #define GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING "grpc.experimental.enable_hedging"
 /** Per-RPC retry buffer size, in bytes. Default is 256 KiB. */
 #define GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE "grpc.per_rpc_retry_buffer_size"
+/** Maximum number of bytes of responses cached per channel for methods
+    whose method config has a responseCachePolicy.  Cached responses are
+    accounted against the channel's resource quota.  Default is 0, which
+    disables the response cache. */
+#define GRPC_ARG_RESPONSE_CACHE_MAX_BYTES "grpc.response_cache_max_bytes"
+/** If non-zero, limit the number of calls in flight on the channel (or, for
+    servers, across all connections of the server), adjusting the limit
+    based on observed call latency.  Calls over the limit are queued,
+    earliest deadline first, or failed with RESOURCE_EXHAUSTED when the
+    queue is full.  Default is 0 (disabled). */
+#define GRPC_ARG_ADAPTIVE_CONCURRENCY "grpc.adaptive_concurrency"
+/** Upper bound of the adaptive concurrency limit.  Default is 1000. */
+#define GRPC_ARG_ADAPTIVE_CONCURRENCY_MAX_LIMIT \
+  "grpc.adaptive_concurrency.max_limit"
+/** Maximum number of calls waiting for the adaptive concurrency limit.  If
+    0, calls over the limit fail immediately.  Default is 100. */
+#define GRPC_ARG_ADAPTIVE_CONCURRENCY_MAX_QUEUE_SIZE \
+  "grpc.adaptive_concurrency.max_queue_size"
+/** If non-zero, record the latency and payload sizes of each call, keyed by
+    channel target and method, in the process-wide per-method stats (see
+    src/core/lib/debug/method_stats.h).  Servers also record how long each
+    call waited for the application to request it.  Default is 0. */
+#define GRPC_ARG_ENABLE_METHOD_STATS "grpc.enable_method_stats"
+/** One in this many calls records a timeline of its phases (LB pick, HPACK
+    encoding, writes, reads, ...), and is kept by the process-wide flight
+    recorder if it is slow (see src/core/lib/debug/call_timeline.h).  0
+    disables sampling.  Default is 1000. */
+#define GRPC_ARG_CALL_TIMELINE_SAMPLE_RATE "grpc.call_timeline_sample_rate"
+/** Sampled unary calls that take at least this many milliseconds are kept
+    by the flight recorder and by the channel's or server's channelz node
+    (see grpc_channelz_get_slow_calls).  Streaming calls are never kept.
+    Default is 1000. */
+#define GRPC_ARG_SLOW_CALL_THRESHOLD_MS "grpc.slow_call_threshold_ms"
 /** Channel arg that carries the bridged objective c object for custom metrics
  * logging filter. */
 #define GRPC_ARG_MOBILE_LOG_CONTEXT "grpc.mobile_log_context"
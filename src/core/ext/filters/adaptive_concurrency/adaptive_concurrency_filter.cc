@@ -0,0 +1,137 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/adaptive_concurrency/adaptive_concurrency_filter.h"
+
+#include <functional>
+
+#include <grpc/impl/grpc_types.h>
+#include <grpc/status.h>
+
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/promise/map.h"
+#include "src/core/lib/promise/try_seq.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/surface/channel_stack_type.h"
+#include "src/core/lib/transport/metadata_batch.h"
+
+namespace grpc_core {
+
+namespace {
+
+bool AdaptiveConcurrencyEnabled(const ChannelArgs& args) {
+  return args.GetBool(GRPC_ARG_ADAPTIVE_CONCURRENCY).value_or(false);
+}
+
+// Adds a limiter to the args of channels and servers that enable adaptive
+// concurrency.  Since this runs once per server, rather than once per
+// connection, all connections of a server share the limiter.
+ChannelArgs EnsureConcurrencyLimiterInChannelArgs(const ChannelArgs& args) {
+  if (!AdaptiveConcurrencyEnabled(args) ||
+      args.GetObject<ConcurrencyLimiter>() != nullptr) {
+    return args;
+  }
+  return args.SetObject(MakeRefCounted<ConcurrencyLimiter>(
+      ConcurrencyLimiter::Options::FromChannelArgs(args)));
+}
+
+}  // namespace
+
+RefCountedPtr<ConcurrencyLimiter> AdaptiveConcurrencyFilter::GetLimiter(
+    const ChannelArgs& args) {
+  auto limiter = args.GetObjectRef<ConcurrencyLimiter>();
+  // Channel stacks built without args preconditioning (e.g. in tests) get a
+  // limiter of their own.
+  if (limiter == nullptr) {
+    limiter = MakeRefCounted<ConcurrencyLimiter>(
+        ConcurrencyLimiter::Options::FromChannelArgs(args));
+  }
+  return limiter;
+}
+
+ArenaPromise<ServerMetadataHandle> AdaptiveConcurrencyFilter::MakeCallPromise(
+    CallArgs call_args, NextPromiseFactory next_promise_factory) {
+  const Timestamp deadline =
+      call_args.client_initial_metadata->get(GrpcTimeoutMetadata())
+          .value_or(Timestamp::InfFuture());
+  return TrySeq(
+      limiter_->Acquire(deadline),
+      [call_args = std::move(call_args),
+       next_promise_factory = std::move(next_promise_factory)](
+          ConcurrencyLimiter::Permit permit) mutable {
+        return Map(next_promise_factory(std::move(call_args)),
+                   [permit = std::move(permit)](
+                       ServerMetadataHandle trailing_metadata) mutable {
+                     permit.Release(
+                         trailing_metadata->get(GrpcStatusMetadata())
+                             .value_or(GRPC_STATUS_UNKNOWN));
+                     return trailing_metadata;
+                   });
+      });
+}
+
+absl::StatusOr<ClientAdaptiveConcurrencyFilter>
+ClientAdaptiveConcurrencyFilter::Create(const ChannelArgs& args,
+                                        ChannelFilter::Args) {
+  return ClientAdaptiveConcurrencyFilter(GetLimiter(args));
+}
+
+absl::StatusOr<ServerAdaptiveConcurrencyFilter>
+ServerAdaptiveConcurrencyFilter::Create(const ChannelArgs& args,
+                                        ChannelFilter::Args) {
+  return ServerAdaptiveConcurrencyFilter(GetLimiter(args));
+}
+
+const grpc_channel_filter ClientAdaptiveConcurrencyFilter::kFilter =
+    MakePromiseBasedFilter<ClientAdaptiveConcurrencyFilter,
+                           FilterEndpoint::kClient>(
+        "client_adaptive_concurrency");
+const grpc_channel_filter ServerAdaptiveConcurrencyFilter::kFilter =
+    MakePromiseBasedFilter<ServerAdaptiveConcurrencyFilter,
+                           FilterEndpoint::kServer>(
+        "server_adaptive_concurrency");
+
+void RegisterAdaptiveConcurrencyFilters(CoreConfiguration::Builder* builder) {
+  builder->channel_args_preconditioning()->RegisterStage(
+      EnsureConcurrencyLimiterInChannelArgs);
+  builder->channel_init()->RegisterStage(
+      GRPC_CLIENT_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      [](ChannelStackBuilder* builder) {
+        auto channel_args = builder->channel_args();
+        if (!channel_args.WantMinimalStack() &&
+            AdaptiveConcurrencyEnabled(channel_args)) {
+          builder->PrependFilter(&ClientAdaptiveConcurrencyFilter::kFilter);
+        }
+        return true;
+      });
+  builder->channel_init()->RegisterStage(
+      GRPC_SERVER_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      [](ChannelStackBuilder* builder) {
+        auto channel_args = builder->channel_args();
+        if (!channel_args.WantMinimalStack() &&
+            AdaptiveConcurrencyEnabled(channel_args)) {
+          builder->PrependFilter(&ServerAdaptiveConcurrencyFilter::kFilter);
+        }
+        return true;
+      });
+}
+
+}  // namespace grpc_core
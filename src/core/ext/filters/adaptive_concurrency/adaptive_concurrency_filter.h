@@ -0,0 +1,80 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_ADAPTIVE_CONCURRENCY_ADAPTIVE_CONCURRENCY_FILTER_H
+#define GRPC_SRC_CORE_EXT_FILTERS_ADAPTIVE_CONCURRENCY_ADAPTIVE_CONCURRENCY_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <utility>
+
+#include "absl/status/statusor.h"
+
+#include "src/core/ext/filters/adaptive_concurrency/concurrency_limiter.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_fwd.h"
+#include "src/core/lib/channel/promise_based_filter.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/promise/arena_promise.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+
+// Applies a ConcurrencyLimiter to the calls on a channel.
+//
+// The limiter is taken from the channel args, where it is added when the
+// channel (or server) is created, so that a server shares one limit among
+// all of its connections.
+class AdaptiveConcurrencyFilter : public ChannelFilter {
+ public:
+  ArenaPromise<ServerMetadataHandle> MakeCallPromise(
+      CallArgs call_args, NextPromiseFactory next_promise_factory) override;
+
+ protected:
+  explicit AdaptiveConcurrencyFilter(RefCountedPtr<ConcurrencyLimiter> limiter)
+      : limiter_(std::move(limiter)) {}
+
+  static RefCountedPtr<ConcurrencyLimiter> GetLimiter(const ChannelArgs& args);
+
+ private:
+  RefCountedPtr<ConcurrencyLimiter> limiter_;
+};
+
+class ClientAdaptiveConcurrencyFilter final : public AdaptiveConcurrencyFilter {
+ public:
+  static const grpc_channel_filter kFilter;
+
+  static absl::StatusOr<ClientAdaptiveConcurrencyFilter> Create(
+      const ChannelArgs& args, ChannelFilter::Args filter_args);
+
+ private:
+  using AdaptiveConcurrencyFilter::AdaptiveConcurrencyFilter;
+};
+
+class ServerAdaptiveConcurrencyFilter final : public AdaptiveConcurrencyFilter {
+ public:
+  static const grpc_channel_filter kFilter;
+
+  static absl::StatusOr<ServerAdaptiveConcurrencyFilter> Create(
+      const ChannelArgs& args, ChannelFilter::Args filter_args);
+
+ private:
+  using AdaptiveConcurrencyFilter::AdaptiveConcurrencyFilter;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_ADAPTIVE_CONCURRENCY_ADAPTIVE_CONCURRENCY_FILTER_H
@@ -0,0 +1,262 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/adaptive_concurrency/concurrency_limiter.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <iterator>
+
+#include "absl/status/status.h"
+
+#include <grpc/impl/grpc_types.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Multiplier applied to the limit when calls are being dropped.
+constexpr double kBackoffRatio = 0.9;
+// How much the window latency may exceed the lowest latency before the
+// limit starts shrinking.
+constexpr double kRttTolerance = 1.5;
+// Weight of a new limit estimate against the current limit.
+constexpr double kSmoothing = 0.2;
+
+bool IsDrop(grpc_status_code status) {
+  return status == GRPC_STATUS_RESOURCE_EXHAUSTED ||
+         status == GRPC_STATUS_DEADLINE_EXCEEDED;
+}
+
+absl::Status ShedStatus() {
+  return absl::ResourceExhaustedError("adaptive concurrency limit reached");
+}
+
+}  // namespace
+
+//
+// ConcurrencyLimiter::Options
+//
+
+ConcurrencyLimiter::Options ConcurrencyLimiter::Options::FromChannelArgs(
+    const ChannelArgs& args) {
+  Options options;
+  options.max_limit = static_cast<uint32_t>(std::max(
+      1, args.GetInt(GRPC_ARG_ADAPTIVE_CONCURRENCY_MAX_LIMIT)
+             .value_or(static_cast<int>(options.max_limit))));
+  options.initial_limit = std::min(options.initial_limit, options.max_limit);
+  options.max_queue_size = static_cast<size_t>(std::max(
+      0, args.GetInt(GRPC_ARG_ADAPTIVE_CONCURRENCY_MAX_QUEUE_SIZE)
+             .value_or(static_cast<int>(options.max_queue_size))));
+  return options;
+}
+
+//
+// ConcurrencyLimiter::Permit
+//
+
+void ConcurrencyLimiter::Permit::Release(grpc_status_code status) {
+  gpr_timespec elapsed =
+      gpr_cycle_counter_sub(gpr_get_cycle_counter(), start_);
+  TestOnlyRelease(status, gpr_timespec_to_micros(elapsed) / 1e6);
+}
+
+void ConcurrencyLimiter::Permit::TestOnlyRelease(grpc_status_code status,
+                                                 double rtt_seconds) {
+  GPR_ASSERT(limiter_ != nullptr);
+  auto limiter = std::move(limiter_);
+  limiter->OnCallDone(rtt_seconds, IsDrop(status));
+}
+
+//
+// ConcurrencyLimiter::AcquirePromise
+//
+
+ConcurrencyLimiter::AcquirePromise::~AcquirePromise() {
+  if (waiter_ == nullptr) return;
+  bool admitted;
+  {
+    MutexLock lock(&limiter_->mu_);
+    admitted = waiter_->state == Waiter::State::kAdmitted;
+    if (waiter_->state == Waiter::State::kQueued) {
+      limiter_->queue_.erase(waiter_.get());
+    }
+  }
+  // The call was given a slot, but went away before taking it.
+  if (admitted) limiter_->OnCallDone(absl::nullopt, false);
+}
+
+Poll<absl::StatusOr<ConcurrencyLimiter::Permit>>
+ConcurrencyLimiter::AcquirePromise::operator()() {
+  ConcurrencyLimiter* limiter = limiter_.get();
+  std::vector<Waker> wakers;
+  Poll<absl::StatusOr<Permit>> result = Pending{};
+  {
+    MutexLock lock(&limiter->mu_);
+    if (waiter_ == nullptr) {
+      // First poll.
+      if (limiter->queue_.empty() &&
+          limiter->in_flight_ < static_cast<size_t>(limiter->limit_)) {
+        limiter->AddInFlightLocked();
+        return absl::StatusOr<Permit>(Permit(limiter_));
+      }
+      auto& queue = limiter->queue_;
+      if (queue.size() >= limiter->options_.max_queue_size) {
+        // Make room by failing the queued call with the latest deadline,
+        // as long as this call's deadline is earlier.
+        if (queue.empty() || (*queue.rbegin())->deadline <= deadline_) {
+          global_stats().IncrementAdaptiveConcurrencyCallsRejected();
+          return absl::StatusOr<Permit>(ShedStatus());
+        }
+        Waiter* evicted = *queue.rbegin();
+        queue.erase(std::prev(queue.end()));
+        evicted->state = Waiter::State::kRejected;
+        wakers.push_back(std::move(evicted->waker));
+      }
+      waiter_ = std::make_unique<Waiter>();
+      waiter_->deadline = deadline_;
+      waiter_->seq = limiter->next_waiter_seq_++;
+      waiter_->enqueue_time = Timestamp::Now();
+      waiter_->waker = Activity::current()->MakeNonOwningWaker();
+      queue.insert(waiter_.get());
+      global_stats().IncrementAdaptiveConcurrencyCallsQueued();
+    } else {
+      switch (waiter_->state) {
+        case Waiter::State::kQueued:
+          break;
+        case Waiter::State::kAdmitted:
+          global_stats().IncrementAdaptiveConcurrencyQueueDelayMs(
+              static_cast<int>(
+                  (Timestamp::Now() - waiter_->enqueue_time).millis()));
+          waiter_.reset();
+          result = absl::StatusOr<Permit>(Permit(limiter_));
+          break;
+        case Waiter::State::kRejected:
+          global_stats().IncrementAdaptiveConcurrencyCallsRejected();
+          waiter_.reset();
+          result = absl::StatusOr<Permit>(ShedStatus());
+          break;
+      }
+    }
+  }
+  for (Waker& waker : wakers) waker.Wakeup();
+  return result;
+}
+
+//
+// ConcurrencyLimiter
+//
+
+bool ConcurrencyLimiter::WaiterLess::operator()(
+    const AcquirePromise::Waiter* a, const AcquirePromise::Waiter* b) const {
+  if (a->deadline != b->deadline) return a->deadline < b->deadline;
+  return a->seq < b->seq;
+}
+
+ConcurrencyLimiter::ConcurrencyLimiter(const Options& options)
+    : options_(options),
+      limit_(Clamp(options.initial_limit, options.min_limit,
+                   options.max_limit)),
+      window_start_(Timestamp::Now()) {}
+
+void ConcurrencyLimiter::AddInFlightLocked() {
+  ++in_flight_;
+  window_max_in_flight_ = std::max(window_max_in_flight_, in_flight_);
+}
+
+void ConcurrencyLimiter::OnCallDone(absl::optional<double> rtt_seconds,
+                                    bool dropped) {
+  std::vector<Waker> wakers;
+  {
+    MutexLock lock(&mu_);
+    GPR_ASSERT(in_flight_ > 0);
+    --in_flight_;
+    const Timestamp now = Timestamp::Now();
+    if (rtt_seconds.has_value()) {
+      window_rtt_sum_seconds_ += *rtt_seconds;
+      ++window_samples_;
+      window_dropped_ |= dropped;
+      MaybeUpdateLimitLocked(now);
+    }
+    DispatchLocked(now, &wakers);
+  }
+  for (Waker& waker : wakers) waker.Wakeup();
+}
+
+void ConcurrencyLimiter::MaybeUpdateLimitLocked(Timestamp now) {
+  if (now - window_start_ < options_.sample_window ||
+      window_samples_ < options_.min_window_samples) {
+    return;
+  }
+  const double sample_rtt = window_rtt_sum_seconds_ / window_samples_;
+  if (++windows_since_min_rtt_reset_ > options_.min_rtt_reset_windows) {
+    windows_since_min_rtt_reset_ = 0;
+    min_rtt_seconds_ = 0;
+  }
+  if (min_rtt_seconds_ == 0 || sample_rtt < min_rtt_seconds_) {
+    min_rtt_seconds_ = sample_rtt;
+  }
+  double new_limit = limit_;
+  if (window_dropped_) {
+    new_limit = limit_ * kBackoffRatio;
+  } else if (window_max_in_flight_ * 2 >= limit_ && sample_rtt > 0) {
+    // Only adjust the limit if it was actually being used: a window in
+    // which fewer than half of the slots were taken says nothing about
+    // whether the limit is too high.
+    const double gradient =
+        Clamp(kRttTolerance * min_rtt_seconds_ / sample_rtt, 0.5, 1.0);
+    // sqrt(limit) leaves some room for calls to queue below us, so that
+    // the limit keeps growing while latency is flat.
+    const double estimate = limit_ * gradient + sqrt(limit_);
+    new_limit = limit_ * (1 - kSmoothing) + estimate * kSmoothing;
+  }
+  limit_ = Clamp(new_limit, static_cast<double>(options_.min_limit),
+                 static_cast<double>(options_.max_limit));
+  global_stats().IncrementAdaptiveConcurrencyLimit(static_cast<int>(limit_));
+  window_start_ = now;
+  window_rtt_sum_seconds_ = 0;
+  window_samples_ = 0;
+  window_max_in_flight_ = in_flight_;
+  window_dropped_ = false;
+}
+
+void ConcurrencyLimiter::DispatchLocked(Timestamp now,
+                                        std::vector<Waker>* wakers) {
+  while (!queue_.empty()) {
+    AcquirePromise::Waiter* waiter = *queue_.begin();
+    if (waiter->deadline <= now) {
+      // Admitting the call would be pointless.
+      waiter->state = AcquirePromise::Waiter::State::kRejected;
+    } else if (in_flight_ < static_cast<size_t>(limit_)) {
+      waiter->state = AcquirePromise::Waiter::State::kAdmitted;
+      AddInFlightLocked();
+    } else {
+      break;
+    }
+    queue_.erase(queue_.begin());
+    wakers->push_back(std::move(waiter->waker));
+  }
+}
+
+}  // namespace grpc_core
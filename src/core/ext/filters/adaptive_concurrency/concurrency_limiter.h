@@ -0,0 +1,229 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_ADAPTIVE_CONCURRENCY_CONCURRENCY_LIMITER_H
+#define GRPC_SRC_CORE_EXT_FILTERS_ADAPTIVE_CONCURRENCY_CONCURRENCY_LIMITER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/status.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/promise/activity.h"
+#include "src/core/lib/promise/poll.h"
+#include "src/core/lib/resolver/server_address.h"
+
+namespace grpc_core {
+
+// Limits the number of calls in flight, adjusting the limit based on the
+// observed latency of completed calls.
+//
+// Completed calls are sampled over a window.  At the end of each window
+// the mean latency of the window is compared with the lowest latency seen
+// so far: while the two are close the limit grows, and as latency
+// increases (i.e. calls are queuing somewhere below us) the limit shrinks
+// in proportion.  The limit is also cut whenever calls fail with
+// RESOURCE_EXHAUSTED or DEADLINE_EXCEEDED.
+//
+// Calls over the limit wait in a queue that is ordered by deadline, so
+// that the calls that will expire first are admitted first.  When the
+// queue is full, the waiting call with the latest deadline is failed to
+// make room for a call with an earlier deadline; otherwise the new call
+// is failed.  Failed calls get RESOURCE_EXHAUSTED.
+class ConcurrencyLimiter : public RefCounted<ConcurrencyLimiter> {
+ public:
+  struct Options {
+    uint32_t initial_limit = 20;
+    uint32_t min_limit = 1;
+    uint32_t max_limit = 1000;
+    // The number of calls that may wait for the limit.  0 means calls over
+    // the limit fail immediately.
+    size_t max_queue_size = 100;
+    // The limit is updated at most once per window, and only once the
+    // window has at least min_window_samples completed calls.
+    Duration sample_window = Duration::Milliseconds(100);
+    uint32_t min_window_samples = 10;
+    // The lowest latency is re-measured every this many windows, so that
+    // the limiter follows changes in the backend's baseline latency.
+    uint32_t min_rtt_reset_windows = 100;
+
+    static Options FromChannelArgs(const ChannelArgs& args);
+  };
+
+  // A slot in the limit, held by a call while it is in flight.
+  class Permit {
+   public:
+    Permit() = default;
+    Permit(const Permit&) = delete;
+    Permit& operator=(const Permit&) = delete;
+    Permit(Permit&& other) noexcept
+        : limiter_(std::move(other.limiter_)), start_(other.start_) {}
+    Permit& operator=(Permit&& other) noexcept {
+      std::swap(limiter_, other.limiter_);
+      std::swap(start_, other.start_);
+      return *this;
+    }
+    // A permit that is not released explicitly (e.g. because the call was
+    // cancelled) frees its slot without contributing a latency sample.
+    ~Permit() {
+      if (limiter_ != nullptr) limiter_->OnCallDone(absl::nullopt, false);
+    }
+
+    // Frees the slot, sampling the latency of the call.
+    void Release(grpc_status_code status);
+
+    // Like Release(), but with a given latency.
+    void TestOnlyRelease(grpc_status_code status, double rtt_seconds);
+
+   private:
+    friend class ConcurrencyLimiter;
+
+    explicit Permit(RefCountedPtr<ConcurrencyLimiter> limiter)
+        : limiter_(std::move(limiter)), start_(gpr_get_cycle_counter()) {}
+
+    RefCountedPtr<ConcurrencyLimiter> limiter_;
+    gpr_cycle_counter start_{};
+  };
+
+  // Promise returned by Acquire().  Dropping it before it resolves removes
+  // the call from the queue.
+  class AcquirePromise {
+   public:
+    AcquirePromise(const AcquirePromise&) = delete;
+    AcquirePromise& operator=(const AcquirePromise&) = delete;
+    AcquirePromise(AcquirePromise&& other) noexcept
+        : limiter_(std::move(other.limiter_)),
+          deadline_(other.deadline_),
+          waiter_(std::move(other.waiter_)) {}
+    AcquirePromise& operator=(AcquirePromise&& other) = delete;
+    ~AcquirePromise();
+
+    Poll<absl::StatusOr<Permit>> operator()();
+
+   private:
+    friend class ConcurrencyLimiter;
+
+    // A queued call.  Guarded by the limiter's mutex.
+    struct Waiter {
+      enum class State { kQueued, kAdmitted, kRejected };
+
+      Timestamp deadline;
+      uint64_t seq;
+      Timestamp enqueue_time;
+      Waker waker;
+      State state = State::kQueued;
+    };
+
+    AcquirePromise(RefCountedPtr<ConcurrencyLimiter> limiter,
+                   Timestamp deadline)
+        : limiter_(std::move(limiter)), deadline_(deadline) {}
+
+    RefCountedPtr<ConcurrencyLimiter> limiter_;
+    Timestamp deadline_;
+    // Set while the call is queued.
+    std::unique_ptr<Waiter> waiter_;
+  };
+
+  explicit ConcurrencyLimiter(const Options& options);
+
+  static absl::string_view ChannelArgName() {
+    return GRPC_ARG_NO_SUBCHANNEL_PREFIX "adaptive_concurrency_limiter";
+  }
+  static int ChannelArgsCompare(const ConcurrencyLimiter* a,
+                                const ConcurrencyLimiter* b) {
+    return QsortCompare(a, b);
+  }
+
+  // Returns a promise that resolves to a permit once the call may proceed,
+  // or to RESOURCE_EXHAUSTED if the call is shed.
+  AcquirePromise Acquire(Timestamp deadline) {
+    return AcquirePromise(Ref(), deadline);
+  }
+
+  uint32_t limit() const {
+    MutexLock lock(&mu_);
+    return static_cast<uint32_t>(limit_);
+  }
+  size_t in_flight() const {
+    MutexLock lock(&mu_);
+    return in_flight_;
+  }
+  size_t queue_size() const {
+    MutexLock lock(&mu_);
+    return queue_.size();
+  }
+
+ private:
+  struct WaiterLess {
+    bool operator()(const AcquirePromise::Waiter* a,
+                    const AcquirePromise::Waiter* b) const;
+  };
+
+  // Called when a call holding a permit finishes.  rtt_seconds is unset if
+  // the call did not produce a latency sample.
+  void OnCallDone(absl::optional<double> rtt_seconds, bool dropped);
+
+  // Ends the sample window and updates the limit, if the window is over.
+  void MaybeUpdateLimitLocked(Timestamp now) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Admits or fails queued calls as the limit allows.  The wakers of the
+  // affected calls are added to wakers, to be woken without the lock held.
+  void DispatchLocked(Timestamp now, std::vector<Waker>* wakers)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  void AddInFlightLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const Options options_;
+
+  mutable Mutex mu_;
+  double limit_ ABSL_GUARDED_BY(mu_);
+  size_t in_flight_ ABSL_GUARDED_BY(mu_) = 0;
+  // Lowest latency seen, or 0 if it is to be re-measured.
+  double min_rtt_seconds_ ABSL_GUARDED_BY(mu_) = 0;
+  uint32_t windows_since_min_rtt_reset_ ABSL_GUARDED_BY(mu_) = 0;
+  // State of the current sample window.
+  Timestamp window_start_ ABSL_GUARDED_BY(mu_);
+  double window_rtt_sum_seconds_ ABSL_GUARDED_BY(mu_) = 0;
+  uint32_t window_samples_ ABSL_GUARDED_BY(mu_) = 0;
+  size_t window_max_in_flight_ ABSL_GUARDED_BY(mu_) = 0;
+  bool window_dropped_ ABSL_GUARDED_BY(mu_) = false;
+  // Queued calls, earliest deadline first.
+  uint64_t next_waiter_seq_ ABSL_GUARDED_BY(mu_) = 0;
+  std::set<AcquirePromise::Waiter*, WaiterLess> queue_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_ADAPTIVE_CONCURRENCY_CONCURRENCY_LIMITER_H
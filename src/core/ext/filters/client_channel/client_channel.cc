@@ -62,11 +62,13 @@
 #include "src/core/ext/filters/client_channel/subchannel.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface_internal.h"
 #include "src/core/ext/filters/deadline/deadline_filter.h"
+#include "src/core/ext/filters/response_cache/response_cache_filter.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channel_trace.h"
 #include "src/core/lib/channel/status_util.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/call_timeline.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
@@ -1049,6 +1051,7 @@ ClientChannel::ClientChannel(grpc_channel_element_args* args,
       interested_parties_(grpc_pollset_set_create()),
       service_config_parser_index_(
           internal::ClientChannelServiceConfigParser::ParserIndex()),
+      response_cache_(ResponseCacheFilter::CreateCache(channel_args_)),
       work_serializer_(std::make_shared<WorkSerializer>()),
       state_tracker_("client_channel", GRPC_CHANNEL_IDLE),
       subchannel_pool_(GetSubchannelPool(channel_args_)) {
@@ -1492,12 +1495,19 @@ void ClientChannel::UpdateServiceConfigInDataPlaneLocked() {
   }
   ChannelArgs new_args =
       channel_args_.SetObject(this).SetObject(service_config);
+  if (response_cache_ != nullptr) {
+    new_args = new_args.SetObject(response_cache_);
+  }
   bool enable_retries =
       !new_args.WantMinimalStack() &&
       new_args.GetBool(GRPC_ARG_ENABLE_RETRIES).value_or(true);
   // Construct dynamic filter stack.
   std::vector<const grpc_channel_filter*> filters =
       config_selector->GetFilters();
+  // The response cache goes first, so that cache hits skip everything else.
+  if (response_cache_ != nullptr) {
+    filters.insert(filters.begin(), &ResponseCacheFilter::kVtable);
+  }
   if (enable_retries) {
     filters.push_back(&RetryFilter::kVtable);
   } else {
@@ -2611,6 +2621,7 @@ void ClientChannel::LoadBalancedCall::AddCallToLbQueuedCallsLocked() {
                                          chand_->interested_parties_);
   // Add to queue.
   chand_->lb_queued_calls_.insert(this);
+  CallTimeline::Record(call_context(), CallPhase::kLbPickQueued);
   OnAddToQueueLocked();
 }
 
@@ -2678,6 +2689,7 @@ absl::optional<absl::Status> ClientChannel::LoadBalancedCall::PickSubchannel(
       return error;
     }
     // Pick succeeded.
+    CallTimeline::Record(call_context(), CallPhase::kLbPickComplete);
     Commit();
     return absl::OkStatus();
   }
@@ -43,6 +43,7 @@
 #include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
 #include "src/core/ext/filters/client_channel/subchannel.h"
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
+#include "src/core/ext/filters/response_cache/response_cache.h"
 #include "src/core/lib/channel/call_tracer.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_fwd.h"
@@ -291,6 +292,8 @@ class ClientChannel {
   channelz::ChannelNode* channelz_node_;
   grpc_pollset_set* interested_parties_;
   const size_t service_config_parser_index_;
+  // Null if response caching is disabled.
+  const RefCountedPtr<ResponseCache> response_cache_;
 
   //
   // Fields related to name resolution.  Guarded by resolution_mu_.
@@ -22,44 +22,78 @@
 
 #include <utility>
 
+#include "absl/hash/hash.h"
+
 #include "src/core/ext/filters/client_channel/subchannel.h"
 
 namespace grpc_core {
 
+GlobalSubchannelPool::HashedKey::HashedKey(const SubchannelKey& key)
+    : hash(absl::HashOf(key)), key(key) {}
+
 RefCountedPtr<GlobalSubchannelPool> GlobalSubchannelPool::instance() {
   static GlobalSubchannelPool* p = new GlobalSubchannelPool();
   return p->Ref();
 }
 
+std::pair<GlobalSubchannelPool::SubchannelMap,
+          GlobalSubchannelPool::SubchannelMap>
+GlobalSubchannelPool::PublishLocked(size_t index, SubchannelMap map) {
+  LockedMap& write_shard = write_shards_[index];
+  LockedMap& read_shard = read_shards_[index];
+  SubchannelMap old_write_map = std::exchange(write_shard.map, map);
+  MutexLock lock(&read_shard.mu);
+  SubchannelMap old_read_map = std::exchange(read_shard.map, std::move(map));
+  return {std::move(old_write_map), std::move(old_read_map)};
+}
+
 RefCountedPtr<Subchannel> GlobalSubchannelPool::RegisterSubchannel(
     const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
-  if (it != subchannel_map_.end()) {
-    RefCountedPtr<Subchannel> existing = it->second->RefIfNonZero();
-    if (existing != nullptr) return existing;
+  HashedKey hashed_key(key);
+  const size_t index = hashed_key.hash % kShards;
+  LockedMap& shard = write_shards_[index];
+  // Declared before the lock, so that they are destroyed after it is
+  // released.
+  std::pair<SubchannelMap, SubchannelMap> old_maps;
+  MutexLock lock(&shard.mu);
+  const WeakRefCountedPtr<Subchannel>* existing =
+      shard.map.Lookup(hashed_key);
+  if (existing != nullptr) {
+    RefCountedPtr<Subchannel> existing_ref = (*existing)->RefIfNonZero();
+    if (existing_ref != nullptr) return existing_ref;
   }
-  subchannel_map_[key] = constructed.get();
+  old_maps = PublishLocked(
+      index, shard.map.Add(std::move(hashed_key), constructed->WeakRef()));
   return constructed;
 }
 
 void GlobalSubchannelPool::UnregisterSubchannel(const SubchannelKey& key,
                                                 Subchannel* subchannel) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
+  HashedKey hashed_key(key);
+  const size_t index = hashed_key.hash % kShards;
+  LockedMap& shard = write_shards_[index];
+  std::pair<SubchannelMap, SubchannelMap> old_maps;
+  MutexLock lock(&shard.mu);
+  const WeakRefCountedPtr<Subchannel>* existing =
+      shard.map.Lookup(hashed_key);
   // delete only if key hasn't been re-registered to a different subchannel
   // between strong-unreffing and unregistration of subchannel.
-  if (it != subchannel_map_.end() && it->second == subchannel) {
-    subchannel_map_.erase(it);
-  }
+  if (existing == nullptr || existing->get() != subchannel) return;
+  old_maps = PublishLocked(index, shard.map.Remove(hashed_key));
 }
 
 RefCountedPtr<Subchannel> GlobalSubchannelPool::FindSubchannel(
     const SubchannelKey& key) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
-  if (it == subchannel_map_.end()) return nullptr;
-  return it->second->RefIfNonZero();
+  HashedKey hashed_key(key);
+  LockedMap& shard = read_shards_[hashed_key.hash % kShards];
+  SubchannelMap map;
+  {
+    MutexLock lock(&shard.mu);
+    map = shard.map;
+  }
+  const WeakRefCountedPtr<Subchannel>* subchannel = map.Lookup(hashed_key);
+  if (subchannel == nullptr) return nullptr;
+  return (*subchannel)->RefIfNonZero();
 }
 
 }  // namespace grpc_core
@@ -21,11 +21,15 @@
 
 #include <grpc/support/port_platform.h>
 
-#include <map>
+#include <stddef.h>
+
+#include <array>
+#include <utility>
 
 #include "absl/base/thread_annotations.h"
 
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
+#include "src/core/lib/avl/avl.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 
@@ -33,6 +37,13 @@ namespace grpc_core {
 
 // The global subchannel pool. It shares subchannels among channels. There
 // should be only one instance of this class.
+//
+// Subchannels are spread across shards by key hash, so that channels
+// registering unrelated subchannels do not contend.  Each shard keeps its
+// map in a persistent AVL tree, and a second, read-only copy of it behind
+// its own mutex: readers only hold that mutex to take a reference to the
+// current tree and do their lookup without any lock, while writers update
+// the write copy and then publish it.
 class GlobalSubchannelPool final : public SubchannelPoolInterface {
  public:
   // Gets the singleton instance.
@@ -40,22 +51,54 @@ class GlobalSubchannelPool final : public SubchannelPoolInterface {
 
   // Implements interface methods.
   RefCountedPtr<Subchannel> RegisterSubchannel(
-      const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) override
-      ABSL_LOCKS_EXCLUDED(mu_);
+      const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) override;
   void UnregisterSubchannel(const SubchannelKey& key,
-                            Subchannel* subchannel) override
-      ABSL_LOCKS_EXCLUDED(mu_);
-  RefCountedPtr<Subchannel> FindSubchannel(const SubchannelKey& key) override
-      ABSL_LOCKS_EXCLUDED(mu_);
+                            Subchannel* subchannel) override;
+  RefCountedPtr<Subchannel> FindSubchannel(const SubchannelKey& key) override;
 
  private:
   GlobalSubchannelPool() {}
   ~GlobalSubchannelPool() override {}
 
-  // A map from subchannel key to subchannel.
-  std::map<SubchannelKey, Subchannel*> subchannel_map_ ABSL_GUARDED_BY(mu_);
-  // To protect subchannel_map_.
-  Mutex mu_;
+  static constexpr size_t kShards = 127;
+
+  // Orders keys by hash first, so that finding a key in a shard mostly
+  // compares hashes rather than channel args.
+  struct HashedKey {
+    explicit HashedKey(const SubchannelKey& key);
+
+    bool operator<(const HashedKey& other) const {
+      if (hash != other.hash) return hash < other.hash;
+      return key < other.key;
+    }
+    bool operator>(const HashedKey& other) const { return other < *this; }
+
+    size_t hash;
+    SubchannelKey key;
+  };
+
+  // Holds weak refs, so that a reader that took a reference to a tree
+  // before a subchannel was unregistered can still call RefIfNonZero() on
+  // it.
+  using SubchannelMap = AVL<HashedKey, WeakRefCountedPtr<Subchannel>>;
+
+  struct LockedMap {
+    Mutex mu;
+    SubchannelMap map ABSL_GUARDED_BY(mu);
+  };
+  using ShardedMap = std::array<LockedMap, kShards>;
+
+  // Replaces the map of shard index with map in both write_shards_ and
+  // read_shards_.  Returns the old trees, so that the caller can drop them
+  // (and possibly the last refs to subchannels) after releasing the lock.
+  std::pair<SubchannelMap, SubchannelMap> PublishLocked(size_t index,
+                                                        SubchannelMap map)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(write_shards_[index].mu);
+
+  // The maps that RegisterSubchannel() and UnregisterSubchannel() update.
+  ShardedMap write_shards_;
+  // Copies of write_shards_ for FindSubchannel().
+  ShardedMap read_shards_;
 };
 
 }  // namespace grpc_core
@@ -0,0 +1,749 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/connectivity_state.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thread_local_random.h"
+#include "src/core/lib/gprpp/validation_errors.h"
+#include "src/core/lib/gprpp/work_serializer.h"
+#include "src/core/lib/iomgr/resolved_address.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_args.h"
+#include "src/core/lib/json/json_object_loader.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/lb_policy_factory.h"
+#include "src/core/lib/load_balancing/subchannel_interface.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_least_request_trace(false, "least_request_lb");
+
+namespace {
+
+constexpr absl::string_view kLeastRequest = "least_request_experimental";
+
+// Picks use more random choices than this only at a cost in pick latency
+// that is not worth paying, so larger values are capped.
+constexpr uint32_t kMaxChoiceCount = 10;
+
+// Config for least_request LB policy.
+class LeastRequestConfig : public LoadBalancingPolicy::Config {
+ public:
+  LeastRequestConfig() = default;
+
+  LeastRequestConfig(const LeastRequestConfig&) = delete;
+  LeastRequestConfig& operator=(const LeastRequestConfig&) = delete;
+
+  LeastRequestConfig(LeastRequestConfig&&) = delete;
+  LeastRequestConfig& operator=(LeastRequestConfig&&) = delete;
+
+  absl::string_view name() const override { return kLeastRequest; }
+
+  uint32_t choice_count() const { return choice_count_; }
+  bool enable_orca_weighting() const { return enable_orca_weighting_; }
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader =
+        JsonObjectLoader<LeastRequestConfig>()
+            .OptionalField("choiceCount", &LeastRequestConfig::choice_count_)
+            .OptionalField("enableOrcaWeighting",
+                           &LeastRequestConfig::enable_orca_weighting_)
+            .Finish();
+    return loader;
+  }
+
+  void JsonPostLoad(const Json&, const JsonArgs&, ValidationErrors* errors) {
+    if (choice_count_ < 2) {
+      ValidationErrors::ScopedField field(errors, ".choiceCount");
+      errors->AddError("must be at least 2");
+    }
+    choice_count_ = std::min(choice_count_, kMaxChoiceCount);
+  }
+
+ private:
+  uint32_t choice_count_ = 2;
+  bool enable_orca_weighting_ = false;
+};
+
+// least_request LB policy.
+class LeastRequest : public LoadBalancingPolicy {
+ public:
+  explicit LeastRequest(Args args);
+
+  absl::string_view name() const override { return kLeastRequest; }
+
+  absl::Status UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  // Tracks the load on a given address.  Shared by the subchannel lists
+  // and pickers for that address, so that calls still in flight are
+  // counted across address list updates.
+  class AddressLoad : public RefCounted<AddressLoad> {
+   public:
+    AddressLoad(RefCountedPtr<LeastRequest> least_request, std::string key)
+        : least_request_(std::move(least_request)), key_(std::move(key)) {}
+    ~AddressLoad() override;
+
+    uint64_t in_flight() const {
+      return in_flight_.load(std::memory_order_relaxed);
+    }
+    float utilization() const {
+      return utilization_.load(std::memory_order_relaxed);
+    }
+
+    void OnCallStarted() { in_flight_.fetch_add(1, std::memory_order_relaxed); }
+
+    // Records that a call has finished.  If backend_metric_data is
+    // non-null, its utilization replaces the last utilization reported.
+    void OnCallFinished(const BackendMetricData* backend_metric_data);
+
+   private:
+    RefCountedPtr<LeastRequest> least_request_;
+    const std::string key_;
+
+    std::atomic<uint64_t> in_flight_{0};
+    std::atomic<float> utilization_{0};
+  };
+
+  // Forward declaration.
+  class LeastRequestSubchannelList;
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  class LeastRequestSubchannelData
+      : public SubchannelData<LeastRequestSubchannelList,
+                              LeastRequestSubchannelData> {
+   public:
+    LeastRequestSubchannelData(
+        SubchannelList<LeastRequestSubchannelList,
+                       LeastRequestSubchannelData>* subchannel_list,
+        const ServerAddress& address, RefCountedPtr<SubchannelInterface> sc);
+
+    absl::optional<grpc_connectivity_state> connectivity_state() const {
+      return logical_connectivity_state_;
+    }
+
+    RefCountedPtr<AddressLoad> load() const { return load_; }
+
+   private:
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state) override;
+
+    // Updates the logical connectivity state.
+    void UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+    // The logical connectivity state of the subchannel.
+    // Note that the logical connectivity state may differ from the
+    // actual reported state in some cases (e.g., after we see
+    // TRANSIENT_FAILURE, we ignore any subsequent state changes until
+    // we see READY).
+    absl::optional<grpc_connectivity_state> logical_connectivity_state_;
+
+    RefCountedPtr<AddressLoad> load_;
+  };
+
+  // A list of subchannels.
+  class LeastRequestSubchannelList
+      : public SubchannelList<LeastRequestSubchannelList,
+                              LeastRequestSubchannelData> {
+   public:
+    LeastRequestSubchannelList(LeastRequest* policy,
+                               ServerAddressList addresses,
+                               const ChannelArgs& args)
+        : SubchannelList(policy,
+                         (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)
+                              ? "LeastRequestSubchannelList"
+                              : nullptr),
+                         std::move(addresses), policy->channel_control_helper(),
+                         args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+    }
+
+    ~LeastRequestSubchannelList() override {
+      LeastRequest* p = static_cast<LeastRequest*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state);
+
+    // Ensures that the right subchannel list is used and then updates
+    // the aggregated connectivity state based on the subchannel list's
+    // state counters.
+    void MaybeUpdateAggregatedConnectivityStateLocked(
+        absl::Status status_for_tf);
+
+   private:
+    std::shared_ptr<WorkSerializer> work_serializer() const override {
+      return static_cast<LeastRequest*>(policy())->work_serializer();
+    }
+
+    std::string CountersString() const {
+      return absl::StrCat("num_subchannels=", num_subchannels(),
+                          " num_ready=", num_ready_,
+                          " num_connecting=", num_connecting_,
+                          " num_transient_failure=", num_transient_failure_);
+    }
+
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+
+    absl::Status last_failure_;
+  };
+
+  // A picker that samples choice_count READY subchannels at random and
+  // picks the one with the lowest load.
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(RefCountedPtr<LeastRequest> least_request,
+           LeastRequestSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // A call tracker that counts the call as in flight on its address
+    // between Start() and Finish(), and collects per-call utilization
+    // reports if ORCA weighting is enabled.
+    class SubchannelCallTracker : public SubchannelCallTrackerInterface {
+     public:
+      SubchannelCallTracker(RefCountedPtr<AddressLoad> load,
+                            bool enable_orca_weighting)
+          : load_(std::move(load)),
+            enable_orca_weighting_(enable_orca_weighting) {}
+
+      void Start() override { load_->OnCallStarted(); }
+
+      void Finish(FinishArgs args) override;
+
+     private:
+      RefCountedPtr<AddressLoad> load_;
+      const bool enable_orca_weighting_;
+    };
+
+    // Info stored about each subchannel.
+    struct SubchannelInfo {
+      SubchannelInfo(RefCountedPtr<SubchannelInterface> subchannel,
+                     RefCountedPtr<AddressLoad> load)
+          : subchannel(std::move(subchannel)), load(std::move(load)) {}
+
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<AddressLoad> load;
+    };
+
+    // Returns the cost of sending one more call to the given subchannel.
+    double Cost(const SubchannelInfo& subchannel_info) const;
+
+    RefCountedPtr<LeastRequest> least_request_;
+    RefCountedPtr<LeastRequestConfig> config_;
+    std::vector<SubchannelInfo> subchannels_;
+  };
+
+  ~LeastRequest() override;
+
+  void ShutdownLocked() override;
+
+  RefCountedPtr<AddressLoad> GetOrCreateLoad(
+      const grpc_resolved_address& address);
+
+  RefCountedPtr<LeastRequestConfig> config_;
+
+  // List of subchannels.
+  RefCountedPtr<LeastRequestSubchannelList> subchannel_list_;
+  // Latest pending subchannel list.
+  // When we get an updated address list, we create a new subchannel list
+  // for it here, and we wait to swap it into subchannel_list_ until the new
+  // list becomes READY.
+  RefCountedPtr<LeastRequestSubchannelList> latest_pending_subchannel_list_;
+
+  Mutex address_load_map_mu_;
+  std::map<std::string, AddressLoad*, std::less<>> address_load_map_
+      ABSL_GUARDED_BY(&address_load_map_mu_);
+
+  bool shutdown_ = false;
+};
+
+//
+// LeastRequest::AddressLoad
+//
+
+LeastRequest::AddressLoad::~AddressLoad() {
+  MutexLock lock(&least_request_->address_load_map_mu_);
+  auto it = least_request_->address_load_map_.find(key_);
+  if (it != least_request_->address_load_map_.end() && it->second == this) {
+    least_request_->address_load_map_.erase(it);
+  }
+}
+
+void LeastRequest::AddressLoad::OnCallFinished(
+    const BackendMetricData* backend_metric_data) {
+  in_flight_.fetch_sub(1, std::memory_order_relaxed);
+  if (backend_metric_data == nullptr) return;
+  double utilization = backend_metric_data->application_utilization;
+  if (utilization <= 0) {
+    utilization = backend_metric_data->cpu_utilization;
+  }
+  utilization_.store(static_cast<float>(std::max(utilization, 0.0)),
+                     std::memory_order_relaxed);
+}
+
+//
+// LeastRequest::Picker::SubchannelCallTracker
+//
+
+void LeastRequest::Picker::SubchannelCallTracker::Finish(FinishArgs args) {
+  load_->OnCallFinished(
+      enable_orca_weighting_
+          ? args.backend_metric_accessor->GetBackendMetricData()
+          : nullptr);
+}
+
+//
+// LeastRequest::Picker
+//
+
+LeastRequest::Picker::Picker(RefCountedPtr<LeastRequest> least_request,
+                             LeastRequestSubchannelList* subchannel_list)
+    : least_request_(std::move(least_request)),
+      config_(least_request_->config_) {
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    LeastRequestSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state() == GRPC_CHANNEL_READY) {
+      subchannels_.emplace_back(sd->subchannel()->Ref(), sd->load());
+    }
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO,
+            "[LR %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels, choice_count=%" PRIu32,
+            least_request_.get(), this, subchannel_list, subchannels_.size(),
+            config_->choice_count());
+  }
+}
+
+double LeastRequest::Picker::Cost(const SubchannelInfo& subchannel_info) const {
+  const double in_flight =
+      static_cast<double>(subchannel_info.load->in_flight());
+  if (!config_->enable_orca_weighting()) return in_flight;
+  // Scale the number of calls in flight, including the one being picked,
+  // by the endpoint's last reported utilization, so that a fully
+  // utilized endpoint counts each of its calls twice.
+  return (in_flight + 1) * (1 + subchannel_info.load->utilization());
+}
+
+LeastRequest::PickResult LeastRequest::Picker::Pick(PickArgs /*args*/) {
+  // Sample choice_count subchannels uniformly at random, with
+  // replacement, and pick the first one seen with the lowest cost.
+  const auto random_index = [this]() {
+    return static_cast<size_t>(((ThreadLocalRandom() >> 32) *
+                                subchannels_.size()) >>
+                               32);
+  };
+  size_t index = 0;
+  if (subchannels_.size() > 1) {
+    index = random_index();
+    double cost = Cost(subchannels_[index]);
+    for (uint32_t i = 1; i < config_->choice_count(); ++i) {
+      const size_t candidate_index = random_index();
+      const double candidate_cost = Cost(subchannels_[candidate_index]);
+      if (candidate_cost < cost) {
+        index = candidate_index;
+        cost = candidate_cost;
+      }
+    }
+  }
+  const SubchannelInfo& subchannel_info = subchannels_[index];
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO,
+            "[LR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
+            least_request_.get(), this, index,
+            subchannel_info.subchannel.get());
+  }
+  return PickResult::Complete(
+      subchannel_info.subchannel,
+      std::make_unique<SubchannelCallTracker>(
+          subchannel_info.load, config_->enable_orca_weighting()));
+}
+
+//
+// LeastRequest
+//
+
+LeastRequest::LeastRequest(Args args) : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Created", this);
+  }
+}
+
+LeastRequest::~LeastRequest() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Destroying least_request LB policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void LeastRequest::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void LeastRequest::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+absl::Status LeastRequest::UpdateLocked(UpdateArgs args) {
+  config_ = std::move(args.config);
+  ServerAddressList addresses;
+  if (args.addresses.ok()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO, "[LR %p] received update with %" PRIuPTR " addresses",
+              this, args.addresses->size());
+    }
+    addresses = std::move(*args.addresses);
+  } else {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO, "[LR %p] received update with address error: %s", this,
+              args.addresses.status().ToString().c_str());
+    }
+    // If we already have a subchannel list, then keep using the existing
+    // list, but still report back that the update was not accepted.
+    if (subchannel_list_ != nullptr) return args.addresses.status();
+  }
+  // Create new subchannel list, replacing the previous pending list, if any.
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace) &&
+      latest_pending_subchannel_list_ != nullptr) {
+    gpr_log(GPR_INFO, "[LR %p] replacing previous pending subchannel list %p",
+            this, latest_pending_subchannel_list_.get());
+  }
+  latest_pending_subchannel_list_ = MakeRefCounted<LeastRequestSubchannelList>(
+      this, std::move(addresses), args.args);
+  latest_pending_subchannel_list_->StartWatchingLocked(args.args);
+  // If the new list is empty, immediately promote it to
+  // subchannel_list_ and report TRANSIENT_FAILURE.
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace) &&
+        subchannel_list_ != nullptr) {
+      gpr_log(GPR_INFO, "[LR %p] replacing previous subchannel list %p", this,
+              subchannel_list_.get());
+    }
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    absl::Status status =
+        args.addresses.ok() ? absl::UnavailableError(absl::StrCat(
+                                  "empty address list: ", args.resolution_note))
+                            : args.addresses.status();
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        MakeRefCounted<TransientFailurePicker>(status));
+    return status;
+  }
+  // Otherwise, if this is the initial update, immediately promote it to
+  // subchannel_list_.
+  if (subchannel_list_.get() == nullptr) {
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+  }
+  return absl::OkStatus();
+}
+
+RefCountedPtr<LeastRequest::AddressLoad> LeastRequest::GetOrCreateLoad(
+    const grpc_resolved_address& address) {
+  // Addresses that cannot be converted to a URI share a single load.
+  auto key = grpc_sockaddr_to_uri(&address);
+  if (!key.ok()) key = std::string();
+  MutexLock lock(&address_load_map_mu_);
+  auto it = address_load_map_.find(*key);
+  if (it != address_load_map_.end()) {
+    auto load = it->second->RefIfNonZero();
+    if (load != nullptr) return load;
+  }
+  auto load =
+      MakeRefCounted<AddressLoad>(Ref(DEBUG_LOCATION, "AddressLoad"), *key);
+  address_load_map_[*key] = load.get();
+  return load;
+}
+
+//
+// LeastRequest::LeastRequestSubchannelList
+//
+
+void LeastRequest::LeastRequestSubchannelList::UpdateStateCountersLocked(
+    absl::optional<grpc_connectivity_state> old_state,
+    grpc_connectivity_state new_state) {
+  if (old_state.has_value()) {
+    GPR_ASSERT(*old_state != GRPC_CHANNEL_SHUTDOWN);
+    if (*old_state == GRPC_CHANNEL_READY) {
+      GPR_ASSERT(num_ready_ > 0);
+      --num_ready_;
+    } else if (*old_state == GRPC_CHANNEL_CONNECTING) {
+      GPR_ASSERT(num_connecting_ > 0);
+      --num_connecting_;
+    } else if (*old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      GPR_ASSERT(num_transient_failure_ > 0);
+      --num_transient_failure_;
+    }
+  }
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+void LeastRequest::LeastRequestSubchannelList::
+    MaybeUpdateAggregatedConnectivityStateLocked(absl::Status status_for_tf) {
+  LeastRequest* p = static_cast<LeastRequest*>(policy());
+  // If this is latest_pending_subchannel_list_, then swap it into
+  // subchannel_list_ in the following cases:
+  // - subchannel_list_ has no READY subchannels.
+  // - This list has at least one READY subchannel and we have seen the
+  //   initial connectivity state notification for all subchannels.
+  // - All of the subchannels in this list are in TRANSIENT_FAILURE.
+  //   (This may cause the channel to go from READY to TRANSIENT_FAILURE,
+  //   but we're doing what the control plane told us to do.)
+  if (p->latest_pending_subchannel_list_.get() == this &&
+      (p->subchannel_list_->num_ready_ == 0 ||
+       (num_ready_ > 0 && AllSubchannelsSeenInitialState()) ||
+       num_transient_failure_ == num_subchannels())) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      const std::string old_counters_string =
+          p->subchannel_list_ != nullptr ? p->subchannel_list_->CountersString()
+                                         : "";
+      gpr_log(
+          GPR_INFO,
+          "[LR %p] swapping out subchannel list %p (%s) in favor of %p (%s)", p,
+          p->subchannel_list_.get(), old_counters_string.c_str(), this,
+          CountersString().c_str());
+    }
+    p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+  }
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  // First matching rule wins:
+  // 1) ANY subchannel is READY => policy is READY.
+  // 2) ANY subchannel is CONNECTING => policy is CONNECTING.
+  // 3) ALL subchannels are TRANSIENT_FAILURE => policy is TRANSIENT_FAILURE.
+  if (num_ready_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO, "[LR %p] reporting READY with subchannel list %p", p,
+              this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_READY, absl::Status(),
+        MakeRefCounted<Picker>(p->Ref(DEBUG_LOCATION, "Picker"), this));
+  } else if (num_connecting_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO, "[LR %p] reporting CONNECTING with subchannel list %p",
+              p, this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        MakeRefCounted<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO,
+              "[LR %p] reporting TRANSIENT_FAILURE with subchannel list %p: %s",
+              p, this, status_for_tf.ToString().c_str());
+    }
+    if (!status_for_tf.ok()) {
+      last_failure_ = absl::UnavailableError(
+          absl::StrCat("connections to all backends failing; last error: ",
+                       status_for_tf.ToString()));
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, last_failure_,
+        MakeRefCounted<TransientFailurePicker>(last_failure_));
+  }
+}
+
+//
+// LeastRequest::LeastRequestSubchannelData
+//
+
+LeastRequest::LeastRequestSubchannelData::LeastRequestSubchannelData(
+    SubchannelList<LeastRequestSubchannelList, LeastRequestSubchannelData>*
+        subchannel_list,
+    const ServerAddress& address, RefCountedPtr<SubchannelInterface> sc)
+    : SubchannelData(subchannel_list, address, std::move(sc)),
+      load_(static_cast<LeastRequest*>(subchannel_list->policy())
+                ->GetOrCreateLoad(address.address())) {}
+
+void LeastRequest::LeastRequestSubchannelData::ProcessConnectivityChangeLocked(
+    absl::optional<grpc_connectivity_state> old_state,
+    grpc_connectivity_state new_state) {
+  LeastRequest* p = static_cast<LeastRequest*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If this is not the initial state notification and the new state is
+  // TRANSIENT_FAILURE or IDLE, re-resolve.
+  // Note that we don't want to do this on the initial state notification,
+  // because that would result in an endless loop of re-resolution.
+  if (old_state.has_value() && (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+                                new_state == GRPC_CHANNEL_IDLE)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO,
+              "[LR %p] Subchannel %p reported %s; requesting re-resolution", p,
+              subchannel(), ConnectivityStateName(new_state));
+    }
+    p->channel_control_helper()->RequestReresolution();
+  }
+  if (new_state == GRPC_CHANNEL_IDLE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO,
+              "[LR %p] Subchannel %p reported IDLE; requesting connection", p,
+              subchannel());
+    }
+    subchannel()->RequestConnection();
+  }
+  // Update logical connectivity state.
+  UpdateLogicalConnectivityStateLocked(new_state);
+  // Update the policy state.
+  subchannel_list()->MaybeUpdateAggregatedConnectivityStateLocked(
+      connectivity_status());
+}
+
+void LeastRequest::LeastRequestSubchannelData::
+    UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state) {
+  LeastRequest* p = static_cast<LeastRequest*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[LR %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        (logical_connectivity_state_.has_value()
+             ? ConnectivityStateName(*logical_connectivity_state_)
+             : "N/A"),
+        ConnectivityStateName(connectivity_state));
+  }
+  // Decide what state to report for aggregation purposes.
+  // If the last logical state was TRANSIENT_FAILURE, then ignore the
+  // state change unless the new state is READY.
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
+      connectivity_state != GRPC_CHANNEL_READY) {
+    return;
+  }
+  // If the new state is IDLE, treat it as CONNECTING, since it will
+  // immediately transition into CONNECTING anyway.
+  if (connectivity_state == GRPC_CHANNEL_IDLE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO,
+              "[LR %p] subchannel %p, subchannel_list %p (index %" PRIuPTR
+              " of %" PRIuPTR "): treating IDLE as CONNECTING",
+              p, subchannel(), subchannel_list(), Index(),
+              subchannel_list()->num_subchannels());
+    }
+    connectivity_state = GRPC_CHANNEL_CONNECTING;
+  }
+  // If no change, return false.
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == connectivity_state) {
+    return;
+  }
+  // Otherwise, update counters and logical state.
+  subchannel_list()->UpdateStateCountersLocked(logical_connectivity_state_,
+                                               connectivity_state);
+  logical_connectivity_state_ = connectivity_state;
+}
+
+//
+// factory
+//
+
+class LeastRequestFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<LeastRequest>(std::move(args));
+  }
+
+  absl::string_view name() const override { return kLeastRequest; }
+
+  absl::StatusOr<RefCountedPtr<LoadBalancingPolicy::Config>>
+  ParseLoadBalancingConfig(const Json& json) const override {
+    return LoadFromJson<RefCountedPtr<LeastRequestConfig>>(
+        json, JsonArgs(), "errors validating least_request LB policy config");
+  }
+};
+
+}  // namespace
+
+void RegisterLeastRequestLbPolicy(CoreConfiguration::Builder* builder) {
+  builder->lb_policy_registry()->RegisterLoadBalancingPolicyFactory(
+      std::make_unique<LeastRequestFactory>());
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,245 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+#define XXH_INLINE_ALL
+#include "xxhash.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash_lb_policy.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/validation_errors.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_args.h"
+#include "src/core/lib/json/json_object_loader.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/lb_policy_factory.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_maglev_trace(false, "maglev_lb");
+
+namespace {
+
+constexpr absl::string_view kMaglev = "maglev_experimental";
+
+// The lookup table size must be prime, so that every skip value generates
+// a full permutation of the table.  The default and maximum are the same
+// as Envoy's.
+constexpr uint64_t kDefaultTableSize = 65537;
+constexpr uint64_t kMaxTableSize = 5000011;
+
+bool IsPrime(uint64_t n) {
+  if (n < 2) return false;
+  for (uint64_t i = 2; i * i <= n; ++i) {
+    if (n % i == 0) return false;
+  }
+  return true;
+}
+
+struct MaglevConfig {
+  uint64_t table_size = kDefaultTableSize;
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader =
+        JsonObjectLoader<MaglevConfig>()
+            .OptionalField("tableSize", &MaglevConfig::table_size)
+            .Finish();
+    return loader;
+  }
+
+  void JsonPostLoad(const Json&, const JsonArgs&, ValidationErrors* errors) {
+    ValidationErrors::ScopedField field(errors, ".tableSize");
+    if (!errors->FieldHasErrors() &&
+        (table_size > kMaxTableSize || !IsPrime(table_size))) {
+      errors->AddError(absl::StrCat("must be a prime number no larger than ",
+                                    kMaxTableSize));
+    }
+  }
+};
+
+class MaglevLbConfig : public LoadBalancingPolicy::Config {
+ public:
+  explicit MaglevLbConfig(size_t table_size) : table_size_(table_size) {}
+  absl::string_view name() const override { return kMaglev; }
+  size_t table_size() const { return table_size_; }
+
+ private:
+  size_t table_size_;
+};
+
+//
+// maglev LB policy
+//
+
+class Maglev : public ConsistentHashLbPolicy {
+ public:
+  explicit Maglev(Args args)
+      : ConsistentHashLbPolicy(std::move(args), &grpc_lb_maglev_trace,
+                               "MAGLEV", "maglev") {}
+
+  absl::string_view name() const override { return kMaglev; }
+
+ private:
+  // The Maglev lookup table maps each of a fixed, prime number of slots
+  // to a subchannel.  Each subchannel fills the slots in the order of
+  // its own permutation of the table, which is derived from a hash of
+  // its address, taking turns in proportion to its weight until the
+  // table is full.  Since the permutations depend only on the addresses,
+  // adding or removing a subchannel changes only a small fraction of
+  // the slots of the other subchannels.
+  class MaglevTable : public Table {
+   public:
+    MaglevTable(MaglevLbConfig* config, HashSubchannelList* subchannel_list);
+
+    size_t size() const override { return entries_.size(); }
+
+    // Unlike a ring, every slot is equally likely to be hit, so the
+    // request hash maps directly to a slot.
+    size_t FindIndex(uint64_t hash) const override {
+      return hash % entries_.size();
+    }
+
+    size_t subchannel_index(size_t index) const override {
+      return entries_[index];
+    }
+
+   private:
+    // For each slot, the index of its subchannel.
+    std::vector<uint32_t> entries_;
+  };
+
+  RefCountedPtr<Table> CreateTable(HashSubchannelList* subchannel_list,
+                                   const ChannelArgs& /*args*/) override {
+    return MakeRefCounted<MaglevTable>(static_cast<MaglevLbConfig*>(config()),
+                                       subchannel_list);
+  }
+};
+
+//
+// Maglev::MaglevTable
+//
+
+Maglev::MaglevTable::MaglevTable(MaglevLbConfig* config,
+                                 HashSubchannelList* subchannel_list) {
+  const size_t num_subchannels = subchannel_list->num_subchannels();
+  if (num_subchannels == 0) return;
+  const uint64_t table_size = config->table_size();
+  // Each subchannel's permutation of the slots is offset, offset + skip,
+  // offset + 2 * skip, ... (mod table_size).  Since table_size is prime
+  // and skip is non-zero, this visits every slot exactly once.
+  struct BuildEntry {
+    uint64_t offset;
+    uint64_t skip;
+    double weight;
+    // The number of slots taken so far, scaled by the maximum weight.
+    double target_weight = 0;
+    // The position in the permutation to try next.
+    uint64_t next = 0;
+  };
+  std::vector<BuildEntry> build_entries;
+  build_entries.reserve(num_subchannels);
+  double max_weight = 0;
+  for (size_t i = 0; i < num_subchannels; ++i) {
+    HashSubchannelData* sd = subchannel_list->subchannel(i);
+    const std::string address =
+        grpc_sockaddr_to_string(&sd->address().address(), false).value();
+    // Default weight is 1 for the cases where a weight is not provided.
+    // Weight should never be zero, but ignore it just in case, since
+    // that value would keep the subchannel from ever taking a turn.
+    const auto weight_arg =
+        sd->address().args().GetInt(GRPC_ARG_ADDRESS_WEIGHT);
+    BuildEntry entry;
+    entry.offset = XXH64(address.data(), address.size(), 0) % table_size;
+    entry.skip =
+        XXH64(address.data(), address.size(), 1) % (table_size - 1) + 1;
+    entry.weight = weight_arg.value_or(0) > 0 ? *weight_arg : 1;
+    max_weight = std::max(max_weight, entry.weight);
+    build_entries.push_back(entry);
+  }
+  // Subchannels take turns claiming their next free slot.  On each
+  // iteration, a subchannel takes a turn only if its share of the slots so
+  // far is no more than its weight allows, so a subchannel with the
+  // maximum weight takes a turn on every iteration, and one with a third of
+  // that weight takes a turn on every third iteration.
+  const uint32_t kEmpty = static_cast<uint32_t>(num_subchannels);
+  entries_.assign(table_size, kEmpty);
+  uint64_t num_filled = 0;
+  for (uint64_t iteration = 1; num_filled < table_size; ++iteration) {
+    for (size_t i = 0; i < num_subchannels && num_filled < table_size; ++i) {
+      BuildEntry& entry = build_entries[i];
+      if (iteration * entry.weight < entry.target_weight) continue;
+      entry.target_weight += max_weight;
+      uint64_t slot;
+      do {
+        slot = (entry.offset + entry.next * entry.skip) % table_size;
+        ++entry.next;
+      } while (entries_[slot] != kEmpty);
+      entries_[slot] = static_cast<uint32_t>(i);
+      ++num_filled;
+    }
+  }
+}
+
+//
+// factory
+//
+
+class MaglevFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<Maglev>(std::move(args));
+  }
+
+  absl::string_view name() const override { return kMaglev; }
+
+  absl::StatusOr<RefCountedPtr<LoadBalancingPolicy::Config>>
+  ParseLoadBalancingConfig(const Json& json) const override {
+    auto config = LoadFromJson<MaglevConfig>(
+        json, JsonArgs(), "errors validating maglev LB policy config");
+    if (!config.ok()) return config.status();
+    return MakeRefCounted<MaglevLbConfig>(config->table_size);
+  }
+};
+
+}  // namespace
+
+void RegisterMaglevLbPolicy(CoreConfiguration::Builder* builder) {
+  builder->lb_policy_registry()->RegisterLoadBalancingPolicyFactory(
+      std::make_unique<MaglevFactory>());
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,514 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash_lb_policy.h"
+
+#include <inttypes.h>
+
+#include <string>
+#include <utility>
+
+#include "absl/base/attributes.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/client_channel_internal.h"
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+//
+// ConsistentHashLbPolicy::Picker::SubchannelConnectionAttempter
+//
+
+// A fire-and-forget class that schedules subchannel connection attempts
+// on the control plane WorkSerializer.
+class ConsistentHashLbPolicy::Picker::SubchannelConnectionAttempter
+    : public Orphanable {
+ public:
+  explicit SubchannelConnectionAttempter(
+      RefCountedPtr<ConsistentHashLbPolicy> policy)
+      : policy_(std::move(policy)) {
+    GRPC_CLOSURE_INIT(&closure_, RunInExecCtx, this, nullptr);
+  }
+
+  void Orphan() override {
+    // Hop into ExecCtx, so that we're not holding the data plane mutex
+    // while we run control-plane code.
+    ExecCtx::Run(DEBUG_LOCATION, &closure_, absl::OkStatus());
+  }
+
+  void AddSubchannel(RefCountedPtr<SubchannelInterface> subchannel) {
+    subchannels_.push_back(std::move(subchannel));
+  }
+
+ private:
+  static void RunInExecCtx(void* arg, grpc_error_handle /*error*/) {
+    auto* self = static_cast<SubchannelConnectionAttempter*>(arg);
+    self->policy_->work_serializer()->Run(
+        [self]() {
+          if (!self->policy_->shutdown_) {
+            for (auto& subchannel : self->subchannels_) {
+              subchannel->RequestConnection();
+            }
+          }
+          delete self;
+        },
+        DEBUG_LOCATION);
+  }
+
+  RefCountedPtr<ConsistentHashLbPolicy> policy_;
+  grpc_closure closure_;
+  std::vector<RefCountedPtr<SubchannelInterface>> subchannels_;
+};
+
+//
+// ConsistentHashLbPolicy::Picker
+//
+
+ConsistentHashLbPolicy::Picker::Picker(
+    RefCountedPtr<ConsistentHashLbPolicy> policy,
+    HashSubchannelList* subchannel_list)
+    : policy_(std::move(policy)), table_(subchannel_list->table()) {
+  subchannels_.reserve(subchannel_list->num_subchannels());
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    HashSubchannelData* subchannel_data = subchannel_list->subchannel(i);
+    subchannels_.emplace_back(
+        SubchannelInfo{subchannel_data->subchannel()->Ref(),
+                       subchannel_data->logical_connectivity_state(),
+                       subchannel_data->logical_connectivity_status()});
+    if (subchannel_data->logical_connectivity_state() == GRPC_CHANNEL_READY) {
+      ++num_ready_;
+    }
+  }
+}
+
+ConsistentHashLbPolicy::PickResult ConsistentHashLbPolicy::Picker::Pick(
+    PickArgs args) {
+  auto* call_state = static_cast<ClientChannelLbCallState*>(args.call_state);
+  auto* hash_attribute = static_cast<RequestHashAttribute*>(
+      call_state->GetCallAttribute(RequestHashAttribute::TypeName()));
+  absl::string_view hash;
+  if (hash_attribute != nullptr) {
+    hash = hash_attribute->request_hash();
+  }
+  uint64_t h;
+  if (!absl::SimpleAtoi(hash, &h)) {
+    return PickResult::Fail(absl::InternalError(
+        absl::StrCat(policy_->description_, " value is not a number")));
+  }
+  const Table& table = *table_;
+  const size_t first_index = table.FindIndex(h);
+  OrphanablePtr<SubchannelConnectionAttempter> subchannel_connection_attempter;
+  auto ScheduleSubchannelConnectionAttempt =
+      [&](RefCountedPtr<SubchannelInterface> subchannel) {
+        if (subchannel_connection_attempter == nullptr) {
+          subchannel_connection_attempter =
+              MakeOrphanable<SubchannelConnectionAttempter>(policy_->Ref(
+                  DEBUG_LOCATION, "SubchannelConnectionAttempter"));
+        }
+        subchannel_connection_attempter->AddSubchannel(std::move(subchannel));
+      };
+  const size_t first_subchannel_index = table.subchannel_index(first_index);
+  SubchannelInfo& first_subchannel = subchannels_[first_subchannel_index];
+  switch (first_subchannel.state) {
+    case GRPC_CHANNEL_READY:
+      return PickReady(first_index);
+    case GRPC_CHANNEL_IDLE:
+      ScheduleSubchannelConnectionAttempt(first_subchannel.subchannel);
+      ABSL_FALLTHROUGH_INTENDED;
+    case GRPC_CHANNEL_CONNECTING:
+      return PickResult::Queue();
+    default:  // GRPC_CHANNEL_TRANSIENT_FAILURE
+      break;
+  }
+  ScheduleSubchannelConnectionAttempt(first_subchannel.subchannel);
+  // Loop through remaining subchannels to find one in READY.
+  // On the way, we make sure the right set of connection attempts
+  // will happen.
+  bool found_second_subchannel = false;
+  bool found_first_non_failed = false;
+  for (size_t i = 1; i < table.size(); ++i) {
+    const size_t index = (first_index + i) % table.size();
+    const size_t subchannel_index = table.subchannel_index(index);
+    if (subchannel_index == first_subchannel_index) continue;
+    SubchannelInfo& subchannel_info = subchannels_[subchannel_index];
+    if (subchannel_info.state == GRPC_CHANNEL_READY) return PickReady(index);
+    if (!found_second_subchannel) {
+      switch (subchannel_info.state) {
+        case GRPC_CHANNEL_IDLE:
+          ScheduleSubchannelConnectionAttempt(subchannel_info.subchannel);
+          ABSL_FALLTHROUGH_INTENDED;
+        case GRPC_CHANNEL_CONNECTING:
+          return PickResult::Queue();
+        default:
+          break;
+      }
+      found_second_subchannel = true;
+    }
+    if (!found_first_non_failed) {
+      if (subchannel_info.state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+        ScheduleSubchannelConnectionAttempt(subchannel_info.subchannel);
+      } else {
+        if (subchannel_info.state == GRPC_CHANNEL_IDLE) {
+          ScheduleSubchannelConnectionAttempt(subchannel_info.subchannel);
+        }
+        found_first_non_failed = true;
+      }
+    }
+  }
+  return PickResult::Fail(absl::UnavailableError(absl::StrCat(
+      policy_->description_,
+      " cannot find a connected subchannel; first failure: ",
+      first_subchannel.status.ToString())));
+}
+
+ConsistentHashLbPolicy::PickResult ConsistentHashLbPolicy::Picker::PickReady(
+    size_t index) {
+  return PickResult::Complete(
+      subchannels_[table_->subchannel_index(index)].subchannel);
+}
+
+//
+// ConsistentHashLbPolicy::HashSubchannelList
+//
+
+ConsistentHashLbPolicy::HashSubchannelList::HashSubchannelList(
+    ConsistentHashLbPolicy* policy, ServerAddressList addresses,
+    const ChannelArgs& args)
+    : SubchannelList(policy,
+                     (GRPC_TRACE_FLAG_ENABLED(*policy->tracer_)
+                          ? "HashSubchannelList"
+                          : nullptr),
+                     std::move(addresses), policy->channel_control_helper(),
+                     args),
+      num_idle_(num_subchannels()) {
+  // Need to maintain a ref to the LB policy as long as we maintain
+  // any references to subchannels, since the subchannels'
+  // pollset_sets will include the LB policy's pollset_set.
+  policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+  // Construct the table.
+  table_ = policy->CreateTable(this, args);
+  if (GRPC_TRACE_FLAG_ENABLED(*policy->tracer_)) {
+    gpr_log(GPR_INFO,
+            "[%s %p] created subchannel list %p with %" PRIuPTR
+            " table entries",
+            policy->log_prefix_, policy, this, table_->size());
+  }
+}
+
+ConsistentHashLbPolicy::HashSubchannelList::~HashSubchannelList() {
+  ConsistentHashLbPolicy* p = static_cast<ConsistentHashLbPolicy*>(policy());
+  p->Unref(DEBUG_LOCATION, "subchannel_list");
+}
+
+void ConsistentHashLbPolicy::HashSubchannelList::UpdateStateCountersLocked(
+    grpc_connectivity_state old_state, grpc_connectivity_state new_state) {
+  if (old_state == GRPC_CHANNEL_IDLE) {
+    GPR_ASSERT(num_idle_ > 0);
+    --num_idle_;
+  } else if (old_state == GRPC_CHANNEL_READY) {
+    GPR_ASSERT(num_ready_ > 0);
+    --num_ready_;
+  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
+    GPR_ASSERT(num_connecting_ > 0);
+    --num_connecting_;
+  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    GPR_ASSERT(num_transient_failure_ > 0);
+    --num_transient_failure_;
+  }
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (new_state == GRPC_CHANNEL_IDLE) {
+    ++num_idle_;
+  } else if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+void ConsistentHashLbPolicy::HashSubchannelList::UpdateConnectivityStateLocked(
+    size_t index, bool connection_attempt_complete, absl::Status status) {
+  ConsistentHashLbPolicy* p = static_cast<ConsistentHashLbPolicy*>(policy());
+  // If this is latest_pending_subchannel_list_, then swap it into
+  // subchannel_list_ as soon as we get the initial connectivity state
+  // report for every subchannel in the list.
+  if (p->latest_pending_subchannel_list_.get() == this &&
+      AllSubchannelsSeenInitialState()) {
+    if (GRPC_TRACE_FLAG_ENABLED(*p->tracer_)) {
+      gpr_log(GPR_INFO, "[%s %p] replacing subchannel list %p with %p",
+              p->log_prefix_, p, p->subchannel_list_.get(), this);
+    }
+    p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+  }
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  // The overall aggregation rules here are:
+  // 1. If there is at least one subchannel in READY state, report READY.
+  // 2. If there are 2 or more subchannels in TRANSIENT_FAILURE state, report
+  //    TRANSIENT_FAILURE.
+  // 3. If there is at least one subchannel in CONNECTING state, report
+  //    CONNECTING.
+  // 4. If there is one subchannel in TRANSIENT_FAILURE state and there is
+  //    more than one subchannel, report CONNECTING.
+  // 5. If there is at least one subchannel in IDLE state, report IDLE.
+  // 6. Otherwise, report TRANSIENT_FAILURE.
+  //
+  // We set start_connection_attempt to true if we match rules 2, 3, or 6.
+  grpc_connectivity_state state;
+  bool start_connection_attempt = false;
+  if (num_ready_ > 0) {
+    state = GRPC_CHANNEL_READY;
+  } else if (num_transient_failure_ >= 2) {
+    state = GRPC_CHANNEL_TRANSIENT_FAILURE;
+    start_connection_attempt = true;
+  } else if (num_connecting_ > 0) {
+    state = GRPC_CHANNEL_CONNECTING;
+  } else if (num_transient_failure_ == 1 && num_subchannels() > 1) {
+    state = GRPC_CHANNEL_CONNECTING;
+    start_connection_attempt = true;
+  } else if (num_idle_ > 0) {
+    state = GRPC_CHANNEL_IDLE;
+  } else {
+    state = GRPC_CHANNEL_TRANSIENT_FAILURE;
+    start_connection_attempt = true;
+  }
+  // In TRANSIENT_FAILURE, report the last reported failure.
+  // Otherwise, report OK.
+  if (state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    if (!status.ok()) {
+      last_failure_ = absl::UnavailableError(absl::StrCat(
+          "no reachable subchannels; last error: ", status.ToString()));
+    }
+    status = last_failure_;
+  } else {
+    status = absl::OkStatus();
+  }
+  // Generate new picker and return it to the channel.
+  // Note that we use our own picker regardless of connectivity state.
+  p->channel_control_helper()->UpdateState(state, status,
+                                           p->CreatePicker(this));
+  // While the policy is reporting TRANSIENT_FAILURE, it will
+  // not be getting any pick requests from the priority policy.
+  // However, because the policy does not attempt to
+  // reconnect to subchannels unless it is getting pick requests,
+  // it will need special handling to ensure that it will eventually
+  // recover from TRANSIENT_FAILURE state once the problem is resolved.
+  // Specifically, it will make sure that it is attempting to connect to
+  // at least one subchannel at any given time.  After a given subchannel
+  // fails a connection attempt, it will move on to the next subchannel
+  // in the list.  It will keep doing this until one of the subchannels
+  // successfully connects, at which point it will report READY and stop
+  // proactively trying to connect.  The policy will remain in
+  // TRANSIENT_FAILURE until at least one subchannel becomes connected,
+  // even if subchannels are in state CONNECTING during that time.
+  //
+  // Note that we do the same thing when the policy is in state
+  // CONNECTING, just to ensure that we don't remain in CONNECTING state
+  // indefinitely if there are no new picks coming in.
+  if (internally_triggered_connection_index_.has_value() &&
+      *internally_triggered_connection_index_ == index &&
+      connection_attempt_complete) {
+    internally_triggered_connection_index_.reset();
+  }
+  if (start_connection_attempt &&
+      !internally_triggered_connection_index_.has_value()) {
+    size_t next_index = (index + 1) % num_subchannels();
+    if (GRPC_TRACE_FLAG_ENABLED(*p->tracer_)) {
+      gpr_log(GPR_INFO,
+              "[%s %p] triggering internal connection attempt for subchannel "
+              "%p, subchannel_list %p (index %" PRIuPTR " of %" PRIuPTR ")",
+              p->log_prefix_, p, subchannel(next_index)->subchannel(), this,
+              next_index, num_subchannels());
+    }
+    internally_triggered_connection_index_ = next_index;
+    subchannel(next_index)->subchannel()->RequestConnection();
+  }
+}
+
+//
+// ConsistentHashLbPolicy::HashSubchannelData
+//
+
+void ConsistentHashLbPolicy::HashSubchannelData::
+    ProcessConnectivityChangeLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state) {
+  ConsistentHashLbPolicy* p =
+      static_cast<ConsistentHashLbPolicy*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(*p->tracer_)) {
+    gpr_log(
+        GPR_INFO,
+        "[%s %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p->log_prefix_, p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        ConnectivityStateName(logical_connectivity_state_),
+        ConnectivityStateName(new_state));
+  }
+  GPR_ASSERT(subchannel() != nullptr);
+  // If this is not the initial state notification and the new state is
+  // TRANSIENT_FAILURE or IDLE, re-resolve.
+  // Note that we don't want to do this on the initial state notification,
+  // because that would result in an endless loop of re-resolution.
+  if (old_state.has_value() && (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+                                new_state == GRPC_CHANNEL_IDLE)) {
+    if (GRPC_TRACE_FLAG_ENABLED(*p->tracer_)) {
+      gpr_log(GPR_INFO,
+              "[%s %p] Subchannel %p reported %s; requesting re-resolution",
+              p->log_prefix_, p, subchannel(),
+              ConnectivityStateName(new_state));
+    }
+    p->channel_control_helper()->RequestReresolution();
+  }
+  const bool connection_attempt_complete = new_state != GRPC_CHANNEL_CONNECTING;
+  // Decide what state to report for the purposes of aggregation and
+  // picker behavior.
+  // If the last recorded state was TRANSIENT_FAILURE, ignore the change
+  // unless the new state is READY (or TF again, in which case we need
+  // to update the status).
+  if (logical_connectivity_state_ != GRPC_CHANNEL_TRANSIENT_FAILURE ||
+      new_state == GRPC_CHANNEL_READY ||
+      new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    // Update state counters used for aggregation.
+    subchannel_list()->UpdateStateCountersLocked(logical_connectivity_state_,
+                                                 new_state);
+    // Update logical state.
+    logical_connectivity_state_ = new_state;
+    logical_connectivity_status_ = connectivity_status();
+  }
+  // Update the policy's connectivity state, creating new picker.
+  subchannel_list()->UpdateConnectivityStateLocked(
+      Index(), connection_attempt_complete, logical_connectivity_status_);
+}
+
+//
+// ConsistentHashLbPolicy
+//
+
+ConsistentHashLbPolicy::ConsistentHashLbPolicy(Args args, TraceFlag* tracer,
+                                               const char* log_prefix,
+                                               absl::string_view description)
+    : LoadBalancingPolicy(std::move(args)),
+      tracer_(tracer),
+      log_prefix_(log_prefix),
+      description_(description) {
+  if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
+    gpr_log(GPR_INFO, "[%s %p] Created", log_prefix_, this);
+  }
+}
+
+ConsistentHashLbPolicy::~ConsistentHashLbPolicy() {
+  if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
+    gpr_log(GPR_INFO, "[%s %p] Destroying %s policy", log_prefix_, this,
+            std::string(description_).c_str());
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void ConsistentHashLbPolicy::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
+    gpr_log(GPR_INFO, "[%s %p] Shutting down", log_prefix_, this);
+  }
+  shutdown_ = true;
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void ConsistentHashLbPolicy::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+RefCountedPtr<LoadBalancingPolicy::SubchannelPicker>
+ConsistentHashLbPolicy::CreatePicker(HashSubchannelList* subchannel_list) {
+  return MakeRefCounted<Picker>(Ref(DEBUG_LOCATION, "Picker"),
+                                subchannel_list);
+}
+
+absl::Status ConsistentHashLbPolicy::UpdateLocked(UpdateArgs args) {
+  config_ = std::move(args.config);
+  ServerAddressList addresses;
+  if (args.addresses.ok()) {
+    if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
+      gpr_log(GPR_INFO, "[%s %p] received update with %" PRIuPTR " addresses",
+              log_prefix_, this, args.addresses->size());
+    }
+    addresses = *std::move(args.addresses);
+  } else {
+    if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
+      gpr_log(GPR_INFO, "[%s %p] received update with addresses error: %s",
+              log_prefix_, this, args.addresses.status().ToString().c_str());
+    }
+    // If we already have a subchannel list, then keep using the existing
+    // list, but still report back that the update was not accepted.
+    if (subchannel_list_ != nullptr) return args.addresses.status();
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(*tracer_) &&
+      latest_pending_subchannel_list_ != nullptr) {
+    gpr_log(GPR_INFO, "[%s %p] replacing latest pending subchannel list %p",
+            log_prefix_, this, latest_pending_subchannel_list_.get());
+  }
+  latest_pending_subchannel_list_ = MakeRefCounted<HashSubchannelList>(
+      this, std::move(addresses), args.args);
+  latest_pending_subchannel_list_->StartWatchingLocked(args.args);
+  // If we have no existing list or the new list is empty, immediately
+  // promote the new list.
+  // Otherwise, do nothing; the new list will be promoted when the
+  // initial subchannel states are reported.
+  if (subchannel_list_ == nullptr ||
+      latest_pending_subchannel_list_->num_subchannels() == 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(*tracer_) && subchannel_list_ != nullptr) {
+      gpr_log(GPR_INFO,
+              "[%s %p] empty address list, replacing subchannel list %p",
+              log_prefix_, this, subchannel_list_.get());
+    }
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    // If the new list is empty, report TRANSIENT_FAILURE.
+    if (subchannel_list_->num_subchannels() == 0) {
+      absl::Status status =
+          args.addresses.ok()
+              ? absl::UnavailableError(
+                    absl::StrCat("empty address list: ", args.resolution_note))
+              : args.addresses.status();
+      channel_control_helper()->UpdateState(
+          GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+          MakeRefCounted<TransientFailurePicker>(status));
+      return status;
+    }
+    // Otherwise, report IDLE.
+    subchannel_list_->UpdateConnectivityStateLocked(
+        /*index=*/0, /*connection_attempt_complete=*/false, absl::OkStatus());
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace grpc_core
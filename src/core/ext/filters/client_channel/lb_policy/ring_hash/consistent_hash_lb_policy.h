@@ -0,0 +1,242 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_CONSISTENT_HASH_LB_POLICY_H
+#define GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_CONSISTENT_HASH_LB_POLICY_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/connectivity_state.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/work_serializer.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/subchannel_interface.h"
+#include "src/core/lib/resolver/server_address.h"
+
+namespace grpc_core {
+
+// Base class for LB policies that pick a subchannel by looking up the
+// request hash (see RequestHashAttribute) in a table built from the
+// addresses, such as ring_hash and maglev.
+//
+// This class manages the subchannel lists, aggregates their connectivity
+// state, and, when the subchannel for a hash is not READY, walks the
+// following table entries to find one that is, starting connection
+// attempts on the way.  Subclasses only build the table.
+class ConsistentHashLbPolicy : public LoadBalancingPolicy {
+ public:
+  absl::Status UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ protected:
+  class HashSubchannelList;
+
+  // Maps request hashes to a circular sequence of entries, each of which
+  // refers to a subchannel of a subchannel list.  Built once per
+  // subchannel list, and shared by all of the list's pickers.
+  class Table : public RefCounted<Table> {
+   public:
+    // Number of entries.
+    virtual size_t size() const = 0;
+
+    // Returns the index of the entry for a request hash.
+    virtual size_t FindIndex(uint64_t hash) const = 0;
+
+    // Returns the index of the subchannel for the entry at index.
+    virtual size_t subchannel_index(size_t index) const = 0;
+  };
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  class HashSubchannelData
+      : public SubchannelData<HashSubchannelList, HashSubchannelData> {
+   public:
+    HashSubchannelData(
+        SubchannelList<HashSubchannelList, HashSubchannelData>*
+            subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+        : SubchannelData(subchannel_list, address, std::move(subchannel)),
+          address_(address) {}
+
+    const ServerAddress& address() const { return address_; }
+
+    grpc_connectivity_state logical_connectivity_state() const {
+      return logical_connectivity_state_;
+    }
+    const absl::Status& logical_connectivity_status() const {
+      return logical_connectivity_status_;
+    }
+
+   private:
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state) override;
+
+    ServerAddress address_;
+
+    // Last logical connectivity state seen.
+    // Note that this may differ from the state actually reported by the
+    // subchannel in some cases; for example, once this is set to
+    // TRANSIENT_FAILURE, we do not change it again until we get READY,
+    // so we skip any interim stops in CONNECTING.
+    grpc_connectivity_state logical_connectivity_state_ = GRPC_CHANNEL_IDLE;
+    absl::Status logical_connectivity_status_;
+  };
+
+  // A list of subchannels and the table containing those subchannels.
+  class HashSubchannelList
+      : public SubchannelList<HashSubchannelList, HashSubchannelData> {
+   public:
+    HashSubchannelList(ConsistentHashLbPolicy* policy,
+                       ServerAddressList addresses, const ChannelArgs& args);
+
+    ~HashSubchannelList() override;
+
+    const RefCountedPtr<Table>& table() const { return table_; }
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                                   grpc_connectivity_state new_state);
+
+    // Updates the policy's connectivity state based on the subchannel
+    // list's state counters, creating a new picker.
+    // The index parameter indicates the index into the list of the subchannel
+    // whose status report triggered the call to
+    // UpdateConnectivityStateLocked().
+    // connection_attempt_complete is true if the subchannel just
+    // finished a connection attempt.
+    void UpdateConnectivityStateLocked(size_t index,
+                                       bool connection_attempt_complete,
+                                       absl::Status status);
+
+   private:
+    std::shared_ptr<WorkSerializer> work_serializer() const override {
+      return static_cast<ConsistentHashLbPolicy*>(policy())->work_serializer();
+    }
+
+    size_t num_idle_;
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+
+    RefCountedPtr<Table> table_;
+
+    // The index of the subchannel currently doing an internally
+    // triggered connection attempt, if any.
+    absl::optional<size_t> internally_triggered_connection_index_;
+
+    // TODO(roth): If we ever change the helper UpdateState() API to not
+    // need the status reported for TRANSIENT_FAILURE state (because
+    // it's not currently actually used for anything outside of the picker),
+    // then we will no longer need this data member.
+    absl::Status last_failure_;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(RefCountedPtr<ConsistentHashLbPolicy> policy,
+           HashSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   protected:
+    struct SubchannelInfo {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      grpc_connectivity_state state;
+      absl::Status status;
+    };
+
+    // Called with the index of the first table entry at or after the one
+    // for the request hash whose subchannel is READY.  By default, picks
+    // that subchannel.
+    virtual PickResult PickReady(size_t index);
+
+    const Table& table() const { return *table_; }
+    const std::vector<SubchannelInfo>& subchannels() const {
+      return subchannels_;
+    }
+    size_t num_ready() const { return num_ready_; }
+
+   private:
+    class SubchannelConnectionAttempter;
+
+    RefCountedPtr<ConsistentHashLbPolicy> policy_;
+    RefCountedPtr<Table> table_;
+    std::vector<SubchannelInfo> subchannels_;
+    size_t num_ready_ = 0;
+  };
+
+  // tracer and log_prefix are used for logging, and description in the
+  // status of failed picks (e.g. "ring hash").
+  ConsistentHashLbPolicy(Args args, TraceFlag* tracer, const char* log_prefix,
+                         absl::string_view description);
+  ~ConsistentHashLbPolicy() override;
+
+  // Builds the table for a new subchannel list.
+  virtual RefCountedPtr<Table> CreateTable(HashSubchannelList* subchannel_list,
+                                           const ChannelArgs& args) = 0;
+
+  // Returns a picker for subchannel_list.  By default, a Picker.
+  virtual RefCountedPtr<SubchannelPicker> CreatePicker(
+      HashSubchannelList* subchannel_list);
+
+  // Config from the last update.
+  LoadBalancingPolicy::Config* config() const { return config_.get(); }
+
+  TraceFlag* tracer() const { return tracer_; }
+  const char* log_prefix() const { return log_prefix_; }
+
+ private:
+  void ShutdownLocked() override;
+
+  TraceFlag* const tracer_;
+  const char* const log_prefix_;
+  const absl::string_view description_;
+
+  // Current config from resolver.
+  RefCountedPtr<LoadBalancingPolicy::Config> config_;
+
+  // list of subchannels.
+  RefCountedPtr<HashSubchannelList> subchannel_list_;
+  RefCountedPtr<HashSubchannelList> latest_pending_subchannel_list_;
+  // indicating if we are shutting down.
+  bool shutdown_ = false;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_CONSISTENT_HASH_LB_POLICY_H
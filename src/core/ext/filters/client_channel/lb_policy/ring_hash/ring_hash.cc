@@ -22,30 +22,28 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
-#include "absl/base/attributes.h"
-#include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
-#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
-#include "absl/types/optional.h"
 
 #define XXH_INLINE_ALL
 #include "xxhash.h"
 
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/grpc.h>
-#include <grpc/impl/connectivity_state.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
-#include "src/core/ext/filters/client_channel/client_channel_internal.h"
-#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash_lb_policy.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/config/core_configuration.h"
@@ -54,17 +52,11 @@
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/unique_type_name.h"
-#include "src/core/lib/gprpp/work_serializer.h"
-#include "src/core/lib/iomgr/closure.h"
-#include "src/core/lib/iomgr/error.h"
-#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/load_balancing/lb_policy.h"
 #include "src/core/lib/load_balancing/lb_policy_factory.h"
-#include "src/core/lib/load_balancing/subchannel_interface.h"
-#include "src/core/lib/resolver/server_address.h"
-#include "src/core/lib/transport/connectivity_state.h"
 
 namespace grpc_core {
 
@@ -130,333 +122,198 @@ class RingHashLbConfig : public LoadBalancingPolicy::Config {
 
 constexpr size_t kRingSizeCapDefault = 4096;
 
-class RingHash : public LoadBalancingPolicy {
+// Rings with fewer entries than this are always hashed on the calling
+// thread, since handing work to other threads would cost more than it saves.
+constexpr size_t kMinRingSizeForParallelHashing = 65536;
+// Upper bound on the number of threads used to hash a ring.
+constexpr size_t kMaxRingHashingThreads = 8;
+
+
+class RingHash : public ConsistentHashLbPolicy {
  public:
-  explicit RingHash(Args args);
+  explicit RingHash(Args args)
+      : ConsistentHashLbPolicy(std::move(args), &grpc_lb_ring_hash_trace, "RH",
+                               "ring hash") {}
 
   absl::string_view name() const override { return kRingHash; }
 
-  absl::Status UpdateLocked(UpdateArgs args) override;
-  void ResetBackoffLocked() override;
-
  private:
-  // Forward declaration.
-  class RingHashSubchannelList;
-
-  // Data for a particular subchannel in a subchannel list.
-  // This subclass adds the following functionality:
-  // - Tracks the previous connectivity state of the subchannel, so that
-  //   we know how many subchannels are in each state.
-  class RingHashSubchannelData
-      : public SubchannelData<RingHashSubchannelList, RingHashSubchannelData> {
-   public:
-    RingHashSubchannelData(
-        SubchannelList<RingHashSubchannelList, RingHashSubchannelData>*
-            subchannel_list,
-        const ServerAddress& address,
-        RefCountedPtr<SubchannelInterface> subchannel)
-        : SubchannelData(subchannel_list, address, std::move(subchannel)),
-          address_(address) {}
-
-    const ServerAddress& address() const { return address_; }
-
-    grpc_connectivity_state logical_connectivity_state() const {
-      return logical_connectivity_state_;
-    }
-    const absl::Status& logical_connectivity_status() const {
-      return logical_connectivity_status_;
-    }
-
-   private:
-    // Performs connectivity state updates that need to be done only
-    // after we have started watching.
-    void ProcessConnectivityChangeLocked(
-        absl::optional<grpc_connectivity_state> old_state,
-        grpc_connectivity_state new_state) override;
-
-    ServerAddress address_;
-
-    // Last logical connectivity state seen.
-    // Note that this may differ from the state actually reported by the
-    // subchannel in some cases; for example, once this is set to
-    // TRANSIENT_FAILURE, we do not change it again until we get READY,
-    // so we skip any interim stops in CONNECTING.
-    grpc_connectivity_state logical_connectivity_state_ = GRPC_CHANNEL_IDLE;
-    absl::Status logical_connectivity_status_;
-  };
-
-  // A list of subchannels and the ring containing those subchannels.
-  class RingHashSubchannelList
-      : public SubchannelList<RingHashSubchannelList, RingHashSubchannelData> {
+  // The ring is stored in two parts: the hashes, laid out for fast
+  // lookup, and the subchannel index of each entry, in ring order.
+  //
+  // The hashes are stored in Eytzinger (breadth-first) order, i.e. as
+  // an implicit binary search tree in which the children of the node at
+  // index k are at 2k and 2k+1.  A lookup touches the same number of
+  // nodes as a binary search over a sorted array, but the first several
+  // levels of the tree share a handful of cache lines, which matters
+  // for rings with millions of entries.
+  class Ring : public Table {
    public:
-    class Ring : public RefCounted<Ring> {
+    // Number of calls in flight on each subchannel in the list.  Used
+    // for consistent hashing with bounded loads.
+    class CallCounts : public RefCounted<CallCounts> {
      public:
-      struct RingEntry {
-        uint64_t hash;
-        size_t subchannel_index;
-      };
+      explicit CallCounts(size_t num_subchannels) : counts_(num_subchannels) {}
 
-      Ring(RingHashLbConfig* config, RingHashSubchannelList* subchannel_list,
-           const ChannelArgs& args);
+      uint64_t total() const { return total_.load(std::memory_order_relaxed); }
+      uint64_t count(size_t index) const {
+        return counts_[index].load(std::memory_order_relaxed);
+      }
 
-      const std::vector<RingEntry>& ring() const { return ring_; }
+      void Increment(size_t index) {
+        counts_[index].fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+      }
+      void Decrement(size_t index) {
+        counts_[index].fetch_sub(1, std::memory_order_relaxed);
+        total_.fetch_sub(1, std::memory_order_relaxed);
+      }
 
      private:
-      std::vector<RingEntry> ring_;
+      std::vector<std::atomic<uint64_t>> counts_;
+      std::atomic<uint64_t> total_{0};
     };
 
-    RingHashSubchannelList(RingHash* policy, ServerAddressList addresses,
-                           const ChannelArgs& args);
+    Ring(RingHashLbConfig* config, HashSubchannelList* subchannel_list,
+         const ChannelArgs& args,
+         grpc_event_engine::experimental::EventEngine* event_engine);
 
-    ~RingHashSubchannelList() override {
-      RingHash* p = static_cast<RingHash*>(policy());
-      p->Unref(DEBUG_LOCATION, "subchannel_list");
-    }
-
-    RefCountedPtr<Ring> ring() { return ring_; }
+    // Number of entries in the ring.
+    size_t size() const override { return subchannel_indexes_.size(); }
 
-    // Updates the counters of subchannels in each state when a
-    // subchannel transitions from old_state to new_state.
-    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
-                                   grpc_connectivity_state new_state);
+    // Returns the index of the first ring entry whose hash is >= h,
+    // wrapping around to the first entry if there is none.
+    size_t FindIndex(uint64_t h) const override;
 
-    // Updates the RH policy's connectivity state based on the
-    // subchannel list's state counters, creating new picker and new ring.
-    // The index parameter indicates the index into the list of the subchannel
-    // whose status report triggered the call to
-    // UpdateRingHashConnectivityStateLocked().
-    // connection_attempt_complete is true if the subchannel just
-    // finished a connection attempt.
-    void UpdateRingHashConnectivityStateLocked(size_t index,
-                                               bool connection_attempt_complete,
-                                               absl::Status status);
-
-   private:
-    std::shared_ptr<WorkSerializer> work_serializer() const override {
-      return static_cast<RingHash*>(policy())->work_serializer();
+    // Returns the index of the subchannel for the ring entry at index.
+    size_t subchannel_index(size_t index) const override {
+      return subchannel_indexes_[index];
     }
 
-    size_t num_idle_;
-    size_t num_ready_ = 0;
-    size_t num_connecting_ = 0;
-    size_t num_transient_failure_ = 0;
-
-    RefCountedPtr<Ring> ring_;
+    // Balance factor for bounded-load picks, as a percentage, or 0 if
+    // bounded loads are disabled.
+    uint32_t balance_factor() const { return balance_factor_; }
+    const RefCountedPtr<CallCounts>& call_counts() const {
+      return call_counts_;
+    }
 
-    // The index of the subchannel currently doing an internally
-    // triggered connection attempt, if any.
-    absl::optional<size_t> internally_triggered_connection_index_;
+   private:
+    struct RingEntry {
+      uint64_t hash;
+      uint32_t subchannel_index;
+    };
 
-    // TODO(roth): If we ever change the helper UpdateState() API to not
-    // need the status reported for TRANSIENT_FAILURE state (because
-    // it's not currently actually used for anything outside of the picker),
-    // then we will no longer need this data member.
-    absl::Status last_failure_;
+    // Computes the hashes for the addresses in [begin, end), storing
+    // each address's entries starting at its offset into ring.
+    static void HashAddresses(const std::vector<std::string>& addresses,
+                              const std::vector<size_t>& offsets, size_t begin,
+                              size_t end, RingEntry* ring);
+
+    // Calls hash_chunk for each of num_chunks chunks, offering all but one
+    // of them to event_engine.  The calling thread also hashes chunks until
+    // none are left, so it only ever waits for chunks that are already
+    // being hashed elsewhere, even if event_engine runs none of them.
+    static void HashChunksInParallel(
+        size_t num_chunks, std::function<void(size_t)> hash_chunk,
+        grpc_event_engine::experimental::EventEngine* event_engine);
+
+    // Ring entry hashes in Eytzinger order.  Index 0 is unused.
+    std::vector<uint64_t> hashes_;
+    // For each element of hashes_, the index of its entry in ring order.
+    std::vector<uint32_t> ring_indexes_;
+    // For each ring entry in ring order, the index of its subchannel.
+    std::vector<uint32_t> subchannel_indexes_;
+
+    uint32_t balance_factor_ = 0;
+    // Set only if bounded loads are enabled.
+    RefCountedPtr<CallCounts> call_counts_;
   };
 
-  class Picker : public SubchannelPicker {
+  // Adds consistent hashing with bounded loads to the picks of the base
+  // class, if enabled.
+  class RingHashPicker : public Picker {
    public:
-    Picker(RefCountedPtr<RingHash> ring_hash_lb,
-           RingHashSubchannelList* subchannel_list)
-        : ring_hash_lb_(std::move(ring_hash_lb)),
-          ring_(subchannel_list->ring()) {
-      subchannels_.reserve(subchannel_list->num_subchannels());
-      for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
-        RingHashSubchannelData* subchannel_data =
-            subchannel_list->subchannel(i);
-        subchannels_.emplace_back(
-            SubchannelInfo{subchannel_data->subchannel()->Ref(),
-                           subchannel_data->logical_connectivity_state(),
-                           subchannel_data->logical_connectivity_status()});
-      }
-    }
-
-    PickResult Pick(PickArgs args) override;
+    RingHashPicker(RefCountedPtr<RingHash> ring_hash_lb,
+                   HashSubchannelList* subchannel_list)
+        : Picker(std::move(ring_hash_lb), subchannel_list),
+          ring_(static_cast<const Ring&>(table())) {}
 
    private:
-    // A fire-and-forget class that schedules subchannel connection attempts
-    // on the control plane WorkSerializer.
-    class SubchannelConnectionAttempter : public Orphanable {
+    // Counts a call against a subchannel's load for as long as the call
+    // is in flight.
+    class SubchannelCallTracker : public SubchannelCallTrackerInterface {
      public:
-      explicit SubchannelConnectionAttempter(
-          RefCountedPtr<RingHash> ring_hash_lb)
-          : ring_hash_lb_(std::move(ring_hash_lb)) {
-        GRPC_CLOSURE_INIT(&closure_, RunInExecCtx, this, nullptr);
-      }
+      SubchannelCallTracker(RefCountedPtr<Ring::CallCounts> call_counts,
+                            size_t subchannel_index)
+          : call_counts_(std::move(call_counts)),
+            subchannel_index_(subchannel_index) {}
 
-      void Orphan() override {
-        // Hop into ExecCtx, so that we're not holding the data plane mutex
-        // while we run control-plane code.
-        ExecCtx::Run(DEBUG_LOCATION, &closure_, absl::OkStatus());
-      }
+      void Start() override { call_counts_->Increment(subchannel_index_); }
 
-      void AddSubchannel(RefCountedPtr<SubchannelInterface> subchannel) {
-        subchannels_.push_back(std::move(subchannel));
+      void Finish(FinishArgs /*args*/) override {
+        call_counts_->Decrement(subchannel_index_);
       }
 
      private:
-      static void RunInExecCtx(void* arg, grpc_error_handle /*error*/) {
-        auto* self = static_cast<SubchannelConnectionAttempter*>(arg);
-        self->ring_hash_lb_->work_serializer()->Run(
-            [self]() {
-              if (!self->ring_hash_lb_->shutdown_) {
-                for (auto& subchannel : self->subchannels_) {
-                  subchannel->RequestConnection();
-                }
-              }
-              delete self;
-            },
-            DEBUG_LOCATION);
-      }
-
-      RefCountedPtr<RingHash> ring_hash_lb_;
-      grpc_closure closure_;
-      std::vector<RefCountedPtr<SubchannelInterface>> subchannels_;
+      RefCountedPtr<Ring::CallCounts> call_counts_;
+      const size_t subchannel_index_;
     };
 
-    struct SubchannelInfo {
-      RefCountedPtr<SubchannelInterface> subchannel;
-      grpc_connectivity_state state;
-      absl::Status status;
-    };
+    // Implements consistent hashing with bounded loads: starting at
+    // first_index, walks the ring to the first READY subchannel whose
+    // load is under the bound, so that hot keys spill over to their
+    // neighbors on the ring instead of overloading a single endpoint.
+    PickResult PickReady(size_t first_index) override;
 
-    RefCountedPtr<RingHash> ring_hash_lb_;
-    RefCountedPtr<RingHashSubchannelList::Ring> ring_;
-    std::vector<SubchannelInfo> subchannels_;
+    // Owned by the base class.
+    const Ring& ring_;
   };
 
-  ~RingHash() override;
-
-  void ShutdownLocked() override;
-
-  // Current config from resolver.
-  RefCountedPtr<RingHashLbConfig> config_;
-
-  // list of subchannels.
-  RefCountedPtr<RingHashSubchannelList> subchannel_list_;
-  RefCountedPtr<RingHashSubchannelList> latest_pending_subchannel_list_;
-  // indicating if we are shutting down.
-  bool shutdown_ = false;
+  RefCountedPtr<Table> CreateTable(HashSubchannelList* subchannel_list,
+                                   const ChannelArgs& args) override;
+  RefCountedPtr<SubchannelPicker> CreatePicker(
+      HashSubchannelList* subchannel_list) override;
 };
 
 //
-// RingHash::Picker
+// RingHash::RingHashPicker
 //
 
-RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
-  auto* call_state = static_cast<ClientChannelLbCallState*>(args.call_state);
-  auto* hash_attribute = static_cast<RequestHashAttribute*>(
-      call_state->GetCallAttribute(RequestHashAttribute::TypeName()));
-  absl::string_view hash;
-  if (hash_attribute != nullptr) {
-    hash = hash_attribute->request_hash();
-  }
-  uint64_t h;
-  if (!absl::SimpleAtoi(hash, &h)) {
-    return PickResult::Fail(
-        absl::InternalError("ring hash value is not a number"));
-  }
-  const auto& ring = ring_->ring();
-  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c
-  // (ketama_get_server) NOTE: The algorithm depends on using signed integers
-  // for lowp, highp, and first_index. Do not change them!
-  int64_t lowp = 0;
-  int64_t highp = ring.size();
-  int64_t first_index = 0;
-  while (true) {
-    first_index = (lowp + highp) / 2;
-    if (first_index == static_cast<int64_t>(ring.size())) {
-      first_index = 0;
-      break;
-    }
-    uint64_t midval = ring[first_index].hash;
-    uint64_t midval1 = first_index == 0 ? 0 : ring[first_index - 1].hash;
-    if (h <= midval && h > midval1) {
-      break;
-    }
-    if (midval < h) {
-      lowp = first_index + 1;
-    } else {
-      highp = first_index - 1;
-    }
-    if (lowp > highp) {
-      first_index = 0;
+RingHash::PickResult RingHash::RingHashPicker::PickReady(size_t first_index) {
+  const RefCountedPtr<Ring::CallCounts>& call_counts = ring_.call_counts();
+  if (call_counts == nullptr) return Picker::PickReady(first_index);
+  // Each READY subchannel may have at most ceil(c * (n + 1) / r) calls in
+  // flight, where c is the balance factor, n is the number of calls in
+  // flight across all subchannels (not counting this one), and r is the
+  // number of READY subchannels.  Since c >= 1, at least one READY
+  // subchannel is always under the bound.
+  const uint64_t divisor = uint64_t{100} * num_ready();
+  const uint64_t bound =
+      (ring_.balance_factor() * (call_counts->total() + 1) + divisor - 1) /
+      divisor;
+  size_t subchannel_index = ring_.subchannel_index(first_index);
+  for (size_t i = 0; i < ring_.size(); ++i) {
+    const size_t index =
+        ring_.subchannel_index((first_index + i) % ring_.size());
+    if (subchannels()[index].state == GRPC_CHANNEL_READY &&
+        call_counts->count(index) < bound) {
+      subchannel_index = index;
       break;
     }
   }
-  OrphanablePtr<SubchannelConnectionAttempter> subchannel_connection_attempter;
-  auto ScheduleSubchannelConnectionAttempt =
-      [&](RefCountedPtr<SubchannelInterface> subchannel) {
-        if (subchannel_connection_attempter == nullptr) {
-          subchannel_connection_attempter =
-              MakeOrphanable<SubchannelConnectionAttempter>(ring_hash_lb_->Ref(
-                  DEBUG_LOCATION, "SubchannelConnectionAttempter"));
-        }
-        subchannel_connection_attempter->AddSubchannel(std::move(subchannel));
-      };
-  SubchannelInfo& first_subchannel =
-      subchannels_[ring[first_index].subchannel_index];
-  switch (first_subchannel.state) {
-    case GRPC_CHANNEL_READY:
-      return PickResult::Complete(first_subchannel.subchannel);
-    case GRPC_CHANNEL_IDLE:
-      ScheduleSubchannelConnectionAttempt(first_subchannel.subchannel);
-      ABSL_FALLTHROUGH_INTENDED;
-    case GRPC_CHANNEL_CONNECTING:
-      return PickResult::Queue();
-    default:  // GRPC_CHANNEL_TRANSIENT_FAILURE
-      break;
-  }
-  ScheduleSubchannelConnectionAttempt(first_subchannel.subchannel);
-  // Loop through remaining subchannels to find one in READY.
-  // On the way, we make sure the right set of connection attempts
-  // will happen.
-  bool found_second_subchannel = false;
-  bool found_first_non_failed = false;
-  for (size_t i = 1; i < ring.size(); ++i) {
-    const auto& entry = ring[(first_index + i) % ring.size()];
-    if (entry.subchannel_index == ring[first_index].subchannel_index) {
-      continue;
-    }
-    SubchannelInfo& subchannel_info = subchannels_[entry.subchannel_index];
-    if (subchannel_info.state == GRPC_CHANNEL_READY) {
-      return PickResult::Complete(subchannel_info.subchannel);
-    }
-    if (!found_second_subchannel) {
-      switch (subchannel_info.state) {
-        case GRPC_CHANNEL_IDLE:
-          ScheduleSubchannelConnectionAttempt(subchannel_info.subchannel);
-          ABSL_FALLTHROUGH_INTENDED;
-        case GRPC_CHANNEL_CONNECTING:
-          return PickResult::Queue();
-        default:
-          break;
-      }
-      found_second_subchannel = true;
-    }
-    if (!found_first_non_failed) {
-      if (subchannel_info.state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
-        ScheduleSubchannelConnectionAttempt(subchannel_info.subchannel);
-      } else {
-        if (subchannel_info.state == GRPC_CHANNEL_IDLE) {
-          ScheduleSubchannelConnectionAttempt(subchannel_info.subchannel);
-        }
-        found_first_non_failed = true;
-      }
-    }
-  }
-  return PickResult::Fail(absl::UnavailableError(absl::StrCat(
-      "ring hash cannot find a connected subchannel; first failure: ",
-      first_subchannel.status.ToString())));
+  return PickResult::Complete(
+      subchannels()[subchannel_index].subchannel,
+      std::make_unique<SubchannelCallTracker>(call_counts, subchannel_index));
 }
 
 //
-// RingHash::RingHashSubchannelList::Ring
+// RingHash::Ring
 //
 
-RingHash::RingHashSubchannelList::Ring::Ring(
-    RingHashLbConfig* config, RingHashSubchannelList* subchannel_list,
-    const ChannelArgs& args) {
+RingHash::Ring::Ring(
+    RingHashLbConfig* config, HashSubchannelList* subchannel_list,
+    const ChannelArgs& args,
+    grpc_event_engine::experimental::EventEngine* event_engine) {
   // Store the weights while finding the sum.
   struct AddressWeight {
     std::string address;
@@ -469,7 +326,7 @@ RingHash::RingHashSubchannelList::Ring::Ring(
   size_t sum = 0;
   address_weights.reserve(subchannel_list->num_subchannels());
   for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
-    RingHashSubchannelData* sd = subchannel_list->subchannel(i);
+    HashSubchannelData* sd = subchannel_list->subchannel(i);
     auto weight_arg = sd->address().args().GetInt(GRPC_ARG_ADDRESS_WEIGHT);
     AddressWeight address_weight;
     address_weight.address =
@@ -506,345 +363,194 @@ RingHash::RingHashSubchannelList::Ring::Ring(
   const double scale = std::min(
       std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
       static_cast<double>(max_ring_size));
-  // Reserve memory for the entire ring up front.
-  const uint64_t ring_size = std::ceil(scale);
-  ring_.reserve(ring_size);
-  // Populate the hash ring by walking through the (host, weight) pairs in
-  // normalized_host_weights, and generating (scale * weight) hashes for each
-  // host. Since these aren't necessarily whole numbers, we maintain running
-  // sums -- current_hashes and target_hashes -- which allows us to populate the
-  // ring in a mostly stable way.
-  absl::InlinedVector<char, 196> hash_key_buffer;
+  // Decide how many hashes each host gets by walking through the (host,
+  // weight) pairs in normalized_host_weights, and generating (scale *
+  // weight) hashes for each host. Since these aren't necessarily whole
+  // numbers, we maintain running sums -- current_hashes and target_hashes
+  // -- which allows us to populate the ring in a mostly stable way.
+  // offsets[i] is the index of the first ring entry for host i.
+  std::vector<std::string> addresses;
+  std::vector<size_t> offsets;
+  addresses.reserve(address_weights.size());
+  offsets.reserve(address_weights.size() + 1);
   double current_hashes = 0.0;
   double target_hashes = 0.0;
-  uint64_t min_hashes_per_host = ring_size;
-  uint64_t max_hashes_per_host = 0;
-  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
-    const std::string& address_string = address_weights[i].address;
-    hash_key_buffer.assign(address_string.begin(), address_string.end());
-    hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
-    target_hashes += scale * address_weights[i].normalized_weight;
-    size_t count = 0;
+  size_t ring_size = 0;
+  for (auto& address_weight : address_weights) {
+    addresses.push_back(std::move(address_weight.address));
+    offsets.push_back(ring_size);
+    target_hashes += scale * address_weight.normalized_weight;
     while (current_hashes < target_hashes) {
-      const std::string count_str = absl::StrCat(count);
-      hash_key_buffer.insert(offset_start, count_str.begin(), count_str.end());
-      absl::string_view hash_key(hash_key_buffer.data(),
-                                 hash_key_buffer.size());
-      const uint64_t hash = XXH64(hash_key.data(), hash_key.size(), 0);
-      ring_.push_back({hash, i});
-      ++count;
+      ++ring_size;
       ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
     }
-    min_hashes_per_host =
-        std::min(static_cast<uint64_t>(i), min_hashes_per_host);
-    max_hashes_per_host =
-        std::max(static_cast<uint64_t>(i), max_hashes_per_host);
   }
-  std::sort(ring_.begin(), ring_.end(),
+  offsets.push_back(ring_size);
+  // Compute the hashes.  Large rings are split into contiguous ranges of
+  // hosts with roughly the same number of entries, which are hashed in
+  // parallel on the EventEngine.
+  std::vector<RingEntry> ring(ring_size);
+  const size_t num_chunks = std::min<size_t>(
+      {static_cast<size_t>(gpr_cpu_num_cores()), kMaxRingHashingThreads,
+       ring_size / kMinRingSizeForParallelHashing});
+  if (num_chunks <= 1) {
+    HashAddresses(addresses, offsets, 0, addresses.size(), ring.data());
+  } else {
+    // chunk_begins[c] is the index of the first host of chunk c.
+    std::vector<size_t> chunk_begins;
+    chunk_begins.reserve(num_chunks + 1);
+    chunk_begins.push_back(0);
+    for (size_t c = 1; c < num_chunks; ++c) {
+      size_t end = chunk_begins.back();
+      while (end < addresses.size() &&
+             offsets[end] < ring_size * c / num_chunks) {
+        ++end;
+      }
+      chunk_begins.push_back(end);
+    }
+    chunk_begins.push_back(addresses.size());
+    HashChunksInParallel(
+        num_chunks,
+        [&addresses, &offsets, &chunk_begins, &ring](size_t c) {
+          HashAddresses(addresses, offsets, chunk_begins[c],
+                        chunk_begins[c + 1], ring.data());
+        },
+        event_engine);
+  }
+  std::sort(ring.begin(), ring.end(),
             [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
               return lhs.hash < rhs.hash;
             });
-}
-
-//
-// RingHash::RingHashSubchannelList
-//
-
-RingHash::RingHashSubchannelList::RingHashSubchannelList(
-    RingHash* policy, ServerAddressList addresses, const ChannelArgs& args)
-    : SubchannelList(policy,
-                     (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)
-                          ? "RingHashSubchannelList"
-                          : nullptr),
-                     std::move(addresses), policy->channel_control_helper(),
-                     args),
-      num_idle_(num_subchannels()) {
-  // Need to maintain a ref to the LB policy as long as we maintain
-  // any references to subchannels, since the subchannels'
-  // pollset_sets will include the LB policy's pollset_set.
-  policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
-  // Construct the ring.
-  ring_ = MakeRefCounted<Ring>(policy->config_.get(), this, args);
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
-    gpr_log(GPR_INFO,
-            "[RH %p] created subchannel list %p with %" PRIuPTR " ring entries",
-            policy, this, ring_->ring().size());
-  }
-}
-
-void RingHash::RingHashSubchannelList::UpdateStateCountersLocked(
-    grpc_connectivity_state old_state, grpc_connectivity_state new_state) {
-  if (old_state == GRPC_CHANNEL_IDLE) {
-    GPR_ASSERT(num_idle_ > 0);
-    --num_idle_;
-  } else if (old_state == GRPC_CHANNEL_READY) {
-    GPR_ASSERT(num_ready_ > 0);
-    --num_ready_;
-  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
-    GPR_ASSERT(num_connecting_ > 0);
-    --num_connecting_;
-  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
-    GPR_ASSERT(num_transient_failure_ > 0);
-    --num_transient_failure_;
+  // Lay out the hashes in Eytzinger order, by visiting the nodes of the
+  // implicit tree in order (i.e. in ascending hash order).
+  hashes_.resize(ring_size + 1);
+  ring_indexes_.resize(ring_size + 1);
+  subchannel_indexes_.reserve(ring_size);
+  size_t k = 1;
+  while (2 * k <= ring_size) k *= 2;
+  for (size_t i = 0; i < ring_size; ++i) {
+    hashes_[k] = ring[i].hash;
+    ring_indexes_[k] = i;
+    subchannel_indexes_.push_back(ring[i].subchannel_index);
+    // Move to the in-order successor of k: the leftmost node of k's right
+    // subtree if there is one, and otherwise the nearest ancestor of
+    // which k is in the left subtree.
+    if (2 * k + 1 <= ring_size) {
+      k = 2 * k + 1;
+      while (2 * k <= ring_size) k *= 2;
+    } else {
+      while ((k & 1) != 0) k >>= 1;
+      k >>= 1;
+    }
   }
-  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
-  if (new_state == GRPC_CHANNEL_IDLE) {
-    ++num_idle_;
-  } else if (new_state == GRPC_CHANNEL_READY) {
-    ++num_ready_;
-  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
-    ++num_connecting_;
-  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
-    ++num_transient_failure_;
+  // Set up call counting if bounded loads are enabled.  Balance factors
+  // under 100% could never be satisfied, so they are raised to 100%.
+  const int balance_factor =
+      args.GetInt(GRPC_ARG_RING_HASH_LB_BALANCE_FACTOR).value_or(0);
+  if (balance_factor > 0) {
+    balance_factor_ = std::max(balance_factor, 100);
+    call_counts_ =
+        MakeRefCounted<CallCounts>(subchannel_list->num_subchannels());
   }
 }
 
-void RingHash::RingHashSubchannelList::UpdateRingHashConnectivityStateLocked(
-    size_t index, bool connection_attempt_complete, absl::Status status) {
-  RingHash* p = static_cast<RingHash*>(policy());
-  // If this is latest_pending_subchannel_list_, then swap it into
-  // subchannel_list_ as soon as we get the initial connectivity state
-  // report for every subchannel in the list.
-  if (p->latest_pending_subchannel_list_.get() == this &&
-      AllSubchannelsSeenInitialState()) {
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
-      gpr_log(GPR_INFO, "[RH %p] replacing subchannel list %p with %p", p,
-              p->subchannel_list_.get(), this);
-    }
-    p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
-  }
-  // Only set connectivity state if this is the current subchannel list.
-  if (p->subchannel_list_.get() != this) return;
-  // The overall aggregation rules here are:
-  // 1. If there is at least one subchannel in READY state, report READY.
-  // 2. If there are 2 or more subchannels in TRANSIENT_FAILURE state, report
-  //    TRANSIENT_FAILURE.
-  // 3. If there is at least one subchannel in CONNECTING state, report
-  //    CONNECTING.
-  // 4. If there is one subchannel in TRANSIENT_FAILURE state and there is
-  //    more than one subchannel, report CONNECTING.
-  // 5. If there is at least one subchannel in IDLE state, report IDLE.
-  // 6. Otherwise, report TRANSIENT_FAILURE.
-  //
-  // We set start_connection_attempt to true if we match rules 2, 3, or 6.
-  grpc_connectivity_state state;
-  bool start_connection_attempt = false;
-  if (num_ready_ > 0) {
-    state = GRPC_CHANNEL_READY;
-  } else if (num_transient_failure_ >= 2) {
-    state = GRPC_CHANNEL_TRANSIENT_FAILURE;
-    start_connection_attempt = true;
-  } else if (num_connecting_ > 0) {
-    state = GRPC_CHANNEL_CONNECTING;
-  } else if (num_transient_failure_ == 1 && num_subchannels() > 1) {
-    state = GRPC_CHANNEL_CONNECTING;
-    start_connection_attempt = true;
-  } else if (num_idle_ > 0) {
-    state = GRPC_CHANNEL_IDLE;
-  } else {
-    state = GRPC_CHANNEL_TRANSIENT_FAILURE;
-    start_connection_attempt = true;
-  }
-  // In TRANSIENT_FAILURE, report the last reported failure.
-  // Otherwise, report OK.
-  if (state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
-    if (!status.ok()) {
-      last_failure_ = absl::UnavailableError(absl::StrCat(
-          "no reachable subchannels; last error: ", status.ToString()));
-    }
-    status = last_failure_;
-  } else {
-    status = absl::OkStatus();
-  }
-  // Generate new picker and return it to the channel.
-  // Note that we use our own picker regardless of connectivity state.
-  p->channel_control_helper()->UpdateState(
-      state, status,
-      MakeRefCounted<Picker>(p->Ref(DEBUG_LOCATION, "RingHashPicker"), this));
-  // While the ring_hash policy is reporting TRANSIENT_FAILURE, it will
-  // not be getting any pick requests from the priority policy.
-  // However, because the ring_hash policy does not attempt to
-  // reconnect to subchannels unless it is getting pick requests,
-  // it will need special handling to ensure that it will eventually
-  // recover from TRANSIENT_FAILURE state once the problem is resolved.
-  // Specifically, it will make sure that it is attempting to connect to
-  // at least one subchannel at any given time.  After a given subchannel
-  // fails a connection attempt, it will move on to the next subchannel
-  // in the ring.  It will keep doing this until one of the subchannels
-  // successfully connects, at which point it will report READY and stop
-  // proactively trying to connect.  The policy will remain in
-  // TRANSIENT_FAILURE until at least one subchannel becomes connected,
-  // even if subchannels are in state CONNECTING during that time.
-  //
-  // Note that we do the same thing when the policy is in state
-  // CONNECTING, just to ensure that we don't remain in CONNECTING state
-  // indefinitely if there are no new picks coming in.
-  if (internally_triggered_connection_index_.has_value() &&
-      *internally_triggered_connection_index_ == index &&
-      connection_attempt_complete) {
-    internally_triggered_connection_index_.reset();
-  }
-  if (start_connection_attempt &&
-      !internally_triggered_connection_index_.has_value()) {
-    size_t next_index = (index + 1) % num_subchannels();
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
-      gpr_log(GPR_INFO,
-              "[RH %p] triggering internal connection attempt for subchannel "
-              "%p, subchannel_list %p (index %" PRIuPTR " of %" PRIuPTR ")",
-              p, subchannel(next_index)->subchannel(), this, next_index,
-              num_subchannels());
+void RingHash::Ring::HashChunksInParallel(
+    size_t num_chunks, std::function<void(size_t)> hash_chunk,
+    grpc_event_engine::experimental::EventEngine* event_engine) {
+  // Shared with the EventEngine callbacks, which may run after we return.
+  // By then, no chunks are left, so they do not touch hash_chunk.
+  struct State {
+    Mutex mu;
+    CondVar cv;
+    const size_t num_chunks;
+    const std::function<void(size_t)> hash_chunk;
+    size_t next_chunk ABSL_GUARDED_BY(mu) = 0;
+    size_t chunks_in_progress ABSL_GUARDED_BY(mu) = 0;
+
+    State(size_t num_chunks, std::function<void(size_t)> hash_chunk)
+        : num_chunks(num_chunks), hash_chunk(std::move(hash_chunk)) {}
+
+    void HashChunks() {
+      while (true) {
+        size_t chunk;
+        {
+          MutexLock lock(&mu);
+          if (next_chunk == num_chunks) return;
+          chunk = next_chunk++;
+          ++chunks_in_progress;
+        }
+        hash_chunk(chunk);
+        MutexLock lock(&mu);
+        if (--chunks_in_progress == 0) cv.SignalAll();
+      }
     }
-    internally_triggered_connection_index_ = next_index;
-    subchannel(next_index)->subchannel()->RequestConnection();
+  };
+  auto state = std::make_shared<State>(num_chunks, std::move(hash_chunk));
+  for (size_t i = 1; i < num_chunks; ++i) {
+    event_engine->Run([state]() { state->HashChunks(); });
   }
+  state->HashChunks();
+  MutexLock lock(&state->mu);
+  while (state->chunks_in_progress > 0) state->cv.Wait(&state->mu);
 }
 
-//
-// RingHash::RingHashSubchannelData
-//
-
-void RingHash::RingHashSubchannelData::ProcessConnectivityChangeLocked(
-    absl::optional<grpc_connectivity_state> old_state,
-    grpc_connectivity_state new_state) {
-  RingHash* p = static_cast<RingHash*>(subchannel_list()->policy());
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
-    gpr_log(
-        GPR_INFO,
-        "[RH %p] connectivity changed for subchannel %p, subchannel_list %p "
-        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
-        p, subchannel(), subchannel_list(), Index(),
-        subchannel_list()->num_subchannels(),
-        ConnectivityStateName(logical_connectivity_state_),
-        ConnectivityStateName(new_state));
-  }
-  GPR_ASSERT(subchannel() != nullptr);
-  // If this is not the initial state notification and the new state is
-  // TRANSIENT_FAILURE or IDLE, re-resolve.
-  // Note that we don't want to do this on the initial state notification,
-  // because that would result in an endless loop of re-resolution.
-  if (old_state.has_value() && (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
-                                new_state == GRPC_CHANNEL_IDLE)) {
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
-      gpr_log(GPR_INFO,
-              "[RH %p] Subchannel %p reported %s; requesting re-resolution", p,
-              subchannel(), ConnectivityStateName(new_state));
+void RingHash::Ring::HashAddresses(
+    const std::vector<std::string>& addresses,
+    const std::vector<size_t>& offsets, size_t begin, size_t end,
+    RingEntry* ring) {
+  std::string hash_key;
+  for (size_t i = begin; i < end; ++i) {
+    hash_key.assign(addresses[i]);
+    hash_key.push_back('_');
+    const size_t prefix_size = hash_key.size();
+    for (size_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+      hash_key.resize(prefix_size);
+      absl::StrAppend(&hash_key, j - offsets[i]);
+      ring[j] = {XXH64(hash_key.data(), hash_key.size(), 0),
+                 static_cast<uint32_t>(i)};
     }
-    p->channel_control_helper()->RequestReresolution();
   }
-  const bool connection_attempt_complete = new_state != GRPC_CHANNEL_CONNECTING;
-  // Decide what state to report for the purposes of aggregation and
-  // picker behavior.
-  // If the last recorded state was TRANSIENT_FAILURE, ignore the change
-  // unless the new state is READY (or TF again, in which case we need
-  // to update the status).
-  if (logical_connectivity_state_ != GRPC_CHANNEL_TRANSIENT_FAILURE ||
-      new_state == GRPC_CHANNEL_READY ||
-      new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
-    // Update state counters used for aggregation.
-    subchannel_list()->UpdateStateCountersLocked(logical_connectivity_state_,
-                                                 new_state);
-    // Update logical state.
-    logical_connectivity_state_ = new_state;
-    logical_connectivity_status_ = connectivity_status();
+}
+
+size_t RingHash::Ring::FindIndex(uint64_t h) const {
+  // Descend the implicit tree, going right whenever the node's hash is
+  // less than h.  Once we fall off the bottom, the node we want is the
+  // last one at which we went left, which is found by stripping the
+  // trailing right turns (1 bits) and then the final left turn.
+  const size_t n = size();
+  size_t k = 1;
+  while (k <= n) {
+    k = 2 * k + (hashes_[k] < h ? 1 : 0);
   }
-  // Update the RH policy's connectivity state, creating new picker and new
-  // ring.
-  subchannel_list()->UpdateRingHashConnectivityStateLocked(
-      Index(), connection_attempt_complete, logical_connectivity_status_);
+  while ((k & 1) != 0) k >>= 1;
+  k >>= 1;
+  // If we never went left, all hashes are less than h, so wrap around.
+  if (k == 0) return 0;
+  return ring_indexes_[k];
 }
 
 //
 // RingHash
 //
 
-RingHash::RingHash(Args args) : LoadBalancingPolicy(std::move(args)) {
+RefCountedPtr<ConsistentHashLbPolicy::Table> RingHash::CreateTable(
+    HashSubchannelList* subchannel_list, const ChannelArgs& args) {
+  auto ring = MakeRefCounted<Ring>(
+      static_cast<RingHashLbConfig*>(config()), subchannel_list, args,
+      channel_control_helper()->GetEventEngine());
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
-    gpr_log(GPR_INFO, "[RH %p] Created", this);
-  }
-}
-
-RingHash::~RingHash() {
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
-    gpr_log(GPR_INFO, "[RH %p] Destroying Ring Hash policy", this);
-  }
-  GPR_ASSERT(subchannel_list_ == nullptr);
-  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
-}
-
-void RingHash::ShutdownLocked() {
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
-    gpr_log(GPR_INFO, "[RH %p] Shutting down", this);
-  }
-  shutdown_ = true;
-  subchannel_list_.reset();
-  latest_pending_subchannel_list_.reset();
-}
-
-void RingHash::ResetBackoffLocked() {
-  subchannel_list_->ResetBackoffLocked();
-  if (latest_pending_subchannel_list_ != nullptr) {
-    latest_pending_subchannel_list_->ResetBackoffLocked();
+    gpr_log(GPR_INFO,
+            "[RH %p] created ring for subchannel list %p with "
+            "balance_factor=%" PRIu32,
+            this, subchannel_list, ring->balance_factor());
   }
+  return ring;
 }
 
-absl::Status RingHash::UpdateLocked(UpdateArgs args) {
-  config_ = std::move(args.config);
-  ServerAddressList addresses;
-  if (args.addresses.ok()) {
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
-      gpr_log(GPR_INFO, "[RH %p] received update with %" PRIuPTR " addresses",
-              this, args.addresses->size());
-    }
-    addresses = *std::move(args.addresses);
-  } else {
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
-      gpr_log(GPR_INFO, "[RH %p] received update with addresses error: %s",
-              this, args.addresses.status().ToString().c_str());
-    }
-    // If we already have a subchannel list, then keep using the existing
-    // list, but still report back that the update was not accepted.
-    if (subchannel_list_ != nullptr) return args.addresses.status();
-  }
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace) &&
-      latest_pending_subchannel_list_ != nullptr) {
-    gpr_log(GPR_INFO, "[RH %p] replacing latest pending subchannel list %p",
-            this, latest_pending_subchannel_list_.get());
-  }
-  latest_pending_subchannel_list_ = MakeRefCounted<RingHashSubchannelList>(
-      this, std::move(addresses), args.args);
-  latest_pending_subchannel_list_->StartWatchingLocked(args.args);
-  // If we have no existing list or the new list is empty, immediately
-  // promote the new list.
-  // Otherwise, do nothing; the new list will be promoted when the
-  // initial subchannel states are reported.
-  if (subchannel_list_ == nullptr ||
-      latest_pending_subchannel_list_->num_subchannels() == 0) {
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace) &&
-        subchannel_list_ != nullptr) {
-      gpr_log(GPR_INFO,
-              "[RH %p] empty address list, replacing subchannel list %p", this,
-              subchannel_list_.get());
-    }
-    subchannel_list_ = std::move(latest_pending_subchannel_list_);
-    // If the new list is empty, report TRANSIENT_FAILURE.
-    if (subchannel_list_->num_subchannels() == 0) {
-      absl::Status status =
-          args.addresses.ok()
-              ? absl::UnavailableError(
-                    absl::StrCat("empty address list: ", args.resolution_note))
-              : args.addresses.status();
-      channel_control_helper()->UpdateState(
-          GRPC_CHANNEL_TRANSIENT_FAILURE, status,
-          MakeRefCounted<TransientFailurePicker>(status));
-      return status;
-    }
-    // Otherwise, report IDLE.
-    subchannel_list_->UpdateRingHashConnectivityStateLocked(
-        /*index=*/0, /*connection_attempt_complete=*/false, absl::OkStatus());
-  }
-  return absl::OkStatus();
+RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> RingHash::CreatePicker(
+    HashSubchannelList* subchannel_list) {
+  return MakeRefCounted<RingHashPicker>(Ref(DEBUG_LOCATION, "RingHashPicker"),
+                                        subchannel_list);
 }
 
 //
@@ -35,6 +35,7 @@
 #include "absl/types/optional.h"
 
 #include <grpc/impl/connectivity_state.h>
+#include <grpc/impl/grpc_types.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
@@ -43,6 +44,7 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/per_cpu.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/work_serializer.h"
 #include "src/core/lib/json/json.h"
@@ -179,10 +181,23 @@ class RoundRobin : public LoadBalancingPolicy {
     PickResult Pick(PickArgs args) override;
 
    private:
+    // Pick cursor used by all threads running on a given CPU shard.
+    // Padded to a full cache line, so that picks on different shards do
+    // not contend with each other.
+    struct PerCpuCursor {
+      std::atomic<size_t> last_picked_index{0};
+      char padding[GPR_CACHELINE_SIZE - sizeof(std::atomic<size_t>)];
+    };
+
     // Using pointer value only, no ref held -- do not dereference!
     RoundRobin* parent_;
 
     std::atomic<size_t> last_picked_index_;
+    // Set only if per-CPU picking is enabled.  Each shard starts at a
+    // different offset into subchannels_ and steps through the whole
+    // list on its own, so each shard (and therefore the overall pick
+    // distribution) stays even in the long run.
+    std::unique_ptr<PerCpu<PerCpuCursor>> per_cpu_cursors_;
     std::vector<RefCountedPtr<SubchannelInterface>> subchannels_;
   };
 
@@ -196,6 +211,9 @@ class RoundRobin : public LoadBalancingPolicy {
   // list becomes READY.
   RefCountedPtr<RoundRobinSubchannelList> latest_pending_subchannel_list_;
 
+  // Whether to create pickers with a per-CPU pick cursor.
+  const bool per_cpu_picker_;
+
   bool shutdown_ = false;
 
   absl::BitGen bit_gen_;
@@ -220,16 +238,36 @@ RoundRobin::Picker::Picker(RoundRobin* parent,
   size_t index =
       absl::Uniform<size_t>(parent->bit_gen_, 0, subchannels_.size());
   last_picked_index_.store(index, std::memory_order_relaxed);
+  if (parent->per_cpu_picker_) {
+    // Spread the shards' starting offsets evenly around the list, so that
+    // threads on different CPUs do not all start with the same subchannel.
+    per_cpu_cursors_ = std::make_unique<PerCpu<PerCpuCursor>>(
+        PerCpuOptions().SetCpusPerShard(1).SetMaxShards(32));
+    const size_t num_shards =
+        per_cpu_cursors_->end() - per_cpu_cursors_->begin();
+    size_t shard_index = 0;
+    for (PerCpuCursor& cursor : *per_cpu_cursors_) {
+      cursor.last_picked_index.store(
+          index + shard_index * subchannels_.size() / num_shards,
+          std::memory_order_relaxed);
+      ++shard_index;
+    }
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
-            "[RR %p picker %p] created picker from subchannel_list=%p "
+            "[RR %p picker %p] created %spicker from subchannel_list=%p "
             "with %" PRIuPTR " READY subchannels; last_picked_index_=%" PRIuPTR,
-            parent_, this, subchannel_list, subchannels_.size(), index);
+            parent_, this, per_cpu_cursors_ != nullptr ? "per-CPU " : "",
+            subchannel_list, subchannels_.size(), index);
   }
 }
 
 RoundRobin::PickResult RoundRobin::Picker::Pick(PickArgs /*args*/) {
-  size_t index = last_picked_index_.fetch_add(1, std::memory_order_relaxed) %
+  std::atomic<size_t>& last_picked_index =
+      per_cpu_cursors_ != nullptr
+          ? per_cpu_cursors_->this_cpu().last_picked_index
+          : last_picked_index_;
+  size_t index = last_picked_index.fetch_add(1, std::memory_order_relaxed) %
                  subchannels_.size();
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
@@ -243,9 +281,15 @@ RoundRobin::PickResult RoundRobin::Picker::Pick(PickArgs /*args*/) {
 // RoundRobin
 //
 
-RoundRobin::RoundRobin(Args args) : LoadBalancingPolicy(std::move(args)) {
+RoundRobin::RoundRobin(Args args)
+    : LoadBalancingPolicy(std::move(args)),
+      per_cpu_picker_(
+          channel_args()
+              .GetBool(GRPC_ARG_ROUND_ROBIN_LB_PER_CPU_PICKER)
+              .value_or(false)) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
-    gpr_log(GPR_INFO, "[RR %p] Created", this);
+    gpr_log(GPR_INFO, "[RR %p] Created (per_cpu_picker=%d)", this,
+            per_cpu_picker_);
   }
 }
 
@@ -0,0 +1,149 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/alias_table_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+
+#include <grpc/support/log.h>
+
+namespace grpc_core {
+
+namespace {
+
+// These match the constants of the same name in StaticStrideScheduler; see
+// the comments there.  Neither is needed to bound the cost of a pick here,
+// but they are applied anyway so that both schedulers produce the same
+// distribution for a given set of weights.
+constexpr double kMaxRatio = 10;
+constexpr double kMinRatio = 0.01;
+
+}  // namespace
+
+absl::optional<AliasTableScheduler> AliasTableScheduler::Make(
+    absl::Span<const float> float_weights,
+    absl::AnyInvocable<uint64_t()> next_random_func) {
+  if (float_weights.empty()) return absl::nullopt;
+  if (float_weights.size() == 1) return absl::nullopt;
+
+  // Picks use 32 bits of randomness to select a column.
+  const size_t n = float_weights.size();
+  GPR_ASSERT(n <= std::numeric_limits<uint32_t>::max());
+
+  size_t num_zero_weight_channels = 0;
+  double sum = 0;
+  float unscaled_max = 0;
+  for (const float weight : float_weights) {
+    sum += weight;
+    unscaled_max = std::max(unscaled_max, weight);
+    if (weight == 0) {
+      ++num_zero_weight_channels;
+    }
+  }
+
+  if (num_zero_weight_channels == n) return absl::nullopt;
+
+  // Mean of non-zero weights.
+  const double mean = sum / static_cast<double>(n - num_zero_weight_channels);
+  const double max_weight = std::min<double>(unscaled_max, kMaxRatio * mean);
+  const double min_weight = mean * kMinRatio;
+
+  std::vector<double> weights;
+  weights.reserve(n);
+  double total = 0;
+  for (const float weight : float_weights) {
+    if (weight == 0) {  // Weight is unknown.
+      weights.push_back(mean);
+    } else {
+      weights.push_back(std::max(std::min<double>(weight, max_weight),
+                                 min_weight));
+    }
+    total += weights.back();
+  }
+
+  // Vose's alias method.  Scale the weights such that their mean is 1; each
+  // column then has room for exactly 1 unit of probability.  Columns with
+  // less than 1 ("small") are topped up with probability taken from a column
+  // with more than 1 ("large"), which becomes their alias.
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  small.reserve(n);
+  large.reserve(n);
+  const double scale = static_cast<double>(n) / total;
+  for (size_t i = 0; i < n; ++i) {
+    weights[i] *= scale;
+    if (weights[i] < 1) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+
+  const auto probability_to_threshold = [](double probability) {
+    return static_cast<uint32_t>(
+        std::min(std::ldexp(probability, 32),
+                 static_cast<double>(std::numeric_limits<uint32_t>::max())));
+  };
+
+  std::vector<Column> columns(n);
+  while (!small.empty() && !large.empty()) {
+    const uint32_t s = small.back();
+    small.pop_back();
+    const uint32_t l = large.back();
+    columns[s] = {probability_to_threshold(weights[s]), l};
+    weights[l] = (weights[l] + weights[s]) - 1;
+    if (weights[l] < 1) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // Whatever is left over is full, up to rounding errors.  Aliasing those
+  // columns to themselves makes the threshold irrelevant.
+  for (const uint32_t i : large) columns[i] = {0, i};
+  for (const uint32_t i : small) columns[i] = {0, i};
+
+  return AliasTableScheduler{std::move(columns), std::move(next_random_func)};
+}
+
+AliasTableScheduler::AliasTableScheduler(
+    std::vector<Column> columns,
+    absl::AnyInvocable<uint64_t()> next_random_func)
+    : next_random_func_(std::move(next_random_func)),
+      columns_(std::move(columns)) {
+  GPR_ASSERT(next_random_func_ != nullptr);
+}
+
+size_t AliasTableScheduler::Pick() const {
+  const uint64_t random = next_random_func_();
+  // The upper 32 bits select the column, using a multiply-shift rather than
+  // a modulus, and the lower 32 bits decide between the column's own index
+  // and its alias.
+  const size_t index =
+      static_cast<size_t>(((random >> 32) * columns_.size()) >> 32);
+  const Column& column = columns_[index];
+  if (static_cast<uint32_t>(random) < column.threshold) return index;
+  return column.alias;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,82 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_ALIAS_TABLE_SCHEDULER_H
+#define GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_ALIAS_TABLE_SCHEDULER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+
+namespace grpc_core {
+
+// AliasTableScheduler picks indexes at random, in proportion to their
+// weights, using Vose's alias method.  Like StaticStrideScheduler, it cannot
+// be modified after construction and can be used to make concurrent picks
+// without any locking.
+//
+// Construction is O(|weights|).  Picking is O(1) in the worst case, no matter
+// how skewed the weights are: it consumes exactly one random number and reads
+// exactly one table entry.  Stores eight bytes per weight.
+//
+// Weights are normalized the same way as in StaticStrideScheduler (zero
+// weights are replaced with the mean of the non-zero weights, and weights are
+// clamped to a range around that mean), so that the two schedulers are
+// interchangeable.
+class AliasTableScheduler {
+ public:
+  // Constructs and returns a new AliasTableScheduler, or nullopt if all
+  // weights are zero or |weights| <= 1. All weights must be >=0.
+  // `next_random_func` should return uniformly distributed 64-bit random
+  // numbers. `float_weights` does not need to live beyond the function.
+  // Caller is responsible for ensuring `next_random_func` remains valid for
+  // all calls to `Pick()`.
+  static absl::optional<AliasTableScheduler> Make(
+      absl::Span<const float> float_weights,
+      absl::AnyInvocable<uint64_t()> next_random_func);
+
+  // Returns the index of the next pick. Invokes `next_random_func` exactly
+  // once. The returned value is guaranteed to be in [0, |weights|).
+  // Can be called concurrently iff `next_random_func` can.
+  size_t Pick() const;
+
+ private:
+  // One column of the alias table.  A pick that lands on this column
+  // returns the column's own index with probability threshold / 2^32, and
+  // `alias` otherwise.
+  struct Column {
+    uint32_t threshold;
+    uint32_t alias;
+  };
+
+  AliasTableScheduler(std::vector<Column> columns,
+                      absl::AnyInvocable<uint64_t()> next_random_func);
+
+  mutable absl::AnyInvocable<uint64_t()> next_random_func_;
+
+  std::vector<Column> columns_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_ALIAS_TABLE_SCHEDULER_H
@@ -39,14 +39,17 @@
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "absl/types/variant.h"
 
 #include <grpc/event_engine/event_engine.h>
 #include <grpc/impl/connectivity_state.h>
+#include <grpc/impl/grpc_types.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
 #include "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.h"
 #include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/alias_table_scheduler.h"
 #include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
@@ -57,6 +60,7 @@
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thread_local_random.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/gprpp/validation_errors.h"
 #include "src/core/lib/gprpp/work_serializer.h"
@@ -331,11 +335,14 @@ class WeightedRoundRobin : public LoadBalancingPolicy {
       RefCountedPtr<AddressWeight> weight;
     };
 
+    using Scheduler = absl::variant<StaticStrideScheduler, AliasTableScheduler>;
+
     // Returns the index into subchannels_ to be picked.
     size_t PickIndex();
 
     // Builds a new scheduler and swaps it into place, then starts a
-    // timer for the next update.
+    // timer for the next update.  If the weights have not changed since
+    // the last time, the current scheduler is kept.
     void BuildSchedulerAndStartTimerLocked()
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&timer_mu_);
 
@@ -344,12 +351,14 @@ class WeightedRoundRobin : public LoadBalancingPolicy {
     std::vector<SubchannelInfo> subchannels_;
 
     Mutex scheduler_mu_;
-    std::shared_ptr<StaticStrideScheduler> scheduler_
+    std::shared_ptr<const Scheduler> scheduler_
         ABSL_GUARDED_BY(&scheduler_mu_);
 
     Mutex timer_mu_ ABSL_ACQUIRED_BEFORE(&scheduler_mu_);
     absl::optional<grpc_event_engine::experimental::EventEngine::TaskHandle>
         timer_handle_ ABSL_GUARDED_BY(&timer_mu_);
+    // Weights that the current scheduler was built from.
+    std::vector<float> last_weights_ ABSL_GUARDED_BY(&timer_mu_);
 
     // Used when falling back to RR.
     std::atomic<size_t> last_picked_index_;
@@ -377,6 +386,10 @@ class WeightedRoundRobin : public LoadBalancingPolicy {
   std::map<std::string, AddressWeight*, std::less<>> address_weight_map_
       ABSL_GUARDED_BY(&address_weight_map_mu_);
 
+  // Whether pickers use AliasTableScheduler instead of
+  // StaticStrideScheduler.
+  const bool use_alias_table_scheduler_;
+
   bool shutdown_ = false;
 
   absl::BitGen bit_gen_;
@@ -557,13 +570,15 @@ WeightedRoundRobin::PickResult WeightedRoundRobin::Picker::Pick(
 
 size_t WeightedRoundRobin::Picker::PickIndex() {
   // Grab a ref to the scheduler.
-  std::shared_ptr<StaticStrideScheduler> scheduler;
+  std::shared_ptr<const Scheduler> scheduler;
   {
     MutexLock lock(&scheduler_mu_);
     scheduler = scheduler_;
   }
   // If we have a scheduler, use it to do a WRR pick.
-  if (scheduler != nullptr) return scheduler->Pick();
+  if (scheduler != nullptr) {
+    return absl::visit([](const auto& s) { return s.Pick(); }, *scheduler);
+  }
   // We don't have a scheduler (i.e., either all of the weights are 0 or
   // there is only one subchannel), so fall back to RR.
   return last_picked_index_.fetch_add(1) % subchannels_.size();
@@ -578,27 +593,46 @@ void WeightedRoundRobin::Picker::BuildSchedulerAndStartTimerLocked() {
     weights.push_back(subchannel.weight->GetWeight(
         now, config_->weight_expiration_period(), config_->blackout_period()));
   }
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
-    gpr_log(GPR_INFO, "[WRR %p picker %p] new weights: %s", wrr_.get(), this,
-            absl::StrJoin(weights, " ").c_str());
-  }
-  auto scheduler_or = StaticStrideScheduler::Make(
-      weights, [this]() { return wrr_->scheduler_state_.fetch_add(1); });
-  std::shared_ptr<StaticStrideScheduler> scheduler;
-  if (scheduler_or.has_value()) {
-    scheduler =
-        std::make_shared<StaticStrideScheduler>(std::move(*scheduler_or));
+  if (weights == last_weights_) {
+    // Nothing to do; pickers keep using the current scheduler.
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
-      gpr_log(GPR_INFO, "[WRR %p picker %p] new scheduler: %p", wrr_.get(),
-              this, scheduler.get());
+      gpr_log(GPR_INFO, "[WRR %p picker %p] weights unchanged", wrr_.get(),
+              this);
     }
-  } else if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
-    gpr_log(GPR_INFO, "[WRR %p picker %p] no scheduler, falling back to RR",
-            wrr_.get(), this);
-  }
-  {
-    MutexLock lock(&scheduler_mu_);
-    scheduler_ = std::move(scheduler);
+  } else {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p picker %p] new weights: %s", wrr_.get(), this,
+              absl::StrJoin(weights, " ").c_str());
+    }
+    // The new scheduler is built without holding scheduler_mu_, so
+    // concurrent picks keep using the old one until it is swapped in.
+    std::shared_ptr<const Scheduler> scheduler;
+    if (wrr_->use_alias_table_scheduler_) {
+      auto scheduler_or = AliasTableScheduler::Make(weights, ThreadLocalRandom);
+      if (scheduler_or.has_value()) {
+        scheduler = std::make_shared<const Scheduler>(std::move(*scheduler_or));
+      }
+    } else {
+      auto scheduler_or = StaticStrideScheduler::Make(
+          weights, [this]() { return wrr_->scheduler_state_.fetch_add(1); });
+      if (scheduler_or.has_value()) {
+        scheduler = std::make_shared<const Scheduler>(std::move(*scheduler_or));
+      }
+    }
+    if (scheduler != nullptr) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+        gpr_log(GPR_INFO, "[WRR %p picker %p] new scheduler: %p", wrr_.get(),
+                this, scheduler.get());
+      }
+    } else if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p picker %p] no scheduler, falling back to RR",
+              wrr_.get(), this);
+    }
+    {
+      MutexLock lock(&scheduler_mu_);
+      scheduler_ = std::move(scheduler);
+    }
+    last_weights_ = std::move(weights);
   }
   // Start timer.
   WeakRefCountedPtr<Picker> self = WeakRef();
@@ -626,9 +660,14 @@ void WeightedRoundRobin::Picker::BuildSchedulerAndStartTimerLocked() {
 //
 
 WeightedRoundRobin::WeightedRoundRobin(Args args)
-    : LoadBalancingPolicy(std::move(args)) {
+    : LoadBalancingPolicy(std::move(args)),
+      use_alias_table_scheduler_(
+          channel_args()
+              .GetBool(GRPC_ARG_WEIGHTED_ROUND_ROBIN_LB_ALIAS_TABLE_SCHEDULER)
+              .value_or(false)) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
-    gpr_log(GPR_INFO, "[WRR %p] Created", this);
+    gpr_log(GPR_INFO, "[WRR %p] Created (use_alias_table_scheduler=%d)", this,
+            use_alias_table_scheduler_);
   }
 }
 
@@ -475,9 +475,9 @@ void CdsLb::OnClusterChanged(const std::string& name,
       gpr_log(GPR_INFO, "[cdslb %p] generated config for child policy: %s",
               this, JsonDump(json, /*indent=*/1).c_str());
     }
-    auto config =
-        CoreConfiguration::Get().lb_policy_registry().ParseLoadBalancingConfig(
-            json);
+    auto config = CoreConfiguration::Get()
+                      .lb_policy_registry()
+                      .ParseLoadBalancingConfigInterned(json);
     if (!config.ok()) {
       OnError(name, absl::UnavailableError(config.status().message()));
       return;
@@ -892,9 +892,9 @@ XdsClusterResolverLb::CreateChildPolicyConfigLocked() {
         "[xds_cluster_resolver_lb %p] generated config for child policy: %s",
         this, JsonDump(json, /*indent=*/1).c_str());
   }
-  auto config =
-      CoreConfiguration::Get().lb_policy_registry().ParseLoadBalancingConfig(
-          json);
+  auto config = CoreConfiguration::Get()
+                    .lb_policy_registry()
+                    .ParseLoadBalancingConfigInterned(json);
   if (!config.ok()) {
     // This should never happen, but if it does, we basically have no
     // way to fix it, so we put the channel in TRANSIENT_FAILURE.
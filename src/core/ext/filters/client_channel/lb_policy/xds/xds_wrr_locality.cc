@@ -211,9 +211,9 @@ absl::Status XdsWrrLocalityLb::UpdateLocked(UpdateArgs args) {
             JsonDump(child_config_json, /*indent=*/1).c_str());
   }
   // Parse config.
-  auto child_config =
-      CoreConfiguration::Get().lb_policy_registry().ParseLoadBalancingConfig(
-          child_config_json);
+  auto child_config = CoreConfiguration::Get()
+                          .lb_policy_registry()
+                          .ParseLoadBalancingConfigInterned(child_config_json);
   if (!child_config.ok()) {
     // This should never happen, but if it does, we basically have no
     // way to fix it, so we put the channel in TRANSIENT_FAILURE.
@@ -16,6 +16,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -76,6 +77,7 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/dual_ref_counted.h"
+#include "src/core/lib/gprpp/intern_cache.h"
 #include "src/core/lib/gprpp/match.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -102,19 +104,26 @@ TraceFlag grpc_xds_resolver_trace(false, "xds_resolver");
 
 namespace {
 
+// Maximum number of service configs shared between xds resolvers.
+constexpr size_t kMaxInternedServiceConfigs = 256;
+
+using ServiceConfigCache = InternCache<ServiceConfig>;
+
 //
 // XdsResolver
 //
 
 class XdsResolver : public Resolver {
  public:
-  XdsResolver(ResolverArgs args, std::string data_plane_authority)
+  XdsResolver(ResolverArgs args, std::string data_plane_authority,
+              std::shared_ptr<ServiceConfigCache> service_config_cache)
       : work_serializer_(std::move(args.work_serializer)),
         result_handler_(std::move(args.result_handler)),
         args_(std::move(args.args)),
         interested_parties_(args.pollset_set),
         uri_(std::move(args.uri)),
         data_plane_authority_(std::move(data_plane_authority)),
+        service_config_cache_(std::move(service_config_cache)),
         channel_id_(absl::Uniform<uint64_t>(absl::BitGen())) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_resolver_trace)) {
       gpr_log(
@@ -318,6 +327,8 @@ class XdsResolver : public Resolver {
 
     std::map<absl::string_view, RefCountedPtr<ClusterRef>> clusters_;
     std::vector<RouteEntry> routes_;
+    // Compiled from routes_ once they are all added.
+    std::unique_ptr<XdsRouting::RouteTable> compiled_routes_;
   };
 
   class XdsConfigSelector : public ConfigSelector {
@@ -415,6 +426,9 @@ class XdsResolver : public Resolver {
   RefCountedPtr<GrpcXdsClient> xds_client_;
   std::string lds_resource_name_;
   std::string data_plane_authority_;
+  // Shared by all xds resolvers, so that channels that get the same
+  // service config share one parsed copy of it.
+  std::shared_ptr<ServiceConfigCache> service_config_cache_;
   uint64_t channel_id_;
 
   ListenerWatcher* listener_watcher_ = nullptr;
@@ -479,14 +493,16 @@ XdsResolver::RouteConfigData::Create(
       return status;
     }
   }
+  data->compiled_routes_ =
+      std::make_unique<XdsRouting::RouteTable>(RouteListIterator(data.get()));
   return data;
 }
 
 XdsResolver::RouteConfigData::RouteEntry*
 XdsResolver::RouteConfigData::GetRouteForRequest(
     absl::string_view path, grpc_metadata_batch* initial_metadata) {
-  auto route_index = XdsRouting::GetRouteForRequest(RouteListIterator(this),
-                                                    path, initial_metadata);
+  auto route_index =
+      compiled_routes_->GetRouteForRequest(path, initial_metadata);
   if (!route_index.has_value()) {
     return nullptr;
   }
@@ -1181,7 +1197,11 @@ XdsResolver::CreateServiceConfig() {
       "  ]\n"
       "}");
   std::string json = absl::StrJoin(config_parts, "");
-  return ServiceConfigImpl::Create(args_, json.c_str());
+  // The cache is keyed by the JSON alone.  That is safe because the config
+  // has no methodConfig section, and the parsers for the global params
+  // do not depend on the channel args.
+  return service_config_cache_->GetOrCreate(
+      json, [&]() { return ServiceConfigImpl::Create(args_, json); });
 }
 
 void XdsResolver::GenerateResult() {
@@ -1253,7 +1273,8 @@ class XdsResolverFactory : public ResolverFactory {
   OrphanablePtr<Resolver> CreateResolver(ResolverArgs args) const override {
     if (!IsValidUri(args.uri)) return nullptr;
     std::string authority = GetDataPlaneAuthority(args.args, args.uri);
-    return MakeOrphanable<XdsResolver>(std::move(args), std::move(authority));
+    return MakeOrphanable<XdsResolver>(std::move(args), std::move(authority),
+                                       service_config_cache_);
   }
 
  private:
@@ -1264,6 +1285,9 @@ class XdsResolverFactory : public ResolverFactory {
     if (authority.has_value()) return URI::PercentEncodeAuthority(*authority);
     return GetDefaultAuthority(uri);
   }
+
+  std::shared_ptr<ServiceConfigCache> service_config_cache_ =
+      std::make_shared<ServiceConfigCache>(kMaxInternedServiceConfigs);
 };
 
 }  // namespace
@@ -81,9 +81,13 @@
 // When constructing the "child" batches, we compare the state in the
 // CallAttempt object against the state in the CallData object to see
 // which batches need to be sent on the LB call for a given attempt.
-
-// TODO(roth): In subsequent PRs:
-// - implement hedging
+//
+// With a hedgingPolicy, the same machinery is used to run several call
+// attempts concurrently: a new attempt is started every hedgingDelay (or
+// right away when an attempt fails with a non-fatal status), and each one
+// replays the cached send ops.  The first attempt to receive data from the
+// server (or to fail with a fatal status) is committed, and all of the
+// other attempts are cancelled.
 
 using grpc_core::internal::RetryGlobalConfig;
 using grpc_core::internal::RetryMethodConfig;
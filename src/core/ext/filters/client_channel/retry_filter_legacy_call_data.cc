@@ -120,6 +120,7 @@ RetryFilter::LegacyCallData::CallAttempt::CallAttempt(
     : RefCounted(GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace) ? "CallAttempt"
                                                            : nullptr),
       calld_(calld),
+      num_previous_hedged_attempts_(calld->num_attempts_started_),
       batch_payload_(calld->call_context_),
       started_send_initial_metadata_(false),
       completed_send_initial_metadata_(false),
@@ -135,7 +136,7 @@ RetryFilter::LegacyCallData::CallAttempt::CallAttempt(
   lb_call_ = calld->CreateLoadBalancedCall(
       [this]() {
         lb_call_committed_ = true;
-        if (calld_->retry_committed_) {
+        if (calld_->retry_committed_ && !abandoned_) {
           auto* service_config_call_data =
               static_cast<ClientChannelServiceConfigCallData*>(
                   calld_->call_context_[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA]
@@ -181,10 +182,8 @@ RetryFilter::LegacyCallData::CallAttempt::~CallAttempt() {
 
 void RetryFilter::LegacyCallData::CallAttempt::
     FreeCachedSendOpDataAfterCommit() {
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
+  // Note: Not used with hedging, because abandoned attempts may still
+  // be using this data.
   if (completed_send_initial_metadata_) {
     calld_->FreeCachedSendInitialMetadata();
   }
@@ -225,10 +224,9 @@ bool RetryFilter::LegacyCallData::CallAttempt::HaveSendOpsToReplay() {
 
 void RetryFilter::LegacyCallData::CallAttempt::MaybeSwitchToFastPath() {
   // If we're not yet committed, we can't switch yet.
-  // TODO(roth): As part of implementing hedging, this logic needs to
-  // check that *this* call attempt is the one that we've committed to.
-  // Might need to replace abandoned_ with an enum indicating whether we're
-  // in flight, abandoned, or the winning call attempt.
+  // Note that with hedging, committing cancels all other attempts and
+  // removes them from calld_->call_attempts_, so this attempt is the one
+  // that we've committed to.
   if (!calld_->retry_committed_) return;
   // If we've already switched to fast path, there's nothing to do here.
   if (calld_->committed_call_ != nullptr) return;
@@ -247,7 +245,7 @@ void RetryFilter::LegacyCallData::CallAttempt::MaybeSwitchToFastPath() {
             calld_->chand_, calld_, this);
   }
   calld_->committed_call_ = std::move(lb_call_);
-  calld_->call_attempt_.reset(DEBUG_LOCATION, "MaybeSwitchToFastPath");
+  calld_->call_attempts_.clear();
 }
 
 // If there are any cached send ops that need to be replayed on the
@@ -552,11 +550,28 @@ void RetryFilter::LegacyCallData::CallAttempt::CancelFromSurface(
   lb_call_->StartTransportStreamOpBatch(cancel_batch);
 }
 
+void RetryFilter::LegacyCallData::CallAttempt::CancelHedgedAttempt(
+    CallCombinerClosureList* closures) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p attempt=%p: cancelling hedged attempt",
+            calld_->chand_, calld_, this);
+  }
+  MaybeCancelPerAttemptRecvTimer();
+  Abandon();
+  MaybeAddBatchForCancelOp(
+      grpc_error_set_int(
+          GRPC_ERROR_CREATE("call committed to another hedged attempt"),
+          StatusIntProperty::kRpcStatus, GRPC_STATUS_CANCELLED),
+      closures);
+}
+
 bool RetryFilter::LegacyCallData::CallAttempt::ShouldRetry(
     absl::optional<grpc_status_code> status,
     absl::optional<Duration> server_pushback) {
-  // If no retry policy, don't retry.
-  if (calld_->retry_policy_ == nullptr) return false;
+  // If no retry policy, don't retry.  Hedged attempts are handled by
+  // MaybeContinueHedging() instead.
+  if (calld_->retry_policy_ == nullptr || calld_->hedging()) return false;
   // Check status.
   if (status.has_value()) {
     if (GPR_LIKELY(*status == GRPC_STATUS_OK)) {
@@ -776,10 +791,8 @@ RetryFilter::LegacyCallData::CallAttempt::BatchData::~BatchData() {
 void RetryFilter::LegacyCallData::CallAttempt::BatchData::
     FreeCachedSendOpDataForCompletedBatch() {
   auto* calld = call_attempt_->calld_;
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
+  // Note: Not used with hedging, because abandoned attempts may still
+  // be using this data.
   if (batch_.send_initial_metadata) {
     calld->FreeCachedSendInitialMetadata();
   }
@@ -1170,7 +1183,13 @@ void RetryFilter::LegacyCallData::CallAttempt::BatchData::
   }
   // Check if we should retry.
   if (!is_lb_drop) {  // Never retry on LB drops.
-    enum { kNoRetry, kTransparentRetry, kConfigurableRetry } retry = kNoRetry;
+    enum {
+      kNoRetry,
+      kTransparentRetry,
+      kConfigurableRetry,
+      kHedge
+    } retry = kNoRetry;
+    CallCombinerClosureList closures;
     // Handle transparent retries.
     if (stream_network_state.has_value() && !calld->retry_committed_) {
       // If not sent on wire, then always retry.
@@ -1184,14 +1203,19 @@ void RetryFilter::LegacyCallData::CallAttempt::BatchData::
         retry = kTransparentRetry;
       }
     }
-    // If not transparently retrying, check for configurable retry.
-    if (retry == kNoRetry &&
-        call_attempt->ShouldRetry(status, server_pushback)) {
-      retry = kConfigurableRetry;
+    // If not transparently retrying, check for configurable retry or,
+    // with hedging, whether to continue on the other attempts.
+    if (retry == kNoRetry) {
+      if (calld->hedging()) {
+        if (calld->MaybeContinueHedging(status, server_pushback, &closures)) {
+          retry = kHedge;
+        }
+      } else if (call_attempt->ShouldRetry(status, server_pushback)) {
+        retry = kConfigurableRetry;
+      }
     }
     // If we're retrying, do so.
     if (retry != kNoRetry) {
-      CallCombinerClosureList closures;
       // Cancel call attempt.
       call_attempt->MaybeAddBatchForCancelOp(
           error.ok() ? grpc_error_set_int(
@@ -1202,13 +1226,16 @@ void RetryFilter::LegacyCallData::CallAttempt::BatchData::
       // For transparent retries, add a closure to immediately start a new
       // call attempt.
       // For configurable retries, start retry timer.
+      // For hedging, MaybeContinueHedging() has already added batches for
+      // the next attempt or started the hedging timer, if needed.
       if (retry == kTransparentRetry) {
         calld->AddClosureToStartTransparentRetry(&closures);
-      } else {
+      } else if (retry == kConfigurableRetry) {
         calld->StartRetryTimer(server_pushback);
       }
       // Record that this attempt has been abandoned.
       call_attempt->Abandon();
+      calld->RemoveCallAttempt(call_attempt);
       // Yields call combiner.
       closures.RunClosures(calld->call_combiner_);
       return;
@@ -1232,10 +1259,16 @@ void RetryFilter::LegacyCallData::CallAttempt::BatchData::
                                         CallCombinerClosureList* closures) {
   auto* calld = call_attempt_->calld_;
   PendingBatch* pending = calld->PendingBatchFind(
-      "completed", [this](grpc_transport_stream_op_batch* batch) {
+      "completed", [this, calld](grpc_transport_stream_op_batch* batch) {
         // Match the pending batch with the same set of send ops as the
-        // batch we've just completed.
+        // batch we've just completed.  Skip pending batches whose send ops
+        // have not been cached yet: no attempt has started them, and
+        // completing them would let the surface free their payloads.
+        // This can happen when one hedged attempt completes a send op
+        // that was replayed from the cache.
         return batch->on_complete != nullptr &&
+               calld->pending_batches_[GetBatchIndex(batch)]
+                   .send_ops_cached &&
                batch_.send_initial_metadata == batch->send_initial_metadata &&
                batch_.send_message == batch->send_message &&
                batch_.send_trailing_metadata == batch->send_trailing_metadata;
@@ -1340,8 +1373,9 @@ void RetryFilter::LegacyCallData::CallAttempt::BatchData::OnComplete(
     call_attempt->completed_send_trailing_metadata_ = true;
   }
   // If the call is committed, free cached data for send ops that we've just
-  // completed.
-  if (calld->retry_committed_) {
+  // completed.  With hedging, the cached data is freed when the call is
+  // destroyed instead.
+  if (calld->retry_committed_ && !calld->hedging()) {
     batch_data->FreeCachedSendOpDataForCompletedBatch();
   }
   // Construct list of closures to execute.
@@ -1392,12 +1426,15 @@ void RetryFilter::LegacyCallData::CallAttempt::BatchData::
   // the filters in the subchannel stack may modify this batch, and we don't
   // want those modifications to be passed forward to subsequent attempts.
   //
-  // If we've already completed one or more attempts, add the
-  // grpc-retry-attempts header.
+  // If we've already completed one or more attempts (or, with hedging,
+  // started one or more other attempts), add the grpc-retry-attempts header.
   call_attempt_->send_initial_metadata_ = calld->send_initial_metadata_.Copy();
-  if (GPR_UNLIKELY(calld->num_attempts_completed_ > 0)) {
+  const int num_previous_attempts =
+      calld->hedging() ? call_attempt_->num_previous_hedged_attempts_
+                       : calld->num_attempts_completed_;
+  if (GPR_UNLIKELY(num_previous_attempts > 0)) {
     call_attempt_->send_initial_metadata_.Set(GrpcPreviousRpcAttemptsMetadata(),
-                                              calld->num_attempts_completed_);
+                                              num_previous_attempts);
   } else {
     call_attempt_->send_initial_metadata_.Remove(
         GrpcPreviousRpcAttemptsMetadata());
@@ -1615,19 +1652,23 @@ void RetryFilter::LegacyCallData::StartTransportStreamOpBatch(
     PendingBatchesFail(cancelled_from_surface_);
     // If we have a current call attempt, commit the call, then send
     // the cancellation down to that attempt.  When the call fails, it
-    // will not be retried, because we have committed it here.
-    if (call_attempt_ != nullptr) {
-      RetryCommit(call_attempt_.get());
-      // TODO(roth): When implementing hedging, this will get more
-      // complex, because instead of just passing the batch down to a
-      // single call attempt, we'll need to cancel multiple call
-      // attempts and wait for the cancellation on_complete from each call
-      // attempt before we propagate the on_complete from this batch
-      // back to the surface.
+    // will not be retried, because we have committed it here.  With
+    // hedging, committing sends our own cancellation to all of the other
+    // attempts, so only the attempt we commit to sees the surface's
+    // cancellation batch.
+    if (!call_attempts_.empty()) {
+      RefCountedPtr<CallAttempt> call_attempt = call_attempts_.front();
+      RetryCommit(call_attempt.get());
       // Note: This will release the call combiner.
-      call_attempt_->CancelFromSurface(batch);
+      call_attempt->CancelFromSurface(batch);
       return;
     }
+    // Cancel hedging timer, which may be pending after all attempts failed
+    // with server push-back.
+    if (hedging_timer_handle_.has_value()) {
+      MaybeCancelHedgingTimer();
+      FreeAllCachedSendOpData();
+    }
     // Cancel retry timer if needed.
     if (retry_timer_handle_.has_value()) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
@@ -1657,7 +1698,16 @@ void RetryFilter::LegacyCallData::StartTransportStreamOpBatch(
     return;
   }
   // If we do not yet have a call attempt, create one.
-  if (call_attempt_ == nullptr) {
+  if (call_attempts_.empty()) {
+    // If we have already started an attempt, then the next one will be
+    // started by a pending transparent retry or hedging timer, and it will
+    // pick up this batch.
+    if (retry_codepath_started_) {
+      GRPC_CALL_COMBINER_STOP(call_combiner_,
+                              "added pending batch while waiting for next "
+                              "call attempt");
+      return;
+    }
     // If this is the first batch and retries are already committed
     // (e.g., if this batch put the call above the buffer size limit), then
     // immediately create an LB call and delegate the batch to it.  This
@@ -1700,15 +1750,30 @@ void RetryFilter::LegacyCallData::StartTransportStreamOpBatch(
               this);
     }
     retry_codepath_started_ = true;
-    CreateCallAttempt(/*is_transparent_retry=*/false);
+    CreateCallAttempt(/*is_transparent_retry=*/false)->StartRetriableBatches();
+    return;
+  }
+  // Send batches to call attempts.
+  if (call_attempts_.size() == 1) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: starting batch on attempt=%p",
+              chand_, this, call_attempts_.front().get());
+    }
+    call_attempts_.front()->StartRetriableBatches();
     return;
   }
-  // Send batches to call attempt.
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
-    gpr_log(GPR_INFO, "chand=%p calld=%p: starting batch on attempt=%p", chand_,
-            this, call_attempt_.get());
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: starting batch on %" PRIuPTR
+            " hedged attempts",
+            chand_, this, call_attempts_.size());
+  }
+  CallCombinerClosureList closures;
+  for (const auto& call_attempt : call_attempts_) {
+    call_attempt->AddRetriableBatches(&closures);
   }
-  call_attempt_->StartRetriableBatches();
+  // Note: This will yield the call combiner.
+  closures.RunClosures(call_combiner_);
 }
 
 OrphanablePtr<ClientChannel::FilterBasedLoadBalancedCall>
@@ -1725,9 +1790,28 @@ RetryFilter::LegacyCallData::CreateLoadBalancedCall(
       std::move(on_commit), is_transparent_retry);
 }
 
-void RetryFilter::LegacyCallData::CreateCallAttempt(bool is_transparent_retry) {
-  call_attempt_ = MakeRefCounted<CallAttempt>(this, is_transparent_retry);
-  call_attempt_->StartRetriableBatches();
+RetryFilter::LegacyCallData::CallAttempt*
+RetryFilter::LegacyCallData::CreateCallAttempt(bool is_transparent_retry) {
+  call_attempts_.push_back(
+      MakeRefCounted<CallAttempt>(this, is_transparent_retry));
+  CallAttempt* call_attempt = call_attempts_.back().get();
+  // With hedging, each non-transparent attempt arms the timer for the next
+  // one.  Transparent retries replace an attempt that never reached the
+  // server, so they do not count against maxAttempts.
+  if (hedging() && !is_transparent_retry) {
+    ++num_attempts_started_;
+    MaybeStartHedgingTimer(retry_policy_->hedging_delay());
+  }
+  return call_attempt;
+}
+
+void RetryFilter::LegacyCallData::RemoveCallAttempt(CallAttempt* call_attempt) {
+  for (auto it = call_attempts_.begin(); it != call_attempts_.end(); ++it) {
+    if (it->get() == call_attempt) {
+      call_attempts_.erase(it);
+      return;
+    }
+  }
 }
 
 //
@@ -1846,9 +1930,6 @@ RetryFilter::LegacyCallData::PendingBatchesAdd(
   if (batch->send_trailing_metadata) {
     pending_send_trailing_metadata_ = true;
   }
-  // TODO(roth): When we implement hedging, if there are currently attempts
-  // in flight, we will need to pick the one on which the max number of send
-  // ops have already been sent, and we commit to that attempt.
   if (GPR_UNLIKELY(bytes_buffered_for_retry_ >
                    chand_->per_rpc_retry_buffer_size())) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
@@ -1856,7 +1937,17 @@ RetryFilter::LegacyCallData::PendingBatchesAdd(
               "chand=%p calld=%p: exceeded retry buffer size, committing",
               chand_, this);
     }
-    RetryCommit(call_attempt_.get());
+    // With hedging, commit to the attempt that has sent the most messages,
+    // since it has the least to replay.
+    CallAttempt* call_attempt = nullptr;
+    for (const auto& attempt : call_attempts_) {
+      if (call_attempt == nullptr ||
+          attempt->started_send_message_count() >
+              call_attempt->started_send_message_count()) {
+        call_attempt = attempt.get();
+      }
+    }
+    RetryCommit(call_attempt);
   }
   return pending;
 }
@@ -1967,6 +2058,25 @@ void RetryFilter::LegacyCallData::RetryCommit(CallAttempt* call_attempt) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: committing retries", chand_, this);
   }
   if (call_attempt != nullptr) {
+    // With hedging, stop starting new attempts and cancel all attempts
+    // other than the one we're committing to.
+    if (hedging()) {
+      MaybeCancelHedgingTimer();
+      CallCombinerClosureList closures;
+      RefCountedPtr<CallAttempt> committed_attempt;
+      for (auto& attempt : call_attempts_) {
+        if (attempt.get() == call_attempt) {
+          committed_attempt = std::move(attempt);
+        } else {
+          attempt->CancelHedgedAttempt(&closures);
+        }
+      }
+      call_attempts_.clear();
+      if (committed_attempt != nullptr) {
+        call_attempts_.push_back(std::move(committed_attempt));
+      }
+      closures.RunClosuresWithoutYielding(call_combiner_);
+    }
     // If the call attempt's LB call has been committed, invoke the
     // call's on_commit callback.
     // Note: If call_attempt is null, this is happening before the first
@@ -1979,15 +2089,17 @@ void RetryFilter::LegacyCallData::RetryCommit(CallAttempt* call_attempt) {
               call_context_[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA].value);
       service_config_call_data->Commit();
     }
-    // Free cached send ops.
-    call_attempt->FreeCachedSendOpDataAfterCommit();
+    // Free cached send ops.  With hedging, replay batches on the attempts
+    // we just cancelled may still reference them, so they are kept until
+    // the call is destroyed.
+    if (!hedging()) call_attempt->FreeCachedSendOpDataAfterCommit();
   }
 }
 
 void RetryFilter::LegacyCallData::StartRetryTimer(
     absl::optional<Duration> server_pushback) {
   // Reset call attempt.
-  call_attempt_.reset(DEBUG_LOCATION, "StartRetryTimer");
+  call_attempts_.clear();
   // Compute backoff delay.
   Duration next_attempt_timeout;
   if (server_pushback.has_value()) {
@@ -2022,7 +2134,8 @@ void RetryFilter::LegacyCallData::OnRetryTimerLocked(
     void* arg, grpc_error_handle /*error*/) {
   auto* calld = static_cast<RetryFilter::LegacyCallData*>(arg);
   calld->retry_timer_handle_.reset();
-  calld->CreateCallAttempt(/*is_transparent_retry=*/false);
+  calld->CreateCallAttempt(/*is_transparent_retry=*/false)
+      ->StartRetriableBatches();
   GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnRetryTimer");
 }
 
@@ -2033,20 +2146,168 @@ void RetryFilter::LegacyCallData::AddClosureToStartTransparentRetry(
             this);
   }
   GRPC_CALL_STACK_REF(owning_call_, "OnRetryTimer");
-  GRPC_CLOSURE_INIT(&retry_closure_, StartTransparentRetry, this, nullptr);
-  closures->Add(&retry_closure_, absl::OkStatus(), "start transparent retry");
+  // With hedging, several attempts may be transparently retried at once,
+  // so each one gets its own closure.
+  grpc_closure* closure = arena_->New<grpc_closure>();
+  GRPC_CLOSURE_INIT(closure, StartTransparentRetry, this, nullptr);
+  closures->Add(closure, absl::OkStatus(), "start transparent retry");
 }
 
 void RetryFilter::LegacyCallData::StartTransparentRetry(
     void* arg, grpc_error_handle /*error*/) {
   auto* calld = static_cast<RetryFilter::LegacyCallData*>(arg);
-  if (calld->cancelled_from_surface_.ok()) {
-    calld->CreateCallAttempt(/*is_transparent_retry=*/true);
-  } else {
+  if (!calld->cancelled_from_surface_.ok()) {
     GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
                             "call cancelled before transparent retry");
+  } else if (calld->committed_call_ != nullptr ||
+             (calld->retry_committed_ && !calld->call_attempts_.empty())) {
+    // With hedging, another attempt may have been committed to meanwhile.
+    GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
+                            "call committed before transparent retry");
+  } else {
+    calld->CreateCallAttempt(/*is_transparent_retry=*/true)
+        ->StartRetriableBatches();
   }
   GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnRetryTimer");
 }
 
+//
+// hedging code
+//
+
+bool RetryFilter::LegacyCallData::MaybeContinueHedging(
+    grpc_status_code status, absl::optional<Duration> server_pushback,
+    CallCombinerClosureList* closures) {
+  if (GPR_LIKELY(status == GRPC_STATUS_OK)) {
+    if (retry_throttle_data_ != nullptr) retry_throttle_data_->RecordSuccess();
+    return false;
+  }
+  // Only statuses configured as non-fatal let the other attempts continue.
+  if (!retry_policy_->non_fatal_status_codes().Contains(status)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p: status %s not configured as non-fatal for "
+              "hedging",
+              chand_, this, grpc_status_code_to_string(status));
+    }
+    return false;
+  }
+  // As with retries, record the failure only for non-fatal statuses.
+  // The throttle shares its token bucket with retries.
+  const bool throttled = retry_throttle_data_ != nullptr &&
+                         !retry_throttle_data_->RecordFailure();
+  if (retry_committed_) return false;
+  // Negative push-back means that no further attempts should be started,
+  // although the ones already in flight may still succeed.
+  if (server_pushback.has_value() && *server_pushback < Duration::Zero()) {
+    hedging_stopped_ = true;
+  }
+  if (!throttled && !hedging_stopped_ &&
+      num_attempts_started_ < retry_policy_->max_attempts()) {
+    if (server_pushback.has_value()) {
+      // Start the next attempt after the push-back delay instead of the
+      // hedging delay.
+      MaybeCancelHedgingTimer();
+      MaybeStartHedgingTimer(*server_pushback);
+    } else {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+        gpr_log(GPR_INFO,
+                "chand=%p calld=%p: hedged attempt failed, starting next "
+                "attempt",
+                chand_, this);
+      }
+      CreateCallAttempt(/*is_transparent_retry=*/false)
+          ->AddRetriableBatches(closures);
+    }
+    return true;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: not starting more hedged attempts "
+            "(throttled=%d, stopped=%d, started=%d); %" PRIuPTR
+            " attempts in flight",
+            chand_, this, throttled, hedging_stopped_, num_attempts_started_,
+            call_attempts_.size());
+  }
+  // Continue as long as any other attempt is still in flight.
+  return call_attempts_.size() > 1;
+}
+
+void RetryFilter::LegacyCallData::MaybeStartHedgingTimer(Duration delay) {
+  if (hedging_timer_handle_.has_value() || retry_committed_ ||
+      hedging_stopped_ ||
+      num_attempts_started_ >= retry_policy_->max_attempts()) {
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: starting next hedged attempt in %" PRId64
+            " ms",
+            chand_, this, delay.millis());
+  }
+  GRPC_CALL_STACK_REF(owning_call_, "OnHedgingTimer");
+  hedging_timer_handle_ = chand_->event_engine()->RunAfter(delay, [this] {
+    ApplicationCallbackExecCtx callback_exec_ctx;
+    ExecCtx exec_ctx;
+    OnHedgingTimer();
+  });
+}
+
+void RetryFilter::LegacyCallData::MaybeCancelHedgingTimer() {
+  if (hedging_timer_handle_.has_value()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: cancelling hedging timer", chand_,
+              this);
+    }
+    if (chand_->event_engine()->Cancel(*hedging_timer_handle_)) {
+      GRPC_CALL_STACK_UNREF(owning_call_, "OnHedgingTimer");
+    }
+    hedging_timer_handle_.reset();
+  }
+}
+
+bool RetryFilter::LegacyCallData::ShouldStartHedgedAttempt() {
+  if (!cancelled_from_surface_.ok() || committed_call_ != nullptr) {
+    return false;
+  }
+  // If every attempt has failed, the timer was started for push-back, and
+  // the call needs a new attempt even if it has since been committed due
+  // to the retry buffer size.
+  if (call_attempts_.empty()) return true;
+  if (retry_committed_ || hedging_stopped_ ||
+      num_attempts_started_ >= retry_policy_->max_attempts()) {
+    return false;
+  }
+  // Unlike retries, hedged attempts are started before any failure is
+  // recorded, so check the throttle without updating it.
+  if (retry_throttle_data_ != nullptr && retry_throttle_data_->IsThrottled()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: hedged attempts throttled", chand_,
+              this);
+    }
+    return false;
+  }
+  return true;
+}
+
+void RetryFilter::LegacyCallData::OnHedgingTimer() {
+  GRPC_CLOSURE_INIT(&hedging_closure_, OnHedgingTimerLocked, this, nullptr);
+  GRPC_CALL_COMBINER_START(call_combiner_, &hedging_closure_, absl::OkStatus(),
+                           "hedging timer fired");
+}
+
+void RetryFilter::LegacyCallData::OnHedgingTimerLocked(
+    void* arg, grpc_error_handle /*error*/) {
+  auto* calld = static_cast<RetryFilter::LegacyCallData*>(arg);
+  calld->hedging_timer_handle_.reset();
+  if (calld->ShouldStartHedgedAttempt()) {
+    calld->CreateCallAttempt(/*is_transparent_retry=*/false)
+        ->StartRetriableBatches();
+  } else {
+    GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
+                            "hedging timer fired after call committed");
+  }
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnHedgingTimer");
+}
+
 }  // namespace grpc_core
@@ -84,11 +84,17 @@ class RetryFilter::LegacyCallData {
     ~CallAttempt() override;
 
     bool lb_call_committed() const { return lb_call_committed_; }
+    size_t started_send_message_count() const {
+      return started_send_message_count_;
+    }
 
     // Constructs and starts whatever batches are needed on this call
     // attempt.
     void StartRetriableBatches();
 
+    // Adds whatever batches are needed on this attempt to closures.
+    void AddRetriableBatches(CallCombinerClosureList* closures);
+
     // Frees cached send ops that have already been completed after
     // committing the call.
     void FreeCachedSendOpDataAfterCommit();
@@ -96,6 +102,10 @@ class RetryFilter::LegacyCallData {
     // Cancels the call attempt.
     void CancelFromSurface(grpc_transport_stream_op_batch* cancel_batch);
 
+    // Cancels a hedged attempt after the call has been committed to a
+    // different attempt.
+    void CancelHedgedAttempt(CallCombinerClosureList* closures);
+
    private:
     // State used for starting a retryable batch on the call attempt's LB call.
     // This provides its own grpc_transport_stream_op_batch and other data
@@ -229,9 +239,6 @@ class RetryFilter::LegacyCallData {
     // Adds batches for pending batches to closures.
     void AddBatchesForPendingBatches(CallCombinerClosureList* closures);
 
-    // Adds whatever batches are needed on this attempt to closures.
-    void AddRetriableBatches(CallCombinerClosureList* closures);
-
     // Returns true if any send op in the batch was not yet started on this
     // attempt.
     bool PendingBatchContainsUnstartedSendOps(PendingBatch* pending);
@@ -256,6 +263,8 @@ class RetryFilter::LegacyCallData {
     void MaybeCancelPerAttemptRecvTimer();
 
     LegacyCallData* calld_;
+    // For hedging, the number of hedged attempts started before this one.
+    const int num_previous_hedged_attempts_;
     OrphanablePtr<ClientChannel::FilterBasedLoadBalancedCall> lb_call_;
     bool lb_call_committed_ = false;
 
@@ -349,7 +358,12 @@ class RetryFilter::LegacyCallData {
   void FreeCachedSendTrailingMetadata();
   void FreeAllCachedSendOpData();
 
+  bool hedging() const {
+    return retry_policy_ != nullptr && retry_policy_->hedging();
+  }
+
   // Commits the call so that no further retry attempts will be performed.
+  // With hedging, cancels all call attempts other than call_attempt.
   void RetryCommit(CallAttempt* call_attempt);
 
   // Starts a timer to retry after appropriate back-off.
@@ -363,15 +377,37 @@ class RetryFilter::LegacyCallData {
   void AddClosureToStartTransparentRetry(CallCombinerClosureList* closures);
   static void StartTransparentRetry(void* arg, grpc_error_handle error);
 
+  // Called when a hedged attempt fails with status.  Returns true if the
+  // call should continue on other hedged attempts, in which case the
+  // failed attempt is abandoned.  If another attempt should be started
+  // right away, adds its batches to closures.
+  bool MaybeContinueHedging(grpc_status_code status,
+                            absl::optional<Duration> server_pushback,
+                            CallCombinerClosureList* closures);
+
+  // Starts a timer to start the next hedged attempt after delay, unless
+  // one is already pending or no more attempts may be started.
+  void MaybeStartHedgingTimer(Duration delay);
+  void MaybeCancelHedgingTimer();
+  // Returns true if the hedging timer should start another attempt.
+  bool ShouldStartHedgedAttempt();
+
+  void OnHedgingTimer();
+  static void OnHedgingTimerLocked(void* arg, grpc_error_handle /*error*/);
+
   OrphanablePtr<ClientChannel::FilterBasedLoadBalancedCall>
   CreateLoadBalancedCall(absl::AnyInvocable<void()> on_commit,
                          bool is_transparent_retry);
 
-  void CreateCallAttempt(bool is_transparent_retry);
+  // Creates a call attempt and adds it to call_attempts_.  The caller is
+  // responsible for starting its batches.
+  CallAttempt* CreateCallAttempt(bool is_transparent_retry);
+  void RemoveCallAttempt(CallAttempt* call_attempt);
 
   RetryFilter* chand_;
   grpc_polling_entity* pollent_;
   RefCountedPtr<internal::ServerRetryThrottleData> retry_throttle_data_;
+  // Either a retryPolicy or a hedgingPolicy.
   const internal::RetryMethodConfig* retry_policy_ = nullptr;
   BackOff retry_backoff_;
 
@@ -386,10 +422,10 @@ class RetryFilter::LegacyCallData {
 
   RefCountedPtr<CallStackDestructionBarrier> call_stack_destruction_barrier_;
 
-  // TODO(roth): As part of implementing hedging, we will need to maintain a
-  // list of all pending attempts, so that we can cancel them all if the call
-  // gets cancelled.
-  RefCountedPtr<CallAttempt> call_attempt_;
+  // The call attempts in flight.  Without hedging, there is at most one.
+  // With hedging, there may be several until the call is committed, at
+  // which point the others are cancelled and removed from this list.
+  absl::InlinedVector<RefCountedPtr<CallAttempt>, 1> call_attempts_;
 
   // LB call used when we've committed to a call attempt and the retry
   // state for that attempt is no longer needed.  This provides a fast
@@ -416,6 +452,13 @@ class RetryFilter::LegacyCallData {
       retry_timer_handle_;
   grpc_closure retry_closure_;
 
+  // Hedging state.
+  bool hedging_stopped_ = false;  // Set by negative server push-back.
+  int num_attempts_started_ = 0;
+  absl::optional<grpc_event_engine::experimental::EventEngine::TaskHandle>
+      hedging_timer_handle_;
+  grpc_closure hedging_closure_;
+
   // Cached data for retrying send ops.
   // send_initial_metadata
   bool seen_send_initial_metadata_ = false;
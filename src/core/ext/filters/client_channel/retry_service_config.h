@@ -54,9 +54,23 @@ class RetryGlobalConfig : public ServiceConfigParser::ParsedConfig {
   uintptr_t milli_token_ratio_ = 0;
 };
 
+// Holds either a retryPolicy or a hedgingPolicy from a method config.
 class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
  public:
+  RetryMethodConfig() = default;
+  // Creates a hedging policy.
+  RetryMethodConfig(int max_attempts, Duration hedging_delay,
+                    StatusCodeSet non_fatal_status_codes)
+      : max_attempts_(max_attempts),
+        hedging_(true),
+        hedging_delay_(hedging_delay),
+        non_fatal_status_codes_(non_fatal_status_codes) {}
+
+  // True for a hedgingPolicy, false for a retryPolicy.
+  bool hedging() const { return hedging_; }
   int max_attempts() const { return max_attempts_; }
+
+  // Fields used only for retryPolicy.
   Duration initial_backoff() const { return initial_backoff_; }
   Duration max_backoff() const { return max_backoff_; }
   float backoff_multiplier() const { return backoff_multiplier_; }
@@ -67,6 +81,12 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
     return per_attempt_recv_timeout_;
   }
 
+  // Fields used only for hedgingPolicy.
+  Duration hedging_delay() const { return hedging_delay_; }
+  StatusCodeSet non_fatal_status_codes() const {
+    return non_fatal_status_codes_;
+  }
+
   static const JsonLoaderInterface* JsonLoader(const JsonArgs&);
   void JsonPostLoad(const Json& json, const JsonArgs& args,
                     ValidationErrors* errors);
@@ -78,6 +98,9 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
   float backoff_multiplier_ = 0;
   StatusCodeSet retryable_status_codes_;
   absl::optional<Duration> per_attempt_recv_timeout_;
+  bool hedging_ = false;
+  Duration hedging_delay_;
+  StatusCodeSet non_fatal_status_codes_;
 };
 
 class RetryServiceConfigParser : public ServiceConfigParser::Parser {
@@ -106,6 +106,16 @@ void ServerRetryThrottleData::RecordSuccess() {
       static_cast<gpr_atm>(throttle_data->max_milli_tokens_));
 }
 
+bool ServerRetryThrottleData::IsThrottled() {
+  // First, check if we are stale and need to be replaced.
+  ServerRetryThrottleData* throttle_data = this;
+  GetReplacementThrottleDataIfNeeded(&throttle_data);
+  const uintptr_t value = static_cast<uintptr_t>(
+      gpr_atm_no_barrier_load(&throttle_data->milli_tokens_));
+  // Use the same threshold as RecordFailure().
+  return value <= throttle_data->max_milli_tokens_ / 2;
+}
+
 //
 // ServerRetryThrottleMap
 //
@@ -51,6 +51,10 @@ class ServerRetryThrottleData : public RefCounted<ServerRetryThrottleData> {
   /// Records a success.
   void RecordSuccess();
 
+  /// Returns true if retries and hedged attempts are currently throttled,
+  /// without recording anything.
+  bool IsThrottled();
+
   uintptr_t max_milli_tokens() const { return max_milli_tokens_; }
   uintptr_t milli_token_ratio() const { return milli_token_ratio_; }
 
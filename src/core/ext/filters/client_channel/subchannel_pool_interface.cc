@@ -40,7 +40,7 @@ TraceFlag grpc_subchannel_pool_trace(false, "subchannel_pool");
 
 SubchannelKey::SubchannelKey(const grpc_resolved_address& address,
                              const ChannelArgs& args)
-    : address_(address), args_(args) {}
+    : address_(address), args_(args.Intern()) {}
 
 bool SubchannelKey::operator<(const SubchannelKey& other) const {
   if (address_.len < other.address_.len) return true;
@@ -51,6 +51,12 @@ bool SubchannelKey::operator<(const SubchannelKey& other) const {
   return args_ < other.args();
 }
 
+bool SubchannelKey::operator==(const SubchannelKey& other) const {
+  return address_.len == other.address_.len &&
+         memcmp(address_.addr, other.address_.addr, address_.len) == 0 &&
+         args_ == other.args_;
+}
+
 std::string SubchannelKey::ToString() const {
   auto addr_uri = grpc_sockaddr_to_uri(&address_);
   return absl::StrCat(
@@ -22,6 +22,7 @@
 #include <grpc/support/port_platform.h>
 
 #include <string>
+#include <utility>
 
 #include "absl/strings/string_view.h"
 
@@ -39,6 +40,8 @@ class Subchannel;
 extern TraceFlag grpc_subchannel_pool_trace;
 
 // A key that can uniquely identify a subchannel.
+// Holds interned args, so that comparing two keys for equality and hashing
+// a key are O(1) in the number of args.
 class SubchannelKey {
  public:
   SubchannelKey(const grpc_resolved_address& address, const ChannelArgs& args);
@@ -49,6 +52,14 @@ class SubchannelKey {
   SubchannelKey& operator=(SubchannelKey&& other) noexcept = default;
 
   bool operator<(const SubchannelKey& other) const;
+  bool operator==(const SubchannelKey& other) const;
+
+  template <typename H>
+  friend H AbslHashValue(H h, const SubchannelKey& key) {
+    return H::combine(std::move(h),
+                      absl::string_view(key.address_.addr, key.address_.len),
+                      key.args_);
+  }
 
   const grpc_resolved_address& address() const { return address_; }
   const ChannelArgs& args() const { return args_; }
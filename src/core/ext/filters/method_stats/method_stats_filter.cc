@@ -0,0 +1,151 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/method_stats/method_stats_filter.h"
+
+#include <stdint.h>
+
+#include <functional>
+
+#include <grpc/impl/grpc_types.h>
+#include <grpc/status.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/method_stats.h"
+#include "src/core/lib/promise/cancel_callback.h"
+#include "src/core/lib/promise/context.h"
+#include "src/core/lib/promise/map.h"
+#include "src/core/lib/promise/pipe.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/surface/channel_stack_type.h"
+#include "src/core/lib/transport/metadata_batch.h"
+
+namespace grpc_core {
+
+namespace {
+
+bool MethodStatsEnabled(const ChannelArgs& args) {
+  return args.GetBool(GRPC_ARG_ENABLE_METHOD_STATS).value_or(false);
+}
+
+}  // namespace
+
+class MethodStatsFilter::CallData {
+ public:
+  explicit CallData(MethodStatsCollector* stats)
+      : stats_(stats), start_(gpr_get_cycle_counter()) {}
+
+  void AddRequestBytes(size_t bytes) { request_bytes_ += bytes; }
+  void AddResponseBytes(size_t bytes) { response_bytes_ += bytes; }
+
+  void Record(grpc_status_code status) {
+    const gpr_timespec elapsed =
+        gpr_cycle_counter_sub(gpr_get_cycle_counter(), start_);
+    stats_->RecordCall(status != GRPC_STATUS_OK,
+                       gpr_timespec_to_micros(elapsed),
+                       static_cast<int64_t>(request_bytes_),
+                       static_cast<int64_t>(response_bytes_));
+  }
+
+ private:
+  MethodStatsCollector* const stats_;
+  const gpr_cycle_counter start_;
+  uint64_t request_bytes_ = 0;
+  uint64_t response_bytes_ = 0;
+};
+
+ArenaPromise<ServerMetadataHandle> MethodStatsFilter::MakeCallPromise(
+    CallArgs call_args, NextPromiseFactory next_promise_factory) {
+  const Slice* path =
+      call_args.client_initial_metadata->get_pointer(HttpPathMetadata());
+  if (path == nullptr) return next_promise_factory(std::move(call_args));
+  auto* calld = GetContext<Arena>()->New<CallData>(
+      collectors_->Get(path->as_string_view()));
+  call_args.client_to_server_messages->InterceptAndMap(
+      [calld](MessageHandle message) {
+        calld->AddRequestBytes(message->payload()->Length());
+        return message;
+      });
+  call_args.server_to_client_messages->InterceptAndMap(
+      [calld](MessageHandle message) {
+        calld->AddResponseBytes(message->payload()->Length());
+        return message;
+      });
+  return OnCancel(Map(next_promise_factory(std::move(call_args)),
+                      [calld](ServerMetadataHandle trailing_metadata) {
+                        calld->Record(
+                            trailing_metadata->get(GrpcStatusMetadata())
+                                .value_or(GRPC_STATUS_UNKNOWN));
+                        return trailing_metadata;
+                      }),
+                  [calld]() { calld->Record(GRPC_STATUS_CANCELLED); });
+}
+
+absl::StatusOr<ClientMethodStatsFilter> ClientMethodStatsFilter::Create(
+    const ChannelArgs& args, ChannelFilter::Args) {
+  return ClientMethodStatsFilter(
+      args.GetOwnedString(GRPC_ARG_SERVER_URI).value_or(""));
+}
+
+absl::StatusOr<ServerMethodStatsFilter> ServerMethodStatsFilter::Create(
+    const ChannelArgs&, ChannelFilter::Args) {
+  return ServerMethodStatsFilter("");
+}
+
+const grpc_channel_filter ClientMethodStatsFilter::kFilter =
+    MakePromiseBasedFilter<ClientMethodStatsFilter, FilterEndpoint::kClient,
+                           kFilterExaminesInboundMessages |
+                               kFilterExaminesOutboundMessages>(
+        "client_method_stats");
+const grpc_channel_filter ServerMethodStatsFilter::kFilter =
+    MakePromiseBasedFilter<ServerMethodStatsFilter, FilterEndpoint::kServer,
+                           kFilterExaminesInboundMessages |
+                               kFilterExaminesOutboundMessages>(
+        "server_method_stats");
+
+void RegisterMethodStatsFilters(CoreConfiguration::Builder* builder) {
+  builder->channel_init()->RegisterStage(
+      GRPC_CLIENT_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      [](ChannelStackBuilder* builder) {
+        auto channel_args = builder->channel_args();
+        if (!channel_args.WantMinimalStack() &&
+            MethodStatsEnabled(channel_args)) {
+          builder->PrependFilter(&ClientMethodStatsFilter::kFilter);
+        }
+        return true;
+      });
+  builder->channel_init()->RegisterStage(
+      GRPC_SERVER_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      [](ChannelStackBuilder* builder) {
+        auto channel_args = builder->channel_args();
+        if (!channel_args.WantMinimalStack() &&
+            MethodStatsEnabled(channel_args)) {
+          builder->PrependFilter(&ServerMethodStatsFilter::kFilter);
+        }
+        return true;
+      });
+}
+
+}  // namespace grpc_core
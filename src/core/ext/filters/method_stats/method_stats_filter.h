@@ -0,0 +1,81 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_METHOD_STATS_METHOD_STATS_FILTER_H
+#define GRPC_SRC_CORE_EXT_FILTERS_METHOD_STATS_METHOD_STATS_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/status/statusor.h"
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_fwd.h"
+#include "src/core/lib/channel/promise_based_filter.h"
+#include "src/core/lib/debug/method_stats.h"
+#include "src/core/lib/promise/arena_promise.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+
+// Records the latency and payload sizes of each call to the
+// MethodStatsRegistry, keyed by the channel target (empty on servers) and
+// the call's path.  Each channel resolves a method's collector once and
+// caches it, so recording a call doesn't touch the registry's locks.
+class MethodStatsFilter : public ChannelFilter {
+ public:
+  ArenaPromise<ServerMetadataHandle> MakeCallPromise(
+      CallArgs call_args, NextPromiseFactory next_promise_factory) override;
+
+ protected:
+  explicit MethodStatsFilter(std::string target)
+      : collectors_(
+            std::make_unique<MethodStatsCollectorCache>(std::move(target))) {}
+
+ private:
+  class CallData;
+
+  std::unique_ptr<MethodStatsCollectorCache> collectors_;
+};
+
+class ClientMethodStatsFilter final : public MethodStatsFilter {
+ public:
+  static const grpc_channel_filter kFilter;
+
+  static absl::StatusOr<ClientMethodStatsFilter> Create(
+      const ChannelArgs& args, ChannelFilter::Args filter_args);
+
+ private:
+  using MethodStatsFilter::MethodStatsFilter;
+};
+
+class ServerMethodStatsFilter final : public MethodStatsFilter {
+ public:
+  static const grpc_channel_filter kFilter;
+
+  static absl::StatusOr<ServerMethodStatsFilter> Create(
+      const ChannelArgs& args, ChannelFilter::Args filter_args);
+
+ private:
+  using MethodStatsFilter::MethodStatsFilter;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_METHOD_STATS_METHOD_STATS_FILTER_H
@@ -0,0 +1,154 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/response_cache/response_cache.h"
+
+#include <algorithm>
+
+#include "absl/types/optional.h"
+
+#include <grpc/event_engine/memory_request.h>
+#include <grpc/support/log.h>
+
+namespace grpc_core {
+
+ResponseCache::ResponseCache(size_t size_limit, MemoryOwner memory_owner)
+    : size_limit_(size_limit), memory_owner_(std::move(memory_owner)) {}
+
+ResponseCache::LookupResult ResponseCache::Lookup(
+    const Key& key, Waiter* waiter, std::shared_ptr<const Response>* response) {
+  MutexLock lock(&mu_);
+  auto it = map_.find(key);
+  if (it != map_.end()) {
+    Entry& entry = it->second;
+    // Another call is fetching the response.
+    if (entry.response == nullptr) {
+      entry.waiters.push_back(waiter);
+      return LookupResult::kWait;
+    }
+    if (entry.expiration > Timestamp::Now()) {
+      lru_list_.splice(lru_list_.end(), lru_list_, entry.lru_iterator);
+      *response = entry.response;
+      return LookupResult::kHit;
+    }
+    RemoveLocked(it);
+  }
+  // Add an unfilled entry, so that calls with the same key wait for this one.
+  map_.emplace(key, Entry());
+  return LookupResult::kFill;
+}
+
+void ResponseCache::FinishFill(const Key& key, Duration ttl,
+                               std::shared_ptr<const Response> response) {
+  std::vector<Waiter*> waiters;
+  {
+    MutexLock lock(&mu_);
+    auto it = map_.find(key);
+    GPR_ASSERT(it != map_.end());
+    Entry& entry = it->second;
+    GPR_ASSERT(entry.response == nullptr);
+    waiters = std::move(entry.waiters);
+    const size_t size =
+        response == nullptr ? 0 : EntrySize(it->first, *response);
+    if (response == nullptr || ttl <= Duration::Zero() || size > size_limit_) {
+      map_.erase(it);
+    } else {
+      MaybeShrinkSizeLocked(size_limit_ - size);
+      entry.response = response;
+      entry.expiration = Timestamp::Now() + ttl;
+      entry.size = size;
+      entry.lru_iterator = lru_list_.insert(lru_list_.end(), &it->first);
+      size_ += size;
+      memory_owner_.Reserve(size);
+      MaybePostReclaimerLocked();
+    }
+  }
+  // Waiters get the response even if it was too large to cache.
+  for (Waiter* waiter : waiters) waiter->OnFillDone(response);
+}
+
+bool ResponseCache::CancelWait(const Key& key, Waiter* waiter) {
+  MutexLock lock(&mu_);
+  auto it = map_.find(key);
+  if (it == map_.end()) return false;
+  std::vector<Waiter*>& waiters = it->second.waiters;
+  auto waiter_it = std::find(waiters.begin(), waiters.end(), waiter);
+  if (waiter_it == waiters.end()) return false;
+  waiters.erase(waiter_it);
+  return true;
+}
+
+void ResponseCache::Orphan() {
+  {
+    MutexLock lock(&mu_);
+    shutdown_ = true;
+    MaybeShrinkSizeLocked(0);
+  }
+  // Cancels the reclaimer, if any.  Done without holding mu_, since the
+  // reclaimer acquires it.
+  memory_owner_.Reset();
+}
+
+size_t ResponseCache::EntrySize(const Key& key, const Response& response) {
+  size_t size = sizeof(Key) + sizeof(Entry) + sizeof(Response) +
+                key.method.size() + key.request.size() +
+                response.message.length();
+  for (const Metadata* metadata :
+       {&response.initial_metadata, &response.trailing_metadata}) {
+    for (const auto& p : *metadata) {
+      size += sizeof(p) + p.first.size() + p.second.size();
+    }
+  }
+  return size;
+}
+
+void ResponseCache::MaybeShrinkSizeLocked(size_t bytes) {
+  while (size_ > bytes) {
+    GPR_ASSERT(!lru_list_.empty());
+    auto it = map_.find(*lru_list_.front());
+    GPR_ASSERT(it != map_.end());
+    RemoveLocked(it);
+  }
+}
+
+void ResponseCache::RemoveLocked(Map::iterator it) {
+  Entry& entry = it->second;
+  GPR_ASSERT(entry.response != nullptr);
+  size_ -= entry.size;
+  memory_owner_.Release(entry.size);
+  lru_list_.erase(entry.lru_iterator);
+  map_.erase(it);
+}
+
+void ResponseCache::MaybePostReclaimerLocked() {
+  if (reclaimer_posted_) return;
+  reclaimer_posted_ = true;
+  // Dropping cached responses is always safe, so do it in the benign pass.
+  // The reclaimer is re-posted when the next response is cached.
+  memory_owner_.PostReclaimer(
+      ReclamationPass::kBenign,
+      [self = WeakRef()](absl::optional<ReclamationSweep> sweep) {
+        if (!sweep.has_value()) return;
+        MutexLock lock(&self->mu_);
+        self->reclaimer_posted_ = false;
+        if (self->shutdown_) return;
+        self->MaybeShrinkSizeLocked(0);
+      });
+}
+
+}  // namespace grpc_core
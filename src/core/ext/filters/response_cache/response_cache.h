@@ -0,0 +1,166 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_RESPONSE_CACHE_RESPONSE_CACHE_H
+#define GRPC_SRC_CORE_EXT_FILTERS_RESPONSE_CACHE_RESPONSE_CACHE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/dual_ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/slice/slice.h"
+
+namespace grpc_core {
+
+// A cache of responses to unary calls, shared by all calls on a channel.
+//
+// Entries are keyed by method and serialized request message.  While a
+// call is fetching the response for a key, other calls with the same key
+// wait for it instead of sending their own request (single-flight).
+//
+// The total size of the cached responses is bounded, and is accounted
+// against the memory quota that the cache was created with.  Entries are
+// evicted in LRU order when the bound is reached, and all entries are
+// dropped when the quota asks for memory back.
+class ResponseCache : public DualRefCounted<ResponseCache> {
+ public:
+  using Metadata = std::vector<std::pair<std::string, std::string>>;
+
+  // A cached response.  Metadata is stored in its wire form.
+  struct Response {
+    Metadata initial_metadata;
+    Slice message;
+    uint32_t message_flags = 0;
+    Metadata trailing_metadata;
+  };
+
+  struct Key {
+    std::string method;
+    std::string request;
+
+    bool operator==(const Key& other) const {
+      return method == other.method && request == other.request;
+    }
+
+    template <typename H>
+    friend H AbslHashValue(H h, const Key& key) {
+      return H::combine(std::move(h), key.method, key.request);
+    }
+  };
+
+  // A call waiting for another call with the same key to fetch the response.
+  class Waiter {
+   public:
+    virtual ~Waiter() = default;
+
+    // Called without the cache's lock held when the fetch is done.
+    // response is null if the fetch did not produce a cacheable response.
+    virtual void OnFillDone(std::shared_ptr<const Response> response) = 0;
+  };
+
+  enum class LookupResult {
+    // *response has been set to the cached response.
+    kHit,
+    // No response is cached and no other call is fetching one.  The caller
+    // must fetch it and then call FinishFill().
+    kFill,
+    // Another call is fetching the response.  The waiter will be notified
+    // when it is done, unless CancelWait() is called first.
+    kWait,
+  };
+
+  ResponseCache(size_t size_limit, MemoryOwner memory_owner);
+
+  static absl::string_view ChannelArgName() {
+    return "grpc.internal.response_cache";
+  }
+  static int ChannelArgsCompare(const ResponseCache* a,
+                                const ResponseCache* b) {
+    return QsortCompare(a, b);
+  }
+
+  LookupResult Lookup(const Key& key, Waiter* waiter,
+                      std::shared_ptr<const Response>* response);
+
+  // Finishes a fill started by Lookup().  If response is non-null, it is
+  // cached for ttl.  Either way, waiters for the key are notified.
+  void FinishFill(const Key& key, Duration ttl,
+                  std::shared_ptr<const Response> response);
+
+  // Stops waiting for a fill.  Returns false if the waiter has already been
+  // (or is about to be) notified.
+  bool CancelWait(const Key& key, Waiter* waiter);
+
+  void Orphan() override;
+
+  // Returns the number of bytes accounted for the cached responses.
+  size_t size() const {
+    MutexLock lock(&mu_);
+    return size_;
+  }
+
+ private:
+  struct Entry {
+    // Set once the entry has been filled.
+    std::shared_ptr<const Response> response;
+    Timestamp expiration;
+    size_t size = 0;
+    // Calls waiting for the fill.
+    std::vector<Waiter*> waiters;
+    // Only filled entries are in the LRU list.
+    std::list<const Key*>::iterator lru_iterator;
+  };
+
+  using Map = std::unordered_map<Key, Entry, absl::Hash<Key>>;
+
+  static size_t EntrySize(const Key& key, const Response& response);
+
+  // Evicts entries until the cache is no larger than bytes.
+  void MaybeShrinkSizeLocked(size_t bytes) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void RemoveLocked(Map::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void MaybePostReclaimerLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const size_t size_limit_;
+  MemoryOwner memory_owner_;
+
+  mutable Mutex mu_;
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  bool reclaimer_posted_ ABSL_GUARDED_BY(mu_) = false;
+  size_t size_ ABSL_GUARDED_BY(mu_) = 0;
+  Map map_ ABSL_GUARDED_BY(mu_);
+  std::list<const Key*> lru_list_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_RESPONSE_CACHE_RESPONSE_CACHE_H
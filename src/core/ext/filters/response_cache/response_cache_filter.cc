@@ -0,0 +1,645 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/response_cache/response_cache_filter.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/grpc_types.h>
+#include <grpc/status.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/response_cache/response_cache_service_config_parser.h"
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/iomgr/call_combiner.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/transport.h"
+
+grpc_core::TraceFlag grpc_response_cache_trace(false, "response_cache");
+
+namespace grpc_core {
+
+namespace {
+
+// Copies the encodable entries of a metadata batch into their wire form.
+class MetadataRecorder {
+ public:
+  explicit MetadataRecorder(ResponseCache::Metadata* out) : out_(out) {}
+
+  void Encode(const Slice& key, const Slice& value) {
+    out_->emplace_back(std::string(key.as_string_view()),
+                       std::string(value.as_string_view()));
+  }
+
+  template <typename Which>
+  void Encode(Which, const typename Which::ValueType& value) {
+    out_->emplace_back(
+        std::string(Which::key()),
+        std::string(Slice(Which::Encode(value)).as_string_view()));
+  }
+
+  void Encode(ContentTypeMetadata,
+              const typename ContentTypeMetadata::ValueType& value) {
+    if (value == ContentTypeMetadata::kInvalid) return;
+    Encode<ContentTypeMetadata>(ContentTypeMetadata(), value);
+  }
+
+ private:
+  ResponseCache::Metadata* out_;
+};
+
+ResponseCache::Metadata RecordMetadata(const grpc_metadata_batch& batch) {
+  ResponseCache::Metadata metadata;
+  MetadataRecorder recorder(&metadata);
+  batch.Encode(&recorder);
+  return metadata;
+}
+
+void ReplayMetadata(const ResponseCache::Metadata& metadata,
+                    grpc_metadata_batch* batch) {
+  for (const auto& p : metadata) {
+    batch->Append(p.first, Slice::FromCopiedString(p.second),
+                  [](absl::string_view, const Slice&) {});
+  }
+}
+
+}  // namespace
+
+//
+// ResponseCacheFilter::CallData
+//
+
+class ResponseCacheFilter::CallData : public ResponseCache::Waiter {
+ public:
+  static grpc_error_handle Init(grpc_call_element* elem,
+                                const grpc_call_element_args* args);
+  static void Destroy(grpc_call_element* elem,
+                      const grpc_call_final_info* /*final_info*/,
+                      grpc_closure* /*then_schedule_closure*/);
+  static void StartTransportStreamOpBatch(
+      grpc_call_element* elem, grpc_transport_stream_op_batch* batch);
+
+ private:
+  enum class State {
+    // The method is not cacheable.  Batches are passed down as-is.
+    kPassThrough,
+    // Holding batches until we have the request message.
+    kBuffering,
+    // Holding batches while another call with the same request fetches
+    // the response.
+    kWaiting,
+    // Passing batches down and recording the response for the cache.
+    kFilling,
+    // Completing batches with the cached response.
+    kServing,
+    // Cancelled before any batches were passed down.
+    kCancelled,
+  };
+
+  CallData(grpc_call_element* elem, const grpc_call_element_args& args);
+  ~CallData() override;
+
+  ResponseCacheFilter* chand() const {
+    return static_cast<ResponseCacheFilter*>(elem_->channel_data);
+  }
+
+  void StartTransportStreamOpBatch(grpc_transport_stream_op_batch* batch);
+
+  // Returns the index into pending_batches_ to be used for batch.
+  static size_t GetBatchIndex(grpc_transport_stream_op_batch* batch);
+  void PendingBatchesAdd(grpc_transport_stream_op_batch* batch);
+  // Fails all pending batches without yielding the call combiner.
+  void PendingBatchesFail(grpc_error_handle error);
+  // Passes all pending batches down.  Yields the call combiner.
+  void PendingBatchesResume();
+  static void ResumePendingBatchInCallCombiner(void* arg,
+                                               grpc_error_handle ignored);
+
+  // Looks up the request in the cache.  Yields the call combiner.
+  void StartLookup(const SliceBuffer& request);
+
+  // Completes all pending batches with response.  Yields the call combiner.
+  void StartServing(std::shared_ptr<const ResponseCache::Response> response);
+  void ServeBatch(grpc_transport_stream_op_batch* batch,
+                  CallCombinerClosureList* closures);
+
+  // ResponseCache::Waiter implementation.
+  void OnFillDone(
+      std::shared_ptr<const ResponseCache::Response> response) override;
+  static void OnFillDoneInCallCombiner(void* arg, grpc_error_handle ignored);
+
+  // Intercepts the recv ops in batch to record the response.
+  void InterceptRecvOps(grpc_transport_stream_op_batch* batch);
+  static void RecvInitialMetadataReady(void* arg, grpc_error_handle error);
+  static void RecvMessageReady(void* arg, grpc_error_handle error);
+  static void RecvTrailingMetadataReady(void* arg, grpc_error_handle error);
+  // Caches the response once both the message and the trailing metadata
+  // have been received.
+  void MaybeFinishFill();
+  void FinishFill(std::shared_ptr<const ResponseCache::Response> response);
+
+  grpc_call_element* elem_;
+  grpc_call_stack* owning_call_;
+  CallCombiner* call_combiner_;
+  const ResponseCacheMethodParsedConfig* method_config_;
+  Slice path_;
+
+  State state_;
+  ResponseCache::Key key_;
+
+  // Batches received from above while buffering or waiting.
+  grpc_transport_stream_op_batch* pending_batches_[6] = {};
+
+  // Set when we get a cancel_stream op while holding batches.
+  grpc_error_handle cancel_error_;
+
+  // For kWaiting.
+  grpc_closure fill_done_closure_;
+  std::shared_ptr<const ResponseCache::Response> fill_done_response_;
+
+  // For kServing.
+  std::shared_ptr<const ResponseCache::Response> response_;
+  bool served_message_ = false;
+
+  // For kFilling.
+  std::shared_ptr<ResponseCache::Response> recorded_response_;
+  bool fill_finished_ = false;
+  size_t num_messages_ = 0;
+  bool recv_message_pending_ = false;
+  bool recv_trailing_metadata_done_ = false;
+  grpc_metadata_batch* recv_initial_metadata_ = nullptr;
+  grpc_closure recv_initial_metadata_ready_;
+  grpc_closure* original_recv_initial_metadata_ready_ = nullptr;
+  absl::optional<SliceBuffer>* recv_message_ = nullptr;
+  uint32_t* recv_message_flags_ = nullptr;
+  grpc_closure recv_message_ready_;
+  grpc_closure* original_recv_message_ready_ = nullptr;
+  grpc_metadata_batch* recv_trailing_metadata_ = nullptr;
+  grpc_error_handle recv_trailing_metadata_error_;
+  grpc_closure recv_trailing_metadata_ready_;
+  grpc_closure* original_recv_trailing_metadata_ready_ = nullptr;
+};
+
+grpc_error_handle ResponseCacheFilter::CallData::Init(
+    grpc_call_element* elem, const grpc_call_element_args* args) {
+  new (elem->call_data) CallData(elem, *args);
+  return absl::OkStatus();
+}
+
+void ResponseCacheFilter::CallData::Destroy(
+    grpc_call_element* elem, const grpc_call_final_info* /*final_info*/,
+    grpc_closure* /*then_schedule_closure*/) {
+  auto* calld = static_cast<CallData*>(elem->call_data);
+  calld->~CallData();
+}
+
+void ResponseCacheFilter::CallData::StartTransportStreamOpBatch(
+    grpc_call_element* elem, grpc_transport_stream_op_batch* batch) {
+  auto* calld = static_cast<CallData*>(elem->call_data);
+  calld->StartTransportStreamOpBatch(batch);
+}
+
+ResponseCacheFilter::CallData::CallData(grpc_call_element* elem,
+                                        const grpc_call_element_args& args)
+    : elem_(elem),
+      owning_call_(args.call_stack),
+      call_combiner_(args.call_combiner),
+      method_config_(ResponseCacheMethodParsedConfig::GetFromCallContext(
+          args.context, chand()->service_config_parser_index_)),
+      path_(CSliceRef(args.path)),
+      state_(method_config_ == nullptr ? State::kPassThrough
+                                       : State::kBuffering) {}
+
+ResponseCacheFilter::CallData::~CallData() {
+  // If the call ended without a response, let the waiters send their own
+  // requests.
+  if (state_ == State::kFilling && !fill_finished_) FinishFill(nullptr);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(pending_batches_); ++i) {
+    GPR_ASSERT(pending_batches_[i] == nullptr);
+  }
+}
+
+void ResponseCacheFilter::CallData::StartTransportStreamOpBatch(
+    grpc_transport_stream_op_batch* batch) {
+  switch (state_) {
+    case State::kPassThrough:
+      grpc_call_next_op(elem_, batch);
+      return;
+    case State::kFilling:
+      InterceptRecvOps(batch);
+      grpc_call_next_op(elem_, batch);
+      return;
+    case State::kServing: {
+      CallCombinerClosureList closures;
+      ServeBatch(batch, &closures);
+      // Note: This will release the call combiner.
+      closures.RunClosures(call_combiner_);
+      return;
+    }
+    case State::kCancelled:
+      // Note: This will release the call combiner.
+      grpc_transport_stream_op_batch_finish_with_failure(batch, cancel_error_,
+                                                         call_combiner_);
+      return;
+    case State::kBuffering:
+    case State::kWaiting:
+      break;
+  }
+  // We are holding batches, so nothing has been sent down yet.
+  if (GPR_UNLIKELY(batch->cancel_stream)) {
+    cancel_error_ = batch->payload->cancel_stream.cancel_error;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_response_cache_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: cancelled while %s: %s", chand(),
+              this, state_ == State::kWaiting ? "waiting" : "buffering",
+              StatusToString(cancel_error_).c_str());
+    }
+    // If the fill is already done, OnFillDoneInCallCombiner() will release
+    // the call stack ref.
+    if (state_ == State::kWaiting && chand()->cache_->CancelWait(key_, this)) {
+      GRPC_CALL_STACK_UNREF(owning_call_, "ResponseCacheWait");
+    }
+    state_ = State::kCancelled;
+    PendingBatchesFail(cancel_error_);
+    // Note: This will release the call combiner.
+    grpc_transport_stream_op_batch_finish_with_failure(batch, cancel_error_,
+                                                       call_combiner_);
+    return;
+  }
+  PendingBatchesAdd(batch);
+  if (state_ == State::kBuffering && batch->send_message) {
+    StartLookup(*batch->payload->send_message.send_message);
+    return;
+  }
+  GRPC_CALL_COMBINER_STOP(call_combiner_, "holding batch in response cache");
+}
+
+size_t ResponseCacheFilter::CallData::GetBatchIndex(
+    grpc_transport_stream_op_batch* batch) {
+  if (batch->send_initial_metadata) return 0;
+  if (batch->send_message) return 1;
+  if (batch->send_trailing_metadata) return 2;
+  if (batch->recv_initial_metadata) return 3;
+  if (batch->recv_message) return 4;
+  if (batch->recv_trailing_metadata) return 5;
+  GPR_UNREACHABLE_CODE(return (size_t)-1);
+}
+
+void ResponseCacheFilter::CallData::PendingBatchesAdd(
+    grpc_transport_stream_op_batch* batch) {
+  grpc_transport_stream_op_batch*& pending =
+      pending_batches_[GetBatchIndex(batch)];
+  GPR_ASSERT(pending == nullptr);
+  pending = batch;
+}
+
+void ResponseCacheFilter::CallData::PendingBatchesFail(
+    grpc_error_handle error) {
+  CallCombinerClosureList closures;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(pending_batches_); ++i) {
+    grpc_transport_stream_op_batch*& batch = pending_batches_[i];
+    if (batch != nullptr) {
+      grpc_transport_stream_op_batch_queue_finish_with_failure(batch, error,
+                                                               &closures);
+      batch = nullptr;
+    }
+  }
+  closures.RunClosuresWithoutYielding(call_combiner_);
+}
+
+void ResponseCacheFilter::CallData::ResumePendingBatchInCallCombiner(
+    void* arg, grpc_error_handle /*ignored*/) {
+  grpc_transport_stream_op_batch* batch =
+      static_cast<grpc_transport_stream_op_batch*>(arg);
+  auto* elem =
+      static_cast<grpc_call_element*>(batch->handler_private.extra_arg);
+  // Note: This will release the call combiner.
+  grpc_call_next_op(elem, batch);
+}
+
+void ResponseCacheFilter::CallData::PendingBatchesResume() {
+  CallCombinerClosureList closures;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(pending_batches_); ++i) {
+    grpc_transport_stream_op_batch*& batch = pending_batches_[i];
+    if (batch != nullptr) {
+      if (state_ == State::kFilling) InterceptRecvOps(batch);
+      batch->handler_private.extra_arg = elem_;
+      GRPC_CLOSURE_INIT(&batch->handler_private.closure,
+                        ResumePendingBatchInCallCombiner, batch, nullptr);
+      closures.Add(&batch->handler_private.closure, absl::OkStatus(),
+                   "resuming pending batch from response cache");
+      batch = nullptr;
+    }
+  }
+  // Note: This will release the call combiner.
+  closures.RunClosures(call_combiner_);
+}
+
+void ResponseCacheFilter::CallData::StartLookup(const SliceBuffer& request) {
+  key_.method = std::string(path_.as_string_view());
+  key_.request = request.JoinIntoString();
+  std::shared_ptr<const ResponseCache::Response> response;
+  switch (chand()->cache_->Lookup(key_, this, &response)) {
+    case ResponseCache::LookupResult::kHit:
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_response_cache_trace)) {
+        gpr_log(GPR_INFO, "chand=%p calld=%p: cache hit for %s", chand(),
+                this, key_.method.c_str());
+      }
+      StartServing(std::move(response));
+      break;
+    case ResponseCache::LookupResult::kFill:
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_response_cache_trace)) {
+        gpr_log(GPR_INFO, "chand=%p calld=%p: cache miss for %s", chand(),
+                this, key_.method.c_str());
+      }
+      state_ = State::kFilling;
+      recorded_response_ = std::make_shared<ResponseCache::Response>();
+      PendingBatchesResume();
+      break;
+    case ResponseCache::LookupResult::kWait:
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_response_cache_trace)) {
+        gpr_log(GPR_INFO,
+                "chand=%p calld=%p: waiting for in-flight call for %s",
+                chand(), this, key_.method.c_str());
+      }
+      // OnFillDoneInCallCombiner() cannot run until we yield the call
+      // combiner, so it is safe to take the ref here.
+      state_ = State::kWaiting;
+      GRPC_CALL_STACK_REF(owning_call_, "ResponseCacheWait");
+      GRPC_CALL_COMBINER_STOP(call_combiner_,
+                              "waiting for response cache fill");
+      break;
+  }
+}
+
+void ResponseCacheFilter::CallData::StartServing(
+    std::shared_ptr<const ResponseCache::Response> response) {
+  state_ = State::kServing;
+  response_ = std::move(response);
+  CallCombinerClosureList closures;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(pending_batches_); ++i) {
+    grpc_transport_stream_op_batch*& batch = pending_batches_[i];
+    if (batch != nullptr) {
+      ServeBatch(batch, &closures);
+      batch = nullptr;
+    }
+  }
+  // Note: This will release the call combiner.
+  closures.RunClosures(call_combiner_);
+}
+
+void ResponseCacheFilter::CallData::ServeBatch(
+    grpc_transport_stream_op_batch* batch, CallCombinerClosureList* closures) {
+  grpc_transport_stream_op_batch_payload* payload = batch->payload;
+  if (batch->send_trailing_metadata &&
+      payload->send_trailing_metadata.sent != nullptr) {
+    *payload->send_trailing_metadata.sent = true;
+  }
+  if (batch->recv_initial_metadata) {
+    ReplayMetadata(response_->initial_metadata,
+                   payload->recv_initial_metadata.recv_initial_metadata);
+    if (payload->recv_initial_metadata.trailing_metadata_available !=
+        nullptr) {
+      *payload->recv_initial_metadata.trailing_metadata_available = false;
+    }
+    closures->Add(payload->recv_initial_metadata.recv_initial_metadata_ready,
+                  absl::OkStatus(), "recv_initial_metadata_ready from cache");
+  }
+  if (batch->recv_message) {
+    // The cached response has exactly one message.
+    if (!served_message_) {
+      served_message_ = true;
+      payload->recv_message.recv_message->emplace();
+      (*payload->recv_message.recv_message)->Append(response_->message.Ref());
+      if (payload->recv_message.flags != nullptr) {
+        *payload->recv_message.flags = response_->message_flags;
+      }
+    } else {
+      payload->recv_message.recv_message->reset();
+    }
+    closures->Add(payload->recv_message.recv_message_ready, absl::OkStatus(),
+                  "recv_message_ready from cache");
+  }
+  if (batch->recv_trailing_metadata) {
+    grpc_metadata_batch* md =
+        payload->recv_trailing_metadata.recv_trailing_metadata;
+    ReplayMetadata(response_->trailing_metadata, md);
+    md->Set(GrpcStatusFromWire(), true);
+    closures->Add(
+        payload->recv_trailing_metadata.recv_trailing_metadata_ready,
+        absl::OkStatus(), "recv_trailing_metadata_ready from cache");
+  }
+  if (batch->on_complete != nullptr) {
+    closures->Add(batch->on_complete, absl::OkStatus(),
+                  "on_complete from cache");
+  }
+}
+
+void ResponseCacheFilter::CallData::OnFillDone(
+    std::shared_ptr<const ResponseCache::Response> response) {
+  // Called from the filling call, so hop into our own call combiner.
+  fill_done_response_ = std::move(response);
+  GRPC_CLOSURE_INIT(&fill_done_closure_, OnFillDoneInCallCombiner, this,
+                    nullptr);
+  GRPC_CALL_COMBINER_START(call_combiner_, &fill_done_closure_,
+                           absl::OkStatus(), "response cache fill done");
+}
+
+void ResponseCacheFilter::CallData::OnFillDoneInCallCombiner(
+    void* arg, grpc_error_handle /*ignored*/) {
+  auto* calld = static_cast<CallData*>(arg);
+  grpc_call_stack* owning_call = calld->owning_call_;
+  if (calld->state_ == State::kCancelled) {
+    GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
+                            "cancelled while waiting for response cache");
+  } else if (calld->fill_done_response_ != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_response_cache_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: got response from in-flight call",
+              calld->chand(), calld);
+    }
+    calld->StartServing(std::move(calld->fill_done_response_));
+  } else {
+    // The other call did not get a cacheable response, so send our own
+    // request without caching the result.
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_response_cache_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p: in-flight call failed, sending request",
+              calld->chand(), calld);
+    }
+    calld->state_ = State::kPassThrough;
+    calld->PendingBatchesResume();
+  }
+  GRPC_CALL_STACK_UNREF(owning_call, "ResponseCacheWait");
+}
+
+void ResponseCacheFilter::CallData::InterceptRecvOps(
+    grpc_transport_stream_op_batch* batch) {
+  grpc_transport_stream_op_batch_payload* payload = batch->payload;
+  if (batch->recv_initial_metadata) {
+    recv_initial_metadata_ =
+        payload->recv_initial_metadata.recv_initial_metadata;
+    original_recv_initial_metadata_ready_ =
+        payload->recv_initial_metadata.recv_initial_metadata_ready;
+    GRPC_CLOSURE_INIT(&recv_initial_metadata_ready_, RecvInitialMetadataReady,
+                      this, nullptr);
+    payload->recv_initial_metadata.recv_initial_metadata_ready =
+        &recv_initial_metadata_ready_;
+  }
+  if (batch->recv_message) {
+    recv_message_pending_ = true;
+    recv_message_ = payload->recv_message.recv_message;
+    recv_message_flags_ = payload->recv_message.flags;
+    original_recv_message_ready_ = payload->recv_message.recv_message_ready;
+    GRPC_CLOSURE_INIT(&recv_message_ready_, RecvMessageReady, this, nullptr);
+    payload->recv_message.recv_message_ready = &recv_message_ready_;
+  }
+  if (batch->recv_trailing_metadata) {
+    recv_trailing_metadata_ =
+        payload->recv_trailing_metadata.recv_trailing_metadata;
+    original_recv_trailing_metadata_ready_ =
+        payload->recv_trailing_metadata.recv_trailing_metadata_ready;
+    GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready_,
+                      RecvTrailingMetadataReady, this, nullptr);
+    payload->recv_trailing_metadata.recv_trailing_metadata_ready =
+        &recv_trailing_metadata_ready_;
+  }
+}
+
+void ResponseCacheFilter::CallData::RecvInitialMetadataReady(
+    void* arg, grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  if (error.ok() && calld->recorded_response_ != nullptr) {
+    calld->recorded_response_->initial_metadata =
+        RecordMetadata(*calld->recv_initial_metadata_);
+  }
+  Closure::Run(DEBUG_LOCATION, calld->original_recv_initial_metadata_ready_,
+               error);
+}
+
+void ResponseCacheFilter::CallData::RecvMessageReady(void* arg,
+                                                     grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  calld->recv_message_pending_ = false;
+  if (error.ok() && calld->recv_message_->has_value() &&
+      ++calld->num_messages_ == 1 && calld->recorded_response_ != nullptr) {
+    calld->recorded_response_->message =
+        Slice::FromCopiedString((*calld->recv_message_)->JoinIntoString());
+    if (calld->recv_message_flags_ != nullptr) {
+      calld->recorded_response_->message_flags = *calld->recv_message_flags_;
+    }
+  }
+  calld->MaybeFinishFill();
+  Closure::Run(DEBUG_LOCATION, calld->original_recv_message_ready_, error);
+}
+
+void ResponseCacheFilter::CallData::RecvTrailingMetadataReady(
+    void* arg, grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  calld->recv_trailing_metadata_done_ = true;
+  calld->recv_trailing_metadata_error_ = error;
+  calld->MaybeFinishFill();
+  Closure::Run(DEBUG_LOCATION, calld->original_recv_trailing_metadata_ready_,
+               error);
+}
+
+void ResponseCacheFilter::CallData::MaybeFinishFill() {
+  if (fill_finished_ || !recv_trailing_metadata_done_ ||
+      recv_message_pending_) {
+    return;
+  }
+  // Only successful calls with exactly one response message are cached.
+  std::shared_ptr<const ResponseCache::Response> response;
+  if (recv_trailing_metadata_error_.ok() && num_messages_ == 1 &&
+      recv_trailing_metadata_->get(GrpcStatusMetadata())
+              .value_or(GRPC_STATUS_UNKNOWN) == GRPC_STATUS_OK) {
+    recorded_response_->trailing_metadata =
+        RecordMetadata(*recv_trailing_metadata_);
+    response = std::move(recorded_response_);
+  }
+  FinishFill(std::move(response));
+}
+
+void ResponseCacheFilter::CallData::FinishFill(
+    std::shared_ptr<const ResponseCache::Response> response) {
+  fill_finished_ = true;
+  recorded_response_.reset();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_response_cache_trace)) {
+    gpr_log(GPR_INFO, "chand=%p calld=%p: %s response for %s", chand(), this,
+            response != nullptr ? "caching" : "not caching",
+            key_.method.c_str());
+  }
+  chand()->cache_->FinishFill(key_, method_config_->ttl(),
+                              std::move(response));
+}
+
+//
+// ResponseCacheFilter
+//
+
+RefCountedPtr<ResponseCache> ResponseCacheFilter::CreateCache(
+    const ChannelArgs& args) {
+  const int max_bytes =
+      std::max(0, args.GetInt(GRPC_ARG_RESPONSE_CACHE_MAX_BYTES).value_or(0));
+  if (max_bytes == 0) return nullptr;
+  ResourceQuotaRefPtr resource_quota = args.GetObjectRef<ResourceQuota>();
+  if (resource_quota == nullptr) resource_quota = ResourceQuota::Default();
+  return MakeRefCounted<ResponseCache>(
+      max_bytes,
+      resource_quota->memory_quota()->CreateMemoryOwner("response_cache"));
+}
+
+ResponseCacheFilter::ResponseCacheFilter(const ChannelArgs& args)
+    : cache_(args.GetObjectRef<ResponseCache>()),
+      service_config_parser_index_(
+          ResponseCacheServiceConfigParser::ParserIndex()) {
+  GPR_ASSERT(cache_ != nullptr);
+}
+
+const grpc_channel_filter ResponseCacheFilter::kVtable = {
+    ResponseCacheFilter::CallData::StartTransportStreamOpBatch,
+    nullptr,
+    grpc_channel_next_op,
+    sizeof(ResponseCacheFilter::CallData),
+    ResponseCacheFilter::CallData::Init,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    ResponseCacheFilter::CallData::Destroy,
+    sizeof(ResponseCacheFilter),
+    ResponseCacheFilter::Init,
+    grpc_channel_stack_no_post_init,
+    ResponseCacheFilter::Destroy,
+    grpc_channel_next_get_info,
+    "response_cache",
+};
+
+}  // namespace grpc_core
@@ -0,0 +1,77 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_RESPONSE_CACHE_RESPONSE_CACHE_FILTER_H
+#define GRPC_SRC_CORE_EXT_FILTERS_RESPONSE_CACHE_RESPONSE_CACHE_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <new>
+
+#include "src/core/ext/filters/response_cache/response_cache.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_fwd.h"
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/error.h"
+
+extern grpc_core::TraceFlag grpc_response_cache_trace;
+
+namespace grpc_core {
+
+// Serves responses to cacheable unary calls from a ResponseCache.
+//
+// This filter is intended to be used as the first filter in the
+// DynamicFilter stack in the client channel, which is where the method
+// config for the call is known.  When a response is served from the
+// cache, the call never reaches the retry filter, the LB policy or the
+// transport.
+class ResponseCacheFilter {
+ public:
+  static const grpc_channel_filter kVtable;
+
+  // Returns the cache for a channel with the given args, or null if
+  // response caching is disabled.  The cache must be passed to the filter
+  // via the ResponseCache channel arg.
+  static RefCountedPtr<ResponseCache> CreateCache(const ChannelArgs& args);
+
+ private:
+  class CallData;
+
+  explicit ResponseCacheFilter(const ChannelArgs& args);
+
+  static grpc_error_handle Init(grpc_channel_element* elem,
+                                grpc_channel_element_args* args) {
+    GPR_ASSERT(elem->filter == &kVtable);
+    new (elem->channel_data) ResponseCacheFilter(args->channel_args);
+    return absl::OkStatus();
+  }
+
+  static void Destroy(grpc_channel_element* elem) {
+    auto* chand = static_cast<ResponseCacheFilter*>(elem->channel_data);
+    chand->~ResponseCacheFilter();
+  }
+
+  RefCountedPtr<ResponseCache> cache_;
+  const size_t service_config_parser_index_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_RESPONSE_CACHE_RESPONSE_CACHE_FILTER_H
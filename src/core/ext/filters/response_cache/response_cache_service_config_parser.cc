@@ -0,0 +1,86 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/response_cache/response_cache_service_config_parser.h"
+
+
+#include "src/core/lib/service_config/service_config_call_data.h"
+
+namespace grpc_core {
+
+const JsonLoaderInterface*
+ResponseCacheMethodParsedConfig::ResponseCachePolicy::JsonLoader(
+    const JsonArgs&) {
+  static const auto* loader = JsonObjectLoader<ResponseCachePolicy>()
+                                  .Field("ttl", &ResponseCachePolicy::ttl)
+                                  .Finish();
+  return loader;
+}
+
+void ResponseCacheMethodParsedConfig::ResponseCachePolicy::JsonPostLoad(
+    const Json&, const JsonArgs&, ValidationErrors* errors) {
+  if (ttl <= Duration::Zero()) {
+    ValidationErrors::ScopedField field(errors, ".ttl");
+    errors->AddError("must be greater than 0");
+  }
+}
+
+const JsonLoaderInterface* ResponseCacheMethodParsedConfig::JsonLoader(
+    const JsonArgs&) {
+  static const auto* loader =
+      JsonObjectLoader<ResponseCacheMethodParsedConfig>()
+          .OptionalField("responseCachePolicy",
+                         &ResponseCacheMethodParsedConfig::policy_)
+          .Finish();
+  return loader;
+}
+
+const ResponseCacheMethodParsedConfig*
+ResponseCacheMethodParsedConfig::GetFromCallContext(
+    const grpc_call_context_element* context,
+    size_t service_config_parser_index) {
+  if (context == nullptr) return nullptr;
+  auto* svc_cfg_call_data = static_cast<ServiceConfigCallData*>(
+      context[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA].value);
+  if (svc_cfg_call_data == nullptr) return nullptr;
+  return static_cast<const ResponseCacheMethodParsedConfig*>(
+      svc_cfg_call_data->GetMethodParsedConfig(service_config_parser_index));
+}
+
+std::unique_ptr<ServiceConfigParser::ParsedConfig>
+ResponseCacheServiceConfigParser::ParsePerMethodParams(
+    const ChannelArgs& /*args*/, const Json& json, ValidationErrors* errors) {
+  auto config =
+      LoadFromJson<std::unique_ptr<ResponseCacheMethodParsedConfig>>(
+          json, JsonArgs(), errors);
+  if (config == nullptr || !config->policy_.has_value()) return nullptr;
+  return config;
+}
+
+void ResponseCacheServiceConfigParser::Register(
+    CoreConfiguration::Builder* builder) {
+  builder->service_config_parser()->RegisterParser(
+      std::make_unique<ResponseCacheServiceConfigParser>());
+}
+
+size_t ResponseCacheServiceConfigParser::ParserIndex() {
+  return CoreConfiguration::Get().service_config_parser().GetParserIndex(
+      parser_name());
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,87 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_RESPONSE_CACHE_RESPONSE_CACHE_SERVICE_CONFIG_PARSER_H
+#define GRPC_SRC_CORE_EXT_FILTERS_RESPONSE_CACHE_RESPONSE_CACHE_SERVICE_CONFIG_PARSER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/gprpp/validation_errors.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_args.h"
+#include "src/core/lib/json/json_object_loader.h"
+#include "src/core/lib/service_config/service_config_parser.h"
+
+namespace grpc_core {
+
+class ResponseCacheMethodParsedConfig
+    : public ServiceConfigParser::ParsedConfig {
+ public:
+  // How long responses to the method may be served from the cache.
+  Duration ttl() const { return policy_->ttl; }
+
+  static const ResponseCacheMethodParsedConfig* GetFromCallContext(
+      const grpc_call_context_element* context,
+      size_t service_config_parser_index);
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&);
+
+ private:
+  friend class ResponseCacheServiceConfigParser;
+
+  struct ResponseCachePolicy {
+    Duration ttl;
+
+    static const JsonLoaderInterface* JsonLoader(const JsonArgs&);
+    void JsonPostLoad(const Json& json, const JsonArgs&,
+                      ValidationErrors* errors);
+  };
+
+  absl::optional<ResponseCachePolicy> policy_;
+};
+
+class ResponseCacheServiceConfigParser final
+    : public ServiceConfigParser::Parser {
+ public:
+  absl::string_view name() const override { return parser_name(); }
+  // Parses the responseCachePolicy field of a method config.  Returns null
+  // for methods without one, which are never cached.
+  std::unique_ptr<ServiceConfigParser::ParsedConfig> ParsePerMethodParams(
+      const ChannelArgs& args, const Json& json,
+      ValidationErrors* errors) override;
+  // Returns the parser index for ResponseCacheServiceConfigParser.
+  static size_t ParserIndex();
+  // Registers ResponseCacheServiceConfigParser to ServiceConfigParser.
+  static void Register(CoreConfiguration::Builder* builder);
+
+ private:
+  static absl::string_view parser_name() { return "response_cache"; }
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_RESPONSE_CACHE_RESPONSE_CACHE_SERVICE_CONFIG_PARSER_H
@@ -269,6 +269,73 @@ void ForEachContextListEntryExecute(void* arg, Timestamps* ts,
   delete context_list;
 }
 
+double Http2TransportTelemetry::WriteCoalescingRatio() const {
+  if (writes == 0) return 0;
+  return static_cast<double>(messages_written) / writes;
+}
+
+double Http2TransportTelemetry::BytesPerWrite() const {
+  if (writes == 0) return 0;
+  return static_cast<double>(bytes_written) / writes;
+}
+
+void Chttp2Telemetry::RecordPingRtt(gpr_timespec rtt) {
+  const int64_t sample =
+      std::max<int64_t>(static_cast<int64_t>(gpr_timespec_to_micros(rtt)), 1);
+  const int64_t smoothed = smoothed_rtt_us_.load(std::memory_order_relaxed);
+  Set(smoothed_rtt_us_,
+      smoothed == 0 ? sample : smoothed + (sample - smoothed) / 8);
+}
+
+Http2TransportTelemetry Chttp2Telemetry::Snapshot() const {
+  Http2TransportTelemetry telemetry;
+  telemetry.smoothed_rtt_us = smoothed_rtt_us_.load(std::memory_order_relaxed);
+  telemetry.bdp_estimate = bdp_estimate_.load(std::memory_order_relaxed);
+  telemetry.bandwidth_estimate =
+      bandwidth_estimate_.load(std::memory_order_relaxed);
+  telemetry.local_window = local_window_.load(std::memory_order_relaxed);
+  telemetry.remote_window = remote_window_.load(std::memory_order_relaxed);
+  telemetry.transport_stalled_time = Duration::Milliseconds(
+      transport_stalled_ms_.load(std::memory_order_relaxed));
+  telemetry.stream_stalled_time = Duration::Milliseconds(
+      stream_stalled_ms_.load(std::memory_order_relaxed));
+  telemetry.writes = writes_.load(std::memory_order_relaxed);
+  telemetry.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+  telemetry.messages_written =
+      messages_written_.load(std::memory_order_relaxed);
+  return telemetry;
+}
+
+void Chttp2Telemetry::PopulateSocketData(Json::Object* data) {
+  const Http2TransportTelemetry telemetry = Snapshot();
+  (*data)["localFlowControlWindow"] =
+      Json::FromString(absl::StrCat(telemetry.local_window));
+  (*data)["remoteFlowControlWindow"] =
+      Json::FromString(absl::StrCat(telemetry.remote_window));
+  Json::Array options;
+  auto add_option = [&options](const char* name, std::string value) {
+    options.push_back(Json::FromObject({
+        {"name", Json::FromString(name)},
+        {"value", Json::FromString(std::move(value))},
+    }));
+  };
+  add_option("grpc.http2.smoothed_rtt_us",
+             absl::StrCat(telemetry.smoothed_rtt_us));
+  add_option("grpc.http2.bdp_estimate", absl::StrCat(telemetry.bdp_estimate));
+  add_option("grpc.http2.bandwidth_estimate",
+             absl::StrFormat("%.0f", telemetry.bandwidth_estimate));
+  add_option("grpc.http2.transport_stalled_ms",
+             absl::StrCat(telemetry.transport_stalled_time.millis()));
+  add_option("grpc.http2.stream_stalled_ms",
+             absl::StrCat(telemetry.stream_stalled_time.millis()));
+  add_option("grpc.http2.writes", absl::StrCat(telemetry.writes));
+  add_option("grpc.http2.write_coalescing_ratio",
+             absl::StrFormat("%.2f", telemetry.WriteCoalescingRatio()));
+  add_option("grpc.http2.bytes_per_write",
+             absl::StrFormat("%.1f", telemetry.BytesPerWrite()));
+  (*data)["option"] = Json::FromArray(std::move(options));
+}
+
 }  // namespace grpc_core
 
 //
@@ -400,7 +467,8 @@ static void read_channel_args(grpc_chttp2_transport* t,
             absl::StrCat(get_vtable()->name, " ",
                          t->peer_string.as_string_view()),
             channel_args
-                .GetObjectRef<grpc_core::channelz::SocketNode::Security>());
+                .GetObjectRef<grpc_core::channelz::SocketNode::Security>(),
+            t->telemetry);
   }
 
   t->ack_pings = channel_args.GetBool("grpc.http2.ack_pings").value_or(true);
@@ -999,6 +1067,7 @@ static void write_action(void* gt, grpc_error_handle /*error*/) {
   if (max_frame_size == 0) {
     max_frame_size = INT_MAX;
   }
+  t->telemetry->RecordWrite(t->outbuf.length);
   grpc_endpoint_write(
       t->ep, &t->outbuf,
       GRPC_CLOSURE_INIT(&t->write_action_end_locked, write_action_end, t,
@@ -1360,6 +1429,7 @@ static void perform_stream_op_locked(void* stream_op,
   }
 
   if (op->send_initial_metadata) {
+    grpc_chttp2_record_call_phase(s, grpc_core::CallPhase::kTransportOp);
     if (t->is_client && t->channelz_socket != nullptr) {
       t->channelz_socket->RecordStreamStartedFromLocal();
     }
@@ -1686,6 +1756,11 @@ void grpc_chttp2_ack_ping(grpc_chttp2_transport* t, uint64_t id) {
             std::string(t->peer_string.as_string_view()).c_str(), id);
     return;
   }
+  if (pq->inflight_sent_at != 0) {
+    t->telemetry->RecordPingRtt(
+        gpr_cycle_counter_sub(gpr_get_cycle_counter(), pq->inflight_sent_at));
+    pq->inflight_sent_at = 0;
+  }
   grpc_core::ExecCtx::RunList(DEBUG_LOCATION,
                               &pq->lists[GRPC_CHTTP2_PCL_INFLIGHT]);
   if (!grpc_closure_list_empty(pq->lists[GRPC_CHTTP2_PCL_NEXT])) {
@@ -1989,6 +2064,7 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
               if (t->channelz_socket != nullptr) {
                 t->channelz_socket->RecordMessageReceived();
               }
+              grpc_chttp2_record_call_phase(s, grpc_core::CallPhase::kDecode);
               break;
             }
           }
@@ -2544,6 +2620,8 @@ static void read_action_locked(void* tp, grpc_error_handle error) {
       }
       t->initial_window_update = 0;
     }
+    t->telemetry->RecordWindows(t->flow_control.announced_window(),
+                                t->flow_control.remote_window());
   }
 
   bool keep_reading = false;
@@ -2660,6 +2738,8 @@ static void finish_bdp_ping_locked(void* tp, grpc_error_handle error) {
   t->bdp_ping_started = false;
   grpc_core::Timestamp next_ping =
       t->flow_control.bdp_estimator()->CompletePing();
+  t->telemetry->RecordBdp(t->flow_control.bdp_estimator()->EstimateBdp(),
+                          t->flow_control.bdp_estimator()->EstimateBandwidth());
   grpc_chttp2_act_on_flowctl_action(t->flow_control.PeriodicUpdate(), t,
                                     nullptr);
   GPR_ASSERT(!t->next_bdp_ping_timer_handle.has_value());
@@ -3126,6 +3206,13 @@ grpc_chttp2_transport_get_socket_node(grpc_transport* transport) {
   return t->channelz_socket;
 }
 
+grpc_core::Http2TransportTelemetry grpc_chttp2_transport_get_telemetry(
+    grpc_transport* transport) {
+  grpc_chttp2_transport* t =
+      reinterpret_cast<grpc_chttp2_transport*>(transport);
+  return t->telemetry->Snapshot();
+}
+
 grpc_transport* grpc_create_chttp2_transport(
     const grpc_core::ChannelArgs& channel_args, grpc_endpoint* ep,
     bool is_client) {
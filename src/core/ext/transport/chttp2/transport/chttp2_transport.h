@@ -21,12 +21,15 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <grpc/slice.h>
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/endpoint.h"
@@ -48,6 +51,45 @@ grpc_transport* grpc_create_chttp2_transport(
 grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode>
 grpc_chttp2_transport_get_socket_node(grpc_transport* transport);
 
+namespace grpc_core {
+
+// A snapshot of the telemetry kept for each chttp2 connection.  The same
+// values are rendered as options of the connection's channelz socket.
+struct Http2TransportTelemetry {
+  // Round trip time of the PINGs sent on the connection, in microseconds,
+  // smoothed as TCP smooths its RTT (gain 1/8), or zero before the first PING
+  // ack.
+  int64_t smoothed_rtt_us = 0;
+  // The BDP estimator's latest estimate, in bytes, and the bandwidth it
+  // implies, in bytes per second.
+  int64_t bdp_estimate = 0;
+  double bandwidth_estimate = 0;
+  // Flow control windows as of the last read or write: how much the peer may
+  // send us, and how much we may send the peer.
+  int64_t local_window = 0;
+  int64_t remote_window = 0;
+  // Time during which some stream had data to send but was blocked by the
+  // connection's flow control window, or by its own.  A stall is counted
+  // when it ends.
+  Duration transport_stalled_time;
+  Duration stream_stalled_time;
+  // Writes handed to the endpoint, and the bytes and messages they carried.
+  int64_t writes = 0;
+  int64_t bytes_written = 0;
+  int64_t messages_written = 0;
+
+  // Messages sent per write.
+  double WriteCoalescingRatio() const;
+  // Bytes sent per write.  A write is a single sendmsg() unless the socket
+  // buffer fills up.
+  double BytesPerWrite() const;
+};
+
+}  // namespace grpc_core
+
+grpc_core::Http2TransportTelemetry grpc_chttp2_transport_get_telemetry(
+    grpc_transport* transport);
+
 /// Takes ownership of \a read_buffer, which (if non-NULL) contains
 /// leftover bytes previously read from the endpoint (e.g., by handshakers).
 /// If non-null, \a notify_on_receive_settings will be scheduled when
@@ -24,6 +24,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 
 #include "absl/container/flat_hash_map.h"
@@ -37,6 +38,7 @@
 #include <grpc/slice.h>
 #include <grpc/support/time.h>
 
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/ext/transport/chttp2/transport/context_list_entry.h"
 #include "src/core/ext/transport/chttp2/transport/flow_control.h"
 #include "src/core/ext/transport/chttp2/transport/frame.h"
@@ -50,7 +52,9 @@
 #include "src/core/ext/transport/chttp2/transport/http2_settings.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/debug/call_timeline.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/bitset.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -60,6 +64,7 @@
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/json/json.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/slice/slice.h"
@@ -145,6 +150,7 @@ const char* grpc_chttp2_initiate_write_reason_string(
 struct grpc_chttp2_ping_queue {
   grpc_closure_list lists[GRPC_CHTTP2_PCL_COUNT] = {};
   uint64_t inflight_id = 0;
+  gpr_cycle_counter inflight_sent_at = 0;
 };
 struct grpc_chttp2_repeated_ping_policy {
   int max_pings_without_data;
@@ -245,6 +251,70 @@ typedef enum {
   GRPC_CHTTP2_KEEPALIVE_STATE_DISABLED,
 } grpc_chttp2_keepalive_state;
 
+namespace grpc_core {
+
+// Per-connection telemetry (see Http2TransportTelemetry).  It is only updated
+// under the transport's combiner, so updates are relaxed loads and stores
+// rather than read-modify-writes; it may be read from any thread, including
+// by channelz after the transport is gone.
+class Chttp2Telemetry final : public channelz::SocketNode::TransportData {
+ public:
+  void RecordPingRtt(gpr_timespec rtt);
+  void RecordBdp(int64_t bdp_estimate, double bandwidth_estimate) {
+    Set(bdp_estimate_, bdp_estimate);
+    bandwidth_estimate_.store(bandwidth_estimate, std::memory_order_relaxed);
+  }
+  void RecordWindows(int64_t local_window, int64_t remote_window) {
+    Set(local_window_, local_window);
+    Set(remote_window_, remote_window);
+  }
+  void RecordWrite(size_t bytes) {
+    Add(writes_, 1);
+    Add(bytes_written_, bytes);
+  }
+  void RecordMessagesWritten(uint32_t messages) {
+    Add(messages_written_, messages);
+  }
+  // Called when the first stream is added to, and the last one is removed
+  // from, the stalled_by_transport or stalled_by_stream list.
+  void TransportStallStarted() { transport_stall_start_ = Timestamp::Now(); }
+  void TransportStallEnded() {
+    Add(transport_stalled_ms_,
+        (Timestamp::Now() - transport_stall_start_).millis());
+  }
+  void StreamStallStarted() { stream_stall_start_ = Timestamp::Now(); }
+  void StreamStallEnded() {
+    Add(stream_stalled_ms_, (Timestamp::Now() - stream_stall_start_).millis());
+  }
+
+  Http2TransportTelemetry Snapshot() const;
+
+  void PopulateSocketData(Json::Object* data) override;
+
+ private:
+  static void Set(std::atomic<int64_t>& value, int64_t new_value) {
+    value.store(new_value, std::memory_order_relaxed);
+  }
+  static void Add(std::atomic<int64_t>& value, int64_t delta) {
+    Set(value, value.load(std::memory_order_relaxed) + delta);
+  }
+
+  std::atomic<int64_t> smoothed_rtt_us_{0};
+  std::atomic<int64_t> bdp_estimate_{0};
+  std::atomic<double> bandwidth_estimate_{0};
+  std::atomic<int64_t> local_window_{0};
+  std::atomic<int64_t> remote_window_{0};
+  std::atomic<int64_t> transport_stalled_ms_{0};
+  std::atomic<int64_t> stream_stalled_ms_{0};
+  std::atomic<int64_t> writes_{0};
+  std::atomic<int64_t> bytes_written_{0};
+  std::atomic<int64_t> messages_written_{0};
+  Timestamp transport_stall_start_;
+  Timestamp stream_stall_start_;
+};
+
+}  // namespace grpc_core
+
 struct grpc_chttp2_transport : public grpc_core::KeepsGrpcInitialized {
   grpc_chttp2_transport(const grpc_core::ChannelArgs& channel_args,
                         grpc_endpoint* ep, bool is_client);
@@ -455,6 +525,8 @@ struct grpc_chttp2_transport : public grpc_core::KeepsGrpcInitialized {
   uint32_t max_header_list_size_soft_limit = 0;
   grpc_core::ContextList* cl = nullptr;
   grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode> channelz_socket;
+  const grpc_core::RefCountedPtr<grpc_core::Chttp2Telemetry> telemetry =
+      grpc_core::MakeRefCounted<grpc_core::Chttp2Telemetry>();
   uint32_t num_messages_in_next_write = 0;
   /// The number of pending induced frames (SETTINGS_ACK, PINGS_ACK and
   /// RST_STREAM) in the outgoing buffer (t->qbuf). If this number goes beyond
@@ -687,6 +759,14 @@ inline grpc_chttp2_stream* grpc_chttp2_parsing_lookup_stream(
 grpc_chttp2_stream* grpc_chttp2_parsing_accept_stream(grpc_chttp2_transport* t,
                                                       uint32_t id);
 
+// Records a phase in the flight recorder timeline of a stream's call, if the
+// call is sampled.
+inline void grpc_chttp2_record_call_phase(grpc_chttp2_stream* s,
+                                          grpc_core::CallPhase phase) {
+  grpc_core::CallTimeline::Record(
+      static_cast<const grpc_call_context_element*>(s->context), phase);
+}
+
 void grpc_chttp2_add_incoming_goaway(grpc_chttp2_transport* t,
                                      uint32_t goaway_error,
                                      uint32_t last_stream_id,
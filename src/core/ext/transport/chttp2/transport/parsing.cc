@@ -539,6 +539,7 @@ static grpc_error_handle init_data_frame_parser(grpc_chttp2_transport* t) {
   }
   s->received_bytes += t->incoming_frame_size;
   s->stats.incoming.framing_bytes += 9;
+  grpc_chttp2_record_call_phase(s, grpc_core::CallPhase::kRead);
   if (s->read_closed) {
     return init_non_header_skip_frame_parser(t);
   }
@@ -660,6 +661,7 @@ static grpc_error_handle init_header_frame_parser(grpc_chttp2_transport* t,
   }
   GPR_DEBUG_ASSERT(s != nullptr);
   s->stats.incoming.framing_bytes += 9;
+  grpc_chttp2_record_call_phase(s, grpc_core::CallPhase::kRead);
   if (GPR_UNLIKELY(s->read_closed)) {
     GRPC_CHTTP2_IF_TRACING(gpr_log(
         GPR_ERROR, "skipping already closed grpc_chttp2_stream header"));
@@ -874,6 +876,7 @@ grpc_error_handle grpc_chttp2_header_parser_parse(void* hpack_parser,
         }
         s->published_metadata[s->header_frames_received] =
             GRPC_METADATA_PUBLISHED_FROM_WIRE;
+        grpc_chttp2_record_call_phase(s, grpc_core::CallPhase::kDecode);
         maybe_complete_funcs[s->header_frames_received](t, s);
         s->header_frames_received++;
       }
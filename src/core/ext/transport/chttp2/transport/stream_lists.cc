@@ -185,32 +185,65 @@ void grpc_chttp2_list_remove_waiting_for_concurrency(grpc_chttp2_transport* t,
   stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_WAITING_FOR_CONCURRENCY);
 }
 
+// The stalled lists are timed: a stall lasts from the first stream being added
+// to a list until the list is empty again.
+
 void grpc_chttp2_list_add_stalled_by_transport(grpc_chttp2_transport* t,
                                                grpc_chttp2_stream* s) {
-  stream_list_add(t, s, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT);
+  const bool was_empty =
+      stream_list_empty(t, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT);
+  if (stream_list_add(t, s, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT) &&
+      was_empty) {
+    t->telemetry->TransportStallStarted();
+  }
 }
 
 bool grpc_chttp2_list_pop_stalled_by_transport(grpc_chttp2_transport* t,
                                                grpc_chttp2_stream** s) {
-  return stream_list_pop(t, s, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT);
+  if (!stream_list_pop(t, s, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT)) {
+    return false;
+  }
+  if (stream_list_empty(t, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT)) {
+    t->telemetry->TransportStallEnded();
+  }
+  return true;
 }
 
 void grpc_chttp2_list_remove_stalled_by_transport(grpc_chttp2_transport* t,
                                                   grpc_chttp2_stream* s) {
-  stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT);
+  if (stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT) &&
+      stream_list_empty(t, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT)) {
+    t->telemetry->TransportStallEnded();
+  }
 }
 
 void grpc_chttp2_list_add_stalled_by_stream(grpc_chttp2_transport* t,
                                             grpc_chttp2_stream* s) {
-  stream_list_add(t, s, GRPC_CHTTP2_LIST_STALLED_BY_STREAM);
+  const bool was_empty =
+      stream_list_empty(t, GRPC_CHTTP2_LIST_STALLED_BY_STREAM);
+  if (stream_list_add(t, s, GRPC_CHTTP2_LIST_STALLED_BY_STREAM) && was_empty) {
+    t->telemetry->StreamStallStarted();
+  }
 }
 
 bool grpc_chttp2_list_pop_stalled_by_stream(grpc_chttp2_transport* t,
                                             grpc_chttp2_stream** s) {
-  return stream_list_pop(t, s, GRPC_CHTTP2_LIST_STALLED_BY_STREAM);
+  if (!stream_list_pop(t, s, GRPC_CHTTP2_LIST_STALLED_BY_STREAM)) {
+    return false;
+  }
+  if (stream_list_empty(t, GRPC_CHTTP2_LIST_STALLED_BY_STREAM)) {
+    t->telemetry->StreamStallEnded();
+  }
+  return true;
 }
 
 bool grpc_chttp2_list_remove_stalled_by_stream(grpc_chttp2_transport* t,
                                                grpc_chttp2_stream* s) {
-  return stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_STALLED_BY_STREAM);
+  if (!stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_STALLED_BY_STREAM)) {
+    return false;
+  }
+  if (stream_list_empty(t, GRPC_CHTTP2_LIST_STALLED_BY_STREAM)) {
+    t->telemetry->StreamStallEnded();
+  }
+  return true;
 }
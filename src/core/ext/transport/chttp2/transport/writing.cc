@@ -170,6 +170,7 @@ static void maybe_initiate_ping(grpc_chttp2_transport* t) {
   t->ping_state.last_ping_sent_time = now;
 
   pq->inflight_id = t->ping_ctr;
+  pq->inflight_sent_at = gpr_get_cycle_counter();
   t->ping_ctr++;
   grpc_core::ExecCtx::RunList(DEBUG_LOCATION,
                               &pq->lists[GRPC_CHTTP2_PCL_INITIATE]);
@@ -476,6 +477,7 @@ class StreamWriteContext {
               &s_->stats.outgoing                         // stats
           },
           *s_->send_initial_metadata, &t_->outbuf);
+      grpc_chttp2_record_call_phase(s_, grpc_core::CallPhase::kHpackEncode);
       grpc_chttp2_reset_ping_clock(t_);
       write_context_->IncInitialMetadataWrites();
     }
@@ -518,6 +520,8 @@ class StreamWriteContext {
         grpc_chttp2_list_add_stalled_by_transport(t_, s_);
       } else if (data_send_context.stream_remote_window() <= 0) {
         grpc_core::global_stats().IncrementHttp2StreamStalls();
+        grpc_chttp2_record_call_phase(s_,
+                                      grpc_core::CallPhase::kFlowControlStall);
         report_stall(t_, s_, "stream");
         grpc_chttp2_list_add_stalled_by_stream(t_, s_);
       }
@@ -571,6 +575,7 @@ class StreamWriteContext {
                           [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
               &s_->stats.outgoing},
           *s_->send_trailing_metadata, &t_->outbuf);
+      grpc_chttp2_record_call_phase(s_, grpc_core::CallPhase::kHpackEncode);
     }
     write_context_->IncTrailingMetadataWrites();
     grpc_chttp2_reset_ping_clock(t_);
@@ -688,9 +693,13 @@ void grpc_chttp2_end_write(grpc_chttp2_transport* t, grpc_error_handle error) {
   if (t->channelz_socket != nullptr) {
     t->channelz_socket->RecordMessagesSent(t->num_messages_in_next_write);
   }
+  t->telemetry->RecordMessagesWritten(t->num_messages_in_next_write);
+  t->telemetry->RecordWindows(t->flow_control.announced_window(),
+                              t->flow_control.remote_window());
   t->num_messages_in_next_write = 0;
 
   while (grpc_chttp2_list_pop_writing_stream(t, &s)) {
+    grpc_chttp2_record_call_phase(s, grpc_core::CallPhase::kWrite);
     if (s->sending_bytes != 0) {
       update_list(t, s, static_cast<int64_t>(s->sending_bytes),
                   &s->on_write_finished_cbs, &s->flow_controlled_bytes_written,
@@ -78,6 +78,17 @@ class XdsApi {
     // we fail to parse the Resource wrapper.
     virtual void ResourceWrapperParsingFailed(size_t idx,
                                               absl::string_view message) = 0;
+
+    // Called instead of ParseResource() for each resource in a delta
+    // ADS response, which carries a version for each resource.
+    virtual void ParseDeltaResource(upb_Arena* arena, size_t idx,
+                                    absl::string_view type_url,
+                                    absl::string_view resource_name,
+                                    absl::string_view resource_version,
+                                    absl::string_view serialized_resource) = 0;
+
+    // Called for each resource that a delta ADS response removes.
+    virtual void ResourceRemoved(absl::string_view resource_name) = 0;
   };
 
   struct ClusterLoadReport {
@@ -163,6 +174,20 @@ class XdsApi {
   absl::Status ParseAdsResponse(absl::string_view encoded_response,
                                 AdsResponseParserInterface* parser);
 
+  // Creates a delta ADS request.  initial_resource_versions should be
+  // non-empty only in the first request for the type on a stream.
+  std::string CreateDeltaAdsRequest(
+      absl::string_view type_url, absl::string_view nonce,
+      const std::vector<std::string>& resource_names_subscribe,
+      const std::vector<std::string>& resource_names_unsubscribe,
+      const std::map<std::string, std::string>& initial_resource_versions,
+      absl::Status status, bool populate_node);
+
+  // Like ParseAdsResponse(), but for a delta ADS response.  In the
+  // fields reported to the parser, version is the system version.
+  absl::Status ParseDeltaAdsResponse(absl::string_view encoded_response,
+                                     AdsResponseParserInterface* parser);
+
   // Creates an initial LRS request.
   std::string CreateLrsInitialRequest();
 
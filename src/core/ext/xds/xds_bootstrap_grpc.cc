@@ -87,6 +87,8 @@ namespace {
 constexpr absl::string_view kServerFeatureIgnoreResourceDeletion =
     "ignore_resource_deletion";
 
+constexpr absl::string_view kServerFeatureDeltaXds = "delta_xds";
+
 }  // namespace
 
 bool GrpcXdsBootstrap::GrpcXdsServer::IgnoreResourceDeletion() const {
@@ -94,6 +96,11 @@ bool GrpcXdsBootstrap::GrpcXdsServer::IgnoreResourceDeletion() const {
              kServerFeatureIgnoreResourceDeletion)) != server_features_.end();
 }
 
+bool GrpcXdsBootstrap::GrpcXdsServer::UseDeltaXds() const {
+  return server_features_.find(std::string(kServerFeatureDeltaXds)) !=
+         server_features_.end();
+}
+
 bool GrpcXdsBootstrap::GrpcXdsServer::Equals(const XdsServer& other) const {
   const auto& o = static_cast<const GrpcXdsServer&>(other);
   return (server_uri_ == o.server_uri_ &&
@@ -168,7 +175,8 @@ void GrpcXdsBootstrap::GrpcXdsServer::JsonPostLoad(const Json& json,
         const Json::Array& array = it->second.array();
         for (const Json& feature_json : array) {
           if (feature_json.type() == Json::Type::kString &&
-              (feature_json.string() == kServerFeatureIgnoreResourceDeletion)) {
+              (feature_json.string() == kServerFeatureIgnoreResourceDeletion ||
+               feature_json.string() == kServerFeatureDeltaXds)) {
             server_features_.insert(feature_json.string());
           }
         }
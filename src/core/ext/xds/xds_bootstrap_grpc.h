@@ -81,6 +81,7 @@ class GrpcXdsBootstrap : public XdsBootstrap {
     const std::string& server_uri() const override { return server_uri_; }
 
     bool IgnoreResourceDeletion() const override;
+    bool UseDeltaXds() const override;
 
     bool Equals(const XdsServer& other) const override;
 
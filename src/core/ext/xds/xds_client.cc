@@ -22,6 +22,8 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <type_traits>
 
 #include "absl/strings/match.h"
@@ -34,14 +36,17 @@
 #include "upb/mem/arena.h"
 
 #include <grpc/event_engine/event_engine.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/xds/xds_api.h"
 #include "src/core/ext/xds/xds_bootstrap.h"
 #include "src/core/ext/xds/xds_client_stats.h"
+#include "src/core/ext/xds/xds_parallel_for.h"
 #include "src/core/lib/backoff/backoff.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -155,14 +160,71 @@ class XdsClient::ChannelState::AdsCallState
     void ResourceWrapperParsingFailed(size_t idx,
                                       absl::string_view message) override;
 
+    void ParseDeltaResource(upb_Arena* arena, size_t idx,
+                            absl::string_view type_url,
+                            absl::string_view resource_name,
+                            absl::string_view resource_version,
+                            absl::string_view serialized_resource) override
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    void ResourceRemoved(absl::string_view resource_name) override
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    // Decodes the resources seen by the methods above, fanning them out
+    // across EventEngine threads if there are enough of them.  This only
+    // touches the parser's own state and a symtab that is no longer
+    // modified, so it is called without holding the XdsClient mutex.
+    void DecodeResources();
+
+    // Applies the decoded resources and any removals to the cache in the
+    // order in which they appeared in the response.
+    void ApplyResources() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     Result TakeResult() { return std::move(result_); }
 
    private:
+    // A resource from the response.  Resources are recorded while the
+    // response is parsed and decoded once it has been parsed completely,
+    // so that the (potentially expensive) decoding can be parallelized.
+    struct PendingResource {
+      size_t idx;
+      std::string type_url;
+      std::string name;
+      std::string version;
+      std::string serialized_resource;
+      // If non-empty, the Resource wrapper could not be parsed, and the
+      // fields above other than idx are not set.
+      std::string wrapper_error;
+      absl::optional<XdsResourceType::DecodeResult> decode_result;
+    };
+
     XdsClient* xds_client() const { return ads_call_state_->xds_client(); }
 
+    // Shared by ParseResource() and ParseDeltaResource().
+    void AddPendingResource(size_t idx, absl::string_view type_url,
+                            absl::string_view resource_name,
+                            absl::string_view resource_version,
+                            absl::string_view serialized_resource);
+
+    // Applies a decoded resource to the cache.
+    void ApplyResource(PendingResource* resource)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    // Applies a resource removal to the cache.
+    void ApplyResourceRemoval(absl::string_view resource_name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    // Stops the does-not-exist timer for the resource, if any.
+    void MarkResourceSeen(const XdsResourceName& name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     AdsCallState* ads_call_state_;
     const Timestamp update_time_ = Timestamp::Now();
     Result result_;
+    // The symtab to decode result_.type's resources with.
+    upb_DefPool* decode_symtab_ = nullptr;
+    std::vector<PendingResource> pending_resources_;
+    std::vector<std::string> removed_resources_;
   };
 
   class ResourceTimer : public InternallyRefCounted<ResourceTimer> {
@@ -302,6 +364,12 @@ class XdsClient::ChannelState::AdsCallState
     std::string nonce;
     absl::Status status;
 
+    // Delta only: the resource names the server knows we are subscribed
+    // to on this stream, and whether we have sent a request for this
+    // type yet.
+    std::set<std::string> subscribed_names_sent;
+    bool sent_request = false;
+
     // Subscribed resources of this type.
     std::map<std::string /*authority*/,
              std::map<XdsResourceKey, OrphanablePtr<ResourceTimer>>>
@@ -317,11 +385,20 @@ class XdsClient::ChannelState::AdsCallState
 
   bool IsCurrentCallOnChannel() const;
 
+  // True if this call uses the delta xDS protocol.
+  bool delta() const { return chand()->server_.UseDeltaXds(); }
+
   // Constructs a list of resource names of a given type for an ADS
   // request.  Also starts the timer for each resource if needed.
   std::vector<std::string> ResourceNamesForRequest(const XdsResourceType* type)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
+  // Returns the versions of the cached resources of a given type, for
+  // the first delta request for that type on the stream.
+  std::map<std::string, std::string> CachedResourceVersions(
+      const XdsResourceType* type)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
   // The owning RetryableCall<>.
   RefCountedPtr<RetryableCall<AdsCallState>> parent_;
 
@@ -707,6 +784,8 @@ absl::Status XdsClient::ChannelState::AdsCallState::AdsResponseParser::
     return absl::InvalidArgumentError(
         absl::StrCat("unknown resource type ", fields.type_url));
   }
+  decode_symtab_ =
+      ads_call_state_->xds_client()->decode_symtabs_[result_.type]->ptr();
   result_.type_url = std::move(fields.type_url);
   result_.version = std::move(fields.version);
   result_.nonce = std::move(fields.nonce);
@@ -715,6 +794,12 @@ absl::Status XdsClient::ChannelState::AdsCallState::AdsResponseParser::
 
 namespace {
 
+// Responses smaller than this are decoded on the thread that received
+// them, since handing resources to other threads would cost more than
+// it saves.
+constexpr size_t kMinResponseSizeForParallelDecoding = 64 * 1024;
+constexpr size_t kMaxResourceDecodingThreads = 8;
+
 // Build a resource metadata struct for ADS result accepting methods and CSDS.
 XdsApi::ResourceMetadata CreateResourceMetadataAcked(
     std::string serialized_proto, std::string version, Timestamp update_time) {
@@ -740,8 +825,117 @@ void UpdateResourceMetadataNacked(const std::string& version,
 }  // namespace
 
 void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
-    upb_Arena* arena, size_t idx, absl::string_view type_url,
+    upb_Arena* /*arena*/, size_t idx, absl::string_view type_url,
     absl::string_view resource_name, absl::string_view serialized_resource) {
+  AddPendingResource(idx, type_url, resource_name, result_.version,
+                     serialized_resource);
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    ParseDeltaResource(upb_Arena* /*arena*/, size_t idx,
+                       absl::string_view type_url,
+                       absl::string_view resource_name,
+                       absl::string_view resource_version,
+                       absl::string_view serialized_resource) {
+  AddPendingResource(idx, type_url, resource_name, resource_version,
+                     serialized_resource);
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    AddPendingResource(size_t idx, absl::string_view type_url,
+                       absl::string_view resource_name,
+                       absl::string_view resource_version,
+                       absl::string_view serialized_resource) {
+  PendingResource resource;
+  resource.idx = idx;
+  resource.type_url = std::string(type_url);
+  resource.name = std::string(resource_name);
+  resource.version = std::string(resource_version);
+  resource.serialized_resource = std::string(serialized_resource);
+  pending_resources_.push_back(std::move(resource));
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    ResourceWrapperParsingFailed(size_t idx, absl::string_view message) {
+  PendingResource resource;
+  resource.idx = idx;
+  resource.wrapper_error = std::string(message);
+  pending_resources_.push_back(std::move(resource));
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    ResourceRemoved(absl::string_view resource_name) {
+  removed_resources_.emplace_back(resource_name);
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    DecodeResources() {
+  // Resources of the wrong type are rejected without being decoded.
+  std::vector<PendingResource*> to_decode;
+  size_t total_size = 0;
+  for (PendingResource& resource : pending_resources_) {
+    if (!resource.wrapper_error.empty()) continue;
+    if (resource.type_url != result_.type_url) continue;
+    to_decode.push_back(&resource);
+    total_size += resource.serialized_resource.size();
+  }
+  const XdsResourceType::DecodeContext context = {
+      xds_client(), ads_call_state_->chand()->server_, &grpc_xds_client_trace,
+      decode_symtab_, nullptr};
+  const size_t max_threads =
+      total_size < kMinResponseSizeForParallelDecoding
+          ? 1
+          : std::min(static_cast<size_t>(gpr_cpu_num_cores()),
+                     kMaxResourceDecodingThreads);
+  XdsParallelFor(xds_client()->engine(), to_decode.size(), max_threads,
+                 [&](size_t i) {
+                   // upb arenas are not thread-safe, so each resource gets
+                   // its own.
+                   upb::Arena arena;
+                   XdsResourceType::DecodeContext resource_context = context;
+                   resource_context.arena = arena.ptr();
+                   to_decode[i]->decode_result = result_.type->Decode(
+                       resource_context, to_decode[i]->serialized_resource);
+                 });
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    ApplyResources() {
+  // Apply the results in order.
+  for (PendingResource& resource : pending_resources_) {
+    if (!resource.wrapper_error.empty()) {
+      result_.errors.emplace_back(absl::StrCat(
+          "resource index ", resource.idx, ": ", resource.wrapper_error));
+      continue;
+    }
+    ApplyResource(&resource);
+  }
+  pending_resources_.clear();
+  for (const std::string& resource_name : removed_resources_) {
+    ApplyResourceRemoval(resource_name);
+  }
+  removed_resources_.clear();
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    MarkResourceSeen(const XdsResourceName& name) {
+  auto timer_it = ads_call_state_->state_map_.find(result_.type);
+  if (timer_it != ads_call_state_->state_map_.end()) {
+    auto it = timer_it->second.subscribed_resources.find(name.authority);
+    if (it != timer_it->second.subscribed_resources.end()) {
+      auto res_it = it->second.find(name.key);
+      if (res_it != it->second.end()) {
+        res_it->second->MarkSeen();
+      }
+    }
+  }
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ApplyResource(
+    PendingResource* resource) {
+  const size_t idx = resource->idx;
+  absl::string_view type_url = resource->type_url;
+  absl::string_view resource_name = resource->name;
   std::string error_prefix = absl::StrCat(
       "resource index ", idx, ": ",
       resource_name.empty() ? "" : absl::StrCat(resource_name, ": "));
@@ -752,12 +946,7 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
                      "\" (should be \"", result_.type_url, "\")"));
     return;
   }
-  // Parse the resource.
-  XdsResourceType::DecodeContext context = {
-      xds_client(), ads_call_state_->chand()->server_, &grpc_xds_client_trace,
-      xds_client()->symtab_.ptr(), arena};
-  XdsResourceType::DecodeResult decode_result =
-      result_.type->Decode(context, serialized_resource);
+  XdsResourceType::DecodeResult& decode_result = *resource->decode_result;
   // If we didn't already have the resource name from the Resource
   // wrapper, try to get it from the decoding result.
   if (resource_name.empty()) {
@@ -788,17 +977,7 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     return;
   }
   // Cancel resource-does-not-exist timer, if needed.
-  auto timer_it = ads_call_state_->state_map_.find(result_.type);
-  if (timer_it != ads_call_state_->state_map_.end()) {
-    auto it = timer_it->second.subscribed_resources.find(
-        parsed_resource_name->authority);
-    if (it != timer_it->second.subscribed_resources.end()) {
-      auto res_it = it->second.find(parsed_resource_name->key);
-      if (res_it != it->second.end()) {
-        res_it->second->MarkSeen();
-      }
-    }
-  }
+  MarkResourceSeen(*parsed_resource_name);
   // Lookup the authority in the cache.
   auto authority_it =
       xds_client()->authority_state_map_.find(parsed_resource_name->authority);
@@ -841,7 +1020,7 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
         resource_state.watchers,
         absl::UnavailableError(
             absl::StrCat("invalid resource: ", decode_status.ToString())));
-    UpdateResourceMetadataNacked(result_.version, decode_status.ToString(),
+    UpdateResourceMetadataNacked(resource->version, decode_status.ToString(),
                                  update_time_, &resource_state.meta);
     return;
   }
@@ -862,7 +1041,8 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
   // Update the resource state.
   resource_state.resource = std::move(*decode_result.resource);
   resource_state.meta = CreateResourceMetadataAcked(
-      std::string(serialized_resource), result_.version, update_time_);
+      std::move(resource->serialized_resource), std::move(resource->version),
+      update_time_);
   // Notify watchers.
   auto& watchers_list = resource_state.watchers;
   auto* value =
@@ -879,9 +1059,41 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
 }
 
 void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
-    ResourceWrapperParsingFailed(size_t idx, absl::string_view message) {
-  result_.errors.emplace_back(
-      absl::StrCat("resource index ", idx, ": ", message));
+    ApplyResourceRemoval(absl::string_view resource_name) {
+  auto parsed_resource_name =
+      xds_client()->ParseXdsResourceName(resource_name, result_.type);
+  if (!parsed_resource_name.ok()) {
+    result_.errors.emplace_back(
+        absl::StrCat("removed resource ", resource_name,
+                     ": Cannot parse xDS resource name"));
+    return;
+  }
+  // The server has told us the resource does not exist, so there is no
+  // need to wait for it any longer.
+  MarkResourceSeen(*parsed_resource_name);
+  auto authority_it =
+      xds_client()->authority_state_map_.find(parsed_resource_name->authority);
+  if (authority_it == xds_client()->authority_state_map_.end()) return;
+  auto type_it = authority_it->second.resource_map.find(result_.type);
+  if (type_it == authority_it->second.resource_map.end()) return;
+  auto it = type_it->second.find(parsed_resource_name->key);
+  if (it == type_it->second.end()) return;
+  ResourceState& resource_state = it->second;
+  if (ads_call_state_->chand()->server_.IgnoreResourceDeletion()) {
+    if (!resource_state.ignored_deletion) {
+      gpr_log(GPR_ERROR,
+              "[xds_client %p] xds server %s: ignoring deletion for resource "
+              "type %s name %s",
+              xds_client(),
+              ads_call_state_->chand()->server_.server_uri().c_str(),
+              result_.type_url.c_str(), std::string(resource_name).c_str());
+      resource_state.ignored_deletion = true;
+    }
+    return;
+  }
+  resource_state.resource.reset();
+  resource_state.meta.client_status = XdsApi::ResourceMetadata::DOES_NOT_EXIST;
+  xds_client()->NotifyWatchersOnResourceDoesNotExist(resource_state.watchers);
 }
 
 //
@@ -898,8 +1110,10 @@ XdsClient::ChannelState::AdsCallState::AdsCallState(
   GPR_ASSERT(xds_client() != nullptr);
   // Init the ADS call.
   const char* method =
-      "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
-      "StreamAggregatedResources";
+      delta() ? "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+                "DeltaAggregatedResources"
+              : "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+                "StreamAggregatedResources";
   call_ = chand()->transport_->CreateStreamingCall(
       method, std::make_unique<StreamEventHandler>(
                   // Passing the initial ref here.  This ref will go away when
@@ -951,9 +1165,32 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
     return;
   }
   auto& state = state_map_[type];
-  std::string serialized_message = xds_client()->api_.CreateAdsRequest(
-      type->type_url(), chand()->resource_type_version_map_[type], state.nonce,
-      ResourceNamesForRequest(type), state.status, !sent_initial_message_);
+  std::vector<std::string> resource_names = ResourceNamesForRequest(type);
+  std::string serialized_message;
+  if (delta()) {
+    // Send only the changes to the subscriptions the server knows about.
+    std::set<std::string> names(resource_names.begin(), resource_names.end());
+    std::vector<std::string> subscribe;
+    std::set_difference(names.begin(), names.end(),
+                        state.subscribed_names_sent.begin(),
+                        state.subscribed_names_sent.end(),
+                        std::back_inserter(subscribe));
+    std::vector<std::string> unsubscribe;
+    std::set_difference(state.subscribed_names_sent.begin(),
+                        state.subscribed_names_sent.end(), names.begin(),
+                        names.end(), std::back_inserter(unsubscribe));
+    serialized_message = xds_client()->api_.CreateDeltaAdsRequest(
+        type->type_url(), state.nonce, subscribe, unsubscribe,
+        state.sent_request ? std::map<std::string, std::string>()
+                           : CachedResourceVersions(type),
+        state.status, !sent_initial_message_);
+    state.subscribed_names_sent = std::move(names);
+    state.sent_request = true;
+  } else {
+    serialized_message = xds_client()->api_.CreateAdsRequest(
+        type->type_url(), chand()->resource_type_version_map_[type],
+        state.nonce, resource_names, state.status, !sent_initial_message_);
+  }
   sent_initial_message_ = true;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO,
@@ -965,6 +1202,9 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
             state.nonce.c_str(), state.status.ToString().c_str());
   }
   state.status = absl::OkStatus();
+  // In delta xDS, the nonce is sent only to ACK or NACK a response, not
+  // again with later subscription changes.
+  if (delta()) state.nonce.clear();
   call_->SendMessage(std::move(serialized_message));
   send_message_pending_ = type;
 }
@@ -1036,12 +1276,17 @@ void XdsClient::ChannelState::AdsCallState::OnRequestSent(bool ok) {
 
 void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
     absl::string_view payload) {
+  // The response is parsed and applied under the lock, but the resources in
+  // it are decoded without it, so that decoding a large response does not
+  // block watchers and the other xDS channels.
+  AdsResponseParser parser(this);
   {
     MutexLock lock(&xds_client()->mu_);
     if (!IsCurrentCallOnChannel()) return;
     // Parse and validate the response.
-    AdsResponseParser parser(this);
-    absl::Status status = xds_client()->api_.ParseAdsResponse(payload, &parser);
+    absl::Status status =
+        delta() ? xds_client()->api_.ParseDeltaAdsResponse(payload, &parser)
+                : xds_client()->api_.ParseAdsResponse(payload, &parser);
     if (!status.ok()) {
       // Ignore unparsable response.
       gpr_log(GPR_ERROR,
@@ -1049,89 +1294,98 @@ void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
               "-- ignoring",
               xds_client(), chand()->server_.server_uri().c_str(),
               status.ToString().c_str());
-    } else {
-      seen_response_ = true;
-      chand()->status_ = absl::OkStatus();
-      AdsResponseParser::Result result = parser.TakeResult();
-      // Update nonce.
-      auto& state = state_map_[result.type];
-      state.nonce = result.nonce;
-      // If we got an error, set state.status so that we'll NACK the update.
-      if (!result.errors.empty()) {
-        state.status = absl::UnavailableError(
-            absl::StrCat("xDS response validation errors: [",
-                         absl::StrJoin(result.errors, "; "), "]"));
-        gpr_log(GPR_ERROR,
-                "[xds_client %p] xds server %s: ADS response invalid for "
-                "resource "
-                "type %s version %s, will NACK: nonce=%s status=%s",
-                xds_client(), chand()->server_.server_uri().c_str(),
-                result.type_url.c_str(), result.version.c_str(),
-                state.nonce.c_str(), state.status.ToString().c_str());
-      }
-      // Delete resources not seen in update if needed.
-      if (result.type->AllResourcesRequiredInSotW()) {
-        for (auto& a : xds_client()->authority_state_map_) {
-          const std::string& authority = a.first;
-          AuthorityState& authority_state = a.second;
-          // Skip authorities that are not using this xDS channel.
-          if (authority_state.channel_state != chand()) continue;
-          auto seen_authority_it = result.resources_seen.find(authority);
-          // Find this resource type.
-          auto type_it = authority_state.resource_map.find(result.type);
-          if (type_it == authority_state.resource_map.end()) continue;
-          // Iterate over resource ids.
-          for (auto& r : type_it->second) {
-            const XdsResourceKey& resource_key = r.first;
-            ResourceState& resource_state = r.second;
-            if (seen_authority_it == result.resources_seen.end() ||
-                seen_authority_it->second.find(resource_key) ==
-                    seen_authority_it->second.end()) {
-              // If the resource was newly requested but has not yet been
-              // received, we don't want to generate an error for the
-              // watchers, because this ADS response may be in reaction to an
-              // earlier request that did not yet request the new resource, so
-              // its absence from the response does not necessarily indicate
-              // that the resource does not exist.  For that case, we rely on
-              // the request timeout instead.
-              if (resource_state.resource == nullptr) continue;
-              if (chand()->server_.IgnoreResourceDeletion()) {
-                if (!resource_state.ignored_deletion) {
-                  gpr_log(GPR_ERROR,
-                          "[xds_client %p] xds server %s: ignoring deletion "
-                          "for resource type %s name %s",
-                          xds_client(), chand()->server_.server_uri().c_str(),
-                          result.type_url.c_str(),
-                          XdsClient::ConstructFullXdsResourceName(
-                              authority, result.type_url.c_str(), resource_key)
-                              .c_str());
-                  resource_state.ignored_deletion = true;
-                }
-              } else {
-                resource_state.resource.reset();
-                resource_state.meta.client_status =
-                    XdsApi::ResourceMetadata::DOES_NOT_EXIST;
-                xds_client()->NotifyWatchersOnResourceDoesNotExist(
-                    resource_state.watchers);
+      return;
+    }
+  }
+  parser.DecodeResources();
+  {
+    MutexLock lock(&xds_client()->mu_);
+    // The call may have been replaced or the client shut down while the
+    // lock was released.
+    if (!IsCurrentCallOnChannel()) return;
+    seen_response_ = true;
+    chand()->status_ = absl::OkStatus();
+    parser.ApplyResources();
+    AdsResponseParser::Result result = parser.TakeResult();
+    // Update nonce.
+    auto& state = state_map_[result.type];
+    state.nonce = result.nonce;
+    // If we got an error, set state.status so that we'll NACK the update.
+    if (!result.errors.empty()) {
+      state.status = absl::UnavailableError(
+          absl::StrCat("xDS response validation errors: [",
+                       absl::StrJoin(result.errors, "; "), "]"));
+      gpr_log(GPR_ERROR,
+              "[xds_client %p] xds server %s: ADS response invalid for "
+              "resource "
+              "type %s version %s, will NACK: nonce=%s status=%s",
+              xds_client(), chand()->server_.server_uri().c_str(),
+              result.type_url.c_str(), result.version.c_str(),
+              state.nonce.c_str(), state.status.ToString().c_str());
+    }
+    // Delete resources not seen in update if needed.  Delta responses
+    // list deleted resources explicitly instead.
+    if (!delta() && result.type->AllResourcesRequiredInSotW()) {
+      for (auto& a : xds_client()->authority_state_map_) {
+        const std::string& authority = a.first;
+        AuthorityState& authority_state = a.second;
+        // Skip authorities that are not using this xDS channel.
+        if (authority_state.channel_state != chand()) continue;
+        auto seen_authority_it = result.resources_seen.find(authority);
+        // Find this resource type.
+        auto type_it = authority_state.resource_map.find(result.type);
+        if (type_it == authority_state.resource_map.end()) continue;
+        // Iterate over resource ids.
+        for (auto& r : type_it->second) {
+          const XdsResourceKey& resource_key = r.first;
+          ResourceState& resource_state = r.second;
+          if (seen_authority_it == result.resources_seen.end() ||
+              seen_authority_it->second.find(resource_key) ==
+                  seen_authority_it->second.end()) {
+            // If the resource was newly requested but has not yet been
+            // received, we don't want to generate an error for the
+            // watchers, because this ADS response may be in reaction to an
+            // earlier request that did not yet request the new resource, so
+            // its absence from the response does not necessarily indicate
+            // that the resource does not exist.  For that case, we rely on
+            // the request timeout instead.
+            if (resource_state.resource == nullptr) continue;
+            if (chand()->server_.IgnoreResourceDeletion()) {
+              if (!resource_state.ignored_deletion) {
+                gpr_log(GPR_ERROR,
+                        "[xds_client %p] xds server %s: ignoring deletion "
+                        "for resource type %s name %s",
+                        xds_client(), chand()->server_.server_uri().c_str(),
+                        result.type_url.c_str(),
+                        XdsClient::ConstructFullXdsResourceName(
+                            authority, result.type_url.c_str(), resource_key)
+                            .c_str());
+                resource_state.ignored_deletion = true;
               }
+            } else {
+              resource_state.resource.reset();
+              resource_state.meta.client_status =
+                  XdsApi::ResourceMetadata::DOES_NOT_EXIST;
+              xds_client()->NotifyWatchersOnResourceDoesNotExist(
+                  resource_state.watchers);
             }
           }
         }
       }
-      // If we had valid resources or the update was empty, update the version.
-      if (result.have_valid_resources || result.errors.empty()) {
-        chand()->resource_type_version_map_[result.type] =
-            std::move(result.version);
-        // Start load reporting if needed.
-        auto& lrs_call = chand()->lrs_calld_;
-        if (lrs_call != nullptr) {
-          LrsCallState* lrs_calld = lrs_call->calld();
-          if (lrs_calld != nullptr) lrs_calld->MaybeStartReportingLocked();
-        }
+    }
+    // If we had valid resources or the update was empty, update the version.
+    if (result.have_valid_resources || result.errors.empty()) {
+      chand()->resource_type_version_map_[result.type] =
+          std::move(result.version);
+      // Start load reporting if needed.
+      auto& lrs_call = chand()->lrs_calld_;
+      if (lrs_call != nullptr) {
+        LrsCallState* lrs_calld = lrs_call->calld();
+        if (lrs_calld != nullptr) lrs_calld->MaybeStartReportingLocked();
       }
-      // Send ACK or NACK.
-      SendMessageLocked(result.type);
     }
+    // Send ACK or NACK.
+    SendMessageLocked(result.type);
   }
   xds_client()->work_serializer_.DrainQueue();
 }
@@ -1199,6 +1453,27 @@ XdsClient::ChannelState::AdsCallState::ResourceNamesForRequest(
   return resource_names;
 }
 
+std::map<std::string, std::string>
+XdsClient::ChannelState::AdsCallState::CachedResourceVersions(
+    const XdsResourceType* type) {
+  std::map<std::string, std::string> versions;
+  for (const auto& a : xds_client()->authority_state_map_) {
+    const std::string& authority = a.first;
+    // Skip authorities that are not using this xDS channel.
+    if (a.second.channel_state != chand()) continue;
+    auto type_it = a.second.resource_map.find(type);
+    if (type_it == a.second.resource_map.end()) continue;
+    for (const auto& r : type_it->second) {
+      const ResourceState& resource_state = r.second;
+      if (resource_state.resource == nullptr) continue;
+      versions.emplace(XdsClient::ConstructFullXdsResourceName(
+                           authority, type->type_url(), r.first),
+                       resource_state.meta.version);
+    }
+  }
+  return versions;
+}
+
 //
 // XdsClient::ChannelState::LrsCallState::Reporter
 //
@@ -1725,6 +2000,9 @@ void XdsClient::MaybeRegisterResourceTypeLocked(
   }
   resource_types_.emplace(resource_type->type_url(), resource_type);
   resource_type->InitUpbSymtab(this, symtab_.ptr());
+  auto decode_symtab = std::make_unique<upb::SymbolTable>();
+  resource_type->InitUpbSymtab(this, decode_symtab->ptr());
+  decode_symtabs_.emplace(resource_type, std::move(decode_symtab));
 }
 
 const XdsResourceType* XdsClient::GetResourceTypeLocked(
@@ -318,6 +318,11 @@ class XdsClient : public DualRefCounted<XdsClient> {
   std::map<absl::string_view /*resource_type*/, const XdsResourceType*>
       resource_types_ ABSL_GUARDED_BY(mu_);
   upb::SymbolTable symtab_ ABSL_GUARDED_BY(mu_);
+  // A separate symtab per resource type, used only to decode resources of
+  // that type.  Each is filled in when its type is registered and only read
+  // after that, so resources can be decoded without holding mu_.
+  std::map<const XdsResourceType*, std::unique_ptr<upb::SymbolTable>>
+      decode_symtabs_ ABSL_GUARDED_BY(mu_);
 
   // Map of existing xDS server channels.
   // Key is owned by the bootstrap config.
@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <limits>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "absl/status/status.h"
@@ -41,11 +42,14 @@
 #include "google/protobuf/wrappers.upb.h"
 #include "upb/text/encode.h"
 
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/xds/upb_utils.h"
+#include "src/core/ext/xds/xds_client.h"
 #include "src/core/ext/xds/xds_cluster.h"
 #include "src/core/ext/xds/xds_health_status.h"
+#include "src/core/ext/xds/xds_parallel_for.h"
 #include "src/core/ext/xds/xds_resource_type.h"
 #include "src/core/lib/address_utils/parse_address.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
@@ -241,8 +245,75 @@ struct ResolvedAddressLessThan {
 using ResolvedAddressSet =
     std::set<grpc_resolved_address, ResolvedAddressLessThan>;
 
+// The result of parsing one LbEndpoint.
+struct ParsedEndpoint {
+  absl::optional<ServerAddress> address;
+  // Errors found in the endpoint, with the full field names.
+  ValidationErrors errors;
+};
+
+// Endpoints are the bulk of a large ClusterLoadAssignment, so when there are
+// at least this many, they are parsed on multiple threads, in chunks of
+// kEndpointsPerParsingTask.
+constexpr size_t kMinEndpointsForParallelParsing = 1024;
+constexpr size_t kEndpointsPerParsingTask = 256;
+constexpr size_t kMaxEndpointParsingThreads = 8;
+
+// Parses the lb_endpoints of each locality.  Returns one vector per locality.
+std::vector<std::vector<ParsedEndpoint>> EndpointsParse(
+    const XdsResourceType::DecodeContext& context,
+    const envoy_config_endpoint_v3_LocalityLbEndpoints* const* endpoints,
+    size_t locality_size) {
+  std::vector<std::vector<ParsedEndpoint>> parsed_endpoints(locality_size);
+  // The (locality index, endpoint index) pair of each endpoint.
+  std::vector<std::pair<size_t, size_t>> endpoint_indexes;
+  for (size_t i = 0; i < locality_size; ++i) {
+    size_t size;
+    envoy_config_endpoint_v3_LocalityLbEndpoints_lb_endpoints(endpoints[i],
+                                                              &size);
+    parsed_endpoints[i].resize(size);
+    for (size_t j = 0; j < size; ++j) endpoint_indexes.emplace_back(i, j);
+  }
+  auto parse_endpoint = [&](size_t k) {
+    const size_t i = endpoint_indexes[k].first;
+    const size_t j = endpoint_indexes[k].second;
+    size_t size;
+    const envoy_config_endpoint_v3_LbEndpoint* lb_endpoint =
+        envoy_config_endpoint_v3_LocalityLbEndpoints_lb_endpoints(endpoints[i],
+                                                                  &size)[j];
+    ParsedEndpoint& parsed = parsed_endpoints[i][j];
+    ValidationErrors::ScopedField field(&parsed.errors, "endpoints");
+    ValidationErrors::ScopedField field2(&parsed.errors,
+                                         absl::StrCat("[", i, "]"));
+    ValidationErrors::ScopedField field3(
+        &parsed.errors, absl::StrCat(".lb_endpoints[", j, "]"));
+    parsed.address = ServerAddressParse(lb_endpoint, &parsed.errors);
+  };
+  if (endpoint_indexes.size() < kMinEndpointsForParallelParsing) {
+    for (size_t k = 0; k < endpoint_indexes.size(); ++k) parse_endpoint(k);
+  } else {
+    const size_t num_tasks =
+        (endpoint_indexes.size() + kEndpointsPerParsingTask - 1) /
+        kEndpointsPerParsingTask;
+    XdsParallelFor(
+        context.client->engine(), num_tasks,
+        std::min(static_cast<size_t>(gpr_cpu_num_cores()),
+                 kMaxEndpointParsingThreads),
+        [&](size_t task) {
+          const size_t end =
+              std::min((task + 1) * kEndpointsPerParsingTask,
+                       endpoint_indexes.size());
+          for (size_t k = task * kEndpointsPerParsingTask; k < end; ++k) {
+            parse_endpoint(k);
+          }
+        });
+  }
+  return parsed_endpoints;
+}
+
 absl::optional<ParsedLocality> LocalityParse(
     const envoy_config_endpoint_v3_LocalityLbEndpoints* locality_lb_endpoints,
+    std::vector<ParsedEndpoint> parsed_endpoints,
     ResolvedAddressSet* address_set, ValidationErrors* errors) {
   const size_t original_error_size = errors->size();
   ParsedLocality parsed_locality;
@@ -276,14 +347,11 @@ absl::optional<ParsedLocality> LocalityParse(
   parsed_locality.locality.name = MakeRefCounted<XdsLocalityName>(
       std::move(region), std::move(zone), std::move(sub_zone));
   // lb_endpoints
-  size_t size;
-  const envoy_config_endpoint_v3_LbEndpoint* const* lb_endpoints =
-      envoy_config_endpoint_v3_LocalityLbEndpoints_lb_endpoints(
-          locality_lb_endpoints, &size);
-  for (size_t i = 0; i < size; ++i) {
+  for (size_t i = 0; i < parsed_endpoints.size(); ++i) {
+    errors->AddErrors(parsed_endpoints[i].errors);
     ValidationErrors::ScopedField field(errors,
                                         absl::StrCat(".lb_endpoints[", i, "]"));
-    auto address = ServerAddressParse(lb_endpoints[i], errors);
+    auto& address = parsed_endpoints[i].address;
     if (address.has_value()) {
       bool inserted = address_set->insert(address->address()).second;
       if (!inserted) {
@@ -354,7 +422,7 @@ void DropParseAndAppend(
 }
 
 absl::StatusOr<XdsEndpointResource> EdsResourceParse(
-    const XdsResourceType::DecodeContext& /*context*/,
+    const XdsResourceType::DecodeContext& context,
     const envoy_config_endpoint_v3_ClusterLoadAssignment*
         cluster_load_assignment) {
   ValidationErrors errors;
@@ -367,9 +435,12 @@ absl::StatusOr<XdsEndpointResource> EdsResourceParse(
     const envoy_config_endpoint_v3_LocalityLbEndpoints* const* endpoints =
         envoy_config_endpoint_v3_ClusterLoadAssignment_endpoints(
             cluster_load_assignment, &locality_size);
+    std::vector<std::vector<ParsedEndpoint>> parsed_endpoints =
+        EndpointsParse(context, endpoints, locality_size);
     for (size_t i = 0; i < locality_size; ++i) {
       ValidationErrors::ScopedField field(&errors, absl::StrCat("[", i, "]"));
-      auto parsed_locality = LocalityParse(endpoints[i], &address_set, &errors);
+      auto parsed_locality = LocalityParse(
+          endpoints[i], std::move(parsed_endpoints[i]), &address_set, &errors);
       if (parsed_locality.has_value()) {
         GPR_ASSERT(parsed_locality->locality.lb_weight != 0);
         // Make sure prorities is big enough. Note that they might not
@@ -0,0 +1,101 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_XDS_XDS_PARALLEL_FOR_H
+#define GRPC_SRC_CORE_EXT_XDS_XDS_PARALLEL_FOR_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+// Calls fn(0), ..., fn(num_items - 1) on up to max_threads threads: the
+// calling thread and up to max_threads - 1 EventEngine tasks.  Returns once
+// every call has returned.  If engine is null, all calls are made on the
+// calling thread.
+//
+// Each thread repeatedly claims the next index that has not been claimed.
+// The calling thread therefore never waits for a task that has not started
+// running, and a task that starts after all indexes have been claimed
+// returns without calling fn.
+inline void XdsParallelFor(grpc_event_engine::experimental::EventEngine* engine,
+                           size_t num_items, size_t max_threads,
+                           absl::FunctionRef<void(size_t)> fn) {
+  class State : public RefCounted<State> {
+   public:
+    State(size_t num_items, absl::FunctionRef<void(size_t)> fn)
+        : num_items_(num_items), fn_(fn) {}
+
+    void Run() {
+      while (true) {
+        const size_t i = next_item_.fetch_add(1, std::memory_order_relaxed);
+        if (i >= num_items_) return;
+        fn_(i);
+        MutexLock lock(&mu_);
+        if (++num_done_ == num_items_) cv_.SignalAll();
+      }
+    }
+
+    void Wait() {
+      MutexLock lock(&mu_);
+      while (num_done_ < num_items_) cv_.Wait(&mu_);
+    }
+
+   private:
+    const size_t num_items_;
+    // Only called for claimed indexes, all of which are claimed before the
+    // caller returns.
+    const absl::FunctionRef<void(size_t)> fn_;
+    std::atomic<size_t> next_item_{0};
+    Mutex mu_;
+    CondVar cv_;
+    size_t num_done_ ABSL_GUARDED_BY(mu_) = 0;
+  };
+  const size_t num_threads =
+      engine == nullptr ? 1 : std::min(max_threads, num_items);
+  if (num_threads <= 1) {
+    for (size_t i = 0; i < num_items; ++i) fn(i);
+    return;
+  }
+  auto state = MakeRefCounted<State>(num_items, fn);
+  for (size_t i = 1; i < num_threads; ++i) {
+    engine->Run([state]() {
+      ApplicationCallbackExecCtx callback_exec_ctx;
+      ExecCtx exec_ctx;
+      state->Run();
+    });
+  }
+  state->Run();
+  state->Wait();
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_XDS_XDS_PARALLEL_FOR_H
@@ -25,12 +25,15 @@
 
 #include <algorithm>
 #include <cctype>
+#include <iterator>
 #include <utility>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "re2/re2.h"
 
 #include <grpc/support/log.h>
 
@@ -175,6 +178,215 @@ absl::optional<size_t> XdsRouting::GetRouteForRequest(
   return absl::nullopt;
 }
 
+//
+// XdsRouting::RouteTable::PathTrie
+//
+
+void XdsRouting::RouteTable::PathTrie::Insert(absl::string_view key,
+                                              bool is_prefix, uint32_t route) {
+  uint32_t node = 0;
+  for (const char c : key) {
+    auto& children = nodes_[node].children;
+    auto it = std::lower_bound(
+        children.begin(), children.end(), c,
+        [](const std::pair<char, uint32_t>& child, char c) {
+          return child.first < c;
+        });
+    if (it != children.end() && it->first == c) {
+      node = it->second;
+      continue;
+    }
+    const uint32_t child = nodes_.size();
+    children.emplace(it, c, child);
+    // Invalidates children.
+    nodes_.emplace_back();
+    node = child;
+  }
+  if (is_prefix) {
+    nodes_[node].prefix_routes.push_back(route);
+  } else {
+    nodes_[node].exact_routes.push_back(route);
+  }
+}
+
+void XdsRouting::RouteTable::PathTrie::Lookup(absl::string_view path,
+                                              RouteList* routes) const {
+  const Node* node = &nodes_[0];
+  for (const char c : path) {
+    routes->insert(routes->end(), node->prefix_routes.begin(),
+                   node->prefix_routes.end());
+    auto it = std::lower_bound(
+        node->children.begin(), node->children.end(), c,
+        [](const std::pair<char, uint32_t>& child, char c) {
+          return child.first < c;
+        });
+    if (it == node->children.end() || it->first != c) return;
+    node = &nodes_[it->second];
+  }
+  routes->insert(routes->end(), node->prefix_routes.begin(),
+                 node->prefix_routes.end());
+  routes->insert(routes->end(), node->exact_routes.begin(),
+                 node->exact_routes.end());
+}
+
+//
+// XdsRouting::RouteTable::PathCache
+//
+
+void XdsRouting::RouteTable::PathCache::GetRoutes(const RouteTable& table,
+                                                  absl::string_view path,
+                                                  RouteList* routes) {
+  MutexLock lock(&mu_);
+  auto it = index_.find(path);
+  if (it != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    *routes = it->second->routes;
+    return;
+  }
+  // On a miss, reuse the least recently used entry if the cache is full,
+  // so that a full cache does not allocate a new one.
+  if (entries_.size() >= kMaxCachedPathsPerShard) {
+    index_.erase(entries_.back().path);
+    entries_.splice(entries_.begin(), entries_, std::prev(entries_.end()));
+  } else {
+    entries_.emplace_front();
+  }
+  Entry& entry = entries_.front();
+  entry.path.assign(path.data(), path.size());
+  entry.routes.clear();
+  table.RoutesForPath(path, &entry.routes);
+  index_.emplace(entry.path, entries_.begin());
+  *routes = entry.routes;
+}
+
+bool XdsRouting::RouteTable::PathCache::Contains(absl::string_view path) {
+  MutexLock lock(&mu_);
+  return index_.find(path) != index_.end();
+}
+
+//
+// XdsRouting::RouteTable
+//
+
+XdsRouting::RouteTable::RouteTable(
+    const RouteListIterator& route_list_iterator) {
+  routes_.resize(route_list_iterator.Size());
+  std::map<absl::string_view, size_t> header_indexes;
+  std::vector<const StringMatcher*> regex_matchers;
+  for (uint32_t i = 0; i < routes_.size(); ++i) {
+    const XdsRouteConfigResource::Route::Matchers& matchers =
+        route_list_iterator.GetMatchersForRoute(i);
+    const StringMatcher& path_matcher = matchers.path_matcher;
+    switch (path_matcher.type()) {
+      case StringMatcher::Type::kExact:
+      case StringMatcher::Type::kPrefix: {
+        const bool is_prefix =
+            path_matcher.type() == StringMatcher::Type::kPrefix;
+        if (path_matcher.case_sensitive()) {
+          case_sensitive_paths_.Insert(path_matcher.string_matcher(),
+                                       is_prefix, i);
+        } else {
+          case_insensitive_paths_.Insert(
+              absl::AsciiStrToLower(path_matcher.string_matcher()), is_prefix,
+              i);
+        }
+        break;
+      }
+      case StringMatcher::Type::kSafeRegex:
+        regex_matchers.push_back(&path_matcher);
+        regex_path_routes_.push_back(i);
+        break;
+      default:
+        other_paths_.emplace_back(i, &path_matcher);
+    }
+    for (const HeaderMatcher& header_matcher : matchers.header_matchers) {
+      auto it =
+          header_indexes.emplace(header_matcher.name(), header_names_.size())
+              .first;
+      if (it->second == header_names_.size()) {
+        header_names_.push_back(header_matcher.name());
+      }
+      routes_[i].header_matchers.emplace_back(it->second, &header_matcher);
+    }
+    routes_[i].fraction_per_million = matchers.fraction_per_million;
+  }
+  if (regex_matchers.empty()) return;
+  // Use the same options as StringMatcher, anchored at both ends as for
+  // RE2::FullMatch().
+  regex_paths_ = std::make_unique<RE2::Set>(RE2::Options(), RE2::ANCHOR_BOTH);
+  bool ok = true;
+  for (const StringMatcher* matcher : regex_matchers) {
+    if (regex_paths_->Add(matcher->regex_matcher()->pattern(), nullptr) < 0) {
+      ok = false;
+      break;
+    }
+  }
+  // If the regexes can't be combined (e.g., because the combined
+  // automaton would be too large), match them one by one.
+  if (!ok || !regex_paths_->Compile()) {
+    regex_paths_.reset();
+    for (size_t i = 0; i < regex_matchers.size(); ++i) {
+      other_paths_.emplace_back(regex_path_routes_[i], regex_matchers[i]);
+    }
+    regex_path_routes_.clear();
+  }
+}
+
+void XdsRouting::RouteTable::RoutesForPath(absl::string_view path,
+                                           RouteList* routes) const {
+  case_sensitive_paths_.Lookup(path, routes);
+  if (!case_insensitive_paths_.empty()) {
+    case_insensitive_paths_.Lookup(absl::AsciiStrToLower(path), routes);
+  }
+  if (regex_paths_ != nullptr) {
+    std::vector<int> matches;
+    regex_paths_->Match(re2::StringPiece(path.data(), path.size()), &matches);
+    for (int match : matches) routes->push_back(regex_path_routes_[match]);
+  }
+  for (const auto& p : other_paths_) {
+    if (p.second->Match(path)) routes->push_back(p.first);
+  }
+  std::sort(routes->begin(), routes->end());
+}
+
+absl::optional<size_t> XdsRouting::RouteTable::GetRouteForRequest(
+    absl::string_view path, grpc_metadata_batch* initial_metadata) const {
+  RouteList routes;
+  path_caches_.this_cpu().GetRoutes(*this, path, &routes);
+  // Header values, looked up on first use.
+  std::vector<absl::optional<absl::optional<absl::string_view>>> header_values;
+  std::vector<std::string> concatenated_values;
+  for (const uint32_t i : routes) {
+    const Route& route = routes_[i];
+    bool headers_match = true;
+    for (const auto& p : route.header_matchers) {
+      if (header_values.empty()) {
+        header_values.resize(header_names_.size());
+        concatenated_values.resize(header_names_.size());
+      }
+      auto& value = header_values[p.first];
+      if (!value.has_value()) {
+        value = GetHeaderValue(initial_metadata, header_names_[p.first],
+                               &concatenated_values[p.first]);
+      }
+      if (!p.second->Match(*value)) {
+        headers_match = false;
+        break;
+      }
+    }
+    if (headers_match && (!route.fraction_per_million.has_value() ||
+                          UnderFraction(*route.fraction_per_million))) {
+      return i;
+    }
+  }
+  return absl::nullopt;
+}
+
+bool XdsRouting::RouteTable::TestOnlyIsPathCached(
+    absl::string_view path) const {
+  return path_caches_.this_cpu().Contains(path);
+}
+
 bool XdsRouting::IsValidDomainPattern(absl::string_view domain_pattern) {
   return DomainPatternMatchType(domain_pattern) != INVALID_MATCH;
 }
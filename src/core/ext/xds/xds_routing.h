@@ -22,19 +22,30 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <list>
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "re2/set.h"
 
 #include "src/core/ext/xds/xds_http_filters.h"
 #include "src/core/ext/xds/xds_listener.h"
 #include "src/core/ext/xds/xds_route_config.h"
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/per_cpu.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/matchers/matchers.h"
 #include "src/core/lib/transport/metadata_batch.h"
 
 namespace grpc_core {
@@ -71,6 +82,117 @@ class XdsRouting {
       const RouteListIterator& route_list_iterator, absl::string_view path,
       grpc_metadata_batch* initial_metadata);
 
+  // A route list compiled for matching many requests against it.
+  // Exact and prefix path matchers are merged into a trie, regex path
+  // matchers into a single RE2::Set, and each header is looked up at
+  // most once per request, no matter how many routes match on it.  The
+  // routes whose path matchers match a given path are memoized in a
+  // bounded LRU cache per shard of CPUs.
+  // Selects the same route as GetRouteForRequest() on the same list.
+  // The route list must outlive the table.
+  class RouteTable {
+   public:
+    // Max number of paths whose matching routes are memoized in each
+    // shard of the path cache.
+    static constexpr size_t kMaxCachedPathsPerShard = 128;
+
+    explicit RouteTable(const RouteListIterator& route_list_iterator);
+
+    RouteTable(const RouteTable&) = delete;
+    RouteTable& operator=(const RouteTable&) = delete;
+
+    // Returns the index of the route to use for a request with the
+    // specified path and metadata, or nullopt if no route matches.
+    absl::optional<size_t> GetRouteForRequest(
+        absl::string_view path, grpc_metadata_batch* initial_metadata) const;
+
+    // Returns true if the routes for path are in the calling CPU's shard
+    // of the path cache.
+    bool TestOnlyIsPathCached(absl::string_view path) const;
+
+   private:
+    // Sorted route indexes.
+    using RouteList = absl::InlinedVector<uint32_t, 8>;
+
+    // A byte-wise trie of exact and prefix path matchers.
+    class PathTrie {
+     public:
+      PathTrie() : nodes_(1) {}
+
+      bool empty() const { return nodes_.size() == 1 && nodes_[0].empty(); }
+
+      void Insert(absl::string_view key, bool is_prefix, uint32_t route);
+
+      // Appends the routes whose matcher matches path to routes.
+      void Lookup(absl::string_view path, RouteList* routes) const;
+
+     private:
+      struct Node {
+        // Sorted by byte.
+        std::vector<std::pair<char, uint32_t>> children;
+        std::vector<uint32_t> prefix_routes;
+        std::vector<uint32_t> exact_routes;
+
+        bool empty() const {
+          return children.empty() && prefix_routes.empty() &&
+                 exact_routes.empty();
+        }
+      };
+
+      std::vector<Node> nodes_;
+    };
+
+    struct Route {
+      // Index into header_names_ of each header matcher.
+      std::vector<std::pair<size_t, const HeaderMatcher*>> header_matchers;
+      absl::optional<uint32_t> fraction_per_million;
+    };
+
+    // An LRU cache of the routes whose path matchers match each path.
+    // There is one per shard of CPUs, so that calls on different CPUs do
+    // not contend for its lock.
+    class PathCache {
+     public:
+      // Sets *routes to the routes cached for path.  On a miss, computes
+      // them with table.RoutesForPath() and caches them, evicting the
+      // least recently used path if the cache is full.
+      void GetRoutes(const RouteTable& table, absl::string_view path,
+                     RouteList* routes);
+
+      bool Contains(absl::string_view path);
+
+     private:
+      struct Entry {
+        std::string path;
+        RouteList routes;
+      };
+
+      Mutex mu_;
+      // Most recently used first.
+      std::list<Entry> entries_ ABSL_GUARDED_BY(mu_);
+      // Keys point into entries_.
+      absl::flat_hash_map<absl::string_view, std::list<Entry>::iterator>
+          index_ ABSL_GUARDED_BY(mu_);
+    };
+
+    // Sets *routes to the routes whose path matchers match path.
+    void RoutesForPath(absl::string_view path, RouteList* routes) const;
+
+    std::vector<Route> routes_;
+    PathTrie case_sensitive_paths_;
+    // Keys are lower-cased.
+    PathTrie case_insensitive_paths_;
+    std::unique_ptr<RE2::Set> regex_paths_;
+    // Route index of each regex in regex_paths_.
+    std::vector<uint32_t> regex_path_routes_;
+    // Routes whose path matchers are evaluated one by one.
+    std::vector<std::pair<uint32_t, const StringMatcher*>> other_paths_;
+    std::vector<std::string> header_names_;
+
+    mutable PerCpu<PathCache> path_caches_{
+        PerCpuOptions().SetCpusPerShard(2).SetMaxShards(16)};
+  };
+
   // Returns true if \a domain_pattern is a valid domain pattern, false
   // otherwise.
   static bool IsValidDomainPattern(absl::string_view domain_pattern);
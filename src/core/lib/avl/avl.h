@@ -59,6 +59,9 @@ class AVL {
 
   bool SameIdentity(const AVL& avl) const { return root_ == avl.root_; }
 
+  // A reference to an AVL that does not keep its nodes alive.
+  class WeakRef;
+
   friend int QsortCompare(const AVL& left, const AVL& right) {
     if (left.root_.get() == right.root_.get()) return 0;
     Iterator a(left.root_);
@@ -318,6 +321,27 @@ class AVL {
   }
 };
 
+template <class K, class V>
+class AVL<K, V>::WeakRef {
+ public:
+  WeakRef() = default;
+  explicit WeakRef(const AVL& avl) : root_(avl.root_) {}
+
+  // If the tree is still alive, sets *avl to it and returns true.  This is
+  // never the case for a WeakRef to an empty tree.
+  bool Lock(AVL* avl) const {
+    NodePtr root = root_.lock();
+    if (root == nullptr) return false;
+    *avl = AVL(std::move(root));
+    return true;
+  }
+
+  bool expired() const { return root_.expired(); }
+
+ private:
+  std::weak_ptr<Node> root_;
+};
+
 template <class K>
 class AVL<K, void> {
  public:
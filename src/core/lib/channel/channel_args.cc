@@ -29,6 +29,9 @@
 #include <map>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -41,6 +44,7 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/crash.h"
 #include "src/core/lib/gprpp/match.h"
+#include "src/core/lib/gprpp/sync.h"
 
 namespace grpc_core {
 
@@ -88,6 +92,7 @@ bool ChannelArgs::operator<(const ChannelArgs& other) const {
 }
 
 bool ChannelArgs::operator==(const ChannelArgs& other) const {
+  if (interned_ && other.interned_) return args_.SameIdentity(other.args_);
   return args_ == other.args_;
 }
 
@@ -102,6 +107,105 @@ bool ChannelArgs::WantMinimalStack() const {
 ChannelArgs::ChannelArgs(AVL<std::string, Value> args)
     : args_(std::move(args)) {}
 
+namespace {
+
+// The table behind ChannelArgs::Intern(): the trees of interned args, keyed
+// by hash.  It only holds weak references, so interned args are destroyed
+// as usual once nothing else refers to them; expired entries are dropped
+// when their bucket is next visited, and by a sweep of the whole shard
+// whenever it has doubled in size since the last one.  Sharded by hash to
+// keep contention between channels low.
+class ChannelArgsInternTable {
+ public:
+  using Tree = AVL<std::string, ChannelArgs::Value>;
+
+  static ChannelArgsInternTable* Get() {
+    static ChannelArgsInternTable* table = new ChannelArgsInternTable();
+    return table;
+  }
+
+  // Returns the live interned tree equal to args, if there is one, or else
+  // interns args and returns it.
+  Tree Intern(const Tree& args, size_t hash) {
+    Shard& shard = shards_[hash % kNumShards];
+    MutexLock lock(&shard.mu);
+    std::vector<Tree::WeakRef>& bucket = shard.buckets[hash];
+    Tree existing;
+    for (auto it = bucket.begin(); it != bucket.end();) {
+      if (!it->Lock(&existing)) {
+        it = bucket.erase(it);
+        --shard.size;
+      } else if (existing == args) {
+        return existing;
+      } else {
+        ++it;
+      }
+    }
+    bucket.emplace_back(args);
+    if (++shard.size > shard.sweep_threshold) {
+      SweepLocked(&shard);
+      shard.sweep_threshold = std::max(kMinSweepThreshold, 2 * shard.size);
+    }
+    return args;
+  }
+
+ private:
+  static constexpr size_t kNumShards = 16;
+  static constexpr size_t kMinSweepThreshold = 64;
+
+  struct Shard {
+    Mutex mu;
+    absl::flat_hash_map<size_t, std::vector<Tree::WeakRef>> buckets
+        ABSL_GUARDED_BY(mu);
+    size_t size ABSL_GUARDED_BY(mu) = 0;
+    size_t sweep_threshold ABSL_GUARDED_BY(mu) = kMinSweepThreshold;
+  };
+
+  static void SweepLocked(Shard* shard) ABSL_EXCLUSIVE_LOCKS_REQUIRED(
+      shard->mu) {
+    for (auto it = shard->buckets.begin(); it != shard->buckets.end();) {
+      std::vector<Tree::WeakRef>& bucket = it->second;
+      const size_t size = bucket.size();
+      bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                                  [](const Tree::WeakRef& ref) {
+                                    return ref.expired();
+                                  }),
+                   bucket.end());
+      shard->size -= size - bucket.size();
+      if (bucket.empty()) {
+        shard->buckets.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  Shard shards_[kNumShards];
+};
+
+}  // namespace
+
+ChannelArgs ChannelArgs::Intern() const {
+  if (interned_) return *this;
+  const size_t hash = Hash();
+  // There is only one empty tree, so empty args need no table entry.
+  ChannelArgs result(
+      args_.Empty() ? args_
+                    : ChannelArgsInternTable::Get()->Intern(args_, hash));
+  result.hash_ = hash;
+  result.interned_ = true;
+  return result;
+}
+
+size_t ChannelArgs::Hash() const {
+  if (interned_) return hash_;
+  size_t hash = 0;
+  args_.ForEach([&hash](const std::string& key, const Value& value) {
+    hash = absl::HashOf(hash, key, value.Hash());
+  });
+  return hash;
+}
+
 ChannelArgs ChannelArgs::Set(grpc_arg arg) const {
   switch (arg.type) {
     case GRPC_ARG_INTEGER:
@@ -172,6 +276,23 @@ bool ChannelArgs::Value::operator==(const Value& rhs) const {
   }
 }
 
+size_t ChannelArgs::Value::Hash() const {
+  switch (rep_.index()) {
+    case 0:
+      return absl::HashOf(rep_.index(), absl::get<int>(rep_));
+    case 1:
+      return absl::HashOf(
+          rep_.index(), *absl::get<std::shared_ptr<const std::string>>(rep_));
+    case 2:
+      // Pointers are compared with their vtable's cmp(), which may find
+      // distinct pointers equal, so neither the pointer nor its vtable can
+      // be hashed.
+      return absl::HashOf(rep_.index());
+    default:
+      Crash("unreachable");
+  }
+}
+
 ChannelArgs::CPtr ChannelArgs::ToC() const {
   std::vector<grpc_arg> c_args;
   args_.ForEach([&c_args](const std::string& key, const Value& value) {
@@ -303,27 +424,29 @@ ChannelArgs ChannelArgs::UnionWith(ChannelArgs other) const {
   if (args_.Empty()) return other;
   if (other.args_.Empty()) return *this;
   if (args_.Height() <= other.args_.Height()) {
-    args_.ForEach([&other](const std::string& key, const Value& value) {
-      other.args_ = other.args_.Add(key, value);
+    AVL<std::string, Value> result = std::move(other.args_);
+    args_.ForEach([&result](const std::string& key, const Value& value) {
+      result = result.Add(key, value);
     });
-    return other;
+    return ChannelArgs(std::move(result));
   } else {
-    auto result = *this;
+    AVL<std::string, Value> result = args_;
     other.args_.ForEach([&result](const std::string& key, const Value& value) {
-      if (result.args_.Lookup(key) == nullptr) {
-        result.args_ = result.args_.Add(key, value);
+      if (result.Lookup(key) == nullptr) {
+        result = result.Add(key, value);
       }
     });
-    return result;
+    return ChannelArgs(std::move(result));
   }
 }
 
 ChannelArgs ChannelArgs::FuzzingReferenceUnionWith(ChannelArgs other) const {
   // DO NOT OPTIMIZE THIS!!
-  args_.ForEach([&other](const std::string& key, const Value& value) {
-    other.args_ = other.args_.Add(key, value);
+  AVL<std::string, Value> result = std::move(other.args_);
+  args_.ForEach([&result](const std::string& key, const Value& value) {
+    result = result.Add(key, value);
   });
-  return other;
+  return ChannelArgs(std::move(result));
 }
 
 void ChannelArgs::ChannelArgsDeleter::operator()(
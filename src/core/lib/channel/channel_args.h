@@ -307,6 +307,9 @@ class ChannelArgs {
       return **p == rhs;
     }
 
+    // Consistent with operator==.
+    size_t Hash() const;
+
    private:
     absl::variant<int, std::shared_ptr<const std::string>, Pointer> rep_;
   };
@@ -452,6 +455,24 @@ class ChannelArgs {
         reason);
   }
 
+  // Returns a ChannelArgs equal to this one that shares its representation
+  // with every other live interned ChannelArgs holding the same args, and
+  // caches their hash.  Two interned ChannelArgs compare equal iff they are
+  // the same tree, so operator== on them is a pointer comparison.
+  // Interning hashes every arg and takes a lock on a global table, so it is
+  // meant for args that are kept around and compared often (such as
+  // subchannel keys), not for every intermediate ChannelArgs.  Set() and
+  // friends return args that are not interned.
+  GRPC_MUST_USE_RESULT ChannelArgs Intern() const;
+  bool is_interned() const { return interned_; }
+
+  // Consistent with operator==.  O(1) for interned args.
+  size_t Hash() const;
+  template <typename H>
+  friend H AbslHashValue(H h, const ChannelArgs& args) {
+    return H::combine(std::move(h), args.Hash());
+  }
+
   bool operator!=(const ChannelArgs& other) const;
   bool operator<(const ChannelArgs& other) const;
   bool operator==(const ChannelArgs& other) const;
@@ -468,6 +489,9 @@ class ChannelArgs {
                                        Value value) const;
 
   AVL<std::string, Value> args_;
+  // Set by Intern().
+  size_t hash_ = 0;
+  bool interned_ = false;
 };
 
 std::ostream& operator<<(std::ostream& out, const ChannelArgs& args);
@@ -24,6 +24,7 @@
 #include <atomic>
 #include <cstdint>
 
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
@@ -152,6 +153,30 @@ void PerCpuCallCountingHelper::PopulateCallCounts(Json::Object* json) {
   }
 }
 
+//
+// slow calls
+//
+
+namespace {
+
+Json RenderSlowCallsJson(const CallFlightRecorder& recorder) {
+  Json::Array array;
+  for (const CallFlightRecorder::SlowCall& slow_call : recorder.SlowCalls()) {
+    array.emplace_back(Json::FromObject({
+        {"method", Json::FromString(slow_call.method)},
+        {"status", Json::FromString(absl::StatusCodeToString(
+                       static_cast<absl::StatusCode>(slow_call.status)))},
+        {"latency", Json::FromString(slow_call.latency.ToJsonString())},
+        {"timeline", Json::FromString(slow_call.timeline)},
+    }));
+  }
+  Json::Object object;
+  if (!array.empty()) object["slowCall"] = Json::FromArray(std::move(array));
+  return Json::FromObject(std::move(object));
+}
+
+}  // namespace
+
 //
 // ChannelNode
 //
@@ -263,6 +288,10 @@ void ChannelNode::RemoveChildSubchannel(intptr_t child_uuid) {
   child_subchannels_.erase(child_uuid);
 }
 
+Json ChannelNode::RenderSlowCalls() const {
+  return RenderSlowCallsJson(slow_calls_);
+}
+
 //
 // ServerNode
 //
@@ -353,6 +382,10 @@ Json ServerNode::RenderJson() {
   return Json::FromObject(std::move(object));
 }
 
+Json ServerNode::RenderSlowCalls() const {
+  return RenderSlowCallsJson(slow_calls_);
+}
+
 //
 // SocketNode::Security::Tls
 //
@@ -478,11 +511,13 @@ void PopulateSocketAddressJson(Json::Object* json, const char* name,
 }  // namespace
 
 SocketNode::SocketNode(std::string local, std::string remote, std::string name,
-                       RefCountedPtr<Security> security)
+                       RefCountedPtr<Security> security,
+                       RefCountedPtr<TransportData> transport_data)
     : BaseNode(EntityType::kSocket, std::move(name)),
       local_(std::move(local)),
       remote_(std::move(remote)),
-      security_(std::move(security)) {}
+      security_(std::move(security)),
+      transport_data_(std::move(transport_data)) {}
 
 void SocketNode::RecordStreamStartedFromLocal() {
   streams_started_.fetch_add(1, std::memory_order_relaxed);
@@ -570,6 +605,7 @@ Json SocketNode::RenderJson() {
   if (keepalives_sent != 0) {
     data["keepAlivesSent"] = Json::FromString(absl::StrCat(keepalives_sent));
   }
+  if (transport_data_ != nullptr) transport_data_->PopulateSocketData(&data);
   // Create and fill the parent object.
   Json::Object object = {
       {"ref", Json::FromObject({
@@ -38,6 +38,7 @@
 #include <grpc/slice.h>
 
 #include "src/core/lib/channel/channel_trace.h"
+#include "src/core/lib/debug/call_timeline.h"
 #include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/per_cpu.h"
@@ -212,6 +213,13 @@ class ChannelNode : public BaseNode {
   void RecordCallFailed() { call_counter_.RecordCallFailed(); }
   void RecordCallSucceeded() { call_counter_.RecordCallSucceeded(); }
 
+  // Slow sampled calls are kept apart from the trace, so that they cannot
+  // push out its events.
+  void AddSlowCall(CallFlightRecorder::SlowCall slow_call) {
+    slow_calls_.Add(std::move(slow_call));
+  }
+  Json RenderSlowCalls() const;
+
   void SetConnectivityState(grpc_connectivity_state state);
 
   // TODO(roth): take in a RefCountedPtr to the child channel so we can retrieve
@@ -233,6 +241,7 @@ class ChannelNode : public BaseNode {
   std::string target_;
   CallCountingHelper call_counter_;
   ChannelTrace trace_;
+  CallFlightRecorder slow_calls_;
 
   // Least significant bit indicates whether the value is set.  Remaining
   // bits are a grpc_connectivity_state value.
@@ -277,9 +286,17 @@ class ServerNode : public BaseNode {
   void RecordCallFailed() { call_counter_.RecordCallFailed(); }
   void RecordCallSucceeded() { call_counter_.RecordCallSucceeded(); }
 
+  // Slow sampled calls are kept apart from the trace, so that they cannot
+  // push out its events.
+  void AddSlowCall(CallFlightRecorder::SlowCall slow_call) {
+    slow_calls_.Add(std::move(slow_call));
+  }
+  Json RenderSlowCalls() const;
+
  private:
   PerCpuCallCountingHelper call_counter_;
   ChannelTrace trace_;
+  CallFlightRecorder slow_calls_;
   Mutex child_mu_;  // Guards child maps below.
   std::map<intptr_t, RefCountedPtr<SocketNode>> child_sockets_;
   std::map<intptr_t, RefCountedPtr<ListenSocketNode>> child_listen_sockets_;
@@ -325,8 +342,17 @@ class SocketNode : public BaseNode {
         const grpc_channel_args* args);
   };
 
+  // State kept by the transport that is rendered as part of the socket's
+  // data, e.g. flow control windows and transport-specific options.
+  class TransportData : public RefCounted<TransportData> {
+   public:
+    // Adds fields to the SocketData object.  May be called from any thread.
+    virtual void PopulateSocketData(Json::Object* data) = 0;
+  };
+
   SocketNode(std::string local, std::string remote, std::string name,
-             RefCountedPtr<Security> security);
+             RefCountedPtr<Security> security,
+             RefCountedPtr<TransportData> transport_data = nullptr);
   ~SocketNode() override {}
 
   Json RenderJson() override;
@@ -361,6 +387,7 @@ class SocketNode : public BaseNode {
   std::string local_;
   std::string remote_;
   RefCountedPtr<Security> const security_;
+  RefCountedPtr<TransportData> const transport_data_;
 };
 
 // Handles channelz bookkeeping for listen sockets
@@ -41,7 +41,7 @@ namespace grpc_core {
 namespace channelz {
 namespace {
 
-const int kPaginationLimit = 100;
+const size_t kPaginationLimit = 100;
 
 }  // anonymous namespace
 
@@ -51,57 +51,81 @@ ChannelzRegistry* ChannelzRegistry::Default() {
 }
 
 void ChannelzRegistry::InternalRegister(BaseNode* node) {
-  MutexLock lock(&mu_);
-  node->uuid_ = ++uuid_generator_;
-  node_map_[node->uuid_] = node;
+  node->uuid_ = uuid_generator_.fetch_add(1, std::memory_order_relaxed) + 1;
+  Shard& shard = ShardFor(node->uuid_);
+  MutexLock lock(&shard.mu);
+  shard.nodes[node->uuid_] = node;
+  switch (node->type()) {
+    case BaseNode::EntityType::kTopLevelChannel:
+      shard.top_level_channels[node->uuid_] = node;
+      break;
+    case BaseNode::EntityType::kServer:
+      shard.servers[node->uuid_] = node;
+      break;
+    default:
+      break;
+  }
 }
 
 void ChannelzRegistry::InternalUnregister(intptr_t uuid) {
   GPR_ASSERT(uuid >= 1);
-  MutexLock lock(&mu_);
-  GPR_ASSERT(uuid <= uuid_generator_);
-  node_map_.erase(uuid);
+  GPR_ASSERT(uuid <= uuid_generator_.load(std::memory_order_relaxed));
+  Shard& shard = ShardFor(uuid);
+  MutexLock lock(&shard.mu);
+  shard.nodes.erase(uuid);
+  shard.top_level_channels.erase(uuid);
+  shard.servers.erase(uuid);
 }
 
 RefCountedPtr<BaseNode> ChannelzRegistry::InternalGet(intptr_t uuid) {
-  MutexLock lock(&mu_);
-  if (uuid < 1 || uuid > uuid_generator_) {
+  if (uuid < 1 || uuid > uuid_generator_.load(std::memory_order_relaxed)) {
     return nullptr;
   }
-  auto it = node_map_.find(uuid);
-  if (it == node_map_.end()) return nullptr;
+  Shard& shard = ShardFor(uuid);
+  MutexLock lock(&shard.mu);
+  auto it = shard.nodes.find(uuid);
+  if (it == shard.nodes.end()) return nullptr;
   // Found node.  Return only if its refcount is not zero (i.e., when we
   // know that there is no other thread about to destroy it).
   BaseNode* node = it->second;
   return node->RefIfNonZero();
 }
 
-std::string ChannelzRegistry::InternalGetTopChannels(
-    intptr_t start_channel_id) {
-  std::vector<RefCountedPtr<BaseNode>> top_level_channels;
-  RefCountedPtr<BaseNode> node_after_pagination_limit;
-  {
-    MutexLock lock(&mu_);
-    for (auto it = node_map_.lower_bound(start_channel_id);
-         it != node_map_.end(); ++it) {
-      BaseNode* node = it->second;
-      RefCountedPtr<BaseNode> node_ref;
-      if (node->type() == BaseNode::EntityType::kTopLevelChannel &&
-          (node_ref = node->RefIfNonZero()) != nullptr) {
-        // Check if we are over pagination limit to determine if we need to set
-        // the "end" element. If we don't go through this block, we know that
-        // when the loop terminates, we have <= to kPaginationLimit.
-        // Note that because we have already increased this node's
-        // refcount, we need to decrease it, but we can't unref while
-        // holding the lock, because this may lead to a deadlock.
-        if (top_level_channels.size() == kPaginationLimit) {
-          node_after_pagination_limit = std::move(node_ref);
-          break;
-        }
-        top_level_channels.emplace_back(std::move(node_ref));
+std::vector<RefCountedPtr<BaseNode>> ChannelzRegistry::GetPage(
+    std::map<intptr_t, BaseNode*> Shard::*index, intptr_t start_id,
+    size_t max_results, bool* end) {
+  // The first max_results + 1 nodes overall are among the first
+  // max_results + 1 nodes of each shard.  Note that we can't drop any refs
+  // while holding a shard's lock, because this may lead to a deadlock.
+  std::vector<RefCountedPtr<BaseNode>> nodes;
+  for (Shard& shard : shards_) {
+    MutexLock lock(&shard.mu);
+    const std::map<intptr_t, BaseNode*>& map = shard.*index;
+    size_t taken = 0;
+    for (auto it = map.lower_bound(start_id);
+         it != map.end() && taken <= max_results; ++it) {
+      RefCountedPtr<BaseNode> node = it->second->RefIfNonZero();
+      if (node != nullptr) {
+        nodes.emplace_back(std::move(node));
+        ++taken;
       }
     }
   }
+  std::sort(nodes.begin(), nodes.end(),
+            [](const RefCountedPtr<BaseNode>& a,
+               const RefCountedPtr<BaseNode>& b) {
+              return a->uuid() < b->uuid();
+            });
+  *end = nodes.size() <= max_results;
+  if (!*end) nodes.resize(max_results);
+  return nodes;
+}
+
+std::string ChannelzRegistry::InternalGetTopChannels(
+    intptr_t start_channel_id) {
+  bool end;
+  std::vector<RefCountedPtr<BaseNode>> top_level_channels = GetPage(
+      &Shard::top_level_channels, start_channel_id, kPaginationLimit, &end);
   Json::Object object;
   if (!top_level_channels.empty()) {
     // Create list of channels.
@@ -111,37 +135,16 @@ std::string ChannelzRegistry::InternalGetTopChannels(
     }
     object["channel"] = Json::FromArray(std::move(array));
   }
-  if (node_after_pagination_limit == nullptr) {
+  if (end) {
     object["end"] = Json::FromBool(true);
   }
   return JsonDump(Json::FromObject(std::move(object)));
 }
 
 std::string ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
-  std::vector<RefCountedPtr<BaseNode>> servers;
-  RefCountedPtr<BaseNode> node_after_pagination_limit;
-  {
-    MutexLock lock(&mu_);
-    for (auto it = node_map_.lower_bound(start_server_id);
-         it != node_map_.end(); ++it) {
-      BaseNode* node = it->second;
-      RefCountedPtr<BaseNode> node_ref;
-      if (node->type() == BaseNode::EntityType::kServer &&
-          (node_ref = node->RefIfNonZero()) != nullptr) {
-        // Check if we are over pagination limit to determine if we need to set
-        // the "end" element. If we don't go through this block, we know that
-        // when the loop terminates, we have <= to kPaginationLimit.
-        // Note that because we have already increased this node's
-        // refcount, we need to decrease it, but we can't unref while
-        // holding the lock, because this may lead to a deadlock.
-        if (servers.size() == kPaginationLimit) {
-          node_after_pagination_limit = std::move(node_ref);
-          break;
-        }
-        servers.emplace_back(std::move(node_ref));
-      }
-    }
-  }
+  bool end;
+  std::vector<RefCountedPtr<BaseNode>> servers =
+      GetPage(&Shard::servers, start_server_id, kPaginationLimit, &end);
   Json::Object object;
   if (!servers.empty()) {
     // Create list of servers.
@@ -151,7 +154,7 @@ std::string ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
     }
     object["server"] = Json::FromArray(std::move(array));
   }
-  if (node_after_pagination_limit == nullptr) {
+  if (end) {
     object["end"] = Json::FromBool(true);
   }
   return JsonDump(Json::FromObject(std::move(object)));
@@ -159,21 +162,36 @@ std::string ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
 
 void ChannelzRegistry::InternalLogAllEntities() {
   std::vector<RefCountedPtr<BaseNode>> nodes;
-  {
-    MutexLock lock(&mu_);
-    for (auto& p : node_map_) {
+  for (Shard& shard : shards_) {
+    MutexLock lock(&shard.mu);
+    for (auto& p : shard.nodes) {
       RefCountedPtr<BaseNode> node = p.second->RefIfNonZero();
       if (node != nullptr) {
         nodes.emplace_back(std::move(node));
       }
     }
   }
+  std::sort(nodes.begin(), nodes.end(),
+            [](const RefCountedPtr<BaseNode>& a,
+               const RefCountedPtr<BaseNode>& b) {
+              return a->uuid() < b->uuid();
+            });
   for (size_t i = 0; i < nodes.size(); ++i) {
     std::string json = nodes[i]->RenderJsonString();
     gpr_log(GPR_INFO, "%s", json.c_str());
   }
 }
 
+void ChannelzRegistry::InternalTestOnlyReset() {
+  for (Shard& shard : shards_) {
+    MutexLock lock(&shard.mu);
+    shard.nodes.clear();
+    shard.top_level_channels.clear();
+    shard.servers.clear();
+  }
+  uuid_generator_.store(0, std::memory_order_relaxed);
+}
+
 }  // namespace channelz
 }  // namespace grpc_core
 
@@ -279,3 +297,28 @@ char* grpc_channelz_get_socket(intptr_t socket_id) {
   });
   return gpr_strdup(grpc_core::JsonDump(json).c_str());
 }
+
+char* grpc_channelz_get_slow_calls(intptr_t channelz_id) {
+  grpc_core::ApplicationCallbackExecCtx callback_exec_ctx;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::RefCountedPtr<grpc_core::channelz::BaseNode> node =
+      grpc_core::channelz::ChannelzRegistry::Get(channelz_id);
+  if (node == nullptr) return nullptr;
+  grpc_core::Json json;
+  switch (node->type()) {
+    case grpc_core::channelz::BaseNode::EntityType::kTopLevelChannel:
+    case grpc_core::channelz::BaseNode::EntityType::kInternalChannel:
+      // This cast is ok since we have just checked to make sure node is
+      // actually a channel node.
+      json = static_cast<grpc_core::channelz::ChannelNode*>(node.get())
+                 ->RenderSlowCalls();
+      break;
+    case grpc_core::channelz::BaseNode::EntityType::kServer:
+      json = static_cast<grpc_core::channelz::ServerNode*>(node.get())
+                 ->RenderSlowCalls();
+      break;
+    default:
+      return nullptr;
+  }
+  return gpr_strdup(grpc_core::JsonDump(json).c_str());
+}
@@ -21,9 +21,17 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -34,6 +42,11 @@ namespace channelz {
 
 // singleton registry object to track all objects that are needed to support
 // channelz bookkeeping. All objects share globally distributed uuids.
+//
+// Nodes are spread over shards by uuid, so that registration of sockets and
+// subchannels on different threads rarely contends, and so that queries
+// only ever hold one shard's lock, briefly, while taking refs to the nodes
+// they need.  Nodes are rendered to JSON without any lock held.
 class ChannelzRegistry {
  public:
   static void Register(BaseNode* node) {
@@ -61,14 +74,28 @@ class ChannelzRegistry {
   static void LogAllEntities() { Default()->InternalLogAllEntities(); }
 
   // Test only helper function to reset to initial state.
-  static void TestOnlyReset() {
-    auto* p = Default();
-    MutexLock lock(&p->mu_);
-    p->node_map_.clear();
-    p->uuid_generator_ = 0;
-  }
+  static void TestOnlyReset() { Default()->InternalTestOnlyReset(); }
 
  private:
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    Mutex mu;
+    absl::flat_hash_map<intptr_t, BaseNode*> nodes ABSL_GUARDED_BY(mu);
+    // Top-level channels and servers, ordered for pagination.  With many
+    // sockets and subchannels, these are a small fraction of all nodes.
+    std::map<intptr_t, BaseNode*> top_level_channels ABSL_GUARDED_BY(mu);
+    std::map<intptr_t, BaseNode*> servers ABSL_GUARDED_BY(mu);
+  };
+
+  Shard& ShardFor(intptr_t uuid) { return shards_[uuid % kNumShards]; }
+
+  // Returns refs to up to max_results nodes of the given type with uuids
+  // of at least start_id, in uuid order.  Sets *end if there are no more.
+  std::vector<RefCountedPtr<BaseNode>> GetPage(
+      std::map<intptr_t, BaseNode*> Shard::*index, intptr_t start_id,
+      size_t max_results, bool* end);
+
   // Returned the singleton instance of ChannelzRegistry;
   static ChannelzRegistry* Default();
 
@@ -88,10 +115,10 @@ class ChannelzRegistry {
 
   void InternalLogAllEntities();
 
-  // protects members
-  Mutex mu_;
-  std::map<intptr_t, BaseNode*> node_map_;
-  intptr_t uuid_generator_ = 0;
+  void InternalTestOnlyReset();
+
+  std::atomic<intptr_t> uuid_generator_{0};
+  std::array<Shard, kNumShards> shards_;
 };
 
 }  // namespace channelz
@@ -56,6 +56,9 @@ typedef enum {
   /// the server.
   GRPC_CONTEXT_BACKEND_METRIC_PROVIDER,
 
+  /// Value is a CallTimeline, if the call is sampled by the flight recorder.
+  GRPC_CONTEXT_CALL_TIMELINE,
+
   GRPC_CONTEXT_COUNT
 } grpc_context_index;
 
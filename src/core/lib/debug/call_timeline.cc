@@ -0,0 +1,177 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/debug/call_timeline.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+
+#include <grpc/impl/grpc_types.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/no_destruct.h"
+
+namespace grpc_core {
+
+namespace {
+
+thread_local uint32_t g_calls_until_sample = 0;
+
+double MicrosBetween(gpr_cycle_counter start, gpr_cycle_counter end) {
+  return gpr_timespec_to_micros(gpr_cycle_counter_sub(end, start));
+}
+
+}  // namespace
+
+absl::string_view CallPhaseName(CallPhase phase) {
+  switch (phase) {
+    case CallPhase::kNone:
+      return "none";
+    case CallPhase::kArenaCreated:
+      return "arena_created";
+    case CallPhase::kCallStackInit:
+      return "call_stack_init";
+    case CallPhase::kLbPickQueued:
+      return "lb_pick_queued";
+    case CallPhase::kLbPickComplete:
+      return "lb_pick_complete";
+    case CallPhase::kTransportOp:
+      return "transport_op";
+    case CallPhase::kHpackEncode:
+      return "hpack_encode";
+    case CallPhase::kFlowControlStall:
+      return "flow_control_stall";
+    case CallPhase::kWrite:
+      return "write";
+    case CallPhase::kRead:
+      return "read";
+    case CallPhase::kDecode:
+      return "decode";
+    case CallPhase::kEnd:
+      return "end";
+  }
+  return "unknown";
+}
+
+//
+// CallTimelineOptions
+//
+
+CallTimelineOptions CallTimelineOptions::FromChannelArgs(
+    const ChannelArgs& args) {
+  CallTimelineOptions options;
+  options.sample_rate = static_cast<uint32_t>(
+      std::max(0, args.GetInt(GRPC_ARG_CALL_TIMELINE_SAMPLE_RATE)
+                      .value_or(static_cast<int>(options.sample_rate))));
+  options.slow_call_threshold = Duration::Milliseconds(
+      std::max(0, args.GetInt(GRPC_ARG_SLOW_CALL_THRESHOLD_MS)
+                      .value_or(static_cast<int>(
+                          options.slow_call_threshold.millis()))));
+  return options;
+}
+
+//
+// CallTimeline
+//
+
+bool CallTimeline::ShouldSample(uint32_t sample_rate) {
+  if (sample_rate == 0) return false;
+  // A count left over from a channel with a higher rate is reset.
+  if (g_calls_until_sample > 0 && g_calls_until_sample < sample_rate) {
+    --g_calls_until_sample;
+    return false;
+  }
+  g_calls_until_sample = sample_rate - 1;
+  return true;
+}
+
+void CallTimeline::Record(CallPhase phase) {
+  const gpr_cycle_counter now = gpr_get_cycle_counter();
+  Event& event =
+      events_[num_events_.fetch_add(1, std::memory_order_relaxed) %
+              kMaxEvents];
+  event.when.store(now, std::memory_order_relaxed);
+  event.phase.store(phase, std::memory_order_release);
+}
+
+Duration CallTimeline::Elapsed() const {
+  return Duration::MicrosecondsRoundDown(
+      static_cast<int64_t>(MicrosBetween(start_, gpr_get_cycle_counter())));
+}
+
+std::string CallTimeline::ToString() const {
+  const size_t num_events = num_events_.load(std::memory_order_relaxed);
+  const size_t first = num_events > kMaxEvents ? num_events - kMaxEvents : 0;
+  std::string result;
+  if (first > 0) absl::StrAppend(&result, "(", first, " events dropped)");
+  for (size_t i = first; i < num_events; ++i) {
+    const Event& event = events_[i % kMaxEvents];
+    const CallPhase phase = event.phase.load(std::memory_order_acquire);
+    // Still being written.
+    if (phase == CallPhase::kNone) continue;
+    absl::StrAppendFormat(
+        &result, "%s%s +%.0fus", result.empty() ? "" : " ",
+        CallPhaseName(phase),
+        MicrosBetween(start_, event.when.load(std::memory_order_relaxed)));
+  }
+  return result;
+}
+
+//
+// CallFlightRecorder
+//
+
+std::string CallFlightRecorder::SlowCall::ToString() const {
+  return absl::StrCat(
+      "slow call ", method, " (",
+      absl::StatusCodeToString(static_cast<absl::StatusCode>(status)), ", ",
+      latency.ToString(), "): ", timeline);
+}
+
+CallFlightRecorder& CallFlightRecorder::Get() {
+  return *NoDestructSingleton<CallFlightRecorder>::Get();
+}
+
+absl::optional<CallFlightRecorder::SlowCall> CallFlightRecorder::OnCallEnd(
+    const CallTimeline& timeline, grpc_status_code status,
+    Duration threshold) {
+  const Duration latency = timeline.Elapsed();
+  if (latency < threshold) return absl::nullopt;
+  SlowCall slow_call{std::string(timeline.method()), status, latency,
+                     timeline.ToString()};
+  Add(slow_call);
+  return slow_call;
+}
+
+void CallFlightRecorder::Add(SlowCall slow_call) {
+  MutexLock lock(&mu_);
+  if (slow_calls_.size() == kMaxSlowCalls) slow_calls_.pop_front();
+  slow_calls_.push_back(std::move(slow_call));
+}
+
+std::vector<CallFlightRecorder::SlowCall> CallFlightRecorder::SlowCalls()
+    const {
+  MutexLock lock(&mu_);
+  return std::vector<SlowCall>(slow_calls_.begin(), slow_calls_.end());
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,202 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_LIB_DEBUG_CALL_TIMELINE_H
+#define GRPC_SRC_CORE_LIB_DEBUG_CALL_TIMELINE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/status.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/slice/slice.h"
+
+// A flight recorder for the phases of individual calls.
+//
+// One in every N calls (per thread) gets a CallTimeline, allocated in its
+// arena and stored in its context.  The call path records cycle counter
+// timestamps for the phases the call goes through; for calls that are not
+// sampled, recording costs a load and a branch.  When a sampled unary call
+// takes longer than a threshold, its timeline is kept by the process-wide
+// CallFlightRecorder and by the one of its channelz channel or server.
+// Streaming calls are never kept: they live as long as the application keeps
+// them open, so their lifetime says nothing about how slow they were.
+
+namespace grpc_core {
+
+enum class CallPhase : uint8_t {
+  kNone,
+  // The call's arena and call object were created.
+  kArenaCreated,
+  // The call's filter stack was initialized.
+  kCallStackInit,
+  // The client's LB pick was queued (e.g. waiting for a subchannel to
+  // connect).
+  kLbPickQueued,
+  // The client's LB pick completed.
+  kLbPickComplete,
+  // The transport got the call's initial metadata.
+  kTransportOp,
+  // The transport HPACK-encoded a header frame of the call.
+  kHpackEncode,
+  // The call's stream ran out of flow control window.
+  kFlowControlStall,
+  // A write containing data of the call finished.
+  kWrite,
+  // The transport read a frame of the call.
+  kRead,
+  // The transport decoded a header block or a message of the call.
+  kDecode,
+  // The call was destroyed.
+  kEnd,
+};
+
+absl::string_view CallPhaseName(CallPhase phase);
+
+struct CallTimelineOptions {
+  static constexpr uint32_t kDefaultSampleRate = 1000;
+  static constexpr Duration kDefaultSlowCallThreshold = Duration::Seconds(1);
+
+  // One in sample_rate calls is sampled; 0 disables sampling.
+  uint32_t sample_rate = kDefaultSampleRate;
+  // Sampled unary calls that take at least this long are kept as slow
+  // calls.
+  Duration slow_call_threshold = kDefaultSlowCallThreshold;
+
+  static CallTimelineOptions FromChannelArgs(const ChannelArgs& args);
+};
+
+class CallTimeline {
+ public:
+  // The timeline keeps the last kMaxEvents phases of a call.
+  static constexpr size_t kMaxEvents = 64;
+
+  explicit CallTimeline(gpr_cycle_counter start) : start_(start) {}
+
+  CallTimeline(const CallTimeline&) = delete;
+  CallTimeline& operator=(const CallTimeline&) = delete;
+
+  // Returns true if the next call created on this thread should be sampled.
+  static bool ShouldSample(uint32_t sample_rate);
+
+  // Records a phase in the timeline of the call owning a context array, if
+  // the call is sampled.
+  static void Record(const grpc_call_context_element* context,
+                     CallPhase phase) {
+    if (context == nullptr) return;
+    auto* timeline =
+        static_cast<CallTimeline*>(context[GRPC_CONTEXT_CALL_TIMELINE].value);
+    if (GPR_LIKELY(timeline == nullptr)) return;
+    timeline->Record(phase);
+  }
+
+  // Records a phase.  Thread-safe.
+  void Record(CallPhase phase);
+
+  // Counts the send and receive message ops started on the call.
+  void CountSendMessage() {
+    messages_sent_.fetch_add(1, std::memory_order_relaxed);
+  }
+  void CountRecvMessage() {
+    messages_received_.fetch_add(1, std::memory_order_relaxed);
+  }
+  // True if more than one message was sent or received.
+  bool is_streaming() const {
+    return messages_sent_.load(std::memory_order_relaxed) > 1 ||
+           messages_received_.load(std::memory_order_relaxed) > 1;
+  }
+
+  void set_method(Slice method) { method_ = std::move(method); }
+  absl::string_view method() const { return method_.as_string_view(); }
+
+  // Time since the start of the call.
+  Duration Elapsed() const;
+
+  // Returns e.g. "arena_created +0us call_stack_init +12us ... end +803us".
+  std::string ToString() const;
+
+ private:
+  struct Event {
+    std::atomic<CallPhase> phase{CallPhase::kNone};
+    std::atomic<gpr_cycle_counter> when{};
+  };
+
+  const gpr_cycle_counter start_;
+  Slice method_;
+  std::atomic<uint32_t> messages_sent_{0};
+  std::atomic<uint32_t> messages_received_{0};
+  std::atomic<size_t> num_events_{0};
+  Event events_[kMaxEvents];
+};
+
+// Keeps the timelines of the last few slow calls, either of the whole process
+// (Get()) or of a channelz channel or server.
+class CallFlightRecorder {
+ public:
+  static constexpr size_t kMaxSlowCalls = 64;
+
+  struct SlowCall {
+    std::string method;
+    grpc_status_code status;
+    Duration latency;
+    std::string timeline;
+
+    std::string ToString() const;
+  };
+
+  CallFlightRecorder() = default;
+  CallFlightRecorder(const CallFlightRecorder&) = delete;
+  CallFlightRecorder& operator=(const CallFlightRecorder&) = delete;
+
+  static CallFlightRecorder& Get();
+
+  // Called when a sampled call ends.  If the call took at least
+  // threshold, keeps its timeline and returns it.
+  absl::optional<SlowCall> OnCallEnd(const CallTimeline& timeline,
+                                     grpc_status_code status,
+                                     Duration threshold);
+
+  // Keeps a slow call, dropping the oldest one if kMaxSlowCalls are kept.
+  void Add(SlowCall slow_call);
+
+  // Returns the kept slow calls, oldest first.
+  std::vector<SlowCall> SlowCalls() const;
+
+ private:
+  mutable Mutex mu_;
+  std::deque<SlowCall> slow_calls_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_LIB_DEBUG_CALL_TIMELINE_H
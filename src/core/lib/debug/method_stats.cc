@@ -0,0 +1,279 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/debug/method_stats.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <tuple>
+
+#include "src/core/lib/gprpp/no_destruct.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Values below 2^kSubBucketBits get a bucket each; every power of two
+// above that is split into 2^kSubBucketBits buckets.
+constexpr int kSubBucketBits = 2;
+constexpr int kSubBuckets = 1 << kSubBucketBits;
+// Values at or above 2^kMaxValueBits land in the last bucket.
+constexpr int kMaxValueBits = 30;
+static_assert(MethodStatsHistogram::kBuckets ==
+                  kSubBuckets + (kMaxValueBits - kSubBucketBits) * kSubBuckets,
+              "MethodStatsHistogram::kBuckets is out of date");
+
+int Log2Floor(uint32_t value) {
+  int result = 0;
+  for (int shift : {16, 8, 4, 2, 1}) {
+    if (value >= (uint32_t{1} << shift)) {
+      value >>= shift;
+      result += shift;
+    }
+  }
+  return result;
+}
+
+int ClampToInt(int64_t value) {
+  return static_cast<int>(
+      std::min<int64_t>(value, std::numeric_limits<int>::max()));
+}
+
+const char kOverflowKey[] = "*";
+
+}  // namespace
+
+//
+// MethodStatsHistogram
+//
+
+int MethodStatsHistogram::BucketFor(int value) {
+  if (value < kSubBuckets) return std::max(value, 0);
+  if (value >= (1 << kMaxValueBits)) return kBuckets - 1;
+  const int octave = Log2Floor(static_cast<uint32_t>(value)) - kSubBucketBits;
+  return kSubBuckets + octave * kSubBuckets + (value >> octave) - kSubBuckets;
+}
+
+const int* MethodStatsHistogram::BucketBoundaries() {
+  static const auto* const kBoundaries = []() {
+    auto* boundaries = new int[kBuckets + 1];
+    for (int i = 0; i < kSubBuckets; ++i) boundaries[i] = i;
+    for (int i = kSubBuckets; i <= kBuckets; ++i) {
+      const int octave = (i - kSubBuckets) / kSubBuckets;
+      const int sub_bucket = (i - kSubBuckets) % kSubBuckets;
+      boundaries[i] = (kSubBuckets + sub_bucket) << octave;
+    }
+    return boundaries;
+  }();
+  return kBoundaries;
+}
+
+MethodStatsHistogram operator-(const MethodStatsHistogram& left,
+                               const MethodStatsHistogram& right) {
+  MethodStatsHistogram result;
+  for (int i = 0; i < MethodStatsHistogram::kBuckets; i++) {
+    result.buckets_[i] = left.buckets_[i] - right.buckets_[i];
+  }
+  return result;
+}
+
+void MethodStatsHistogramCollector::Collect(
+    MethodStatsHistogram* result) const {
+  for (int i = 0; i < MethodStatsHistogram::kBuckets; i++) {
+    result->buckets_[i] += buckets_[i].load(std::memory_order_relaxed);
+  }
+}
+
+//
+// MethodStats
+//
+
+const absl::string_view MethodStats::counter_name[static_cast<int>(
+    Counter::COUNT)] = {
+    "calls",
+    "failed_calls",
+};
+const absl::string_view MethodStats::counter_doc[static_cast<int>(
+    Counter::COUNT)] = {
+    "Number of finished calls",
+    "Number of calls that finished with a non-OK status",
+};
+const absl::string_view MethodStats::histogram_name[static_cast<int>(
+    Histogram::COUNT)] = {
+    "latency_us",
+    "request_bytes",
+    "response_bytes",
+    "queue_time_us",
+};
+const absl::string_view MethodStats::histogram_doc[static_cast<int>(
+    Histogram::COUNT)] = {
+    "Microseconds from the start to the end of each call",
+    "Total size of the messages sent by the client on each call",
+    "Total size of the messages sent by the server on each call",
+    "Microseconds each server call waited for the application to request it",
+};
+
+MethodStats::MethodStats() : calls{0}, failed_calls{0} {}
+
+HistogramView MethodStats::histogram(Histogram which) const {
+  const MethodStatsHistogram* result = nullptr;
+  switch (which) {
+    case Histogram::kLatencyUs:
+      result = &latency_us;
+      break;
+    case Histogram::kRequestBytes:
+      result = &request_bytes;
+      break;
+    case Histogram::kResponseBytes:
+      result = &response_bytes;
+      break;
+    case Histogram::kQueueTimeUs:
+    case Histogram::COUNT:
+      result = &queue_time_us;
+      break;
+  }
+  return HistogramView{&MethodStatsHistogram::BucketFor,
+                       MethodStatsHistogram::BucketBoundaries(),
+                       MethodStatsHistogram::kBuckets, result->buckets()};
+}
+
+std::unique_ptr<MethodStats> MethodStats::Diff(const MethodStats& other) const {
+  auto result = std::make_unique<MethodStats>();
+  result->calls = calls - other.calls;
+  result->failed_calls = failed_calls - other.failed_calls;
+  result->latency_us = latency_us - other.latency_us;
+  result->request_bytes = request_bytes - other.request_bytes;
+  result->response_bytes = response_bytes - other.response_bytes;
+  result->queue_time_us = queue_time_us - other.queue_time_us;
+  return result;
+}
+
+//
+// MethodStatsCollector
+//
+
+std::unique_ptr<MethodStats> MethodStatsCollector::Collect() const {
+  auto result = std::make_unique<MethodStats>();
+  for (const auto& data : data_) {
+    result->calls += data.calls.load(std::memory_order_relaxed);
+    result->failed_calls += data.failed_calls.load(std::memory_order_relaxed);
+    data.latency_us.Collect(&result->latency_us);
+    data.request_bytes.Collect(&result->request_bytes);
+    data.response_bytes.Collect(&result->response_bytes);
+    data.queue_time_us.Collect(&result->queue_time_us);
+  }
+  return result;
+}
+
+void MethodStatsCollector::RecordCall(bool failed, int64_t latency_us,
+                                      int64_t request_bytes,
+                                      int64_t response_bytes) {
+  Data& data = data_.this_cpu();
+  data.calls.fetch_add(1, std::memory_order_relaxed);
+  if (failed) data.failed_calls.fetch_add(1, std::memory_order_relaxed);
+  data.latency_us.Increment(ClampToInt(latency_us));
+  data.request_bytes.Increment(ClampToInt(request_bytes));
+  data.response_bytes.Increment(ClampToInt(response_bytes));
+}
+
+void MethodStatsCollector::RecordQueueTime(int64_t queue_time_us) {
+  data_.this_cpu().queue_time_us.Increment(ClampToInt(queue_time_us));
+}
+
+//
+// MethodStatsRegistry
+//
+
+MethodStatsRegistry& MethodStatsRegistry::Get() {
+  return *NoDestructSingleton<MethodStatsRegistry>::Get();
+}
+
+MethodStatsCollector* MethodStatsRegistry::GetCollector(
+    absl::string_view target, absl::string_view method) {
+  const auto key = std::make_pair(target, method);
+  Shard& shard = shards_[KeyHash()(key) % kShards];
+  MutexLock lock(&shard.mu);
+  auto it = shard.collectors.find(key);
+  if (it != shard.collectors.end()) return it->second.get();
+  if (num_entries_.fetch_add(1, std::memory_order_relaxed) >= max_entries_) {
+    num_entries_.fetch_sub(1, std::memory_order_relaxed);
+    overflowed_.store(true, std::memory_order_relaxed);
+    return &overflow_;
+  }
+  auto& collector =
+      shard.collectors[Key(std::string(target), std::string(method))];
+  collector = std::make_unique<MethodStatsCollector>();
+  return collector.get();
+}
+
+//
+// MethodStatsCollectorCache
+//
+
+MethodStatsCollectorCache::~MethodStatsCollectorCache() {
+  for (auto& slot : slots_) delete slot.load(std::memory_order_relaxed);
+}
+
+MethodStatsCollector* MethodStatsCollectorCache::Get(
+    absl::string_view method) {
+  const size_t hash = absl::HashOf(method);
+  for (size_t i = 0; i < kSlots; ++i) {
+    std::atomic<Entry*>& slot = slots_[(hash + i) % kSlots];
+    Entry* entry = slot.load(std::memory_order_acquire);
+    if (entry == nullptr) {
+      MethodStatsCollector* collector =
+          registry_->GetCollector(target_, method);
+      // Don't let methods beyond the registry's limit (e.g. random paths
+      // sent to a server) take up the slots.
+      if (registry_->IsOverflow(collector)) return collector;
+      auto* new_entry = new Entry{std::string(method), collector};
+      if (slot.compare_exchange_strong(entry, new_entry,
+                                       std::memory_order_acq_rel,
+                                       std::memory_order_acquire)) {
+        return collector;
+      }
+      // Another thread filled the slot first; entry is now its entry.
+      delete new_entry;
+    }
+    if (entry->method == method) return entry->collector;
+  }
+  return registry_->GetCollector(target_, method);
+}
+
+std::vector<MethodStatsRegistry::Entry> MethodStatsRegistry::Collect() const {
+  std::vector<Entry> result;
+  for (const Shard& shard : shards_) {
+    MutexLock lock(&shard.mu);
+    for (const auto& p : shard.collectors) {
+      result.push_back(
+          Entry{p.first.first, p.first.second, p.second->Collect()});
+    }
+  }
+  std::sort(result.begin(), result.end(),
+            [](const Entry& a, const Entry& b) {
+              return std::tie(a.target, a.method) <
+                     std::tie(b.target, b.method);
+            });
+  if (overflowed_.load(std::memory_order_relaxed)) {
+    result.push_back(Entry{kOverflowKey, kOverflowKey, overflow_.Collect()});
+  }
+  return result;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,253 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_LIB_DEBUG_METHOD_STATS_H
+#define GRPC_SRC_CORE_LIB_DEBUG_METHOD_STATS_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/debug/histogram_view.h"
+#include "src/core/lib/gprpp/per_cpu.h"
+#include "src/core/lib/gprpp/sync.h"
+
+// Per-method call stats: latency, payload size and queueing time
+// histograms, kept for each (target, method) pair in per-cpu shards.
+//
+// These follow the layout of GlobalStats (see stats_data.h), so that a
+// MethodStats snapshot can be passed to StatsAsJson(), but their
+// histograms use log-linear (HDR-style) buckets: values below 4 have a
+// bucket each, and every power of two above that is split into 4 equal
+// buckets, so that any recorded value is within 25% of its bucket's lower
+// bound.  Values of 2^30 and above all land in the last bucket.
+
+namespace grpc_core {
+
+class MethodStatsHistogramCollector;
+class MethodStatsHistogram {
+ public:
+  static constexpr int kBuckets = 116;
+
+  static int BucketFor(int value);
+  // Returns the kBuckets + 1 bucket boundaries.
+  static const int* BucketBoundaries();
+  const uint64_t* buckets() const { return buckets_; }
+  friend MethodStatsHistogram operator-(const MethodStatsHistogram& left,
+                                        const MethodStatsHistogram& right);
+
+ private:
+  friend class MethodStatsHistogramCollector;
+  uint64_t buckets_[kBuckets]{};
+};
+class MethodStatsHistogramCollector {
+ public:
+  void Increment(int value) {
+    buckets_[MethodStatsHistogram::BucketFor(value)].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  void Collect(MethodStatsHistogram* result) const;
+
+ private:
+  std::atomic<uint64_t> buckets_[MethodStatsHistogram::kBuckets]{};
+};
+
+// A snapshot of the stats of one method.
+struct MethodStats {
+  enum class Counter { kCalls, kFailedCalls, COUNT };
+  enum class Histogram {
+    kLatencyUs,
+    kRequestBytes,
+    kResponseBytes,
+    kQueueTimeUs,
+    COUNT
+  };
+  MethodStats();
+  static const absl::string_view counter_name[static_cast<int>(Counter::COUNT)];
+  static const absl::string_view
+      histogram_name[static_cast<int>(Histogram::COUNT)];
+  static const absl::string_view counter_doc[static_cast<int>(Counter::COUNT)];
+  static const absl::string_view
+      histogram_doc[static_cast<int>(Histogram::COUNT)];
+  union {
+    struct {
+      uint64_t calls;
+      uint64_t failed_calls;
+    };
+    uint64_t counters[static_cast<int>(Counter::COUNT)];
+  };
+  MethodStatsHistogram latency_us;
+  MethodStatsHistogram request_bytes;
+  MethodStatsHistogram response_bytes;
+  MethodStatsHistogram queue_time_us;
+  HistogramView histogram(Histogram which) const;
+  std::unique_ptr<MethodStats> Diff(const MethodStats& other) const;
+};
+
+// Collects the stats of one method.
+class MethodStatsCollector {
+ public:
+  std::unique_ptr<MethodStats> Collect() const;
+  // Records a finished call.  Payload sizes are the sums of the sizes of
+  // all messages sent in each direction.
+  void RecordCall(bool failed, int64_t latency_us, int64_t request_bytes,
+                  int64_t response_bytes);
+  // Records the time a server call spent waiting for the application to
+  // request it.
+  void RecordQueueTime(int64_t queue_time_us);
+
+ private:
+  struct Data {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> failed_calls{0};
+    MethodStatsHistogramCollector latency_us;
+    MethodStatsHistogramCollector request_bytes;
+    MethodStatsHistogramCollector response_bytes;
+    MethodStatsHistogramCollector queue_time_us;
+  };
+  PerCpu<Data> data_{PerCpuOptions().SetCpusPerShard(4).SetMaxShards(4)};
+};
+
+// Maps (target, method) pairs to their collectors.
+//
+// Clients use the channel target, servers an empty one.  To bound the
+// memory used by a process that sees many distinct methods (e.g. a server
+// hit with random paths), at most max_entries pairs get collectors of
+// their own; calls to any further pair are recorded under the target and
+// method "*".  Collectors are never removed.
+class MethodStatsRegistry {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 100;
+
+  struct Entry {
+    std::string target;
+    std::string method;
+    std::unique_ptr<MethodStats> stats;
+  };
+
+  explicit MethodStatsRegistry(size_t max_entries = kDefaultMaxEntries)
+      : max_entries_(max_entries) {}
+
+  MethodStatsRegistry(const MethodStatsRegistry&) = delete;
+  MethodStatsRegistry& operator=(const MethodStatsRegistry&) = delete;
+
+  // The registry that filters record to.
+  static MethodStatsRegistry& Get();
+
+  // Returns the collector for a method, creating it if needed.  The
+  // returned collector lives as long as the registry.  This takes a lock:
+  // callers on the call path go through a MethodStatsCollectorCache.
+  MethodStatsCollector* GetCollector(absl::string_view target,
+                                     absl::string_view method);
+
+  // Whether a collector is the one shared by all pairs beyond max_entries.
+  bool IsOverflow(const MethodStatsCollector* collector) const {
+    return collector == &overflow_;
+  }
+
+  // Returns a snapshot of every collector, sorted by target and method.
+  // The "*" entry comes last, and only once the limit has been reached.
+  std::vector<Entry> Collect() const;
+
+  size_t num_entries() const {
+    return num_entries_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr size_t kShards = 31;
+
+  using Key = std::pair<std::string, std::string>;
+
+  // Allows looking up a Key by a pair of string_views without copying.
+  struct KeyHash {
+    using is_transparent = void;
+    template <typename T>
+    size_t operator()(const T& key) const {
+      return absl::HashOf(absl::string_view(key.first),
+                          absl::string_view(key.second));
+    }
+  };
+  struct KeyEq {
+    using is_transparent = void;
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+      return absl::string_view(a.first) == absl::string_view(b.first) &&
+             absl::string_view(a.second) == absl::string_view(b.second);
+    }
+  };
+
+  struct Shard {
+    mutable Mutex mu;
+    absl::flat_hash_map<Key, std::unique_ptr<MethodStatsCollector>, KeyHash,
+                        KeyEq>
+        collectors ABSL_GUARDED_BY(mu);
+  };
+
+  const size_t max_entries_;
+  std::atomic<size_t> num_entries_{0};
+  std::atomic<bool> overflowed_{false};
+  std::array<Shard, kShards> shards_;
+  MethodStatsCollector overflow_;
+};
+
+// Caches the collectors of one target's methods, for a channel or a server.
+// Once a method has been looked up, looking it up again takes no lock: the
+// cache is a fixed-size open-addressed table whose slots are only ever
+// filled, never changed.  Methods that do not fit, and methods that
+// overflowed the registry, are looked up in the registry every time.
+class MethodStatsCollectorCache {
+ public:
+  explicit MethodStatsCollectorCache(
+      std::string target,
+      MethodStatsRegistry* registry = &MethodStatsRegistry::Get())
+      : target_(std::move(target)), registry_(registry) {}
+  ~MethodStatsCollectorCache();
+
+  MethodStatsCollectorCache(const MethodStatsCollectorCache&) = delete;
+  MethodStatsCollectorCache& operator=(const MethodStatsCollectorCache&) =
+      delete;
+
+  MethodStatsCollector* Get(absl::string_view method);
+
+ private:
+  static constexpr size_t kSlots = 64;
+
+  struct Entry {
+    std::string method;
+    MethodStatsCollector* collector;
+  };
+
+  const std::string target_;
+  MethodStatsRegistry* const registry_;
+  std::atomic<Entry*> slots_[kSlots]{};
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_LIB_DEBUG_METHOD_STATS_H
@@ -27,6 +27,20 @@ union DblUint {
   uint64_t uint;
 };
 }  // namespace
+void HistogramCollector_1000000_40::Collect(
+    Histogram_1000000_40* result) const {
+  for (int i = 0; i < 40; i++) {
+    result->buckets_[i] += buckets_[i].load(std::memory_order_relaxed);
+  }
+}
+Histogram_1000000_40 operator-(const Histogram_1000000_40& left,
+                               const Histogram_1000000_40& right) {
+  Histogram_1000000_40 result;
+  for (int i = 0; i < 40; i++) {
+    result.buckets_[i] = left.buckets_[i] - right.buckets_[i];
+  }
+  return result;
+}
 void HistogramCollector_65536_26::Collect(Histogram_65536_26* result) const {
   for (int i = 0; i < 26; i++) {
     result->buckets_[i] += buckets_[i].load(std::memory_order_relaxed);
@@ -67,17 +81,32 @@ Histogram_80_10 operator-(const Histogram_80_10& left,
   }
   return result;
 }
-const absl::string_view
-    GlobalStats::counter_name[static_cast<int>(Counter::COUNT)] = {
-        "client_calls_created",    "server_calls_created",
-        "client_channels_created", "client_subchannels_created",
-        "server_channels_created", "insecure_connections_created",
-        "syscall_write",           "syscall_read",
-        "tcp_read_alloc_8k",       "tcp_read_alloc_64k",
-        "http2_settings_writes",   "http2_pings_sent",
-        "http2_writes_begun",      "http2_transport_stalls",
-        "http2_stream_stalls",     "cq_pluck_creates",
-        "cq_next_creates",         "cq_callback_creates",
+const absl::string_view GlobalStats::counter_name[static_cast<int>(
+    Counter::COUNT)] = {
+    "client_calls_created",
+    "server_calls_created",
+    "client_channels_created",
+    "client_subchannels_created",
+    "server_channels_created",
+    "insecure_connections_created",
+    "syscall_write",
+    "syscall_read",
+    "tcp_read_alloc_8k",
+    "tcp_read_alloc_64k",
+    "http2_settings_writes",
+    "http2_pings_sent",
+    "http2_writes_begun",
+    "http2_transport_stalls",
+    "http2_stream_stalls",
+    "cq_pluck_creates",
+    "cq_next_creates",
+    "cq_callback_creates",
+    "adaptive_concurrency_calls_queued",
+    "adaptive_concurrency_calls_rejected",
+    "thread_pool_closures_stolen",
+    "thread_pool_lifeguard_wakeups",
+    "thread_pool_threads_started",
+    "thread_pool_threads_exited",
 };
 const absl::string_view GlobalStats::counter_doc[static_cast<int>(
     Counter::COUNT)] = {
@@ -105,12 +134,32 @@ const absl::string_view GlobalStats::counter_doc[static_cast<int>(
     "usage)",
     "Number of completion queues created for cq_callback (indicates callback "
     "api usage)",
+    "Number of calls queued because an adaptive concurrency limit was reached",
+    "Number of calls failed with RESOURCE_EXHAUSTED by adaptive concurrency "
+    "limiting",
+    "Number of closures that EventEngine thread pool threads stole from other "
+    "threads",
+    "Number of times the thread pool lifeguard woke an idle thread to take "
+    "queued work",
+    "Number of threads EventEngine thread pools started because they were "
+    "backlogged",
+    "Number of idle threads EventEngine thread pools let exit",
 };
 const absl::string_view GlobalStats::histogram_name[static_cast<int>(
     Histogram::COUNT)] = {
-    "call_initial_size",       "tcp_write_size",      "tcp_write_iov_size",
-    "tcp_read_size",           "tcp_read_offer",      "tcp_read_offer_iov_size",
-    "http2_send_message_size", "http2_metadata_size",
+    "call_initial_size",
+    "tcp_write_size",
+    "tcp_write_iov_size",
+    "tcp_read_size",
+    "tcp_read_offer",
+    "tcp_read_offer_iov_size",
+    "http2_send_message_size",
+    "http2_metadata_size",
+    "adaptive_concurrency_limit",
+    "adaptive_concurrency_queue_delay_ms",
+    "thread_pool_queue_delay_us",
+    "thread_pool_run_time_us",
+    "thread_pool_thread_count",
 };
 const absl::string_view GlobalStats::histogram_doc[static_cast<int>(
     Histogram::COUNT)] = {
@@ -122,25 +171,64 @@ const absl::string_view GlobalStats::histogram_doc[static_cast<int>(
     "Number of byte segments offered to each syscall_read",
     "Size of messages received by HTTP2 transport",
     "Number of bytes consumed by metadata, according to HPACK accounting rules",
+    "Concurrency limit computed at each update of an adaptive concurrency "
+    "limiter",
+    "Milliseconds that admitted calls spent queued by adaptive concurrency "
+    "limiting",
+    "Microseconds that EventEngine thread pool closures waited to start "
+    "running after being scheduled",
+    "Microseconds that EventEngine thread pool closures took to run",
+    "Number of threads in an EventEngine thread pool each time it started a "
+    "thread because it was backlogged",
 };
 namespace {
-const int kStatsTable0[27] = {0,    1,     2,     4,     7,     11,   17,
+const int kStatsTable0[41] = {
+    0,      1,      2,      3,      5,       8,     12,    17,     24,
+    34,     48,     67,     94,     131,     183,   255,   356,    496,
+    691,    962,    1340,   1866,   2598,    3617,  5035,  7009,   9757,
+    13582,  18906,  26316,  36630,  50987,   70971, 98787, 137504, 191395,
+    266407, 370817, 516147, 718434, 1000000};
+const uint8_t kStatsTable1[71] = {
+    4,  4,  5,  5,  5,  6,  6,  7,  7,  8,  8,  9,  9,  10, 10, 11, 11, 12, 13,
+    13, 13, 14, 15, 15, 16, 16, 17, 17, 18, 18, 19, 19, 20, 20, 21, 21, 22, 22,
+    23, 23, 24, 25, 25, 26, 26, 27, 27, 28, 28, 29, 29, 30, 30, 31, 31, 32, 32,
+    33, 33, 34, 34, 35, 36, 36, 36, 37, 38, 38, 39, 39, 40};
+const int kStatsTable2[27] = {0,    1,     2,     4,     7,     11,   17,
                               26,   40,    61,    92,    139,   210,  317,
                               478,  721,   1087,  1638,  2468,  3719, 5604,
                               8443, 12721, 19166, 28875, 43502, 65536};
-const uint8_t kStatsTable1[29] = {3,  3,  4,  5,  6,  6,  7,  8,  9,  10,
+const uint8_t kStatsTable3[29] = {3,  3,  4,  5,  6,  6,  7,  8,  9,  10,
                                   11, 11, 12, 13, 14, 15, 16, 16, 17, 18,
                                   19, 20, 21, 21, 22, 23, 24, 25, 26};
-const int kStatsTable2[21] = {
+const int kStatsTable4[21] = {
     0,     1,      3,      8,       19,      45,      106,
     250,   588,    1383,   3252,    7646,    17976,   42262,
     99359, 233593, 549177, 1291113, 3035402, 7136218, 16777216};
-const uint8_t kStatsTable3[23] = {2,  3,  3,  4,  5,  6,  7,  8,
+const uint8_t kStatsTable5[23] = {2,  3,  3,  4,  5,  6,  7,  8,
                                   8,  9,  10, 11, 12, 12, 13, 14,
                                   15, 16, 16, 17, 18, 19, 20};
-const int kStatsTable4[11] = {0, 1, 2, 4, 7, 11, 17, 26, 38, 56, 80};
-const uint8_t kStatsTable5[9] = {3, 3, 4, 5, 6, 6, 7, 8, 9};
+const int kStatsTable6[11] = {0, 1, 2, 4, 7, 11, 17, 26, 38, 56, 80};
+const uint8_t kStatsTable7[9] = {3, 3, 4, 5, 6, 6, 7, 8, 9};
 }  // namespace
+int Histogram_1000000_40::BucketFor(int value) {
+  if (value < 4) {
+    if (value < 0) {
+      return 0;
+    } else {
+      return value;
+    }
+  } else {
+    if (value < 786433) {
+      DblUint val;
+      val.dbl = value;
+      const int bucket =
+          kStatsTable1[((val.uint - 4616189618054758400ull) >> 50)];
+      return bucket - (value < kStatsTable0[bucket]);
+    } else {
+      return 39;
+    }
+  }
+}
 int Histogram_65536_26::BucketFor(int value) {
   if (value < 3) {
     if (value < 0) {
@@ -153,8 +241,8 @@ int Histogram_65536_26::BucketFor(int value) {
       DblUint val;
       val.dbl = value;
       const int bucket =
-          kStatsTable1[((val.uint - 4613937818241073152ull) >> 51)];
-      return bucket - (value < kStatsTable0[bucket]);
+          kStatsTable3[((val.uint - 4613937818241073152ull) >> 51)];
+      return bucket - (value < kStatsTable2[bucket]);
     } else {
       return 25;
     }
@@ -172,8 +260,8 @@ int Histogram_16777216_20::BucketFor(int value) {
       DblUint val;
       val.dbl = value;
       const int bucket =
-          kStatsTable3[((val.uint - 4611686018427387904ull) >> 52)];
-      return bucket - (value < kStatsTable2[bucket]);
+          kStatsTable5[((val.uint - 4611686018427387904ull) >> 52)];
+      return bucket - (value < kStatsTable4[bucket]);
     } else {
       return 19;
     }
@@ -191,8 +279,8 @@ int Histogram_80_10::BucketFor(int value) {
       DblUint val;
       val.dbl = value;
       const int bucket =
-          kStatsTable5[((val.uint - 4613937818241073152ull) >> 51)];
-      return bucket - (value < kStatsTable4[bucket]);
+          kStatsTable7[((val.uint - 4613937818241073152ull) >> 51)];
+      return bucket - (value < kStatsTable6[bucket]);
     } else {
       if (value < 56) {
         return 8;
@@ -220,35 +308,56 @@ GlobalStats::GlobalStats()
       http2_stream_stalls{0},
       cq_pluck_creates{0},
       cq_next_creates{0},
-      cq_callback_creates{0} {}
+      cq_callback_creates{0},
+      adaptive_concurrency_calls_queued{0},
+      adaptive_concurrency_calls_rejected{0},
+      thread_pool_closures_stolen{0},
+      thread_pool_lifeguard_wakeups{0},
+      thread_pool_threads_started{0},
+      thread_pool_threads_exited{0} {}
 HistogramView GlobalStats::histogram(Histogram which) const {
   switch (which) {
     default:
       GPR_UNREACHABLE_CODE(return HistogramView());
     case Histogram::kCallInitialSize:
-      return HistogramView{&Histogram_65536_26::BucketFor, kStatsTable0, 26,
+      return HistogramView{&Histogram_65536_26::BucketFor, kStatsTable2, 26,
                            call_initial_size.buckets()};
     case Histogram::kTcpWriteSize:
-      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
+      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable4, 20,
                            tcp_write_size.buckets()};
     case Histogram::kTcpWriteIovSize:
-      return HistogramView{&Histogram_80_10::BucketFor, kStatsTable4, 10,
+      return HistogramView{&Histogram_80_10::BucketFor, kStatsTable6, 10,
                            tcp_write_iov_size.buckets()};
     case Histogram::kTcpReadSize:
-      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
+      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable4, 20,
                            tcp_read_size.buckets()};
     case Histogram::kTcpReadOffer:
-      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
+      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable4, 20,
                            tcp_read_offer.buckets()};
     case Histogram::kTcpReadOfferIovSize:
-      return HistogramView{&Histogram_80_10::BucketFor, kStatsTable4, 10,
+      return HistogramView{&Histogram_80_10::BucketFor, kStatsTable6, 10,
                            tcp_read_offer_iov_size.buckets()};
     case Histogram::kHttp2SendMessageSize:
-      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
+      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable4, 20,
                            http2_send_message_size.buckets()};
     case Histogram::kHttp2MetadataSize:
-      return HistogramView{&Histogram_65536_26::BucketFor, kStatsTable0, 26,
+      return HistogramView{&Histogram_65536_26::BucketFor, kStatsTable2, 26,
                            http2_metadata_size.buckets()};
+    case Histogram::kAdaptiveConcurrencyLimit:
+      return HistogramView{&Histogram_65536_26::BucketFor, kStatsTable2, 26,
+                           adaptive_concurrency_limit.buckets()};
+    case Histogram::kAdaptiveConcurrencyQueueDelayMs:
+      return HistogramView{&Histogram_65536_26::BucketFor, kStatsTable2, 26,
+                           adaptive_concurrency_queue_delay_ms.buckets()};
+    case Histogram::kThreadPoolQueueDelayUs:
+      return HistogramView{&Histogram_1000000_40::BucketFor, kStatsTable0, 40,
+                           thread_pool_queue_delay_us.buckets()};
+    case Histogram::kThreadPoolRunTimeUs:
+      return HistogramView{&Histogram_1000000_40::BucketFor, kStatsTable0, 40,
+                           thread_pool_run_time_us.buckets()};
+    case Histogram::kThreadPoolThreadCount:
+      return HistogramView{&Histogram_65536_26::BucketFor, kStatsTable2, 26,
+                           thread_pool_thread_count.buckets()};
   }
 }
 std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
@@ -288,6 +397,19 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
         data.cq_next_creates.load(std::memory_order_relaxed);
     result->cq_callback_creates +=
         data.cq_callback_creates.load(std::memory_order_relaxed);
+    result->adaptive_concurrency_calls_queued +=
+        data.adaptive_concurrency_calls_queued.load(std::memory_order_relaxed);
+    result->adaptive_concurrency_calls_rejected +=
+        data.adaptive_concurrency_calls_rejected.load(
+            std::memory_order_relaxed);
+    result->thread_pool_closures_stolen +=
+        data.thread_pool_closures_stolen.load(std::memory_order_relaxed);
+    result->thread_pool_lifeguard_wakeups +=
+        data.thread_pool_lifeguard_wakeups.load(std::memory_order_relaxed);
+    result->thread_pool_threads_started +=
+        data.thread_pool_threads_started.load(std::memory_order_relaxed);
+    result->thread_pool_threads_exited +=
+        data.thread_pool_threads_exited.load(std::memory_order_relaxed);
     data.call_initial_size.Collect(&result->call_initial_size);
     data.tcp_write_size.Collect(&result->tcp_write_size);
     data.tcp_write_iov_size.Collect(&result->tcp_write_iov_size);
@@ -296,6 +418,14 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
     data.tcp_read_offer_iov_size.Collect(&result->tcp_read_offer_iov_size);
     data.http2_send_message_size.Collect(&result->http2_send_message_size);
     data.http2_metadata_size.Collect(&result->http2_metadata_size);
+    data.adaptive_concurrency_limit.Collect(
+        &result->adaptive_concurrency_limit);
+    data.adaptive_concurrency_queue_delay_ms.Collect(
+        &result->adaptive_concurrency_queue_delay_ms);
+    data.thread_pool_queue_delay_us.Collect(
+        &result->thread_pool_queue_delay_us);
+    data.thread_pool_run_time_us.Collect(&result->thread_pool_run_time_us);
+    data.thread_pool_thread_count.Collect(&result->thread_pool_thread_count);
   }
   return result;
 }
@@ -327,6 +457,20 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
   result->cq_pluck_creates = cq_pluck_creates - other.cq_pluck_creates;
   result->cq_next_creates = cq_next_creates - other.cq_next_creates;
   result->cq_callback_creates = cq_callback_creates - other.cq_callback_creates;
+  result->adaptive_concurrency_calls_queued =
+      adaptive_concurrency_calls_queued -
+      other.adaptive_concurrency_calls_queued;
+  result->adaptive_concurrency_calls_rejected =
+      adaptive_concurrency_calls_rejected -
+      other.adaptive_concurrency_calls_rejected;
+  result->thread_pool_closures_stolen =
+      thread_pool_closures_stolen - other.thread_pool_closures_stolen;
+  result->thread_pool_lifeguard_wakeups =
+      thread_pool_lifeguard_wakeups - other.thread_pool_lifeguard_wakeups;
+  result->thread_pool_threads_started =
+      thread_pool_threads_started - other.thread_pool_threads_started;
+  result->thread_pool_threads_exited =
+      thread_pool_threads_exited - other.thread_pool_threads_exited;
   result->call_initial_size = call_initial_size - other.call_initial_size;
   result->tcp_write_size = tcp_write_size - other.tcp_write_size;
   result->tcp_write_iov_size = tcp_write_iov_size - other.tcp_write_iov_size;
@@ -337,6 +481,17 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
   result->http2_send_message_size =
       http2_send_message_size - other.http2_send_message_size;
   result->http2_metadata_size = http2_metadata_size - other.http2_metadata_size;
+  result->adaptive_concurrency_limit =
+      adaptive_concurrency_limit - other.adaptive_concurrency_limit;
+  result->adaptive_concurrency_queue_delay_ms =
+      adaptive_concurrency_queue_delay_ms -
+      other.adaptive_concurrency_queue_delay_ms;
+  result->thread_pool_queue_delay_us =
+      thread_pool_queue_delay_us - other.thread_pool_queue_delay_us;
+  result->thread_pool_run_time_us =
+      thread_pool_run_time_us - other.thread_pool_run_time_us;
+  result->thread_pool_thread_count =
+      thread_pool_thread_count - other.thread_pool_thread_count;
   return result;
 }
 }  // namespace grpc_core
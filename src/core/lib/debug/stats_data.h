@@ -30,6 +30,29 @@
 #include "src/core/lib/gprpp/per_cpu.h"
 
 namespace grpc_core {
+class HistogramCollector_1000000_40;
+class Histogram_1000000_40 {
+ public:
+  static int BucketFor(int value);
+  const uint64_t* buckets() const { return buckets_; }
+  friend Histogram_1000000_40 operator-(const Histogram_1000000_40& left,
+                                        const Histogram_1000000_40& right);
+
+ private:
+  friend class HistogramCollector_1000000_40;
+  uint64_t buckets_[40]{};
+};
+class HistogramCollector_1000000_40 {
+ public:
+  void Increment(int value) {
+    buckets_[Histogram_1000000_40::BucketFor(value)].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  void Collect(Histogram_1000000_40* result) const;
+
+ private:
+  std::atomic<uint64_t> buckets_[40]{};
+};
 class HistogramCollector_65536_26;
 class Histogram_65536_26 {
  public:
@@ -119,6 +142,12 @@ struct GlobalStats {
     kCqPluckCreates,
     kCqNextCreates,
     kCqCallbackCreates,
+    kAdaptiveConcurrencyCallsQueued,
+    kAdaptiveConcurrencyCallsRejected,
+    kThreadPoolClosuresStolen,
+    kThreadPoolLifeguardWakeups,
+    kThreadPoolThreadsStarted,
+    kThreadPoolThreadsExited,
     COUNT
   };
   enum class Histogram {
@@ -130,6 +159,11 @@ struct GlobalStats {
     kTcpReadOfferIovSize,
     kHttp2SendMessageSize,
     kHttp2MetadataSize,
+    kAdaptiveConcurrencyLimit,
+    kAdaptiveConcurrencyQueueDelayMs,
+    kThreadPoolQueueDelayUs,
+    kThreadPoolRunTimeUs,
+    kThreadPoolThreadCount,
     COUNT
   };
   GlobalStats();
@@ -159,6 +193,12 @@ struct GlobalStats {
       uint64_t cq_pluck_creates;
       uint64_t cq_next_creates;
       uint64_t cq_callback_creates;
+      uint64_t adaptive_concurrency_calls_queued;
+      uint64_t adaptive_concurrency_calls_rejected;
+      uint64_t thread_pool_closures_stolen;
+      uint64_t thread_pool_lifeguard_wakeups;
+      uint64_t thread_pool_threads_started;
+      uint64_t thread_pool_threads_exited;
     };
     uint64_t counters[static_cast<int>(Counter::COUNT)];
   };
@@ -170,6 +210,11 @@ struct GlobalStats {
   Histogram_80_10 tcp_read_offer_iov_size;
   Histogram_16777216_20 http2_send_message_size;
   Histogram_65536_26 http2_metadata_size;
+  Histogram_65536_26 adaptive_concurrency_limit;
+  Histogram_65536_26 adaptive_concurrency_queue_delay_ms;
+  Histogram_1000000_40 thread_pool_queue_delay_us;
+  Histogram_1000000_40 thread_pool_run_time_us;
+  Histogram_65536_26 thread_pool_thread_count;
   HistogramView histogram(Histogram which) const;
   std::unique_ptr<GlobalStats> Diff(const GlobalStats& other) const;
 };
@@ -240,6 +285,30 @@ class GlobalStatsCollector {
     data_.this_cpu().cq_callback_creates.fetch_add(1,
                                                    std::memory_order_relaxed);
   }
+  void IncrementAdaptiveConcurrencyCallsQueued() {
+    data_.this_cpu().adaptive_concurrency_calls_queued.fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  void IncrementAdaptiveConcurrencyCallsRejected() {
+    data_.this_cpu().adaptive_concurrency_calls_rejected.fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  void IncrementThreadPoolClosuresStolen() {
+    data_.this_cpu().thread_pool_closures_stolen.fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  void IncrementThreadPoolLifeguardWakeups() {
+    data_.this_cpu().thread_pool_lifeguard_wakeups.fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  void IncrementThreadPoolThreadsStarted() {
+    data_.this_cpu().thread_pool_threads_started.fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  void IncrementThreadPoolThreadsExited() {
+    data_.this_cpu().thread_pool_threads_exited.fetch_add(
+        1, std::memory_order_relaxed);
+  }
   void IncrementCallInitialSize(int value) {
     data_.this_cpu().call_initial_size.Increment(value);
   }
@@ -264,6 +333,21 @@ class GlobalStatsCollector {
   void IncrementHttp2MetadataSize(int value) {
     data_.this_cpu().http2_metadata_size.Increment(value);
   }
+  void IncrementAdaptiveConcurrencyLimit(int value) {
+    data_.this_cpu().adaptive_concurrency_limit.Increment(value);
+  }
+  void IncrementAdaptiveConcurrencyQueueDelayMs(int value) {
+    data_.this_cpu().adaptive_concurrency_queue_delay_ms.Increment(value);
+  }
+  void IncrementThreadPoolQueueDelayUs(int value) {
+    data_.this_cpu().thread_pool_queue_delay_us.Increment(value);
+  }
+  void IncrementThreadPoolRunTimeUs(int value) {
+    data_.this_cpu().thread_pool_run_time_us.Increment(value);
+  }
+  void IncrementThreadPoolThreadCount(int value) {
+    data_.this_cpu().thread_pool_thread_count.Increment(value);
+  }
 
  private:
   struct Data {
@@ -285,6 +369,12 @@ class GlobalStatsCollector {
     std::atomic<uint64_t> cq_pluck_creates{0};
     std::atomic<uint64_t> cq_next_creates{0};
     std::atomic<uint64_t> cq_callback_creates{0};
+    std::atomic<uint64_t> adaptive_concurrency_calls_queued{0};
+    std::atomic<uint64_t> adaptive_concurrency_calls_rejected{0};
+    std::atomic<uint64_t> thread_pool_closures_stolen{0};
+    std::atomic<uint64_t> thread_pool_lifeguard_wakeups{0};
+    std::atomic<uint64_t> thread_pool_threads_started{0};
+    std::atomic<uint64_t> thread_pool_threads_exited{0};
     HistogramCollector_65536_26 call_initial_size;
     HistogramCollector_16777216_20 tcp_write_size;
     HistogramCollector_80_10 tcp_write_iov_size;
@@ -293,6 +383,11 @@ class GlobalStatsCollector {
     HistogramCollector_80_10 tcp_read_offer_iov_size;
     HistogramCollector_16777216_20 http2_send_message_size;
     HistogramCollector_65536_26 http2_metadata_size;
+    HistogramCollector_65536_26 adaptive_concurrency_limit;
+    HistogramCollector_65536_26 adaptive_concurrency_queue_delay_ms;
+    HistogramCollector_1000000_40 thread_pool_queue_delay_us;
+    HistogramCollector_1000000_40 thread_pool_run_time_us;
+    HistogramCollector_65536_26 thread_pool_thread_count;
   };
   PerCpu<Data> data_{PerCpuOptions().SetCpusPerShard(4).SetMaxShards(32)};
 };
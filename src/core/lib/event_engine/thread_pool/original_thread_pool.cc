@@ -30,6 +30,8 @@
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/event_engine/thread_local.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/gprpp/time.h"
@@ -38,7 +40,7 @@ namespace grpc_event_engine {
 namespace experimental {
 
 void OriginalThreadPool::StartThread(StatePtr state, StartThreadReason reason) {
-  state->thread_count.Add();
+  const int threads = state->thread_count.Add();
   const auto now = grpc_core::Timestamp::Now();
   switch (reason) {
     case StartThreadReason::kNoWaitersWhenScheduling: {
@@ -59,6 +61,8 @@ void OriginalThreadPool::StartThread(StatePtr state, StartThreadReason reason) {
       }
       state->last_started_thread.store(now.milliseconds_after_process_epoch(),
                                        std::memory_order_relaxed);
+      grpc_core::global_stats().IncrementThreadPoolThreadsStarted();
+      grpc_core::global_stats().IncrementThreadPoolThreadCount(threads);
       break;
     case StartThreadReason::kInitialPool:
       break;
@@ -112,6 +116,7 @@ bool OriginalThreadPool::Queue::Step() {
       bool timeout = cv_.WaitWithTimeout(&queue_mu_, absl::Seconds(30));
       threads_waiting_--;
       if (timeout && threads_waiting_ >= reserve_threads_) {
+        grpc_core::global_stats().IncrementThreadPoolThreadsExited();
         return false;
       }
     } else {
@@ -126,7 +131,12 @@ bool OriginalThreadPool::Queue::Step() {
   auto callback = std::move(callbacks_.front());
   callbacks_.pop();
   lock.Release();
-  callback();
+  const gpr_cycle_counter start = gpr_get_cycle_counter();
+  grpc_core::global_stats().IncrementThreadPoolQueueDelayUs(
+      ThreadPoolElapsedMicros(callback.enqueued_at, start));
+  callback.callback();
+  grpc_core::global_stats().IncrementThreadPoolRunTimeUs(
+      ThreadPoolElapsedMicros(start, gpr_get_cycle_counter()));
   return true;
 }
 
@@ -169,9 +179,10 @@ void OriginalThreadPool::Run(EventEngine::Closure* closure) {
 }
 
 bool OriginalThreadPool::Queue::Add(absl::AnyInvocable<void()> callback) {
+  const gpr_cycle_counter now = gpr_get_cycle_counter();
   grpc_core::MutexLock lock(&queue_mu_);
   // Add works to the callbacks list
-  callbacks_.push(std::move(callback));
+  callbacks_.push({std::move(callback), now});
   cv_.Signal();
   if (forking_) return false;
   return callbacks_.size() > threads_waiting_;
@@ -207,9 +218,9 @@ void OriginalThreadPool::Queue::SetForking(bool is_forking) {
   cv_.SignalAll();
 }
 
-void OriginalThreadPool::ThreadCount::Add() {
+int OriginalThreadPool::ThreadCount::Add() {
   grpc_core::MutexLock lock(&thread_count_mu_);
-  ++threads_;
+  return ++threads_;
 }
 
 void OriginalThreadPool::ThreadCount::Remove() {
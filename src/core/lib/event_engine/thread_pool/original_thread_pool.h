@@ -33,6 +33,7 @@
 #include <grpc/event_engine/event_engine.h>
 
 #include "src/core/lib/event_engine/thread_pool/thread_pool.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/sync.h"
 
 namespace grpc_event_engine {
@@ -74,11 +75,15 @@ class OriginalThreadPool final : public ThreadPool {
     void SleepIfRunning();
 
    private:
+    struct Callback {
+      absl::AnyInvocable<void()> callback;
+      gpr_cycle_counter enqueued_at;
+    };
+
     const unsigned reserve_threads_;
     grpc_core::Mutex queue_mu_;
     grpc_core::CondVar cv_;
-    std::queue<absl::AnyInvocable<void()>> callbacks_
-        ABSL_GUARDED_BY(queue_mu_);
+    std::queue<Callback> callbacks_ ABSL_GUARDED_BY(queue_mu_);
     unsigned threads_waiting_ ABSL_GUARDED_BY(queue_mu_) = 0;
     // Track shutdown and fork bits separately.
     // It's possible for a ThreadPool to initiate shut down while fork handlers
@@ -90,7 +95,8 @@ class OriginalThreadPool final : public ThreadPool {
 
   class ThreadCount {
    public:
-    void Add();
+    // Returns the new thread count.
+    int Add();
     void Remove();
     void BlockUntilThreadCount(int threads, const char* why);
 
@@ -15,15 +15,19 @@
 #define GRPC_SRC_CORE_LIB_EVENT_ENGINE_THREAD_POOL_THREAD_POOL_H
 #include <grpc/support/port_platform.h>
 
+#include <limits.h>
 #include <stddef.h>
 
+#include <algorithm>
 #include <memory>
 
 #include "absl/functional/any_invocable.h"
 
 #include <grpc/event_engine/event_engine.h>
+#include <grpc/support/time.h>
 
 #include "src/core/lib/event_engine/forkable.h"
+#include "src/core/lib/gpr/time_precise.h"
 
 namespace grpc_event_engine {
 namespace experimental {
@@ -41,6 +45,14 @@ class ThreadPool : public Forkable {
   virtual void Run(EventEngine::Closure* closure) = 0;
 };
 
+// Returns the microseconds between two gpr_get_cycle_counter() values, capped
+// to fit the thread pool stats histograms.
+inline int ThreadPoolElapsedMicros(gpr_cycle_counter start,
+                                   gpr_cycle_counter end) {
+  return static_cast<int>(std::min<double>(
+      gpr_timespec_to_micros(gpr_cycle_counter_sub(end, start)), INT_MAX));
+}
+
 // Creates a default thread pool.
 std::shared_ptr<ThreadPool> MakeThreadPool(size_t reserve_threads);
 
@@ -32,9 +32,12 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/backoff/backoff.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/event_engine/common_closures.h"
 #include "src/core/lib/event_engine/thread_local.h"
+#include "src/core/lib/event_engine/thread_pool/thread_pool.h"
 #include "src/core/lib/event_engine/trace.h"
 #include "src/core/lib/event_engine/work_queue/basic_work_queue.h"
 #include "src/core/lib/event_engine/work_queue/work_queue.h"
@@ -146,11 +149,12 @@ void WorkStealingThreadPool::TheftRegistry::Unenroll(WorkQueue* queue) {
   queues_.erase(queue);
 }
 
-EventEngine::Closure* WorkStealingThreadPool::TheftRegistry::StealOne() {
+EventEngine::Closure* WorkStealingThreadPool::TheftRegistry::StealOne(
+    gpr_cycle_counter* enqueued_at) {
   grpc_core::MutexLock lock(&mu_);
   EventEngine::Closure* closure;
   for (auto* queue : queues_) {
-    closure = queue->PopMostRecent();
+    closure = queue->PopMostRecent(enqueued_at);
     if (closure != nullptr) return closure;
   }
   return nullptr;
@@ -337,6 +341,7 @@ void WorkStealingThreadPool::WorkStealingThreadPoolImpl::Lifeguard::
   if (busy_thread_count < living_thread_count) {
     if (!pool_->queue_.Empty()) {
       pool_->work_signal()->Signal();
+      grpc_core::global_stats().IncrementThreadPoolLifeguardWakeups();
       backoff_.Reset();
     }
     // Idle threads will eventually wake up for an attempt at work stealing.
@@ -360,6 +365,9 @@ void WorkStealingThreadPool::WorkStealingThreadPoolImpl::Lifeguard::
       "Starting new ThreadPool thread due to backlog (total threads: %d)",
       living_thread_count + 1);
   pool_->StartThread();
+  grpc_core::global_stats().IncrementThreadPoolThreadsStarted();
+  grpc_core::global_stats().IncrementThreadPoolThreadCount(
+      living_thread_count + 1);
   // Tell the lifeguard to monitor the pool more closely.
   backoff_.Reset();
 }
@@ -409,12 +417,13 @@ void WorkStealingThreadPool::ThreadState::SleepIfRunning() {
 
 bool WorkStealingThreadPool::ThreadState::Step() {
   if (pool_->IsForking()) return false;
-  auto* closure = g_local_queue->PopMostRecent();
+  gpr_cycle_counter enqueued_at;
+  auto* closure = g_local_queue->PopMostRecent(&enqueued_at);
   // If local work is available, run it.
   if (closure != nullptr) {
     ThreadCount::AutoThreadCount auto_busy{pool_->thread_count(),
                                            CounterType::kBusyCount};
-    closure->Run();
+    RunClosure(closure, enqueued_at);
     return true;
   }
   // Thread shutdown exit condition (ignoring fork). All must be true:
@@ -430,14 +439,15 @@ bool WorkStealingThreadPool::ThreadState::Step() {
     // TODO(hork): consider an empty check for performance wins. Depends on the
     // queue implementation, the BasicWorkQueue takes two locks when you do an
     // empty check then pop.
-    closure = pool_->queue()->PopMostRecent();
+    closure = pool_->queue()->PopMostRecent(&enqueued_at);
     if (closure != nullptr) {
       should_run_again = true;
       break;
     };
     // Try stealing if the queue is empty
-    closure = pool_->theft_registry()->StealOne();
+    closure = pool_->theft_registry()->StealOne(&enqueued_at);
     if (closure != nullptr) {
+      grpc_core::global_stats().IncrementThreadPoolClosuresStolen();
       should_run_again = true;
       break;
     }
@@ -453,6 +463,7 @@ bool WorkStealingThreadPool::ThreadState::Step() {
         pool_->thread_count()->GetCount(CounterType::kLivingThreadCount) >
             pool_->reserve_threads() &&
         grpc_core::Timestamp::Now() - start_time > kIdleThreadLimit) {
+      grpc_core::global_stats().IncrementThreadPoolThreadsExited();
       return false;
     }
   }
@@ -464,30 +475,41 @@ bool WorkStealingThreadPool::ThreadState::Step() {
   if (closure != nullptr) {
     ThreadCount::AutoThreadCount auto_busy{pool_->thread_count(),
                                            CounterType::kBusyCount};
-    closure->Run();
+    RunClosure(closure, enqueued_at);
   }
   backoff_.Reset();
   return should_run_again;
 }
 
+void WorkStealingThreadPool::ThreadState::RunClosure(
+    EventEngine::Closure* closure, gpr_cycle_counter enqueued_at) {
+  const gpr_cycle_counter start = gpr_get_cycle_counter();
+  grpc_core::global_stats().IncrementThreadPoolQueueDelayUs(
+      ThreadPoolElapsedMicros(enqueued_at, start));
+  closure->Run();
+  grpc_core::global_stats().IncrementThreadPoolRunTimeUs(
+      ThreadPoolElapsedMicros(start, gpr_get_cycle_counter()));
+}
+
 void WorkStealingThreadPool::ThreadState::FinishDraining() {
   // The thread is definitionally busy while draining
   ThreadCount::AutoThreadCount auto_busy{pool_->thread_count(),
                                          CounterType::kBusyCount};
   // If a fork occurs at any point during shutdown, quit draining. The post-fork
   // threads will finish draining the global queue.
+  gpr_cycle_counter enqueued_at;
   while (!pool_->IsForking()) {
     if (!g_local_queue->Empty()) {
-      auto* closure = g_local_queue->PopMostRecent();
+      auto* closure = g_local_queue->PopMostRecent(&enqueued_at);
       if (closure != nullptr) {
-        closure->Run();
+        RunClosure(closure, enqueued_at);
       }
       continue;
     }
     if (!pool_->queue()->Empty()) {
-      auto* closure = pool_->queue()->PopMostRecent();
+      auto* closure = pool_->queue()->PopMostRecent(&enqueued_at);
       if (closure != nullptr) {
-        closure->Run();
+        RunClosure(closure, enqueued_at);
       }
       continue;
     }
@@ -36,6 +36,7 @@
 #include "src/core/lib/event_engine/thread_pool/thread_pool.h"
 #include "src/core/lib/event_engine/work_queue/basic_work_queue.h"
 #include "src/core/lib/event_engine/work_queue/work_queue.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/notification.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/time.h"
@@ -138,8 +139,9 @@ class WorkStealingThreadPool final : public ThreadPool {
     // Disallow work stealing from the provided queue.
     void Unenroll(WorkQueue* queue) ABSL_LOCKS_EXCLUDED(mu_);
     // Returns one closure from another thread, or nullptr if none are
-    // available.
-    EventEngine::Closure* StealOne() ABSL_LOCKS_EXCLUDED(mu_);
+    // available. Sets *enqueued_at to the time the closure was queued.
+    EventEngine::Closure* StealOne(gpr_cycle_counter* enqueued_at)
+        ABSL_LOCKS_EXCLUDED(mu_);
 
    private:
     grpc_core::Mutex mu_;
@@ -250,6 +252,10 @@ class WorkStealingThreadPool final : public ThreadPool {
     void FinishDraining();
 
    private:
+    // Runs a closure, recording how long it was queued and how long it ran.
+    void RunClosure(EventEngine::Closure* closure,
+                    gpr_cycle_counter enqueued_at);
+
     // pool_ must be the first member so that it is alive when the thread count
     // is decremented at time of destruction. This is necessary when this thread
     // state holds the last shared_ptr keeping the pool alive.
@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "src/core/lib/event_engine/common_closures.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/sync.h"
 
 namespace grpc_event_engine {
@@ -34,29 +35,45 @@ size_t BasicWorkQueue::Size() const {
 }
 
 EventEngine::Closure* BasicWorkQueue::PopMostRecent() {
+  gpr_cycle_counter enqueued_at;
+  return PopMostRecent(&enqueued_at);
+}
+
+EventEngine::Closure* BasicWorkQueue::PopOldest() {
+  gpr_cycle_counter enqueued_at;
+  return PopOldest(&enqueued_at);
+}
+
+EventEngine::Closure* BasicWorkQueue::PopMostRecent(
+    gpr_cycle_counter* enqueued_at) {
   grpc_core::MutexLock lock(&mu_);
   if (q_.empty()) return nullptr;
-  auto tmp = q_.back();
+  Entry tmp = q_.back();
   q_.pop_back();
-  return tmp;
+  *enqueued_at = tmp.enqueued_at;
+  return tmp.closure;
 }
 
-EventEngine::Closure* BasicWorkQueue::PopOldest() {
+EventEngine::Closure* BasicWorkQueue::PopOldest(
+    gpr_cycle_counter* enqueued_at) {
   grpc_core::MutexLock lock(&mu_);
   if (q_.empty()) return nullptr;
-  auto tmp = q_.front();
+  Entry tmp = q_.front();
   q_.pop_front();
-  return tmp;
+  *enqueued_at = tmp.enqueued_at;
+  return tmp.closure;
 }
 
 void BasicWorkQueue::Add(EventEngine::Closure* closure) {
+  const gpr_cycle_counter now = gpr_get_cycle_counter();
   grpc_core::MutexLock lock(&mu_);
-  q_.push_back(closure);
+  q_.push_back({closure, now});
 }
 
 void BasicWorkQueue::Add(absl::AnyInvocable<void()> invocable) {
+  const gpr_cycle_counter now = gpr_get_cycle_counter();
   grpc_core::MutexLock lock(&mu_);
-  q_.push_back(SelfDeletingClosure::Create(std::move(invocable)));
+  q_.push_back({SelfDeletingClosure::Create(std::move(invocable)), now});
 }
 
 }  // namespace experimental
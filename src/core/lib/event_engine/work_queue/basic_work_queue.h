@@ -25,6 +25,7 @@
 #include <grpc/event_engine/event_engine.h>
 
 #include "src/core/lib/event_engine/work_queue/work_queue.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/sync.h"
 
 namespace grpc_event_engine {
@@ -54,6 +55,11 @@ class BasicWorkQueue : public WorkQueue {
   //
   // This method may return nullptr even if the queue is not empty.
   EventEngine::Closure* PopOldest() override ABSL_LOCKS_EXCLUDED(mu_);
+  // As above, also returning when the closure was added.
+  EventEngine::Closure* PopMostRecent(gpr_cycle_counter* enqueued_at) override
+      ABSL_LOCKS_EXCLUDED(mu_);
+  EventEngine::Closure* PopOldest(gpr_cycle_counter* enqueued_at) override
+      ABSL_LOCKS_EXCLUDED(mu_);
   // Adds a closure to the queue.
   void Add(EventEngine::Closure* closure) override ABSL_LOCKS_EXCLUDED(mu_);
   // Wraps an AnyInvocable and adds it to the the queue.
@@ -61,8 +67,13 @@ class BasicWorkQueue : public WorkQueue {
       ABSL_LOCKS_EXCLUDED(mu_);
 
  private:
+  struct Entry {
+    EventEngine::Closure* closure;
+    gpr_cycle_counter enqueued_at;
+  };
+
   mutable grpc_core::Mutex mu_;
-  std::deque<EventEngine::Closure*> q_ ABSL_GUARDED_BY(mu_);
+  std::deque<Entry> q_ ABSL_GUARDED_BY(mu_);
 };
 
 }  // namespace experimental
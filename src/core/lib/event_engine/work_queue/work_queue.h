@@ -22,6 +22,8 @@
 
 #include <grpc/event_engine/event_engine.h>
 
+#include "src/core/lib/gpr/time_precise.h"
+
 namespace grpc_event_engine {
 namespace experimental {
 
@@ -50,6 +52,11 @@ class WorkQueue {
   // Implementations are permitted to return nullptr even if the queue is not
   // empty. This is to support potential optimizations.
   virtual EventEngine::Closure* PopOldest() = 0;
+  // As above, and sets *enqueued_at to the gpr_get_cycle_counter() value at
+  // the time the returned closure was added.
+  virtual EventEngine::Closure* PopMostRecent(
+      gpr_cycle_counter* enqueued_at) = 0;
+  virtual EventEngine::Closure* PopOldest(gpr_cycle_counter* enqueued_at) = 0;
   // Adds a closure to the queue.
   virtual void Add(EventEngine::Closure* closure) = 0;
   // Wraps an AnyInvocable and adds it to the the queue.
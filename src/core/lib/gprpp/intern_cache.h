@@ -0,0 +1,112 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_LIB_GPRPP_INTERN_CACHE_H
+#define GRPC_SRC_CORE_LIB_GPRPP_INTERN_CACHE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <functional>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+// A content-addressed cache of immutable ref-counted objects: callers that
+// build an object from the same key get the same instance.
+//
+// RefCounted<> offers no weak references, so the cache holds a strong ref
+// to each entry.  To keep that bounded, at most max_entries objects are
+// retained, and the least recently used one is dropped when a new one is
+// added.  Objects that are dropped stay alive for as long as their
+// existing holders keep them.
+//
+// Thread-safe.
+template <typename T>
+class InternCache {
+ public:
+  explicit InternCache(size_t max_entries) : max_entries_(max_entries) {}
+
+  InternCache(const InternCache&) = delete;
+  InternCache& operator=(const InternCache&) = delete;
+
+  // Returns the object cached under key.  If there is none, calls create()
+  // to build one and caches it if that succeeds.  create() is called
+  // without holding the lock, so it may itself use the cache.
+  absl::StatusOr<RefCountedPtr<T>> GetOrCreate(
+      absl::string_view key,
+      const std::function<absl::StatusOr<RefCountedPtr<T>>()>& create) {
+    {
+      MutexLock lock(&mu_);
+      RefCountedPtr<T> value = LookupLocked(key);
+      if (value != nullptr) return value;
+    }
+    absl::StatusOr<RefCountedPtr<T>> value = create();
+    if (!value.ok() || *value == nullptr || max_entries_ == 0) return value;
+    MutexLock lock(&mu_);
+    // Another caller may have created the same object in the meantime.
+    // Return that one, so that everybody shares a single instance.
+    RefCountedPtr<T> existing = LookupLocked(key);
+    if (existing != nullptr) return existing;
+    auto it = entries_.emplace(std::string(key), Entry{*value, {}}).first;
+    lru_.push_front(&it->first);
+    it->second.lru_pos = lru_.begin();
+    while (entries_.size() > max_entries_) {
+      entries_.erase(*lru_.back());
+      lru_.pop_back();
+    }
+    return value;
+  }
+
+  size_t size() const {
+    MutexLock lock(&mu_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    RefCountedPtr<T> value;
+    // Position of this entry's key in lru_.
+    typename std::list<const std::string*>::iterator lru_pos;
+  };
+
+  RefCountedPtr<T> LookupLocked(absl::string_view key)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return nullptr;
+    lru_.splice(lru_.begin(), lru_, it->second.lru_pos);
+    return it->second.value;
+  }
+
+  const size_t max_entries_;
+  mutable Mutex mu_;
+  std::map<std::string, Entry, std::less<>> entries_ ABSL_GUARDED_BY(mu_);
+  // Keys of entries_, most recently used first.
+  std::list<const std::string*> lru_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_LIB_GPRPP_INTERN_CACHE_H
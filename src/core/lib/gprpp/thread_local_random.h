@@ -0,0 +1,41 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_LIB_GPRPP_THREAD_LOCAL_RANDOM_H
+#define GRPC_SRC_CORE_LIB_GPRPP_THREAD_LOCAL_RANDOM_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include "absl/random/random.h"
+
+namespace grpc_core {
+
+// Returns a uniformly distributed 64-bit random number from a generator
+// private to the calling thread, so that concurrent callers (e.g. LB
+// pickers) do not contend on shared generator state.
+// The generator is splitmix64, seeded once per thread from absl::BitGen.
+// Not suitable for anything security sensitive.
+inline uint64_t ThreadLocalRandom() {
+  static thread_local uint64_t state = absl::Uniform<uint64_t>(absl::BitGen());
+  uint64_t z = (state += 0x9e3779b97f4a7c15);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_LIB_GPRPP_THREAD_LOCAL_RANDOM_H
@@ -38,6 +38,13 @@ void ValidationErrors::AddError(absl::string_view error) {
   field_errors_[absl::StrJoin(fields_, "")].emplace_back(error);
 }
 
+void ValidationErrors::AddErrors(const ValidationErrors& other) {
+  for (const auto& p : other.field_errors_) {
+    std::vector<std::string>& errors = field_errors_[p.first];
+    errors.insert(errors.end(), p.second.begin(), p.second.end());
+  }
+}
+
 bool ValidationErrors::FieldHasErrors() const {
   return field_errors_.find(absl::StrJoin(fields_, "")) != field_errors_.end();
 }
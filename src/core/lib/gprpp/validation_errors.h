@@ -97,6 +97,11 @@ class ValidationErrors {
   // field.
   void AddError(absl::string_view error) GPR_ATTRIBUTE_NOINLINE;
 
+  // Records all of the errors recorded by other, under the field names
+  // other recorded them with.  This allows parts of a data structure to be
+  // validated separately (e.g., in parallel) and the results combined.
+  void AddErrors(const ValidationErrors& other) GPR_ATTRIBUTE_NOINLINE;
+
   // Returns true if the current field has errors.
   bool FieldHasErrors() const GPR_ATTRIBUTE_NOINLINE;
 
@@ -0,0 +1,817 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/json/json_document.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Same limits as JsonParse().
+constexpr size_t kMaxDepth = 255;
+constexpr size_t kMaxErrors = 16;
+
+// The number of bytes that are classified at a time in the first pass.
+constexpr size_t kBlockSize = 64;
+
+// Spaces appended to the copy of the input, so that the second pass can
+// read whole words past the end of any string or scalar.
+constexpr size_t kPadding = 8;
+
+//
+// Bit manipulation helpers for the first pass.  Each 64-byte block is
+// classified 8 bytes at a time with SWAR (SIMD within a register)
+// arithmetic, which is portable and needs no intrinsics.  The results are
+// packed into 64-bit masks with one bit per input byte, bit i being byte i
+// of the block.
+//
+
+constexpr uint64_t kOnes = 0x0101010101010101ull;
+constexpr uint64_t kLowBits = 0x7f7f7f7f7f7f7f7full;
+constexpr uint64_t kHighBits = 0x8080808080808080ull;
+
+inline uint32_t PopCount(uint64_t x) {
+#if defined(__GNUC__)
+  return __builtin_popcountll(x);
+#else
+  return BitCount(x);
+#endif
+}
+
+inline uint32_t CountTrailingZeros(uint64_t x) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(x);
+#else
+  return BitCount((x & (~x + 1)) - 1);
+#endif
+}
+
+// Loads 8 bytes such that byte i of p is in bits [8i, 8i+8) of the result,
+// whatever the endianness of the platform.  Compilers turn this into a
+// single load on little-endian platforms.
+inline uint64_t LoadWord(const uint8_t* p) {
+  return static_cast<uint64_t>(p[0]) | (static_cast<uint64_t>(p[1]) << 8) |
+         (static_cast<uint64_t>(p[2]) << 16) |
+         (static_cast<uint64_t>(p[3]) << 24) |
+         (static_cast<uint64_t>(p[4]) << 32) |
+         (static_cast<uint64_t>(p[5]) << 40) |
+         (static_cast<uint64_t>(p[6]) << 48) |
+         (static_cast<uint64_t>(p[7]) << 56);
+}
+
+// Returns a word with the high bit set in every byte of w that is zero.
+// None of the additions carry across bytes, so there are no false
+// positives.
+inline uint64_t ZeroBytes(uint64_t w) {
+  return ~(((w & kLowBits) + kLowBits) | w | kLowBits);
+}
+
+inline uint64_t BytesEqualTo(uint64_t w, uint8_t c) {
+  return ZeroBytes(w ^ (kOnes * c));
+}
+
+// Returns a word with the high bit set in every byte of w that is less
+// than n, which must be at most 0x80.
+inline uint64_t BytesLessThan(uint64_t w, uint8_t n) {
+  return ~(((w & kLowBits) + kOnes * (0x80 - n)) | w) & kHighBits;
+}
+
+// Gathers the high bit of each byte of x into the low 8 bits.
+inline uint64_t MoveMask(uint64_t x) {
+  return (((x & kHighBits) >> 7) * 0x0102040810204080ull) >> 56;
+}
+
+// Returns a mask with bit i set if any of the bits [0, i] of x are set an
+// odd number of times.
+inline uint64_t PrefixXor(uint64_t x) {
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+// Per-byte classification of one block.
+struct BlockMasks {
+  uint64_t quote = 0;
+  uint64_t backslash = 0;
+  uint64_t whitespace = 0;
+  uint64_t control = 0;
+  // '{', '}', '[', ']', ':' and ','.
+  uint64_t op = 0;
+  // '{' and '['.
+  uint64_t open = 0;
+  uint64_t colon = 0;
+  bool non_ascii = false;
+};
+
+BlockMasks ClassifyBlock(const uint8_t* block) {
+  BlockMasks masks;
+  uint64_t high_bits = 0;
+  for (size_t i = 0; i < kBlockSize / 8; ++i) {
+    const uint64_t w = LoadWord(block + 8 * i);
+    // Setting bit 5 maps '[' to '{' and ']' to '}', and no other bytes to
+    // either.
+    const uint64_t folded = w | (kOnes * 0x20);
+    const uint64_t open = BytesEqualTo(folded, '{');
+    const uint64_t colon = BytesEqualTo(w, ':');
+    const uint64_t op =
+        open | BytesEqualTo(folded, '}') | colon | BytesEqualTo(w, ',');
+    const uint64_t whitespace = BytesEqualTo(w, ' ') | BytesEqualTo(w, '\t') |
+                                BytesEqualTo(w, '\n') | BytesEqualTo(w, '\r');
+    const int shift = static_cast<int>(8 * i);
+    masks.quote |= MoveMask(BytesEqualTo(w, '"')) << shift;
+    masks.backslash |= MoveMask(BytesEqualTo(w, '\\')) << shift;
+    masks.whitespace |= MoveMask(whitespace) << shift;
+    masks.control |= MoveMask(BytesLessThan(w, 0x20)) << shift;
+    masks.op |= MoveMask(op) << shift;
+    masks.open |= MoveMask(open) << shift;
+    masks.colon |= MoveMask(colon) << shift;
+    high_bits |= w;
+  }
+  masks.non_ascii = (high_bits & kHighBits) != 0;
+  return masks;
+}
+
+// Returns the characters that are escaped by a backslash, i.e., that
+// follow an odd-length run of backslashes.  *prev_escaped carries whether
+// the first character of the next block is escaped.
+uint64_t FindEscaped(uint64_t backslash, uint64_t* prev_escaped) {
+  constexpr uint64_t kEvenBits = 0x5555555555555555ull;
+  // An escaped backslash does not start an escape.
+  backslash &= ~*prev_escaped;
+  const uint64_t follows_escape = (backslash << 1) | *prev_escaped;
+  // Runs of backslashes that start on an odd bit.  Adding them to the
+  // backslashes carries through each run, leaving a bit just past the end
+  // of the run.
+  const uint64_t odd_starts = backslash & ~kEvenBits & ~follows_escape;
+  const uint64_t sequences_starting_on_even_bits = odd_starts + backslash;
+  *prev_escaped = sequences_starting_on_even_bits < odd_starts ? 1 : 0;
+  const uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+  return (kEvenBits ^ invert_mask) & follows_escape;
+}
+
+// Returns the offset of the first byte of p that is not part of a valid
+// UTF-8 sequence, as per Table 3-7 in
+// https://www.unicode.org/versions/Unicode14.0.0/ch03.pdf, or size if
+// there is none.
+size_t FindInvalidUtf8(const uint8_t* p, size_t size) {
+  size_t i = 0;
+  while (i < size) {
+    if (size - i >= 8 && (LoadWord(p + i) & kHighBits) == 0) {
+      i += 8;
+      continue;
+    }
+    const uint8_t c = p[i];
+    if (c < 0x80) {
+      ++i;
+      continue;
+    }
+    size_t length;
+    uint8_t min = 0x80;
+    uint8_t max = 0xbf;
+    if (c >= 0xc2 && c <= 0xdf) {
+      length = 2;
+    } else if (c >= 0xe0 && c <= 0xef) {
+      length = 3;
+      if (c == 0xe0) min = 0xa0;
+      if (c == 0xed) max = 0x9f;
+    } else if (c >= 0xf0 && c <= 0xf4) {
+      length = 4;
+      if (c == 0xf0) min = 0x90;
+      if (c == 0xf4) max = 0x8f;
+    } else {
+      return i;
+    }
+    if (i + 1 >= size || p[i + 1] < min || p[i + 1] > max) return i + 1;
+    for (size_t j = 2; j < length; ++j) {
+      if (i + j >= size || (p[i + j] & 0xc0) != 0x80) return i + j;
+    }
+    i += length;
+  }
+  return size;
+}
+
+// Characters that end a number or a literal.
+bool IsScalarEnd(char c) {
+  switch (c) {
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+    case ':':
+    case ',':
+    case '"':
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Accepts the same numbers as JsonParse().
+bool IsValidNumber(absl::string_view number) {
+  enum class State { kStart, kNumber, kZero, kDot, kDecimal, kE, kExponent };
+  State state = State::kStart;
+  for (char c : number) {
+    const bool digit = c >= '0' && c <= '9';
+    switch (state) {
+      case State::kStart:
+        if (c == '0') {
+          state = State::kZero;
+        } else if (digit || c == '-') {
+          state = State::kNumber;
+        } else {
+          return false;
+        }
+        break;
+      case State::kNumber:
+        if (digit) break;
+        if (c == 'e' || c == 'E') {
+          state = State::kE;
+        } else if (c == '.') {
+          state = State::kDot;
+        } else {
+          return false;
+        }
+        break;
+      case State::kZero:
+        if (c != '.') return false;
+        state = State::kDot;
+        break;
+      case State::kDot:
+        if (!digit) return false;
+        state = State::kDecimal;
+        break;
+      case State::kDecimal:
+        if (digit) break;
+        if (c != 'e' && c != 'E') return false;
+        state = State::kE;
+        break;
+      case State::kE:
+        if (!digit && c != '+' && c != '-') return false;
+        state = State::kExponent;
+        break;
+      case State::kExponent:
+        if (!digit) return false;
+        break;
+    }
+  }
+  return state == State::kNumber || state == State::kZero ||
+         state == State::kDecimal || state == State::kExponent;
+}
+
+bool ParseHex4(const char* p, uint32_t* value) {
+  *value = 0;
+  for (int i = 0; i < 4; ++i) {
+    const char c = p[i];
+    uint32_t digit;
+    if (c >= '0' && c <= '9') {
+      digit = c - '0';
+    } else if (c >= 'A' && c <= 'F') {
+      digit = c - 'A' + 10;
+    } else if (c >= 'a' && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else {
+      return false;
+    }
+    *value = (*value << 4) | digit;
+  }
+  return true;
+}
+
+char* AppendUtf8(uint32_t c, char* out) {
+  if (c <= 0x7f) {
+    *out++ = static_cast<char>(c);
+  } else if (c <= 0x7ff) {
+    *out++ = static_cast<char>(0xc0 | (c >> 6));
+    *out++ = static_cast<char>(0x80 | (c & 0x3f));
+  } else if (c <= 0xffff) {
+    *out++ = static_cast<char>(0xe0 | (c >> 12));
+    *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+    *out++ = static_cast<char>(0x80 | (c & 0x3f));
+  } else {
+    *out++ = static_cast<char>(0xf0 | (c >> 18));
+    *out++ = static_cast<char>(0x80 | ((c >> 12) & 0x3f));
+    *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+    *out++ = static_cast<char>(0x80 | (c & 0x3f));
+  }
+  return out;
+}
+
+}  // namespace
+
+//
+// JsonView
+//
+
+const JsonView::Node JsonView::kNullNode = {Json::Type::kNull, 0, {false}};
+
+absl::optional<JsonView> JsonView::Find(absl::string_view key) const {
+  const Member* begin = node_->members;
+  const Member* end = begin + node_->size;
+  const Member* it = std::lower_bound(
+      begin, end, key,
+      [](const Member& member, absl::string_view key) {
+        return member.key < key;
+      });
+  if (it == end || it->key != key) return absl::nullopt;
+  return JsonView(&it->value);
+}
+
+Json JsonView::ToJson() const {
+  switch (type()) {
+    case Json::Type::kNull:
+      return Json();
+    case Json::Type::kBoolean:
+      return Json::FromBool(boolean());
+    case Json::Type::kNumber:
+      return Json::FromNumber(std::string(string()));
+    case Json::Type::kString:
+      return Json::FromString(std::string(string()));
+    case Json::Type::kObject: {
+      Json::Object object;
+      for (size_t i = 0; i < size(); ++i) {
+        object.emplace_hint(object.end(), std::string(key(i)),
+                            value(i).ToJson());
+      }
+      return Json::FromObject(std::move(object));
+    }
+    case Json::Type::kArray: {
+      Json::Array array;
+      array.reserve(size());
+      for (size_t i = 0; i < size(); ++i) {
+        array.push_back(element(i).ToJson());
+      }
+      return Json::FromArray(std::move(array));
+    }
+  }
+  GPR_UNREACHABLE_CODE(return Json());
+}
+
+//
+// JsonDocument::Parser
+//
+
+class JsonDocument::Parser {
+ public:
+  explicit Parser(absl::string_view input)
+      // JsonParse() stops at the first NUL.
+      : input_(input.substr(0, input.find('\0'))) {}
+
+  absl::StatusOr<JsonDocument> Parse();
+
+ private:
+  using Node = JsonView::Node;
+  using Member = JsonView::Member;
+
+  struct Scope {
+    Json::Type type;
+    // Index in children_ of the first child of this container.
+    size_t first_child;
+    // The key of this container in its parent, if the parent is an object.
+    absl::string_view key;
+  };
+
+  // First pass: finds the position of every structural character, string
+  // and scalar in the input, and counts the values.
+  bool IndexStructurals();
+  // Second pass: builds the DOM from index_.
+  bool BuildDom();
+
+  bool StartContainer(size_t pos, Json::Type type);
+  bool EndContainer(size_t pos);
+  void AddValue(const Node& node);
+  bool ParseString(size_t pos, absl::string_view* str);
+  bool ParseScalar(size_t pos, Node* node);
+
+  // Allocates an array of n T's in the arena.
+  template <typename T>
+  T* Allocate(size_t n) {
+    const size_t bytes = n * sizeof(T);
+    if (static_cast<size_t>(arena_end_ - arena_next_) < bytes) return nullptr;
+    T* result = reinterpret_cast<T*>(arena_next_);
+    arena_next_ += bytes;
+    return result;
+  }
+
+  void AddError(std::string error);
+  bool ParseError(size_t pos) {
+    AddError(absl::StrCat("JSON parse error at index ", pos));
+    return false;
+  }
+  absl::Status ErrorStatus();
+
+  const absl::string_view input_;
+  // Positions of the structural characters, the opening quotes of strings,
+  // and the first characters of scalars.
+  std::vector<uint32_t> index_;
+  // An upper bound for the number of values, except for the root.
+  size_t num_values_ = 0;
+
+  std::unique_ptr<char[]> arena_;
+  Node* root_ = nullptr;
+  char* arena_next_ = nullptr;
+  char* arena_end_ = nullptr;
+  // The copy of the input in the arena.
+  char* buf_ = nullptr;
+
+  std::vector<Scope> stack_;
+  // The values of the containers that are being parsed.  They are moved to
+  // the arena once their container ends.
+  std::vector<Member> children_;
+  absl::string_view key_;
+
+  std::vector<std::string> errors_;
+  bool truncated_errors_ = false;
+};
+
+absl::StatusOr<JsonDocument> JsonDocument::Parser::Parse() {
+  if (!IndexStructurals() || !BuildDom() || !errors_.empty()) {
+    return ErrorStatus();
+  }
+  return JsonDocument(std::move(arena_), root_);
+}
+
+bool JsonDocument::Parser::IndexStructurals() {
+  const size_t size = input_.size();
+  if (size > std::numeric_limits<uint32_t>::max()) {
+    AddError("JSON document too large");
+    return false;
+  }
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(input_.data());
+  // Most documents have a structural character every few bytes.
+  index_.reserve(size / 4 + 1);
+  uint64_t prev_escaped = 0;
+  uint64_t prev_in_string = 0;
+  uint64_t prev_scalar = 0;
+  size_t first_non_ascii = size;
+  int64_t num_values = 0;
+  uint8_t last_block[kBlockSize];
+  for (size_t offset = 0; offset < size; offset += kBlockSize) {
+    const uint8_t* block = data + offset;
+    if (size - offset < kBlockSize) {
+      memset(last_block, ' ', kBlockSize);
+      memcpy(last_block, block, size - offset);
+      block = last_block;
+    }
+    const BlockMasks masks = ClassifyBlock(block);
+    if (masks.non_ascii && first_non_ascii == size) first_non_ascii = offset;
+    // Find the strings.  in_string covers the opening quote and the
+    // contents of each string, and string_tail the contents and the
+    // closing quote.
+    const uint64_t escaped = FindEscaped(masks.backslash, &prev_escaped);
+    const uint64_t quote = masks.quote & ~escaped;
+    const uint64_t in_string = PrefixXor(quote) ^ prev_in_string;
+    prev_in_string =
+        static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+    const uint64_t string_tail = in_string ^ quote;
+    if ((masks.control & in_string) != 0) {
+      return ParseError(offset +
+                        CountTrailingZeros(masks.control & in_string));
+    }
+    // Scalars are runs of anything else.
+    const uint64_t scalar = ~(masks.op | masks.whitespace | masks.quote);
+    const uint64_t scalar_start = scalar & ~((scalar << 1) | prev_scalar);
+    prev_scalar = scalar >> 63;
+    uint64_t structurals = (masks.op | quote | scalar_start) & ~string_tail;
+    // Every opening quote, scalar and container is a value, except for
+    // the keys, which are each followed by a colon.
+    num_values += PopCount((quote | scalar_start | masks.open) & ~string_tail);
+    num_values -= PopCount(masks.colon & ~string_tail);
+    if (structurals == 0) continue;
+    size_t next = index_.size();
+    index_.resize(next + PopCount(structurals));
+    while (structurals != 0) {
+      index_[next++] =
+          static_cast<uint32_t>(offset + CountTrailingZeros(structurals));
+      structurals &= structurals - 1;
+    }
+  }
+  if (prev_in_string != 0) return ParseError(size);
+  if (first_non_ascii < size) {
+    const size_t invalid = FindInvalidUtf8(data + first_non_ascii,
+                                           size - first_non_ascii);
+    if (invalid < size - first_non_ascii) {
+      return ParseError(first_non_ascii + invalid);
+    }
+  }
+  num_values_ = static_cast<size_t>(std::max<int64_t>(num_values, 0));
+  return true;
+}
+
+bool JsonDocument::Parser::BuildDom() {
+  // A single allocation holds the root, the children of every container
+  // and a padded copy of the input.  Member is bigger than Node, so this
+  // is enough room whatever mix of objects and arrays the document has.
+  static_assert(sizeof(Member) % alignof(Node) == 0, "");
+  static_assert(sizeof(Node) % alignof(Member) == 0, "");
+  const size_t nodes_size = sizeof(Node) + num_values_ * sizeof(Member);
+  arena_.reset(new char[nodes_size + input_.size() + kPadding]);
+  root_ = new (arena_.get()) Node(JsonView::kNullNode);
+  arena_next_ = arena_.get() + sizeof(Node);
+  arena_end_ = arena_.get() + nodes_size;
+  buf_ = arena_end_;
+  memcpy(buf_, input_.data(), input_.size());
+  memset(buf_ + input_.size(), ' ', kPadding);
+  enum class State { kValue, kFirstElement, kFirstKey, kKey, kAfterValue };
+  State state = State::kValue;
+  for (size_t i = 0; i < index_.size(); ++i) {
+    const size_t pos = index_[i];
+    const char c = buf_[pos];
+    switch (state) {
+      case State::kFirstKey:
+        if (c == '}') {
+          if (!EndContainer(pos)) return false;
+          state = State::kAfterValue;
+          break;
+        }
+        ABSL_FALLTHROUGH_INTENDED;
+      case State::kKey:
+        if (c != '"') return ParseError(pos);
+        if (!ParseString(pos, &key_)) return false;
+        if (i + 1 == index_.size()) return ParseError(input_.size());
+        if (buf_[index_[i + 1]] != ':') return ParseError(index_[i + 1]);
+        ++i;
+        state = State::kValue;
+        break;
+      case State::kFirstElement:
+        if (c == ']') {
+          if (!EndContainer(pos)) return false;
+          state = State::kAfterValue;
+          break;
+        }
+        ABSL_FALLTHROUGH_INTENDED;
+      case State::kValue:
+        switch (c) {
+          case '{':
+            if (!StartContainer(pos, Json::Type::kObject)) return false;
+            state = State::kFirstKey;
+            break;
+          case '[':
+            if (!StartContainer(pos, Json::Type::kArray)) return false;
+            state = State::kFirstElement;
+            break;
+          case '}':
+          case ']':
+          case ':':
+          case ',':
+            return ParseError(pos);
+          case '"': {
+            absl::string_view str;
+            if (!ParseString(pos, &str)) return false;
+            Node node;
+            node.type = Json::Type::kString;
+            node.size = static_cast<uint32_t>(str.size());
+            node.string = str.data();
+            AddValue(node);
+            state = State::kAfterValue;
+            break;
+          }
+          default: {
+            Node node;
+            if (!ParseScalar(pos, &node)) return false;
+            AddValue(node);
+            state = State::kAfterValue;
+            break;
+          }
+        }
+        break;
+      case State::kAfterValue:
+        if (stack_.empty()) return ParseError(pos);
+        if (c == ',') {
+          state = stack_.back().type == Json::Type::kObject ? State::kKey
+                                                            : State::kValue;
+        } else if (c == (stack_.back().type == Json::Type::kObject ? '}'
+                                                                    : ']')) {
+          if (!EndContainer(pos)) return false;
+        } else {
+          return ParseError(pos);
+        }
+        break;
+    }
+  }
+  if (state != State::kAfterValue || !stack_.empty()) {
+    return ParseError(input_.size());
+  }
+  return true;
+}
+
+bool JsonDocument::Parser::StartContainer(size_t pos, Json::Type type) {
+  if (stack_.size() == kMaxDepth) {
+    AddError(absl::StrFormat("exceeded max stack depth (%d) at index %" PRIuPTR,
+                             kMaxDepth, pos));
+    return ParseError(pos);
+  }
+  stack_.push_back(Scope{type, children_.size(), key_});
+  return true;
+}
+
+bool JsonDocument::Parser::EndContainer(size_t pos) {
+  const Scope scope = stack_.back();
+  stack_.pop_back();
+  Member* first = children_.data() + scope.first_child;
+  const size_t count = children_.size() - scope.first_child;
+  Node node;
+  node.type = scope.type;
+  node.size = static_cast<uint32_t>(count);
+  if (scope.type == Json::Type::kArray) {
+    Node* elements = Allocate<Node>(count);
+    if (elements == nullptr) return ParseError(pos);
+    for (size_t i = 0; i < count; ++i) new (&elements[i]) Node(first[i].value);
+    node.elements = elements;
+  } else {
+    std::sort(first, first + count, [](const Member& a, const Member& b) {
+      return a.key < b.key;
+    });
+    for (size_t i = 1; i < count; ++i) {
+      if (first[i - 1].key != first[i].key) continue;
+      // Report the position of the later one, as JsonParse() does.  Keys
+      // are decoded in place, so their position in buf_ is that of their
+      // opening quote plus one.
+      const char* later = std::max(first[i - 1].key.data(),
+                                   first[i].key.data());
+      AddError(absl::StrFormat("duplicate key \"%s\" at index %" PRIuPTR,
+                               first[i].key, later - buf_ - 1));
+    }
+    Member* members = Allocate<Member>(count);
+    if (members == nullptr) return ParseError(pos);
+    std::uninitialized_copy(first, first + count, members);
+    node.members = members;
+  }
+  children_.resize(scope.first_child);
+  key_ = scope.key;
+  AddValue(node);
+  return true;
+}
+
+void JsonDocument::Parser::AddValue(const Node& node) {
+  if (stack_.empty()) {
+    *root_ = node;
+  } else {
+    children_.push_back(Member{key_, node});
+  }
+}
+
+bool JsonDocument::Parser::ParseString(size_t pos, absl::string_view* str) {
+  char* const start = buf_ + pos + 1;
+  char* in = start;
+  // Skip to the first quote or backslash, 8 bytes at a time.  The first
+  // pass made sure that the string is terminated.
+  while (true) {
+    const uint64_t w = LoadWord(reinterpret_cast<const uint8_t*>(in));
+    const uint64_t found = BytesEqualTo(w, '"') | BytesEqualTo(w, '\\');
+    if (found != 0) {
+      in += CountTrailingZeros(found) / 8;
+      break;
+    }
+    in += 8;
+  }
+  // Decode escape sequences in place.  Decoding never makes the string
+  // longer.
+  char* out = in;
+  while (*in != '"') {
+    if (*in != '\\') {
+      *out++ = *in++;
+      continue;
+    }
+    const size_t escape_pos = in + 1 - buf_;
+    in += 2;
+    switch (buf_[escape_pos]) {
+      case '"':
+      case '\\':
+      case '/':
+        *out++ = buf_[escape_pos];
+        break;
+      case 'b':
+        *out++ = '\b';
+        break;
+      case 'f':
+        *out++ = '\f';
+        break;
+      case 'n':
+        *out++ = '\n';
+        break;
+      case 'r':
+        *out++ = '\r';
+        break;
+      case 't':
+        *out++ = '\t';
+        break;
+      case 'u': {
+        uint32_t c;
+        if (!ParseHex4(in, &c)) return ParseError(in - buf_);
+        in += 4;
+        if ((c & 0xfc00) == 0xd800) {
+          // A high surrogate must be followed by a low one.
+          uint32_t low;
+          if (in[0] != '\\' || in[1] != 'u' || !ParseHex4(in + 2, &low) ||
+              (low & 0xfc00) != 0xdc00) {
+            return ParseError(in - buf_);
+          }
+          in += 6;
+          c = 0x10000 + ((c - 0xd800) << 10) + (low - 0xdc00);
+        } else if ((c & 0xfc00) == 0xdc00) {
+          return ParseError(in - 1 - buf_);
+        }
+        out = AppendUtf8(c, out);
+        break;
+      }
+      default:
+        return ParseError(escape_pos);
+    }
+  }
+  *str = absl::string_view(start, out - start);
+  return true;
+}
+
+bool JsonDocument::Parser::ParseScalar(size_t pos, Node* node) {
+  const char* start = buf_ + pos;
+  const char* end = start;
+  // The padding ensures that this stops before the end of the buffer.
+  while (!IsScalarEnd(*end)) ++end;
+  const absl::string_view scalar(start, end - start);
+  if (scalar == "true" || scalar == "false") {
+    node->type = Json::Type::kBoolean;
+    node->size = 0;
+    node->boolean = scalar == "true";
+  } else if (scalar == "null") {
+    *node = JsonView::kNullNode;
+  } else if (IsValidNumber(scalar)) {
+    node->type = Json::Type::kNumber;
+    node->size = static_cast<uint32_t>(scalar.size());
+    node->string = start;
+  } else {
+    return ParseError(pos);
+  }
+  return true;
+}
+
+void JsonDocument::Parser::AddError(std::string error) {
+  if (errors_.size() == kMaxErrors) {
+    truncated_errors_ = true;
+  } else {
+    errors_.push_back(std::move(error));
+  }
+}
+
+absl::Status JsonDocument::Parser::ErrorStatus() {
+  if (truncated_errors_) {
+    errors_.push_back(
+        "too many errors encountered during JSON parsing -- fix reported "
+        "errors and try again to see additional errors");
+  }
+  return absl::InvalidArgumentError(absl::StrCat(
+      "JSON parsing failed: [", absl::StrJoin(errors_, "; "), "]"));
+}
+
+//
+// JsonDocument
+//
+
+absl::StatusOr<JsonDocument> JsonDocument::Parse(absl::string_view json_str) {
+  return Parser(json_str).Parse();
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,133 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_LIB_JSON_JSON_DOCUMENT_H
+#define GRPC_SRC_CORE_LIB_JSON_JSON_DOCUMENT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include "src/core/lib/json/json.h"
+
+// A read-only JSON DOM that is parsed in two passes, in the style of
+// simdjson: the first pass finds the position of every token 64 bytes at a
+// time, and the second one builds the DOM.  All of the nodes and strings of
+// a document live in a single arena that is allocated once, after the first
+// pass has counted how many values there are.  Strings and numbers point
+// into a copy of the input held in that arena, and strings with escape
+// sequences are decoded in place.
+//
+// Accepts the same documents as JsonParse().  Use JsonView::ToJson() to get
+// a mutable Json, or LoadFromJson() in json_object_loader.h to load C++
+// objects directly from a JsonView.
+
+namespace grpc_core {
+
+class JsonDocument;
+
+// A value in a JsonDocument.  Cheap to copy; valid for as long as the
+// document it came from.
+class JsonView {
+ public:
+  // A null value.
+  JsonView() = default;
+
+  Json::Type type() const { return node_->type; }
+
+  // For kBoolean.
+  bool boolean() const { return node_->boolean; }
+
+  // For kString and kNumber.  Numbers are returned in the form they had in
+  // the input.
+  absl::string_view string() const {
+    return absl::string_view(node_->string, node_->size);
+  }
+
+  // For kArray and kObject: the number of elements or members.
+  size_t size() const { return node_->size; }
+
+  // For kArray.
+  JsonView element(size_t i) const { return JsonView(&node_->elements[i]); }
+
+  // For kObject.  Members are sorted by key.
+  absl::string_view key(size_t i) const { return node_->members[i].key; }
+  JsonView value(size_t i) const { return JsonView(&node_->members[i].value); }
+
+  // For kObject.  Returns the value of the member with the given key, if
+  // there is one.
+  absl::optional<JsonView> Find(absl::string_view key) const;
+
+  // Returns a copy of this value as a Json.
+  Json ToJson() const;
+
+ private:
+  friend class JsonDocument;
+
+  struct Member;
+
+  struct Node {
+    Json::Type type;
+    uint32_t size;
+    union {
+      bool boolean;
+      const char* string;
+      const Node* elements;
+      const Member* members;
+    };
+  };
+
+  struct Member {
+    absl::string_view key;
+    Node value;
+  };
+
+  explicit JsonView(const Node* node) : node_(node) {}
+
+  static const Node kNullNode;
+
+  const Node* node_ = &kNullNode;
+};
+
+class JsonDocument {
+ public:
+  // Parses json_str.  The document does not refer to json_str once this
+  // returns.
+  static absl::StatusOr<JsonDocument> Parse(absl::string_view json_str);
+
+  JsonView root() const { return JsonView(root_); }
+
+ private:
+  class Parser;
+
+  JsonDocument(std::unique_ptr<char[]> arena, const JsonView::Node* root)
+      : arena_(std::move(arena)), root_(root) {}
+
+  std::unique_ptr<char[]> arena_;
+  const JsonView::Node* root_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_LIB_JSON_JSON_DOCUMENT_H
@@ -16,6 +16,7 @@
 
 #include "src/core/lib/json/json_object_loader.h"
 
+#include <string>
 #include <utility>
 
 #include "absl/strings/ascii.h"
@@ -27,6 +28,11 @@
 namespace grpc_core {
 namespace json_detail {
 
+void LoaderInterface::LoadViewInto(const JsonView& json, const JsonArgs& args,
+                                   void* dst, ValidationErrors* errors) const {
+  LoadInto(json.ToJson(), args, dst, errors);
+}
+
 void LoadScalar::LoadInto(const Json& json, const JsonArgs& /*args*/, void* dst,
                           ValidationErrors* errors) const {
   // We accept either kString or kNumber for numeric values, as per
@@ -40,16 +46,27 @@ void LoadScalar::LoadInto(const Json& json, const JsonArgs& /*args*/, void* dst,
   return LoadInto(json.string(), dst, errors);
 }
 
+void LoadScalar::LoadViewInto(const JsonView& json, const JsonArgs& /*args*/,
+                              void* dst, ValidationErrors* errors) const {
+  if (json.type() != Json::Type::kString &&
+      (!IsNumber() || json.type() != Json::Type::kNumber)) {
+    errors->AddError(
+        absl::StrCat("is not a ", IsNumber() ? "number" : "string"));
+    return;
+  }
+  return LoadInto(json.string(), dst, errors);
+}
+
 bool LoadString::IsNumber() const { return false; }
 
-void LoadString::LoadInto(const std::string& value, void* dst,
+void LoadString::LoadInto(absl::string_view value, void* dst,
                           ValidationErrors*) const {
-  *static_cast<std::string*>(dst) = value;
+  *static_cast<std::string*>(dst) = std::string(value);
 }
 
 bool LoadDuration::IsNumber() const { return false; }
 
-void LoadDuration::LoadInto(const std::string& value, void* dst,
+void LoadDuration::LoadInto(absl::string_view value, void* dst,
                             ValidationErrors* errors) const {
   absl::string_view buf(value);
   if (!absl::ConsumeSuffix(&buf, "s")) {
@@ -100,6 +117,15 @@ void LoadBool::LoadInto(const Json& json, const JsonArgs&, void* dst,
   *static_cast<bool*>(dst) = json.boolean();
 }
 
+void LoadBool::LoadViewInto(const JsonView& json, const JsonArgs&, void* dst,
+                            ValidationErrors* errors) const {
+  if (json.type() != Json::Type::kBoolean) {
+    errors->AddError("is not a boolean");
+    return;
+  }
+  *static_cast<bool*>(dst) = json.boolean();
+}
+
 void LoadUnprocessedJsonObject::LoadInto(const Json& json, const JsonArgs&,
                                          void* dst,
                                          ValidationErrors* errors) const {
@@ -135,6 +161,20 @@ void LoadVector::LoadInto(const Json& json, const JsonArgs& args, void* dst,
   }
 }
 
+void LoadVector::LoadViewInto(const JsonView& json, const JsonArgs& args,
+                              void* dst, ValidationErrors* errors) const {
+  if (json.type() != Json::Type::kArray) {
+    errors->AddError("is not an array");
+    return;
+  }
+  const LoaderInterface* element_loader = ElementLoader();
+  for (size_t i = 0; i < json.size(); ++i) {
+    ValidationErrors::ScopedField field(errors, absl::StrCat("[", i, "]"));
+    void* element = EmplaceBack(dst);
+    element_loader->LoadViewInto(json.element(i), args, element, errors);
+  }
+}
+
 void AutoLoader<std::vector<bool>>::LoadInto(const Json& json,
                                              const JsonArgs& args, void* dst,
                                              ValidationErrors* errors) const {
@@ -153,6 +193,23 @@ void AutoLoader<std::vector<bool>>::LoadInto(const Json& json,
   }
 }
 
+void AutoLoader<std::vector<bool>>::LoadViewInto(
+    const JsonView& json, const JsonArgs& args, void* dst,
+    ValidationErrors* errors) const {
+  if (json.type() != Json::Type::kArray) {
+    errors->AddError("is not an array");
+    return;
+  }
+  const LoaderInterface* element_loader = LoaderForType<bool>();
+  std::vector<bool>* vec = static_cast<std::vector<bool>*>(dst);
+  for (size_t i = 0; i < json.size(); ++i) {
+    ValidationErrors::ScopedField field(errors, absl::StrCat("[", i, "]"));
+    bool elem = false;
+    element_loader->LoadViewInto(json.element(i), args, &elem, errors);
+    vec->push_back(elem);
+  }
+}
+
 void LoadMap::LoadInto(const Json& json, const JsonArgs& args, void* dst,
                        ValidationErrors* errors) const {
   if (json.type() != Json::Type::kObject) {
@@ -168,6 +225,21 @@ void LoadMap::LoadInto(const Json& json, const JsonArgs& args, void* dst,
   }
 }
 
+void LoadMap::LoadViewInto(const JsonView& json, const JsonArgs& args,
+                           void* dst, ValidationErrors* errors) const {
+  if (json.type() != Json::Type::kObject) {
+    errors->AddError("is not an object");
+    return;
+  }
+  const LoaderInterface* element_loader = ElementLoader();
+  for (size_t i = 0; i < json.size(); ++i) {
+    ValidationErrors::ScopedField field(
+        errors, absl::StrCat("[\"", json.key(i), "\"]"));
+    void* element = Insert(std::string(json.key(i)), dst);
+    element_loader->LoadViewInto(json.value(i), args, element, errors);
+  }
+}
+
 void LoadWrapped::LoadInto(const Json& json, const JsonArgs& args, void* dst,
                            ValidationErrors* errors) const {
   void* element = Emplace(dst);
@@ -176,6 +248,14 @@ void LoadWrapped::LoadInto(const Json& json, const JsonArgs& args, void* dst,
   if (errors->size() > starting_error_size) Reset(dst);
 }
 
+void LoadWrapped::LoadViewInto(const JsonView& json, const JsonArgs& args,
+                               void* dst, ValidationErrors* errors) const {
+  void* element = Emplace(dst);
+  size_t starting_error_size = errors->size();
+  ElementLoader()->LoadViewInto(json, args, element, errors);
+  if (errors->size() > starting_error_size) Reset(dst);
+}
+
 bool LoadObject(const Json& json, const JsonArgs& args, const Element* elements,
                 size_t num_elements, void* dst, ValidationErrors* errors) {
   if (json.type() != Json::Type::kObject) {
@@ -201,6 +281,32 @@ bool LoadObject(const Json& json, const JsonArgs& args, const Element* elements,
   return true;
 }
 
+bool LoadObject(const JsonView& json, const JsonArgs& args,
+                const Element* elements, size_t num_elements, void* dst,
+                ValidationErrors* errors) {
+  if (json.type() != Json::Type::kObject) {
+    errors->AddError("is not an object");
+    return false;
+  }
+  for (size_t i = 0; i < num_elements; ++i) {
+    const Element& element = elements[i];
+    if (element.enable_key != nullptr && !args.IsEnabled(element.enable_key)) {
+      continue;
+    }
+    ValidationErrors::ScopedField field(errors,
+                                        absl::StrCat(".", element.name));
+    absl::optional<JsonView> value = json.Find(element.name);
+    if (!value.has_value() || value->type() == Json::Type::kNull) {
+      if (element.optional) continue;
+      errors->AddError("field not present");
+      continue;
+    }
+    char* field_dst = static_cast<char*>(dst) + element.member_offset;
+    element.loader->LoadViewInto(*value, args, field_dst, errors);
+  }
+  return true;
+}
+
 const Json* GetJsonObjectField(const Json::Object& json,
                                absl::string_view field,
                                ValidationErrors* errors, bool required) {
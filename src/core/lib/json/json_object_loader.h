@@ -39,6 +39,7 @@
 #include "src/core/lib/gprpp/validation_errors.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/json/json_args.h"
+#include "src/core/lib/json/json_document.h"
 
 // Provides a means to load JSON objects into C++ objects, with the aim of
 // minimizing object code size.
@@ -71,6 +72,10 @@
 //   };
 // Now we can load Foo objects from JSON:
 //   absl::StatusOr<Foo> foo = LoadFromJson<Foo>(json);
+// or directly from a JsonDocument, without building a Json first:
+//   absl::StatusOr<Foo> foo = LoadFromJson<Foo>(document.root());
+// Loaders for types with a JsonPostLoad() method still convert their part
+// of the document to a Json, since that is what JsonPostLoad() takes.
 namespace grpc_core {
 
 namespace json_detail {
@@ -83,6 +88,11 @@ class LoaderInterface {
   virtual void LoadInto(const Json& json, const JsonArgs& args, void* dst,
                         ValidationErrors* errors) const = 0;
 
+  // Same as LoadInto(), but reads from a JsonView.  The default converts
+  // json to a Json and calls LoadInto().
+  virtual void LoadViewInto(const JsonView& json, const JsonArgs& args,
+                            void* dst, ValidationErrors* errors) const;
+
  protected:
   ~LoaderInterface() = default;
 };
@@ -92,6 +102,8 @@ class LoadScalar : public LoaderInterface {
  public:
   void LoadInto(const Json& json, const JsonArgs& args, void* dst,
                 ValidationErrors* errors) const override;
+  void LoadViewInto(const JsonView& json, const JsonArgs& args, void* dst,
+                    ValidationErrors* errors) const override;
 
  protected:
   ~LoadScalar() = default;
@@ -102,7 +114,7 @@ class LoadScalar : public LoaderInterface {
   // needing an instance variable.
   virtual bool IsNumber() const = 0;
 
-  virtual void LoadInto(const std::string& json, void* dst,
+  virtual void LoadInto(absl::string_view json, void* dst,
                         ValidationErrors* errors) const = 0;
 };
 
@@ -113,7 +125,7 @@ class LoadString : public LoadScalar {
 
  private:
   bool IsNumber() const override;
-  void LoadInto(const std::string& value, void* dst,
+  void LoadInto(absl::string_view value, void* dst,
                 ValidationErrors* errors) const override;
 };
 
@@ -124,7 +136,7 @@ class LoadDuration : public LoadScalar {
 
  private:
   bool IsNumber() const override;
-  void LoadInto(const std::string& value, void* dst,
+  void LoadInto(absl::string_view value, void* dst,
                 ValidationErrors* errors) const override;
 };
 
@@ -144,7 +156,7 @@ class TypedLoadSignedNumber : public LoadNumber {
   ~TypedLoadSignedNumber() = default;
 
  private:
-  void LoadInto(const std::string& value, void* dst,
+  void LoadInto(absl::string_view value, void* dst,
                 ValidationErrors* errors) const override {
     if (!absl::SimpleAtoi(value, static_cast<T*>(dst))) {
       errors->AddError("failed to parse number");
@@ -159,7 +171,7 @@ class TypedLoadUnsignedNumber : public LoadNumber {
   ~TypedLoadUnsignedNumber() = default;
 
  private:
-  void LoadInto(const std::string& value, void* dst,
+  void LoadInto(absl::string_view value, void* dst,
                 ValidationErrors* errors) const override {
     if (!absl::SimpleAtoi(value, static_cast<T*>(dst))) {
       errors->AddError("failed to parse non-negative number");
@@ -173,7 +185,7 @@ class LoadFloat : public LoadNumber {
   ~LoadFloat() = default;
 
  private:
-  void LoadInto(const std::string& value, void* dst,
+  void LoadInto(absl::string_view value, void* dst,
                 ValidationErrors* errors) const override {
     if (!absl::SimpleAtof(value, static_cast<float*>(dst))) {
       errors->AddError("failed to parse floating-point number");
@@ -187,7 +199,7 @@ class LoadDouble : public LoadNumber {
   ~LoadDouble() = default;
 
  private:
-  void LoadInto(const std::string& value, void* dst,
+  void LoadInto(absl::string_view value, void* dst,
                 ValidationErrors* errors) const override {
     if (!absl::SimpleAtod(value, static_cast<double*>(dst))) {
       errors->AddError("failed to parse floating-point number");
@@ -200,6 +212,8 @@ class LoadBool : public LoaderInterface {
  public:
   void LoadInto(const Json& json, const JsonArgs& /*args*/, void* dst,
                 ValidationErrors* errors) const override;
+  void LoadViewInto(const JsonView& json, const JsonArgs& /*args*/, void* dst,
+                    ValidationErrors* errors) const override;
 
  protected:
   ~LoadBool() = default;
@@ -230,6 +244,8 @@ class LoadVector : public LoaderInterface {
  public:
   void LoadInto(const Json& json, const JsonArgs& args, void* dst,
                 ValidationErrors* errors) const override;
+  void LoadViewInto(const JsonView& json, const JsonArgs& args, void* dst,
+                    ValidationErrors* errors) const override;
 
  protected:
   ~LoadVector() = default;
@@ -244,6 +260,8 @@ class LoadMap : public LoaderInterface {
  public:
   void LoadInto(const Json& json, const JsonArgs& args, void* dst,
                 ValidationErrors* errors) const override;
+  void LoadViewInto(const JsonView& json, const JsonArgs& args, void* dst,
+                    ValidationErrors* errors) const override;
 
  protected:
   ~LoadMap() = default;
@@ -258,6 +276,8 @@ class LoadWrapped : public LoaderInterface {
  public:
   void LoadInto(const Json& json, const JsonArgs& args, void* dst,
                 ValidationErrors* errors) const override;
+  void LoadViewInto(const JsonView& json, const JsonArgs& args, void* dst,
+                    ValidationErrors* errors) const override;
 
  protected:
   ~LoadWrapped() = default;
@@ -283,6 +303,10 @@ class AutoLoader final : public LoaderInterface {
                 ValidationErrors* errors) const override {
     T::JsonLoader(args)->LoadInto(json, args, dst, errors);
   }
+  void LoadViewInto(const JsonView& json, const JsonArgs& args, void* dst,
+                    ValidationErrors* errors) const override {
+    T::JsonLoader(args)->LoadViewInto(json, args, dst, errors);
+  }
 
  private:
   ~AutoLoader() = default;
@@ -369,6 +393,8 @@ class AutoLoader<std::vector<bool>> final : public LoaderInterface {
  public:
   void LoadInto(const Json& json, const JsonArgs& args, void* dst,
                 ValidationErrors* errors) const override;
+  void LoadViewInto(const JsonView& json, const JsonArgs& args, void* dst,
+                    ValidationErrors* errors) const override;
 
  private:
   ~AutoLoader() = default;
@@ -509,6 +535,9 @@ class Vec<T, 0> {
 // Returns false if the JSON object was not of type Json::Type::kObject.
 bool LoadObject(const Json& json, const JsonArgs& args, const Element* elements,
                 size_t num_elements, void* dst, ValidationErrors* errors);
+bool LoadObject(const JsonView& json, const JsonArgs& args,
+                const Element* elements, size_t num_elements, void* dst,
+                ValidationErrors* errors);
 
 // Adaptor type - takes a compile time computed list of elements and
 // implements LoaderInterface by calling LoadObject.
@@ -523,6 +552,11 @@ class FinishedJsonObjectLoader final : public LoaderInterface {
     LoadObject(json, args, elements_.data(), elements_.size(), dst, errors);
   }
 
+  void LoadViewInto(const JsonView& json, const JsonArgs& args, void* dst,
+                    ValidationErrors* errors) const override {
+    LoadObject(json, args, elements_.data(), elements_.size(), dst, errors);
+  }
+
  private:
   GPR_NO_UNIQUE_ADDRESS Vec<Element, kElemCount> elements_;
 };
@@ -624,6 +658,27 @@ T LoadFromJson(const Json& json, const JsonArgs& args,
   return result;
 }
 
+template <typename T>
+absl::StatusOr<T> LoadFromJson(
+    const JsonView& json, const JsonArgs& args = JsonArgs(),
+    absl::string_view error_prefix = "errors validating JSON") {
+  ValidationErrors errors;
+  T result{};
+  json_detail::LoaderForType<T>()->LoadViewInto(json, args, &result, &errors);
+  if (!errors.ok()) {
+    return errors.status(absl::StatusCode::kInvalidArgument, error_prefix);
+  }
+  return std::move(result);
+}
+
+template <typename T>
+T LoadFromJson(const JsonView& json, const JsonArgs& args,
+               ValidationErrors* errors) {
+  T result{};
+  json_detail::LoaderForType<T>()->LoadViewInto(json, args, &result, errors);
+  return result;
+}
+
 template <typename T>
 absl::optional<T> LoadJsonObjectField(const Json::Object& json,
                                       const JsonArgs& args,
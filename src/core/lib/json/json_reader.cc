@@ -468,6 +468,10 @@ JsonReader::Status JsonReader::Run() {
                   !container_just_begun_) {
                 return Status::GRPC_JSON_PARSE_ERROR;
               }
+              // An object member with no value, as in {"a":}.
+              if (c == '}' && state_ == State::GRPC_JSON_STATE_VALUE_BEGIN) {
+                return Status::GRPC_JSON_PARSE_ERROR;
+              }
               if (c == ']' && stack_.back().type() != Json::Type::kArray) {
                 return Status::GRPC_JSON_PARSE_ERROR;
               }
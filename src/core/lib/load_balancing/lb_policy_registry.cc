@@ -18,9 +18,12 @@
 
 #include "src/core/lib/load_balancing/lb_policy_registry.h"
 
+#include <stddef.h>
+
 #include <algorithm>
 #include <initializer_list>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -34,10 +37,18 @@
 #include <grpc/support/json.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/json/json_writer.h"
 #include "src/core/lib/load_balancing/lb_policy.h"
 
 namespace grpc_core {
 
+namespace {
+
+// Maximum number of configs retained by ParseLoadBalancingConfigInterned().
+constexpr size_t kMaxInternedConfigs = 1024;
+
+}  // namespace
+
 //
 // LoadBalancingPolicyRegistry::Builder
 //
@@ -53,6 +64,9 @@ void LoadBalancingPolicyRegistry::Builder::RegisterLoadBalancingPolicyFactory(
 LoadBalancingPolicyRegistry LoadBalancingPolicyRegistry::Builder::Build() {
   LoadBalancingPolicyRegistry out;
   out.factories_ = std::move(factories_);
+  out.interned_configs_ =
+      std::make_unique<InternCache<LoadBalancingPolicy::Config>>(
+          kMaxInternedConfigs);
   return out;
 }
 
@@ -140,4 +154,11 @@ LoadBalancingPolicyRegistry::ParseLoadBalancingConfig(const Json& json) const {
   return factory->ParseLoadBalancingConfig((*policy)->second);
 }
 
+absl::StatusOr<RefCountedPtr<LoadBalancingPolicy::Config>>
+LoadBalancingPolicyRegistry::ParseLoadBalancingConfigInterned(
+    const Json& json) const {
+  return interned_configs_->GetOrCreate(
+      JsonDump(json), [&]() { return ParseLoadBalancingConfig(json); });
+}
+
 }  // namespace grpc_core
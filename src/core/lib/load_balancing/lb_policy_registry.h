@@ -25,6 +25,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 
+#include "src/core/lib/gprpp/intern_cache.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/json/json.h"
@@ -67,6 +68,13 @@ class LoadBalancingPolicyRegistry {
   absl::StatusOr<RefCountedPtr<LoadBalancingPolicy::Config>>
   ParseLoadBalancingConfig(const Json& json) const;
 
+  /// Like ParseLoadBalancingConfig(), but returns the same config object
+  /// for equal JSON.  Used for configs that are generated from data
+  /// shared by many channels (e.g., xDS resources), so that those channels
+  /// share one parsed copy instead of each holding its own.
+  absl::StatusOr<RefCountedPtr<LoadBalancingPolicy::Config>>
+  ParseLoadBalancingConfigInterned(const Json& json) const;
+
  private:
   LoadBalancingPolicyFactory* GetLoadBalancingPolicyFactory(
       absl::string_view name) const;
@@ -75,6 +83,8 @@ class LoadBalancingPolicyRegistry {
 
   std::map<absl::string_view, std::unique_ptr<LoadBalancingPolicyFactory>>
       factories_;
+  // Held by pointer so that the registry stays movable.
+  std::unique_ptr<InternCache<LoadBalancingPolicy::Config>> interned_configs_;
 };
 
 }  // namespace grpc_core
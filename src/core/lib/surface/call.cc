@@ -65,6 +65,7 @@
 #include "src/core/lib/channel/context.h"
 #include "src/core/lib/channel/status_util.h"
 #include "src/core/lib/compression/compression_internal.h"
+#include "src/core/lib/debug/call_timeline.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/experiments/experiments.h"
@@ -689,6 +690,11 @@ class FilterStackCall final : public Call {
 
   static void ReleaseCall(void* call, grpc_error_handle);
   static void DestroyCall(void* call, grpc_error_handle);
+  void FinishTimeline(CallTimeline* timeline);
+  CallTimeline* timeline() const {
+    return static_cast<CallTimeline*>(
+        context_[GRPC_CONTEXT_CALL_TIMELINE].value);
+  }
 
   static FilterStackCall* FromCallStack(grpc_call_stack* call_stack) {
     return reinterpret_cast<FilterStackCall*>(
@@ -816,6 +822,10 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
   size_t call_alloc_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(FilterStackCall)) +
       channel_stack->call_stack_size;
+  const bool sampled = CallTimeline::ShouldSample(
+      channel->call_timeline_options().sample_rate);
+  const gpr_cycle_counter timeline_start =
+      sampled ? gpr_get_cycle_counter() : gpr_cycle_counter{};
 
   std::pair<Arena*, void*> arena_with_call = Arena::CreateWithAlloc(
       initial_size, call_alloc_size, channel->allocator());
@@ -824,6 +834,14 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
   GPR_DEBUG_ASSERT(FromC(call->c_ptr()) == call);
   GPR_DEBUG_ASSERT(FromCallStack(call->call_stack()) == call);
   *out_call = call->c_ptr();
+  CallTimeline* timeline = nullptr;
+  if (sampled) {
+    timeline = arena->New<CallTimeline>(timeline_start);
+    timeline->Record(CallPhase::kArenaCreated);
+    call->ContextSet(GRPC_CONTEXT_CALL_TIMELINE, timeline, [](void* p) {
+      static_cast<CallTimeline*>(p)->~CallTimeline();
+    });
+  }
   grpc_slice path = grpc_empty_slice();
   if (call->is_client()) {
     call->final_op_.client.status_details = nullptr;
@@ -831,6 +849,7 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
     call->final_op_.client.error_string = nullptr;
     global_stats().IncrementClientCallsCreated();
     path = CSliceRef(args->path->c_slice());
+    if (timeline != nullptr) timeline->set_method(args->path->Ref());
     call->send_initial_metadata_.Set(HttpPathMetadata(),
                                      std::move(*args->path));
     if (args->authority.has_value()) {
@@ -876,6 +895,7 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
       call->arena(),      &call->call_combiner_};
   add_init_error(&error, grpc_call_stack_init(channel_stack, 1, DestroyCall,
                                               call, &call_args));
+  if (timeline != nullptr) timeline->Record(CallPhase::kCallStackInit);
   // Publish this call to parent only after the call stack has been initialized.
   if (parent != nullptr) {
     call->PublishToParent(parent);
@@ -937,6 +957,11 @@ void FilterStackCall::ReleaseCall(void* call, grpc_error_handle /*error*/) {
 
 void FilterStackCall::DestroyCall(void* call, grpc_error_handle /*error*/) {
   auto* c = static_cast<FilterStackCall*>(call);
+  CallTimeline* timeline = c->timeline();
+  if (timeline != nullptr && !c->is_client()) {
+    Slice* path = c->recv_initial_metadata_.get_pointer(HttpPathMetadata());
+    if (path != nullptr) timeline->set_method(path->Ref());
+  }
   c->recv_initial_metadata_.Clear();
   c->recv_trailing_metadata_.Clear();
   c->receiving_slice_buffer_.reset();
@@ -955,11 +980,37 @@ void FilterStackCall::DestroyCall(void* call, grpc_error_handle /*error*/) {
   c->status_error_.set(absl::OkStatus());
   c->final_info_.stats.latency =
       gpr_cycle_counter_sub(gpr_get_cycle_counter(), c->start_time());
+  if (timeline != nullptr) c->FinishTimeline(timeline);
   grpc_call_stack_destroy(c->call_stack(), &c->final_info_,
                           GRPC_CLOSURE_INIT(&c->release_call_, ReleaseCall, c,
                                             grpc_schedule_on_exec_ctx));
 }
 
+void FilterStackCall::FinishTimeline(CallTimeline* timeline) {
+  timeline->Record(CallPhase::kEnd);
+  // A streaming call lasts as long as the application keeps it open, so it
+  // being long says nothing about it being slow.
+  if (timeline->is_streaming()) return;
+  auto slow_call = CallFlightRecorder::Get().OnCallEnd(
+      *timeline, final_info_.final_status,
+      channel()->call_timeline_options().slow_call_threshold);
+  if (!slow_call.has_value()) return;
+  // Also keep the timeline with the channel's or server's channelz node, so
+  // that it can be found by the channelz id.
+  if (is_client()) {
+    channelz::ChannelNode* channelz_channel = channel()->channelz_node();
+    if (channelz_channel != nullptr) {
+      channelz_channel->AddSlowCall(std::move(*slow_call));
+    }
+  } else if (final_op_.server.core_server != nullptr) {
+    channelz::ServerNode* channelz_node =
+        final_op_.server.core_server->channelz_node();
+    if (channelz_node != nullptr) {
+      channelz_node->AddSlowCall(std::move(*slow_call));
+    }
+  }
+}
+
 void FilterStackCall::ExternalUnref() {
   if (GPR_LIKELY(!ext_ref_.Unref())) return;
 
@@ -1618,6 +1669,7 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
         }
         stream_op->send_message = true;
         sending_message_ = true;
+        if (timeline() != nullptr) timeline()->CountSendMessage();
         send_slice_buffer_.Clear();
         grpc_slice_buffer_move_into(
             &op->data.send_message.send_message->data.raw.slice_buffer,
@@ -1756,6 +1808,7 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
         }
         receiving_message_ = true;
         stream_op->recv_message = true;
+        if (timeline() != nullptr) timeline()->CountRecvMessage();
         receiving_slice_buffer_.reset();
         receiving_buffer_ = op->data.recv_message.recv_message;
         stream_op_payload->recv_message.recv_message = &receiving_slice_buffer_;
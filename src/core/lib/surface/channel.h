@@ -45,6 +45,7 @@
 #include "src/core/lib/channel/channel_stack.h"  // IWYU pragma: keep
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/debug/call_timeline.h"
 #include "src/core/lib/gprpp/cpp_impl_of.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -125,6 +126,10 @@ class Channel : public RefCounted<Channel>,
 
   channelz::ChannelNode* channelz_node() const { return channelz_node_.get(); }
 
+  const CallTimelineOptions& call_timeline_options() const {
+    return call_timeline_options_;
+  }
+
   size_t CallSizeEstimate() {
     // We round up our current estimate to the NEXT value of kRoundUpSize.
     // This ensures:
@@ -168,6 +173,7 @@ class Channel : public RefCounted<Channel>,
   const bool is_client_;
   const bool is_promising_;
   const grpc_compression_options compression_options_;
+  const CallTimelineOptions call_timeline_options_;
   std::atomic<size_t> call_size_estimate_;
   CallRegistrationTable registration_table_;
   RefCountedPtr<channelz::ChannelNode> channelz_node_;
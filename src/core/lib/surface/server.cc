@@ -35,6 +35,7 @@
 
 #include "absl/cleanup/cleanup.h"
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 #include "absl/types/variant.h"
 
@@ -50,6 +51,7 @@
 #include "src/core/lib/channel/channel_trace.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/method_stats.h"
 #include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/crash.h"
@@ -696,10 +698,23 @@ RefCountedPtr<channelz::ServerNode> CreateChannelzNode(
   return channelz_node;
 }
 
+// Records how long a server call waited to be matched with a requested call.
+void RecordQueueTime(MethodStatsCollectorCache* collectors,
+                     absl::string_view method, gpr_cycle_counter start) {
+  const gpr_timespec elapsed =
+      gpr_cycle_counter_sub(gpr_get_cycle_counter(), start);
+  collectors->Get(method)->RecordQueueTime(gpr_timespec_to_micros(elapsed));
+}
+
 }  // namespace
 
 Server::Server(const ChannelArgs& args)
-    : channel_args_(args), channelz_node_(CreateChannelzNode(args)) {}
+    : channel_args_(args),
+      queue_time_collectors_(
+          args.GetBool(GRPC_ARG_ENABLE_METHOD_STATS).value_or(false)
+              ? std::make_unique<MethodStatsCollectorCache>(/*target=*/"")
+              : nullptr),
+      channelz_node_(CreateChannelzNode(args)) {}
 
 Server::~Server() {
   // Remove the cq pollsets from the config_fetcher.
@@ -1312,6 +1327,10 @@ ArenaPromise<ServerMetadataHandle> Server::ChannelData::MakeCallPromise(
     };
   }
   Timestamp deadline = GetContext<CallContext>()->deadline();
+  absl::optional<gpr_cycle_counter> queue_start;
+  if (server->queue_time_collectors_ != nullptr) {
+    queue_start = gpr_get_cycle_counter();
+  }
   // Find request matcher.
   RequestMatcherInterface* matcher;
   ChannelRegisteredMethod* rm =
@@ -1337,11 +1356,16 @@ ArenaPromise<ServerMetadataHandle> Server::ChannelData::MakeCallPromise(
   return TrySeq(
       TryJoin(matcher->MatchRequest(chand->cq_idx()),
               std::move(maybe_read_first_message)),
-      [path = std::move(*path), host_ptr, deadline,
+      [path = std::move(*path), host_ptr, deadline, queue_start,
+       queue_time_collectors = server->queue_time_collectors_.get(),
        call_args = std::move(call_args)](
           std::tuple<RequestMatcherInterface::MatchResult,
                      NextResult<MessageHandle>>
               match_result_and_payload) mutable {
+        if (queue_start.has_value()) {
+          RecordQueueTime(queue_time_collectors, path.as_string_view(),
+                          *queue_start);
+        }
         auto& mr = std::get<0>(match_result_and_payload);
         auto& payload = std::get<1>(match_result_and_payload);
         auto* rc = mr.TakeCall();
@@ -1491,6 +1515,10 @@ void Server::CallData::Start(grpc_call_element* elem) {
 }
 
 void Server::CallData::Publish(size_t cq_idx, RequestedCall* rc) {
+  if (queue_start_.has_value()) {
+    RecordQueueTime(server_->queue_time_collectors_.get(),
+                    path_->as_string_view(), *queue_start_);
+  }
   grpc_call_set_completion_queue(call_, rc->cq_bound_to_call);
   *rc->call = call_;
   cq_new_ = server_->cqs_[cq_idx];
@@ -1555,6 +1583,9 @@ void Server::CallData::StartNewRpc(grpc_call_element* elem) {
     KillZombie();
     return;
   }
+  if (server_->queue_time_collectors_ != nullptr && path_.has_value()) {
+    queue_start_ = gpr_get_cycle_counter();
+  }
   // Find request matcher.
   matcher_ = server_->unregistered_request_matcher_.get();
   grpc_server_register_method_payload_handling payload_handling =
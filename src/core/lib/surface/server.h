@@ -43,6 +43,7 @@
 #include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/debug/method_stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/cpp_impl_of.h"
 #include "src/core/lib/gprpp/dual_ref_counted.h"
@@ -328,6 +329,9 @@ class Server : public InternallyRefCounted<Server>,
     absl::optional<Slice> path_;
     absl::optional<Slice> host_;
     Timestamp deadline_ = Timestamp::InfFuture();
+    // Set when the call starts waiting to be matched with a requested call,
+    // if the server records method stats.
+    absl::optional<gpr_cycle_counter> queue_start_;
 
     grpc_completion_queue* cq_new_ = nullptr;
 
@@ -443,6 +447,9 @@ class Server : public InternallyRefCounted<Server>,
   }
 
   ChannelArgs const channel_args_;
+  // Where to record how long calls wait to be requested; null unless
+  // GRPC_ARG_ENABLE_METHOD_STATS is set.
+  const std::unique_ptr<MethodStatsCollectorCache> queue_time_collectors_;
   RefCountedPtr<channelz::ServerNode> channelz_node_;
   std::unique_ptr<grpc_server_config_fetcher> config_fetcher_;
 
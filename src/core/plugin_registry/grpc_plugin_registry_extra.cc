@@ -40,6 +40,7 @@ extern void RegisterXdsOverrideHostLbPolicy(
     CoreConfiguration::Builder* builder);
 extern void RegisterXdsWrrLocalityLbPolicy(CoreConfiguration::Builder* builder);
 extern void RegisterRingHashLbPolicy(CoreConfiguration::Builder* builder);
+extern void RegisterMaglevLbPolicy(CoreConfiguration::Builder* builder);
 extern void RegisterFileWatcherCertificateProvider(
     CoreConfiguration::Builder* builder);
 #endif
@@ -62,6 +63,7 @@ void RegisterExtraFilters(CoreConfiguration::Builder* builder) {
   RegisterXdsOverrideHostLbPolicy(builder);
   RegisterXdsWrrLocalityLbPolicy(builder);
   RegisterRingHashLbPolicy(builder);
+  RegisterMaglevLbPolicy(builder);
   RegisterFileWatcherCertificateProvider(builder);
 #endif
 }
@@ -15,6 +15,8 @@
 # AUTO-GENERATED FROM `$REPO_ROOT/templates/src/python/grpcio/grpc_core_dependencies.py.template`!!!
 
 CORE_SOURCE_FILES = [
+    'src/core/ext/filters/adaptive_concurrency/adaptive_concurrency_filter.cc',
+    'src/core/ext/filters/adaptive_concurrency/concurrency_limiter.cc',
     'src/core/ext/filters/backend_metrics/backend_metric_filter.cc',
     'src/core/ext/filters/census/grpc_context.cc',
     'src/core/ext/filters/channel_idle/channel_idle_filter.cc',
@@ -39,13 +41,17 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
     'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
     'src/core/ext/filters/client_channel/lb_policy/health_check_client.cc',
+    'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
+    'src/core/ext/filters/client_channel/lb_policy/maglev/maglev.cc',
     'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
     'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
     'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
     'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
+    'src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash_lb_policy.cc',
     'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
     'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
     'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+    'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/alias_table_scheduler.cc',
     'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.cc',
     'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
     'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
@@ -89,8 +95,12 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/http/message_compress/compression_filter.cc',
     'src/core/ext/filters/http/server/http_server_filter.cc',
     'src/core/ext/filters/message_size/message_size_filter.cc',
+    'src/core/ext/filters/method_stats/method_stats_filter.cc',
     'src/core/ext/filters/rbac/rbac_filter.cc',
     'src/core/ext/filters/rbac/rbac_service_config_parser.cc',
+    'src/core/ext/filters/response_cache/response_cache.cc',
+    'src/core/ext/filters/response_cache/response_cache_filter.cc',
+    'src/core/ext/filters/response_cache/response_cache_service_config_parser.cc',
     'src/core/ext/filters/server_config_selector/server_config_selector_filter.cc',
     'src/core/ext/filters/stateful_session/stateful_session_filter.cc',
     'src/core/ext/filters/stateful_session/stateful_session_service_config_parser.cc',
@@ -486,8 +496,10 @@ CORE_SOURCE_FILES = [
     'src/core/lib/config/config_vars_non_generated.cc',
     'src/core/lib/config/core_configuration.cc',
     'src/core/lib/config/load_config.cc',
+    'src/core/lib/debug/call_timeline.cc',
     'src/core/lib/debug/event_log.cc',
     'src/core/lib/debug/histogram_view.cc',
+    'src/core/lib/debug/method_stats.cc',
     'src/core/lib/debug/stats.cc',
     'src/core/lib/debug/stats_data.cc',
     'src/core/lib/debug/trace.cc',
@@ -670,6 +682,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/wakeup_fd_nospecial.cc',
     'src/core/lib/iomgr/wakeup_fd_pipe.cc',
     'src/core/lib/iomgr/wakeup_fd_posix.cc',
+    'src/core/lib/json/json_document.cc',
     'src/core/lib/json/json_object_loader.cc',
     'src/core/lib/json/json_reader.cc',
     'src/core/lib/json/json_util.cc',
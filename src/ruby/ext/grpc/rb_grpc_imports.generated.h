@@ -335,6 +335,9 @@ extern grpc_channelz_get_subchannel_type grpc_channelz_get_subchannel_import;
 typedef char*(*grpc_channelz_get_socket_type)(intptr_t socket_id);
 extern grpc_channelz_get_socket_type grpc_channelz_get_socket_import;
 #define grpc_channelz_get_socket grpc_channelz_get_socket_import
+typedef char*(*grpc_channelz_get_slow_calls_type)(intptr_t channelz_id);
+extern grpc_channelz_get_slow_calls_type grpc_channelz_get_slow_calls_import;
+#define grpc_channelz_get_slow_calls grpc_channelz_get_slow_calls_import
 typedef const grpc_arg_pointer_vtable*(*grpc_authorization_policy_provider_arg_vtable_type)(void);
 extern grpc_authorization_policy_provider_arg_vtable_type grpc_authorization_policy_provider_arg_vtable_import;
 #define grpc_authorization_policy_provider_arg_vtable grpc_authorization_policy_provider_arg_vtable_import
@@ -86,6 +86,67 @@ TEST(ChannelArgsTest, RemoveAllKeysWithPrefix) {
   EXPECT_EQ(modified.GetInt("bar"), 4);
 }
 
+TEST(ChannelArgsTest, Intern) {
+  ChannelArgs a = ChannelArgs().Set("foo", 1).Set("bar", "baz");
+  ChannelArgs b = ChannelArgs().Set("bar", "baz").Set("foo", 1);
+  EXPECT_FALSE(a.is_interned());
+  ChannelArgs interned_a = a.Intern();
+  ChannelArgs interned_b = b.Intern();
+  EXPECT_TRUE(interned_a.is_interned());
+  EXPECT_TRUE(interned_b.is_interned());
+  EXPECT_EQ(interned_a, a);
+  EXPECT_EQ(interned_a, interned_b);
+  EXPECT_EQ(interned_a.Hash(), a.Hash());
+  EXPECT_EQ(interned_a.Hash(), b.Hash());
+  EXPECT_EQ(interned_a.ToString(), interned_b.ToString());
+  // Modifying interned args gives args that are not interned.
+  ChannelArgs c = interned_a.Set("foo", 2);
+  EXPECT_FALSE(c.is_interned());
+  EXPECT_NE(c, interned_a);
+  ChannelArgs interned_c = c.Intern();
+  EXPECT_NE(interned_c, interned_a);
+  EXPECT_EQ(interned_c.Remove("foo").Set("foo", 1).Intern(), interned_a);
+  EXPECT_EQ(interned_a.UnionWith(ChannelArgs().Set("x", 1)).GetInt("x"), 1);
+  EXPECT_FALSE(interned_a.UnionWith(ChannelArgs().Set("x", 1)).is_interned());
+  EXPECT_EQ(ChannelArgs().Intern(), ChannelArgs());
+}
+
+TEST(ChannelArgsTest, InternPointersComparedWithVTable) {
+  struct Test : public RefCounted<Test> {
+    explicit Test(int n) : n(n) {}
+    int n;
+    static int ChannelArgsCompare(const Test* a, const Test* b) {
+      return QsortCompare(a->n, b->n);
+    }
+  };
+  // Distinct objects that compare equal give the same interned args.
+  ChannelArgs a = ChannelArgs().Set("test", MakeRefCounted<Test>(1)).Intern();
+  ChannelArgs b = ChannelArgs().Set("test", MakeRefCounted<Test>(1)).Intern();
+  ChannelArgs c = ChannelArgs().Set("test", MakeRefCounted<Test>(2)).Intern();
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(a.Hash(), b.Hash());
+  EXPECT_EQ(b.GetPointer<Test>("test"), a.GetPointer<Test>("test"));
+  EXPECT_NE(a, c);
+}
+
+TEST(ChannelArgsTest, InternedArgsAreReleased) {
+  struct Test : public RefCounted<Test> {
+    explicit Test(bool* destroyed) : destroyed(destroyed) {}
+    ~Test() override { *destroyed = true; }
+    bool* destroyed;
+    static int ChannelArgsCompare(const Test* a, const Test* b) {
+      return QsortCompare(a, b);
+    }
+  };
+  bool destroyed = false;
+  ChannelArgs interned =
+      ChannelArgs().Set("test", MakeRefCounted<Test>(&destroyed)).Intern();
+  EXPECT_FALSE(destroyed);
+  // The intern table does not keep the args alive.
+  interned = ChannelArgs();
+  EXPECT_TRUE(destroyed);
+}
+
 TEST(ChannelArgsTest, StoreRefCountedPtr) {
   struct Test : public RefCounted<Test> {
     explicit Test(int n) : n(n) {}
@@ -21,11 +21,17 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
 
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_reader.h"
 #include "test/core/util/test_config.h"
 
 namespace grpc_core {
@@ -128,6 +134,67 @@ TEST_F(ChannelzRegistryTest, TestUnregistration) {
   }
 }
 
+TEST_F(ChannelzRegistryTest, TopChannelsAmongOtherNodes) {
+  ExecCtx exec_ctx;
+  // Interleave channels with many more sockets, so that channels land in
+  // every shard.
+  std::vector<RefCountedPtr<BaseNode>> channels;
+  std::vector<RefCountedPtr<BaseNode>> sockets;
+  for (int i = 0; i < 150; ++i) {
+    channels.push_back(MakeRefCounted<ChannelNode>("test", 0, false));
+    for (int j = 0; j < i % 7; ++j) sockets.push_back(CreateTestNode());
+  }
+  std::vector<intptr_t> uuids;
+  intptr_t start_id = 0;
+  bool end = false;
+  while (!end) {
+    auto json = JsonParse(ChannelzRegistry::GetTopChannels(start_id));
+    ASSERT_TRUE(json.ok()) << json.status();
+    auto it = json->object().find("channel");
+    ASSERT_NE(it, json->object().end());
+    ASSERT_LE(it->second.array().size(), 100);
+    for (const Json& channel : it->second.array()) {
+      const std::string& id = channel.object()
+                                  .at("ref")
+                                  .object()
+                                  .at("channelId")
+                                  .string();
+      uuids.push_back(std::stoll(id));
+    }
+    start_id = uuids.back() + 1;
+    end = json->object().find("end") != json->object().end();
+  }
+  ASSERT_EQ(uuids.size(), channels.size());
+  for (size_t i = 0; i < channels.size(); ++i) {
+    EXPECT_EQ(uuids[i], channels[i]->uuid());
+  }
+}
+
+TEST_F(ChannelzRegistryTest, RegistrationDuringQueries) {
+  ExecCtx exec_ctx;
+  std::vector<RefCountedPtr<BaseNode>> channels;
+  for (int i = 0; i < 10; ++i) {
+    channels.push_back(MakeRefCounted<ChannelNode>("test", 0, false));
+  }
+  std::atomic<bool> done{false};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&done]() {
+      while (!done.load(std::memory_order_relaxed)) {
+        RefCountedPtr<BaseNode> socket = CreateTestNode();
+        EXPECT_EQ(ChannelzRegistry::Get(socket->uuid()), socket);
+      }
+    });
+  }
+  for (int i = 0; i < 100; ++i) {
+    auto json = JsonParse(ChannelzRegistry::GetTopChannels(0));
+    ASSERT_TRUE(json.ok()) << json.status();
+    EXPECT_EQ(json->object().at("channel").array().size(), channels.size());
+  }
+  done.store(true, std::memory_order_relaxed);
+  for (auto& thread : threads) thread.join();
+}
+
 }  // namespace testing
 }  // namespace channelz
 }  // namespace grpc_core
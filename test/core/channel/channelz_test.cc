@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <atomic>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/status/status.h"
@@ -37,7 +39,9 @@
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz_registry.h"
+#include "src/core/lib/debug/call_timeline.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/json/json_reader.h"
@@ -551,6 +555,69 @@ TEST(ChannelzServerTest, BasicServerAPIFunctionality) {
   ValidateServer(channelz_server, {3, 3, 3});
 }
 
+CallFlightRecorder::SlowCall MakeSlowCall(std::string method) {
+  return {std::move(method), GRPC_STATUS_DEADLINE_EXCEEDED,
+          Duration::Milliseconds(1500), "arena_created +0us end +1500000us"};
+}
+
+// Validates what grpc_channelz_get_slow_calls() returns for a channel or
+// server, and that the slow calls are kept out of its trace.
+void ValidateSlowCalls(intptr_t uuid, const std::string& node_json,
+                       const std::vector<std::string>& methods) {
+  EXPECT_EQ(node_json.find("slow call"), std::string::npos) << node_json;
+  char* core_api_json_str = grpc_channelz_get_slow_calls(uuid);
+  ASSERT_NE(core_api_json_str, nullptr);
+  auto json = JsonParse(core_api_json_str);
+  gpr_free(core_api_json_str);
+  ASSERT_TRUE(json.ok()) << json.status();
+  ASSERT_EQ(json->type(), Json::Type::kObject);
+  auto it = json->object().find("slowCall");
+  if (methods.empty()) {
+    EXPECT_EQ(it, json->object().end());
+    return;
+  }
+  ASSERT_NE(it, json->object().end());
+  ASSERT_EQ(it->second.type(), Json::Type::kArray);
+  const Json::Array& slow_calls = it->second.array();
+  ASSERT_EQ(slow_calls.size(), methods.size());
+  for (size_t i = 0; i < methods.size(); ++i) {
+    const Json::Object& slow_call = slow_calls[i].object();
+    EXPECT_EQ(slow_call.at("method").string(), methods[i]);
+    EXPECT_EQ(slow_call.at("status").string(), "DEADLINE_EXCEEDED");
+    EXPECT_EQ(slow_call.at("latency").string(), "1.500000000s");
+    EXPECT_EQ(slow_call.at("timeline").string(),
+              "arena_created +0us end +1500000us");
+  }
+}
+
+TEST(ChannelzChannelTest, SlowCalls) {
+  ExecCtx exec_ctx;
+  ChannelFixture channel(1024);
+  ChannelNode* channelz_channel =
+      grpc_channel_get_channelz_node(channel.channel());
+  ValidateSlowCalls(channelz_channel->uuid(),
+                    channelz_channel->RenderJsonString(), {});
+  channelz_channel->AddSlowCall(MakeSlowCall("/foo/bar"));
+  channelz_channel->AddSlowCall(MakeSlowCall("/foo/baz"));
+  ValidateSlowCalls(channelz_channel->uuid(),
+                    channelz_channel->RenderJsonString(),
+                    {"/foo/bar", "/foo/baz"});
+}
+
+TEST(ChannelzServerTest, SlowCalls) {
+  ExecCtx exec_ctx;
+  ServerFixture server(1024);
+  ServerNode* channelz_server = Server::FromC(server.server())->channelz_node();
+  channelz_server->AddSlowCall(MakeSlowCall("/foo/bar"));
+  ValidateSlowCalls(channelz_server->uuid(),
+                    channelz_server->RenderJsonString(), {"/foo/bar"});
+}
+
+TEST(ChannelzSlowCallsTest, UnknownEntity) {
+  ExecCtx exec_ctx;
+  EXPECT_EQ(grpc_channelz_get_slow_calls(-1), nullptr);
+}
+
 TEST_F(ChannelzRegistryBasedTest, BasicGetServersTest) {
   ExecCtx exec_ctx;
   ServerFixture server;
@@ -0,0 +1,161 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/alias_table_scheduler.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <random>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr int kNumPicks = 1000000;
+
+// Picks kNumPicks times from a scheduler built from `weights`, and returns
+// the fraction of picks that went to each index.
+std::vector<double> PickFractions(const std::vector<float>& weights) {
+  std::mt19937_64 rng(0);
+  const absl::optional<AliasTableScheduler> scheduler =
+      AliasTableScheduler::Make(absl::MakeSpan(weights), [&] { return rng(); });
+  EXPECT_TRUE(scheduler.has_value());
+  std::vector<double> fractions(weights.size());
+  if (!scheduler.has_value()) return fractions;
+  for (int i = 0; i < kNumPicks; ++i) {
+    fractions[scheduler->Pick()] += 1.0 / kNumPicks;
+  }
+  return fractions;
+}
+
+TEST(AliasTableSchedulerTest, EmptyWeightsIsNullopt) {
+  const std::vector<float> weights = {};
+  ASSERT_FALSE(AliasTableScheduler::Make(absl::MakeSpan(weights), [] {
+                 return uint64_t{0};
+               }).has_value());
+}
+
+TEST(AliasTableSchedulerTest, AllZeroWeightsIsNullopt) {
+  const std::vector<float> weights = {0, 0, 0, 0};
+  ASSERT_FALSE(AliasTableScheduler::Make(absl::MakeSpan(weights), [] {
+                 return uint64_t{0};
+               }).has_value());
+}
+
+TEST(AliasTableSchedulerTest, OneWeightsIsNullopt) {
+  const std::vector<float> weights = {1};
+  ASSERT_FALSE(AliasTableScheduler::Make(absl::MakeSpan(weights), [] {
+                 return uint64_t{0};
+               }).has_value());
+}
+
+TEST(AliasTableSchedulerTest, PicksAreWeighted) {
+  const std::vector<double> fractions = PickFractions({1, 2, 3, 4});
+  EXPECT_NEAR(fractions[0], 0.1, 0.005);
+  EXPECT_NEAR(fractions[1], 0.2, 0.005);
+  EXPECT_NEAR(fractions[2], 0.3, 0.005);
+  EXPECT_NEAR(fractions[3], 0.4, 0.005);
+}
+
+TEST(AliasTableSchedulerTest, ZeroWeightUsesMean) {
+  const std::vector<double> fractions = PickFractions({3, 0, 1});
+  EXPECT_NEAR(fractions[0], 0.5, 0.005);
+  EXPECT_NEAR(fractions[1], 1.0 / 3, 0.005);
+  EXPECT_NEAR(fractions[2], 1.0 / 6, 0.005);
+}
+
+TEST(AliasTableSchedulerTest, MaxIsClampedForHighRatio) {
+  // max gets clamped to mean*maxRatio = 50 for this set of weights, as it
+  // does in StaticStrideScheduler.
+  const std::vector<double> fractions = PickFractions(
+      {81, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1});
+  EXPECT_NEAR(fractions[0], 50.0 / 69, 0.005);
+  for (size_t i = 1; i < fractions.size(); ++i) {
+    EXPECT_NEAR(fractions[i], 1.0 / 69, 0.002);
+  }
+}
+
+TEST(AliasTableSchedulerTest, MinIsClampedForHighRatio) {
+  // mean is ~50, so the epsilon weight gets capped from below to 0.5, as it
+  // does in StaticStrideScheduler.
+  const std::vector<double> fractions = PickFractions({100, 1e-10});
+  EXPECT_NEAR(fractions[0], 200.0 / 201, 0.001);
+  EXPECT_NEAR(fractions[1], 1.0 / 201, 0.001);
+}
+
+TEST(AliasTableSchedulerTest, SkewedWeightsWithManyEntries) {
+  std::vector<float> weights;
+  for (int i = 0; i < 1000; ++i) weights.push_back(1 + i % 10);
+  const std::vector<double> fractions = PickFractions(weights);
+  // Sum of weights is 100 * (1 + 2 + ... + 10) = 5500.
+  for (size_t i = 0; i < weights.size(); ++i) {
+    EXPECT_NEAR(fractions[i], weights[i] / 5500, 0.0005) << i;
+  }
+}
+
+TEST(AliasTableSchedulerTest, PickConsumesOneRandomNumber) {
+  int calls = 0;
+  const std::vector<float> weights = {1, 100, 1, 1};
+  const absl::optional<AliasTableScheduler> scheduler =
+      AliasTableScheduler::Make(absl::MakeSpan(weights), [&] {
+        ++calls;
+        return uint64_t{0xdeadbeefcafef00d} * calls;
+      });
+  ASSERT_TRUE(scheduler.has_value());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_LT(scheduler->Pick(), weights.size());
+  }
+  EXPECT_EQ(calls, 100);
+}
+
+TEST(AliasTableSchedulerTest, PicksAreDeterministic) {
+  uint64_t state = 0;
+  const auto next = [&] { return (state += 0x9e3779b97f4a7c15); };
+  const std::vector<float> weights = {1, 2, 3};
+  const absl::optional<AliasTableScheduler> scheduler =
+      AliasTableScheduler::Make(absl::MakeSpan(weights), next);
+  ASSERT_TRUE(scheduler.has_value());
+
+  const int n = 100;
+  std::vector<size_t> picks;
+  picks.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    picks.push_back(scheduler->Pick());
+  }
+
+  // Rewind and make each pick with a new scheduler instance. This should give
+  // identical picks.
+  state = 0;
+  for (int i = 0; i < n; ++i) {
+    const absl::optional<AliasTableScheduler> rebuild =
+        AliasTableScheduler::Make(absl::MakeSpan(weights), next);
+    ASSERT_TRUE(rebuild.has_value());
+    EXPECT_EQ(rebuild->Pick(), picks[i]);
+  }
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,247 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmarks the data plane (picker) of a few LB policies, with picks
+// coming from multiple threads at once.  The control plane is driven
+// through the same fake helper used by the LB policy unit tests.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/variant.h"
+
+#include <grpc/grpc.h>
+#include <grpc/impl/grpc_types.h>
+#include <grpc/support/json.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/no_destruct.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "test/core/client_channel/lb_policy/lb_policy_test_lib.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Number of distinct request hashes cycled through by each picking thread.
+constexpr size_t kNumRequestHashes = 256;
+
+// Brings up an LB policy with num_endpoints READY endpoints and exposes
+// its picker.  Instances are created once per configuration and shared
+// by all benchmark threads.
+class PickerFixture : public LoadBalancingPolicyTest {
+ public:
+  PickerFixture(absl::string_view policy_name, const Json& config,
+                size_t num_endpoints, const ChannelArgs& channel_args,
+                bool skewed_backend_metrics) {
+    lb_policy_ = MakeLbPolicy(policy_name, channel_args);
+    std::vector<std::string> address_strings;
+    for (size_t i = 0; i < num_endpoints; ++i) {
+      address_strings.push_back(
+          absl::StrFormat("ipv4:10.%d.%d.%d:443", (i >> 16) & 0xff,
+                          (i >> 8) & 0xff, i & 0xff));
+    }
+    std::vector<absl::string_view> addresses(address_strings.begin(),
+                                             address_strings.end());
+    GPR_ASSERT(ApplyUpdate(BuildUpdate(addresses, MakeConfig(config)),
+                           lb_policy_.get())
+                   .ok());
+    for (size_t i = 0; i < addresses.size(); ++i) {
+      auto* subchannel = FindSubchannel(addresses[i]);
+      GPR_ASSERT(subchannel != nullptr);
+      if (skewed_backend_metrics) {
+        // Spread the weights over two orders of magnitude, so that the
+        // scheduler has real work to do.
+        BackendMetricData backend_metrics;
+        backend_metrics.qps = 100 * (1 + i % 100);
+        backend_metrics.cpu_utilization = 0.5;
+        subchannel->SendOobBackendMetricReport(backend_metrics);
+      }
+      subchannel->SetConnectivityState(GRPC_CHANNEL_CONNECTING);
+      subchannel->SetConnectivityState(GRPC_CHANNEL_READY);
+    }
+    // Keep the last picker reported; by now, all endpoints are READY.
+    while (!helper_->QueueEmpty()) {
+      auto update = helper_->GetNextStateUpdate();
+      GPR_ASSERT(update.has_value());
+      picker_ = std::move(update->picker);
+    }
+    GPR_ASSERT(picker_ != nullptr);
+    for (size_t i = 0; i < kNumRequestHashes; ++i) {
+      request_hashes_.push_back(absl::StrCat(i * 0x9e3779b97f4a7c15ull));
+    }
+  }
+
+  void TestBody() override {}
+
+  // Runs picks from the calling benchmark thread until the benchmark
+  // is done.  Like the client channel, holds one ExecCtx across many
+  // picks rather than creating one per pick.
+  void RunPicks(benchmark::State& state) {
+    ExecCtx exec_ctx;
+    FakeMetadata metadata({});
+    std::vector<std::unique_ptr<FakeCallState>> call_states;
+    std::vector<CallAttributes> call_attributes(request_hashes_.size());
+    for (size_t i = 0; i < request_hashes_.size(); ++i) {
+      call_attributes[i].emplace_back(
+          std::make_unique<RequestHashAttribute>(request_hashes_[i]));
+      call_states.push_back(
+          std::make_unique<FakeCallState>(call_attributes[i]));
+    }
+    size_t i = 0;
+    for (auto s : state) {
+      auto result = picker_->Pick(
+          {"/service/method", &metadata, call_states[i].get()});
+      GPR_DEBUG_ASSERT(absl::holds_alternative<
+                       LoadBalancingPolicy::PickResult::Complete>(
+          result.result));
+      benchmark::DoNotOptimize(result);
+      if (++i == call_states.size()) i = 0;
+    }
+  }
+
+ private:
+  OrphanablePtr<LoadBalancingPolicy> lb_policy_;
+  RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker_;
+  std::vector<std::string> request_hashes_;
+};
+
+enum class Policy {
+  kRoundRobin,
+  kRoundRobinPerCpu,
+  kWeightedRoundRobin,
+  kRingHash,
+};
+
+std::unique_ptr<PickerFixture> MakeFixture(Policy policy,
+                                           size_t num_endpoints) {
+  switch (policy) {
+    case Policy::kRoundRobin:
+      return std::make_unique<PickerFixture>(
+          "round_robin",
+          Json::FromArray({Json::FromObject(
+              {{"round_robin", Json::FromObject({})}})}),
+          num_endpoints, ChannelArgs(), false);
+    case Policy::kRoundRobinPerCpu:
+      return std::make_unique<PickerFixture>(
+          "round_robin",
+          Json::FromArray({Json::FromObject(
+              {{"round_robin", Json::FromObject({})}})}),
+          num_endpoints,
+          ChannelArgs().Set(GRPC_ARG_ROUND_ROBIN_LB_PER_CPU_PICKER, true),
+          false);
+    case Policy::kWeightedRoundRobin:
+      return std::make_unique<PickerFixture>(
+          "weighted_round_robin",
+          Json::FromArray({Json::FromObject(
+              {{"weighted_round_robin",
+                Json::FromObject(
+                    {{"enableOobLoadReport", Json::FromBool(true)},
+                     {"blackoutPeriod", Json::FromString("0s")}})}})}),
+          num_endpoints, ChannelArgs(), true);
+    case Policy::kRingHash:
+      return std::make_unique<PickerFixture>(
+          "ring_hash_experimental",
+          Json::FromArray({Json::FromObject(
+              {{"ring_hash_experimental",
+                Json::FromObject({{"minRingSize", Json::FromNumber(1024)},
+                                  {"maxRingSize",
+                                   Json::FromNumber(8388608)}})}})}),
+          num_endpoints,
+          ChannelArgs().Set(GRPC_ARG_RING_HASH_LB_RING_SIZE_CAP, 8388608),
+          false);
+  }
+  GPR_UNREACHABLE_CODE(return nullptr);
+}
+
+// Returns the shared fixture for the given policy and endpoint count,
+// creating it on first use.  Fixtures are intentionally leaked, since
+// their pickers may still be referenced by timers at exit.
+PickerFixture* GetFixture(Policy policy, size_t num_endpoints) {
+  static NoDestruct<Mutex> mu;
+  static NoDestruct<std::map<std::pair<Policy, size_t>, PickerFixture*>>
+      fixtures;
+  MutexLock lock(mu.get());
+  PickerFixture*& fixture = (*fixtures)[{policy, num_endpoints}];
+  if (fixture == nullptr) {
+    fixture = MakeFixture(policy, num_endpoints).release();
+  }
+  return fixture;
+}
+
+void BM_Pick(benchmark::State& state, Policy policy) {
+  GetFixture(policy, state.range(0))->RunPicks(state);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_Pick, RoundRobin, Policy::kRoundRobin)
+    ->RangeMultiplier(100)
+    ->Range(10, 1000)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_Pick, RoundRobinPerCpu, Policy::kRoundRobinPerCpu)
+    ->RangeMultiplier(100)
+    ->Range(10, 1000)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_Pick, WeightedRoundRobin, Policy::kWeightedRoundRobin)
+    ->RangeMultiplier(100)
+    ->Range(10, 1000)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_Pick, RingHash, Policy::kRingHash)
+    ->RangeMultiplier(100)
+    ->Range(10, 1000)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  // The fixtures are leaked (see GetFixture()), so we don't call
+  // grpc_shutdown() here.
+  grpc_init();
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -563,12 +563,13 @@ class LoadBalancingPolicyTest : public ::testing::Test {
   // Creates an LB policy of the specified name.
   // Creates a new FakeHelper for the new LB policy, and sets helper_ to
   // point to the FakeHelper.
-  OrphanablePtr<LoadBalancingPolicy> MakeLbPolicy(absl::string_view name) {
+  OrphanablePtr<LoadBalancingPolicy> MakeLbPolicy(
+      absl::string_view name, const ChannelArgs& channel_args = ChannelArgs()) {
     auto helper =
         std::make_unique<FakeHelper>(this, work_serializer_, event_engine_);
     helper_ = helper.get();
     LoadBalancingPolicy::Args args = {work_serializer_, std::move(helper),
-                                      ChannelArgs()};
+                                      channel_args};
     return CoreConfiguration::Get()
         .lb_policy_registry()
         .CreateLoadBalancingPolicy(name, std::move(args));
@@ -0,0 +1,204 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stddef.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/json.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "test/core/client_channel/lb_policy/lb_policy_test_lib.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using CallTracker =
+    std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>;
+
+class LeastRequestTest : public LoadBalancingPolicyTest {
+ protected:
+  LeastRequestTest()
+      : lb_policy_(MakeLbPolicy("least_request_experimental")) {}
+
+  static RefCountedPtr<LoadBalancingPolicy::Config> MakeLeastRequestConfig(
+      int choice_count, bool enable_orca_weighting = false) {
+    return MakeConfig(Json::FromArray({Json::FromObject(
+        {{"least_request_experimental",
+          Json::FromObject(
+              {{"choiceCount", Json::FromNumber(choice_count)},
+               {"enableOrcaWeighting",
+                Json::FromBool(enable_orca_weighting)}})}})}));
+  }
+
+  // Sends an update with the given addresses, brings all subchannels to
+  // READY, and returns the last picker reported.
+  RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> StartAllReady(
+      absl::Span<const absl::string_view> addresses,
+      RefCountedPtr<LoadBalancingPolicy::Config> config) {
+    EXPECT_EQ(ApplyUpdate(BuildUpdate(addresses, std::move(config)),
+                          lb_policy_.get()),
+              absl::OkStatus());
+    for (const absl::string_view address : addresses) {
+      auto* subchannel = FindSubchannel(address);
+      EXPECT_NE(subchannel, nullptr) << "Address: " << address;
+      if (subchannel == nullptr) return nullptr;
+      EXPECT_TRUE(subchannel->ConnectionRequested());
+      subchannel->SetConnectivityState(GRPC_CHANNEL_CONNECTING);
+      subchannel->SetConnectivityState(GRPC_CHANNEL_READY);
+    }
+    RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker;
+    while (!helper_->QueueEmpty()) {
+      auto update = helper_->GetNextStateUpdate();
+      EXPECT_TRUE(update.has_value());
+      if (!update.has_value()) return nullptr;
+      picker = std::move(update->picker);
+    }
+    return picker;
+  }
+
+  // Does a pick, starts the call, and adds its call tracker to the
+  // per-address lists of calls in flight.
+  void StartCall(LoadBalancingPolicy::SubchannelPicker* picker) {
+    CallTracker call_tracker;
+    auto address = ExpectPickComplete(picker, {}, &call_tracker);
+    ASSERT_TRUE(address.has_value());
+    ASSERT_NE(call_tracker, nullptr);
+    call_tracker->Start();
+    calls_[*address].push_back(std::move(call_tracker));
+  }
+
+  // Finishes all calls in flight to the given address, reporting the
+  // given backend metric data.
+  void FinishCalls(absl::string_view address,
+                   absl::optional<BackendMetricData> backend_metric_data =
+                       absl::nullopt) {
+    for (CallTracker& call_tracker : calls_[std::string(address)]) {
+      FakeMetadata metadata({});
+      FakeBackendMetricAccessor backend_metric_accessor(backend_metric_data);
+      call_tracker->Finish(
+          {address, absl::OkStatus(), &metadata, &backend_metric_accessor});
+    }
+    calls_[std::string(address)].clear();
+  }
+
+  size_t NumCalls(absl::string_view address) {
+    return calls_[std::string(address)].size();
+  }
+
+  OrphanablePtr<LoadBalancingPolicy> lb_policy_;
+  std::map<std::string, std::vector<CallTracker>> calls_;
+};
+
+TEST_F(LeastRequestTest, Basic) {
+  const std::array<absl::string_view, 3> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443"};
+  auto picker = StartAllReady(kAddresses, MakeLeastRequestConfig(2));
+  ASSERT_NE(picker, nullptr);
+  for (size_t i = 0; i < 30; ++i) StartCall(picker.get());
+  for (const absl::string_view address : kAddresses) {
+    EXPECT_GT(NumCalls(address), 0) << address;
+    FinishCalls(address);
+  }
+}
+
+TEST_F(LeastRequestTest, PicksLessLoadedAddress) {
+  const std::array<absl::string_view, 2> kAddresses = {"ipv4:127.0.0.1:441",
+                                                       "ipv4:127.0.0.1:442"};
+  // With 10 choices, a pick goes to the more loaded address only if all
+  // 10 choices land on it, which happens with probability 1/1024.
+  auto picker = StartAllReady(kAddresses, MakeLeastRequestConfig(10));
+  ASSERT_NE(picker, nullptr);
+  for (size_t i = 0; i < 100; ++i) StartCall(picker.get());
+  EXPECT_NEAR(NumCalls(kAddresses[0]), NumCalls(kAddresses[1]), 4);
+  // Once the first address's calls finish, new calls go to it until the
+  // load is balanced again.
+  FinishCalls(kAddresses[0]);
+  for (size_t i = 0; i < 40; ++i) StartCall(picker.get());
+  EXPECT_GE(NumCalls(kAddresses[0]), 38);
+  FinishCalls(kAddresses[0]);
+  FinishCalls(kAddresses[1]);
+}
+
+TEST_F(LeastRequestTest, OrcaWeighting) {
+  const std::array<absl::string_view, 2> kAddresses = {"ipv4:127.0.0.1:441",
+                                                       "ipv4:127.0.0.1:442"};
+  auto picker = StartAllReady(
+      kAddresses,
+      MakeLeastRequestConfig(10, /*enable_orca_weighting=*/true));
+  ASSERT_NE(picker, nullptr);
+  // Get a utilization report from each address.
+  while (NumCalls(kAddresses[0]) == 0 || NumCalls(kAddresses[1]) == 0) {
+    StartCall(picker.get());
+  }
+  BackendMetricData busy;
+  busy.cpu_utilization = 1;
+  BackendMetricData idle;
+  idle.cpu_utilization = 0;
+  FinishCalls(kAddresses[0], busy);
+  FinishCalls(kAddresses[1], idle);
+  // The busy address counts each call twice, so it gets about a third
+  // of the calls.
+  for (size_t i = 0; i < 90; ++i) StartCall(picker.get());
+  EXPECT_NEAR(NumCalls(kAddresses[0]), 30, 4);
+  EXPECT_NEAR(NumCalls(kAddresses[1]), 60, 4);
+  FinishCalls(kAddresses[0]);
+  FinishCalls(kAddresses[1]);
+}
+
+TEST(LeastRequestConfigTest, ChoiceCountMustBeAtLeastTwo) {
+  auto config =
+      CoreConfiguration::Get().lb_policy_registry().ParseLoadBalancingConfig(
+          Json::FromArray({Json::FromObject(
+              {{"least_request_experimental",
+                Json::FromObject({{"choiceCount", Json::FromNumber(1)}})}})}));
+  EXPECT_EQ(config.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(config.status().message(),
+            "errors validating least_request LB policy config: ["
+            "field:choiceCount error:must be at least 2]");
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
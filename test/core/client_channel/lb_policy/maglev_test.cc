@@ -0,0 +1,181 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/json.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "test/core/client_channel/lb_policy/lb_policy_test_lib.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+class MaglevTest : public LoadBalancingPolicyTest {
+ protected:
+  MaglevTest() : lb_policy_(MakeLbPolicy("maglev_experimental")) {}
+
+  static RefCountedPtr<LoadBalancingPolicy::Config> MakeMaglevConfig(
+      size_t table_size) {
+    return MakeConfig(Json::FromArray({Json::FromObject(
+        {{"maglev_experimental",
+          Json::FromObject({{"tableSize", Json::FromNumber(table_size)}})}})}));
+  }
+
+  // Sends an update with the given addresses, brings any subchannels that
+  // are not yet READY to READY, and returns the last picker reported.
+  RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> UpdateAllReady(
+      absl::Span<const absl::string_view> addresses, size_t table_size) {
+    EXPECT_EQ(ApplyUpdate(BuildUpdate(addresses, MakeMaglevConfig(table_size)),
+                          lb_policy_.get()),
+              absl::OkStatus());
+    for (const absl::string_view address : addresses) {
+      auto* subchannel = FindSubchannel(address);
+      EXPECT_NE(subchannel, nullptr) << "Address: " << address;
+      if (subchannel == nullptr) return nullptr;
+      if (ready_addresses_.insert(std::string(address)).second) {
+        subchannel->SetConnectivityState(GRPC_CHANNEL_CONNECTING);
+        subchannel->SetConnectivityState(GRPC_CHANNEL_READY);
+      }
+    }
+    RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker;
+    while (!helper_->QueueEmpty()) {
+      auto update = helper_->GetNextStateUpdate();
+      EXPECT_TRUE(update.has_value());
+      if (!update.has_value()) return nullptr;
+      picker = std::move(update->picker);
+    }
+    return picker;
+  }
+
+  // Returns the address picked for each hash in [0, num_hashes).
+  std::vector<std::string> PickAll(
+      LoadBalancingPolicy::SubchannelPicker* picker, size_t num_hashes) {
+    std::vector<std::string> picks;
+    picks.reserve(num_hashes);
+    for (size_t h = 0; h < num_hashes; ++h) {
+      CallAttributes attributes;
+      attributes.emplace_back(
+          std::make_unique<RequestHashAttribute>(absl::StrCat(h)));
+      auto address = ExpectPickComplete(picker, attributes);
+      picks.push_back(address.value_or(""));
+    }
+    return picks;
+  }
+
+  OrphanablePtr<LoadBalancingPolicy> lb_policy_;
+  std::set<std::string> ready_addresses_;
+};
+
+TEST_F(MaglevTest, SlotsAreSpreadEvenly) {
+  const std::array<absl::string_view, 3> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443"};
+  auto picker = UpdateAllReady(kAddresses, /*table_size=*/101);
+  ASSERT_NE(picker, nullptr);
+  // Hashes are mapped to slots modulo the table size, so picking every
+  // hash in [0, 101) visits every slot once.
+  std::map<std::string, size_t> counts;
+  for (const std::string& address : PickAll(picker.get(), 101)) {
+    ++counts[address];
+  }
+  ASSERT_EQ(counts.size(), kAddresses.size());
+  for (const auto& p : counts) {
+    EXPECT_THAT(p.second, ::testing::AnyOf(33, 34)) << p.first;
+  }
+}
+
+TEST_F(MaglevTest, AddingAnEndpointMovesFewKeys) {
+  const std::array<absl::string_view, 4> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443",
+      "ipv4:127.0.0.1:444"};
+  constexpr size_t kTableSize = 65537;
+  auto picker = UpdateAllReady(absl::MakeSpan(kAddresses).subspan(0, 3),
+                               kTableSize);
+  ASSERT_NE(picker, nullptr);
+  const std::vector<std::string> before = PickAll(picker.get(), kTableSize);
+  picker = UpdateAllReady(kAddresses, kTableSize);
+  ASSERT_NE(picker, nullptr);
+  const std::vector<std::string> after = PickAll(picker.get(), kTableSize);
+  size_t moved_to_new_address = 0;
+  size_t moved_between_old_addresses = 0;
+  for (size_t i = 0; i < kTableSize; ++i) {
+    if (after[i] == kAddresses[3]) {
+      ++moved_to_new_address;
+    } else if (after[i] != before[i]) {
+      ++moved_between_old_addresses;
+    }
+  }
+  // The new address takes its fair share of the slots, almost entirely
+  // from the existing addresses' shares.
+  EXPECT_NEAR(moved_to_new_address, kTableSize / 4, 1);
+  EXPECT_LT(moved_between_old_addresses, kTableSize / 100);
+}
+
+TEST(MaglevConfigTest, TableSizeMustBePrime) {
+  for (const int table_size : {0, 1, 65536, 5000023}) {
+    auto config =
+        CoreConfiguration::Get().lb_policy_registry().ParseLoadBalancingConfig(
+            Json::FromArray({Json::FromObject(
+                {{"maglev_experimental",
+                  Json::FromObject(
+                      {{"tableSize", Json::FromNumber(table_size)}})}})}));
+    EXPECT_EQ(config.status().code(), absl::StatusCode::kInvalidArgument)
+        << table_size;
+    EXPECT_EQ(config.status().message(),
+              "errors validating maglev LB policy config: ["
+              "field:tableSize error:must be a prime number no larger than "
+              "5000011]")
+        << table_size;
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,224 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#define XXH_INLINE_ALL
+#include "xxhash.h"
+
+#include <grpc/grpc.h>
+#include <grpc/impl/grpc_types.h>
+#include <grpc/support/json.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "test/core/client_channel/lb_policy/lb_policy_test_lib.h"
+#include "test/core/event_engine/mock_event_engine.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+class RingHashTest : public LoadBalancingPolicyTest {
+ protected:
+  // Creates the LB policy with the given channel args, sends it an
+  // update with the given addresses, brings all subchannels to READY,
+  // and returns the resulting picker.
+  RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> StartAllReady(
+      absl::Span<const absl::string_view> addresses, size_t min_ring_size,
+      const ChannelArgs& channel_args = ChannelArgs()) {
+    lb_policy_ = MakeLbPolicy("ring_hash_experimental", channel_args);
+    auto config = MakeConfig(Json::FromArray({Json::FromObject(
+        {{"ring_hash_experimental",
+          Json::FromObject(
+              {{"minRingSize", Json::FromNumber(min_ring_size)},
+               {"maxRingSize", Json::FromNumber(min_ring_size)}})}})}));
+    EXPECT_EQ(
+        ApplyUpdate(BuildUpdate(addresses, std::move(config)), lb_policy_.get()),
+        absl::OkStatus());
+    for (const absl::string_view address : addresses) {
+      auto* subchannel = FindSubchannel(address);
+      EXPECT_NE(subchannel, nullptr) << "Address: " << address;
+      if (subchannel == nullptr) return nullptr;
+      subchannel->SetConnectivityState(GRPC_CHANNEL_CONNECTING);
+      subchannel->SetConnectivityState(GRPC_CHANNEL_READY);
+    }
+    // Keep the last picker reported; by now, all subchannels are READY.
+    RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker;
+    while (!helper_->QueueEmpty()) {
+      auto update = helper_->GetNextStateUpdate();
+      EXPECT_TRUE(update.has_value());
+      if (!update.has_value()) return nullptr;
+      picker = std::move(update->picker);
+    }
+    return picker;
+  }
+
+  // Returns call attributes requesting the given hash.
+  static CallAttributes HashAttributes(uint64_t hash) {
+    CallAttributes attributes;
+    attributes.emplace_back(
+        std::make_unique<RequestHashAttribute>(absl::StrCat(hash)));
+    return attributes;
+  }
+
+  // Returns the hash of the given ring entry of an address, as computed
+  // by the policy when building the ring.
+  static uint64_t EntryHash(absl::string_view address, size_t entry) {
+    // Strip the "ipv4:" URI scheme used by the test framework.
+    const std::string key =
+        absl::StrCat(address.substr(address.find(':') + 1), "_", entry);
+    return XXH64(key.data(), key.size(), 0);
+  }
+
+  OrphanablePtr<LoadBalancingPolicy> lb_policy_;
+};
+
+TEST_F(RingHashTest, PicksEntryWithMatchingHash) {
+  const std::array<absl::string_view, 3> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443"};
+  auto picker = StartAllReady(kAddresses, /*min_ring_size=*/12);
+  ASSERT_NE(picker, nullptr);
+  for (const absl::string_view address : kAddresses) {
+    for (size_t entry = 0; entry < 4; ++entry) {
+      EXPECT_EQ(ExpectPickComplete(picker.get(),
+                                   HashAttributes(EntryHash(address, entry))),
+                address)
+          << "entry " << entry;
+    }
+  }
+}
+
+TEST_F(RingHashTest, LargeRing) {
+  // Big enough for the ring to be hashed in parallel on the EventEngine, if
+  // the machine has multiple cores.
+  const std::array<absl::string_view, 3> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443"};
+  auto picker = StartAllReady(
+      kAddresses, /*min_ring_size=*/300000,
+      ChannelArgs().Set(GRPC_ARG_RING_HASH_LB_RING_SIZE_CAP, 300000));
+  ASSERT_NE(picker, nullptr);
+  for (const absl::string_view address : kAddresses) {
+    for (size_t entry : {0, 1, 1000, 50000, 99999}) {
+      EXPECT_EQ(ExpectPickComplete(picker.get(),
+                                   HashAttributes(EntryHash(address, entry))),
+                address)
+          << "entry " << entry;
+    }
+  }
+}
+
+// An EventEngine that never runs the closures it is given.
+class RingHashStalledEventEngineTest : public RingHashTest {
+ protected:
+  RingHashStalledEventEngineTest() {
+    auto mock_ee =
+        std::make_shared<grpc_event_engine::experimental::MockEventEngine>();
+    ON_CALL(*mock_ee, Run(::testing::A<absl::AnyInvocable<void()>>()))
+        .WillByDefault([](absl::AnyInvocable<void()> /*closure*/) {});
+    event_engine_ = std::move(mock_ee);
+  }
+};
+
+TEST_F(RingHashStalledEventEngineTest, LargeRingIsHashedOnPolicyThread) {
+  // The chunks offered to the EventEngine are hashed by the thread building
+  // the ring instead.
+  const std::array<absl::string_view, 3> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443"};
+  auto picker = StartAllReady(
+      kAddresses, /*min_ring_size=*/300000,
+      ChannelArgs().Set(GRPC_ARG_RING_HASH_LB_RING_SIZE_CAP, 300000));
+  ASSERT_NE(picker, nullptr);
+  for (const absl::string_view address : kAddresses) {
+    for (size_t entry : {0, 1, 1000, 50000, 99999}) {
+      EXPECT_EQ(ExpectPickComplete(picker.get(),
+                                   HashAttributes(EntryHash(address, entry))),
+                address)
+          << "entry " << entry;
+    }
+  }
+}
+
+TEST_F(RingHashTest, BoundedLoadSpillsOverToNeighbors) {
+  const std::array<absl::string_view, 3> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443"};
+  auto picker = StartAllReady(
+      kAddresses, /*min_ring_size=*/1024,
+      ChannelArgs().Set(GRPC_ARG_RING_HASH_LB_BALANCE_FACTOR, 150));
+  ASSERT_NE(picker, nullptr);
+  const CallAttributes attributes = HashAttributes(EntryHash(kAddresses[0], 0));
+  // Start 30 calls with the same hash, without finishing any of them.
+  // No address may have more than 150% of the average load, i.e. 15.
+  std::vector<
+      std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>>
+      call_trackers;
+  std::map<std::string, size_t> counts;
+  for (size_t i = 0; i < 30; ++i) {
+    std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
+        call_tracker;
+    auto address = ExpectPickComplete(picker.get(), attributes, &call_tracker);
+    ASSERT_TRUE(address.has_value());
+    ASSERT_NE(call_tracker, nullptr);
+    call_tracker->Start();
+    call_trackers.push_back(std::move(call_tracker));
+    ++counts[*address];
+  }
+  EXPECT_EQ(counts[std::string(kAddresses[0])], 15);
+  for (const auto& p : counts) EXPECT_LE(p.second, 15) << p.first;
+  // Once the calls finish, the hash goes back to its own address.
+  for (auto& call_tracker : call_trackers) {
+    FakeMetadata metadata({});
+    FakeBackendMetricAccessor backend_metric_accessor({});
+    call_tracker->Finish(
+        {"", absl::OkStatus(), &metadata, &backend_metric_accessor});
+  }
+  EXPECT_EQ(ExpectPickComplete(picker.get(), attributes), kAddresses[0]);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
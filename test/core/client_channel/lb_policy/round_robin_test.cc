@@ -17,14 +17,21 @@
 #include <stddef.h>
 
 #include <array>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "absl/types/span.h"
 #include "gtest/gtest.h"
 
 #include <grpc/grpc.h>
+#include <grpc/impl/grpc_types.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/load_balancing/lb_policy.h"
@@ -108,6 +115,109 @@ TEST_F(RoundRobinTest, AddressUpdates) {
 // - empty address list
 // - subchannels failing connection attempts
 
+// Upper bound on the number of per-CPU shards used by the picker.
+// Within a single shard, the number of picks for any two addresses
+// differs by at most one, so this also bounds the imbalance between
+// addresses across all shards.
+constexpr size_t kMaxShards = 32;
+
+class RoundRobinPerCpuPickerTest : public LoadBalancingPolicyTest {
+ protected:
+  RoundRobinPerCpuPickerTest()
+      : lb_policy_(MakeLbPolicy(
+            "round_robin",
+            ChannelArgs().Set(GRPC_ARG_ROUND_ROBIN_LB_PER_CPU_PICKER, true))) {}
+
+  // Brings up all subchannels and returns the first picker that uses
+  // all of them.  Because each CPU has its own pick cursor, consecutive
+  // picks from the test thread are not guaranteed to be in strict
+  // round-robin order if the thread migrates between CPUs, so we only
+  // check which addresses are returned, not their order.
+  RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> ExpectStartup(
+      absl::Span<const absl::string_view> addresses) {
+    EXPECT_EQ(ApplyUpdate(BuildUpdate(addresses, nullptr), lb_policy_.get()),
+              absl::OkStatus());
+    ExpectConnectingUpdate();
+    for (const absl::string_view address : addresses) {
+      auto* subchannel = FindSubchannel(address);
+      EXPECT_NE(subchannel, nullptr) << "Address: " << address;
+      if (subchannel == nullptr) return nullptr;
+      EXPECT_TRUE(subchannel->ConnectionRequested());
+      subchannel->SetConnectivityState(GRPC_CHANNEL_CONNECTING);
+      subchannel->SetConnectivityState(GRPC_CHANNEL_READY);
+    }
+    RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker;
+    WaitForStateUpdate([&](FakeHelper::StateUpdate update) {
+      if (update.state == GRPC_CHANNEL_CONNECTING) return true;
+      EXPECT_EQ(update.state, GRPC_CHANNEL_READY);
+      if (update.state != GRPC_CHANNEL_READY) return false;
+      auto picks = GetCompletePicks(update.picker.get(), addresses.size() * 3);
+      if (!picks.has_value()) return false;
+      std::map<std::string, size_t> counts = CountPicks(*picks);
+      if (counts.size() < addresses.size()) return true;  // Keep going.
+      picker = std::move(update.picker);
+      return false;  // Stop.
+    });
+    return picker;
+  }
+
+  static std::map<std::string, size_t> CountPicks(
+      const std::vector<std::string>& picks) {
+    std::map<std::string, size_t> counts;
+    for (const std::string& address : picks) ++counts[address];
+    return counts;
+  }
+
+  OrphanablePtr<LoadBalancingPolicy> lb_policy_;
+};
+
+TEST_F(RoundRobinPerCpuPickerTest, EvenDistribution) {
+  const std::array<absl::string_view, 3> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443"};
+  constexpr size_t kPicksPerAddress = 1000;
+  auto picker = ExpectStartup(kAddresses);
+  ASSERT_NE(picker, nullptr);
+  auto picks =
+      GetCompletePicks(picker.get(), kPicksPerAddress * kAddresses.size());
+  ASSERT_TRUE(picks.has_value());
+  std::map<std::string, size_t> counts = CountPicks(*picks);
+  ASSERT_EQ(counts.size(), kAddresses.size());
+  for (const auto& p : counts) {
+    EXPECT_NEAR(p.second, kPicksPerAddress, kMaxShards) << p.first;
+  }
+}
+
+TEST_F(RoundRobinPerCpuPickerTest, ConcurrentPicks) {
+  const std::array<absl::string_view, 4> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443",
+      "ipv4:127.0.0.1:444"};
+  constexpr size_t kNumThreads = 8;
+  constexpr size_t kPicksPerThread = 4000;
+  auto picker = ExpectStartup(kAddresses);
+  ASSERT_NE(picker, nullptr);
+  std::vector<std::vector<std::string>> picks_by_thread(kNumThreads);
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      auto picks = GetCompletePicks(picker.get(), kPicksPerThread);
+      if (picks.has_value()) picks_by_thread[i] = std::move(*picks);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  std::map<std::string, size_t> counts;
+  for (const auto& picks : picks_by_thread) {
+    ASSERT_EQ(picks.size(), kPicksPerThread);
+    for (const auto& p : CountPicks(picks)) counts[p.first] += p.second;
+  }
+  ASSERT_EQ(counts.size(), kAddresses.size());
+  const size_t expected_per_address =
+      kNumThreads * kPicksPerThread / kAddresses.size();
+  for (const auto& p : counts) {
+    EXPECT_NEAR(p.second, expected_per_address, kMaxShards) << p.first;
+  }
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
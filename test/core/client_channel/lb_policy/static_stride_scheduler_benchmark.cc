@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <cstdint>
 #include <vector>
 
@@ -28,6 +29,7 @@
 
 #include <grpc/support/log.h>
 
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/alias_table_scheduler.h"
 #include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
 #include "src/core/lib/gprpp/no_destruct.h"
 
@@ -56,6 +58,40 @@ const std::vector<float>& Weights() {
   return *kWeights;
 }
 
+// Returns a randomly ordered list of weights whose logarithms are equally
+// distributed between log(0.01) and log(1.0), i.e. spanning two orders of
+// magnitude.  This is the worst case for StaticStrideScheduler, since most
+// weights are a small fraction of the max.
+const std::vector<float>& SkewedWeights() {
+  static const NoDestruct<std::vector<float>> kWeights([] {
+    static NoDestruct<absl::BitGen> bit_gen;
+    std::vector<float> weights;
+    weights.reserve(kNumWeightsHigh);
+    for (int i = 0; i < kNumWeightsHigh; ++i) {
+      weights.push_back(std::pow(100.0, -static_cast<double>(i) /
+                                            (kNumWeightsHigh - 1)));
+    }
+    absl::c_shuffle(weights, *bit_gen);
+    return weights;
+  }());
+  return *kWeights;
+}
+
+// A cheap, non-atomic random number generator (splitmix64), standing in for
+// the per-thread generator used by weighted_round_robin.
+class SplitMix64 {
+ public:
+  uint64_t operator()() {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+  }
+
+ private:
+  uint64_t state_ = 0;
+};
+
 void BM_StaticStrideSchedulerPickNonAtomic(benchmark::State& state) {
   uint32_t sequence = 0;
   const absl::optional<StaticStrideScheduler> scheduler =
@@ -100,6 +136,65 @@ BENCHMARK(BM_StaticStrideSchedulerMake)
     ->RangeMultiplier(kRangeMultiplier)
     ->Range(kNumWeightsLow, kNumWeightsHigh);
 
+void BM_StaticStrideSchedulerPickSkewed(benchmark::State& state) {
+  uint32_t sequence = 0;
+  const absl::optional<StaticStrideScheduler> scheduler =
+      StaticStrideScheduler::Make(
+          absl::MakeSpan(SkewedWeights()).subspan(0, state.range(0)),
+          [&] { return sequence++; });
+  GPR_ASSERT(scheduler.has_value());
+  for (auto s : state) {
+    benchmark::DoNotOptimize(scheduler->Pick());
+  }
+}
+BENCHMARK(BM_StaticStrideSchedulerPickSkewed)
+    ->RangeMultiplier(kRangeMultiplier)
+    ->Range(kNumWeightsLow, kNumWeightsHigh);
+
+void BM_AliasTableSchedulerPick(benchmark::State& state) {
+  SplitMix64 rng;
+  const absl::optional<AliasTableScheduler> scheduler =
+      AliasTableScheduler::Make(
+          absl::MakeSpan(Weights()).subspan(0, state.range(0)),
+          [&] { return rng(); });
+  GPR_ASSERT(scheduler.has_value());
+  for (auto s : state) {
+    benchmark::DoNotOptimize(scheduler->Pick());
+  }
+}
+BENCHMARK(BM_AliasTableSchedulerPick)
+    ->RangeMultiplier(kRangeMultiplier)
+    ->Range(kNumWeightsLow, kNumWeightsHigh);
+
+void BM_AliasTableSchedulerPickSkewed(benchmark::State& state) {
+  SplitMix64 rng;
+  const absl::optional<AliasTableScheduler> scheduler =
+      AliasTableScheduler::Make(
+          absl::MakeSpan(SkewedWeights()).subspan(0, state.range(0)),
+          [&] { return rng(); });
+  GPR_ASSERT(scheduler.has_value());
+  for (auto s : state) {
+    benchmark::DoNotOptimize(scheduler->Pick());
+  }
+}
+BENCHMARK(BM_AliasTableSchedulerPickSkewed)
+    ->RangeMultiplier(kRangeMultiplier)
+    ->Range(kNumWeightsLow, kNumWeightsHigh);
+
+void BM_AliasTableSchedulerMake(benchmark::State& state) {
+  SplitMix64 rng;
+  for (auto s : state) {
+    const absl::optional<AliasTableScheduler> scheduler =
+        AliasTableScheduler::Make(
+            absl::MakeSpan(SkewedWeights()).subspan(0, state.range(0)),
+            [&] { return rng(); });
+    GPR_ASSERT(scheduler.has_value());
+  }
+}
+BENCHMARK(BM_AliasTableSchedulerMake)
+    ->RangeMultiplier(kRangeMultiplier)
+    ->Range(kNumWeightsLow, kNumWeightsHigh);
+
 }  // namespace
 }  // namespace grpc_core
 
@@ -38,10 +38,12 @@
 
 #include <grpc/event_engine/event_engine.h>
 #include <grpc/grpc.h>
+#include <grpc/impl/grpc_types.h>
 #include <grpc/support/json.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -862,6 +864,40 @@ TEST_F(WeightedRoundRobinTest, ZeroErrorUtilPenalty) {
       {{kAddresses[0], 1}, {kAddresses[1], 1}, {kAddresses[2], 1}});
 }
 
+TEST_F(WeightedRoundRobinTest, AliasTableScheduler) {
+  lb_policy_ = MakeLbPolicy(
+      "weighted_round_robin",
+      ChannelArgs().Set(GRPC_ARG_WEIGHTED_ROUND_ROBIN_LB_ALIAS_TABLE_SCHEDULER,
+                        true));
+  // Send address list to LB policy.
+  const std::array<absl::string_view, 3> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443"};
+  auto picker = SendInitialUpdateAndWaitForConnected(
+      kAddresses, ConfigBuilder()
+                      .SetEnableOobLoadReport(true)
+                      .SetBlackoutPeriod(Duration::Zero()));
+  ASSERT_NE(picker, nullptr);
+  // Address 0 gets weight 1, address 1 gets weight 3.
+  // No utilization report from backend 2, so it gets the average weight 2.
+  ReportOobBackendMetrics(
+      {{kAddresses[0], MakeBackendMetricData(/*app_utilization=*/0.9,
+                                             /*qps=*/100.0, /*eps=*/0.0)},
+       {kAddresses[1], MakeBackendMetricData(/*app_utilization=*/0.3,
+                                             /*qps=*/100.0, /*eps=*/0.0)}});
+  // Run the timer, so that the picker picks up the new weights.
+  time_cache_.IncrementBy(Duration::Seconds(1));
+  RunTimerCallback();
+  // The alias table scheduler picks at random, so the counts are only
+  // expected to be close to the weights.
+  auto picks = GetCompletePicks(picker.get(), 6000);
+  ASSERT_TRUE(picks.has_value());
+  auto actual = MakePickMap(*picks);
+  gpr_log(GPR_INFO, "Pick map: %s", PickMapString(actual).c_str());
+  EXPECT_NEAR(actual[kAddresses[0]], 1000, 200);
+  EXPECT_NEAR(actual[kAddresses[1]], 3000, 200);
+  EXPECT_NEAR(actual[kAddresses[2]], 2000, 200);
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
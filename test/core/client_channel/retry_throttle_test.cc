@@ -65,6 +65,24 @@ TEST(ServerRetryThrottleData, Basic) {
   EXPECT_TRUE(throttle_data->RecordFailure());
 }
 
+TEST(ServerRetryThrottleData, IsThrottled) {
+  // Max token count is 4, so threshold for retrying is 2.
+  auto throttle_data =
+      MakeRefCounted<ServerRetryThrottleData>(4000, 1600, nullptr);
+  // token_count=4.  Checking does not change the count.
+  EXPECT_FALSE(throttle_data->IsThrottled());
+  EXPECT_FALSE(throttle_data->IsThrottled());
+  // Failure: token_count=3.  Above threshold.
+  EXPECT_TRUE(throttle_data->RecordFailure());
+  EXPECT_FALSE(throttle_data->IsThrottled());
+  // Failure: token_count=2.  At threshold.
+  EXPECT_FALSE(throttle_data->RecordFailure());
+  EXPECT_TRUE(throttle_data->IsThrottled());
+  // Success: token_count=3.6.
+  throttle_data->RecordSuccess();
+  EXPECT_FALSE(throttle_data->IsThrottled());
+}
+
 TEST(ServerRetryThrottleData, Replacement) {
   // Create old throttle data.
   // Max token count is 4, so threshold for retrying is 2.
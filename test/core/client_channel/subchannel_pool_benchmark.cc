@@ -0,0 +1,187 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmarks the global subchannel pool when many channels create
+// subchannels at once, as they do when they all get the same resolver
+// update (e.g. after an xDS EDS push).  Each benchmark thread plays the
+// part of a channel.
+
+#include <stddef.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+
+#include <grpc/grpc.h>
+#include <grpc/impl/grpc_types.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/connector.h"
+#include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/crash.h"
+#include "src/core/lib/gprpp/no_destruct.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/resolved_address.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// The subchannels are never asked to connect.
+class NoopConnector : public SubchannelConnector {
+ public:
+  void Connect(const Args& /*args*/, Result* /*result*/,
+               grpc_closure* /*notify*/) override {
+    Crash("unexpected connection attempt");
+  }
+  void Shutdown(grpc_error_handle /*error*/) override {}
+};
+
+// Channel args as a channel would pass them to its subchannels.  Channelz
+// is disabled so that the benchmark measures the pool rather than the
+// channelz registry.
+ChannelArgs MakeChannelArgs() {
+  return CoreConfiguration::Get()
+      .channel_args_preconditioning()
+      .PreconditionChannelArgs(nullptr)
+      .Set(GRPC_ARG_ENABLE_CHANNELZ, false)
+      .Set(GRPC_ARG_PRIMARY_USER_AGENT_STRING, "subchannel_pool_benchmark")
+      .Set(GRPC_ARG_KEEPALIVE_TIME_MS, 30000)
+      .SetObject(GlobalSubchannelPool::instance());
+}
+
+// Holds num_endpoints subchannels in the global pool, as the channels that
+// already got the resolver update would.  Instances are created once per
+// endpoint count and shared by all benchmark threads.
+class PoolFixture {
+ public:
+  explicit PoolFixture(size_t num_endpoints) : args_(MakeChannelArgs()) {
+    ExecCtx exec_ctx;
+    for (size_t i = 0; i < num_endpoints; ++i) {
+      absl::StatusOr<grpc_resolved_address> address =
+          StringToSockaddr(absl::StrFormat("10.%d.%d.%d:443", (i >> 16) & 0xff,
+                                           (i >> 8) & 0xff, i & 0xff));
+      GPR_ASSERT(address.ok());
+      addresses_.push_back(*address);
+      subchannels_.push_back(CreateSubchannel(i, args_));
+    }
+  }
+
+  size_t num_endpoints() const { return addresses_.size(); }
+  const ChannelArgs& args() const { return args_; }
+
+  RefCountedPtr<Subchannel> CreateSubchannel(size_t i,
+                                             const ChannelArgs& args) const {
+    return Subchannel::Create(MakeOrphanable<NoopConnector>(), addresses_[i],
+                              args);
+  }
+
+ private:
+  const ChannelArgs args_;
+  std::vector<grpc_resolved_address> addresses_;
+  std::vector<RefCountedPtr<Subchannel>> subchannels_;
+};
+
+// Returns the shared fixture for the given endpoint count, creating it on
+// first use.  Fixtures are intentionally leaked.
+PoolFixture* GetFixture(size_t num_endpoints) {
+  static NoDestruct<Mutex> mu;
+  static NoDestruct<std::map<size_t, PoolFixture*>> fixtures;
+  MutexLock lock(mu.get());
+  PoolFixture*& fixture = (*fixtures)[num_endpoints];
+  if (fixture == nullptr) fixture = new PoolFixture(num_endpoints);
+  return fixture;
+}
+
+// Every channel gets the same update and creates subchannels for all of
+// the endpoints, which are all found in the pool.
+void BM_FindExistingSubchannel(benchmark::State& state) {
+  PoolFixture* fixture = GetFixture(state.range(0));
+  ExecCtx exec_ctx;
+  // Start each thread at a different endpoint, like channels that did not
+  // get the update at the same instant.
+  size_t i = state.thread_index() * 7919;
+  for (auto _ : state) {
+    RefCountedPtr<Subchannel> subchannel = fixture->CreateSubchannel(
+        i++ % fixture->num_endpoints(), fixture->args());
+    benchmark::DoNotOptimize(subchannel);
+    exec_ctx.Flush();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FindExistingSubchannel)
+    ->RangeMultiplier(100)
+    ->Range(10, 1000)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+// Every channel has args of its own, so each subchannel it creates is
+// registered in the pool, and unregistered when it is dropped, while the
+// other channels do the same.
+void BM_RegisterAndUnregisterSubchannel(benchmark::State& state) {
+  PoolFixture* fixture = GetFixture(state.range(0));
+  ExecCtx exec_ctx;
+  const ChannelArgs args = fixture->args().Set(
+      "grpc.internal.subchannel_pool_benchmark_channel", state.thread_index());
+  size_t i = 0;
+  for (auto _ : state) {
+    RefCountedPtr<Subchannel> subchannel =
+        fixture->CreateSubchannel(i++ % fixture->num_endpoints(), args);
+    benchmark::DoNotOptimize(subchannel);
+    subchannel.reset();
+    exec_ctx.Flush();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RegisterAndUnregisterSubchannel)
+    ->RangeMultiplier(100)
+    ->Range(10, 1000)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  // The fixtures are leaked (see GetFixture()), so we don't call
+  // grpc_shutdown() here.
+  grpc_init();
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,163 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/lib/debug/call_timeline.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+#include <grpc/impl/grpc_types.h>
+
+#include "src/core/lib/channel/channel_args.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+TEST(CallTimelineTest, SamplesOneInN) {
+  EXPECT_FALSE(CallTimeline::ShouldSample(0));
+  int sampled = 0;
+  for (int i = 0; i < 300; ++i) {
+    if (CallTimeline::ShouldSample(10)) ++sampled;
+  }
+  EXPECT_EQ(sampled, 30);
+  for (int i = 0; i < 10; ++i) EXPECT_TRUE(CallTimeline::ShouldSample(1));
+}
+
+TEST(CallTimelineTest, LowerRateResetsCountdown) {
+  // Leave a long countdown from a channel with a high rate...
+  EXPECT_TRUE(CallTimeline::ShouldSample(1));
+  EXPECT_TRUE(CallTimeline::ShouldSample(1000000));
+  // ...which must not stop a channel with a lower rate from sampling.
+  int sampled = 0;
+  for (int i = 0; i < 20; ++i) {
+    if (CallTimeline::ShouldSample(2)) ++sampled;
+  }
+  EXPECT_EQ(sampled, 10);
+}
+
+TEST(CallTimelineTest, RecordsPhasesInOrder) {
+  grpc_call_context_element context[GRPC_CONTEXT_COUNT] = {};
+  // Not sampled: nothing to record to.
+  CallTimeline::Record(context, CallPhase::kRead);
+  CallTimeline::Record(nullptr, CallPhase::kRead);
+  CallTimeline timeline(gpr_get_cycle_counter());
+  context[GRPC_CONTEXT_CALL_TIMELINE].value = &timeline;
+  timeline.Record(CallPhase::kArenaCreated);
+  CallTimeline::Record(context, CallPhase::kLbPickQueued);
+  CallTimeline::Record(context, CallPhase::kLbPickComplete);
+  CallTimeline::Record(context, CallPhase::kEnd);
+  const std::string result = timeline.ToString();
+  const size_t arena = result.find("arena_created +");
+  const size_t queued = result.find("lb_pick_queued +");
+  const size_t complete = result.find("lb_pick_complete +");
+  const size_t end = result.find("end +");
+  ASSERT_NE(arena, std::string::npos) << result;
+  ASSERT_NE(queued, std::string::npos) << result;
+  ASSERT_NE(complete, std::string::npos) << result;
+  ASSERT_NE(end, std::string::npos) << result;
+  EXPECT_LT(arena, queued);
+  EXPECT_LT(queued, complete);
+  EXPECT_LT(complete, end);
+}
+
+TEST(CallTimelineTest, KeepsLastEvents) {
+  CallTimeline timeline(gpr_get_cycle_counter());
+  for (size_t i = 0; i < CallTimeline::kMaxEvents; ++i) {
+    timeline.Record(CallPhase::kRead);
+  }
+  timeline.Record(CallPhase::kEnd);
+  const std::string result = timeline.ToString();
+  EXPECT_TRUE(absl::StartsWith(result, "(1 events dropped)")) << result;
+  EXPECT_TRUE(absl::StrContains(result, "end +")) << result;
+}
+
+TEST(CallTimelineTest, IsStreaming) {
+  CallTimeline unary(gpr_get_cycle_counter());
+  unary.CountSendMessage();
+  unary.CountRecvMessage();
+  EXPECT_FALSE(unary.is_streaming());
+  CallTimeline client_streaming(gpr_get_cycle_counter());
+  client_streaming.CountSendMessage();
+  client_streaming.CountSendMessage();
+  client_streaming.CountRecvMessage();
+  EXPECT_TRUE(client_streaming.is_streaming());
+  CallTimeline server_streaming(gpr_get_cycle_counter());
+  server_streaming.CountSendMessage();
+  server_streaming.CountRecvMessage();
+  server_streaming.CountRecvMessage();
+  EXPECT_TRUE(server_streaming.is_streaming());
+}
+
+TEST(CallFlightRecorderTest, KeepsOnlySlowCalls) {
+  CallFlightRecorder recorder;
+  CallTimeline timeline(gpr_get_cycle_counter());
+  timeline.set_method(Slice::FromStaticString("/foo/bar"));
+  timeline.Record(CallPhase::kEnd);
+  EXPECT_FALSE(recorder
+                   .OnCallEnd(timeline, GRPC_STATUS_OK,
+                              Duration::Seconds(10))
+                   .has_value());
+  EXPECT_TRUE(recorder.SlowCalls().empty());
+  auto slow_call =
+      recorder.OnCallEnd(timeline, GRPC_STATUS_UNAVAILABLE, Duration::Zero());
+  ASSERT_TRUE(slow_call.has_value());
+  EXPECT_EQ(slow_call->method, "/foo/bar");
+  EXPECT_EQ(slow_call->status, GRPC_STATUS_UNAVAILABLE);
+  EXPECT_TRUE(absl::StrContains(slow_call->ToString(), "/foo/bar"));
+  EXPECT_TRUE(absl::StrContains(slow_call->ToString(), "UNAVAILABLE"));
+  EXPECT_EQ(recorder.SlowCalls().size(), 1);
+}
+
+TEST(CallFlightRecorderTest, KeepsLastSlowCalls) {
+  CallFlightRecorder recorder;
+  for (size_t i = 0; i < CallFlightRecorder::kMaxSlowCalls + 1; ++i) {
+    CallTimeline timeline(gpr_get_cycle_counter());
+    timeline.set_method(Slice::FromCopiedString(absl::StrCat("/m/", i)));
+    recorder.OnCallEnd(timeline, GRPC_STATUS_OK, Duration::Zero());
+  }
+  std::vector<CallFlightRecorder::SlowCall> slow_calls = recorder.SlowCalls();
+  ASSERT_EQ(slow_calls.size(), CallFlightRecorder::kMaxSlowCalls);
+  EXPECT_EQ(slow_calls.front().method, "/m/1");
+  EXPECT_EQ(slow_calls.back().method,
+            absl::StrCat("/m/", CallFlightRecorder::kMaxSlowCalls));
+}
+
+TEST(CallTimelineOptionsTest, FromChannelArgs) {
+  auto options = CallTimelineOptions::FromChannelArgs(ChannelArgs());
+  EXPECT_EQ(options.sample_rate, CallTimelineOptions::kDefaultSampleRate);
+  EXPECT_EQ(options.slow_call_threshold,
+            CallTimelineOptions::kDefaultSlowCallThreshold);
+  options = CallTimelineOptions::FromChannelArgs(
+      ChannelArgs()
+          .Set(GRPC_ARG_CALL_TIMELINE_SAMPLE_RATE, 0)
+          .Set(GRPC_ARG_SLOW_CALL_THRESHOLD_MS, 250));
+  EXPECT_EQ(options.sample_rate, 0);
+  EXPECT_EQ(options.slow_call_threshold, Duration::Milliseconds(250));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
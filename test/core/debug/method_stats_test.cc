@@ -0,0 +1,206 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/lib/debug/method_stats.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+#include "src/core/lib/debug/histogram_view.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+int FindExpectedBucket(const HistogramView& h, int value) {
+  if (value < 0) {
+    return 0;
+  }
+  if (value >= h.bucket_boundaries[h.num_buckets]) {
+    return h.num_buckets - 1;
+  }
+  return std::upper_bound(h.bucket_boundaries,
+                          h.bucket_boundaries + h.num_buckets, value) -
+         h.bucket_boundaries - 1;
+}
+
+TEST(MethodStatsHistogramTest, CheckBucket) {
+  MethodStats stats;
+  auto view = stats.histogram(MethodStats::Histogram::kLatencyUs);
+  std::vector<int> values;
+  for (int i = -1000; i < 100000; i++) values.push_back(i);
+  // Check around each boundary beyond the range covered above.
+  for (int i = 0; i <= view.num_buckets; i++) {
+    const int boundary = view.bucket_boundaries[i];
+    for (int value : {boundary - 1, boundary, boundary + 1}) {
+      values.push_back(value);
+    }
+  }
+  for (int value : values) {
+    ASSERT_EQ(FindExpectedBucket(view, value), view.bucket_for(value))
+        << "value=" << value;
+  }
+}
+
+TEST(MethodStatsHistogramTest, BucketsAreWithinAQuarterOfTheirValues) {
+  const int* boundaries = MethodStatsHistogram::BucketBoundaries();
+  for (int i = 1; i < MethodStatsHistogram::kBuckets; i++) {
+    EXPECT_LT(boundaries[i - 1], boundaries[i]);
+    EXPECT_LE(boundaries[i + 1] - boundaries[i], std::max(1, boundaries[i] / 4))
+        << "bucket " << i;
+  }
+  EXPECT_EQ(boundaries[MethodStatsHistogram::kBuckets], 1 << 30);
+}
+
+class MethodStatsRegistryTest : public ::testing::Test {
+ protected:
+  ExecCtx exec_ctx_;
+};
+
+TEST_F(MethodStatsRegistryTest, RecordsCalls) {
+  MethodStatsRegistry registry;
+  MethodStatsCollector* collector =
+      registry.GetCollector("dns:///foo", "/svc/Method");
+  EXPECT_EQ(collector, registry.GetCollector("dns:///foo", "/svc/Method"));
+  EXPECT_NE(collector, registry.GetCollector("dns:///bar", "/svc/Method"));
+  collector->RecordCall(/*failed=*/false, 1000, 10, 20);
+  collector->RecordCall(/*failed=*/true, 3000, 0, 0);
+  collector->RecordQueueTime(5);
+  auto stats = collector->Collect();
+  EXPECT_EQ(stats->calls, 2);
+  EXPECT_EQ(stats->failed_calls, 1);
+  auto latency = stats->histogram(MethodStats::Histogram::kLatencyUs);
+  EXPECT_EQ(latency.Count(), 2);
+  EXPECT_GE(latency.Percentile(100), 3000 * 0.75);
+  EXPECT_LE(latency.Percentile(0), 1000);
+  EXPECT_EQ(
+      stats->histogram(MethodStats::Histogram::kRequestBytes).Count(), 2);
+  EXPECT_EQ(stats->histogram(MethodStats::Histogram::kQueueTimeUs).Count(),
+            1);
+}
+
+TEST_F(MethodStatsRegistryTest, Diff) {
+  MethodStatsRegistry registry;
+  MethodStatsCollector* collector = registry.GetCollector("", "/svc/Method");
+  collector->RecordCall(/*failed=*/false, 100, 1, 1);
+  auto before = collector->Collect();
+  collector->RecordCall(/*failed=*/true, 1 << 20, 1, 1);
+  auto delta = collector->Collect()->Diff(*before);
+  EXPECT_EQ(delta->calls, 1);
+  EXPECT_EQ(delta->failed_calls, 1);
+  auto latency = delta->histogram(MethodStats::Histogram::kLatencyUs);
+  EXPECT_EQ(latency.Count(), 1);
+  EXPECT_EQ(latency.buckets[MethodStatsHistogram::BucketFor(1 << 20)], 1);
+}
+
+TEST_F(MethodStatsRegistryTest, CollectIsSorted) {
+  MethodStatsRegistry registry;
+  registry.GetCollector("b", "/m");
+  registry.GetCollector("a", "/n");
+  registry.GetCollector("a", "/m");
+  auto entries = registry.Collect();
+  ASSERT_EQ(entries.size(), 3);
+  EXPECT_EQ(entries[0].target, "a");
+  EXPECT_EQ(entries[0].method, "/m");
+  EXPECT_EQ(entries[1].target, "a");
+  EXPECT_EQ(entries[1].method, "/n");
+  EXPECT_EQ(entries[2].target, "b");
+}
+
+TEST_F(MethodStatsRegistryTest, OverflowBeyondMaxEntries) {
+  MethodStatsRegistry registry(/*max_entries=*/2);
+  MethodStatsCollector* a = registry.GetCollector("", "/a");
+  MethodStatsCollector* b = registry.GetCollector("", "/b");
+  MethodStatsCollector* c = registry.GetCollector("", "/c");
+  MethodStatsCollector* d = registry.GetCollector("", "/d");
+  EXPECT_NE(a, b);
+  EXPECT_NE(c, a);
+  EXPECT_NE(c, b);
+  EXPECT_EQ(c, d);
+  // Known methods keep their own collectors.
+  EXPECT_EQ(a, registry.GetCollector("", "/a"));
+  EXPECT_EQ(registry.num_entries(), 2);
+  c->RecordCall(/*failed=*/false, 1, 1, 1);
+  d->RecordCall(/*failed=*/false, 1, 1, 1);
+  auto entries = registry.Collect();
+  ASSERT_EQ(entries.size(), 3);
+  EXPECT_EQ(entries[2].target, "*");
+  EXPECT_EQ(entries[2].method, "*");
+  EXPECT_EQ(entries[2].stats->calls, 2);
+}
+
+TEST_F(MethodStatsRegistryTest, CacheReturnsRegistryCollectors) {
+  MethodStatsRegistry registry;
+  MethodStatsCollectorCache cache("dns:///foo", &registry);
+  MethodStatsCollector* collector = cache.Get("/svc/Method");
+  EXPECT_EQ(collector, registry.GetCollector("dns:///foo", "/svc/Method"));
+  EXPECT_EQ(collector, cache.Get("/svc/Method"));
+  EXPECT_NE(collector, cache.Get("/svc/Other"));
+  EXPECT_EQ(registry.num_entries(), 2);
+}
+
+TEST_F(MethodStatsRegistryTest, CacheHandlesMoreMethodsThanSlots) {
+  MethodStatsRegistry registry(/*max_entries=*/1000);
+  MethodStatsCollectorCache cache("", &registry);
+  std::vector<MethodStatsCollector*> collectors;
+  for (int i = 0; i < 200; ++i) {
+    collectors.push_back(cache.Get(absl::StrCat("/svc/M", i)));
+  }
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_EQ(collectors[i], cache.Get(absl::StrCat("/svc/M", i))) << i;
+    EXPECT_EQ(collectors[i],
+              registry.GetCollector("", absl::StrCat("/svc/M", i)))
+        << i;
+  }
+  EXPECT_EQ(registry.num_entries(), 200);
+}
+
+TEST_F(MethodStatsRegistryTest, CacheDoesNotKeepOverflowedMethods) {
+  MethodStatsRegistry registry(/*max_entries=*/1);
+  MethodStatsCollectorCache cache("", &registry);
+  MethodStatsCollector* a = cache.Get("/a");
+  MethodStatsCollector* b = cache.Get("/b");
+  EXPECT_FALSE(registry.IsOverflow(a));
+  EXPECT_TRUE(registry.IsOverflow(b));
+  EXPECT_EQ(a, cache.Get("/a"));
+  EXPECT_TRUE(registry.IsOverflow(cache.Get("/b")));
+}
+
+TEST_F(MethodStatsRegistryTest, StatsAsJson) {
+  MethodStatsRegistry registry;
+  registry.GetCollector("", "/m")->RecordCall(/*failed=*/false, 1, 1, 1);
+  auto entries = registry.Collect();
+  ASSERT_EQ(entries.size(), 1);
+  std::string json = StatsAsJson(entries[0].stats.get());
+  EXPECT_NE(json.find("\"calls\": 1"), std::string::npos) << json;
+  EXPECT_NE(json.find("\"queue_time_us_bkt\""), std::string::npos) << json;
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,319 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/impl/grpc_types.h>
+#include <grpc/status.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/end2end/end2end_tests.h"
+
+namespace grpc_core {
+namespace {
+
+const char* const kCacheServiceConfig =
+    "{\n"
+    "  \"methodConfig\": [ {\n"
+    "    \"name\": [\n"
+    "      { \"service\": \"service\", \"method\": \"method\" }\n"
+    "    ],\n"
+    "    \"responseCachePolicy\": {\n"
+    "      \"ttl\": \"60s\"\n"
+    "    }\n"
+    "  } ]\n"
+    "}";
+
+ChannelArgs CacheClientArgs(int max_bytes = 1024 * 1024) {
+  return ChannelArgs()
+      .Set(GRPC_ARG_SERVICE_CONFIG, kCacheServiceConfig)
+      .Set(GRPC_ARG_RESPONSE_CACHE_MAX_BYTES, max_bytes);
+}
+
+// Answers a call on the server with "bar" and the given status.
+void RespondOnServer(CoreEnd2endTest::IncomingCall& s, int tag,
+                     grpc_status_code status,
+                     CoreEnd2endTest::IncomingCloseOnServer& client_close) {
+  s.NewBatch(tag)
+      .SendInitialMetadata({})
+      .SendMessage("bar")
+      .SendStatusFromServer(status, "xyz", {})
+      .RecvCloseOnServer(client_close);
+}
+
+// Tests that a cached response is served without reaching the server:
+// - the first call reaches the server and its response is cached
+// - an identical second call completes with the same response while the
+//   server has a call requested that never arrives
+CORE_END2END_TEST(CoreClientChannelTest, ResponseCacheHit) {
+  InitServer(ChannelArgs());
+  InitClient(CacheClientArgs());
+  auto c1 =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message1;
+  IncomingMetadata server_initial_metadata1;
+  IncomingStatusOnClient server_status1;
+  c1.NewBatch(1)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata1)
+      .RecvMessage(server_message1)
+      .RecvStatusOnClient(server_status1);
+  auto s = RequestCall(101);
+  Expect(101, true);
+  Step();
+  IncomingCloseOnServer client_close;
+  RespondOnServer(s, 102, GRPC_STATUS_OK, client_close);
+  Expect(102, true);
+  Expect(1, true);
+  Step();
+  EXPECT_EQ(server_status1.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_message1.payload(), "bar");
+  // The second call is served from the cache.
+  auto s2 = RequestCall(201);
+  auto c2 =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message2;
+  IncomingMetadata server_initial_metadata2;
+  IncomingStatusOnClient server_status2;
+  c2.NewBatch(2)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata2)
+      .RecvMessage(server_message2)
+      .RecvStatusOnClient(server_status2);
+  Expect(2, true);
+  Step();
+  EXPECT_EQ(server_status2.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_message2.payload(), "bar");
+  // A different request is not a hit.
+  auto c3 =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingStatusOnClient server_status3;
+  c3.NewBatch(3)
+      .SendInitialMetadata({})
+      .SendMessage("baz")
+      .SendCloseFromClient()
+      .RecvStatusOnClient(server_status3);
+  Expect(201, true);
+  Step();
+  IncomingCloseOnServer client_close2;
+  s2.NewBatch(202)
+      .SendInitialMetadata({})
+      .SendStatusFromServer(GRPC_STATUS_OK, "xyz", {})
+      .RecvCloseOnServer(client_close2);
+  Expect(202, true);
+  Expect(3, true);
+  Step();
+  EXPECT_EQ(server_status3.status(), GRPC_STATUS_OK);
+}
+
+// Tests that identical concurrent calls share one call to the server:
+// - the first call reaches the server
+// - the second call waits for it instead of reaching the server
+// - both calls get the response of the first one
+CORE_END2END_TEST(CoreClientChannelTest, ResponseCacheCoalescesCalls) {
+  InitServer(ChannelArgs());
+  InitClient(CacheClientArgs());
+  auto c1 =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message1;
+  IncomingMetadata server_initial_metadata1;
+  IncomingStatusOnClient server_status1;
+  c1.NewBatch(1)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata1)
+      .RecvMessage(server_message1)
+      .RecvStatusOnClient(server_status1);
+  auto s = RequestCall(101);
+  Expect(101, true);
+  Step();
+  auto s2 = RequestCall(201);
+  auto c2 =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message2;
+  IncomingMetadata server_initial_metadata2;
+  IncomingStatusOnClient server_status2;
+  c2.NewBatch(2)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata2)
+      .RecvMessage(server_message2)
+      .RecvStatusOnClient(server_status2);
+  // Neither the second call nor a second server call completes.
+  Step();
+  IncomingCloseOnServer client_close;
+  RespondOnServer(s, 102, GRPC_STATUS_OK, client_close);
+  Expect(102, true);
+  Expect(1, true);
+  Expect(2, true);
+  Step();
+  EXPECT_EQ(server_status1.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_message1.payload(), "bar");
+  EXPECT_EQ(server_status2.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_message2.payload(), "bar");
+  ShutdownServerAndNotify(1000);
+  Expect(1000, true);
+  Expect(201, false);
+  Step();
+}
+
+// Tests that a call can be cancelled while it waits for another call:
+// - the second call waits for the first one and is cancelled
+// - the first call still gets its response
+CORE_END2END_TEST(CoreClientChannelTest, ResponseCacheCancelWhileWaiting) {
+  InitServer(ChannelArgs());
+  InitClient(CacheClientArgs());
+  auto c1 =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message1;
+  IncomingMetadata server_initial_metadata1;
+  IncomingStatusOnClient server_status1;
+  c1.NewBatch(1)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata1)
+      .RecvMessage(server_message1)
+      .RecvStatusOnClient(server_status1);
+  auto s = RequestCall(101);
+  Expect(101, true);
+  Step();
+  auto s2 = RequestCall(201);
+  auto c2 =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message2;
+  IncomingMetadata server_initial_metadata2;
+  IncomingStatusOnClient server_status2;
+  c2.NewBatch(2)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata2)
+      .RecvMessage(server_message2)
+      .RecvStatusOnClient(server_status2);
+  Step();
+  c2.Cancel();
+  Expect(2, true);
+  Step();
+  EXPECT_EQ(server_status2.status(), GRPC_STATUS_CANCELLED);
+  IncomingCloseOnServer client_close;
+  RespondOnServer(s, 102, GRPC_STATUS_OK, client_close);
+  Expect(102, true);
+  Expect(1, true);
+  Step();
+  EXPECT_EQ(server_status1.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_message1.payload(), "bar");
+  ShutdownServerAndNotify(1000);
+  Expect(1000, true);
+  Expect(201, false);
+  Step();
+}
+
+// Tests that calls waiting for a call that fails send their own requests:
+// - the second call waits for the first one
+// - the first call fails, so its response is not cached
+// - the second call then reaches the server and gets its own response
+CORE_END2END_TEST(CoreClientChannelTest, ResponseCacheFillFails) {
+  InitServer(ChannelArgs());
+  InitClient(CacheClientArgs());
+  auto c1 =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message1;
+  IncomingMetadata server_initial_metadata1;
+  IncomingStatusOnClient server_status1;
+  c1.NewBatch(1)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata1)
+      .RecvMessage(server_message1)
+      .RecvStatusOnClient(server_status1);
+  auto s = RequestCall(101);
+  Expect(101, true);
+  Step();
+  auto s2 = RequestCall(201);
+  auto c2 =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message2;
+  IncomingMetadata server_initial_metadata2;
+  IncomingStatusOnClient server_status2;
+  c2.NewBatch(2)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata2)
+      .RecvMessage(server_message2)
+      .RecvStatusOnClient(server_status2);
+  Step();
+  IncomingCloseOnServer client_close;
+  RespondOnServer(s, 102, GRPC_STATUS_UNAVAILABLE, client_close);
+  Expect(102, true);
+  Expect(1, true);
+  Expect(201, true);
+  Step();
+  EXPECT_EQ(server_status1.status(), GRPC_STATUS_UNAVAILABLE);
+  IncomingCloseOnServer client_close2;
+  RespondOnServer(s2, 202, GRPC_STATUS_OK, client_close2);
+  Expect(202, true);
+  Expect(2, true);
+  Step();
+  EXPECT_EQ(server_status2.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_message2.payload(), "bar");
+}
+
+// Tests that a zero GRPC_ARG_RESPONSE_CACHE_MAX_BYTES disables the cache,
+// even for methods with a responseCachePolicy: identical calls all reach
+// the server.
+CORE_END2END_TEST(CoreClientChannelTest, ResponseCacheDisabled) {
+  InitServer(ChannelArgs());
+  InitClient(CacheClientArgs(0));
+  for (int i = 1; i <= 2; ++i) {
+    auto c = NewClientCall("/service/method")
+                 .Timeout(Duration::Seconds(30))
+                 .Create();
+    IncomingMessage server_message;
+    IncomingMetadata server_initial_metadata;
+    IncomingStatusOnClient server_status;
+    c.NewBatch(i)
+        .SendInitialMetadata({})
+        .SendMessage("foo")
+        .SendCloseFromClient()
+        .RecvInitialMetadata(server_initial_metadata)
+        .RecvMessage(server_message)
+        .RecvStatusOnClient(server_status);
+    auto s = RequestCall(100 * i + 1);
+    Expect(100 * i + 1, true);
+    Step();
+    IncomingCloseOnServer client_close;
+    RespondOnServer(s, 100 * i + 2, GRPC_STATUS_OK, client_close);
+    Expect(100 * i + 2, true);
+    Expect(i, true);
+    Step();
+    EXPECT_EQ(server_status.status(), GRPC_STATUS_OK);
+    EXPECT_EQ(server_message.payload(), "bar");
+  }
+}
+
+}  // namespace
+}  // namespace grpc_core
@@ -0,0 +1,115 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "absl/strings/str_format.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/status.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/end2end/end2end_tests.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Tests hedging:
+// - 2 attempts allowed, hedgingDelay of 1s
+// - first attempt does not receive a response
+// - second attempt is started after hedgingDelay and returns OK
+// - first attempt is cancelled when the call commits to the second one
+CORE_END2END_TEST(RetryTest, RetryHedging) {
+  InitServer(ChannelArgs());
+  InitClient(
+      ChannelArgs()
+          .Set(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, true)
+          .Set(
+              GRPC_ARG_SERVICE_CONFIG,
+              absl::StrFormat(
+                  "{\n"
+                  "  \"methodConfig\": [ {\n"
+                  "    \"name\": [\n"
+                  "      { \"service\": \"service\", \"method\": \"method\" }\n"
+                  "    ],\n"
+                  "    \"hedgingPolicy\": {\n"
+                  "      \"maxAttempts\": 2,\n"
+                  "      \"hedgingDelay\": \"%ds\",\n"
+                  "      \"nonFatalStatusCodes\": [ \"ABORTED\" ]\n"
+                  "    }\n"
+                  "  } ]\n"
+                  "}",
+                  1 * grpc_test_slowdown_factor())));
+  auto c =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(10)).Create();
+  IncomingMessage server_message;
+  IncomingMetadata server_initial_metadata;
+  IncomingStatusOnClient server_status;
+  c.NewBatch(1)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .RecvMessage(server_message)
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata)
+      .RecvStatusOnClient(server_status);
+  // Server gets a call but does not respond to it.
+  auto s0 = RequestCall(101);
+  Expect(101, true);
+  Step();
+  // Make sure the "grpc-previous-rpc-attempts" header was not sent in the
+  // initial attempt.
+  EXPECT_EQ(s0.GetInitialMetadata("grpc-previous-rpc-attempts"),
+            absl::nullopt);
+  IncomingCloseOnServer client_close0;
+  s0.NewBatch(102).RecvCloseOnServer(client_close0);
+  // Server gets a second call after the hedging delay, while the first one
+  // is still in flight.
+  auto s1 = RequestCall(201);
+  Expect(201, true);
+  Step();
+  // Make sure the "grpc-previous-rpc-attempts" header was sent in the
+  // hedged attempt.
+  EXPECT_EQ(s1.GetInitialMetadata("grpc-previous-rpc-attempts"), "1");
+  IncomingMessage client_message1;
+  s1.NewBatch(202).RecvMessage(client_message1);
+  // Server sends OK status on the second call.
+  IncomingCloseOnServer client_close1;
+  s1.NewBatch(203)
+      .SendInitialMetadata({})
+      .SendMessage("bar")
+      .SendStatusFromServer(GRPC_STATUS_OK, "xyz", {})
+      .RecvCloseOnServer(client_close1);
+  // The first call is cancelled once the client commits to the second one.
+  Expect(102, true);
+  Expect(202, true);
+  Expect(203, true);
+  Expect(1, true);
+  Step();
+  EXPECT_EQ(server_status.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_status.message(), "xyz");
+  EXPECT_EQ(server_message.payload(), "bar");
+  EXPECT_EQ(client_message1.payload(), "foo");
+  EXPECT_EQ(s1.method(), "/service/method");
+  EXPECT_TRUE(client_close0.was_cancelled());
+  EXPECT_FALSE(client_close1.was_cancelled());
+}
+
+}  // namespace
+}  // namespace grpc_core
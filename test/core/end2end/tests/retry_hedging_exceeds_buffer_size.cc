@@ -0,0 +1,114 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <string>
+
+#include "absl/strings/str_format.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/status.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/end2end/end2end_tests.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Tests that exceeding the retry buffer size commits a hedged call.
+// - 3 attempts allowed, hedgingDelay of 2s
+// - buffer size set to 100 KiB (larger than initial metadata)
+// - first and second attempts are started with only initial metadata
+// - client then sends a 100 KiB message, which commits the call to the
+//   first attempt and cancels the second one
+// - first attempt receives the message and returns OK
+CORE_END2END_TEST(RetryTest, RetryHedgingExceedsBufferSize) {
+  InitServer(ChannelArgs());
+  InitClient(
+      ChannelArgs()
+          .Set(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, true)
+          .Set(
+              GRPC_ARG_SERVICE_CONFIG,
+              absl::StrFormat(
+                  "{\n"
+                  "  \"methodConfig\": [ {\n"
+                  "    \"name\": [\n"
+                  "      { \"service\": \"service\", \"method\": \"method\" }\n"
+                  "    ],\n"
+                  "    \"hedgingPolicy\": {\n"
+                  "      \"maxAttempts\": 3,\n"
+                  "      \"hedgingDelay\": \"%ds\",\n"
+                  "      \"nonFatalStatusCodes\": [ \"ABORTED\" ]\n"
+                  "    }\n"
+                  "  } ]\n"
+                  "}",
+                  2 * grpc_test_slowdown_factor()))
+          .Set(GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE, 102400));
+  auto c =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  c.NewBatch(1).SendInitialMetadata({});
+  Expect(1, true);
+  Step();
+  auto s0 = RequestCall(101);
+  Expect(101, true);
+  Step();
+  auto s1 = RequestCall(201);
+  Expect(201, true);
+  Step();
+  EXPECT_EQ(s1.GetInitialMetadata("grpc-previous-rpc-attempts"), "1");
+  IncomingCloseOnServer client_close1;
+  s1.NewBatch(202).RecvCloseOnServer(client_close1);
+  IncomingMetadata server_initial_metadata;
+  IncomingMessage server_message;
+  IncomingStatusOnClient server_status;
+  c.NewBatch(2)
+      .SendMessage(std::string(102400, 'a'))
+      .RecvMessage(server_message)
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata)
+      .RecvStatusOnClient(server_status);
+  // Neither attempt has sent a message, so the call commits to the first.
+  Expect(202, true);
+  Step();
+  EXPECT_TRUE(client_close1.was_cancelled());
+  IncomingMessage client_message0;
+  s0.NewBatch(102).RecvMessage(client_message0);
+  Expect(102, true);
+  Step();
+  EXPECT_EQ(client_message0.payload(), std::string(102400, 'a'));
+  IncomingCloseOnServer client_close0;
+  s0.NewBatch(103)
+      .SendInitialMetadata({})
+      .SendMessage("bar")
+      .SendStatusFromServer(GRPC_STATUS_OK, "xyz", {})
+      .RecvCloseOnServer(client_close0);
+  Expect(103, true);
+  Expect(2, true);
+  Step();
+  EXPECT_EQ(server_status.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_status.message(), "xyz");
+  EXPECT_EQ(server_message.payload(), "bar");
+  EXPECT_EQ(s0.method(), "/service/method");
+  EXPECT_FALSE(client_close0.was_cancelled());
+}
+
+}  // namespace
+}  // namespace grpc_core
@@ -0,0 +1,172 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <string>
+
+#include "absl/strings/str_format.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/status.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/end2end/end2end_tests.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+std::string HedgingServiceConfig(int hedging_delay_seconds) {
+  return absl::StrFormat(
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"service\", \"method\": \"method\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"hedgingDelay\": \"%ds\",\n"
+      "      \"nonFatalStatusCodes\": [ \"ABORTED\" ]\n"
+      "    }\n"
+      "  } ]\n"
+      "}",
+      hedging_delay_seconds * grpc_test_slowdown_factor());
+}
+
+// Tests that server push-back delays the next hedged attempt.
+// - 3 attempts allowed, hedgingDelay much longer than the test timeout
+// - first attempt gets ABORTED with a 2s push-back
+// - second attempt is started after the push-back delay and returns OK
+CORE_END2END_TEST(RetryTest, RetryHedgingServerPushbackDelay) {
+  InitServer(ChannelArgs());
+  InitClient(ChannelArgs()
+                 .Set(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, true)
+                 .Set(GRPC_ARG_SERVICE_CONFIG, HedgingServiceConfig(60)));
+  auto c =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message;
+  IncomingMetadata server_initial_metadata;
+  IncomingStatusOnClient server_status;
+  c.NewBatch(1)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .RecvMessage(server_message)
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata)
+      .RecvStatusOnClient(server_status);
+  auto s0 = RequestCall(101);
+  Expect(101, true);
+  Step();
+  IncomingCloseOnServer client_close0;
+  s0.NewBatch(102)
+      .SendInitialMetadata({})
+      .SendStatusFromServer(GRPC_STATUS_ABORTED, "message1",
+                            {{"grpc-retry-pushback-ms", "2000"}})
+      .RecvCloseOnServer(client_close0);
+  Expect(102, true);
+  Step();
+  const auto before_hedge = Timestamp::Now();
+  auto s1 = RequestCall(201);
+  Expect(201, true);
+  Step();
+  const auto hedge_delay = Timestamp::Now() - before_hedge;
+  // Server push-back said 2 seconds.  To avoid flakiness, we allow some
+  // fudge factor here.
+  EXPECT_GE(hedge_delay, Duration::Milliseconds(1800));
+  EXPECT_EQ(s1.GetInitialMetadata("grpc-previous-rpc-attempts"), "1");
+  IncomingCloseOnServer client_close1;
+  s1.NewBatch(202)
+      .SendInitialMetadata({})
+      .SendStatusFromServer(GRPC_STATUS_OK, "message2", {})
+      .RecvCloseOnServer(client_close1);
+  Expect(202, true);
+  Expect(1, true);
+  Step();
+  EXPECT_EQ(server_status.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_status.message(), "message2");
+  EXPECT_EQ(s1.method(), "/service/method");
+  EXPECT_FALSE(client_close1.was_cancelled());
+}
+
+// Tests that negative server push-back stops hedging.
+// - 3 attempts allowed, hedgingDelay of 1s
+// - first attempt does not receive a response
+// - second attempt is started after hedgingDelay and gets ABORTED with
+//   negative push-back
+// - no third attempt is started, and the first attempt returns OK
+CORE_END2END_TEST(RetryTest, RetryHedgingServerPushbackStop) {
+  InitServer(ChannelArgs());
+  InitClient(ChannelArgs()
+                 .Set(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, true)
+                 .Set(GRPC_ARG_SERVICE_CONFIG, HedgingServiceConfig(1)));
+  auto c =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message;
+  IncomingMetadata server_initial_metadata;
+  IncomingStatusOnClient server_status;
+  c.NewBatch(1)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .RecvMessage(server_message)
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata)
+      .RecvStatusOnClient(server_status);
+  auto s0 = RequestCall(101);
+  Expect(101, true);
+  Step();
+  auto s1 = RequestCall(201);
+  Expect(201, true);
+  Step();
+  EXPECT_EQ(s1.GetInitialMetadata("grpc-previous-rpc-attempts"), "1");
+  IncomingCloseOnServer client_close1;
+  s1.NewBatch(202)
+      .SendInitialMetadata({})
+      .SendStatusFromServer(GRPC_STATUS_ABORTED, "message1",
+                            {{"grpc-retry-pushback-ms", "-1"}})
+      .RecvCloseOnServer(client_close1);
+  Expect(202, true);
+  Step();
+  // The hedging timer armed by the second attempt fires, but does not
+  // start a third one.
+  auto s2 = RequestCall(301);
+  Step(Duration::Seconds(3 * grpc_test_slowdown_factor()));
+  IncomingCloseOnServer client_close0;
+  s0.NewBatch(102)
+      .SendInitialMetadata({})
+      .SendMessage("bar")
+      .SendStatusFromServer(GRPC_STATUS_OK, "message0", {})
+      .RecvCloseOnServer(client_close0);
+  Expect(102, true);
+  Expect(1, true);
+  Step();
+  EXPECT_EQ(server_status.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_status.message(), "message0");
+  EXPECT_EQ(server_message.payload(), "bar");
+  EXPECT_EQ(s0.method(), "/service/method");
+  EXPECT_FALSE(client_close0.was_cancelled());
+  EXPECT_FALSE(client_close1.was_cancelled());
+  ShutdownServerAndNotify(1000);
+  Expect(1000, true);
+  Expect(301, false);
+  Step();
+}
+
+}  // namespace
+}  // namespace grpc_core
@@ -0,0 +1,135 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "absl/strings/str_format.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/status.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/end2end/end2end_tests.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Tests that we don't start hedged attempts when throttled.
+// - 3 attempts allowed, hedgingDelay of 1s
+// - first call gets ABORTED, which throttles hedging, so no other attempt
+//   is started for it
+// - second call does not start a hedged attempt after hedgingDelay and
+//   gets OK on its only attempt
+CORE_END2END_TEST(RetryTest, RetryHedgingThrottled) {
+  InitServer(ChannelArgs());
+  InitClient(
+      ChannelArgs()
+          .Set(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, true)
+          .Set(
+              GRPC_ARG_SERVICE_CONFIG,
+              absl::StrFormat(
+                  "{\n"
+                  "  \"methodConfig\": [ {\n"
+                  "    \"name\": [\n"
+                  "      { \"service\": \"service\", \"method\": \"method\" }\n"
+                  "    ],\n"
+                  "    \"hedgingPolicy\": {\n"
+                  "      \"maxAttempts\": 3,\n"
+                  "      \"hedgingDelay\": \"%ds\",\n"
+                  "      \"nonFatalStatusCodes\": [ \"ABORTED\" ]\n"
+                  "    }\n"
+                  "  } ],\n"
+                  // A single failure will cause us to be throttled.
+                  "  \"retryThrottling\": {\n"
+                  "    \"maxTokens\": 2,\n"
+                  "    \"tokenRatio\": 1.0\n"
+                  "  }\n"
+                  "}",
+                  1 * grpc_test_slowdown_factor())));
+  {
+    auto c = NewClientCall("/service/method")
+                 .Timeout(Duration::Seconds(30))
+                 .Create();
+    IncomingMessage server_message;
+    IncomingMetadata server_initial_metadata;
+    IncomingStatusOnClient server_status;
+    c.NewBatch(1)
+        .SendInitialMetadata({})
+        .SendMessage("foo")
+        .RecvMessage(server_message)
+        .SendCloseFromClient()
+        .RecvInitialMetadata(server_initial_metadata)
+        .RecvStatusOnClient(server_status);
+    auto s = RequestCall(101);
+    Expect(101, true);
+    Step();
+    IncomingCloseOnServer client_close;
+    s.NewBatch(102)
+        .SendInitialMetadata({})
+        .SendStatusFromServer(GRPC_STATUS_ABORTED, "message1", {})
+        .RecvCloseOnServer(client_close);
+    Expect(102, true);
+    Expect(1, true);
+    Step();
+    EXPECT_EQ(server_status.status(), GRPC_STATUS_ABORTED);
+    EXPECT_EQ(server_status.message(), "message1");
+    EXPECT_FALSE(client_close.was_cancelled());
+  }
+  auto c =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message;
+  IncomingMetadata server_initial_metadata;
+  IncomingStatusOnClient server_status;
+  c.NewBatch(2)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .RecvMessage(server_message)
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata)
+      .RecvStatusOnClient(server_status);
+  auto s0 = RequestCall(201);
+  Expect(201, true);
+  Step();
+  // The hedging timer fires while the first attempt is in flight, but the
+  // throttle keeps it from starting another attempt.
+  auto s1 = RequestCall(301);
+  Step(Duration::Seconds(3 * grpc_test_slowdown_factor()));
+  IncomingCloseOnServer client_close0;
+  s0.NewBatch(202)
+      .SendInitialMetadata({})
+      .SendMessage("bar")
+      .SendStatusFromServer(GRPC_STATUS_OK, "message2", {})
+      .RecvCloseOnServer(client_close0);
+  Expect(202, true);
+  Expect(2, true);
+  Step();
+  EXPECT_EQ(server_status.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_status.message(), "message2");
+  EXPECT_EQ(server_message.payload(), "bar");
+  EXPECT_EQ(s0.method(), "/service/method");
+  EXPECT_FALSE(client_close0.was_cancelled());
+  ShutdownServerAndNotify(1000);
+  Expect(1000, true);
+  Expect(301, false);
+  Step();
+}
+
+}  // namespace
+}  // namespace grpc_core
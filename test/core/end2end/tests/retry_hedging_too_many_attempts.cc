@@ -0,0 +1,110 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "absl/strings/str_format.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/status.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/end2end/end2end_tests.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Tests that we stop starting hedged attempts after maxAttempts.
+// - 2 attempts allowed, hedgingDelay of 1s
+// - first and second attempts are started, and no third one is started
+//   after a further hedgingDelay
+// - both attempts get ABORTED, so the call fails with the status of the
+//   last one
+CORE_END2END_TEST(RetryTest, RetryHedgingTooManyAttempts) {
+  InitServer(ChannelArgs());
+  InitClient(
+      ChannelArgs()
+          .Set(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, true)
+          .Set(
+              GRPC_ARG_SERVICE_CONFIG,
+              absl::StrFormat(
+                  "{\n"
+                  "  \"methodConfig\": [ {\n"
+                  "    \"name\": [\n"
+                  "      { \"service\": \"service\", \"method\": \"method\" }\n"
+                  "    ],\n"
+                  "    \"hedgingPolicy\": {\n"
+                  "      \"maxAttempts\": 2,\n"
+                  "      \"hedgingDelay\": \"%ds\",\n"
+                  "      \"nonFatalStatusCodes\": [ \"ABORTED\" ]\n"
+                  "    }\n"
+                  "  } ]\n"
+                  "}",
+                  1 * grpc_test_slowdown_factor())));
+  auto c =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message;
+  IncomingMetadata server_initial_metadata;
+  IncomingStatusOnClient server_status;
+  c.NewBatch(1)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .RecvMessage(server_message)
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata)
+      .RecvStatusOnClient(server_status);
+  auto s0 = RequestCall(101);
+  Expect(101, true);
+  Step();
+  auto s1 = RequestCall(201);
+  Expect(201, true);
+  Step();
+  EXPECT_EQ(s1.GetInitialMetadata("grpc-previous-rpc-attempts"), "1");
+  auto s2 = RequestCall(301);
+  Step(Duration::Seconds(3 * grpc_test_slowdown_factor()));
+  // A non-fatal status does not start a third attempt either.
+  IncomingCloseOnServer client_close0;
+  s0.NewBatch(102)
+      .SendInitialMetadata({})
+      .SendStatusFromServer(GRPC_STATUS_ABORTED, "message1", {})
+      .RecvCloseOnServer(client_close0);
+  Expect(102, true);
+  Step();
+  IncomingCloseOnServer client_close1;
+  s1.NewBatch(202)
+      .SendInitialMetadata({})
+      .SendStatusFromServer(GRPC_STATUS_ABORTED, "message2", {})
+      .RecvCloseOnServer(client_close1);
+  Expect(202, true);
+  Expect(1, true);
+  Step();
+  EXPECT_EQ(server_status.status(), GRPC_STATUS_ABORTED);
+  EXPECT_EQ(server_status.message(), "message2");
+  EXPECT_EQ(s1.method(), "/service/method");
+  EXPECT_FALSE(client_close0.was_cancelled());
+  EXPECT_FALSE(client_close1.was_cancelled());
+  ShutdownServerAndNotify(1000);
+  Expect(1000, true);
+  Expect(301, false);
+  Step();
+}
+
+}  // namespace
+}  // namespace grpc_core
@@ -0,0 +1,224 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <new>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/status.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_fwd.h"
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/status_helper.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/call_combiner.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/surface/channel_stack_type.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/transport.h"
+#include "test/core/end2end/end2end_tests.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// A filter that fails all batches of the first call it sees, except for
+// cancellations, so that the call fails with an error whose
+// StreamNetworkState is kNotSentOnWire.
+// All subsequent calls are allowed through without failures.
+class FailFirstCallFilter {
+ public:
+  static grpc_channel_filter kFilterVtable;
+
+ private:
+  class CallData {
+   public:
+    static grpc_error_handle Init(grpc_call_element* elem,
+                                  const grpc_call_element_args* args) {
+      new (elem->call_data) CallData(args);
+      return absl::OkStatus();
+    }
+
+    static void Destroy(grpc_call_element* elem,
+                        const grpc_call_final_info* /*final_info*/,
+                        grpc_closure* /*ignored*/) {
+      auto* calld = static_cast<CallData*>(elem->call_data);
+      calld->~CallData();
+    }
+
+    static void StartTransportStreamOpBatch(
+        grpc_call_element* elem, grpc_transport_stream_op_batch* batch) {
+      auto* chand = static_cast<FailFirstCallFilter*>(elem->channel_data);
+      auto* calld = static_cast<CallData*>(elem->call_data);
+      if (chand->num_calls_ < 1) calld->fail_ = true;
+      if (batch->send_initial_metadata) ++chand->num_calls_;
+      if (calld->fail_) {
+        if (batch->recv_trailing_metadata) {
+          batch->payload->recv_trailing_metadata.recv_trailing_metadata->Set(
+              GrpcStreamNetworkState(), GrpcStreamNetworkState::kNotSentOnWire);
+        }
+        if (!batch->cancel_stream) {
+          grpc_transport_stream_op_batch_finish_with_failure(
+              batch,
+              grpc_error_set_int(
+                  GRPC_ERROR_CREATE("FailFirstCallFilter failing batch"),
+                  StatusIntProperty::kRpcStatus, GRPC_STATUS_UNAVAILABLE),
+              calld->call_combiner_);
+          return;
+        }
+      }
+      grpc_call_next_op(elem, batch);
+    }
+
+   private:
+    explicit CallData(const grpc_call_element_args* args)
+        : call_combiner_(args->call_combiner) {}
+
+    CallCombiner* call_combiner_;
+    bool fail_ = false;
+  };
+
+  static grpc_error_handle Init(grpc_channel_element* elem,
+                                grpc_channel_element_args* /*args*/) {
+    new (elem->channel_data) FailFirstCallFilter();
+    return absl::OkStatus();
+  }
+
+  static void Destroy(grpc_channel_element* elem) {
+    auto* chand = static_cast<FailFirstCallFilter*>(elem->channel_data);
+    chand->~FailFirstCallFilter();
+  }
+
+  size_t num_calls_ = 0;
+};
+
+grpc_channel_filter FailFirstCallFilter::kFilterVtable = {
+    CallData::StartTransportStreamOpBatch,
+    nullptr,
+    grpc_channel_next_op,
+    sizeof(CallData),
+    CallData::Init,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    CallData::Destroy,
+    sizeof(FailFirstCallFilter),
+    Init,
+    grpc_channel_stack_no_post_init,
+    Destroy,
+    grpc_channel_next_get_info,
+    "FailFirstCallFilter",
+};
+
+// Tests transparent retry of a hedged attempt.
+// - 2 attempts allowed, hedgingDelay of 1s
+// - first attempt is not sent on the wire and is transparently retried
+// - the transparent retry does not count as an attempt, so a hedged
+//   attempt is still started after hedgingDelay
+// - hedged attempt returns OK, and the transparent retry is cancelled
+CORE_END2END_TEST(RetryTest, RetryHedgingTransparent) {
+  CoreConfiguration::RegisterBuilder([](CoreConfiguration::Builder* builder) {
+    builder->channel_init()->RegisterStage(
+        GRPC_CLIENT_SUBCHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY + 1,
+        [](ChannelStackBuilder* builder) {
+          // Skip on proxy (which explicitly disables retries).
+          if (!builder->channel_args()
+                   .GetBool(GRPC_ARG_ENABLE_RETRIES)
+                   .value_or(true)) {
+            return true;
+          }
+          // Install filter.
+          builder->PrependFilter(&FailFirstCallFilter::kFilterVtable);
+          return true;
+        });
+  });
+  InitServer(ChannelArgs());
+  InitClient(
+      ChannelArgs()
+          .Set(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, true)
+          .Set(
+              GRPC_ARG_SERVICE_CONFIG,
+              absl::StrFormat(
+                  "{\n"
+                  "  \"methodConfig\": [ {\n"
+                  "    \"name\": [\n"
+                  "      { \"service\": \"service\", \"method\": \"method\" }\n"
+                  "    ],\n"
+                  "    \"hedgingPolicy\": {\n"
+                  "      \"maxAttempts\": 2,\n"
+                  "      \"hedgingDelay\": \"%ds\",\n"
+                  "      \"nonFatalStatusCodes\": [ \"ABORTED\" ]\n"
+                  "    }\n"
+                  "  } ]\n"
+                  "}",
+                  1 * grpc_test_slowdown_factor())));
+  auto c =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(30)).Create();
+  IncomingMessage server_message;
+  IncomingMetadata server_initial_metadata;
+  IncomingStatusOnClient server_status;
+  c.NewBatch(1)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .RecvMessage(server_message)
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata)
+      .RecvStatusOnClient(server_status);
+  // The server only sees the transparent retry of the first attempt.
+  auto s0 = RequestCall(101);
+  Expect(101, true);
+  Step();
+  IncomingCloseOnServer client_close0;
+  s0.NewBatch(102).RecvCloseOnServer(client_close0);
+  // Had the transparent retry counted against maxAttempts, there would be
+  // no hedged attempt.
+  auto s1 = RequestCall(201);
+  Expect(201, true);
+  Step();
+  EXPECT_EQ(s1.GetInitialMetadata("grpc-previous-rpc-attempts"), "1");
+  IncomingMessage client_message1;
+  s1.NewBatch(202).RecvMessage(client_message1);
+  IncomingCloseOnServer client_close1;
+  s1.NewBatch(203)
+      .SendInitialMetadata({})
+      .SendMessage("bar")
+      .SendStatusFromServer(GRPC_STATUS_OK, "xyz", {})
+      .RecvCloseOnServer(client_close1);
+  Expect(102, true);
+  Expect(202, true);
+  Expect(203, true);
+  Expect(1, true);
+  Step();
+  EXPECT_EQ(server_status.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_status.message(), "xyz");
+  EXPECT_EQ(server_message.payload(), "bar");
+  EXPECT_EQ(client_message1.payload(), "foo");
+  EXPECT_EQ(s1.method(), "/service/method");
+  EXPECT_TRUE(client_close0.was_cancelled());
+  EXPECT_FALSE(client_close1.was_cancelled());
+}
+
+}  // namespace
+}  // namespace grpc_core
@@ -26,6 +26,9 @@
 
 #include <grpc/grpc.h>
 
+#include "src/core/lib/debug/histogram_view.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/event_engine/thread_pool/original_thread_pool.h"
 #include "src/core/lib/event_engine/thread_pool/work_stealing_thread_pool.h"
 #include "src/core/lib/gprpp/notification.h"
@@ -197,6 +200,24 @@ TYPED_TEST(ThreadPoolTest, CanStartLotsOfClosures) {
   ASSERT_EQ(runcount.load(), pow(2, branch_factor + 1) - 1);
 }
 
+TYPED_TEST(ThreadPoolTest, RecordsSchedulingStats) {
+  using Histogram = grpc_core::GlobalStats::Histogram;
+  auto before = grpc_core::global_stats().Collect();
+  TypeParam p(8);
+  constexpr int kClosures = 100;
+  std::atomic<int> runcount{0};
+  for (int i = 0; i < kClosures; i++) {
+    p.Run([&runcount] { runcount.fetch_add(1); });
+  }
+  p.Quiesce();
+  ASSERT_EQ(runcount.load(), kClosures);
+  auto diff = grpc_core::global_stats().Collect()->Diff(*before);
+  EXPECT_GE(diff->histogram(Histogram::kThreadPoolQueueDelayUs).Count(),
+            kClosures);
+  EXPECT_GE(diff->histogram(Histogram::kThreadPoolRunTimeUs).Count(),
+            kClosures);
+}
+
 class WorkStealingThreadPoolTest : public ::testing::Test {};
 
 // TODO(hork): This is currently a pathological case for the original thread
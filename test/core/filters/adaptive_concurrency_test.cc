@@ -0,0 +1,249 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "gtest/gtest.h"
+
+#include <grpc/status.h>
+
+#include "src/core/ext/filters/adaptive_concurrency/concurrency_limiter.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/promise/activity.h"
+#include "src/core/lib/promise/poll.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using Permit = ConcurrencyLimiter::Permit;
+
+// Counts the wakeups of the calls that it stands in for.
+class TestActivity : public Activity, public Wakeable {
+ public:
+  TestActivity() : scoped_activity_(this) {}
+
+  int wakeups() const { return wakeups_; }
+
+  void ForceImmediateRepoll(WakeupMask) override { ++wakeups_; }
+  void Orphan() override {}
+  Waker MakeOwningWaker() override { return Waker(this, 0); }
+  Waker MakeNonOwningWaker() override { return Waker(this, 0); }
+  void Wakeup(WakeupMask) override { ++wakeups_; }
+  void WakeupAsync(WakeupMask) override { ++wakeups_; }
+  void Drop(WakeupMask) override {}
+  std::string DebugTag() const override { return "TestActivity"; }
+  std::string ActivityDebugTag(WakeupMask) const override {
+    return DebugTag();
+  }
+
+ private:
+  ScopedActivity scoped_activity_;
+  int wakeups_ = 0;
+};
+
+class ConcurrencyLimiterTest : public ::testing::Test {
+ protected:
+  static RefCountedPtr<ConcurrencyLimiter> MakeLimiter(
+      uint32_t initial_limit, size_t max_queue_size) {
+    ConcurrencyLimiter::Options options;
+    options.initial_limit = initial_limit;
+    options.max_queue_size = max_queue_size;
+    options.sample_window = Duration::Seconds(1);
+    options.min_window_samples = 1;
+    return MakeRefCounted<ConcurrencyLimiter>(options);
+  }
+
+  // Acquires a permit that is expected to be granted immediately.
+  static Permit AcquireNow(ConcurrencyLimiter* limiter) {
+    auto promise = limiter->Acquire(Timestamp::InfFuture());
+    auto result = promise();
+    auto* permit = result.value_if_ready();
+    EXPECT_NE(permit, nullptr);
+    EXPECT_TRUE(permit->ok()) << permit->status();
+    return std::move(**permit);
+  }
+
+  // Runs one sample window in which the limit is fully used and every call
+  // takes rtt_seconds.
+  void RunWindow(ConcurrencyLimiter* limiter, double rtt_seconds) {
+    std::vector<Permit> permits;
+    while (limiter->in_flight() < limiter->limit()) {
+      permits.push_back(AcquireNow(limiter));
+    }
+    // The last call to finish ends the window.
+    for (size_t i = 0; i + 1 < permits.size(); ++i) {
+      permits[i].TestOnlyRelease(GRPC_STATUS_OK, rtt_seconds);
+    }
+    time_cache_.TestOnlySetNow(Timestamp::Now() + Duration::Seconds(1));
+    permits.back().TestOnlyRelease(GRPC_STATUS_OK, rtt_seconds);
+  }
+
+  ExecCtx exec_ctx_;
+  ScopedTimeCache time_cache_;
+};
+
+TEST_F(ConcurrencyLimiterTest, AdmitsUpToLimit) {
+  auto limiter = MakeLimiter(2, 0);
+  Permit permit1 = AcquireNow(limiter.get());
+  Permit permit2 = AcquireNow(limiter.get());
+  EXPECT_EQ(limiter->in_flight(), 2);
+  auto promise = limiter->Acquire(Timestamp::InfFuture());
+  auto result = promise();
+  ASSERT_TRUE(result.ready());
+  EXPECT_EQ(result.value().status().code(),
+            absl::StatusCode::kResourceExhausted);
+  permit1.Release(GRPC_STATUS_OK);
+  EXPECT_EQ(limiter->in_flight(), 1);
+}
+
+TEST_F(ConcurrencyLimiterTest, DroppedPermitFreesSlot) {
+  auto limiter = MakeLimiter(1, 0);
+  { Permit permit = AcquireNow(limiter.get()); }
+  EXPECT_EQ(limiter->in_flight(), 0);
+  Permit permit = AcquireNow(limiter.get());
+  EXPECT_EQ(limiter->in_flight(), 1);
+}
+
+TEST_F(ConcurrencyLimiterTest, QueuedCallsAreAdmittedEarliestDeadlineFirst) {
+  auto limiter = MakeLimiter(1, 10);
+  Permit permit = AcquireNow(limiter.get());
+  const Timestamp now = Timestamp::Now();
+  TestActivity late_activity;
+  auto late = limiter->Acquire(now + Duration::Seconds(10));
+  EXPECT_TRUE(late().pending());
+  TestActivity early_activity;
+  auto early = limiter->Acquire(now + Duration::Seconds(5));
+  EXPECT_TRUE(early().pending());
+  EXPECT_EQ(limiter->queue_size(), 2);
+  permit.Release(GRPC_STATUS_OK);
+  EXPECT_EQ(early_activity.wakeups(), 1);
+  EXPECT_EQ(late_activity.wakeups(), 0);
+  auto result = early();
+  ASSERT_TRUE(result.ready());
+  ASSERT_TRUE(result.value().ok());
+  EXPECT_TRUE(late().pending());
+  EXPECT_EQ(limiter->queue_size(), 1);
+  EXPECT_EQ(limiter->in_flight(), 1);
+}
+
+TEST_F(ConcurrencyLimiterTest, FullQueueShedsLatestDeadline) {
+  auto limiter = MakeLimiter(1, 1);
+  Permit permit = AcquireNow(limiter.get());
+  const Timestamp now = Timestamp::Now();
+  TestActivity late_activity;
+  auto late = limiter->Acquire(now + Duration::Seconds(10));
+  EXPECT_TRUE(late().pending());
+  // An earlier deadline takes the place of the queued call.
+  TestActivity early_activity;
+  auto early = limiter->Acquire(now + Duration::Seconds(5));
+  EXPECT_TRUE(early().pending());
+  EXPECT_EQ(late_activity.wakeups(), 1);
+  auto result = late();
+  ASSERT_TRUE(result.ready());
+  EXPECT_EQ(result.value().status().code(),
+            absl::StatusCode::kResourceExhausted);
+  // A later deadline is shed immediately.
+  auto later = limiter->Acquire(now + Duration::Seconds(20));
+  result = later();
+  ASSERT_TRUE(result.ready());
+  EXPECT_EQ(result.value().status().code(),
+            absl::StatusCode::kResourceExhausted);
+  EXPECT_EQ(limiter->queue_size(), 1);
+}
+
+TEST_F(ConcurrencyLimiterTest, CancelledCallLeavesQueue) {
+  auto limiter = MakeLimiter(1, 10);
+  Permit permit = AcquireNow(limiter.get());
+  {
+    TestActivity activity;
+    auto promise = limiter->Acquire(Timestamp::InfFuture());
+    EXPECT_TRUE(promise().pending());
+    EXPECT_EQ(limiter->queue_size(), 1);
+  }
+  EXPECT_EQ(limiter->queue_size(), 0);
+  permit.Release(GRPC_STATUS_OK);
+  EXPECT_EQ(limiter->in_flight(), 0);
+}
+
+TEST_F(ConcurrencyLimiterTest, AdmittedButCancelledCallFreesSlot) {
+  auto limiter = MakeLimiter(1, 10);
+  Permit permit = AcquireNow(limiter.get());
+  {
+    TestActivity activity;
+    auto promise = limiter->Acquire(Timestamp::InfFuture());
+    EXPECT_TRUE(promise().pending());
+    permit.Release(GRPC_STATUS_OK);
+    EXPECT_EQ(activity.wakeups(), 1);
+    EXPECT_EQ(limiter->in_flight(), 1);
+  }
+  EXPECT_EQ(limiter->in_flight(), 0);
+}
+
+TEST_F(ConcurrencyLimiterTest, ExpiredQueuedCallIsShed) {
+  auto limiter = MakeLimiter(1, 10);
+  Permit permit = AcquireNow(limiter.get());
+  TestActivity activity;
+  auto promise = limiter->Acquire(Timestamp::Now() + Duration::Seconds(1));
+  EXPECT_TRUE(promise().pending());
+  time_cache_.TestOnlySetNow(Timestamp::Now() + Duration::Seconds(2));
+  permit.Release(GRPC_STATUS_OK);
+  EXPECT_EQ(activity.wakeups(), 1);
+  auto result = promise();
+  ASSERT_TRUE(result.ready());
+  EXPECT_EQ(result.value().status().code(),
+            absl::StatusCode::kResourceExhausted);
+  EXPECT_EQ(limiter->in_flight(), 0);
+}
+
+TEST_F(ConcurrencyLimiterTest, LimitGrowsWhileLatencyIsFlat) {
+  auto limiter = MakeLimiter(10, 0);
+  for (int i = 0; i < 10; ++i) RunWindow(limiter.get(), 0.01);
+  EXPECT_GT(limiter->limit(), 10);
+}
+
+TEST_F(ConcurrencyLimiterTest, LimitShrinksAsLatencyGrows) {
+  auto limiter = MakeLimiter(10, 0);
+  RunWindow(limiter.get(), 0.01);
+  const uint32_t limit = limiter->limit();
+  for (int i = 0; i < 3; ++i) RunWindow(limiter.get(), 0.1);
+  EXPECT_LT(limiter->limit(), limit);
+}
+
+TEST_F(ConcurrencyLimiterTest, LimitShrinksOnDrops) {
+  auto limiter = MakeLimiter(10, 0);
+  std::vector<Permit> permits;
+  for (int i = 0; i < 10; ++i) permits.push_back(AcquireNow(limiter.get()));
+  time_cache_.TestOnlySetNow(Timestamp::Now() + Duration::Seconds(1));
+  permits[0].TestOnlyRelease(GRPC_STATUS_RESOURCE_EXHAUSTED, 0.01);
+  EXPECT_EQ(limiter->limit(), 9);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
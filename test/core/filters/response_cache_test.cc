@@ -0,0 +1,233 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/response_cache/response_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+class TestWaiter : public ResponseCache::Waiter {
+ public:
+  void OnFillDone(
+      std::shared_ptr<const ResponseCache::Response> response) override {
+    done_ = true;
+    response_ = std::move(response);
+  }
+
+  bool done() const { return done_; }
+  const std::shared_ptr<const ResponseCache::Response>& response() const {
+    return response_;
+  }
+
+ private:
+  bool done_ = false;
+  std::shared_ptr<const ResponseCache::Response> response_;
+};
+
+class ResponseCacheTest : public ::testing::Test {
+ protected:
+  RefCountedPtr<ResponseCache> MakeCache(size_t size_limit) {
+    return MakeRefCounted<ResponseCache>(
+        size_limit,
+        ResourceQuota::Default()->memory_quota()->CreateMemoryOwner("test"));
+  }
+
+  static ResponseCache::Key MakeKey(std::string request) {
+    return ResponseCache::Key{"/package.Service/Get", std::move(request)};
+  }
+
+  static std::shared_ptr<const ResponseCache::Response> MakeResponse(
+      absl::string_view message) {
+    auto response = std::make_shared<ResponseCache::Response>();
+    response->initial_metadata = {{"content-type", "application/grpc"}};
+    response->message = Slice::FromCopiedString(message);
+    response->trailing_metadata = {{"grpc-status", "0"}};
+    return response;
+  }
+
+  // Fills the cache with response for key.
+  static void Fill(ResponseCache* cache, const ResponseCache::Key& key,
+                   std::shared_ptr<const ResponseCache::Response> response,
+                   Duration ttl = Duration::Seconds(10)) {
+    TestWaiter waiter;
+    std::shared_ptr<const ResponseCache::Response> cached;
+    ASSERT_EQ(cache->Lookup(key, &waiter, &cached),
+              ResponseCache::LookupResult::kFill);
+    cache->FinishFill(key, ttl, std::move(response));
+  }
+
+  ScopedTimeCache time_cache_;
+};
+
+TEST_F(ResponseCacheTest, MissThenHit) {
+  auto cache = MakeCache(1 << 20);
+  auto key = MakeKey("request");
+  auto response = MakeResponse("response");
+  Fill(cache.get(), key, response);
+  EXPECT_GT(cache->size(), 0);
+  TestWaiter waiter;
+  std::shared_ptr<const ResponseCache::Response> cached;
+  EXPECT_EQ(cache->Lookup(key, &waiter, &cached),
+            ResponseCache::LookupResult::kHit);
+  EXPECT_EQ(cached, response);
+  EXPECT_FALSE(waiter.done());
+}
+
+TEST_F(ResponseCacheTest, KeyIncludesMethodAndRequest) {
+  auto cache = MakeCache(1 << 20);
+  Fill(cache.get(), MakeKey("request"), MakeResponse("response"));
+  TestWaiter waiter;
+  std::shared_ptr<const ResponseCache::Response> cached;
+  EXPECT_EQ(cache->Lookup(MakeKey("other request"), &waiter, &cached),
+            ResponseCache::LookupResult::kFill);
+  EXPECT_EQ(cache->Lookup(ResponseCache::Key{"/package.Service/List",
+                                             "request"},
+                          &waiter, &cached),
+            ResponseCache::LookupResult::kFill);
+  EXPECT_EQ(cached, nullptr);
+}
+
+TEST_F(ResponseCacheTest, EntriesExpire) {
+  auto cache = MakeCache(1 << 20);
+  auto key = MakeKey("request");
+  const Timestamp start = Timestamp::Now();
+  Fill(cache.get(), key, MakeResponse("response"), Duration::Seconds(5));
+  TestWaiter waiter;
+  std::shared_ptr<const ResponseCache::Response> cached;
+  time_cache_.TestOnlySetNow(start + Duration::Seconds(4));
+  EXPECT_EQ(cache->Lookup(key, &waiter, &cached),
+            ResponseCache::LookupResult::kHit);
+  time_cache_.TestOnlySetNow(start + Duration::Seconds(5));
+  EXPECT_EQ(cache->Lookup(key, &waiter, &cached),
+            ResponseCache::LookupResult::kFill);
+  EXPECT_EQ(cache->size(), 0);
+}
+
+TEST_F(ResponseCacheTest, WaitersGetResponse) {
+  auto cache = MakeCache(1 << 20);
+  auto key = MakeKey("request");
+  TestWaiter waiter1;
+  TestWaiter waiter2;
+  std::shared_ptr<const ResponseCache::Response> cached;
+  EXPECT_EQ(cache->Lookup(key, &waiter1, &cached),
+            ResponseCache::LookupResult::kFill);
+  EXPECT_EQ(cache->Lookup(key, &waiter2, &cached),
+            ResponseCache::LookupResult::kWait);
+  EXPECT_FALSE(waiter1.done());
+  EXPECT_FALSE(waiter2.done());
+  auto response = MakeResponse("response");
+  cache->FinishFill(key, Duration::Seconds(10), response);
+  EXPECT_FALSE(waiter1.done());
+  ASSERT_TRUE(waiter2.done());
+  EXPECT_EQ(waiter2.response(), response);
+}
+
+TEST_F(ResponseCacheTest, FailedFillIsNotCached) {
+  auto cache = MakeCache(1 << 20);
+  auto key = MakeKey("request");
+  TestWaiter waiter1;
+  TestWaiter waiter2;
+  std::shared_ptr<const ResponseCache::Response> cached;
+  EXPECT_EQ(cache->Lookup(key, &waiter1, &cached),
+            ResponseCache::LookupResult::kFill);
+  EXPECT_EQ(cache->Lookup(key, &waiter2, &cached),
+            ResponseCache::LookupResult::kWait);
+  cache->FinishFill(key, Duration::Seconds(10), nullptr);
+  ASSERT_TRUE(waiter2.done());
+  EXPECT_EQ(waiter2.response(), nullptr);
+  EXPECT_EQ(cache->Lookup(key, &waiter1, &cached),
+            ResponseCache::LookupResult::kFill);
+}
+
+TEST_F(ResponseCacheTest, CancelWait) {
+  auto cache = MakeCache(1 << 20);
+  auto key = MakeKey("request");
+  TestWaiter waiter1;
+  TestWaiter waiter2;
+  std::shared_ptr<const ResponseCache::Response> cached;
+  EXPECT_EQ(cache->Lookup(key, &waiter1, &cached),
+            ResponseCache::LookupResult::kFill);
+  EXPECT_EQ(cache->Lookup(key, &waiter2, &cached),
+            ResponseCache::LookupResult::kWait);
+  EXPECT_TRUE(cache->CancelWait(key, &waiter2));
+  EXPECT_FALSE(cache->CancelWait(key, &waiter2));
+  cache->FinishFill(key, Duration::Seconds(10), MakeResponse("response"));
+  EXPECT_FALSE(waiter2.done());
+  EXPECT_FALSE(cache->CancelWait(key, &waiter2));
+}
+
+TEST_F(ResponseCacheTest, EvictsLeastRecentlyUsed) {
+  auto cache = MakeCache(1 << 20);
+  Fill(cache.get(), MakeKey("a"), MakeResponse("response"));
+  const size_t entry_size = cache->size();
+  cache = MakeCache(entry_size * 2);
+  Fill(cache.get(), MakeKey("a"), MakeResponse("response"));
+  Fill(cache.get(), MakeKey("b"), MakeResponse("response"));
+  EXPECT_EQ(cache->size(), entry_size * 2);
+  // Use "a", so that "b" is evicted when "c" is added.
+  TestWaiter waiter;
+  std::shared_ptr<const ResponseCache::Response> cached;
+  EXPECT_EQ(cache->Lookup(MakeKey("a"), &waiter, &cached),
+            ResponseCache::LookupResult::kHit);
+  Fill(cache.get(), MakeKey("c"), MakeResponse("response"));
+  EXPECT_EQ(cache->size(), entry_size * 2);
+  EXPECT_EQ(cache->Lookup(MakeKey("a"), &waiter, &cached),
+            ResponseCache::LookupResult::kHit);
+  EXPECT_EQ(cache->Lookup(MakeKey("c"), &waiter, &cached),
+            ResponseCache::LookupResult::kHit);
+  EXPECT_EQ(cache->Lookup(MakeKey("b"), &waiter, &cached),
+            ResponseCache::LookupResult::kFill);
+}
+
+TEST_F(ResponseCacheTest, OversizedResponseIsNotCachedButReachesWaiters) {
+  auto cache = MakeCache(64);
+  auto key = MakeKey("request");
+  TestWaiter waiter1;
+  TestWaiter waiter2;
+  std::shared_ptr<const ResponseCache::Response> cached;
+  EXPECT_EQ(cache->Lookup(key, &waiter1, &cached),
+            ResponseCache::LookupResult::kFill);
+  EXPECT_EQ(cache->Lookup(key, &waiter2, &cached),
+            ResponseCache::LookupResult::kWait);
+  auto response = MakeResponse(std::string(1024, 'x'));
+  cache->FinishFill(key, Duration::Seconds(10), response);
+  ASSERT_TRUE(waiter2.done());
+  EXPECT_EQ(waiter2.response(), response);
+  EXPECT_EQ(cache->size(), 0);
+  EXPECT_EQ(cache->Lookup(key, &waiter1, &cached),
+            ResponseCache::LookupResult::kFill);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,113 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/gprpp/intern_cache.h"
+
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "gtest/gtest.h"
+
+#include "src/core/lib/gprpp/ref_counted.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+class Value : public RefCounted<Value> {
+ public:
+  explicit Value(std::string name) : name_(std::move(name)) {}
+
+  const std::string& name() const { return name_; }
+
+ private:
+  std::string name_;
+};
+
+class InternCacheTest : public ::testing::Test {
+ protected:
+  RefCountedPtr<Value> Get(InternCache<Value>* cache, const std::string& key) {
+    auto value = cache->GetOrCreate(key, [&]() {
+      ++num_created_;
+      return absl::StatusOr<RefCountedPtr<Value>>(MakeRefCounted<Value>(key));
+    });
+    EXPECT_TRUE(value.ok()) << value.status();
+    return value.ok() ? std::move(*value) : nullptr;
+  }
+
+  int num_created_ = 0;
+};
+
+TEST_F(InternCacheTest, SameKeyReturnsSameObject) {
+  InternCache<Value> cache(10);
+  auto a1 = Get(&cache, "a");
+  auto b = Get(&cache, "b");
+  auto a2 = Get(&cache, "a");
+  EXPECT_EQ(a1, a2);
+  EXPECT_NE(a1, b);
+  EXPECT_EQ(a1->name(), "a");
+  EXPECT_EQ(b->name(), "b");
+  EXPECT_EQ(num_created_, 2);
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(InternCacheTest, ErrorsAreNotCached) {
+  InternCache<Value> cache(10);
+  auto value = cache.GetOrCreate("a", []() {
+    return absl::StatusOr<RefCountedPtr<Value>>(
+        absl::InvalidArgumentError("bad"));
+  });
+  EXPECT_EQ(value.status(), absl::InvalidArgumentError("bad"));
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_NE(Get(&cache, "a"), nullptr);
+  EXPECT_EQ(num_created_, 1);
+}
+
+TEST_F(InternCacheTest, EvictsLeastRecentlyUsed) {
+  InternCache<Value> cache(2);
+  auto a = Get(&cache, "a");
+  Get(&cache, "b");
+  // Use "a" again, so that "b" is the one evicted when "c" is added.
+  EXPECT_EQ(Get(&cache, "a"), a);
+  Get(&cache, "c");
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(num_created_, 3);
+  EXPECT_EQ(Get(&cache, "a"), a);
+  EXPECT_EQ(num_created_, 3);
+  Get(&cache, "b");
+  EXPECT_EQ(num_created_, 4);
+}
+
+TEST_F(InternCacheTest, NestedCreate) {
+  InternCache<Value> cache(10);
+  RefCountedPtr<Value> inner;
+  auto outer = cache.GetOrCreate("outer", [&]() {
+    inner = Get(&cache, "inner");
+    return absl::StatusOr<RefCountedPtr<Value>>(
+        MakeRefCounted<Value>("outer"));
+  });
+  ASSERT_TRUE(outer.ok());
+  EXPECT_EQ(Get(&cache, "inner"), inner);
+  EXPECT_EQ(Get(&cache, "outer"), *outer);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
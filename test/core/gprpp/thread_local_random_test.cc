@@ -0,0 +1,79 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/gprpp/thread_local_random.h"
+
+#include <stdint.h>
+
+#include <array>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace grpc_core {
+namespace {
+
+TEST(ThreadLocalRandomTest, DoesNotRepeat) {
+  std::set<uint64_t> seen;
+  for (int i = 0; i < 10000; ++i) {
+    EXPECT_TRUE(seen.insert(ThreadLocalRandom()).second);
+  }
+}
+
+TEST(ThreadLocalRandomTest, EachBitIsSetAboutHalfTheTime) {
+  constexpr int kIterations = 100000;
+  std::array<int, 64> set_count{};
+  for (int i = 0; i < kIterations; ++i) {
+    const uint64_t r = ThreadLocalRandom();
+    for (int bit = 0; bit < 64; ++bit) {
+      if ((r >> bit) & 1) ++set_count[bit];
+    }
+  }
+  // The standard deviation is about 158, so this is a very loose bound.
+  for (int bit = 0; bit < 64; ++bit) {
+    EXPECT_NEAR(set_count[bit], kIterations / 2, 2000) << "bit " << bit;
+  }
+}
+
+TEST(ThreadLocalRandomTest, ThreadsHaveIndependentSequences) {
+  constexpr int kThreads = 8;
+  constexpr int kValuesPerThread = 1000;
+  std::vector<std::vector<uint64_t>> values(kThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&values, i]() {
+      for (int j = 0; j < kValuesPerThread; ++j) {
+        values[i].push_back(ThreadLocalRandom());
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  // Were the threads sharing state or seeds, values would repeat.
+  std::set<uint64_t> seen;
+  for (const auto& thread_values : values) {
+    for (uint64_t value : thread_values) {
+      EXPECT_TRUE(seen.insert(value).second);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -101,6 +101,27 @@ TEST(ValidationErrors, ErrorsForMultipleFields) {
       << status;
 }
 
+TEST(ValidationErrors, AddErrors) {
+  ValidationErrors errors;
+  {
+    ValidationErrors::ScopedField field(&errors, "foo");
+    errors.AddError("too hot");
+  }
+  ValidationErrors other;
+  {
+    ValidationErrors::ScopedField field(&other, "foo");
+    other.AddError("too cold");
+    ValidationErrors::ScopedField field2(&other, ".bar");
+    other.AddError("value smells funny");
+  }
+  errors.AddErrors(other);
+  EXPECT_EQ(errors.size(), 2);
+  EXPECT_EQ(errors.message("errors validating config"),
+            "errors validating config: ["
+            "field:foo errors:[too hot; too cold]; "
+            "field:foo.bar error:value smells funny]");
+}
+
 TEST(ValidationErrors, MessageMatchesStatusMessage) {
   ValidationErrors errors;
   {
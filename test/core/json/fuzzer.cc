@@ -26,6 +26,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_document.h"
 #include "src/core/lib/json/json_reader.h"
 #include "src/core/lib/json/json_writer.h"
 
@@ -33,9 +34,13 @@ bool squelch = true;
 bool leak_check = true;
 
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
-  auto json = grpc_core::JsonParse(
-      absl::string_view(reinterpret_cast<const char*>(data), size));
+  absl::string_view input(reinterpret_cast<const char*>(data), size);
+  auto json = grpc_core::JsonParse(input);
+  // JsonDocument must accept exactly the same documents.
+  auto document = grpc_core::JsonDocument::Parse(input);
+  GPR_ASSERT(document.ok() == json.ok());
   if (json.ok()) {
+    GPR_ASSERT(document->root().ToJson() == *json);
     auto text2 = grpc_core::JsonDump(*json);
     auto json2 = grpc_core::JsonParse(text2);
     GPR_ASSERT(json2.ok());
@@ -0,0 +1,236 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/json/json_document.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/json/json_object_loader.h"
+#include "src/core/lib/json/json_reader.h"
+#include "src/core/lib/json/json_writer.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Checks that JsonDocument::Parse() and JsonParse() agree on input.
+void ExpectSameAsJsonParse(absl::string_view input) {
+  auto expected = JsonParse(input);
+  auto document = JsonDocument::Parse(input);
+  ASSERT_EQ(document.ok(), expected.ok())
+      << "input: " << input << "\nJsonParse: " << expected.status()
+      << "\nJsonDocument: " << document.status();
+  if (!expected.ok()) return;
+  Json actual = document->root().ToJson();
+  EXPECT_EQ(actual, *expected) << "input: " << input
+                               << "\nJsonParse: " << JsonDump(*expected)
+                               << "\nJsonDocument: " << JsonDump(actual);
+}
+
+TEST(JsonDocumentTest, ValidInputs) {
+  for (const char* input : {
+           "null", "true", "false", "0", "-1", "1.5", "-0.25e+10", "12E-3",
+           // JsonParse() accepts these.
+           "-", "-01", "1e+", "\"\"", "\"foo\"", " \t\n\r\"x\" ", "[]", "{}",
+           "[[[]], {}, [{}]]", "[1,2,3]", "{\"a\":1,\"b\":[true,null]}",
+           "{\"b\":1,\"a\":2,\"c\":{\"z\":null,\"y\":\"\"}}",
+           "\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"", "\"\\u0041\\u00e9\\u20ac\"",
+           "\"\\ud834\\udd1e\"", "\"\xc3\xa9\xe2\x82\xac\xf0\x9d\x84\x9e\"",
+           "{\"\\u0061\":\"\\\\\"}", "\"\\u0000\"", "\"a\\\\\\\"b\\\\\"",
+           "[1 , 2 ,\n3]", "{ \"a\" : 1 , \"b\" : 2 }",
+       }) {
+    ExpectSameAsJsonParse(input);
+  }
+  // Everything after a NUL is ignored.
+  ExpectSameAsJsonParse(absl::string_view("[1]\0garbage", 11));
+}
+
+TEST(JsonDocumentTest, InvalidInputs) {
+  for (const char* input : {
+           "", " ", "\\", "nu ll", "nul", "truex", "fals", "{\"foo\": bar}",
+           "0,0", "\"foo\",[]", "[{},]", "{\"a\":1,}", "{,}", "[,]",
+           "{\"a\":}", "{\"a\"}", "{\"a\" 1}", "{1:2}", "[\"x\":0]", "{}}",
+           "[]]", "{{}", "[[]", "[}", "{]", "{},", "{}x", "1.", "1e", ".12",
+           "000", "01", "0e5", "1.x", "\"\\x\"", "\"\\u123x\"", "\"abc",
+           "\"\n\"", "\"\t\"", "\"\x01\"", "\"\\ud834\"", "\"\\udd1e\"",
+           "\"\\ud834\\ud834\"", "\"\\ud834\\n\"", "\"\xa0\"", "\"\xc0\xbc\"",
+           "\"\xe0\x80\x80\"", "\"\xed\xa0\x80\"", "\"\xf4\x90\x80\x80\"",
+           "\"\xc3\"", "\xc3\xa9", "{\"x\": 1, \"x\": 1}",
+           "\"a\"\"b\"", "[1]\"", "[\"a\"b]",
+       }) {
+    ExpectSameAsJsonParse(input);
+  }
+}
+
+TEST(JsonDocumentTest, DuplicateKeyError) {
+  auto document = JsonDocument::Parse("{\"x\": 1, \"x\": 2}");
+  EXPECT_EQ(document.status(),
+            absl::InvalidArgumentError(
+                "JSON parsing failed: [duplicate key \"x\" at index 9]"));
+}
+
+TEST(JsonDocumentTest, MaxDepth) {
+  ExpectSameAsJsonParse(absl::StrCat(std::string(255, '['),
+                                     std::string(255, ']')));
+  std::string too_deep = absl::StrCat(std::string(256, '['),
+                                      std::string(256, ']'));
+  ExpectSameAsJsonParse(too_deep);
+  EXPECT_EQ(JsonDocument::Parse(too_deep).status(),
+            absl::InvalidArgumentError(
+                "JSON parsing failed: [exceeded max stack depth (255) at "
+                "index 255; JSON parse error at index 255]"));
+}
+
+TEST(JsonDocumentTest, TokensAcrossBlockBoundaries) {
+  // Vary the alignment of strings with escapes, runs of backslashes and
+  // scalars relative to the 64-byte blocks that the parser scans.
+  for (size_t padding = 0; padding < 70; ++padding) {
+    std::string input = absl::StrCat(
+        "{\"", std::string(padding, 'k'), "\":[", std::string(padding, ' '),
+        "\"", std::string(padding, '\\'), std::string(padding % 2, '\\'),
+        "\\\"\\u00e9\xc3\xa9\", 1234567890.5e10, true, null],\"z\":false}");
+    ExpectSameAsJsonParse(input);
+  }
+}
+
+TEST(JsonDocumentTest, Accessors) {
+  auto document = JsonDocument::Parse(
+      "{\"s\":\"a\\nb\",\"n\":-1.5,\"b\":true,\"z\":null,"
+      "\"a\":[1,\"x\"],\"o\":{}}");
+  ASSERT_TRUE(document.ok()) << document.status();
+  JsonView root = document->root();
+  ASSERT_EQ(root.type(), Json::Type::kObject);
+  ASSERT_EQ(root.size(), 6);
+  // Members are sorted by key.
+  EXPECT_EQ(root.key(0), "a");
+  EXPECT_EQ(root.key(5), "z");
+  auto s = root.Find("s");
+  ASSERT_TRUE(s.has_value());
+  EXPECT_EQ(s->type(), Json::Type::kString);
+  EXPECT_EQ(s->string(), "a\nb");
+  auto n = root.Find("n");
+  ASSERT_TRUE(n.has_value());
+  EXPECT_EQ(n->type(), Json::Type::kNumber);
+  EXPECT_EQ(n->string(), "-1.5");
+  auto b = root.Find("b");
+  ASSERT_TRUE(b.has_value());
+  EXPECT_EQ(b->type(), Json::Type::kBoolean);
+  EXPECT_TRUE(b->boolean());
+  auto z = root.Find("z");
+  ASSERT_TRUE(z.has_value());
+  EXPECT_EQ(z->type(), Json::Type::kNull);
+  auto a = root.Find("a");
+  ASSERT_TRUE(a.has_value());
+  ASSERT_EQ(a->type(), Json::Type::kArray);
+  ASSERT_EQ(a->size(), 2);
+  EXPECT_EQ(a->element(0).string(), "1");
+  EXPECT_EQ(a->element(1).string(), "x");
+  auto o = root.Find("o");
+  ASSERT_TRUE(o.has_value());
+  EXPECT_EQ(o->type(), Json::Type::kObject);
+  EXPECT_EQ(o->size(), 0);
+  EXPECT_FALSE(root.Find("missing").has_value());
+  EXPECT_FALSE(o->Find("a").has_value());
+  EXPECT_EQ(JsonView().type(), Json::Type::kNull);
+}
+
+TEST(JsonDocumentTest, DocumentDoesNotReferToInput) {
+  auto input = std::make_unique<std::string>("{\"key\":[\"value\"]}");
+  auto document = JsonDocument::Parse(*input);
+  input.reset();
+  ASSERT_TRUE(document.ok()) << document.status();
+  JsonDocument moved = std::move(*document);
+  EXPECT_EQ(moved.root().ToJson(),
+            Json::FromObject({{"key", Json::FromArray({Json::FromString(
+                                          "value")})}}));
+}
+
+struct Inner {
+  int32_t value = 0;
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader =
+        JsonObjectLoader<Inner>().Field("value", &Inner::value).Finish();
+    return loader;
+  }
+};
+
+struct Outer {
+  std::string name;
+  bool enabled = false;
+  std::vector<Inner> inners;
+  std::map<std::string, uint32_t> counts;
+  absl::optional<Duration> timeout;
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader =
+        JsonObjectLoader<Outer>()
+            .Field("name", &Outer::name)
+            .OptionalField("enabled", &Outer::enabled)
+            .OptionalField("inners", &Outer::inners)
+            .OptionalField("counts", &Outer::counts)
+            .OptionalField("timeout", &Outer::timeout)
+            .Finish();
+    return loader;
+  }
+};
+
+TEST(JsonDocumentTest, LoadFromJsonView) {
+  auto document = JsonDocument::Parse(
+      "{\"name\":\"foo\",\"enabled\":true,\"inners\":[{\"value\":1},"
+      "{\"value\":\"2\"}],\"counts\":{\"a\":3},\"timeout\":\"1.5s\"}");
+  ASSERT_TRUE(document.ok()) << document.status();
+  auto outer = LoadFromJson<Outer>(document->root());
+  ASSERT_TRUE(outer.ok()) << outer.status();
+  EXPECT_EQ(outer->name, "foo");
+  EXPECT_TRUE(outer->enabled);
+  ASSERT_EQ(outer->inners.size(), 2);
+  EXPECT_EQ(outer->inners[0].value, 1);
+  EXPECT_EQ(outer->inners[1].value, 2);
+  EXPECT_EQ(outer->counts, (std::map<std::string, uint32_t>{{"a", 3}}));
+  EXPECT_EQ(outer->timeout, Duration::Milliseconds(1500));
+}
+
+TEST(JsonDocumentTest, LoadFromJsonViewErrors) {
+  auto document = JsonDocument::Parse(
+      "{\"enabled\":1,\"inners\":[{}, {\"value\":true}],"
+      "\"counts\":{\"a\":-1}}");
+  ASSERT_TRUE(document.ok()) << document.status();
+  auto outer = LoadFromJson<Outer>(document->root());
+  EXPECT_EQ(outer.status(),
+            absl::InvalidArgumentError(
+                "errors validating JSON: ["
+                "field:counts[\"a\"] error:failed to parse non-negative "
+                "number; field:enabled error:is not a boolean; "
+                "field:inners[0].value error:field not present; "
+                "field:inners[1].value error:is not a number; "
+                "field:name error:field not present]"));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -24,6 +24,7 @@
 
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/json/json_document.h"
 #include "src/core/lib/json/json_reader.h"
 #include "src/core/lib/json/json_writer.h"
 
@@ -35,7 +36,15 @@ absl::StatusOr<T> Parse(absl::string_view json,
                         const JsonArgs& args = JsonArgs()) {
   auto parsed = JsonParse(json);
   if (!parsed.ok()) return parsed.status();
-  return LoadFromJson<T>(*parsed, args);
+  auto result = LoadFromJson<T>(*parsed, args);
+  // Loading from a JsonDocument must report the same errors.
+  auto document = JsonDocument::Parse(json);
+  EXPECT_TRUE(document.ok()) << document.status();
+  if (document.ok()) {
+    EXPECT_EQ(LoadFromJson<T>(document->root(), args).status(),
+              result.status());
+  }
+  return result;
 }
 
 //
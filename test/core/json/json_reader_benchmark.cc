@@ -0,0 +1,214 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Compares JsonParse() with JsonDocument::Parse() on service configs with
+// a varying number of method configs, both for parsing alone and for
+// parsing followed by loading the method configs with LoadFromJson().
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "absl/types/optional.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_args.h"
+#include "src/core/lib/json/json_document.h"
+#include "src/core/lib/json/json_object_loader.h"
+#include "src/core/lib/json/json_reader.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Builds a service config with num_method_configs method configs, each
+// naming a few methods and carrying a retry policy, followed by an
+// xds_cluster_manager LB config with one child per method config.
+std::string BuildServiceConfig(int num_method_configs) {
+  std::vector<std::string> method_configs;
+  std::vector<std::string> children;
+  for (int i = 0; i < num_method_configs; ++i) {
+    method_configs.push_back(absl::StrFormat(
+        "{\n"
+        "  \"name\": [\n"
+        "    {\"service\": \"package.Service%d\", \"method\": \"Get\"},\n"
+        "    {\"service\": \"package.Service%d\", \"method\": \"List\"},\n"
+        "    {\"service\": \"package.Service%d\"}\n"
+        "  ],\n"
+        "  \"timeout\": \"%d.250s\",\n"
+        "  \"waitForReady\": true,\n"
+        "  \"maxRequestMessageBytes\": %d,\n"
+        "  \"retryPolicy\": {\n"
+        "    \"maxAttempts\": 4,\n"
+        "    \"initialBackoff\": \"0.1s\",\n"
+        "    \"maxBackoff\": \"10s\",\n"
+        "    \"backoffMultiplier\": 1.5,\n"
+        "    \"retryableStatusCodes\": [\"UNAVAILABLE\", \"ABORTED\"]\n"
+        "  }\n"
+        "}",
+        i, i, i, i % 30 + 1, 4194304 + i));
+    children.push_back(absl::StrFormat(
+        "\"cluster:cluster%d\": {\"childPolicy\": [{\"cds_experimental\": "
+        "{\"cluster\": \"cluster%d\"}}]}",
+        i, i));
+  }
+  return absl::StrCat(
+      "{\n\"methodConfig\": [\n", absl::StrJoin(method_configs, ",\n"),
+      "\n],\n\"loadBalancingConfig\": [{\"xds_cluster_manager_experimental\": "
+      "{\"children\": {\n",
+      absl::StrJoin(children, ",\n"), "\n}}}]\n}\n");
+}
+
+// Mirrors the parts of the service config that the client channel loads.
+struct Name {
+  std::string service;
+  std::string method;
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader = JsonObjectLoader<Name>()
+                                    .OptionalField("service", &Name::service)
+                                    .OptionalField("method", &Name::method)
+                                    .Finish();
+    return loader;
+  }
+};
+
+struct RetryPolicy {
+  int32_t max_attempts = 0;
+  Duration initial_backoff;
+  Duration max_backoff;
+  float backoff_multiplier = 0;
+  std::vector<std::string> retryable_status_codes;
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader =
+        JsonObjectLoader<RetryPolicy>()
+            .Field("maxAttempts", &RetryPolicy::max_attempts)
+            .Field("initialBackoff", &RetryPolicy::initial_backoff)
+            .Field("maxBackoff", &RetryPolicy::max_backoff)
+            .Field("backoffMultiplier", &RetryPolicy::backoff_multiplier)
+            .Field("retryableStatusCodes",
+                   &RetryPolicy::retryable_status_codes)
+            .Finish();
+    return loader;
+  }
+};
+
+struct MethodConfig {
+  std::vector<Name> names;
+  absl::optional<Duration> timeout;
+  bool wait_for_ready = false;
+  absl::optional<uint32_t> max_request_message_bytes;
+  absl::optional<RetryPolicy> retry_policy;
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader =
+        JsonObjectLoader<MethodConfig>()
+            .Field("name", &MethodConfig::names)
+            .OptionalField("timeout", &MethodConfig::timeout)
+            .OptionalField("waitForReady", &MethodConfig::wait_for_ready)
+            .OptionalField("maxRequestMessageBytes",
+                           &MethodConfig::max_request_message_bytes)
+            .OptionalField("retryPolicy", &MethodConfig::retry_policy)
+            .Finish();
+    return loader;
+  }
+};
+
+struct ServiceConfig {
+  std::vector<MethodConfig> method_configs;
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader =
+        JsonObjectLoader<ServiceConfig>()
+            .OptionalField("methodConfig", &ServiceConfig::method_configs)
+            .Finish();
+    return loader;
+  }
+};
+
+void BM_JsonParse(benchmark::State& state) {
+  const std::string config = BuildServiceConfig(state.range(0));
+  for (auto _ : state) {
+    auto json = JsonParse(config);
+    GPR_ASSERT(json.ok());
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetBytesProcessed(state.iterations() * config.size());
+}
+BENCHMARK(BM_JsonParse)->Range(1, 4096);
+
+void BM_JsonDocumentParse(benchmark::State& state) {
+  const std::string config = BuildServiceConfig(state.range(0));
+  for (auto _ : state) {
+    auto document = JsonDocument::Parse(config);
+    GPR_ASSERT(document.ok());
+    benchmark::DoNotOptimize(document);
+  }
+  state.SetBytesProcessed(state.iterations() * config.size());
+}
+BENCHMARK(BM_JsonDocumentParse)->Range(1, 4096);
+
+void BM_JsonParseAndLoad(benchmark::State& state) {
+  const std::string config = BuildServiceConfig(state.range(0));
+  for (auto _ : state) {
+    auto json = JsonParse(config);
+    GPR_ASSERT(json.ok());
+    auto service_config = LoadFromJson<ServiceConfig>(*json);
+    GPR_ASSERT(service_config.ok());
+    benchmark::DoNotOptimize(service_config);
+  }
+  state.SetBytesProcessed(state.iterations() * config.size());
+}
+BENCHMARK(BM_JsonParseAndLoad)->Range(1, 4096);
+
+void BM_JsonDocumentParseAndLoad(benchmark::State& state) {
+  const std::string config = BuildServiceConfig(state.range(0));
+  for (auto _ : state) {
+    auto document = JsonDocument::Parse(config);
+    GPR_ASSERT(document.ok());
+    auto service_config = LoadFromJson<ServiceConfig>(document->root());
+    GPR_ASSERT(service_config.ok());
+    benchmark::DoNotOptimize(service_config);
+  }
+  state.SetBytesProcessed(state.iterations() * config.size());
+}
+BENCHMARK(BM_JsonDocumentParseAndLoad)->Range(1, 4096);
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
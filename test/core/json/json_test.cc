@@ -279,6 +279,11 @@ TEST(Json, TrailingComma) {
   RunParseFailureTest("{\"a\": 1, }");
 }
 
+TEST(Json, MissingObjectValue) {
+  RunParseFailureTest("{\"a\":}");
+  RunParseFailureTest("{\"a\": 1, \"b\":}");
+}
+
 TEST(Json, KeySyntaxInArray) { RunParseFailureTest("[\"x\":0]"); }
 
 TEST(Json, InvalidNumbers) {
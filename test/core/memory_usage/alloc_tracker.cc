@@ -0,0 +1,309 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test/core/memory_usage/alloc_tracker.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+
+#include "absl/base/config.h"
+
+// Sanitizers bring their own malloc, which must not be replaced.
+#if defined(__GLIBC__) && !defined(ABSL_HAVE_ADDRESS_SANITIZER) && \
+    !defined(ABSL_HAVE_MEMORY_SANITIZER) &&                        \
+    !defined(ABSL_HAVE_THREAD_SANITIZER) &&                        \
+    !defined(ABSL_HAVE_HWADDRESS_SANITIZER)
+#define GRPC_ALLOC_TRACKER
+#endif
+
+#ifdef GRPC_ALLOC_TRACKER
+#include <errno.h>
+#include <execinfo.h>
+#include <malloc.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <mutex>  // NOLINT
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
+#include "absl/debugging/symbolize.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+
+constexpr int kMaxFrames = 16;
+
+struct Stack {
+  void* frames[kMaxFrames];
+  int depth;
+
+  bool operator==(const Stack& other) const {
+    return depth == other.depth &&
+           memcmp(frames, other.frames, depth * sizeof(void*)) == 0;
+  }
+
+  template <typename H>
+  friend H AbslHashValue(H h, const Stack& stack) {
+    return H::combine_contiguous(std::move(h), stack.frames, stack.depth);
+  }
+};
+
+struct SiteStats {
+  int64_t bytes = 0;
+  int64_t allocations = 0;
+};
+
+struct LiveAlloc {
+  SiteStats* site;
+  size_t size;
+};
+
+struct Tracking {
+  // A node map, so that LiveAlloc can point into it.
+  absl::node_hash_map<Stack, SiteStats> sites;
+  absl::flat_hash_map<void*, LiveAlloc> live;
+};
+
+std::atomic<int64_t> g_live_bytes{0};
+std::atomic<bool> g_tracking{false};
+std::mutex g_mu;
+// Guarded by g_mu.
+Tracking* g_state = nullptr;
+// Set while the tracker itself allocates or frees, so that its own memory is
+// neither counted in the live heap nor tracked (and the hooks can't recurse).
+thread_local bool g_in_hook = false;
+
+class ScopedInHook {
+ public:
+  ScopedInHook() { g_in_hook = true; }
+  ~ScopedInHook() { g_in_hook = false; }
+  ScopedInHook(const ScopedInHook&) = delete;
+  ScopedInHook& operator=(const ScopedInHook&) = delete;
+};
+
+void OnAlloc(void* ptr) {
+  if (ptr == nullptr || g_in_hook) return;
+  const size_t size = malloc_usable_size(ptr);
+  g_live_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (!g_tracking.load(std::memory_order_relaxed)) return;
+  ScopedInHook in_hook;
+  Stack stack;
+  stack.depth = backtrace(stack.frames, kMaxFrames);
+  {
+    std::lock_guard<std::mutex> lock(g_mu);
+    if (g_state != nullptr) {
+      auto it = g_state->sites.emplace(stack, SiteStats()).first;
+      it->second.bytes += size;
+      ++it->second.allocations;
+      g_state->live[ptr] = LiveAlloc{&it->second, size};
+    }
+  }
+}
+
+void OnFree(void* ptr) {
+  if (ptr == nullptr || g_in_hook) return;
+  g_live_bytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+  if (!g_tracking.load(std::memory_order_relaxed)) return;
+  ScopedInHook in_hook;
+  {
+    std::lock_guard<std::mutex> lock(g_mu);
+    if (g_state != nullptr) {
+      auto it = g_state->live.find(ptr);
+      if (it != g_state->live.end()) {
+        it->second.site->bytes -= it->second.size;
+        --it->second.site->allocations;
+        g_state->live.erase(it);
+      }
+    }
+  }
+}
+
+// Frames of functions that allocate on behalf of their caller.
+bool IsAllocatorFrame(absl::string_view name) {
+  static const char* const kAllocatorPrefixes[] = {
+      "malloc",
+      "calloc",
+      "realloc",
+      "posix_memalign",
+      "aligned_alloc",
+      "memalign",
+      "valloc",
+      "pvalloc",
+      "(anonymous namespace)::OnAlloc",
+      "operator new",
+      "gpr_malloc",
+      "gpr_zalloc",
+      "gpr_realloc",
+      "gpr_strdup",
+      "grpc_core::Arena::",
+      "grpc_core::MakeRefCounted",
+      "grpc_core::MakeOrphanable",
+      "std::",
+      "__gnu_cxx::",
+      "absl::",
+  };
+  for (const char* prefix : kAllocatorPrefixes) {
+    if (absl::StartsWith(name, prefix)) return true;
+  }
+  return false;
+}
+
+std::string SiteName(const Stack& stack) {
+  std::string name = "(unknown)";
+  for (int i = 0; i < stack.depth; ++i) {
+    char buf[1024];
+    // Symbolize the call rather than the return address.
+    if (!absl::Symbolize(static_cast<char*>(stack.frames[i]) - 1, buf,
+                         sizeof(buf))) {
+      snprintf(buf, sizeof(buf), "%p", stack.frames[i]);
+    }
+    name = buf;
+    if (!IsAllocatorFrame(name)) break;
+  }
+  return name;
+}
+
+}  // namespace
+
+extern "C" {
+
+void* malloc(size_t size) {
+  void* ptr = __libc_malloc(size);
+  OnAlloc(ptr);
+  return ptr;
+}
+
+void* calloc(size_t n, size_t size) {
+  void* ptr = __libc_calloc(n, size);
+  OnAlloc(ptr);
+  return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+  OnFree(ptr);
+  void* new_ptr = __libc_realloc(ptr, size);
+  // On failure, ptr is still allocated.
+  OnAlloc(new_ptr == nullptr && size != 0 ? ptr : new_ptr);
+  return new_ptr;
+}
+
+void* memalign(size_t alignment, size_t size) {
+  void* ptr = __libc_memalign(alignment, size);
+  OnAlloc(ptr);
+  return ptr;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+  return memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+  *ptr = memalign(alignment, size);
+  return *ptr == nullptr && size != 0 ? ENOMEM : 0;
+}
+
+void* valloc(size_t size) { return memalign(sysconf(_SC_PAGESIZE), size); }
+
+void free(void* ptr) {
+  OnFree(ptr);
+  __libc_free(ptr);
+}
+
+}  // extern "C"
+
+int64_t GetLiveHeapBytes() {
+  return g_live_bytes.load(std::memory_order_relaxed);
+}
+
+void StartAllocTracking() {
+  ScopedInHook in_hook;
+  // The first backtrace() loads the unwinder, which is better not done from
+  // inside malloc.
+  void* frame;
+  backtrace(&frame, 1);
+  auto* state = new Tracking();
+  {
+    std::lock_guard<std::mutex> lock(g_mu);
+    std::swap(g_state, state);
+  }
+  delete state;
+  g_tracking.store(true, std::memory_order_relaxed);
+}
+
+std::vector<AllocSite> StopAllocTracking() {
+  g_tracking.store(false, std::memory_order_relaxed);
+  Tracking* state = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(g_mu);
+    std::swap(g_state, state);
+  }
+  std::map<std::string, AllocSite> by_name;
+  if (state != nullptr) {
+    for (const auto& site : state->sites) {
+      if (site.second.allocations == 0) continue;
+      std::string name = SiteName(site.first);
+      AllocSite& result = by_name[name];
+      result.name = name;
+      result.bytes += site.second.bytes;
+      result.allocations += site.second.allocations;
+    }
+    ScopedInHook in_hook;
+    delete state;
+  }
+  std::vector<AllocSite> sites;
+  for (auto& site : by_name) sites.push_back(std::move(site.second));
+  std::sort(sites.begin(), sites.end(),
+            [](const AllocSite& a, const AllocSite& b) {
+              return a.bytes > b.bytes;
+            });
+  return sites;
+}
+
+#else  // GRPC_ALLOC_TRACKER
+
+int64_t GetLiveHeapBytes() { return 0; }
+
+void StartAllocTracking() {}
+
+std::vector<AllocSite> StopAllocTracking() { return {}; }
+
+#endif  // GRPC_ALLOC_TRACKER
+
+void PrintAllocSites(const char* title, const std::vector<AllocSite>& sites,
+                     int64_t per, size_t max_sites) {
+  printf("---------%s by call site--------\n", title);
+  const double divisor = static_cast<double>(std::max<int64_t>(per, 1));
+  for (size_t i = 0; i < std::min(sites.size(), max_sites); ++i) {
+    printf("%12.1f bytes %8.2f allocations  %s\n",
+           static_cast<double>(sites[i].bytes) / divisor,
+           static_cast<double>(sites[i].allocations) / divisor,
+           sites[i].name.c_str());
+  }
+}
@@ -0,0 +1,56 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_TEST_CORE_MEMORY_USAGE_ALLOC_TRACKER_H
+#define GRPC_TEST_CORE_MEMORY_USAGE_ALLOC_TRACKER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+// A malloc interposer for finding out where heap memory goes.  Linking it
+// into a binary replaces malloc, free and friends (with glibc, and not under
+// sanitizers) by versions that keep count of the live heap and, between
+// StartAllocTracking() and StopAllocTracking(), of the allocations made by
+// each call site.  Call sites are named after the first function on the
+// stack that is not part of an allocator (e.g. gpr_malloc, operator new,
+// the arena or the standard library), and need absl::InitializeSymbolizer()
+// to have been called to be named at all.
+
+// Bytes currently allocated on the heap, not counting the tracker's own
+// bookkeeping, or 0 if the interposer is not active.
+int64_t GetLiveHeapBytes();
+
+struct AllocSite {
+  std::string name;
+  // Allocated since StartAllocTracking() and not freed.
+  int64_t bytes;
+  int64_t allocations;
+};
+
+// Starts tracking the allocations of each call site.
+void StartAllocTracking();
+
+// Stops tracking, and returns the call sites whose allocations since
+// StartAllocTracking() are still live, largest first.
+std::vector<AllocSite> StopAllocTracking();
+
+// Prints the top max_sites sites, with bytes and allocations divided by
+// per (e.g. the number of channels measured).
+void PrintAllocSites(const char* title, const std::vector<AllocSite>& sites,
+                     int64_t per, size_t max_sites = 10);
+
+#endif  // GRPC_TEST_CORE_MEMORY_USAGE_ALLOC_TRACKER_H
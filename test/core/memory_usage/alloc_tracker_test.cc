@@ -0,0 +1,82 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test/core/memory_usage/alloc_tracker.h"
+
+#include <malloc.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "absl/debugging/symbolize.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+constexpr int kAllocations = 100;
+constexpr size_t kAllocationSize = 1000;
+
+// Called through volatile pointers, so that the compiler can't elide the
+// allocations.
+void* (*volatile g_malloc)(size_t) = malloc;
+void (*volatile g_free)(void*) = free;
+
+TEST(AllocTrackerTest, MeasuresOnlyTheCallersAllocations) {
+  if (GetLiveHeapBytes() == 0) {
+    GTEST_SKIP() << "malloc is not interposed in this build";
+  }
+  std::vector<void*> ptrs(kAllocations);
+  const int64_t before = GetLiveHeapBytes();
+  StartAllocTracking();
+  for (void*& ptr : ptrs) ptr = g_malloc(kAllocationSize);
+  const int64_t after = GetLiveHeapBytes();
+  std::vector<AllocSite> sites = StopAllocTracking();
+  int64_t expected = 0;
+  for (void* ptr : ptrs) expected += malloc_usable_size(ptr);
+  for (void* ptr : ptrs) g_free(ptr);
+  // The tracker's own bookkeeping (e.g. its record of each live allocation)
+  // must not show up in the measurement.
+  EXPECT_EQ(after - before, expected);
+  int64_t tracked_bytes = 0;
+  int64_t tracked_allocations = 0;
+  for (const AllocSite& site : sites) {
+    tracked_bytes += site.bytes;
+    tracked_allocations += site.allocations;
+  }
+  EXPECT_EQ(tracked_bytes, expected);
+  EXPECT_EQ(tracked_allocations, kAllocations);
+}
+
+TEST(AllocTrackerTest, ForgetsFreedAllocations) {
+  if (GetLiveHeapBytes() == 0) {
+    GTEST_SKIP() << "malloc is not interposed in this build";
+  }
+  std::vector<void*> ptrs(kAllocations);
+  const int64_t before = GetLiveHeapBytes();
+  StartAllocTracking();
+  for (void*& ptr : ptrs) ptr = g_malloc(kAllocationSize);
+  for (void* ptr : ptrs) g_free(ptr);
+  const int64_t after = GetLiveHeapBytes();
+  std::vector<AllocSite> sites = StopAllocTracking();
+  EXPECT_EQ(after, before);
+  EXPECT_TRUE(sites.empty());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  absl::InitializeSymbolizer(argv[0]);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
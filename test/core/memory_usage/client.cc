@@ -41,6 +41,7 @@
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gpr/useful.h"
+#include "test/core/memory_usage/alloc_tracker.h"
 #include "test/core/memory_usage/memstats.h"
 #include "test/core/util/test_config.h"
 
@@ -177,8 +178,10 @@ static MemStats send_snapshot_request(int call_idx, grpc_slice call_type) {
   return snapshot;
 }
 
-// Create iterations calls, return MemStats when all outstanding
-std::pair<MemStats, MemStats> run_test_loop(int iterations, int* call_idx) {
+// Create iterations calls, return MemStats when all outstanding.  If sites is
+// given, also return the client's allocation sites since StartAllocTracking().
+std::pair<MemStats, MemStats> run_test_loop(
+    int iterations, int* call_idx, std::vector<AllocSite>* sites = nullptr) {
   grpc_event event;
 
   // benchmark period
@@ -192,6 +195,7 @@ std::pair<MemStats, MemStats> run_test_loop(int iterations, int* call_idx) {
       // server
       send_snapshot_request(
           0, grpc_slice_from_static_string("Reflector/DestroyCalls")));
+  if (sites != nullptr) *sites = StopAllocTracking();
 
   do {
     event = grpc_completion_queue_next(
@@ -223,6 +227,7 @@ ABSL_FLAG(std::string, target, "localhost:443", "Target host:port");
 ABSL_FLAG(int, warmup, 100, "Warmup iterations");
 ABSL_FLAG(int, benchmark, 1000, "Benchmark iterations");
 ABSL_FLAG(bool, minstack, false, "Use minimal stack");
+ABSL_FLAG(int, sites, 10, "Number of allocation sites to print");
 
 int main(int argc, char** argv) {
   absl::ParseCommandLine(argc, argv);
@@ -263,8 +268,17 @@ int main(int argc, char** argv) {
 
   run_test_loop(warmup_iterations, &call_idx);
 
+  // The heap is measured from after the warmup, leaving out what the first
+  // calls allocate once for the process (and the server starts tracking its
+  // allocation sites).
+  MemStats server_heap_start = send_snapshot_request(
+      0, grpc_slice_from_static_string("Reflector/SimpleSnapshot"));
+  MemStats client_heap_start = MemStats::Snapshot();
+  StartAllocTracking();
+
+  std::vector<AllocSite> client_sites;
   std::pair<MemStats, MemStats> peak =
-      run_test_loop(benchmark_iterations, &call_idx);
+      run_test_loop(benchmark_iterations, &call_idx, &client_sites);
 
   MemStats client_calls_inflight = peak.first;
   MemStats server_calls_inflight = peak.second;
@@ -287,12 +301,22 @@ int main(int argc, char** argv) {
          static_cast<double>(client_calls_inflight.rss -
                              client_benchmark_calls_start.rss) /
              benchmark_iterations * 1024);
+  printf("client call heap usage: %f bytes per call\n",
+         static_cast<double>(client_calls_inflight.heap -
+                             client_heap_start.heap) /
+             benchmark_iterations);
+  PrintAllocSites("client call", client_sites, benchmark_iterations,
+                  absl::GetFlag(FLAGS_sites));
 
   printf("---------server stats--------\n");
   printf("server call memory usage: %f bytes per call\n",
          static_cast<double>(server_calls_inflight.rss -
                              server_benchmark_calls_start.rss) /
              benchmark_iterations * 1024);
+  printf("server call heap usage: %f bytes per call\n",
+         static_cast<double>(server_calls_inflight.heap -
+                             server_heap_start.heap) /
+             benchmark_iterations);
 
   return 0;
 }
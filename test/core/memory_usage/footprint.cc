@@ -0,0 +1,303 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the heap memory held by the long lived objects that a process
+// keeps many of: idle channels, connected subchannels, pending timers and
+// xDS-watched clusters.  For each, creates --size of them in this process,
+// and reports the live heap they take per object, broken down by the call
+// sites that allocated it.  (Per-call memory is measured by the "call"
+// benchmark of memory_usage_test, which runs client and server in separate
+// processes.)
+
+#include <stdio.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/xds/xds_bootstrap_grpc.h"
+#include "src/core/ext/xds/xds_client.h"
+#include "src/core/ext/xds/xds_cluster.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/proto/grpc/testing/xds/v3/cluster.pb.h"
+#include "src/proto/grpc/testing/xds/v3/discovery.pb.h"
+#include "test/core/memory_usage/alloc_tracker.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/core/xds/xds_transport_fake.h"
+
+ABSL_FLAG(std::string, benchmark_names,
+          "idle_channel,subchannel,timer,xds_cluster",
+          "Which objects to measure");
+ABSL_FLAG(int, size, 1000, "Number of objects of each kind");
+ABSL_FLAG(int, sites, 10, "Number of call sites to print for each kind");
+
+namespace grpc_core {
+namespace {
+
+// Measures the live heap allocated between its construction and Finish().
+class HeapMeasurement {
+ public:
+  HeapMeasurement() : before_(GetLiveHeapBytes()) { StartAllocTracking(); }
+
+  void Finish(absl::string_view name, absl::string_view unit, int size) {
+    const int64_t after = GetLiveHeapBytes();
+    std::vector<AllocSite> sites = StopAllocTracking();
+    printf("---------%s stats--------\n", std::string(name).c_str());
+    printf("%s memory usage: %f bytes per %s\n", std::string(name).c_str(),
+           static_cast<double>(after - before_) / size,
+           std::string(unit).c_str());
+    PrintAllocSites(std::string(name).c_str(), sites, size,
+                    absl::GetFlag(FLAGS_sites));
+  }
+
+ private:
+  const int64_t before_;
+};
+
+grpc_channel* CreateChannel(absl::string_view target) {
+  // Every channel gets its own subchannels, as channels to different
+  // targets would.
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL), 1);
+  grpc_channel_args args = {1, &arg};
+  grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+  grpc_channel* channel =
+      grpc_channel_create(std::string(target).c_str(), creds, &args);
+  grpc_channel_credentials_release(creds);
+  return channel;
+}
+
+void WaitForReady(grpc_channel* channel, grpc_completion_queue* cq) {
+  grpc_connectivity_state state;
+  while ((state = grpc_channel_check_connectivity_state(channel, 1)) !=
+         GRPC_CHANNEL_READY) {
+    grpc_channel_watch_connectivity_state(
+        channel, state, grpc_timeout_seconds_to_deadline(10), cq, nullptr);
+    GPR_ASSERT(grpc_completion_queue_next(
+                   cq, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr)
+                   .type == GRPC_OP_COMPLETE);
+  }
+}
+
+void RunIdleChannelBenchmark(int size) {
+  const std::string target =
+      JoinHostPort("127.0.0.1", grpc_pick_unused_port_or_die());
+  // Leave one-time allocations out.
+  grpc_channel_destroy(CreateChannel(target));
+  std::vector<grpc_channel*> channels;
+  channels.reserve(size);
+  HeapMeasurement measurement;
+  for (int i = 0; i < size; ++i) channels.push_back(CreateChannel(target));
+  measurement.Finish("idle channel", "channel", size);
+  for (grpc_channel* channel : channels) grpc_channel_destroy(channel);
+}
+
+// Measures the connections of channels to a server in this process, so
+// both their client and server ends.
+void RunSubchannelBenchmark(int size) {
+  const std::string addr =
+      JoinHostPort("127.0.0.1", grpc_pick_unused_port_or_die());
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  grpc_server* server = grpc_server_create(nullptr, nullptr);
+  grpc_server_credentials* server_creds =
+      grpc_insecure_server_credentials_create();
+  GPR_ASSERT(grpc_server_add_http2_port(server, addr.c_str(), server_creds));
+  grpc_server_credentials_release(server_creds);
+  grpc_server_register_completion_queue(server, cq, nullptr);
+  grpc_server_start(server);
+  std::vector<grpc_channel*> channels;
+  channels.reserve(size + 1);
+  // Leave one-time allocations out.
+  channels.push_back(CreateChannel(addr));
+  WaitForReady(channels.back(), cq);
+  for (int i = 0; i < size; ++i) channels.push_back(CreateChannel(addr));
+  {
+    HeapMeasurement measurement;
+    for (size_t i = 1; i < channels.size(); ++i) {
+      grpc_channel_check_connectivity_state(channels[i], 1);
+    }
+    for (size_t i = 1; i < channels.size(); ++i) {
+      WaitForReady(channels[i], cq);
+    }
+    // Let the server finish setting up its end of the last connections.
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(100));
+    measurement.Finish("subchannel", "connected subchannel", size);
+  }
+  for (grpc_channel* channel : channels) grpc_channel_destroy(channel);
+  grpc_server_shutdown_and_notify(server, cq, nullptr);
+  GPR_ASSERT(grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                        nullptr)
+                 .type == GRPC_OP_COMPLETE);
+  grpc_server_destroy(server);
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+}
+
+void RunTimerBenchmark(int size) {
+  using grpc_event_engine::experimental::EventEngine;
+  auto engine = grpc_event_engine::experimental::GetDefaultEventEngine();
+  std::vector<EventEngine::TaskHandle> handles;
+  handles.reserve(size + 1);
+  // Leave one-time allocations out.
+  handles.push_back(engine->RunAfter(std::chrono::hours(1), []() {}));
+  {
+    HeapMeasurement measurement;
+    for (int i = 0; i < size; ++i) {
+      handles.push_back(engine->RunAfter(std::chrono::hours(1), []() {}));
+    }
+    measurement.Finish("timer", "pending timer", size);
+  }
+  for (const auto& handle : handles) GPR_ASSERT(engine->Cancel(handle));
+}
+
+constexpr char kBootstrap[] =
+    "{\"xds_servers\": [{\"server_uri\":\"xds.example.com:443\", "
+    "\"channel_creds\":[{\"type\": \"fake\"}]}]}";
+
+class ClusterWatcher : public XdsClusterResourceType::WatcherInterface {
+ public:
+  void OnResourceChanged(XdsClusterResource /*resource*/) override {}
+  void OnError(absl::Status status) override {
+    gpr_log(GPR_ERROR, "CDS watcher error: %s", status.ToString().c_str());
+  }
+  void OnResourceDoesNotExist() override {
+    gpr_log(GPR_ERROR, "CDS resource does not exist");
+  }
+};
+
+std::string ClusterName(int i) { return absl::StrCat("cluster", i); }
+
+std::string BuildClusterResponse(int num_clusters) {
+  envoy::service::discovery::v3::DiscoveryResponse response;
+  response.set_type_url("type.googleapis.com/envoy.config.cluster.v3.Cluster");
+  response.set_version_info("1");
+  response.set_nonce("A");
+  for (int i = 0; i < num_clusters; ++i) {
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name(ClusterName(i));
+    cluster.set_type(cluster.EDS);
+    auto* eds_cluster_config = cluster.mutable_eds_cluster_config();
+    eds_cluster_config->mutable_eds_config()->mutable_ads();
+    eds_cluster_config->set_service_name(absl::StrCat("eds_", ClusterName(i)));
+    response.add_resources()->PackFrom(cluster);
+  }
+  return response.SerializeAsString();
+}
+
+// Measures the memory the XdsClient holds for each cluster watched, as
+// the cds LB policy does for every cluster a channel uses.
+void RunXdsClusterBenchmark(int size) {
+  auto bootstrap = GrpcXdsBootstrap::Create(kBootstrap);
+  GPR_ASSERT(bootstrap.ok());
+  auto transport_factory = MakeOrphanable<FakeXdsTransportFactory>();
+  auto* transport_factory_ptr = transport_factory.get();
+  auto xds_client = MakeRefCounted<XdsClient>(
+      std::move(*bootstrap), std::move(transport_factory),
+      grpc_event_engine::experimental::GetDefaultEventEngine(), "foo agent",
+      "foo version");
+  const std::string response = BuildClusterResponse(size);
+  std::vector<RefCountedPtr<ClusterWatcher>> watchers;
+  watchers.reserve(size);
+  {
+    HeapMeasurement measurement;
+    for (int i = 0; i < size; ++i) {
+      watchers.push_back(MakeRefCounted<ClusterWatcher>());
+      XdsClusterResourceType::StartWatch(xds_client.get(), ClusterName(i),
+                                         watchers.back());
+    }
+    auto stream = transport_factory_ptr->WaitForStream(
+        xds_client->bootstrap().server(), FakeXdsTransportFactory::kAdsMethod,
+        absl::Seconds(5));
+    GPR_ASSERT(stream != nullptr);
+    // Wait for a request that subscribes to all of the clusters.  The
+    // XdsClient may send it as several requests, each naming all of the
+    // clusters watched so far.
+    envoy::service::discovery::v3::DiscoveryRequest request;
+    do {
+      auto message = stream->WaitForMessageFromClient(absl::Seconds(5));
+      GPR_ASSERT(message.has_value());
+      GPR_ASSERT(request.ParseFromString(*message));
+    } while (request.resource_names_size() != size);
+    stream->SendMessageToClient(response);
+    // Wait for the ACK, which is sent once the response has been applied.
+    do {
+      auto message = stream->WaitForMessageFromClient(absl::Seconds(5));
+      GPR_ASSERT(message.has_value());
+      GPR_ASSERT(request.ParseFromString(*message));
+    } while (request.version_info() != "1" || request.response_nonce() != "A");
+    measurement.Finish("xds cluster", "cluster", size);
+  }
+  for (int i = 0; i < size; ++i) {
+    XdsClusterResourceType::CancelWatch(xds_client.get(), ClusterName(i),
+                                        watchers[i].get());
+  }
+}
+
+int RunBenchmark(absl::string_view benchmark, int size) {
+  if (benchmark == "idle_channel") {
+    RunIdleChannelBenchmark(size);
+  } else if (benchmark == "subchannel") {
+    RunSubchannelBenchmark(size);
+  } else if (benchmark == "timer") {
+    RunTimerBenchmark(size);
+  } else if (benchmark == "xds_cluster") {
+    RunXdsClusterBenchmark(size);
+  } else {
+    gpr_log(GPR_ERROR, "Not a valid benchmark name: %s",
+            std::string(benchmark).c_str());
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int status = 0;
+  for (absl::string_view benchmark :
+       absl::StrSplit(absl::GetFlag(FLAGS_benchmark_names), ',')) {
+    status = grpc_core::RunBenchmark(benchmark, absl::GetFlag(FLAGS_size));
+    if (status != 0) break;
+  }
+  grpc_shutdown();
+  return status;
+}
@@ -42,7 +42,7 @@
 #include "test/core/util/subprocess.h"
 #include "test/core/util/test_config.h"
 
-ABSL_FLAG(std::string, benchmark_names, "call,channel",
+ABSL_FLAG(std::string, benchmark_names, "call,channel,xds_config,footprint",
           "Which benchmark to run");  // Default all benchmarks in order to
                                       // trigger CI testing for each one
 ABSL_FLAG(int, size, 1000, "Number of channels/calls");
@@ -149,6 +149,41 @@ int RunChannelBenchmark(char* root) {
   return svr.Join() == 0 ? 0 : 2;
 }
 
+// Per-channel memory used by xDS-generated configs, with and without
+// sharing identical configs between channels
+int RunXdsConfigBenchmark(char* root) {
+  for (const bool interning : {false, true}) {
+    std::vector<std::string> flags = {
+        absl::StrCat(root, "/memory_usage_xds_config",
+                     gpr_subprocess_binary_extension()),
+        absl::StrCat("--size=", absl::GetFlag(FLAGS_size)),
+        absl::StrCat("--interning=", interning ? "true" : "false")};
+    Subprocess xds_config(flags);
+    int status;
+    if ((status = xds_config.Join()) != 0) {
+      printf("xds config benchmark failed with: %d", status);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Heap held per idle channel, connected subchannel, pending timer and
+// xDS-watched cluster, by allocation site
+int RunFootprintBenchmark(char* root) {
+  std::vector<std::string> flags = {
+      absl::StrCat(root, "/memory_usage_footprint",
+                   gpr_subprocess_binary_extension()),
+      absl::StrCat("--size=", absl::GetFlag(FLAGS_size))};
+  Subprocess footprint(flags);
+  int status;
+  if ((status = footprint.Join()) != 0) {
+    printf("footprint benchmark failed with: %d", status);
+    return 1;
+  }
+  return 0;
+}
+
 int RunBenchmark(char* root, absl::string_view benchmark,
                  std::vector<std::string> server_scenario_flags,
                  std::vector<std::string> client_scenario_flags) {
@@ -156,6 +191,10 @@ int RunBenchmark(char* root, absl::string_view benchmark,
     return RunCallBenchmark(root, server_scenario_flags, client_scenario_flags);
   } else if (benchmark == "channel") {
     return RunChannelBenchmark(root);
+  } else if (benchmark == "xds_config") {
+    return RunXdsConfigBenchmark(root);
+  } else if (benchmark == "footprint") {
+    return RunFootprintBenchmark(root);
   } else {
     gpr_log(GPR_INFO, "Not a valid benchmark name");
     return 4;
@@ -17,6 +17,8 @@
 
 #include "absl/types/optional.h"
 
+#include "test/core/memory_usage/alloc_tracker.h"
+
 // IWYU pragma: no_include <bits/types/struct_rusage.h>
 
 // Get the memory usage of either the calling process or another process using
@@ -24,8 +26,11 @@
 long GetMemUsage(absl::optional<int> pid = absl::nullopt);
 
 struct MemStats {
-  long rss;  // Resident set size, in kb
-  static MemStats Snapshot() { return MemStats{GetMemUsage()}; }
+  long rss;   // Resident set size, in kb
+  long heap;  // Live heap, in bytes (0 without the malloc interposer)
+  static MemStats Snapshot() {
+    return MemStats{GetMemUsage(), static_cast<long>(GetLiveHeapBytes())};
+  }
 };
 
 #endif  // GRPC_TEST_CORE_MEMORY_USAGE_MEMSTATS_H
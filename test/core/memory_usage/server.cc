@@ -36,6 +36,7 @@
 #include <grpc/slice.h>
 #include <grpc/status.h>
 
+#include "test/core/memory_usage/alloc_tracker.h"
 #include "test/core/memory_usage/memstats.h"
 #ifndef _WIN32
 // This is for _exit() below, which is temporary.
@@ -117,6 +118,18 @@ static void send_status(void* tag) {
                                                    nullptr));
 }
 
+// Prints where the heap held by the calls in flight was allocated since the
+// last snapshot.
+static void print_call_sites(int max_sites) {
+  int calls_in_flight = 0;
+  for (int k = 0; k < static_cast<int>(sizeof(calls) / sizeof(fling_call));
+       ++k) {
+    if (calls[k].state == FLING_SERVER_WAIT_FOR_DESTROY) ++calls_in_flight;
+  }
+  PrintAllocSites("server call", StopAllocTracking(), calls_in_flight,
+                  max_sites);
+}
+
 static void send_snapshot(void* tag, MemStats* snapshot) {
   grpc_op* op;
 
@@ -157,6 +170,7 @@ static void sigint_handler(int /*x*/) { _exit(0); }
 ABSL_FLAG(std::string, bind, "", "Bind host:port");
 ABSL_FLAG(bool, secure, false, "Use security");
 ABSL_FLAG(bool, minstack, false, "Use minimal stack");
+ABSL_FLAG(int, sites, 10, "Number of allocation sites to print");
 
 int main(int argc, char** argv) {
   absl::ParseCommandLine(argc, argv);
@@ -268,10 +282,12 @@ int main(int argc, char** argv) {
               s->state = FLING_SERVER_SEND_STATUS_SNAPSHOT;
               current_snapshot = MemStats::Snapshot();
               send_snapshot(s, &current_snapshot);
+              StartAllocTracking();
             } else if (0 == grpc_slice_str_cmp(s->call_details.method,
                                                "Reflector/DestroyCalls")) {
               s->state = FLING_SERVER_BATCH_SEND_STATUS_FLING_CALL;
               current_snapshot = MemStats::Snapshot();
+              print_call_sites(absl::GetFlag(FLAGS_sites));
               send_snapshot(s, &current_snapshot);
             } else {
               gpr_log(GPR_ERROR, "Wrong call method");
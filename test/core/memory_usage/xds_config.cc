@@ -0,0 +1,202 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+// Measures the memory held per channel by the LB policy configs and the
+// service config that the xds resolver and the xDS LB policies generate.
+// Every channel is set up as if it were talking to the same set of
+// clusters, as happens when a process opens many channels to the same
+// xDS target.  With --interning, configs are parsed the way the xDS code
+// parses them, so identical configs are shared between channels;
+// without it, every channel parses its own copy.
+
+#include <stdio.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/intern_cache.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_reader.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/service_config/service_config.h"
+#include "src/core/lib/service_config/service_config_impl.h"
+#include "test/core/memory_usage/memstats.h"
+#include "test/core/util/test_config.h"
+
+ABSL_FLAG(int, size, 1000, "Number of channels");
+ABSL_FLAG(int, clusters, 10, "Number of clusters used by each channel");
+ABSL_FLAG(int, localities, 10, "Number of localities in each cluster");
+ABSL_FLAG(bool, interning, true, "Share identical configs between channels");
+
+namespace grpc_core {
+namespace {
+
+// The configs that a channel holds for its xDS clusters.
+struct ChannelConfigs {
+  RefCountedPtr<ServiceConfig> service_config;
+  std::vector<RefCountedPtr<LoadBalancingPolicy::Config>> lb_configs;
+};
+
+std::string ClusterName(int cluster) {
+  return absl::StrCat("cluster", cluster);
+}
+
+// As generated by the xds resolver.
+std::string ServiceConfigJson(int num_clusters) {
+  std::vector<std::string> children;
+  for (int i = 0; i < num_clusters; ++i) {
+    children.push_back(absl::StrFormat(
+        "\"cluster:%s\":{\"childPolicy\":[{\"cds_experimental\":"
+        "{\"cluster\":\"%s\"}}]}",
+        ClusterName(i), ClusterName(i)));
+  }
+  return absl::StrCat(
+      "{\"loadBalancingConfig\":[{\"xds_cluster_manager_experimental\":"
+      "{\"children\":{",
+      absl::StrJoin(children, ","), "}}}]}");
+}
+
+// As generated by the cds policy.
+std::string ClusterResolverJson(int cluster) {
+  return absl::StrFormat(
+      "[{\"xds_cluster_resolver_experimental\":{"
+      "\"discoveryMechanisms\":[{\"clusterName\":\"%s\",\"type\":\"EDS\","
+      "\"edsServiceName\":\"eds_%s\",\"max_concurrent_requests\":1024,"
+      "\"outlierDetection\":{}}],"
+      "\"xdsLbPolicy\":[{\"xds_wrr_locality_experimental\":"
+      "{\"childPolicy\":[{\"round_robin\":{}}]}}]}}]",
+      ClusterName(cluster), ClusterName(cluster));
+}
+
+// As generated by the xds_cluster_resolver policy.
+std::string PriorityJson(int cluster) {
+  return absl::StrFormat(
+      "[{\"priority_experimental\":{\"priorities\":[\"{cluster=%s, "
+      "child_number=0}\"],\"children\":{\"{cluster=%s, child_number=0}\":{"
+      "\"config\":[{\"outlier_detection_experimental\":{\"childPolicy\":["
+      "{\"xds_cluster_impl_experimental\":{\"clusterName\":\"%s\","
+      "\"edsServiceName\":\"eds_%s\",\"maxConcurrentRequests\":1024,"
+      "\"dropCategories\":[],\"childPolicy\":["
+      "{\"xds_override_host_experimental\":{\"childPolicy\":["
+      "{\"xds_wrr_locality_experimental\":{\"childPolicy\":["
+      "{\"round_robin\":{}}]}}]}}]}}]}}]}}}}]",
+      ClusterName(cluster), ClusterName(cluster), ClusterName(cluster),
+      ClusterName(cluster));
+}
+
+// As generated by the xds_wrr_locality policy.
+std::string WeightedTargetJson(int num_localities) {
+  std::vector<std::string> targets;
+  for (int i = 0; i < num_localities; ++i) {
+    targets.push_back(absl::StrFormat(
+        "\"{region=\\\"region\\\", zone=\\\"zone%d\\\", sub_zone=\\\"\\\"}\":"
+        "{\"weight\":%d,\"childPolicy\":[{\"round_robin\":{}}]}",
+        i, i + 1));
+  }
+  return absl::StrCat("[{\"weighted_target_experimental\":{\"targets\":{",
+                      absl::StrJoin(targets, ","), "}}}]");
+}
+
+RefCountedPtr<LoadBalancingPolicy::Config> ParseLbConfig(
+    absl::string_view json_string, bool interning) {
+  auto json = JsonParse(json_string);
+  GPR_ASSERT(json.ok());
+  const auto& registry = CoreConfiguration::Get().lb_policy_registry();
+  auto config = interning ? registry.ParseLoadBalancingConfigInterned(*json)
+                          : registry.ParseLoadBalancingConfig(*json);
+  if (!config.ok()) {
+    gpr_log(GPR_ERROR, "%s", config.status().ToString().c_str());
+    GPR_ASSERT(false);
+  }
+  return std::move(*config);
+}
+
+ChannelConfigs CreateChannelConfigs(InternCache<ServiceConfig>* cache,
+                                    int num_clusters, int num_localities,
+                                    bool interning) {
+  ChannelConfigs configs;
+  const std::string service_config_json = ServiceConfigJson(num_clusters);
+  auto create = [&]() {
+    return ServiceConfigImpl::Create(ChannelArgs(), service_config_json);
+  };
+  auto service_config =
+      interning ? cache->GetOrCreate(service_config_json, create) : create();
+  GPR_ASSERT(service_config.ok());
+  configs.service_config = std::move(*service_config);
+  for (int i = 0; i < num_clusters; ++i) {
+    configs.lb_configs.push_back(
+        ParseLbConfig(ClusterResolverJson(i), interning));
+    configs.lb_configs.push_back(ParseLbConfig(PriorityJson(i), interning));
+    configs.lb_configs.push_back(
+        ParseLbConfig(WeightedTargetJson(num_localities), interning));
+  }
+  return configs;
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  const int size = absl::GetFlag(FLAGS_size);
+  const int clusters = absl::GetFlag(FLAGS_clusters);
+  const int localities = absl::GetFlag(FLAGS_localities);
+  const bool interning = absl::GetFlag(FLAGS_interning);
+  gpr_log(GPR_INFO, "Channels: %d, clusters: %d, localities: %d, interning: %d",
+          size, clusters, localities, interning);
+  {
+    // Stands in for the cache shared by the xds resolvers.
+    grpc_core::InternCache<grpc_core::ServiceConfig> service_config_cache(
+        size);
+    // Parse one set of configs up front, so that one-time allocations
+    // (e.g., for the JSON loaders) are not counted.
+    auto warmup = grpc_core::CreateChannelConfigs(
+        &service_config_cache, clusters, localities, /*interning=*/false);
+    long before = GetMemUsage();
+    std::vector<grpc_core::ChannelConfigs> channels;
+    channels.reserve(size);
+    for (int i = 0; i < size; ++i) {
+      channels.push_back(grpc_core::CreateChannelConfigs(
+          &service_config_cache, clusters, localities, interning));
+    }
+    long after = GetMemUsage();
+    printf("---------xDS config stats--------\n");
+    printf("xds config memory usage (interning %s): %f bytes per channel\n",
+           interning ? "on" : "off",
+           static_cast<double>(after - before) / size * 1024);
+  }
+  grpc_shutdown();
+  return 0;
+}
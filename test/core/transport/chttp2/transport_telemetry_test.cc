@@ -0,0 +1,401 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stdint.h>
+#include <string.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "gtest/gtest.h"
+
+#include <grpc/byte_buffer.h>
+#include <grpc/grpc.h>
+#include <grpc/impl/propagation_bits.h>
+#include <grpc/slice.h>
+#include <grpc/status.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_args_preconditioning.h"
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/surface/channel.h"
+#include "src/core/lib/surface/channel_stack_type.h"
+#include "src/core/lib/surface/completion_queue.h"
+#include "src/core/lib/surface/server.h"
+#include "src/core/lib/transport/transport_fwd.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+TEST(TransportTelemetryTest, SmoothsPingRtt) {
+  auto telemetry = MakeRefCounted<Chttp2Telemetry>();
+  EXPECT_EQ(telemetry->Snapshot().smoothed_rtt_us, 0);
+  // The first sample is taken as is...
+  telemetry->RecordPingRtt(gpr_time_from_micros(800, GPR_TIMESPAN));
+  EXPECT_EQ(telemetry->Snapshot().smoothed_rtt_us, 800);
+  // ...and later ones move the estimate by an eighth of the difference.
+  telemetry->RecordPingRtt(gpr_time_from_micros(1600, GPR_TIMESPAN));
+  EXPECT_EQ(telemetry->Snapshot().smoothed_rtt_us, 900);
+}
+
+TEST(TransportTelemetryTest, ComputesWriteRatios) {
+  auto telemetry = MakeRefCounted<Chttp2Telemetry>();
+  EXPECT_EQ(telemetry->Snapshot().WriteCoalescingRatio(), 0);
+  EXPECT_EQ(telemetry->Snapshot().BytesPerWrite(), 0);
+  telemetry->RecordWrite(1000);
+  telemetry->RecordMessagesWritten(3);
+  telemetry->RecordWrite(3000);
+  telemetry->RecordMessagesWritten(5);
+  Http2TransportTelemetry snapshot = telemetry->Snapshot();
+  EXPECT_EQ(snapshot.writes, 2);
+  EXPECT_EQ(snapshot.bytes_written, 4000);
+  EXPECT_EQ(snapshot.messages_written, 8);
+  EXPECT_EQ(snapshot.WriteCoalescingRatio(), 4);
+  EXPECT_EQ(snapshot.BytesPerWrite(), 2000);
+}
+
+TEST(TransportTelemetryTest, AccumulatesStalls) {
+  ExecCtx exec_ctx;
+  auto telemetry = MakeRefCounted<Chttp2Telemetry>();
+  const Timestamp start = Timestamp::Now();
+  telemetry->TransportStallStarted();
+  telemetry->StreamStallStarted();
+  exec_ctx.TestOnlySetNow(start + Duration::Milliseconds(30));
+  telemetry->TransportStallEnded();
+  exec_ctx.TestOnlySetNow(start + Duration::Milliseconds(50));
+  telemetry->StreamStallEnded();
+  telemetry->TransportStallStarted();
+  exec_ctx.TestOnlySetNow(start + Duration::Milliseconds(60));
+  telemetry->TransportStallEnded();
+  Http2TransportTelemetry snapshot = telemetry->Snapshot();
+  EXPECT_EQ(snapshot.transport_stalled_time, Duration::Milliseconds(40));
+  EXPECT_EQ(snapshot.stream_stalled_time, Duration::Milliseconds(50));
+}
+
+TEST(TransportTelemetryTest, PopulatesChannelzSocketData) {
+  auto telemetry = MakeRefCounted<Chttp2Telemetry>();
+  telemetry->RecordWindows(65535, 1000);
+  telemetry->RecordBdp(12345, 1e6);
+  telemetry->RecordPingRtt(gpr_time_from_micros(250, GPR_TIMESPAN));
+  telemetry->RecordWrite(100);
+  telemetry->RecordMessagesWritten(2);
+  Json::Object data;
+  telemetry->PopulateSocketData(&data);
+  EXPECT_EQ(data["localFlowControlWindow"].string(), "65535");
+  EXPECT_EQ(data["remoteFlowControlWindow"].string(), "1000");
+  std::map<std::string, std::string> options;
+  for (const Json& option : data["option"].array()) {
+    options[option.object().at("name").string()] =
+        option.object().at("value").string();
+  }
+  EXPECT_EQ(options["grpc.http2.smoothed_rtt_us"], "250");
+  EXPECT_EQ(options["grpc.http2.bdp_estimate"], "12345");
+  EXPECT_EQ(options["grpc.http2.bandwidth_estimate"], "1000000");
+  EXPECT_EQ(options["grpc.http2.writes"], "1");
+  EXPECT_EQ(options["grpc.http2.write_coalescing_ratio"], "2.00");
+  EXPECT_EQ(options["grpc.http2.bytes_per_write"], "100.0");
+  EXPECT_EQ(options["grpc.http2.transport_stalled_ms"], "0");
+  EXPECT_EQ(options["grpc.http2.stream_stalled_ms"], "0");
+}
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+std::map<std::string, std::string> SocketOptions(const Json::Object& data) {
+  std::map<std::string, std::string> options;
+  for (const Json& option : data.at("option").array()) {
+    options[option.object().at("name").string()] =
+        option.object().at("value").string();
+  }
+  return options;
+}
+
+bool SameTelemetry(const Http2TransportTelemetry& a,
+                   const Http2TransportTelemetry& b) {
+  return a.smoothed_rtt_us == b.smoothed_rtt_us &&
+         a.bdp_estimate == b.bdp_estimate &&
+         a.bandwidth_estimate == b.bandwidth_estimate &&
+         a.local_window == b.local_window &&
+         a.remote_window == b.remote_window &&
+         a.transport_stalled_time == b.transport_stalled_time &&
+         a.stream_stalled_time == b.stream_stalled_time &&
+         a.writes == b.writes && a.bytes_written == b.bytes_written &&
+         a.messages_written == b.messages_written;
+}
+
+// Runs a client and a server chttp2 transport over a socket pair, so that
+// the telemetry is recorded by the transport itself.
+class TransportTelemetryEnd2endTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ExecCtx exec_ctx;
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+    grpc_endpoint_pair ep =
+        grpc_iomgr_create_endpoint_pair("transport_telemetry", nullptr);
+    // Server.
+    server_ = grpc_server_create(nullptr, nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    grpc_server_start(server_);
+    Server* core_server = Server::FromC(server_);
+    server_transport_ = grpc_create_chttp2_transport(
+        CoreConfiguration::Get()
+            .channel_args_preconditioning()
+            .PreconditionChannelArgs(nullptr),
+        ep.server, false);
+    grpc_endpoint_add_to_pollset(ep.server, grpc_cq_pollset(cq_));
+    ASSERT_TRUE(core_server
+                    ->SetupTransport(server_transport_, nullptr,
+                                     core_server->channel_args(), nullptr)
+                    .ok());
+    grpc_chttp2_transport_start_reading(server_transport_, nullptr, nullptr,
+                                        nullptr);
+    // Client.  Without BDP probing, the client's stream window stays at the
+    // default 64 KiB, so that a larger message from the server stalls until
+    // the client reads it.
+    auto client_args =
+        CoreConfiguration::Get()
+            .channel_args_preconditioning()
+            .PreconditionChannelArgs(
+                ChannelArgs()
+                    .Set(GRPC_ARG_DEFAULT_AUTHORITY, "test-authority")
+                    .Set(GRPC_ARG_HTTP2_BDP_PROBE, false)
+                    .ToC()
+                    .get());
+    client_transport_ =
+        grpc_create_chttp2_transport(client_args, ep.client, true);
+    auto channel = Channel::Create("socketpair-target", client_args,
+                                   GRPC_CLIENT_DIRECT_CHANNEL,
+                                   client_transport_);
+    ASSERT_TRUE(channel.ok()) << channel.status();
+    client_ = channel->release()->c_ptr();
+    grpc_chttp2_transport_start_reading(client_transport_, nullptr, nullptr,
+                                        nullptr);
+  }
+
+  void TearDown() override {
+    if (client_ != nullptr) grpc_channel_destroy(client_);
+    grpc_server_shutdown_and_notify(server_, cq_, Tag(1000));
+    Expect({1000});
+    grpc_server_destroy(server_);
+    grpc_completion_queue_shutdown(cq_);
+    while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq_);
+  }
+
+  // Waits for all of tags to complete successfully, in any order.
+  void Expect(std::set<intptr_t> tags) {
+    while (!tags.empty()) {
+      grpc_event event = grpc_completion_queue_next(
+          cq_, grpc_timeout_seconds_to_deadline(10), nullptr);
+      ASSERT_EQ(event.type, GRPC_OP_COMPLETE);
+      EXPECT_TRUE(event.success);
+      EXPECT_EQ(tags.erase(reinterpret_cast<intptr_t>(event.tag)), 1u);
+    }
+  }
+
+  // Returns the transport's telemetry, after checking that its channelz
+  // socket renders the same values.
+  static Http2TransportTelemetry CheckChannelz(grpc_transport* transport) {
+    RefCountedPtr<channelz::SocketNode> socket_node =
+        grpc_chttp2_transport_get_socket_node(transport);
+    EXPECT_NE(socket_node, nullptr);
+    if (socket_node == nullptr) return Http2TransportTelemetry();
+    // Writes may still be completing after the RPC is done, so retry until
+    // the telemetry is the same before and after rendering.
+    for (int i = 0; i < 100; ++i) {
+      const Http2TransportTelemetry before =
+          grpc_chttp2_transport_get_telemetry(transport);
+      const Json json = socket_node->RenderJson();
+      const Http2TransportTelemetry telemetry =
+          grpc_chttp2_transport_get_telemetry(transport);
+      if (!SameTelemetry(before, telemetry)) {
+        gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+        continue;
+      }
+      const Json::Object& data = json.object().at("data").object();
+      EXPECT_EQ(data.at("localFlowControlWindow").string(),
+                absl::StrCat(telemetry.local_window));
+      EXPECT_EQ(data.at("remoteFlowControlWindow").string(),
+                absl::StrCat(telemetry.remote_window));
+      std::map<std::string, std::string> options = SocketOptions(data);
+      EXPECT_EQ(options["grpc.http2.smoothed_rtt_us"],
+                absl::StrCat(telemetry.smoothed_rtt_us));
+      EXPECT_EQ(options["grpc.http2.bdp_estimate"],
+                absl::StrCat(telemetry.bdp_estimate));
+      EXPECT_EQ(options["grpc.http2.transport_stalled_ms"],
+                absl::StrCat(telemetry.transport_stalled_time.millis()));
+      EXPECT_EQ(options["grpc.http2.stream_stalled_ms"],
+                absl::StrCat(telemetry.stream_stalled_time.millis()));
+      EXPECT_EQ(options["grpc.http2.writes"], absl::StrCat(telemetry.writes));
+      EXPECT_EQ(options["grpc.http2.bytes_per_write"],
+                absl::StrFormat("%.1f", telemetry.BytesPerWrite()));
+      EXPECT_EQ(options["grpc.http2.write_coalescing_ratio"],
+                absl::StrFormat("%.2f", telemetry.WriteCoalescingRatio()));
+      return telemetry;
+    }
+    ADD_FAILURE() << "telemetry kept changing";
+    return Http2TransportTelemetry();
+  }
+
+  grpc_completion_queue* cq_ = nullptr;
+  grpc_server* server_ = nullptr;
+  grpc_channel* client_ = nullptr;
+  grpc_transport* server_transport_ = nullptr;
+  grpc_transport* client_transport_ = nullptr;
+};
+
+TEST_F(TransportTelemetryEnd2endTest, RecordsRpcsAndPings) {
+  constexpr size_t kResponseSize = 1024 * 1024;
+  grpc_call* c = grpc_channel_create_call(
+      client_, nullptr, GRPC_PROPAGATE_DEFAULTS, cq_,
+      grpc_slice_from_static_string("/foo"), nullptr,
+      grpc_timeout_seconds_to_deadline(30), nullptr);
+  ASSERT_NE(c, nullptr);
+  grpc_slice request_slice = grpc_slice_from_static_string("hello");
+  grpc_byte_buffer* request = grpc_raw_byte_buffer_create(&request_slice, 1);
+  grpc_metadata_array initial_metadata_recv;
+  grpc_metadata_array_init(&initial_metadata_recv);
+  grpc_metadata_array trailing_metadata_recv;
+  grpc_metadata_array_init(&trailing_metadata_recv);
+  grpc_status_code status;
+  grpc_slice details;
+  grpc_op ops[6];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_SEND_MESSAGE;
+  ops[1].data.send_message.send_message = request;
+  ops[2].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  ops[3].op = GRPC_OP_RECV_INITIAL_METADATA;
+  ops[3].data.recv_initial_metadata.recv_initial_metadata =
+      &initial_metadata_recv;
+  ops[4].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  ops[4].data.recv_status_on_client.trailing_metadata = &trailing_metadata_recv;
+  ops[4].data.recv_status_on_client.status = &status;
+  ops[4].data.recv_status_on_client.status_details = &details;
+  ASSERT_EQ(grpc_call_start_batch(c, ops, 5, Tag(1), nullptr), GRPC_CALL_OK);
+  grpc_call* s;
+  grpc_call_details call_details;
+  grpc_call_details_init(&call_details);
+  grpc_metadata_array request_metadata_recv;
+  grpc_metadata_array_init(&request_metadata_recv);
+  ASSERT_EQ(grpc_server_request_call(server_, &s, &call_details,
+                                     &request_metadata_recv, cq_, cq_,
+                                     Tag(101)),
+            GRPC_CALL_OK);
+  Expect({101});
+  // Send a response larger than the client's stream window, which stalls
+  // until the client starts reading it.
+  grpc_slice response_slice =
+      grpc_slice_from_cpp_string(std::string(kResponseSize, 'a'));
+  grpc_byte_buffer* response = grpc_raw_byte_buffer_create(&response_slice, 1);
+  grpc_byte_buffer* request_recv = nullptr;
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_SEND_MESSAGE;
+  ops[1].data.send_message.send_message = response;
+  ops[2].op = GRPC_OP_RECV_MESSAGE;
+  ops[2].data.recv_message.recv_message = &request_recv;
+  ASSERT_EQ(grpc_call_start_batch(s, ops, 3, Tag(102), nullptr), GRPC_CALL_OK);
+  const Duration stall = Duration::Milliseconds(500);
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(
+      stall.millis() * grpc_test_slowdown_factor()));
+  grpc_byte_buffer* response_recv = nullptr;
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_RECV_MESSAGE;
+  ops[0].data.recv_message.recv_message = &response_recv;
+  ASSERT_EQ(grpc_call_start_batch(c, ops, 1, Tag(2), nullptr), GRPC_CALL_OK);
+  Expect({2, 102});
+  int was_cancelled = 2;
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  ops[0].data.send_status_from_server.status = GRPC_STATUS_OK;
+  ops[1].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  ops[1].data.recv_close_on_server.cancelled = &was_cancelled;
+  ASSERT_EQ(grpc_call_start_batch(s, ops, 2, Tag(103), nullptr), GRPC_CALL_OK);
+  Expect({1, 103});
+  EXPECT_EQ(status, GRPC_STATUS_OK);
+  EXPECT_EQ(was_cancelled, 0);
+  ASSERT_NE(response_recv, nullptr);
+  EXPECT_EQ(grpc_byte_buffer_length(response_recv), kResponseSize);
+  // A PING from the client gives it an RTT sample.
+  grpc_channel_ping(client_, cq_, Tag(200), nullptr);
+  Expect({200});
+  const Http2TransportTelemetry client = CheckChannelz(client_transport_);
+  const Http2TransportTelemetry server = CheckChannelz(server_transport_);
+  EXPECT_GT(client.smoothed_rtt_us, 0);
+  // Both sides wrote their message, and the server wrote all of the
+  // response.
+  EXPECT_GT(client.writes, 0);
+  EXPECT_GT(client.bytes_written, 0);
+  EXPECT_GE(client.messages_written, 1);
+  EXPECT_GT(server.writes, 0);
+  EXPECT_GT(server.bytes_written, static_cast<int64_t>(kResponseSize));
+  EXPECT_GE(server.messages_written, 1);
+  EXPECT_GT(client.remote_window, 0);
+  EXPECT_GT(server.local_window, 0);
+  // The response was blocked by the client's window until the client read
+  // it.  It is first stalled by the transport or by the stream, depending on
+  // which window the client updates first, but the client only updates the
+  // stream window once it reads.
+  EXPECT_GT(server.stream_stalled_time, Duration::Zero());
+  EXPECT_GE(server.transport_stalled_time + server.stream_stalled_time,
+            stall / 2);
+  grpc_call_unref(c);
+  grpc_call_unref(s);
+  grpc_byte_buffer_destroy(request);
+  grpc_byte_buffer_destroy(request_recv);
+  grpc_byte_buffer_destroy(response);
+  grpc_byte_buffer_destroy(response_recv);
+  grpc_slice_unref(request_slice);
+  grpc_slice_unref(response_slice);
+  grpc_slice_unref(details);
+  grpc_metadata_array_destroy(&initial_metadata_recv);
+  grpc_metadata_array_destroy(&trailing_metadata_recv);
+  grpc_metadata_array_destroy(&request_metadata_recv);
+  grpc_call_details_destroy(&call_details);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,173 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmarks how long XdsClient takes to decode and apply a large EDS
+// response.  The response carries a fixed total number of endpoints,
+// split evenly across a varying number of ClusterLoadAssignment
+// resources, and is delivered over the fake xDS transport.
+
+#include <stddef.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/optional.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/xds/xds_bootstrap_grpc.h"
+#include "src/core/ext/xds/xds_client.h"
+#include "src/core/ext/xds/xds_endpoint.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/proto/grpc/testing/xds/v3/discovery.pb.h"
+#include "src/proto/grpc/testing/xds/v3/endpoint.pb.h"
+#include "test/core/xds/xds_transport_fake.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+constexpr size_t kNumEndpoints = 50000;
+constexpr size_t kEndpointsPerLocality = 100;
+
+constexpr char kBootstrap[] =
+    "{\"xds_servers\": [{\"server_uri\":\"xds.example.com:443\", "
+    "\"channel_creds\":[{\"type\": \"fake\"}]}]}";
+
+class EndpointWatcher : public XdsEndpointResourceType::WatcherInterface {
+ public:
+  void OnResourceChanged(XdsEndpointResource /*resource*/) override {}
+  void OnError(absl::Status status) override {
+    gpr_log(GPR_ERROR, "EDS watcher error: %s", status.ToString().c_str());
+  }
+  void OnResourceDoesNotExist() override {
+    gpr_log(GPR_ERROR, "EDS resource does not exist");
+  }
+};
+
+std::string ClusterName(size_t i) { return absl::StrCat("cluster", i); }
+
+// Builds a response with kNumEndpoints endpoints split across
+// num_resources resources.  The port is varied so that consecutive
+// responses are not identical to the cached resources.
+std::string BuildResponse(size_t num_resources, int port,
+                          absl::string_view nonce) {
+  envoy::service::discovery::v3::DiscoveryResponse response;
+  response.set_type_url(
+      "type.googleapis.com/envoy.config.endpoint.v3.ClusterLoadAssignment");
+  response.set_version_info(std::string(nonce));
+  response.set_nonce(std::string(nonce));
+  const size_t endpoints_per_resource = kNumEndpoints / num_resources;
+  size_t endpoint_index = 0;
+  for (size_t i = 0; i < num_resources; ++i) {
+    envoy::config::endpoint::v3::ClusterLoadAssignment resource;
+    resource.set_cluster_name(ClusterName(i));
+    envoy::config::endpoint::v3::LocalityLbEndpoints* locality = nullptr;
+    for (size_t j = 0; j < endpoints_per_resource; ++j, ++endpoint_index) {
+      if (j % kEndpointsPerLocality == 0) {
+        locality = resource.add_endpoints();
+        locality->mutable_locality()->set_region("region");
+        locality->mutable_locality()->set_zone(
+            absl::StrCat("zone", j / kEndpointsPerLocality));
+        locality->mutable_load_balancing_weight()->set_value(1);
+      }
+      auto* socket_address = locality->add_lb_endpoints()
+                                 ->mutable_endpoint()
+                                 ->mutable_address()
+                                 ->mutable_socket_address();
+      socket_address->set_address(absl::StrCat(
+          "10.", (endpoint_index >> 16) & 0xff, ".",
+          (endpoint_index >> 8) & 0xff, ".", endpoint_index & 0xff));
+      socket_address->set_port_value(port);
+    }
+    response.add_resources()->PackFrom(resource);
+  }
+  return response.SerializeAsString();
+}
+
+void BM_DecodeEdsResponse(benchmark::State& state) {
+  const size_t num_resources = state.range(0);
+  auto bootstrap = GrpcXdsBootstrap::Create(kBootstrap);
+  GPR_ASSERT(bootstrap.ok());
+  auto transport_factory = MakeOrphanable<FakeXdsTransportFactory>();
+  auto* transport_factory_ptr = transport_factory.get();
+  auto xds_client = MakeRefCounted<XdsClient>(
+      std::move(*bootstrap), std::move(transport_factory),
+      grpc_event_engine::experimental::GetDefaultEventEngine(),
+      "foo agent", "foo version");
+  std::vector<RefCountedPtr<EndpointWatcher>> watchers;
+  for (size_t i = 0; i < num_resources; ++i) {
+    watchers.push_back(MakeRefCounted<EndpointWatcher>());
+    XdsEndpointResourceType::StartWatch(xds_client.get(), ClusterName(i),
+                                        watchers.back());
+  }
+  auto stream = transport_factory_ptr->WaitForStream(
+      xds_client->bootstrap().server(), FakeXdsTransportFactory::kAdsMethod,
+      absl::Seconds(5));
+  GPR_ASSERT(stream != nullptr);
+  // Consume the subscription requests.
+  while (stream->WaitForMessageFromClient(absl::ZeroDuration()).has_value()) {
+  }
+  const std::string responses[] = {BuildResponse(num_resources, 443, "A"),
+                                   BuildResponse(num_resources, 444, "B")};
+  size_t i = 0;
+  for (auto _ : state) {
+    stream->SendMessageToClient(responses[i++ % 2]);
+    // Consume the ACK, which is sent once the response has been applied.
+    GPR_ASSERT(stream->WaitForMessageFromClient(absl::Seconds(5)).has_value());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumEndpoints);
+  state.SetBytesProcessed(state.iterations() * responses[0].size());
+  for (size_t j = 0; j < num_resources; ++j) {
+    XdsEndpointResourceType::CancelWatch(xds_client.get(), ClusterName(j),
+                                         watchers[j].get());
+  }
+}
+BENCHMARK(BM_DecodeEdsResponse)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(500)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  grpc_init();
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
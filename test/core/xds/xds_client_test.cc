@@ -67,6 +67,8 @@
 // IWYU pragma: no_include "google/protobuf/json/json.h"
 // IWYU pragma: no_include "google/protobuf/util/json_util.h"
 
+using envoy::service::discovery::v3::DeltaDiscoveryRequest;
+using envoy::service::discovery::v3::DeltaDiscoveryResponse;
 using envoy::service::discovery::v3::DiscoveryRequest;
 using envoy::service::discovery::v3::DiscoveryResponse;
 
@@ -126,10 +128,12 @@ class XdsClientTest : public ::testing::Test {
       bool IgnoreResourceDeletion() const override {
         return ignore_resource_deletion_;
       }
+      bool UseDeltaXds() const override { return use_delta_xds_; }
       bool Equals(const XdsServer& other) const override {
         const auto& o = static_cast<const FakeXdsServer&>(other);
         return server_uri_ == o.server_uri_ &&
-               ignore_resource_deletion_ == o.ignore_resource_deletion_;
+               ignore_resource_deletion_ == o.ignore_resource_deletion_ &&
+               use_delta_xds_ == o.use_delta_xds_;
       }
 
       void set_server_uri(std::string server_uri) {
@@ -138,10 +142,14 @@ class XdsClientTest : public ::testing::Test {
       void set_ignore_resource_deletion(bool ignore_resource_deletion) {
         ignore_resource_deletion_ = ignore_resource_deletion;
       }
+      void set_use_delta_xds(bool use_delta_xds) {
+        use_delta_xds_ = use_delta_xds;
+      }
 
      private:
       std::string server_uri_ = "default_xds_server";
       bool ignore_resource_deletion_ = false;
+      bool use_delta_xds_ = false;
     };
 
     class FakeAuthority : public Authority {
@@ -175,6 +183,10 @@ class XdsClientTest : public ::testing::Test {
         server_.set_ignore_resource_deletion(ignore_resource_deletion);
         return *this;
       }
+      Builder& set_use_delta_xds(bool use_delta_xds) {
+        server_.set_use_delta_xds(use_delta_xds);
+        return *this;
+      }
       std::unique_ptr<XdsBootstrap> Build() {
         auto bootstrap = std::make_unique<FakeXdsBootstrap>();
         bootstrap->server_ = std::move(server_);
@@ -559,6 +571,47 @@ class XdsClientTest : public ::testing::Test {
     DiscoveryResponse response_;
   };
 
+  // A helper class to build and serialize a DeltaDiscoveryResponse.
+  class DeltaResponseBuilder {
+   public:
+    explicit DeltaResponseBuilder(absl::string_view type_url) {
+      response_.set_type_url(absl::StrCat("type.googleapis.com/", type_url));
+    }
+
+    DeltaResponseBuilder& set_system_version_info(
+        absl::string_view system_version_info) {
+      response_.set_system_version_info(std::string(system_version_info));
+      return *this;
+    }
+    DeltaResponseBuilder& set_nonce(absl::string_view nonce) {
+      response_.set_nonce(std::string(nonce));
+      return *this;
+    }
+
+    DeltaResponseBuilder& AddFooResource(const XdsFooResource& resource,
+                                         absl::string_view version) {
+      auto* res = response_.add_resources();
+      res->set_name(resource.name);
+      res->set_version(std::string(version));
+      *res->mutable_resource() = XdsFooResourceType::EncodeAsAny(resource);
+      return *this;
+    }
+
+    DeltaResponseBuilder& AddRemovedResource(absl::string_view name) {
+      response_.add_removed_resources(std::string(name));
+      return *this;
+    }
+
+    std::string Serialize() {
+      std::string serialized_response;
+      EXPECT_TRUE(response_.SerializeToString(&serialized_response));
+      return serialized_response;
+    }
+
+   private:
+    DeltaDiscoveryResponse response_;
+  };
+
   // Sets transport_factory_ and initializes xds_client_ with the
   // specified bootstrap config.
   void InitXdsClient(
@@ -621,7 +674,9 @@ class XdsClientTest : public ::testing::Test {
     const auto* xds_server = xds_client_->bootstrap().FindXdsServer(server);
     GPR_ASSERT(xds_server != nullptr);
     return transport_factory_->WaitForStream(
-        *xds_server, FakeXdsTransportFactory::kAdsMethod,
+        *xds_server,
+        xds_server->UseDeltaXds() ? FakeXdsTransportFactory::kDeltaAdsMethod
+                                  : FakeXdsTransportFactory::kAdsMethod,
         timeout * grpc_test_slowdown_factor());
   }
 
@@ -654,6 +709,58 @@ class XdsClientTest : public ::testing::Test {
     return std::move(request);
   }
 
+  // Gets the latest delta request sent to the fake xDS server.
+  absl::optional<DeltaDiscoveryRequest> WaitForDeltaRequest(
+      FakeXdsTransportFactory::FakeStreamingCall* stream,
+      absl::Duration timeout = absl::Seconds(3),
+      SourceLocation location = SourceLocation()) {
+    auto message =
+        stream->WaitForMessageFromClient(timeout * grpc_test_slowdown_factor());
+    if (!message.has_value()) return absl::nullopt;
+    DeltaDiscoveryRequest request;
+    bool success = request.ParseFromString(*message);
+    EXPECT_TRUE(success) << "Failed to deserialize DeltaDiscoveryRequest at "
+                         << location.file() << ":" << location.line();
+    if (!success) return absl::nullopt;
+    return std::move(request);
+  }
+
+  // Helper function to check the fields of a DeltaDiscoveryRequest.
+  void CheckDeltaRequest(
+      const DeltaDiscoveryRequest& request, absl::string_view type_url,
+      absl::string_view response_nonce, absl::Status error_detail,
+      std::set<absl::string_view> subscribe,
+      std::set<absl::string_view> unsubscribe,
+      std::map<std::string, std::string> initial_resource_versions = {},
+      SourceLocation location = SourceLocation()) {
+    EXPECT_EQ(request.type_url(),
+              absl::StrCat("type.googleapis.com/", type_url))
+        << location.file() << ":" << location.line();
+    EXPECT_EQ(request.response_nonce(), response_nonce)
+        << location.file() << ":" << location.line();
+    if (error_detail.ok()) {
+      EXPECT_FALSE(request.has_error_detail())
+          << location.file() << ":" << location.line();
+    } else {
+      EXPECT_EQ(request.error_detail().code(),
+                static_cast<int>(error_detail.code()))
+          << location.file() << ":" << location.line();
+      EXPECT_EQ(request.error_detail().message(), error_detail.message())
+          << location.file() << ":" << location.line();
+    }
+    EXPECT_THAT(request.resource_names_subscribe(),
+                ::testing::UnorderedElementsAreArray(subscribe))
+        << location.file() << ":" << location.line();
+    EXPECT_THAT(request.resource_names_unsubscribe(),
+                ::testing::UnorderedElementsAreArray(unsubscribe))
+        << location.file() << ":" << location.line();
+    std::map<std::string, std::string> actual_initial_resource_versions(
+        request.initial_resource_versions().begin(),
+        request.initial_resource_versions().end());
+    EXPECT_EQ(actual_initial_resource_versions, initial_resource_versions)
+        << location.file() << ":" << location.line();
+  }
+
   // Helper function to check the fields of a DiscoveryRequest.
   void CheckRequest(const DiscoveryRequest& request, absl::string_view type_url,
                     absl::string_view version_info,
@@ -684,7 +791,8 @@ class XdsClientTest : public ::testing::Test {
 
   // Helper function to check the contents of the node message in a
   // request against the client's node info.
-  void CheckRequestNode(const DiscoveryRequest& request,
+  template <typename Request>
+  void CheckRequestNode(const Request& request,
                         SourceLocation location = SourceLocation()) {
     // These fields come from the bootstrap config.
     EXPECT_EQ(request.node().id(), xds_client_->bootstrap().node()->id())
@@ -2676,6 +2784,185 @@ TEST_F(XdsClientTest, FederationChannelFailureReportedToWatchers) {
   EXPECT_TRUE(stream2->Orphaned());
 }
 
+TEST_F(XdsClientTest, DeltaBasicWatch) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_xds(true));
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  // Watcher should initially not see any resource reported.
+  EXPECT_FALSE(watcher->HasEvent());
+  // XdsClient should have created a delta ADS stream.
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  // XdsClient should have sent a subscription request on the stream.
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*subscribe=*/{"foo1"}, /*unsubscribe=*/{});
+  CheckRequestNode(*request);  // Should be present on the first request.
+  // Send a response.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_system_version_info("1")
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6), "v1")
+          .Serialize());
+  // XdsClient should have delivered the response to the watcher.
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->name, "foo1");
+  EXPECT_EQ(resource->value, 6);
+  // XdsClient should have sent an ACK, which does not repeat the
+  // subscription.
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"A", /*error_detail=*/absl::OkStatus(),
+                    /*subscribe=*/{}, /*unsubscribe=*/{});
+  EXPECT_FALSE(request->has_node());
+  // Start a watch for "foo2".  Only the new name is sent.
+  auto watcher2 = StartFooWatch("foo2");
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*subscribe=*/{"foo2"}, /*unsubscribe=*/{});
+  // The server sends only the new resource.  The first watcher does not
+  // see an update.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_system_version_info("2")
+          .set_nonce("B")
+          .AddFooResource(XdsFooResource("foo2", 7), "v1")
+          .Serialize());
+  resource = watcher2->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->name, "foo2");
+  EXPECT_EQ(resource->value, 7);
+  EXPECT_FALSE(watcher->HasEvent());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"B", /*error_detail=*/absl::OkStatus(),
+                    /*subscribe=*/{}, /*unsubscribe=*/{});
+  // The server removes "foo1".
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_system_version_info("3")
+          .set_nonce("C")
+          .AddRemovedResource("foo1")
+          .Serialize());
+  EXPECT_TRUE(watcher->WaitForDoesNotExist(absl::Seconds(1)));
+  EXPECT_FALSE(watcher2->HasEvent());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"C", /*error_detail=*/absl::OkStatus(),
+                    /*subscribe=*/{}, /*unsubscribe=*/{});
+  // Cancel the watch for "foo2".  XdsClient unsubscribes from it.
+  CancelFooWatch(watcher2.get(), "foo2");
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*subscribe=*/{}, /*unsubscribe=*/{"foo2"});
+  // Cancel the last watch.
+  CancelFooWatch(watcher.get(), "foo1");
+  EXPECT_TRUE(stream->Orphaned());
+}
+
+TEST_F(XdsClientTest, DeltaResourceValidationFailure) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_xds(true));
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*subscribe=*/{"foo1"}, /*unsubscribe=*/{});
+  // Send a response containing an invalid resource.
+  DeltaDiscoveryResponse response;
+  response.set_type_url(absl::StrCat("type.googleapis.com/",
+                                     XdsFooResourceType::Get()->type_url()));
+  response.set_nonce("A");
+  auto* res = response.add_resources();
+  res->set_name("foo1");
+  res->set_version("v1");
+  res->mutable_resource()->set_type_url(absl::StrCat(
+      "type.googleapis.com/", XdsFooResourceType::Get()->type_url()));
+  res->mutable_resource()->set_value("{\"name\":\"foo1\",\"value\":[]}");
+  std::string serialized_response;
+  ASSERT_TRUE(response.SerializeToString(&serialized_response));
+  stream->SendMessageToClient(serialized_response);
+  // XdsClient should deliver an error to the watcher.
+  auto error = watcher->WaitForNextError();
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ(error->code(), absl::StatusCode::kUnavailable);
+  // XdsClient should NACK the update.
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(
+      *request, XdsFooResourceType::Get()->type_url(),
+      /*response_nonce=*/"A",
+      // error_detail=
+      absl::InvalidArgumentError(
+          "xDS response validation errors: ["
+          "resource index 0: foo1: INVALID_ARGUMENT: errors validating JSON: "
+          "[field:value error:is not a number]]"),
+      /*subscribe=*/{}, /*unsubscribe=*/{});
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+  EXPECT_TRUE(stream->Orphaned());
+}
+
+TEST_F(XdsClientTest, DeltaStreamRestartSendsInitialResourceVersions) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_xds(true));
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*subscribe=*/{"foo1"}, /*unsubscribe=*/{});
+  // Server sends a response.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6), "v3")
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->value, 6);
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"A", /*error_detail=*/absl::OkStatus(),
+                    /*subscribe=*/{}, /*unsubscribe=*/{});
+  // Now server closes the stream.
+  stream->MaybeSendStatusToClient(absl::OkStatus());
+  EXPECT_TRUE(stream->Orphaned());
+  // XdsClient should create a new stream and resubscribe, telling the
+  // server which version of the resource it already has.
+  stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*subscribe=*/{"foo1"}, /*unsubscribe=*/{},
+                    /*initial_resource_versions=*/{{"foo1", "v3"}});
+  CheckRequestNode(*request);  // Should be present on the first request.
+  // Watcher does not see an error or an update.
+  EXPECT_FALSE(watcher->HasEvent());
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+  EXPECT_TRUE(stream->Orphaned());
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
@@ -27,6 +27,7 @@
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/optional.h"
 #include "gtest/gtest.h"
@@ -45,6 +46,7 @@
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
 #include "src/core/lib/gprpp/crash.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/error.h"
@@ -91,10 +93,11 @@ class XdsEndpointTest : public ::testing::Test {
       Crash(absl::StrFormat("Error parsing bootstrap: %s",
                             bootstrap.status().ToString().c_str()));
     }
-    return MakeRefCounted<XdsClient>(std::move(*bootstrap),
-                                     /*transport_factory=*/nullptr,
-                                     /*event_engine=*/nullptr, "foo agent",
-                                     "foo version");
+    // The EventEngine is used to parse large resources in parallel.
+    return MakeRefCounted<XdsClient>(
+        std::move(*bootstrap), /*transport_factory=*/nullptr,
+        grpc_event_engine::experimental::GetDefaultEventEngine(), "foo agent",
+        "foo version");
   }
 
   RefCountedPtr<XdsClient> xds_client_;
@@ -722,6 +725,97 @@ TEST_F(XdsEndpointTest, DuplicateAddresses) {
       << decode_result.resource.status();
 }
 
+// Enough endpoints that they are parsed on multiple threads.
+TEST_F(XdsEndpointTest, ManyEndpoints) {
+  ClusterLoadAssignment cla;
+  cla.set_cluster_name("foo");
+  for (int i = 0; i < 3; ++i) {
+    auto* locality = cla.add_endpoints();
+    locality->mutable_load_balancing_weight()->set_value(1);
+    auto* locality_name = locality->mutable_locality();
+    locality_name->set_region(absl::StrCat("region", i));
+    for (int j = 0; j < 1000; ++j) {
+      auto* socket_address = locality->add_lb_endpoints()
+                                 ->mutable_endpoint()
+                                 ->mutable_address()
+                                 ->mutable_socket_address();
+      socket_address->set_address(absl::StrCat("10.0.", i, ".", j % 250));
+      socket_address->set_port_value(1000 + j);
+    }
+  }
+  std::string serialized_resource;
+  ASSERT_TRUE(cla.SerializeToString(&serialized_resource));
+  auto* resource_type = XdsEndpointResourceType::Get();
+  auto decode_result =
+      resource_type->Decode(decode_context_, serialized_resource);
+  ASSERT_TRUE(decode_result.resource.ok()) << decode_result.resource.status();
+  auto& resource = static_cast<XdsEndpointResource&>(**decode_result.resource);
+  ASSERT_EQ(resource.priorities.size(), 1);
+  ASSERT_EQ(resource.priorities[0].localities.size(), 3);
+  for (const auto& p : resource.priorities[0].localities) {
+    const auto& endpoints = p.second.endpoints;
+    ASSERT_EQ(endpoints.size(), 1000);
+    // Endpoints keep their order.
+    for (int j = 0; j < 1000; ++j) {
+      auto addr = grpc_sockaddr_to_string(&endpoints[j].address(),
+                                          /*normalize=*/false);
+      ASSERT_TRUE(addr.ok()) << addr.status();
+      EXPECT_EQ(*addr, absl::StrCat("10.0.", p.first->region().substr(6), ".",
+                                    j % 250, ":", 1000 + j));
+    }
+  }
+}
+
+TEST_F(XdsEndpointTest, ManyEndpointsWithErrors) {
+  ClusterLoadAssignment cla;
+  cla.set_cluster_name("foo");
+  for (int i = 0; i < 2; ++i) {
+    auto* locality = cla.add_endpoints();
+    locality->mutable_load_balancing_weight()->set_value(1);
+    auto* locality_name = locality->mutable_locality();
+    locality_name->set_region(absl::StrCat("region", i));
+    for (int j = 0; j < 1000; ++j) {
+      auto* socket_address = locality->add_lb_endpoints()
+                                 ->mutable_endpoint()
+                                 ->mutable_address()
+                                 ->mutable_socket_address();
+      socket_address->set_address(absl::StrCat("127.0.0.", i + 1));
+      socket_address->set_port_value(j);
+    }
+  }
+  // Give one endpoint an invalid port, and make the last endpoint of the
+  // second locality a duplicate of the first endpoint of the first.
+  cla.mutable_endpoints(0)
+      ->mutable_lb_endpoints(500)
+      ->mutable_endpoint()
+      ->mutable_address()
+      ->mutable_socket_address()
+      ->set_port_value(65536);
+  {
+    auto* socket_address = cla.mutable_endpoints(1)
+                               ->mutable_lb_endpoints(999)
+                               ->mutable_endpoint()
+                               ->mutable_address()
+                               ->mutable_socket_address();
+    socket_address->set_address("127.0.0.1");
+    socket_address->set_port_value(0);
+  }
+  std::string serialized_resource;
+  ASSERT_TRUE(cla.SerializeToString(&serialized_resource));
+  auto* resource_type = XdsEndpointResourceType::Get();
+  auto decode_result =
+      resource_type->Decode(decode_context_, serialized_resource);
+  EXPECT_EQ(decode_result.resource.status().code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(decode_result.resource.status().message(),
+            "errors parsing EDS resource: ["
+            "field:endpoints[0].lb_endpoints[500].endpoint.address"
+            ".socket_address.port_value error:invalid port; "
+            "field:endpoints[1].lb_endpoints[999] "
+            "error:duplicate endpoint address \"ipv4:127.0.0.1:0\"]")
+      << decode_result.resource.status();
+}
+
 TEST_F(XdsEndpointTest, DropConfig) {
   ClusterLoadAssignment cla;
   cla.set_cluster_name("foo");
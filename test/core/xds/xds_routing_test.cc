@@ -0,0 +1,202 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/xds/xds_routing.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/event_engine/memory_allocator.h>
+#include <grpc/grpc.h>
+
+#include "src/core/ext/xds/xds_route_config.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/matchers/matchers.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using Matchers = XdsRouteConfigResource::Route::Matchers;
+
+class RouteListIterator : public XdsRouting::RouteListIterator {
+ public:
+  explicit RouteListIterator(const std::vector<Matchers>* routes)
+      : routes_(routes) {}
+
+  size_t Size() const override { return routes_->size(); }
+
+  const Matchers& GetMatchersForRoute(size_t index) const override {
+    return (*routes_)[index];
+  }
+
+ private:
+  const std::vector<Matchers>* routes_;
+};
+
+Matchers PathMatchers(StringMatcher::Type type, absl::string_view path,
+                      bool case_sensitive = true) {
+  Matchers matchers;
+  matchers.path_matcher =
+      StringMatcher::Create(type, path, case_sensitive).value();
+  return matchers;
+}
+
+Matchers WithHeader(Matchers matchers, absl::string_view name,
+                    HeaderMatcher::Type type, absl::string_view value) {
+  matchers.header_matchers.push_back(
+      HeaderMatcher::Create(name, type, value, 0, 0,
+                            /*present_match=*/type ==
+                                HeaderMatcher::Type::kPresent)
+          .value());
+  return matchers;
+}
+
+class XdsRoutingRouteTableTest : public ::testing::Test {
+ protected:
+  XdsRoutingRouteTableTest()
+      : memory_allocator_(ResourceQuota::Default()
+                              ->memory_quota()
+                              ->CreateMemoryAllocator("test")),
+        arena_(MakeScopedArena(1024, &memory_allocator_)) {
+    routes_.push_back(WithHeader(
+        PathMatchers(StringMatcher::Type::kExact, "/svc.A/Get"), "x-env",
+        HeaderMatcher::Type::kExact, "canary"));
+    routes_.push_back(PathMatchers(StringMatcher::Type::kPrefix, "/svc.A/"));
+    routes_.push_back(
+        PathMatchers(StringMatcher::Type::kSafeRegex, "/svc\\.B/.*Stream"));
+    routes_.push_back(PathMatchers(StringMatcher::Type::kPrefix, "/SVC.C/",
+                                   /*case_sensitive=*/false));
+    routes_.push_back(PathMatchers(StringMatcher::Type::kSuffix, "/Check"));
+    routes_.push_back(
+        WithHeader(WithHeader(PathMatchers(StringMatcher::Type::kPrefix, ""),
+                              "x-env", HeaderMatcher::Type::kPresent, ""),
+                   "x-user", HeaderMatcher::Type::kPrefix, "admin"));
+    routes_.push_back(PathMatchers(StringMatcher::Type::kPrefix, "/"));
+  }
+
+  // Returns the route selected by both the linear search and the
+  // compiled table, after checking that they agree.
+  absl::optional<size_t> GetRoute(
+      const XdsRouting::RouteTable& table, absl::string_view path,
+      std::vector<std::pair<absl::string_view, absl::string_view>> headers) {
+    grpc_metadata_batch metadata(arena_.get());
+    for (const auto& header : headers) {
+      metadata.Append(header.first, Slice::FromCopiedString(header.second),
+                      [](absl::string_view, const Slice&) { abort(); });
+    }
+    auto expected = XdsRouting::GetRouteForRequest(RouteListIterator(&routes_),
+                                                   path, &metadata);
+    // Twice, to hit the path cache.
+    for (int i = 0; i < 2; ++i) {
+      EXPECT_EQ(table.GetRouteForRequest(path, &metadata), expected)
+          << path << " attempt " << i;
+    }
+    return expected;
+  }
+
+  MemoryAllocator memory_allocator_;
+  ScopedArenaPtr arena_;
+  std::vector<Matchers> routes_;
+};
+
+TEST_F(XdsRoutingRouteTableTest, MatchesLinearSearch) {
+  ExecCtx exec_ctx;
+  XdsRouting::RouteTable table((RouteListIterator(&routes_)));
+  EXPECT_EQ(GetRoute(table, "/svc.A/Get", {{"x-env", "canary"}}), 0);
+  EXPECT_EQ(GetRoute(table, "/svc.A/Get", {{"x-env", "prod"}}), 1);
+  EXPECT_EQ(GetRoute(table, "/svc.A/Put", {}), 1);
+  EXPECT_EQ(GetRoute(table, "/svc.B/BidiStream", {}), 2);
+  EXPECT_EQ(GetRoute(table, "/svc.B/Unary", {}), 6);
+  EXPECT_EQ(GetRoute(table, "/svc.c/Get", {}), 3);
+  EXPECT_EQ(GetRoute(table, "/svc.D/Check", {}), 4);
+  EXPECT_EQ(GetRoute(table, "/svc.D/Get", {{"x-env", "prod"}}), 6);
+  EXPECT_EQ(
+      GetRoute(table, "/svc.D/Get", {{"x-env", "prod"}, {"x-user", "admin1"}}),
+      5);
+  EXPECT_EQ(GetRoute(table, "svc.D/Get", {}), absl::nullopt);
+}
+
+TEST_F(XdsRoutingRouteTableTest, ZeroFractionNeverMatches) {
+  ExecCtx exec_ctx;
+  routes_[1].fraction_per_million = 0;
+  XdsRouting::RouteTable table((RouteListIterator(&routes_)));
+  EXPECT_EQ(GetRoute(table, "/svc.A/Put", {}), 6);
+}
+
+TEST_F(XdsRoutingRouteTableTest, ManyPaths) {
+  ExecCtx exec_ctx;
+  XdsRouting::RouteTable table((RouteListIterator(&routes_)));
+  // More paths than fit in the cache.
+  for (int i = 0; i < 1000; ++i) {
+    const std::string path = absl::StrCat("/svc.A/Method", i);
+    EXPECT_EQ(GetRoute(table, path, {}), 1);
+  }
+}
+
+TEST_F(XdsRoutingRouteTableTest, EvictsLeastRecentlyUsedPaths) {
+  // All lookups under one ExecCtx use the same shard of the path cache.
+  ExecCtx exec_ctx;
+  XdsRouting::RouteTable table((RouteListIterator(&routes_)));
+  const size_t kNumPaths = XdsRouting::RouteTable::kMaxCachedPathsPerShard;
+  auto path = [](size_t i) { return absl::StrCat("/svc.A/Method", i); };
+  for (size_t i = 0; i < kNumPaths; ++i) {
+    EXPECT_EQ(GetRoute(table, path(i), {}), 1);
+  }
+  for (size_t i = 0; i < kNumPaths; ++i) {
+    EXPECT_TRUE(table.TestOnlyIsPathCached(path(i))) << path(i);
+  }
+  // Use the oldest path again, so that the next one is evicted instead.
+  EXPECT_EQ(GetRoute(table, path(0), {}), 1);
+  EXPECT_EQ(GetRoute(table, path(kNumPaths), {}), 1);
+  EXPECT_TRUE(table.TestOnlyIsPathCached(path(0)));
+  EXPECT_FALSE(table.TestOnlyIsPathCached(path(1)));
+  for (size_t i = 2; i <= kNumPaths; ++i) {
+    EXPECT_TRUE(table.TestOnlyIsPathCached(path(i))) << path(i);
+  }
+  // An evicted path is recomputed and cached again.
+  EXPECT_EQ(GetRoute(table, path(1), {}), 1);
+  EXPECT_TRUE(table.TestOnlyIsPathCached(path(1)));
+  EXPECT_FALSE(table.TestOnlyIsPathCached(path(2)));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -229,6 +229,90 @@ TEST_P(XdsClientTest, XdsStreamErrorPropagation) {
               ::testing::HasSubstr("(node ID:xds_end2end_test)"));
 }
 
+//
+// DeltaXdsTest - tests of the incremental ADS protocol
+//
+
+class DeltaXdsTest : public XdsEnd2endTest {
+ protected:
+  void SetUp() override { InitClient(BootstrapBuilder().SetUseDeltaXds()); }
+};
+
+INSTANTIATE_TEST_SUITE_P(XdsTest, DeltaXdsTest,
+                         ::testing::Values(XdsTestType()), &XdsTestType::Name);
+
+// Tests that the client gets resources and their updates over a delta
+// stream.
+TEST_P(DeltaXdsTest, Vanilla) {
+  CreateAndStartBackends(2);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends(0, 1)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 0, 1);
+  EXPECT_EQ(1UL, balancer_->ads_service()->delta_stream_count());
+  // Make sure we ACKed each resource type.
+  auto response_state = balancer_->ads_service()->lds_response_state();
+  ASSERT_TRUE(response_state.has_value());
+  EXPECT_EQ(response_state->state, AdsServiceImpl::ResponseState::ACKED);
+  response_state = balancer_->ads_service()->cds_response_state();
+  ASSERT_TRUE(response_state.has_value());
+  EXPECT_EQ(response_state->state, AdsServiceImpl::ResponseState::ACKED);
+  response_state = balancer_->ads_service()->eds_response_state();
+  ASSERT_TRUE(response_state.has_value());
+  EXPECT_EQ(response_state->state, AdsServiceImpl::ResponseState::ACKED);
+  // The server sends only the updated EDS resource.
+  args = EdsResourceArgs({{"locality0", CreateEndpointsForBackends(1, 2)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 1, 2);
+}
+
+// Tests that a resource removed by the server is deleted on the client.
+TEST_P(DeltaXdsTest, ResourceRemoved) {
+  CreateAndStartBackends(1);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION);
+  // Unset CDS resource, which the server reports in removed_resources.
+  balancer_->ads_service()->UnsetResource(kCdsTypeUrl, kDefaultClusterName);
+  // Wait for RPCs to start failing.
+  SendRpcsUntil(DEBUG_LOCATION, [](const RpcResult& result) {
+    if (result.status.ok()) return true;  // Keep going.
+    EXPECT_EQ(StatusCode::UNAVAILABLE, result.status.error_code());
+    EXPECT_EQ(absl::StrCat("CDS resource \"", kDefaultClusterName,
+                           "\" does not exist"),
+              result.status.error_message());
+    return false;
+  });
+  // Recreate the CDS resource, and make sure the client uses it again.
+  balancer_->ads_service()->SetCdsResource(default_cluster_);
+  WaitForAllBackends(DEBUG_LOCATION);
+}
+
+// Tests that after a stream restart, the server sends only the resources
+// that changed since the client last got them.
+TEST_P(DeltaXdsTest, StreamRestartSendsOnlyChangedResources) {
+  CreateAndStartBackends(2);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends(0, 1)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 0, 1);
+  // Stop balancer, which also clears its response states.
+  balancer_->Shutdown();
+  // Update backend, so that the EDS resource has changed when the client
+  // reconnects.
+  args = EdsResourceArgs({{"locality0", CreateEndpointsForBackends(1, 2)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  // Restart balancer.
+  balancer_->Start();
+  WaitForAllBackends(DEBUG_LOCATION, 1, 2);
+  EXPECT_EQ(2UL, balancer_->ads_service()->delta_stream_count());
+  // The client reported the LDS and CDS resources it already had in
+  // initial_resource_versions, so they were not sent again.
+  auto response_state = balancer_->ads_service()->eds_response_state();
+  ASSERT_TRUE(response_state.has_value());
+  EXPECT_EQ(response_state->state, AdsServiceImpl::ResponseState::ACKED);
+  EXPECT_FALSE(balancer_->ads_service()->lds_response_state().has_value());
+  EXPECT_FALSE(balancer_->ads_service()->cds_response_state().has_value());
+}
+
 //
 // GlobalXdsClientTest - tests that need to run with a global XdsClient
 // (this is the default in production)
@@ -342,6 +342,9 @@ std::string XdsEnd2endTest::BootstrapBuilder::MakeXdsServersText(
   if (ignore_resource_deletion_) {
     server_features.push_back("\"ignore_resource_deletion\"");
   }
+  if (use_delta_xds_) {
+    server_features.push_back("\"delta_xds\"");
+  }
   return absl::StrReplaceAll(
       kXdsServerTemplate,
       {{"<SERVER_URI>", server_uri},
@@ -438,6 +438,10 @@ class XdsEnd2endTest : public ::testing::TestWithParam<XdsTestType> {
       ignore_resource_deletion_ = true;
       return *this;
     }
+    BootstrapBuilder& SetUseDeltaXds() {
+      use_delta_xds_ = true;
+      return *this;
+    }
     // If ignore_if_set is true, sets the default server only if it has
     // not already been set.
     BootstrapBuilder& SetDefaultServer(const std::string& server,
@@ -489,6 +493,7 @@ class XdsEnd2endTest : public ::testing::TestWithParam<XdsTestType> {
     std::string MakeAuthorityText();
 
     bool ignore_resource_deletion_ = false;
+    bool use_delta_xds_ = false;
     std::string top_server_;
     std::string client_default_listener_resource_name_template_;
     std::map<std::string /*key*/, PluginInfo> plugins_;
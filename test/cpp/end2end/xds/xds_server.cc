@@ -17,6 +17,9 @@
 #include "test/cpp/end2end/xds/xds_server.h"
 
 #include <deque>
+#include <functional>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <thread>
@@ -25,6 +28,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "absl/strings/numbers.h"
 #include "absl/types/optional.h"
 
 #include <grpc/support/log.h>
@@ -139,6 +143,231 @@ void AdsServiceImpl::ProcessUnsubscriptions(
   }
 }
 
+void AdsServiceImpl::RemoveSubscriptions(SubscriptionMap* subscription_map) {
+  for (auto& p : *subscription_map) {
+    const std::string& type_url = p.first;
+    SubscriptionNameMap& subscription_name_map = p.second;
+    for (auto& q : subscription_name_map) {
+      const std::string& resource_name = q.first;
+      SubscriptionState& subscription_state = q.second;
+      ResourceNameMap& resource_name_map =
+          resource_map_[type_url].resource_name_map;
+      ResourceState& resource_state = resource_name_map[resource_name];
+      resource_state.subscriptions.erase(&subscription_state);
+    }
+  }
+}
+
+Status AdsServiceImpl::DeltaAggregatedResources(ServerContext* context,
+                                                DeltaStream* stream) {
+  gpr_log(GPR_INFO, "ADS[%p]: DeltaAggregatedResources starts", this);
+  {
+    grpc_core::MutexLock lock(&ads_mu_);
+    if (forced_ads_failure_.has_value()) {
+      gpr_log(GPR_INFO,
+              "ADS[%p]: DeltaAggregatedResources forcing early failure "
+              "with status code: %d, message: %s",
+              this, forced_ads_failure_.value().error_code(),
+              forced_ads_failure_.value().error_message().c_str());
+      return forced_ads_failure_.value();
+    }
+    ++delta_stream_count_;
+  }
+  AddClient(context->peer());
+  // Keep the AdsServiceImpl alive until this stream is complete.
+  std::shared_ptr<AdsServiceImpl> ads_service_impl = shared_from_this();
+  // Resources (type/name pairs) that have changed since the client
+  // subscribed to them.
+  UpdateQueue update_queue;
+  // Resources that the client is subscribed to keyed by resource type url.
+  SubscriptionMap subscription_map;
+  // Sent state for each resource type.
+  std::map<std::string /*type_url*/, DeltaSentState> sent_state_map;
+  // Spawn a thread to read requests from the stream.
+  std::deque<DeltaDiscoveryRequest> requests;
+  bool stream_closed = false;
+  std::thread reader(std::bind(
+      &AdsServiceImpl::BlockingRead<DeltaDiscoveryResponse,
+                                    DeltaDiscoveryRequest>,
+      this, stream, &requests, &stream_closed));
+  // Main loop to process requests and updates, as in
+  // StreamAggregatedResources().
+  while (true) {
+    bool did_work = false;
+    absl::optional<DeltaDiscoveryResponse> response;
+    {
+      grpc_core::MutexLock lock(&ads_mu_);
+      if (stream_closed || ads_done_) break;
+      if (!requests.empty()) {
+        DeltaDiscoveryRequest request = std::move(requests.front());
+        requests.pop_front();
+        did_work = true;
+        gpr_log(GPR_INFO,
+                "ADS[%p]: Received delta request for type %s with content %s",
+                this, request.type_url().c_str(),
+                request.DebugString().c_str());
+        DeltaSentState& sent_state = sent_state_map[request.type_url()];
+        ProcessDeltaRequest(request, &update_queue, &subscription_map,
+                            &sent_state, &response);
+      }
+    }
+    if (response.has_value()) {
+      gpr_log(GPR_INFO, "ADS[%p]: Sending delta response: %s", this,
+              response->DebugString().c_str());
+      stream->Write(response.value());
+    }
+    response.reset();
+    {
+      grpc_core::MutexLock lock(&ads_mu_);
+      if (!update_queue.empty()) {
+        const std::string resource_type =
+            std::move(update_queue.front().first);
+        const std::string resource_name =
+            std::move(update_queue.front().second);
+        update_queue.pop_front();
+        did_work = true;
+        DeltaSentState& sent_state = sent_state_map[resource_type];
+        ProcessDeltaUpdate(resource_type, resource_name, &subscription_map,
+                           &sent_state, &response);
+      }
+    }
+    if (response.has_value()) {
+      gpr_log(GPR_INFO, "ADS[%p]: Sending delta update response: %s", this,
+              response->DebugString().c_str());
+      stream->Write(response.value());
+    }
+    {
+      grpc_core::MutexLock lock(&ads_mu_);
+      if (ads_done_) break;
+    }
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(did_work ? 0 : 10));
+  }
+  reader.join();
+  {
+    grpc_core::MutexLock lock(&ads_mu_);
+    RemoveSubscriptions(&subscription_map);
+  }
+  gpr_log(GPR_INFO, "ADS[%p]: DeltaAggregatedResources done", this);
+  RemoveClient(context->peer());
+  return Status::OK;
+}
+
+void AdsServiceImpl::ProcessDeltaRequest(
+    const DeltaDiscoveryRequest& request, UpdateQueue* update_queue,
+    SubscriptionMap* subscription_map, DeltaSentState* sent_state,
+    absl::optional<DeltaDiscoveryResponse>* response) {
+  // In delta xDS, the nonce is set only to ACK or NACK a response.
+  if (!request.response_nonce().empty()) {
+    ResponseState response_state;
+    if (!request.has_error_detail()) {
+      response_state.state = ResponseState::ACKED;
+      gpr_log(GPR_INFO, "ADS[%p]: client ACKed resource_type=%s nonce=%s",
+              this, request.type_url().c_str(),
+              request.response_nonce().c_str());
+    } else {
+      response_state.state = ResponseState::NACKED;
+      EXPECT_EQ(request.error_detail().code(), GRPC_STATUS_INVALID_ARGUMENT);
+      response_state.error_message = request.error_detail().message();
+      gpr_log(GPR_INFO,
+              "ADS[%p]: client NACKed resource_type=%s nonce=%s: %s", this,
+              request.type_url().c_str(), request.response_nonce().c_str(),
+              response_state.error_message.c_str());
+    }
+    resource_type_response_state_[request.type_url()].emplace_back(
+        std::move(response_state));
+  }
+  // Ignore resource types as requested by tests.
+  if (resource_types_to_ignore_.find(request.type_url()) !=
+      resource_types_to_ignore_.end()) {
+    return;
+  }
+  auto& subscription_name_map = (*subscription_map)[request.type_url()];
+  auto& resource_type_state = resource_map_[request.type_url()];
+  auto& resource_name_map = resource_type_state.resource_name_map;
+  // On a new stream, the client reports the resources it already has, so
+  // that they are not sent again if unchanged.
+  for (const auto& p : request.initial_resource_versions()) {
+    int version;
+    if (absl::SimpleAtoi(p.second, &version)) {
+      sent_state->resource_versions[p.first] = version;
+    }
+  }
+  for (const std::string& resource_name : request.resource_names_subscribe()) {
+    auto& subscription_state = subscription_name_map[resource_name];
+    auto& resource_state = resource_name_map[resource_name];
+    MaybeSubscribe(request.type_url(), resource_name, &subscription_state,
+                   &resource_state, update_queue);
+    MaybeAddDeltaResource(resource_name, resource_state, sent_state, response);
+  }
+  if (request.resource_names_unsubscribe_size() > 0) {
+    std::set<std::string> remaining_resources;
+    for (const auto& p : subscription_name_map) {
+      remaining_resources.insert(p.first);
+    }
+    for (const std::string& resource_name :
+         request.resource_names_unsubscribe()) {
+      remaining_resources.erase(resource_name);
+      sent_state->resource_versions.erase(resource_name);
+    }
+    ProcessUnsubscriptions(request.type_url(), remaining_resources,
+                           &subscription_name_map, &resource_name_map);
+  }
+  if (response->has_value()) {
+    (*response)->set_type_url(request.type_url());
+    (*response)->set_system_version_info(
+        std::to_string(resource_type_state.resource_type_version));
+    (*response)->set_nonce(std::to_string(++sent_state->nonce));
+  }
+}
+
+void AdsServiceImpl::ProcessDeltaUpdate(
+    const std::string& resource_type, const std::string& resource_name,
+    SubscriptionMap* subscription_map, DeltaSentState* sent_state,
+    absl::optional<DeltaDiscoveryResponse>* response) {
+  gpr_log(GPR_INFO, "ADS[%p]: Received delta update for type=%s name=%s",
+          this, resource_type.c_str(), resource_name.c_str());
+  auto& subscription_name_map = (*subscription_map)[resource_type];
+  if (subscription_name_map.find(resource_name) ==
+      subscription_name_map.end()) {
+    return;
+  }
+  auto& resource_type_state = resource_map_[resource_type];
+  MaybeAddDeltaResource(resource_name,
+                        resource_type_state.resource_name_map[resource_name],
+                        sent_state, response);
+  if (response->has_value()) {
+    (*response)->set_type_url(resource_type);
+    (*response)->set_system_version_info(
+        std::to_string(resource_type_state.resource_type_version));
+    (*response)->set_nonce(std::to_string(++sent_state->nonce));
+  }
+}
+
+void AdsServiceImpl::MaybeAddDeltaResource(
+    const std::string& resource_name, const ResourceState& resource_state,
+    DeltaSentState* sent_state,
+    absl::optional<DeltaDiscoveryResponse>* response) {
+  auto it = sent_state->resource_versions.find(resource_name);
+  if (resource_state.resource.has_value()) {
+    if (it != sent_state->resource_versions.end() &&
+        it->second == resource_state.resource_type_version) {
+      return;
+    }
+    if (!response->has_value()) response->emplace();
+    auto* resource = (*response)->add_resources();
+    resource->set_name(resource_name);
+    resource->set_version(std::to_string(resource_state.resource_type_version));
+    *resource->mutable_resource() = *resource_state.resource;
+    sent_state->resource_versions[resource_name] =
+        resource_state.resource_type_version;
+  } else {
+    if (it == sent_state->resource_versions.end()) return;
+    if (!response->has_value()) response->emplace();
+    (*response)->add_removed_resources(resource_name);
+    sent_state->resource_versions.erase(it);
+  }
+}
+
 void AdsServiceImpl::Start() {
   grpc_core::MutexLock lock(&ads_mu_);
   ads_done_ = false;
@@ -18,9 +18,11 @@
 #define GRPC_TEST_CPP_END2END_XDS_XDS_SERVER_H
 
 #include <deque>
+#include <map>
 #include <set>
 #include <string>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -174,6 +176,12 @@ class AdsServiceImpl
     forced_ads_failure_ = std::move(status);
   }
 
+  // Returns the number of delta ADS streams that have been started.
+  size_t delta_stream_count() {
+    grpc_core::MutexLock lock(&ads_mu_);
+    return delta_stream_count_;
+  }
+
  private:
   // A queue of resource type/name pairs that have changed since the client
   // subscribed to them.
@@ -198,6 +206,14 @@ class AdsServiceImpl
     int resource_type_version = 0;
   };
 
+  // Sent state for a given resource type on a delta stream.
+  struct DeltaSentState {
+    int nonce = 0;
+    // The version of each resource that the client has, as last sent to
+    // it or reported in initial_resource_versions.
+    std::map<std::string /* resource_name */, int> resource_versions;
+  };
+
   // A struct representing the current state for an individual resource.
   struct ResourceState {
     // The resource itself, if present.
@@ -222,6 +238,12 @@ class AdsServiceImpl
   using DiscoveryRequest = ::envoy::service::discovery::v3::DiscoveryRequest;
   using DiscoveryResponse = ::envoy::service::discovery::v3::DiscoveryResponse;
   using Stream = ServerReaderWriter<DiscoveryResponse, DiscoveryRequest>;
+  using DeltaDiscoveryRequest =
+      ::envoy::service::discovery::v3::DeltaDiscoveryRequest;
+  using DeltaDiscoveryResponse =
+      ::envoy::service::discovery::v3::DeltaDiscoveryResponse;
+  using DeltaStream =
+      ServerReaderWriter<DeltaDiscoveryResponse, DeltaDiscoveryRequest>;
 
   Status StreamAggregatedResources(ServerContext* context,
                                    Stream* stream) override {
@@ -254,8 +276,10 @@ class AdsServiceImpl
     // Requests will be delivered to this thread in a queue.
     std::deque<DiscoveryRequest> requests;
     bool stream_closed = false;
-    std::thread reader(std::bind(&AdsServiceImpl::BlockingRead, this, stream,
-                                 &requests, &stream_closed));
+    std::thread reader(
+        std::bind(&AdsServiceImpl::BlockingRead<DiscoveryResponse,
+                                                DiscoveryRequest>,
+                  this, stream, &requests, &stream_closed));
     // Main loop to process requests and updates.
     while (true) {
       // Boolean to keep track if the loop received any work to do: a
@@ -327,24 +351,20 @@ class AdsServiceImpl
     // finished.
     {
       grpc_core::MutexLock lock(&ads_mu_);
-      for (auto& p : subscription_map) {
-        const std::string& type_url = p.first;
-        SubscriptionNameMap& subscription_name_map = p.second;
-        for (auto& q : subscription_name_map) {
-          const std::string& resource_name = q.first;
-          SubscriptionState& subscription_state = q.second;
-          ResourceNameMap& resource_name_map =
-              resource_map_[type_url].resource_name_map;
-          ResourceState& resource_state = resource_name_map[resource_name];
-          resource_state.subscriptions.erase(&subscription_state);
-        }
-      }
+      RemoveSubscriptions(&subscription_map);
     }
     gpr_log(GPR_INFO, "ADS[%p]: StreamAggregatedResources done", this);
     RemoveClient(context->peer());
     return Status::OK;
   }
 
+  // Implements the incremental ADS protocol.  Unlike
+  // StreamAggregatedResources(), each response carries only the resources
+  // that changed, each with its own version, and deleted resources are
+  // listed explicitly.
+  Status DeltaAggregatedResources(ServerContext* context,
+                                  DeltaStream* stream) override;
+
   // Processes a response read from the client.
   // Populates response if needed.
   void ProcessRequest(const DiscoveryRequest& request,
@@ -490,18 +510,53 @@ class AdsServiceImpl
     }
   }
 
+  // Processes a delta request read from the client.
+  // Populates response if needed.
+  void ProcessDeltaRequest(const DeltaDiscoveryRequest& request,
+                           UpdateQueue* update_queue,
+                           SubscriptionMap* subscription_map,
+                           DeltaSentState* sent_state,
+                           absl::optional<DeltaDiscoveryResponse>* response)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(ads_mu_);
+
+  // Processes a resource update from the test on a delta stream.
+  // Populates response if needed.
+  void ProcessDeltaUpdate(const std::string& resource_type,
+                          const std::string& resource_name,
+                          SubscriptionMap* subscription_map,
+                          DeltaSentState* sent_state,
+                          absl::optional<DeltaDiscoveryResponse>* response)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(ads_mu_);
+
+  // Adds the resource to response if the client does not have its current
+  // version, or adds it to removed_resources if it was deleted since it
+  // was sent to the client.
+  static void MaybeAddDeltaResource(
+      const std::string& resource_name, const ResourceState& resource_state,
+      DeltaSentState* sent_state,
+      absl::optional<DeltaDiscoveryResponse>* response);
+
   // Starting a thread to do blocking read on the stream until cancel.
-  void BlockingRead(Stream* stream, std::deque<DiscoveryRequest>* requests,
-                    bool* stream_closed) {
-    DiscoveryRequest request;
+  template <typename Response, typename Request>
+  void BlockingRead(ServerReaderWriter<Response, Request>* stream,
+                    std::deque<Request>* requests, bool* stream_closed) {
+    Request request;
     bool seen_first_request = false;
     while (stream->Read(&request)) {
       if (!seen_first_request) {
         EXPECT_TRUE(request.has_node());
-        EXPECT_THAT(request.node().client_features(),
-                    ::testing::UnorderedElementsAre(
-                        "envoy.lb.does_not_support_overprovisioning",
-                        "xds.config.resource-in-sotw"));
+        // Resource wrappers are always used in delta responses, so the
+        // client advertises support for them only in state-of-the-world.
+        if (std::is_same<Request, DeltaDiscoveryRequest>::value) {
+          EXPECT_THAT(request.node().client_features(),
+                      ::testing::UnorderedElementsAre(
+                          "envoy.lb.does_not_support_overprovisioning"));
+        } else {
+          EXPECT_THAT(request.node().client_features(),
+                      ::testing::UnorderedElementsAre(
+                          "envoy.lb.does_not_support_overprovisioning",
+                          "xds.config.resource-in-sotw"));
+        }
         seen_first_request = true;
       }
       {
@@ -568,6 +623,10 @@ class AdsServiceImpl
       SubscriptionNameMap* subscription_name_map,
       ResourceNameMap* resource_name_map);
 
+  // Removes all of a stream's subscriptions when the stream ends.
+  void RemoveSubscriptions(SubscriptionMap* subscription_map)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(ads_mu_);
+
   void AddClient(const std::string& client) {
     grpc_core::MutexLock lock(&clients_mu_);
     clients_.insert(client);
@@ -596,6 +655,7 @@ class AdsServiceImpl
   absl::optional<Status> forced_ads_failure_ ABSL_GUARDED_BY(ads_mu_);
   bool wrap_resources_ ABSL_GUARDED_BY(ads_mu_) = false;
   std::string inject_bad_resources_for_resource_type_ ABSL_GUARDED_BY(ads_mu_);
+  size_t delta_stream_count_ ABSL_GUARDED_BY(ads_mu_) = 0;
 
   grpc_core::Mutex clients_mu_;
   std::set<std::string> clients_ ABSL_GUARDED_BY(clients_mu_);
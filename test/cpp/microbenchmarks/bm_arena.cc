@@ -33,9 +33,11 @@ static void BM_Arena_NoOp(benchmark::State& state) {
       grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
                                      ->memory_quota()
                                      ->CreateMemoryAllocator("test"));
+  PerfCounters perf_counters;
   for (auto _ : state) {
     Arena::Create(state.range(0), &memory_allocator)->Destroy();
   }
+  perf_counters.Finish(state);
 }
 BENCHMARK(BM_Arena_NoOp)->Range(1, 1024 * 1024);
 
@@ -47,6 +49,7 @@ static void BM_Arena_ManyAlloc(benchmark::State& state) {
   Arena* a = Arena::Create(state.range(0), &memory_allocator);
   const size_t realloc_after =
       1024 * 1024 * 1024 / ((state.range(1) + 15) & 0xffffff0u);
+  PerfCounters perf_counters;
   while (state.KeepRunning()) {
     a->Alloc(state.range(1));
     // periodically recreate arena to avoid OOM
@@ -55,6 +58,7 @@ static void BM_Arena_ManyAlloc(benchmark::State& state) {
       a = Arena::Create(state.range(0), &memory_allocator);
     }
   }
+  perf_counters.Finish(state);
   a->Destroy();
 }
 BENCHMARK(BM_Arena_ManyAlloc)->Ranges({{1, 1024 * 1024}, {1, 32 * 1024}});
@@ -64,6 +68,7 @@ static void BM_Arena_Batch(benchmark::State& state) {
       grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
                                      ->memory_quota()
                                      ->CreateMemoryAllocator("test"));
+  PerfCounters perf_counters;
   for (auto _ : state) {
     Arena* a = Arena::Create(state.range(0), &memory_allocator);
     for (int i = 0; i < state.range(1); i++) {
@@ -71,6 +76,7 @@ static void BM_Arena_Batch(benchmark::State& state) {
     }
     a->Destroy();
   }
+  perf_counters.Finish(state);
 }
 BENCHMARK(BM_Arena_Batch)->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
 
@@ -87,9 +93,11 @@ static void BM_Arena_MakePooled_Small(benchmark::State& state) {
                                      ->memory_quota()
                                      ->CreateMemoryAllocator("test"));
   Arena* a = Arena::Create(1024, &memory_allocator);
+  PerfCounters perf_counters;
   for (auto _ : state) {
     a->MakePooled<TestThingToAllocate>();
   }
+  perf_counters.Finish(state);
   a->Destroy();
 }
 BENCHMARK(BM_Arena_MakePooled_Small);
@@ -100,19 +108,23 @@ static void BM_Arena_MakePooled3_Small(benchmark::State& state) {
                                      ->memory_quota()
                                      ->CreateMemoryAllocator("test"));
   Arena* a = Arena::Create(1024, &memory_allocator);
+  PerfCounters perf_counters;
   for (auto _ : state) {
     auto x = a->MakePooled<TestThingToAllocate>();
     auto y = a->MakePooled<TestThingToAllocate>();
     auto z = a->MakePooled<TestThingToAllocate>();
   }
+  perf_counters.Finish(state);
   a->Destroy();
 }
 BENCHMARK(BM_Arena_MakePooled3_Small);
 
 static void BM_Arena_NewDeleteComparison_Small(benchmark::State& state) {
+  PerfCounters perf_counters;
   for (auto _ : state) {
     benchmark::DoNotOptimize(std::make_unique<TestThingToAllocate>());
   }
+  perf_counters.Finish(state);
 }
 BENCHMARK(BM_Arena_NewDeleteComparison_Small);
 
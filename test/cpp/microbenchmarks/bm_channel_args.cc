@@ -20,6 +20,8 @@
 #include <benchmark/benchmark.h>
 
 #include "absl/container/btree_map.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
 
 #include <grpcpp/support/channel_arguments.h>
 
@@ -82,6 +84,76 @@ void BM_ChannelArgsAsKeyIntoBTree(benchmark::State& state) {
 }
 BENCHMARK(BM_ChannelArgsAsKeyIntoBTree);
 
+// Args that look like those of a subchannel: a few dozen keys that
+// differ only in the value of the last one.
+grpc_core::ChannelArgs MakeSubchannelLikeArgs(int i) {
+  grpc_core::ChannelArgs args;
+  for (int j = 0; j < 30; j++) {
+    args = args.Set(absl::StrCat("grpc.some_arg_", j), kValue);
+  }
+  return args.Set("grpc.zzz", i);
+}
+
+void BM_ChannelArgsEquality(benchmark::State& state) {
+  auto arg1 = MakeSubchannelLikeArgs(0);
+  auto arg2 = MakeSubchannelLikeArgs(0);
+  for (auto s : state) {
+    benchmark::DoNotOptimize(arg1 == arg2);
+  }
+}
+BENCHMARK(BM_ChannelArgsEquality);
+
+void BM_InternedChannelArgsEquality(benchmark::State& state) {
+  auto arg1 = MakeSubchannelLikeArgs(0).Intern();
+  auto arg2 = MakeSubchannelLikeArgs(0).Intern();
+  for (auto s : state) {
+    benchmark::DoNotOptimize(arg1 == arg2);
+  }
+}
+BENCHMARK(BM_InternedChannelArgsEquality);
+
+void BM_ChannelArgsIntern(benchmark::State& state) {
+  // Keeps the interned copy alive, as a subchannel would.
+  auto interned = MakeSubchannelLikeArgs(0).Intern();
+  auto args = MakeSubchannelLikeArgs(0);
+  for (auto s : state) {
+    benchmark::DoNotOptimize(args.Intern());
+  }
+}
+BENCHMARK(BM_ChannelArgsIntern);
+
+void BM_SubchannelLikeArgsAsKeyIntoMap(benchmark::State& state) {
+  std::map<grpc_core::ChannelArgs, int> m;
+  std::vector<grpc_core::ChannelArgs> v;
+  for (int i = 0; i < 10000; i++) {
+    const auto& a = MakeSubchannelLikeArgs(i);
+    m[a] = i;
+    v.push_back(a);
+  }
+  std::shuffle(v.begin(), v.end(), std::mt19937(std::random_device()()));
+  size_t n = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(m.find(v[n++ % v.size()]));
+  }
+}
+BENCHMARK(BM_SubchannelLikeArgsAsKeyIntoMap);
+
+void BM_InternedChannelArgsAsKeyIntoHashMap(benchmark::State& state) {
+  absl::flat_hash_map<grpc_core::ChannelArgs, int> m;
+  std::vector<grpc_core::ChannelArgs> v;
+  for (int i = 0; i < 10000; i++) {
+    const auto& a = MakeSubchannelLikeArgs(i).Intern();
+    m[a] = i;
+    v.push_back(a);
+  }
+  std::shuffle(v.begin(), v.end(), std::mt19937(std::random_device()()));
+  size_t n = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(m.find(v[n++ % v.size()]));
+  }
+}
+BENCHMARK(BM_InternedChannelArgsAsKeyIntoHashMap);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -0,0 +1,126 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+// Measures the throughput of channelz node registration, alone and while
+// another thread keeps paging through the registry as a channelz client
+// would.
+
+#include <atomic>
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/channel/channelz_registry.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+
+namespace {
+
+// Number of channels and servers in the registry while benchmarking.
+constexpr int kNumChannels = 500;
+constexpr int kNumServers = 50;
+
+// Keeps querying the registry on a separate thread until destroyed.
+class QueryThread final {
+ public:
+  QueryThread() : thread_(&QueryThread::Run, this) {}
+
+  ~QueryThread() {
+    done_.store(true, std::memory_order_relaxed);
+    thread_.join();
+  }
+
+  int64_t queries() const { return queries_.load(std::memory_order_relaxed); }
+
+ private:
+  void Run() {
+    grpc_core::ExecCtx exec_ctx;
+    while (!done_.load(std::memory_order_relaxed)) {
+      benchmark::DoNotOptimize(
+          grpc_core::channelz::ChannelzRegistry::GetTopChannels(0));
+      benchmark::DoNotOptimize(
+          grpc_core::channelz::ChannelzRegistry::GetServers(0));
+      queries_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<bool> done_{false};
+  std::atomic<int64_t> queries_{0};
+  std::thread thread_;
+};
+
+using grpc_core::MakeRefCounted;
+using grpc_core::RefCountedPtr;
+using grpc_core::channelz::BaseNode;
+using grpc_core::channelz::ChannelNode;
+using grpc_core::channelz::ListenSocketNode;
+using grpc_core::channelz::ServerNode;
+
+void RunRegisterUnregister(benchmark::State& state, bool query) {
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<RefCountedPtr<BaseNode>> nodes;
+  std::unique_ptr<QueryThread> query_thread;
+  if (state.thread_index() == 0) {
+    for (int i = 0; i < kNumChannels; ++i) {
+      nodes.push_back(MakeRefCounted<ChannelNode>(
+          absl::StrCat("dns:///target", i), /*channel_tracer_max_nodes=*/0,
+          /*is_internal_channel=*/false));
+    }
+    for (int i = 0; i < kNumServers; ++i) {
+      nodes.push_back(
+          MakeRefCounted<ServerNode>(/*channel_tracer_max_nodes=*/0));
+    }
+    if (query) query_thread = std::make_unique<QueryThread>();
+  }
+  for (auto _ : state) {
+    // Sockets are the nodes that come and go most often.
+    MakeRefCounted<ListenSocketNode>("ipv4:127.0.0.1:1234", "listener");
+  }
+  if (query_thread != nullptr) {
+    const int64_t queries = query_thread->queries();
+    query_thread.reset();
+    state.counters["queries"] = queries;
+  }
+}
+
+void BM_RegisterUnregister(benchmark::State& state) {
+  RunRegisterUnregister(state, /*query=*/false);
+}
+BENCHMARK(BM_RegisterUnregister)->ThreadRange(1, 32);
+
+void BM_RegisterUnregisterWhileQuerying(benchmark::State& state) {
+  RunRegisterUnregister(state, /*query=*/true);
+}
+BENCHMARK(BM_RegisterUnregisterWhileQuerying)->ThreadRange(1, 32);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc::testing::TestGrpcScope grpc_scope;
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -82,6 +82,7 @@ static void BM_HpackEncoderEncodeDeadline(benchmark::State& state) {
   stats = {};
   grpc_slice_buffer outbuf;
   grpc_slice_buffer_init(&outbuf);
+  PerfCounters perf_counters;
   while (state.KeepRunning()) {
     c.EncodeHeaders(
         grpc_core::HPackCompressor::EncodeHeaderOptions{
@@ -95,6 +96,7 @@ static void BM_HpackEncoderEncodeDeadline(benchmark::State& state) {
     grpc_slice_buffer_reset_and_unref(&outbuf);
     grpc_core::ExecCtx::Get()->Flush();
   }
+  perf_counters.Finish(state);
   grpc_slice_buffer_destroy(&outbuf);
 }
 BENCHMARK(BM_HpackEncoderEncodeDeadline);
@@ -117,6 +119,7 @@ static void BM_HpackEncoderEncodeHeader(benchmark::State& state) {
   stats = {};
   grpc_slice_buffer outbuf;
   grpc_slice_buffer_init(&outbuf);
+  PerfCounters perf_counters;
   while (state.KeepRunning()) {
     static constexpr int kEnsureMaxFrameAtLeast = 2;
     c.EncodeHeaders(
@@ -139,6 +142,7 @@ static void BM_HpackEncoderEncodeHeader(benchmark::State& state) {
     grpc_slice_buffer_reset_and_unref(&outbuf);
     grpc_core::ExecCtx::Get()->Flush();
   }
+  perf_counters.Finish(state);
   grpc_slice_buffer_destroy(&outbuf);
 }
 
@@ -361,6 +365,7 @@ static void BM_HpackParserParseHeader(benchmark::State& state) {
     }
   };
   parse_vec(init_slices);
+  PerfCounters perf_counters;
   while (state.KeepRunning()) {
     b->Clear();
     parse_vec(benchmark_slices);
@@ -379,6 +384,7 @@ static void BM_HpackParserParseHeader(benchmark::State& state) {
                        1, grpc_core::HPackParser::LogInfo::kHeaders, false});
     }
   }
+  perf_counters.Finish(state);
   // Clean up
   b.Destroy();
   for (auto slice : init_slices) grpc_slice_unref(slice);
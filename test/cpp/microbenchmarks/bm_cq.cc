@@ -80,6 +80,7 @@ class PhonyTag final : public internal::CompletionQueueTag {
 static void BM_Pass1Cpp(benchmark::State& state) {
   CompletionQueue cq;
   grpc_completion_queue* c_cq = cq.cq();
+  PerfCounters perf_counters;
   for (auto _ : state) {
     grpc_cq_completion completion;
     PhonyTag phony_tag;
@@ -92,6 +93,7 @@ static void BM_Pass1Cpp(benchmark::State& state) {
     bool ok;
     cq.Next(&tag, &ok);
   }
+  perf_counters.Finish(state);
 }
 BENCHMARK(BM_Pass1Cpp);
 
@@ -99,6 +101,7 @@ static void BM_Pass1Core(benchmark::State& state) {
   // TODO(sreek): Templatize this benchmark and pass polling_type as a param
   grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  PerfCounters perf_counters;
   for (auto _ : state) {
     grpc_cq_completion completion;
     grpc_core::ExecCtx exec_ctx;
@@ -108,6 +111,7 @@ static void BM_Pass1Core(benchmark::State& state) {
 
     grpc_completion_queue_next(cq, deadline, nullptr);
   }
+  perf_counters.Finish(state);
   grpc_completion_queue_destroy(cq);
 }
 BENCHMARK(BM_Pass1Core);
@@ -116,6 +120,7 @@ static void BM_Pluck1Core(benchmark::State& state) {
   // TODO(sreek): Templatize this benchmark and pass polling_type as a param
   grpc_completion_queue* cq = grpc_completion_queue_create_for_pluck(nullptr);
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  PerfCounters perf_counters;
   for (auto _ : state) {
     grpc_cq_completion completion;
     grpc_core::ExecCtx exec_ctx;
@@ -125,6 +130,7 @@ static void BM_Pluck1Core(benchmark::State& state) {
 
     grpc_completion_queue_pluck(cq, nullptr, deadline, nullptr);
   }
+  perf_counters.Finish(state);
   grpc_completion_queue_destroy(cq);
 }
 BENCHMARK(BM_Pluck1Core);
@@ -133,9 +139,11 @@ static void BM_EmptyCore(benchmark::State& state) {
   // TODO(sreek): Templatize this benchmark and pass polling_type as a param
   grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
   gpr_timespec deadline = gpr_inf_past(GPR_CLOCK_MONOTONIC);
+  PerfCounters perf_counters;
   for (auto _ : state) {
     grpc_completion_queue_next(cq, deadline, nullptr);
   }
+  perf_counters.Finish(state);
   grpc_completion_queue_destroy(cq);
 }
 BENCHMARK(BM_EmptyCore);
@@ -0,0 +1,139 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+// Measures the per-call cost of per-method stats, end to end as in
+// bm_opencensus_plugin, and for recording alone.
+
+#include <string>
+#include <thread>  // NOLINT
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpcpp/grpcpp.h>
+
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/method_stats.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+
+class EchoServer final : public grpc::testing::EchoTestService::Service {
+  grpc::Status Echo(grpc::ServerContext* /*context*/,
+                    const grpc::testing::EchoRequest* request,
+                    grpc::testing::EchoResponse* response) override {
+    response->set_message(request->message());
+    return grpc::Status::OK;
+  }
+};
+
+// An EchoServerThread object creates an EchoServer on a separate thread and
+// shuts down the server and thread when it goes out of scope.
+class EchoServerThread final {
+ public:
+  explicit EchoServerThread(bool method_stats) {
+    grpc::ServerBuilder builder;
+    int port;
+    builder.AddListeningPort("[::]:0", grpc::InsecureServerCredentials(),
+                             &port);
+    builder.AddChannelArgument(GRPC_ARG_ENABLE_METHOD_STATS, method_stats);
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    if (server_ == nullptr || port == 0) {
+      std::abort();
+    }
+    server_address_ = absl::StrCat("[::]:", port);
+    server_thread_ = std::thread(&EchoServerThread::RunServerLoop, this);
+  }
+
+  ~EchoServerThread() {
+    server_->Shutdown();
+    server_thread_.join();
+  }
+
+  const std::string& address() { return server_address_; }
+
+ private:
+  void RunServerLoop() { server_->Wait(); }
+
+  std::string server_address_;
+  EchoServer service_;
+  std::unique_ptr<grpc::Server> server_;
+  std::thread server_thread_;
+};
+
+static void RunE2eLatency(benchmark::State& state, bool method_stats) {
+  grpc_core::CoreConfiguration::Reset();
+  grpc::testing::TestGrpcScope grpc_scope;
+  EchoServerThread server(method_stats);
+  grpc::ChannelArguments args;
+  args.SetInt(GRPC_ARG_ENABLE_METHOD_STATS, method_stats);
+  std::unique_ptr<grpc::testing::EchoTestService::Stub> stub =
+      grpc::testing::EchoTestService::NewStub(grpc::CreateCustomChannel(
+          server.address(), grpc::InsecureChannelCredentials(), args));
+
+  grpc::testing::EchoResponse response;
+  for (auto _ : state) {
+    grpc::testing::EchoRequest request;
+    grpc::ClientContext context;
+    grpc::Status status = stub->Echo(&context, request, &response);
+  }
+}
+
+static void BM_E2eLatencyMethodStatsDisabled(benchmark::State& state) {
+  RunE2eLatency(state, false);
+}
+BENCHMARK(BM_E2eLatencyMethodStatsDisabled);
+
+static void BM_E2eLatencyMethodStatsEnabled(benchmark::State& state) {
+  RunE2eLatency(state, true);
+}
+BENCHMARK(BM_E2eLatencyMethodStatsEnabled);
+
+// What each call pays on each side: looking up its collector in the
+// channel's cache and recording to it.
+static void BM_RecordCall(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  static grpc_core::MethodStatsCollectorCache* collectors =
+      new grpc_core::MethodStatsCollectorCache("dns:///localhost:1234");
+  for (auto _ : state) {
+    collectors->Get("/grpc.testing.EchoTestService/Echo")
+        ->RecordCall(/*failed=*/false, 150, 100, 100);
+  }
+}
+BENCHMARK(BM_RecordCall)->ThreadRange(1, 32);
+
+// The registry lookup the cache avoids.
+static void BM_RegistryLookup(benchmark::State& state) {
+  auto& registry = grpc_core::MethodStatsRegistry::Get();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(registry.GetCollector(
+        "dns:///localhost:1234", "/grpc.testing.EchoTestService/Echo"));
+  }
+}
+BENCHMARK(BM_RegistryLookup)->ThreadRange(1, 32);
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,322 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+// Benchmark the promise primitives that the promise based call path is
+// built from, in isolation from channels and transports.
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/memory_allocator.h>
+
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/notification.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/promise/activity.h"
+#include "src/core/lib/promise/context.h"
+#include "src/core/lib/promise/exec_ctx_wakeup_scheduler.h"
+#include "src/core/lib/promise/interceptor_list.h"
+#include "src/core/lib/promise/latch.h"
+#include "src/core/lib/promise/party.h"
+#include "src/core/lib/promise/pipe.h"
+#include "src/core/lib/promise/poll.h"
+#include "src/core/lib/promise/seq.h"
+#include "src/core/lib/promise/try_seq.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+MemoryAllocator MakeMemoryAllocator() {
+  return ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator(
+      "bm_promise_primitives");
+}
+
+// Runs body (which runs the benchmark loop) as the promise of an activity
+// with an arena, so that the primitives it polls can register wakeups.
+template <typename Body>
+void RunInActivity(Body body) {
+  ExecCtx exec_ctx;
+  MemoryAllocator memory_allocator = MakeMemoryAllocator();
+  auto activity = MakeActivity(
+      [&body]() {
+        return [&body]() -> Poll<absl::Status> {
+          body();
+          return absl::OkStatus();
+        };
+      },
+      ExecCtxWakeupScheduler(), [](absl::Status) {},
+      MakeScopedArena(1024, &memory_allocator));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Party
+
+class AllocatorOwner {
+ protected:
+  ~AllocatorOwner() { arena_->Destroy(); }
+  MemoryAllocator memory_allocator_ = MakeMemoryAllocator();
+  Arena* arena_ = Arena::Create(1024, &memory_allocator_);
+};
+
+class BenchmarkParty final : public AllocatorOwner, public Party {
+ public:
+  BenchmarkParty() : Party(AllocatorOwner::arena_, 1) {}
+  std::string DebugTag() const override { return "BenchmarkParty"; }
+
+  bool RunParty() override {
+    promise_detail::Context<grpc_event_engine::experimental::EventEngine>
+        ee_ctx(ee_.get());
+    return Party::RunParty();
+  }
+
+  void PartyOver() override {
+    {
+      promise_detail::Context<grpc_event_engine::experimental::EventEngine>
+          ee_ctx(ee_.get());
+      CancelRemainingParticipants();
+    }
+    delete this;
+  }
+
+ private:
+  grpc_event_engine::experimental::EventEngine* event_engine() const final {
+    return ee_.get();
+  }
+
+  std::shared_ptr<grpc_event_engine::experimental::EventEngine> ee_ =
+      grpc_event_engine::experimental::GetDefaultEventEngine();
+};
+
+// A party participant that stays pending until finished, leaving a waker
+// for the benchmark to wake it with each time it is polled.
+class WakeupTarget {
+ public:
+  void SpawnOn(Party* party) {
+    party->Spawn(
+        "WakeupTarget",
+        [this]() -> Poll<Empty> {
+          if (finished_.load(std::memory_order_acquire)) return Empty{};
+          if (!has_waker_.load(std::memory_order_acquire)) {
+            waker_ = Activity::current()->MakeOwningWaker();
+            has_waker_.store(true, std::memory_order_release);
+          }
+          return Pending{};
+        },
+        [this](Empty) { done_.Notify(); });
+  }
+
+  // Wakes the participant if it has been polled since the last wakeup.
+  bool Wakeup() {
+    if (!has_waker_.load(std::memory_order_acquire)) return false;
+    Waker waker = std::move(waker_);
+    has_waker_.store(false, std::memory_order_release);
+    waker.Wakeup();
+    return true;
+  }
+
+  // Completes the participant and waits for it to be done.
+  void Finish() {
+    finished_.store(true, std::memory_order_release);
+    while (!Wakeup()) {
+    }
+    done_.WaitForNotification();
+  }
+
+ private:
+  std::atomic<bool> finished_{false};
+  std::atomic<bool> has_waker_{false};
+  Waker waker_;
+  Notification done_;
+};
+
+void BM_PartySpawn(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  auto party = MakeRefCounted<BenchmarkParty>();
+  for (auto _ : state) {
+    party->Spawn(
+        "BM_PartySpawn", []() { return Empty{}; }, [](Empty) {});
+  }
+}
+BENCHMARK(BM_PartySpawn);
+
+void BM_PartyWakeup(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  auto party = MakeRefCounted<BenchmarkParty>();
+  WakeupTarget target;
+  target.SpawnOn(party.get());
+  for (auto _ : state) {
+    while (!target.Wakeup()) {
+    }
+  }
+  target.Finish();
+}
+BENCHMARK(BM_PartyWakeup);
+
+// Each thread wakes its own participant of one shared party, so threads
+// contend to run the party, and often run each other's participants.
+void BM_PartyWakeupContended(benchmark::State& state) {
+  static BenchmarkParty* const party =
+      MakeRefCounted<BenchmarkParty>().release();
+  ExecCtx exec_ctx;
+  WakeupTarget target;
+  target.SpawnOn(party);
+  for (auto _ : state) {
+    while (!target.Wakeup()) {
+    }
+  }
+  target.Finish();
+}
+// A party has at most 16 participants.
+BENCHMARK(BM_PartyWakeupContended)->ThreadRange(1, 8);
+
+///////////////////////////////////////////////////////////////////////////////
+// Pipe
+
+void BM_PipePushPull(benchmark::State& state) {
+  RunInActivity([&state]() {
+    Pipe<int> pipe;
+    for (auto _ : state) {
+      auto push = pipe.sender.Push(42);
+      auto next = pipe.receiver.Next();
+      // The push waits for the value to be taken...
+      benchmark::DoNotOptimize(push());
+      // ...which happens when the NextResult is destroyed.
+      benchmark::DoNotOptimize(next().value().value());
+      benchmark::DoNotOptimize(push());
+    }
+  });
+}
+BENCHMARK(BM_PipePushPull);
+
+///////////////////////////////////////////////////////////////////////////////
+// InterceptorList
+
+void BM_InterceptorList(benchmark::State& state) {
+  RunInActivity([&state]() {
+    InterceptorList<int> list;
+    for (int i = 0; i < state.range(0); i++) {
+      list.AppendMap([](int x) { return x + 1; }, DEBUG_LOCATION);
+    }
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(list.Run(0)());
+    }
+  });
+}
+BENCHMARK(BM_InterceptorList)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+
+///////////////////////////////////////////////////////////////////////////////
+// Seq, TrySeq
+
+template <size_t... kSteps>
+auto SeqOfDepth(std::index_sequence<kSteps...>) {
+  return Seq([]() { return 0; },
+             ((void)kSteps, [](int x) { return x + 1; })...);
+}
+
+template <size_t... kSteps>
+auto TrySeqOfDepth(std::index_sequence<kSteps...>) {
+  return TrySeq([]() { return absl::StatusOr<int>(0); },
+                ((void)kSteps,
+                 [](int x) { return absl::StatusOr<int>(x + 1); })...);
+}
+
+template <size_t kDepth>
+void BM_Seq(benchmark::State& state) {
+  for (auto _ : state) {
+    auto promise = SeqOfDepth(std::make_index_sequence<kDepth>());
+    benchmark::DoNotOptimize(promise());
+  }
+}
+BENCHMARK_TEMPLATE(BM_Seq, 1);
+BENCHMARK_TEMPLATE(BM_Seq, 2);
+BENCHMARK_TEMPLATE(BM_Seq, 4);
+BENCHMARK_TEMPLATE(BM_Seq, 8);
+
+template <size_t kDepth>
+void BM_TrySeq(benchmark::State& state) {
+  for (auto _ : state) {
+    auto promise = TrySeqOfDepth(std::make_index_sequence<kDepth>());
+    benchmark::DoNotOptimize(promise());
+  }
+}
+BENCHMARK_TEMPLATE(BM_TrySeq, 1);
+BENCHMARK_TEMPLATE(BM_TrySeq, 2);
+BENCHMARK_TEMPLATE(BM_TrySeq, 4);
+BENCHMARK_TEMPLATE(BM_TrySeq, 8);
+
+///////////////////////////////////////////////////////////////////////////////
+// Latch
+
+void BM_LatchSetThenWait(benchmark::State& state) {
+  RunInActivity([&state]() {
+    for (auto _ : state) {
+      Latch<int> latch;
+      auto wait = latch.Wait();
+      latch.Set(42);
+      benchmark::DoNotOptimize(wait());
+    }
+  });
+}
+BENCHMARK(BM_LatchSetThenWait);
+
+void BM_LatchWaitThenSet(benchmark::State& state) {
+  RunInActivity([&state]() {
+    for (auto _ : state) {
+      Latch<int> latch;
+      auto wait = latch.Wait();
+      benchmark::DoNotOptimize(wait());
+      latch.Set(42);
+      benchmark::DoNotOptimize(wait());
+    }
+  });
+}
+BENCHMARK(BM_LatchWaitThenSet);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -20,6 +20,13 @@
 
 #include <string.h>
 
+#ifdef GPR_LINUX
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 static LibraryInitializer* g_libraryInitializer;
 
 LibraryInitializer::LibraryInitializer() {
@@ -33,3 +40,93 @@ LibraryInitializer& LibraryInitializer::get() {
   GPR_ASSERT(g_libraryInitializer != nullptr);
   return *g_libraryInitializer;
 }
+
+#ifdef GPR_LINUX
+
+namespace {
+
+struct PerfEventConfig {
+  const char* name;
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr PerfEventConfig kPerfEvents[] = {
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"cache_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"context_switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+};
+
+int OpenPerfEvent(const PerfEventConfig& event) {
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = 1;
+  // Counting user space only needs perf_event_paranoid <= 2.
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // The PMU may have fewer counters than events, in which case the kernel
+  // multiplexes them and the counts must be scaled.
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, /*pid=*/0,
+                                  /*cpu=*/-1, /*group_fd=*/-1, 0));
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+  for (const PerfEventConfig& event : kPerfEvents) {
+    int fd = OpenPerfEvent(event);
+    if (fd >= 0) events_.push_back({event.name, fd});
+  }
+  for (const Event& event : events_) {
+    ioctl(event.fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(event.fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (const Event& event : events_) close(event.fd);
+}
+
+void PerfCounters::Finish(benchmark::State& state) {
+  for (const Event& event : events_) {
+    ioctl(event.fd, PERF_EVENT_IOC_DISABLE, 0);
+  }
+  double instructions = 0;
+  double cycles = 0;
+  for (const Event& event : events_) {
+    uint64_t values[3];  // value, time enabled, time running
+    if (read(event.fd, values, sizeof(values)) != sizeof(values) ||
+        values[2] == 0) {
+      continue;
+    }
+    const double count = static_cast<double>(values[0]) *
+                         static_cast<double>(values[1]) /
+                         static_cast<double>(values[2]);
+    if (strcmp(event.name, "instructions") == 0) instructions = count;
+    if (strcmp(event.name, "cycles") == 0) cycles = count;
+    state.counters[event.name] =
+        benchmark::Counter(count, benchmark::Counter::kAvgIterations);
+  }
+  if (cycles > 0) {
+    // Counters of all threads are summed up, so average this one.
+    state.counters["ipc"] = benchmark::Counter(
+        instructions / cycles, benchmark::Counter::kAvgThreads);
+  }
+}
+
+#else  // GPR_LINUX
+
+PerfCounters::PerfCounters() {}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::Finish(benchmark::State& /*state*/) {}
+
+#endif  // GPR_LINUX
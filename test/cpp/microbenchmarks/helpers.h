@@ -42,4 +42,30 @@ class LibraryInitializer {
   grpc::internal::GrpcLibrary init_lib_;
 };
 
+// Counts instructions, cycles, cache misses, branch misses and context
+// switches of the calling thread with perf_event_open, from construction
+// until Finish(), and reports them (and instructions per cycle) as benchmark
+// counters per iteration.  Construct it right before the benchmark loop.
+// Events that the kernel or the PMU can't count are left out, so on
+// platforms other than Linux nothing is reported.
+class PerfCounters {
+ public:
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  // Stops counting and reports the counts to state.
+  void Finish(benchmark::State& state);
+
+ private:
+  struct Event {
+    const char* name;
+    int fd;
+  };
+
+  std::vector<Event> events_;
+};
+
 #endif  // GRPC_TEST_CPP_MICROBENCHMARKS_HELPERS_H
@@ -23,6 +23,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include <algorithm>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -144,6 +145,19 @@ class HistogramEntry final {
   int status_;
 };
 
+// Returns the UsageTimer::Now() time at which an open-loop RPC was
+// scheduled to start (issue_time is on the monotonic clock).  Open-loop
+// latencies are measured from there rather than from when the client got
+// around to starting the RPC, so that a client falling behind its schedule
+// does not hide the queueing delay from the latency distribution
+// (coordinated omission).
+inline double IntendedStartTime(gpr_timespec issue_time) {
+  const gpr_timespec behind =
+      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), issue_time);
+  return UsageTimer::Now() -
+         std::max(0.0, gpr_timespec_to_micros(behind) / 1e6);
+}
+
 typedef std::unordered_map<int, int64_t> StatusHistogram;
 
 inline void MergeStatusHistogram(const StatusHistogram& from,
@@ -80,8 +80,11 @@ class SynchronousClient
   }
 
  protected:
-  // WaitToIssue returns false if we realize that we need to break out
-  bool WaitToIssue(int thread_idx) {
+  // WaitToIssue returns false if we realize that we need to break out.
+  // Otherwise, if start is not null, sets it to the time the latency of the
+  // next RPC is to be measured from: the time it was scheduled to start in
+  // open-loop mode, now in closed-loop mode.
+  bool WaitToIssue(int thread_idx, double* start = nullptr) {
     if (!closed_loop_) {
       const gpr_timespec next_issue_time = NextIssueTime(thread_idx);
       // Avoid sleeping for too long continuously because we might
@@ -93,6 +96,7 @@ class SynchronousClient
                          gpr_time_from_seconds(1, GPR_TIMESPAN));
         if (gpr_time_cmp(next_issue_time, one_sec_delay) <= 0) {
           gpr_sleep_until(next_issue_time);
+          if (start != nullptr) *start = IntendedStartTime(next_issue_time);
           return true;
         } else {
           gpr_sleep_until(one_sec_delay);
@@ -102,6 +106,7 @@ class SynchronousClient
         }
       }
     }
+    if (start != nullptr) *start = UsageTimer::Now();
     return true;
   }
 
@@ -120,11 +125,11 @@ class SynchronousUnaryClient final : public SynchronousClient {
   bool InitThreadFuncImpl(size_t /*thread_idx*/) override { return true; }
 
   bool ThreadFuncImpl(HistogramEntry* entry, size_t thread_idx) override {
-    if (!WaitToIssue(thread_idx)) {
+    double start;
+    if (!WaitToIssue(thread_idx, &start)) {
       return true;
     }
     auto* stub = channels_[thread_idx % channels_.size()].get_stub();
-    double start = UsageTimer::Now();
     grpc::ClientContext context;
     grpc::Status s =
         stub->UnaryCall(&context, request_, &responses_[thread_idx]);
@@ -239,10 +244,10 @@ class SynchronousStreamingPingPongClient final
   }
 
   bool ThreadFuncImpl(HistogramEntry* entry, size_t thread_idx) override {
-    if (!WaitToIssue(thread_idx)) {
+    double start;
+    if (!WaitToIssue(thread_idx, &start)) {
       return true;
     }
-    double start = UsageTimer::Now();
     if (stream_[thread_idx]->Write(request_) &&
         stream_[thread_idx]->Read(&responses_[thread_idx])) {
       entry->set_value((UsageTimer::Now() - start) * 1e9);
@@ -131,7 +131,8 @@ static bool IsSuccess(const Status& s) {
 }
 
 // Postprocess ScenarioResult and populate result summary.
-static void postprocess_scenario_result(ScenarioResult* result) {
+static void postprocess_scenario_result(const ClientConfig& client_config,
+                                        ScenarioResult* result) {
   // Get latencies from ScenarioResult latencies histogram and populate to
   // result summary.
   Histogram histogram;
@@ -141,6 +142,7 @@ static void postprocess_scenario_result(ScenarioResult* result) {
   result->mutable_summary()->set_latency_95(histogram.Percentile(95));
   result->mutable_summary()->set_latency_99(histogram.Percentile(99));
   result->mutable_summary()->set_latency_999(histogram.Percentile(99.9));
+  result->mutable_summary()->set_latency_9999(histogram.Percentile(99.99));
 
   // Calculate qps and cpu load for each client and then aggregate results for
   // all clients
@@ -165,6 +167,12 @@ static void postprocess_scenario_result(ScenarioResult* result) {
         server_stat.time_user() / server_stat.time_elapsed();
   }
   result->mutable_summary()->set_qps(qps);
+  // Each open-loop client is asked for offered_load operations per second.
+  if (client_config.load_params().has_poisson()) {
+    result->mutable_summary()->set_target_qps(
+        client_config.load_params().poisson().offered_load() *
+        result->client_stats_size());
+  }
   // Populate the percentage of cpu load to result summary.
   result->mutable_summary()->set_server_system_time(100 *
                                                     server_system_cpu_load);
@@ -645,7 +653,7 @@ std::unique_ptr<ScenarioResult> RunScenario(
   result->mutable_summary()->mutable_start_time()->set_seconds(start_time);
   result->mutable_summary()->mutable_end_time()->set_seconds(end_time);
 
-  postprocess_scenario_result(result.get());
+  postprocess_scenario_result(client_config, result.get());
   return result;
 }
 
@@ -80,6 +80,11 @@ void CompositeReporter::ReportQueriesPerCpuSec(const ScenarioResult& result) {
 
 void GprLogReporter::ReportQPS(const ScenarioResult& result) {
   gpr_log(GPR_INFO, "QPS: %.1f", result.summary().qps());
+  if (result.summary().target_qps() > 0) {
+    gpr_log(GPR_INFO, "target QPS: %.1f (%.1f%% achieved)",
+            result.summary().target_qps(),
+            100 * result.summary().qps() / result.summary().target_qps());
+  }
   if (result.summary().failed_requests_per_second() > 0) {
     gpr_log(GPR_INFO, "failed requests/second: %.1f",
             result.summary().failed_requests_per_second());
@@ -95,12 +100,14 @@ void GprLogReporter::ReportQPSPerCore(const ScenarioResult& result) {
 
 void GprLogReporter::ReportLatency(const ScenarioResult& result) {
   gpr_log(GPR_INFO,
-          "Latencies (50/90/95/99/99.9%%-ile): %.1f/%.1f/%.1f/%.1f/%.1f us",
+          "Latencies (50/90/95/99/99.9/99.99%%-ile): "
+          "%.1f/%.1f/%.1f/%.1f/%.1f/%.1f us",
           result.summary().latency_50() / 1000,
           result.summary().latency_90() / 1000,
           result.summary().latency_95() / 1000,
           result.summary().latency_99() / 1000,
-          result.summary().latency_999() / 1000);
+          result.summary().latency_999() / 1000,
+          result.summary().latency_9999() / 1000);
 }
 
 void GprLogReporter::ReportTimes(const ScenarioResult& result) {
@@ -55,6 +55,14 @@ _INTERESTING = {
         rb"server call memory usage: ([0-9\.]+) bytes per call",
         float,
     ),
+    "call/client/heap": (
+        rb"client call heap usage: ([0-9\.]+) bytes per call",
+        float,
+    ),
+    "call/server/heap": (
+        rb"server call heap usage: ([0-9\.]+) bytes per call",
+        float,
+    ),
     "channel/client": (
         rb"client channel memory usage: ([0-9\.]+) bytes per channel",
         float,
@@ -63,6 +71,22 @@ _INTERESTING = {
         rb"server channel memory usage: ([0-9\.]+) bytes per channel",
         float,
     ),
+    "idle channel": (
+        rb"idle channel memory usage: ([0-9\.]+) bytes per channel",
+        float,
+    ),
+    "subchannel": (
+        rb"subchannel memory usage: ([0-9\.]+) bytes per connected subchannel",
+        float,
+    ),
+    "timer": (
+        rb"timer memory usage: ([0-9\.]+) bytes per pending timer",
+        float,
+    ),
+    "xds cluster": (
+        rb"xds cluster memory usage: ([0-9\.]+) bytes per cluster",
+        float,
+    ),
 }
 
 _SCENARIOS = {
@@ -73,6 +97,7 @@ _SCENARIOS = {
 _BENCHMARKS = {
     "call": ["--benchmark_names=call", "--size=50000"],
     "channel": ["--benchmark_names=channel", "--size=10000"],
+    "footprint": ["--benchmark_names=footprint", "--size=1000"],
 }
 
 
@@ -91,7 +116,7 @@ def _run():
     for name, benchmark_args in _BENCHMARKS.items():
         for scenario, extra_args in _SCENARIOS.items():
             # TODO(chenancy) Remove when minstack is implemented for channel
-            if name == "channel" and scenario == "minstack":
+            if name in ("channel", "footprint") and scenario == "minstack":
                 continue
             try:
                 output = subprocess.check_output(
@@ -41,4 +41,11 @@ _INTERESTING = (
     "svr_transport_stalls_per_iteration",
     "svr_stream_stalls_per_iteration",
     "http2_pings_sent_per_iteration",
+    # Reported by benchmarks that use PerfCounters, on machines with a PMU.
+    "instructions",
+    "cycles",
+    "cache_misses",
+    "branch_misses",
+    # A software event, so reported even without a PMU.
+    "context_switches",
 )
@@ -0,0 +1,471 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 gRPC authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Gates two builds on a key set of microbenchmarks and qps scenarios"""
+
+import argparse
+import collections
+import glob
+import json
+import os
+import random
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+import bm_build
+import bm_speedup
+import tabulate
+
+_PERF_EVENTS = (
+    "instructions",
+    "cycles",
+    "cache-misses",
+    "branch-misses",
+    "context-switches",
+)
+
+# Metrics of qps scenarios (fields of ScenarioResultSummary) that are
+# tracked, and whether higher values are better.
+_QPS_METRICS = {
+    "qps": True,
+    "qpsPerServerCore": True,
+    "latency50": False,
+    "latency90": False,
+    "latency99": False,
+    "latency999": False,
+    "serverQueriesPerCpuSec": True,
+    "clientQueriesPerCpuSec": True,
+}
+
+# Numeric fields of benchmark JSON rows that are not measurements.
+_BM_BOOKKEEPING = (
+    "family_index",
+    "per_family_instance_index",
+    "repetitions",
+    "repetition_index",
+    "threads",
+    "iterations",
+)
+
+_DEFAULT_BM_GATE = ("cpu_time",)
+_DEFAULT_QPS_GATE = ("qps", "latency50", "latency99")
+
+
+def _higher_is_better(metric):
+    if metric in ("bytes_per_second", "items_per_second"):
+        return True
+    return _QPS_METRICS.get(metric, False)
+
+
+def _load_scenarios(filename):
+    """Loads the key set: a JSON list of entries, each either
+
+    {"name": ..., "benchmark": "bm_...", "filter": "<regex>"} or
+    {"name": ..., "qps_scenario": <Scenario as JSON>},
+
+    with an optional "gate" list of the metrics that fail the comparison
+    when they regress.
+    """
+    with open(filename) as f:
+        scenarios = json.load(f)
+    names = set()
+    for s in scenarios:
+        assert "name" in s, "scenario without a name: %r" % s
+        assert s["name"] not in names, "duplicate scenario %s" % s["name"]
+        assert ("benchmark" in s) != ("qps_scenario" in s), (
+            "scenario %s needs exactly one of benchmark or qps_scenario"
+            % s["name"]
+        )
+        names.add(s["name"])
+    return scenarios
+
+
+def _bin_dir(name):
+    return "bm_diff_%s/opt" % name
+
+
+def _results_dir(name):
+    return "bm_regress_%s" % name
+
+
+def _perf_cmd(out_file):
+    return [
+        "perf",
+        "stat",
+        "-x",
+        ",",
+        "-o",
+        out_file,
+        "-e",
+        ",".join(_PERF_EVENTS),
+        "--",
+    ]
+
+
+def _read_perf(out_file):
+    """Parses the CSV output of perf stat into {event: count}."""
+    counters = {}
+    with open(out_file) as f:
+        for line in f:
+            fields = line.strip().split(",")
+            if len(fields) < 3 or line.startswith("#"):
+                continue
+            value, event = fields[0], fields[2]
+            # Events the PMU can't count are reported as <not counted> or
+            # <not supported>.
+            try:
+                counters[event.split(":")[0]] = float(value)
+            except ValueError:
+                continue
+    return counters
+
+
+def _run(cmd, perf):
+    """Runs cmd, optionally under perf stat, and returns the counters."""
+    if not perf:
+        subprocess.check_call(cmd)
+        return {}
+    with tempfile.NamedTemporaryFile(suffix=".perf") as f:
+        subprocess.check_call(_perf_cmd(f.name) + cmd)
+        return _read_perf(f.name)
+
+
+def _per(counters, count, unit):
+    if not count:
+        return {}
+    return {
+        "%s_per_%s" % (event.replace("-", "_"), unit): value / count
+        for event, value in counters.items()
+    }
+
+
+def _run_benchmark(name, scenario, perf):
+    """Runs each benchmark matching the scenario's filter in its own
+    process, so that process wide perf counters belong to one benchmark."""
+    binary = os.path.join(_bin_dir(name), scenario["benchmark"])
+    results = {}
+    for bm in subprocess.check_output(
+        [
+            binary,
+            "--benchmark_list_tests",
+            "--benchmark_filter=%s" % scenario.get("filter", ""),
+        ]
+    ).splitlines():
+        bm = bm.decode("UTF-8").strip()
+        with tempfile.NamedTemporaryFile(suffix=".json") as out:
+            counters = _run(
+                [
+                    binary,
+                    "--benchmark_filter=^%s$" % re.escape(bm),
+                    "--benchmark_out=%s" % out.name,
+                    "--benchmark_out_format=json",
+                ],
+                perf,
+            )
+            js = json.load(out)
+        for row in js["benchmarks"]:
+            # cpu_time, real_time and the user counters of the benchmark.
+            metrics = {
+                k: float(v)
+                for k, v in row.items()
+                if isinstance(v, (int, float))
+                and not isinstance(v, bool)
+                and k not in _BM_BOOKKEEPING
+            }
+            # Includes process startup, so is only comparable across builds.
+            metrics.update(_per(counters, row["iterations"], "iteration"))
+            results["%s:%s" % (scenario["name"], row["name"])] = metrics
+    return results
+
+
+def _run_qps(name, scenario, perf):
+    binary = os.path.join(_bin_dir(name), "qps_json_driver")
+    with tempfile.NamedTemporaryFile(suffix=".json") as out:
+        counters = _run(
+            [
+                binary,
+                "--scenarios_json=%s"
+                % json.dumps({"scenarios": [scenario["qps_scenario"]]}),
+                "--scenario_result_file=%s" % out.name,
+            ],
+            perf,
+        )
+        js = json.load(out)
+    summary = js.get("summary", {})
+    metrics = {k: float(summary[k]) for k in _QPS_METRICS if k in summary}
+    # Includes the warmup, so is only comparable across builds.
+    metrics.update(
+        _per(counters, int(js.get("latencies", {}).get("count", 0)), "rpc")
+    )
+    return {scenario["name"]: metrics}
+
+
+def run(name, scenarios, loops, perf):
+    results_dir = _results_dir(name)
+    shutil.rmtree(results_dir, ignore_errors=True)
+    os.makedirs(results_dir)
+    jobs = [(loop, s) for loop in range(loops) for s in scenarios]
+    # Interleave the scenarios to spread the drift of the machine over them.
+    random.shuffle(jobs)
+    for loop, scenario in jobs:
+        print("running %s %d/%d" % (scenario["name"], loop + 1, loops))
+        if "benchmark" in scenario:
+            results = _run_benchmark(name, scenario, perf)
+        else:
+            results = _run_qps(name, scenario, perf)
+        with open(
+            os.path.join(results_dir, "%s.%d.json" % (scenario["name"], loop)),
+            "w",
+        ) as f:
+            json.dump(
+                {
+                    "name": name,
+                    "scenario": scenario["name"],
+                    "loop": loop,
+                    "results": results,
+                },
+                f,
+                indent=2,
+            )
+
+
+def _read_samples(name):
+    """Returns {scenario: {result: {metric: [samples]}}} for a run."""
+    samples = collections.defaultdict(
+        lambda: collections.defaultdict(lambda: collections.defaultdict(list))
+    )
+    for filename in sorted(glob.glob(os.path.join(_results_dir(name), "*"))):
+        with open(filename) as f:
+            js = json.load(f)
+        for result, metrics in js["results"].items():
+            for metric, value in metrics.items():
+                samples[js["scenario"]][result][metric].append(value)
+    return samples
+
+
+def _median(ary):
+    ary = sorted(ary)
+    n = len(ary)
+    return (ary[(n - 1) // 2] + ary[n // 2]) / 2.0
+
+
+def compare(scenarios, old, new, alpha, threshold, verbose):
+    """Compares two runs and returns (report rows, regressions)."""
+    old_samples = _read_samples(old)
+    new_samples = _read_samples(new)
+    rows = []
+    regressions = []
+    too_few = set()
+    for scenario in scenarios:
+        gate = scenario.get(
+            "gate",
+            _DEFAULT_BM_GATE if "benchmark" in scenario else _DEFAULT_QPS_GATE,
+        )
+        results = old_samples[scenario["name"]]
+        for result in sorted(results):
+            for metric in sorted(results[result]):
+                o = results[result][metric]
+                n = new_samples[scenario["name"]][result][metric]
+                if not n:
+                    continue
+                if (
+                    bm_speedup.min_mann_whitney_pvalue(len(n), len(o)) > alpha
+                    and result not in too_few
+                ):
+                    print(
+                        "WARNING: too few samples of %s for a change to be"
+                        " significant" % result
+                    )
+                    too_few.add(result)
+                o_mdn, n_mdn = _median(o), _median(n)
+                delta = (n_mdn - o_mdn) / o_mdn * 100 if o_mdn else 0.0
+                p = bm_speedup.mann_whitney(n, o)
+                worse = delta < 0 if _higher_is_better(metric) else delta > 0
+                verdict = ""
+                if p < alpha and abs(delta) >= threshold:
+                    verdict = "worse" if worse else "better"
+                    if worse and metric in gate:
+                        verdict = "REGRESSION"
+                        regressions.append((result, metric))
+                if verdict or verbose:
+                    rows.append(
+                        {
+                            "result": result,
+                            "metric": metric,
+                            "old": o_mdn,
+                            "new": n_mdn,
+                            "delta_pct": delta,
+                            "p_value": p,
+                            "verdict": verdict,
+                        }
+                    )
+    return rows, regressions
+
+
+def _args():
+    argp = argparse.ArgumentParser(description=__doc__)
+    argp.add_argument(
+        "command",
+        choices=["build", "run", "compare"],
+        help=(
+            "build: build the key set into bm_diff_NAME; run: run it LOOPS"
+            " times into bm_regress_NAME; compare: compare run OLD to NEW"
+        ),
+    )
+    argp.add_argument(
+        "-s",
+        "--scenarios",
+        type=str,
+        default=os.path.join(
+            os.path.dirname(sys.argv[0]), "key_scenarios.json"
+        ),
+        help="JSON file with the key set of scenarios",
+    )
+    argp.add_argument(
+        "-n", "--name", type=str, help="Name of the build to build or run"
+    )
+    argp.add_argument("-o", "--old", type=str, help="Baseline run to compare")
+    argp.add_argument("--new", type=str, help="Run to compare to the baseline")
+    argp.add_argument(
+        "-l",
+        "--loops",
+        type=int,
+        default=10,
+        help="Number of times to run each scenario",
+    )
+    argp.add_argument(
+        "--perf",
+        action="store_true",
+        help=("Record %s of each run with perf stat" % ", ".join(_PERF_EVENTS)),
+    )
+    argp.add_argument(
+        "--alpha",
+        type=float,
+        default=0.01,
+        help="Significance level of the Mann-Whitney U test",
+    )
+    argp.add_argument(
+        "--threshold",
+        type=float,
+        default=3.0,
+        help="Smallest change in percent that is reported",
+    )
+    argp.add_argument(
+        "--report_json",
+        type=str,
+        default="",
+        help="Also write the comparison to this JSON file",
+    )
+    argp.add_argument(
+        "-v",
+        "--verbose",
+        action="store_true",
+        help="Report all metrics, not only significant changes",
+    )
+    args = argp.parse_args()
+    if args.command in ("build", "run"):
+        assert args.name, "--name is required"
+    else:
+        assert args.old and args.new, "--old and --new are required"
+    return args
+
+
+def main(args):
+    scenarios = _load_scenarios(args.scenarios)
+    if args.command == "build":
+        benchmarks = sorted(
+            set(s["benchmark"] for s in scenarios if "benchmark" in s)
+        )
+        if benchmarks:
+            bm_build.build(args.name, benchmarks, None)
+        else:
+            shutil.rmtree("bm_diff_%s" % args.name, ignore_errors=True)
+            os.makedirs(_bin_dir(args.name))
+        if any("qps_scenario" in s for s in scenarios):
+            subprocess.check_call(
+                [
+                    "tools/bazel",
+                    "build",
+                    "--config=opt",
+                    "--dynamic_mode=off",
+                    "//test/cpp/qps:qps_json_driver",
+                ]
+            )
+            shutil.copy(
+                "bazel-bin/test/cpp/qps/qps_json_driver", _bin_dir(args.name)
+            )
+        return 0
+    if args.command == "run":
+        run(args.name, scenarios, args.loops, args.perf)
+        return 0
+    rows, regressions = compare(
+        scenarios,
+        args.old,
+        args.new,
+        args.alpha,
+        args.threshold,
+        args.verbose,
+    )
+    if args.report_json:
+        with open(args.report_json, "w") as f:
+            json.dump(
+                {"old": args.old, "new": args.new, "rows": rows}, f, indent=2
+            )
+    if rows:
+        print(
+            tabulate.tabulate(
+                [
+                    [
+                        r["result"],
+                        r["metric"],
+                        r["old"],
+                        r["new"],
+                        "%+.1f%%" % r["delta_pct"],
+                        "%.2g" % r["p_value"],
+                        r["verdict"],
+                    ]
+                    for r in rows
+                ],
+                headers=[
+                    "Result",
+                    "Metric",
+                    "Old",
+                    "New",
+                    "Delta",
+                    "p",
+                    "",
+                ],
+                floatfmt=".4g",
+            )
+        )
+    else:
+        print("No significant performance differences")
+    if regressions:
+        print(
+            "%d regression(s) in gated metrics: %s"
+            % (
+                len(regressions),
+                ", ".join("%s %s" % r for r in regressions),
+            )
+        )
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(_args()))
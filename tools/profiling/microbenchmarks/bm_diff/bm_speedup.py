@@ -29,6 +29,23 @@ def cmp(a, b):
     return stats.ttest_ind(a, b)
 
 
+def mann_whitney(new, old):
+    """Returns the p-value of a two-sided Mann-Whitney U test of new vs old.
+
+    Unlike the t-test used by speedup(), this makes no assumption about the
+    distribution of the samples, which for benchmarks is often skewed by a
+    few slow runs.
+    """
+    if len(set(new + old)) == 1:
+        return 1.0
+    return stats.mannwhitneyu(new, old, alternative="two-sided").pvalue
+
+
+def min_mann_whitney_pvalue(n, m):
+    """The smallest p-value a two-sided test of n vs m samples can reach."""
+    return 2.0 / math.comb(n + m, n)
+
+
 def speedup(new, old, threshold=_DEFAULT_THRESHOLD):
     if (len(set(new))) == 1 and new == old:
         return 0
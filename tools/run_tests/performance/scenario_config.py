@@ -138,6 +138,7 @@ def _ping_pong_scenario(
     excluded_poll_engines=None,
     minimal_stack=False,
     offered_load=None,
+    adaptive_concurrency=False,
 ):
     """Creates a basic ping pong scenario."""
     scenario = {
@@ -228,6 +229,11 @@ def _ping_pong_scenario(
         _add_channel_arg(scenario["client_config"], "grpc.minimal_stack", 1)
         _add_channel_arg(scenario["server_config"], "grpc.minimal_stack", 1)
 
+    if adaptive_concurrency:
+        _add_channel_arg(
+            scenario["server_config"], "grpc.adaptive_concurrency", 1
+        )
+
     if messages_per_stream:
         scenario["client_config"]["messages_per_stream"] = messages_per_stream
     if client_language:
@@ -530,6 +536,27 @@ class CXXLanguage(Language):
                 + [SCALABLE],
             )
 
+            # A single server thread serving far more outstanding calls than
+            # it can keep up with.  Compare successful_requests_per_second
+            # (goodput) with and without adaptive concurrency limiting on the
+            # server.  The filter is not part of the minimal stack.
+            for adaptive_concurrency in [False, True]:
+                yield _ping_pong_scenario(
+                    "cpp_protobuf_async_unary_overload_%s%s"
+                    % (
+                        secstr,
+                        "_adaptive_concurrency" if adaptive_concurrency else "",
+                    ),
+                    rpc_type="UNARY",
+                    client_type="ASYNC_CLIENT",
+                    server_type="ASYNC_SERVER",
+                    unconstrained_client="async",
+                    async_server_threads=1,
+                    secure=secure,
+                    adaptive_concurrency=adaptive_concurrency,
+                    categories=[SWEEP],
+                )
+
             for rpc_type in [
                 "unary",
                 "streaming",